@@ -22,6 +22,7 @@ set(HEADER_FILES
 	"src/Core/Application/Serialization/ParseContexts.hpp"
 	"src/Core/Application/Serialization/SerialLogicRegistry.hpp"
 	"src/Core/Application/Threading/ThreadManager.hpp"
+	"src/Core/Application/Threading/ThreadPool.hpp"
 	"src/Core/Application/Threading/WorkerThread.hpp"
 	"src/Core/Data/Application.hpp"
 	"src/Core/Data/BoundedDeque.hpp"
@@ -104,10 +105,15 @@ set(HEADER_FILES
 	"src/Platform/Vulkan/Utils/VkImageUtils.hpp"
 	"src/Platform/Windowing/AppWindow.hpp"
 	"src/Simulation/ODEs.hpp"
+	"src/Simulation/Algorithms/HermiteMotion.hpp"
+	"src/Simulation/Algorithms/RootFinding.hpp"
 	"src/Simulation/Algorithms/COE/COE.hpp"
 	"src/Simulation/Algorithms/COE/COE2RV.hpp"
 	"src/Simulation/Algorithms/COE/RV2COE.hpp"
+	"src/Simulation/Algorithms/Kepler/FINDC2C3.hpp"
+	"src/Simulation/Algorithms/Kepler/KEPLER.hpp"
 	"src/Simulation/Algorithms/Kepler/NU2ANOM.hpp"
+	"src/Simulation/Algorithms/Lambert/LAMBERT.hpp"
 	"src/Simulation/Bodies/Earth.hpp"
 	"src/Simulation/Bodies/ICelestialBody.hpp"
 	"src/Simulation/Bodies/Includes.hpp"
@@ -120,14 +126,41 @@ set(HEADER_FILES
 	"src/Simulation/Bodies/Sun.hpp"
 	"src/Simulation/Bodies/Uranus.hpp"
 	"src/Simulation/Bodies/Venus.hpp"
+	"src/Simulation/Conjunctions/ConjunctionScreener.hpp"
 	"src/Simulation/Data/Bodies.hpp"
 	"src/Simulation/Data/CoordSys.hpp"
+	"src/Simulation/Data/Dispersions.hpp"
+	"src/Simulation/Data/Solvers.hpp"
+	"src/Simulation/Dispersions/MonteCarloRunner.hpp"
+	"src/Simulation/Eclipses/EclipseTracker.hpp"
+	"src/Simulation/Forces/Atmosphere.hpp"
+	"src/Simulation/Forces/ForceModelPipeline.hpp"
+	"src/Simulation/Forces/ForceModels.hpp"
+	"src/Simulation/Forces/GravityField.hpp"
+	"src/Simulation/Gravity/BarnesHut.hpp"
+	"src/Simulation/Gravity/GravityKernels.hpp"
+	"src/Simulation/Gravity/NBodyStore.hpp"
+	"src/Simulation/Integrators/ConservationMonitor.hpp"
+	"src/Simulation/Integrators/EmbeddedRK.hpp"
+	"src/Simulation/Integrators/NBodyRK4.hpp"
 	"src/Simulation/Integrators/RK4.hpp"
+	"src/Simulation/Integrators/Symplectic.hpp"
 	"src/Simulation/Integrators/SymplecticEuler.hpp"
+	"src/Simulation/Integrators/WisdomHolman.hpp"
+	"src/Simulation/Maneuvers/FiniteBurnScheduler.hpp"
+	"src/Simulation/Maneuvers/PorkchopGrid.hpp"
 	"src/Simulation/NutationCoefficients/IAU1980.hpp"
 	"src/Simulation/NutationCoefficients/IAU2000.hpp"
+	"src/Simulation/Passes/PassPredictor.hpp"
+	"src/Simulation/Propagators/Encke/EnckePropagator.hpp"
+	"src/Simulation/Propagators/Kepler/KeplerPropagator.hpp"
+	"src/Simulation/Propagators/SGP4/OMMCatalog.hpp"
+	"src/Simulation/Propagators/SGP4/SDP4Checkpoints.hpp"
 	"src/Simulation/Propagators/SGP4/SGP4.hpp"
+	"src/Simulation/Propagators/SGP4/SGP4Batch.hpp"
 	"src/Simulation/Propagators/SGP4/TLE.hpp"
+	"src/Simulation/Propagators/SGP4/TLECatalog.hpp"
 	"src/Simulation/Systems/CoordinateSystem.hpp"
+	"src/Simulation/Systems/EphemerisCache.hpp"
 	"src/Simulation/Systems/Time.hpp"
 )
\ No newline at end of file
@@ -45,7 +45,25 @@ set(SOURCE_FILES
 	"src/Platform/Vulkan/VkSyncManager.cpp"
 	"src/Platform/Vulkan/VkWindowManager.cpp"
 	"src/Platform/Windowing/AppWindow.cpp"
+	"src/Simulation/Conjunctions/ConjunctionScreener.cpp"
+	"src/Simulation/Dispersions/MonteCarloRunner.cpp"
+	"src/Simulation/Eclipses/EclipseTracker.cpp"
+	"src/Simulation/Forces/ForceModelPipeline.cpp"
+	"src/Simulation/Forces/GravityField.cpp"
+	"src/Simulation/Gravity/BarnesHut.cpp"
+	"src/Simulation/Gravity/GravityKernels.cpp"
+	"src/Simulation/Integrators/ConservationMonitor.cpp"
+	"src/Simulation/Maneuvers/FiniteBurnScheduler.cpp"
+	"src/Simulation/Maneuvers/PorkchopGrid.cpp"
+	"src/Simulation/Passes/PassPredictor.cpp"
+	"src/Simulation/Propagators/Encke/EnckePropagator.cpp"
+	"src/Simulation/Propagators/Kepler/KeplerPropagator.cpp"
+	"src/Simulation/Propagators/SGP4/OMMCatalog.cpp"
+	"src/Simulation/Propagators/SGP4/SDP4Checkpoints.cpp"
 	"src/Simulation/Propagators/SGP4/SGP4.cpp"
+	"src/Simulation/Propagators/SGP4/SGP4Batch.cpp"
 	"src/Simulation/Propagators/SGP4/TLE.cpp"
+	"src/Simulation/Propagators/SGP4/TLECatalog.cpp"
 	"src/Simulation/Systems/CoordinateSystem.cpp"
+	"src/Simulation/Systems/EphemerisCache.cpp"
 )
\ No newline at end of file
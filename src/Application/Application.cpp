@@ -54,6 +54,11 @@ int processAppConfig(int argc, char *argv[]) {
         g_appCtx.Config.debugging_ShowConsole           = getConfigOrArgVal(appConfig, "Debugging", "ShowWindowConsole");//appConfig["Debugging"]["ShowWindowConsole"].get<bool>();
         g_appCtx.Config.debugging_VkValidationLayers    = getConfigOrArgVal(appConfig, "Debugging", "VkValidationLayers");//appConfig["Debugging"]["VkValidationLayers"].get<bool>();
         g_appCtx.Config.debugging_VkAPIDump             = getConfigOrArgVal(appConfig, "Debugging", "VkAPIDump");//appConfig["Debugging"]["VkAPIDump"].get<bool>();
+        g_appCtx.Config.debugging_PhysicsDiagnostics    = getConfigOrArgVal(appConfig, "Debugging", "PhysicsDiagnostics");
+
+        g_appCtx.Config.simulation_PhysicsThreads       = appConfig["Simulation"]["PhysicsThreads"].get<uint32_t>();
+        g_appCtx.Config.simulation_SGP4Threads          = appConfig["Simulation"]["SGP4Threads"].get<uint32_t>();
+        g_appCtx.Config.simulation_ConjunctionThreshold = appConfig["Simulation"]["ConjunctionThreshold"].get<double>();
     }
     catch (const json::parse_error &parseErr) {
         boxer::show(("Cannot start Astrocelerate: Unable to parse file " + enquote(ResourcePath::App.CONFIG_APP) + ".\n\nParser error: " + parseErr.what()).c_str(), "Configuration Error", boxer::Style::Error, boxer::Buttons::Quit);
@@ -197,6 +197,7 @@ void Engine::initComponents() {
     m_ecsRegistry->initComponentArray<PhysicsComponent::NutationAngles>();
     m_ecsRegistry->initComponentArray<PhysicsComponent::ShapeParameters>();
     m_ecsRegistry->initComponentArray<PhysicsComponent::OrbitalElements>();
+    m_ecsRegistry->initComponentArray<PhysicsComponent::Eclipse>();
     m_ecsRegistry->initComponentArray<PhysicsComponent::CoordinateSystem>();
 
     /* Spacecraft */
@@ -0,0 +1,202 @@
+/* ThreadPool.hpp - Defines a pool of persistent worker threads for fork-join data parallelism.
+*/
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <exception>
+#include <algorithm>
+#include <type_traits>
+#include <condition_variable>
+
+
+#include <Core/Application/Threading/WorkerThread.hpp>
+#include <Core/Application/Threading/ThreadManager.hpp>
+
+
+/* A fork-join thread pool.
+	Its worker threads are created once via ThreadManager::CreateThread and sleep between jobs, so that a job (e.g., a force evaluation, which may run several times per time step) does not pay for thread creation.
+	The thread calling ThreadPool::parallelFor takes part in the job, and returns when every task has completed. If a task throws, the first exception is rethrown by ThreadPool::parallelFor once every thread has left the job.
+*/
+class ThreadPool {
+public:
+	ThreadPool() = default;
+	~ThreadPool() { shutdown(); }
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+
+	/* (Re)creates the worker threads.
+		@param name: The name of the pool. Worker threads are named "<name>_<index>".
+		@param threadCount: The total number of threads taking part in a job, including the calling thread. If 0, the number of hardware threads is used.
+	*/
+	inline void init(const std::string &name, uint32_t threadCount) {
+		shutdown();
+
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		m_stopping = false;
+		m_generation = 0;
+
+		for (uint32_t i = 1; i < threadCount; i++) {
+			std::shared_ptr<WorkerThread> worker = ThreadManager::CreateThread(name + "_" + std::to_string(i));
+			worker->set([this, index = i](std::stop_token stopToken) {
+				workerLoop(stopToken, index);
+			});
+			worker->start();
+
+			m_workers.push_back(worker);
+		}
+	}
+
+
+	/* Stops and releases the worker threads. */
+	inline void shutdown() {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+
+		for (auto &worker : m_workers)
+			worker->requestStop();
+		for (auto &worker : m_workers)
+			worker->waitForStop(&m_jobCV);
+
+		m_workers.clear();
+	}
+
+
+	/* Gets the total number of threads taking part in a job (including the calling thread). */
+	inline uint32_t getThreadCount() const { return static_cast<uint32_t>(m_workers.size()) + 1; }
+
+
+	/* Runs task(0), ..., task(taskCount - 1) across the pool, and waits for all of them to complete.
+		Tasks are handed out dynamically, so any task may run on any thread: a task must not depend on the thread that runs it if the result is to be reproducible.
+		If a task throws, the tasks that have not started yet are skipped, and the first exception is rethrown after every thread has finished its current task.
+
+		@param taskCount: The number of tasks.
+		@param task: The task, called as `task(size_t taskIndex)`.
+		@param maxThreads (optional): The maximum number of threads (including the calling thread) taking part in the job. If 0, every thread of the pool is used.
+	*/
+	template<typename Task>
+	inline void parallelFor(size_t taskCount, Task &&task, uint32_t maxThreads = 0) {
+		if (taskCount == 0)
+			return;
+
+		uint32_t threadCount = (maxThreads == 0) ? getThreadCount() : std::min(maxThreads, getThreadCount());
+		threadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, taskCount));
+
+		if (threadCount <= 1) {
+			for (size_t i = 0; i < taskCount; i++)
+				task(i);
+			return;
+		}
+
+
+		// Publish the job
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			m_taskContext = &task;
+			m_taskInvoker = [](void *context, size_t taskIndex) {
+				(*static_cast<std::remove_reference_t<Task> *>(context))(taskIndex);
+			};
+			m_taskCount = taskCount;
+			m_nextTask.store(0);
+
+			m_participants = threadCount - 1;
+			m_pendingWorkers = m_participants;
+			m_generation++;
+		}
+		m_jobCV.notify_all();
+
+
+		runTasks();
+
+
+		// Wait for the workers to finish their last tasks
+		std::exception_ptr exception;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_doneCV.wait(lock, [this] { return m_pendingWorkers == 0; });
+
+			m_taskContext = nullptr;
+			m_taskInvoker = nullptr;
+			std::swap(exception, m_exception);
+		}
+
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+
+private:
+	std::vector<std::shared_ptr<WorkerThread>> m_workers;
+
+	std::mutex m_mutex;
+	std::condition_variable_any m_jobCV;		// Notified when a job is published (or the pool is stopping)
+	std::condition_variable m_doneCV;			// Notified when the last worker of a job finishes
+
+	uint64_t m_generation = 0;					// Incremented on every job
+	uint32_t m_participants = 0;				// Number of workers taking part in the current job
+	uint32_t m_pendingWorkers = 0;				// Number of workers that have not finished the current job yet
+	bool m_stopping = false;
+
+	void *m_taskContext = nullptr;
+	void (*m_taskInvoker)(void *, size_t) = nullptr;
+	size_t m_taskCount = 0;
+	std::atomic<size_t> m_nextTask{ 0 };
+	std::exception_ptr m_exception;				// The first exception thrown by a task of the current job
+
+
+	/* Claims and runs tasks of the current job until none are left. Exceptions are captured (so that the calling thread still waits for the workers, and workers still report completion). */
+	inline void runTasks() {
+		try {
+			for (size_t i = m_nextTask.fetch_add(1); i < m_taskCount; i = m_nextTask.fetch_add(1))
+				m_taskInvoker(m_taskContext, i);
+		}
+		catch (...) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception)
+				m_exception = std::current_exception();
+
+			m_nextTask.store(m_taskCount);		// Skip the tasks that have not started yet
+		}
+	}
+
+
+	inline void workerLoop(std::stop_token stopToken, uint32_t index) {
+		uint64_t seenGeneration = 0;
+
+		while (true) {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_jobCV.wait(lock, stopToken, [&] { return m_stopping || m_generation != seenGeneration; });
+
+				if (m_stopping || stopToken.stop_requested())
+					return;
+
+				seenGeneration = m_generation;
+				if (index > m_participants)
+					continue;		// Not needed for this job
+			}
+
+			runTasks();
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_pendingWorkers--;
+
+				if (m_pendingWorkers == 0)
+					m_doneCV.notify_one();
+			}
+		}
+	}
+};
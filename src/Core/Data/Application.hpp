@@ -4,6 +4,8 @@
 #pragma once
 
 #include <Simulation/Data/CoordSys.hpp>
+#include <Simulation/Data/Solvers.hpp>
+#include <Simulation/Data/Dispersions.hpp>
 
 
 namespace Application {
@@ -35,5 +37,32 @@ namespace Application {
 		CoordSys::Frame frame = CoordSys::Frame::NONE;		// The frame used by the simulation.
 		CoordSys::Epoch epoch;								// The simulation's epoch.
 		std::string epochFormat;							// The epoch's SPICE format ("YYYY-MM-DD HH:MM:SS TZ")
+
+		Solvers::Gravity gravitySolver = Solvers::Gravity::DIRECT;		// The gravity solver used for bodies integrated by the physics system.
+		double openingAngle = Solvers::DEFAULT_OPENING_ANGLE;			// The Barnes-Hut opening angle (theta). Smaller values are more accurate but slower.
+		Solvers::IntegrationMode integrationMode = Solvers::IntegrationMode::PER_BODY;	// Whether bodies are integrated individually or as one system (opt-in).
+		Solvers::Integrator integrator = Solvers::Integrator::RK4;						// The numerical integrator.
+		double absoluteTolerance = Solvers::DEFAULT_ABSOLUTE_TOLERANCE;					// Absolute error tolerance (adaptive integrators only).
+		double relativeTolerance = Solvers::DEFAULT_RELATIVE_TOLERANCE;					// Relative error tolerance (adaptive integrators only).
+		double timeStep = Solvers::DEFAULT_TIME_STEP;									// Step size (fixed-step integrators only).
+
+		int zonalDegree = 0;															// Highest zonal harmonic degree of central bodies (0 = point masses only).
+		bool atmosphericDrag = false;													// Whether spacecraft are subject to atmospheric drag.
+		bool solarRadiationPressure = false;											// Whether spacecraft are subject to solar radiation pressure.
+		Solvers::ShadowModel shadowModel = Solvers::ShadowModel::CONICAL;				// The shadow model used by solar radiation pressure.
+		std::vector<std::string> thirdBodies;											// Bodies (not in the scene) that perturb integrated bodies as point masses (e.g., "Body::Moon").
+
+		std::string gravityFieldPath;													// Path to a spherical harmonic gravity field coefficient file (empty = no gravity field).
+		std::string gravityFieldBody = "Body::Earth";									// The body the gravity field belongs to.
+		std::string gravityFieldFrame;													// The body-fixed SPICE frame of the gravity field (empty = "IAU_<body>").
+		int gravityFieldDegree = -1;													// Truncation degree of the gravity field (negative = every degree in the file).
+		int gravityFieldOrder = -1;														// Truncation order of the gravity field (negative = the truncation degree).
+
+		bool ephemerisCache = true;														// Whether SPICE states and orientations are interpolated from cached fits instead of being queried at every step.
+		double ephemerisPositionTolerance = Solvers::DEFAULT_EPHEMERIS_POSITION_TOLERANCE;	// Fit tolerance of cached positions (m).
+		double ephemerisRotationTolerance = Solvers::DEFAULT_EPHEMERIS_ROTATION_TOLERANCE;	// Fit tolerance of cached orientations (rad).
+		bool ephemerisValidation = false;												// Whether cached queries are checked against SPICE, and the max interpolation error reported.
+
+		Dispersions::Config monteCarlo;													// Monte Carlo dispersion analysis run in the background at startup (no runs = none).
 	};
 }
\ No newline at end of file
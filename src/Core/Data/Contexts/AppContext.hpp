@@ -24,6 +24,11 @@ struct AppContext {
         bool        debugging_ShowConsole           = false;
         bool        debugging_VkValidationLayers    = false;
         bool        debugging_VkAPIDump             = false;
+        bool        debugging_PhysicsDiagnostics    = false;
+
+        uint32_t    simulation_PhysicsThreads       = 0;        // Number of threads sharing the acceleration pass (0: one per hardware thread)
+        uint32_t    simulation_SGP4Threads          = 0;        // Number of threads sharing the propagation of SGP4 entities (0: one per hardware thread)
+        double      simulation_ConjunctionThreshold = 5.0;      // Miss distance (km) below which close approaches between SGP4 entities are reported (0: screening disabled)
     } Config;
 
     struct MainThread {
@@ -286,10 +286,19 @@ namespace YAML {
             switch (rhs.propagatorType) {
             case SGP4:
                 node[YAMLData::Physics_Propagator_PropagatorType] = "SGP4";
+                node[YAMLData::Physics_Propagator_TLEPath] = rhs.tlePath;
+                break;
+
+            case KEPLER:
+                node[YAMLData::Physics_Propagator_PropagatorType] = "Kepler";
                 break;
-            }
 
-            node[YAMLData::Physics_Propagator_TLEPath] = rhs.tlePath;
+            case ENCKE:
+                node[YAMLData::Physics_Propagator_PropagatorType] = "Encke";
+                node[YAMLData::Physics_Propagator_StepSize] = rhs.enckeState.stepSize;
+                node[YAMLData::Physics_Propagator_RectificationThreshold] = rhs.enckeState.rectificationThreshold;
+                break;
+            }
 
             return node;
         }
@@ -300,11 +309,31 @@ namespace YAML {
             std::string propagatorType = node[YAMLData::Physics_Propagator_PropagatorType].as<std::string>();
             if (propagatorType == "SGP4")
                 rhs.propagatorType = PhysicsComponent::Propagator::Type::SGP4;
+            else if (propagatorType == "Kepler")
+                rhs.propagatorType = PhysicsComponent::Propagator::Type::KEPLER;
+            else if (propagatorType == "Encke")
+                rhs.propagatorType = PhysicsComponent::Propagator::Type::ENCKE;
             else
                 throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot recognize propagator type " + enquote(propagatorType) + "!");
 
 
-            rhs.tlePath = node[YAMLData::Physics_Propagator_TLEPath].as<std::string>();
+            // Only TLE-based propagators need a TLE file
+            if (rhs.propagatorType == PhysicsComponent::Propagator::Type::SGP4)
+                rhs.tlePath = node[YAMLData::Physics_Propagator_TLEPath].as<std::string>();
+
+            if (rhs.propagatorType == PhysicsComponent::Propagator::Type::ENCKE) {
+                if (node[YAMLData::Physics_Propagator_StepSize])
+                    rhs.enckeState.stepSize = node[YAMLData::Physics_Propagator_StepSize].as<double>();
+
+                if (node[YAMLData::Physics_Propagator_RectificationThreshold])
+                    rhs.enckeState.rectificationThreshold = node[YAMLData::Physics_Propagator_RectificationThreshold].as<double>();
+
+                if (rhs.enckeState.stepSize <= 0.0)
+                    throw Log::RuntimeException(__FUNCTION__, __LINE__, "Encke propagator step size must be positive!");
+
+                if (rhs.enckeState.rectificationThreshold <= 0.0)
+                    throw Log::RuntimeException(__FUNCTION__, __LINE__, "Encke propagator rectification threshold must be positive!");
+            }
 
             return true;
         }
@@ -324,6 +353,10 @@ namespace YAML {
             node[YAMLData::Physics_ShapeParameters_GravParam] = rhs.gravParam;
             node[YAMLData::Physics_ShapeParameters_RotVelocity] = rhs.rotVelocity;
             node[YAMLData::Physics_ShapeParameters_J2] = rhs.j2;
+            node[YAMLData::Physics_ShapeParameters_J3] = rhs.j3;
+            node[YAMLData::Physics_ShapeParameters_J4] = rhs.j4;
+            node[YAMLData::Physics_ShapeParameters_J5] = rhs.j5;
+            node[YAMLData::Physics_ShapeParameters_J6] = rhs.j6;
 
             return node;
         }
@@ -337,6 +370,15 @@ namespace YAML {
             rhs.rotVelocity = node[YAMLData::Physics_ShapeParameters_RotVelocity].as<glm::dvec3>();
             rhs.j2 = node[YAMLData::Physics_ShapeParameters_J2].as<double>();
 
+            if (node[YAMLData::Physics_ShapeParameters_J3])
+                rhs.j3 = node[YAMLData::Physics_ShapeParameters_J3].as<double>();
+            if (node[YAMLData::Physics_ShapeParameters_J4])
+                rhs.j4 = node[YAMLData::Physics_ShapeParameters_J4].as<double>();
+            if (node[YAMLData::Physics_ShapeParameters_J5])
+                rhs.j5 = node[YAMLData::Physics_ShapeParameters_J5].as<double>();
+            if (node[YAMLData::Physics_ShapeParameters_J6])
+                rhs.j6 = node[YAMLData::Physics_ShapeParameters_J6].as<double>();
+
             return true;
         }
     };
@@ -471,6 +513,78 @@ namespace YAML {
 
 
 
+// ----- SpacecraftComponent::FiniteBurn -----
+namespace YAML {
+    template<>
+    struct convert<SpacecraftComponent::FiniteBurn> {
+        static Node encode(const SpacecraftComponent::FiniteBurn &rhs) {
+            Node node;
+
+            node[YAMLData::Spacecraft_Thruster_Burn_StartTime] = rhs.startTime;
+            node[YAMLData::Spacecraft_Thruster_Burn_Duration] = rhs.duration;
+
+            using enum SpacecraftComponent::FiniteBurn::Attitude;
+            switch (rhs.attitude) {
+            case INERTIAL:
+                node[YAMLData::Spacecraft_Thruster_Burn_Attitude] = "Inertial";
+                node[YAMLData::Spacecraft_Thruster_Burn_Direction] = rhs.direction;
+                break;
+
+            case VELOCITY:
+                node[YAMLData::Spacecraft_Thruster_Burn_Attitude] = "Prograde";
+                break;
+
+            case ANTI_VELOCITY:
+                node[YAMLData::Spacecraft_Thruster_Burn_Attitude] = "Retrograde";
+                break;
+            }
+
+            node[YAMLData::Spacecraft_Thruster_Burn_Throttle] = rhs.throttle;
+
+            return node;
+        }
+
+        static bool decode(const Node &node, SpacecraftComponent::FiniteBurn &rhs) {
+            if (!node.IsMap()) return false;
+
+            rhs.startTime = node[YAMLData::Spacecraft_Thruster_Burn_StartTime].as<double>();
+            rhs.duration = node[YAMLData::Spacecraft_Thruster_Burn_Duration].as<double>();
+
+            if (node[YAMLData::Spacecraft_Thruster_Burn_Attitude]) {
+                std::string attitude = node[YAMLData::Spacecraft_Thruster_Burn_Attitude].as<std::string>();
+                if (attitude == "Inertial")
+                    rhs.attitude = SpacecraftComponent::FiniteBurn::Attitude::INERTIAL;
+                else if (attitude == "Prograde")
+                    rhs.attitude = SpacecraftComponent::FiniteBurn::Attitude::VELOCITY;
+                else if (attitude == "Retrograde")
+                    rhs.attitude = SpacecraftComponent::FiniteBurn::Attitude::ANTI_VELOCITY;
+                else
+                    throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot recognize burn attitude " + enquote(attitude) + "!");
+            }
+
+            // Only inertial burns need a thrust direction
+            if (rhs.attitude == SpacecraftComponent::FiniteBurn::Attitude::INERTIAL)
+                rhs.direction = node[YAMLData::Spacecraft_Thruster_Burn_Direction].as<glm::dvec3>();
+
+            if (node[YAMLData::Spacecraft_Thruster_Burn_Throttle])
+                rhs.throttle = node[YAMLData::Spacecraft_Thruster_Burn_Throttle].as<double>();
+
+            if (rhs.duration < 0.0)
+                throw Log::RuntimeException(__FUNCTION__, __LINE__, "Burn duration must not be negative!");
+
+            if (rhs.throttle < 0.0 || rhs.throttle > 1.0)
+                throw Log::RuntimeException(__FUNCTION__, __LINE__, "Burn throttle must be between 0 and 1!");
+
+            if (rhs.attitude == SpacecraftComponent::FiniteBurn::Attitude::INERTIAL && glm::length(rhs.direction) == 0.0)
+                throw Log::RuntimeException(__FUNCTION__, __LINE__, "Inertial burn direction must not be a zero vector!");
+
+            return true;
+        }
+    };
+}
+
+
+
 // ----- SpacecraftComponent::Thruster -----
 namespace YAML {
     template<>
@@ -483,6 +597,9 @@ namespace YAML {
             node[YAMLData::Spacecraft_Thruster_CurrentFuelMass] = rhs.currentFuelMass;
             node[YAMLData::Spacecraft_Thruster_MaxFuelMass] = rhs.maxFuelMass;
 
+            if (!rhs.burns.empty())
+                node[YAMLData::Spacecraft_Thruster_Burns] = rhs.burns;
+
             return node;
         }
 
@@ -494,6 +611,9 @@ namespace YAML {
             rhs.currentFuelMass = node[YAMLData::Spacecraft_Thruster_CurrentFuelMass].as<double>();
             rhs.maxFuelMass = node[YAMLData::Spacecraft_Thruster_MaxFuelMass].as<double>();
 
+            if (node[YAMLData::Spacecraft_Thruster_Burns])
+                rhs.burns = node[YAMLData::Spacecraft_Thruster_Burns].as<std::vector<SpacecraftComponent::FiniteBurn>>();
+
             return true;
         }
     };
@@ -28,6 +28,46 @@ namespace YAMLSimConfig {
     _YAMLStrType CoordSys_Frame         = "Frame";
     _YAMLStrType CoordSys_Epoch         = "Epoch";
     _YAMLStrType CoordSys_EpochFormat   = "EpochFormat";
+    _YAMLStrType Physics                = "Physics";
+    _YAMLStrType Physics_GravitySolver  = "GravitySolver";
+    _YAMLStrType Physics_OpeningAngle   = "OpeningAngle";
+    _YAMLStrType Physics_IntegrationMode    = "IntegrationMode";
+    _YAMLStrType Physics_Integrator         = "Integrator";
+    _YAMLStrType Physics_AbsoluteTolerance  = "AbsoluteTolerance";
+    _YAMLStrType Physics_RelativeTolerance  = "RelativeTolerance";
+    _YAMLStrType Physics_TimeStep           = "TimeStep";
+    _YAMLStrType Physics_ZonalDegree        = "ZonalDegree";
+    _YAMLStrType Physics_AtmosphericDrag    = "AtmosphericDrag";
+    _YAMLStrType Physics_SolarRadiationPressure = "SolarRadiationPressure";
+    _YAMLStrType Physics_ShadowModel        = "ShadowModel";
+    _YAMLStrType Physics_ThirdBodies        = "ThirdBodies";
+    _YAMLStrType Physics_GravityField       = "GravityField";
+    _YAMLStrType GravityField_CoefficientFile   = "CoefficientFile";
+    _YAMLStrType GravityField_CentralBody       = "CentralBody";
+    _YAMLStrType GravityField_BodyFixedFrame    = "BodyFixedFrame";
+    _YAMLStrType GravityField_Degree            = "Degree";
+    _YAMLStrType GravityField_Order             = "Order";
+    _YAMLStrType Physics_EphemerisCache     = "EphemerisCache";
+    _YAMLStrType EphemerisCache_Enabled             = "Enabled";
+    _YAMLStrType EphemerisCache_PositionTolerance   = "PositionTolerance";
+    _YAMLStrType EphemerisCache_RotationTolerance   = "RotationTolerance";
+    _YAMLStrType EphemerisCache_Validate            = "Validate";
+
+    _YAMLStrType MonteCarlo                 = "MonteCarlo";
+    _YAMLStrType MonteCarlo_Runs                = "Runs";
+    _YAMLStrType MonteCarlo_Duration            = "Duration";
+    _YAMLStrType MonteCarlo_Seed                = "Seed";
+    _YAMLStrType MonteCarlo_MeasuredEntity      = "MeasuredEntity";
+    _YAMLStrType MonteCarlo_Dispersions         = "Dispersions";
+    _YAMLStrType Dispersion_Entity                  = "Entity";
+    _YAMLStrType Dispersion_Position                = "Position";
+    _YAMLStrType Dispersion_Velocity                = "Velocity";
+    _YAMLStrType Dispersion_Mass                    = "Mass";
+    _YAMLStrType Dispersion_DragCoefficient         = "DragCoefficient";
+    _YAMLStrType Dispersion_BurnStartTime           = "BurnStartTime";
+    _YAMLStrType Dispersion_BurnDuration            = "BurnDuration";
+    _YAMLStrType Dispersion_BurnThrottle            = "BurnThrottle";
+    _YAMLStrType Dispersion_BurnPointing            = "BurnPointing";
 }
 
 
@@ -39,6 +79,7 @@ namespace YAMLScene {
     _YAMLStrType Entity_Components                      = "Components";
     _YAMLStrType Entity_Components_Type                 = "Type";
     _YAMLStrType Entity_Components_Type_Data            = "Data";
+    _YAMLStrType Catalog                                = "Catalog";
 
     // Values
     _YAMLStrType Core_Identifiers               = "Core::Identifiers";
@@ -81,12 +122,18 @@ namespace YAMLData {
 
 	_YAMLStrType Physics_Propagator_PropagatorType          = "Type";
 	_YAMLStrType Physics_Propagator_TLEPath                 = "TLEPath";
+	_YAMLStrType Physics_Propagator_StepSize                = "StepSize";
+	_YAMLStrType Physics_Propagator_RectificationThreshold  = "RectificationThreshold";
 
 	_YAMLStrType Physics_ShapeParameters_EquatRadius        = "EquatRadius";
 	_YAMLStrType Physics_ShapeParameters_Flattening         = "Flattening";
 	_YAMLStrType Physics_ShapeParameters_GravParam          = "GravParam";
 	_YAMLStrType Physics_ShapeParameters_RotVelocity        = "RotVelocity";
 	_YAMLStrType Physics_ShapeParameters_J2                 = "J2";
+	_YAMLStrType Physics_ShapeParameters_J3                 = "J3";
+	_YAMLStrType Physics_ShapeParameters_J4                 = "J4";
+	_YAMLStrType Physics_ShapeParameters_J5                 = "J5";
+	_YAMLStrType Physics_ShapeParameters_J6                 = "J6";
 
     _YAMLStrType Physics_OrbitalElements_SemiMajorAxis      = "SemiMajorAxis";
     _YAMLStrType Physics_OrbitalElements_Eccentricity       = "Eccentricity";
@@ -104,6 +151,12 @@ namespace YAMLData {
     _YAMLStrType Spacecraft_Thruster_SpecificImpulse        = "SpecificImpulse";
     _YAMLStrType Spacecraft_Thruster_CurrentFuelMass        = "CurrentFuelMass";
     _YAMLStrType Spacecraft_Thruster_MaxFuelMass            = "MaxFuelMass";
+    _YAMLStrType Spacecraft_Thruster_Burns                  = "Burns";
+    _YAMLStrType Spacecraft_Thruster_Burn_StartTime         = "StartTime";
+    _YAMLStrType Spacecraft_Thruster_Burn_Duration          = "Duration";
+    _YAMLStrType Spacecraft_Thruster_Burn_Attitude          = "Attitude";
+    _YAMLStrType Spacecraft_Thruster_Burn_Direction         = "Direction";
+    _YAMLStrType Spacecraft_Thruster_Burn_Throttle          = "Throttle";
     
     _YAMLStrType Render_MeshRenderable_MeshPath             = "MeshPath";
     _YAMLStrType Render_MeshRenderable_VisualScale          = "VisualScale";
@@ -209,6 +262,174 @@ namespace YAMLKeyDescription {
                 SCALAR_STRING
             }
         },
+        { YAMLSimConfig::Physics,
+            {
+                "Optional physics configuration node. Selects the solvers used to integrate bodies that neither have SPICE ephemeris data nor use propagators.",
+                std::nullopt,
+                MAPPING
+            }
+        },
+        { YAMLSimConfig::Physics_GravitySolver,
+            {
+                "Gravity solver ('Direct' or 'BarnesHut'). 'Direct' sums every pairwise interaction exactly; 'BarnesHut' approximates distant groups of bodies with an octree.",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLSimConfig::Physics_OpeningAngle,
+            {
+                "Barnes-Hut opening angle (theta). A tree node is approximated by its center of mass if (node size / distance) < theta. Only used by the 'BarnesHut' solver.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::Physics_IntegrationMode,
+            {
+                "Integration mode ('PerBody' (default) or 'System'). 'System' integrates all bodies together, evaluating each pairwise force once per stage; 'PerBody' integrates bodies one at a time, so results depend on body order.",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLSimConfig::Physics_Integrator,
+            {
+                "Numerical integrator ('RK4', 'RKF45', 'DOPRI5', 'DOP853', 'VelocityVerlet', 'Yoshida4', 'Yoshida6', 'Yoshida8', or 'WisdomHolman'). 'RK4' uses fixed steps; 'RKF45', 'DOPRI5' and 'DOP853' are adaptive embedded Runge-Kutta pairs that choose their own step sizes to meet the error tolerances; 'VelocityVerlet' and the Yoshida methods are fixed-step symplectic integrators whose energy error stays bounded in long gravity-only runs; 'WisdomHolman' solves the Keplerian motion of each body about its primary (the body whose sphere of influence it is in) exactly and only integrates the remaining interactions, allowing steps of days for planetary and satellite systems (it always integrates the whole system, regardless of the integration mode; steps whose perturbations are too large for this splitting fall back to DOPRI5).",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLSimConfig::Physics_AbsoluteTolerance,
+            {
+                "Absolute local error tolerance of adaptive integrators, applied to each position and velocity component.",
+                "m, m/s",
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::Physics_RelativeTolerance,
+            {
+                "Relative local error tolerance of adaptive integrators.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::Physics_TimeStep,
+            {
+                "Step size of fixed-step integrators (RK4 and the symplectic integrators).",
+                "s",
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::Physics_ZonalDegree,
+            {
+                "Highest degree (2 to 6) of the zonal harmonics (J2, J3, ...) of central bodies applied to integrated bodies. 0 disables zonal harmonics.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::Physics_AtmosphericDrag,
+            {
+                "Whether spacecraft are subject to atmospheric drag (cannonball model, using their drag coefficient and reference area). Only Earth's atmosphere is modeled.",
+                std::nullopt,
+                SCALAR_BOOL
+            }
+        },
+        { YAMLSimConfig::Physics_SolarRadiationPressure,
+            {
+                "Whether spacecraft are subject to solar radiation pressure (cannonball model, using their reflectivity coefficient and reference area). Requires a star in the scene.",
+                std::nullopt,
+                SCALAR_BOOL
+            }
+        },
+        { YAMLSimConfig::Physics_ShadowModel,
+            {
+                "Shadow model of solar radiation pressure ('Cylindrical' or 'Conical'). 'Conical' accounts for the penumbra.",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLSimConfig::Physics_ThirdBodies,
+            {
+                "Bodies that are not part of the scene (e.g., 'Body::Moon'), whose gravity perturbs integrated bodies as point masses. Their states are taken from SPICE.",
+                std::nullopt,
+                SEQUENCE
+            }
+        },
+        { YAMLSimConfig::Physics_GravityField,
+            {
+                "Optional spherical harmonic gravity field of a central body. It replaces the zonal harmonics of that body.",
+                std::nullopt,
+                MAPPING
+            }
+        },
+        { YAMLSimConfig::GravityField_CoefficientFile,
+            {
+                "Path to the gravity field coefficient file: an NGA EGM96/EGM2008 file ('n m C S ...' lines) or an ICGEM .gfc file, with fully normalized coefficients.",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLSimConfig::GravityField_CentralBody,
+            {
+                "The body the gravity field belongs to (Default: 'Body::Earth').",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLSimConfig::GravityField_BodyFixedFrame,
+            {
+                "The body-fixed SPICE frame in which the coefficients are defined (e.g., 'ITRF93' if a high-precision Earth orientation kernel is loaded). Defaults to the body's IAU frame.",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLSimConfig::GravityField_Degree,
+            {
+                "Truncation degree of the gravity field. Higher degrees are more accurate, but the cost of an evaluation grows with the square of the degree. Defaults to every degree in the file (up to 360).",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::GravityField_Order,
+            {
+                "Truncation order of the gravity field (at most the degree). Defaults to the degree.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::Physics_EphemerisCache,
+            {
+                "Optional settings of the ephemeris cache, which interpolates the states and orientations of SPICE bodies from Chebyshev fits instead of querying SPICE at every step.",
+                std::nullopt,
+                MAPPING
+            }
+        },
+        { YAMLSimConfig::EphemerisCache_Enabled,
+            {
+                "Whether the ephemeris cache is used (Default: true). If false, SPICE is queried at every step.",
+                std::nullopt,
+                SCALAR_BOOL
+            }
+        },
+        { YAMLSimConfig::EphemerisCache_PositionTolerance,
+            {
+                "Fit tolerance of cached positions (Default: 1 m). Shorter fit windows are used where needed to meet it.",
+                "m",
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::EphemerisCache_RotationTolerance,
+            {
+                "Fit tolerance of cached body orientations (Default: 1e-9 rad).",
+                "rad",
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLSimConfig::EphemerisCache_Validate,
+            {
+                "Whether every cached query is also made directly to SPICE, and the max interpolation error reported (Default: false). Intended for verifying tolerances, as it forfeits the speed-up.",
+                std::nullopt,
+                SCALAR_BOOL
+            }
+        },
 
 
         // Scene keys
@@ -247,6 +468,13 @@ namespace YAMLKeyDescription {
                 MAPPING
             }
         },
+        { YAMLScene::Catalog,
+            {
+                "Path to an element set catalog in TLE or 3LE format, or a catalog of CCSDS Orbit Mean-Elements Messages in KVN, XML, or CSV encoding (e.g., a CelesTrak GP data file), used in place of 'Entity'. Every valid element set in the catalog spawns an SGP4-propagated spacecraft orbiting 'Body::Earth', named after its 3LE name line (or catalog number).\nAn optional 'Components' array (without 'Physics::Propagator' or 'Physics::OrbitalElements') is applied to every spawned spacecraft.",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
 
 
         // Component type identifiers
@@ -401,18 +629,32 @@ namespace YAMLKeyDescription {
             // Physics::Propagator
         { YAMLData::Physics_Propagator_PropagatorType,
             {
-                "Propagator implementation selector (for example 'SGP4').\nIf set to SGP4, the loader will expect a valid TLE file and assume Earth as parent body.",
+                "Propagator implementation selector ('SGP4', 'Kepler' or 'Encke').\nIf set to SGP4, the loader will expect a valid TLE file and assume Earth as parent body.\nIf set to Kepler, the entity follows the exact two-body orbit defined by its initial state relative to the parent body in its Physics::OrbitalElements component, at a constant cost per frame regardless of the time scale.\nIf set to Encke, the entity's deviation from a two-body reference orbit about the parent body is integrated under the gravity of the other bodies and the force models; the reference orbit is rectified whenever the deviation grows too large. For lightly perturbed orbits, this allows far larger steps than integrating the full equations of motion.",
                 std::nullopt,
                 SCALAR_STRING
             }
         },
         { YAMLData::Physics_Propagator_TLEPath,
             {
-                "Relative or absolute path to a Two-Line Element set describing the entity's orbital parameters.",
+                "Relative or absolute path to a Two-Line Element set describing the entity's orbital parameters (SGP4 only).",
                 std::nullopt,
                 SCALAR_STRING
             }
         },
+        { YAMLData::Physics_Propagator_StepSize,
+            {
+                "Maximum integration step size of the deviation from the reference orbit (Encke only). Defaults to 60 s.",
+                "s",
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLData::Physics_Propagator_RectificationThreshold,
+            {
+                "Ratio of the deviation to the distance from the parent body at which the reference orbit is rectified (Encke only). Defaults to 0.01.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
 
             // Physics::ShapeParameters
         { YAMLData::Physics_ShapeParameters_EquatRadius,
@@ -450,6 +692,34 @@ namespace YAMLKeyDescription {
                 SCALAR_NUMBER
             }
         },
+        { YAMLData::Physics_ShapeParameters_J3,
+            {
+                "Optional third zonal harmonic (J3) coefficient. Defaults to 0.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLData::Physics_ShapeParameters_J4,
+            {
+                "Optional fourth zonal harmonic (J4) coefficient. Defaults to 0.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLData::Physics_ShapeParameters_J5,
+            {
+                "Optional fifth zonal harmonic (J5) coefficient. Defaults to 0.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLData::Physics_ShapeParameters_J6,
+            {
+                "Optional sixth zonal harmonic (J6) coefficient. Defaults to 0.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
 
             // Physics::OrbitalElements
         { YAMLData::Physics_OrbitalElements_SemiMajorAxis,
@@ -554,6 +824,48 @@ namespace YAMLKeyDescription {
                 SCALAR_NUMBER
             }
         },
+        { YAMLData::Spacecraft_Thruster_Burns,
+            {
+                "Array of scheduled finite burns. Burns deplete the fuel at the rate set by the thrust and specific impulse, and end early if the fuel runs out.",
+                std::nullopt,
+                SEQUENCE
+            }
+        },
+        { YAMLData::Spacecraft_Thruster_Burn_StartTime,
+            {
+                "Start of the burn, in simulation time (seconds past the simulation epoch).",
+                "s",
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLData::Spacecraft_Thruster_Burn_Duration,
+            {
+                "Duration of the burn.",
+                "s",
+                SCALAR_NUMBER
+            }
+        },
+        { YAMLData::Spacecraft_Thruster_Burn_Attitude,
+            {
+                "Thrust attitude of the burn ('Inertial', 'Prograde' or 'Retrograde'). 'Prograde' and 'Retrograde' thrust along and against the velocity relative to the dominant gravitating body. Defaults to 'Prograde'.",
+                std::nullopt,
+                SCALAR_STRING
+            }
+        },
+        { YAMLData::Spacecraft_Thruster_Burn_Direction,
+            {
+                "Thrust direction in the simulation frame (used only by inertial burns).",
+                std::nullopt,
+                SEQUENCE_ARRAY_3
+            }
+        },
+        { YAMLData::Spacecraft_Thruster_Burn_Throttle,
+            {
+                "Fraction of the max thrust used by the burn (0 to 1). Defaults to 1.",
+                std::nullopt,
+                SCALAR_NUMBER
+            }
+        },
 
             // Render::MeshRenderable
         { YAMLData::Render_MeshRenderable_MeshPath,
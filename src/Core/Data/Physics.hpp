@@ -12,32 +12,37 @@ namespace Physics {
 	struct State {
 		glm::dvec3 position;
 		glm::dvec3 velocity;
+		double mass = 0.0;		// Mass (kg). Only integrated by ODEs that model mass flow (e.g., thrust); others leave its derivative at 0.
 
 		State operator+(const State& other) const {
 			return State{
 				.position = position + other.position,
-				.velocity = velocity + other.velocity
+				.velocity = velocity + other.velocity,
+				.mass = mass + other.mass
 			};
 		}
 
 		State operator-(const State& other) const {
 			return State{
 				.position = position - other.position,
-				.velocity = velocity - other.velocity
+				.velocity = velocity - other.velocity,
+				.mass = mass - other.mass
 			};
 		}
 
 		State operator*(double scalar) const {
 			return State{
 				.position = position * scalar,
-				.velocity = velocity * scalar
+				.velocity = velocity * scalar,
+				.mass = mass * scalar
 			};
 		}
 
 		State operator/(double scalar) const {
 			return State{
 				.position = position / scalar,
-				.velocity = velocity / scalar
+				.velocity = velocity / scalar,
+				.mass = mass / scalar
 			};
 		}
 	};
@@ -48,7 +53,8 @@ namespace Physics {
 	inline State operator*(double scalar, const State& state) {
 		return State{
 			.position = scalar * state.position,
-			.velocity = scalar * state.velocity
+			.velocity = scalar * state.velocity,
+			.mass = scalar * state.mass
 		};
 	}
 
@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 #include <fstream>
+#include <string_view>
 #include <concepts>
 #include <algorithm>
 #include <filesystem>
@@ -16,9 +17,16 @@
 #include <libgen.h> // For dirname
 #include <limits.h> // For PATH_MAX
 #include <unistd.h> // For readlink
+#include <fcntl.h> // For open
+#include <sys/mman.h> // For mmap
+#include <sys/stat.h> // For fstat
 #elif __APPLE__
 #include <mach-o/dyld.h> // For _NSGetExecutablePath
 #include <limits.h> // For PATH_MAX
+#include <unistd.h> // For close
+#include <fcntl.h> // For open
+#include <sys/mman.h> // For mmap
+#include <sys/stat.h> // For fstat
 #endif
 
 #ifdef CreateFile  // Undefine Windows' CreateFile macro to prevent conflict with FilePathUtils::CreateFile
@@ -226,6 +234,116 @@ namespace FilePathUtils {
 	}
 
 
+	/* A read-only memory mapping of a whole file.
+		Unlike FilePathUtils::ReadFile, no buffer is allocated and nothing is copied: the file's pages are read by the OS as they are first accessed, so large files (e.g., element set catalogs) can be parsed in place.
+		The mapping is released when the object is destroyed.
+	*/
+	class MappedFile {
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::string &filePath) { open(filePath); }
+		~MappedFile() { close(); }
+
+		MappedFile(const MappedFile &) = delete;
+		MappedFile &operator=(const MappedFile &) = delete;
+
+
+		/* Maps a file, releasing any previous mapping.
+			@param filePath: The path to the file.
+		*/
+		inline void open(const std::string &filePath) {
+			close();
+
+			if (filePath.empty()) {
+				throw Log::RuntimeException(__FUNCTION__, __LINE__, "File path is empty!");
+			}
+
+#ifdef _WIN32
+			m_file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+			if (m_file == INVALID_HANDLE_VALUE) {
+				throw Log::RuntimeException(__FUNCTION__, __LINE__, "Failed to open file " + enquote(filePath) + "!");
+			}
+
+			LARGE_INTEGER fileSize{};
+			GetFileSizeEx(m_file, &fileSize);
+			m_size = static_cast<size_t>(fileSize.QuadPart);
+
+			if (m_size == 0)
+				return;		// Empty files cannot be mapped
+
+			m_mapping = CreateFileMappingA(m_file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (m_mapping != NULL)
+				m_data = static_cast<const char *>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+			m_fd = ::open(filePath.c_str(), O_RDONLY);
+			if (m_fd < 0) {
+				throw Log::RuntimeException(__FUNCTION__, __LINE__, "Failed to open file " + enquote(filePath) + "!");
+			}
+
+			struct stat fileStat{};
+			fstat(m_fd, &fileStat);
+			m_size = static_cast<size_t>(fileStat.st_size);
+
+			if (m_size == 0)
+				return;		// Empty files cannot be mapped
+
+			void *mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+			if (mapping != MAP_FAILED) {
+				m_data = static_cast<const char *>(mapping);
+				madvise(mapping, m_size, MADV_SEQUENTIAL);
+			}
+#endif
+
+			if (!m_data) {
+				close();
+				throw Log::RuntimeException(__FUNCTION__, __LINE__, "Failed to map file " + enquote(filePath) + " into memory!");
+			}
+		}
+
+
+		/* Releases the mapping. */
+		inline void close() {
+#ifdef _WIN32
+			if (m_data)
+				UnmapViewOfFile(m_data);
+			if (m_mapping != NULL)
+				CloseHandle(m_mapping);
+			if (m_file != INVALID_HANDLE_VALUE)
+				CloseHandle(m_file);
+
+			m_mapping = NULL;
+			m_file = INVALID_HANDLE_VALUE;
+#else
+			if (m_data)
+				munmap(const_cast<char *>(m_data), m_size);
+			if (m_fd >= 0)
+				::close(m_fd);
+
+			m_fd = -1;
+#endif
+
+			m_data = nullptr;
+			m_size = 0;
+		}
+
+
+		inline const char *data() const { return m_data; }
+		inline size_t size() const { return m_size; }
+		inline std::string_view getView() const { return (m_data) ? std::string_view(m_data, m_size) : std::string_view(); }
+
+	private:
+		const char *m_data = nullptr;
+		size_t m_size = 0;
+
+#ifdef _WIN32
+		HANDLE m_file = INVALID_HANDLE_VALUE;
+		HANDLE m_mapping = NULL;
+#else
+		int m_fd = -1;
+#endif
+	};
+
+
 	/* Does a path (file/directory) exist on disk?
 		@param path: The specified path.
 
@@ -3,12 +3,24 @@
 
 #pragma once
 
+#include <mutex>
+
+
 #include <Platform/External/SPICE.hpp>
 
 #include <Core/Application/IO/LoggingManager.hpp>
 
 
 namespace SPICEUtils {
+	/* Gets the mutex that serializes calls into SPICE.
+		CSPICE is not thread-safe (its error state, kernel pool, and segment buffers are global), so every thread that calls it must hold this mutex while one other thread (e.g., the ephemeris prefetch thread) may do so too. It is recursive, so that functions holding it can call each other.
+	*/
+	inline std::recursive_mutex &GetMutex() {
+		static std::recursive_mutex mutex;
+		return mutex;
+	}
+
+
 	/* Queries the availability of an object name.
 		NOTE: This function assumes all necessary kernels have been loaded prior to calling it.
 
@@ -19,6 +31,8 @@ namespace SPICEUtils {
 	inline bool IsObjectAvailable(const std::string &name) {
 		long naifCode;
 		int isAvailable;
+
+		std::lock_guard<std::recursive_mutex> lock(GetMutex());
 		
 		// "Body Name to Code": Translates the name of a body or object to the corresponding SPICE integer ID code.
 		bodn2c_c(name.c_str(), &naifCode, &isAvailable);
@@ -35,6 +49,8 @@ namespace SPICEUtils {
 	inline void CheckFailure(bool throwException, bool logError = false, const std::function<void(const std::string)> handleFailure = [](const std::string _){}) {
 		static constexpr SpiceInt SPICE_MAX_MSG_LEN = 1840; // Source: https://naif.jpl.nasa.gov/pub/naif/toolkit_docs/C/cspice/getmsg_c.html
 
+		std::lock_guard<std::recursive_mutex> lock(GetMutex());
+
 		if (failed_c()) {
 			char explanation[SPICE_MAX_MSG_LEN + 1];
 
@@ -147,8 +163,48 @@ namespace SPICEUtils {
 
 
 		double epochET;
-		str2et_c(utcString, &epochET);
+		{
+			std::lock_guard<std::recursive_mutex> lock(GetMutex());
+			str2et_c(utcString, &epochET);
+		}
 
 		return epochET;
 	}
+
+
+	/* Converts a UTC Julian date, split into whole and fractional days (as in an SGP4 element set), into TDB seconds past the J2000 epoch.
+		Unlike SPICEUtils::tleEpochToET, this does not format or parse the epoch, so it suits converting many epochs (e.g., those of a catalog of element sets).
+
+		@param jd: The whole days of the Julian date.
+		@param jdFraction: The fractional days of the Julian date.
+
+		@return TDB seconds past the J2000 epoch.
+	*/
+	inline double utcJulianDateToET(double jd, double jdFraction) {
+		const double utcSeconds = ((jd - j2000_c()) + jdFraction) * spd_c();
+
+		double deltaET;		// ET - UTC (leap seconds, and the offset of TDB from TAI)
+		{
+			std::lock_guard<std::recursive_mutex> lock(GetMutex());
+			deltet_c(utcSeconds, "UTC", &deltaET);
+		}
+
+		return utcSeconds + deltaET;
+	}
+
+
+	/* Converts TDB seconds past the J2000 epoch into a UTC Julian date (the inverse of SPICEUtils::utcJulianDateToET).
+		@param et: TDB seconds past the J2000 epoch.
+
+		@return The UTC Julian date.
+	*/
+	inline double etToUTCJulianDate(double et) {
+		double deltaET;		// ET - UTC
+		{
+			std::lock_guard<std::recursive_mutex> lock(GetMutex());
+			deltet_c(et, "ET", &deltaET);
+		}
+
+		return j2000_c() + (et - deltaET) / spd_c();
+	}
 }
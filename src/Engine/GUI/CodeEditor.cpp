@@ -3893,7 +3893,8 @@ const CodeEditor::LanguageDefinition &CodeEditor::LanguageDefinition::YAML() {
 			YAMLScene::Entity,
 			YAMLScene::Entity_Components,
 			YAMLScene::Entity_Components_Type,
-			YAMLScene::Entity_Components_Type_Data
+			YAMLScene::Entity_Components_Type_Data,
+			YAMLScene::Catalog
 		};
 		for (auto &k : keywords) {
 			KeywordDescriptor id{};
@@ -3955,6 +3956,8 @@ const CodeEditor::LanguageDefinition &CodeEditor::LanguageDefinition::YAML() {
 
 			YAMLData::Physics_Propagator_PropagatorType,
 			YAMLData::Physics_Propagator_TLEPath,
+			YAMLData::Physics_Propagator_StepSize,
+			YAMLData::Physics_Propagator_RectificationThreshold,
 
 			YAMLData::Physics_ShapeParameters_EquatRadius,
 			YAMLData::Physics_ShapeParameters_Flattening,
@@ -3978,6 +3981,12 @@ const CodeEditor::LanguageDefinition &CodeEditor::LanguageDefinition::YAML() {
 			YAMLData::Spacecraft_Thruster_SpecificImpulse,
 			YAMLData::Spacecraft_Thruster_CurrentFuelMass,
 			YAMLData::Spacecraft_Thruster_MaxFuelMass,
+			YAMLData::Spacecraft_Thruster_Burns,
+			YAMLData::Spacecraft_Thruster_Burn_StartTime,
+			YAMLData::Spacecraft_Thruster_Burn_Duration,
+			YAMLData::Spacecraft_Thruster_Burn_Attitude,
+			YAMLData::Spacecraft_Thruster_Burn_Direction,
+			YAMLData::Spacecraft_Thruster_Burn_Throttle,
 
 			YAMLData::Render_MeshRenderable_MeshPath,
 			YAMLData::Render_MeshRenderable_VisualScale
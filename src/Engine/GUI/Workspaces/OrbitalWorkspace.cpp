@@ -48,6 +48,10 @@ void OrbitalWorkspace::bindEvents() {
 			using enum UpdateEvent::SessionStatus::Status;
 
 			switch (event.sessionStatus) {
+			case PREPARE_FOR_RESET:
+				m_porkchopGrid.cancel();		// The grid must release the coordinate system before the next session replaces it
+				break;
+
 			case INITIALIZED:
 				m_sceneSampleInitialized = true;
 				initPerFrameTextures();
@@ -60,6 +64,14 @@ void OrbitalWorkspace::bindEvents() {
 			}
 		}
 	);
+
+
+	m_eventDispatcher->subscribe<UpdateEvent::CoordinateSystem>(selfIndex,
+		[this](const UpdateEvent::CoordinateSystem &event) {
+			std::lock_guard<std::mutex> lock(m_plannerCoordSystemMutex);
+			m_plannerCoordSystem = event.coordSystem;
+		}
+	);
 }
 
 
@@ -94,7 +106,7 @@ void OrbitalWorkspace::initPanels() {
 	//m_panelCallbacks[m_panelEntityInspector] =		[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderEntityInspectorPanel(); };
 	m_panelCallbacks[m_panelSimulationControl] =	[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderSimulationControlPanel(); };
 	//m_panelCallbacks[m_panelRenderSettings] =		[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderRenderSettingsPanel(); };
-	//m_panelCallbacks[m_panelOrbitalPlanner] =		[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderOrbitalPlannerPanel(); };
+	m_panelCallbacks[m_panelOrbitalPlanner] =		[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderOrbitalPlannerPanel(); };
 	m_panelCallbacks[m_panelDebugConsole] =			[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderDebugConsole(); };
 	m_panelCallbacks[m_panelDebugApp] =				[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderDebugApplication(); };
 	m_panelCallbacks[m_panelSceneResourceTree] =	[this](IWorkspace *ws) { static_cast<OrbitalWorkspace *>(ws)->renderSceneResourceTree(); };
@@ -109,7 +121,7 @@ void OrbitalWorkspace::initPanels() {
 	//GUI::TogglePanel(m_panelMask, m_panelEntityInspector, GUI::TOGGLE_ON);
 	GUI::TogglePanel(m_panelMask, m_panelSimulationControl, GUI::TOGGLE_ON);
 		//GUI::TogglePanel(m_panelMask, m_panelRenderSettings, GUI::TOGGLE_ON);
-		//GUI::TogglePanel(m_panelMask, m_panelOrbitalPlanner, GUI::TOGGLE_ON);
+	GUI::TogglePanel(m_panelMask, m_panelOrbitalPlanner, GUI::TOGGLE_ON);
 	GUI::TogglePanel(m_panelMask, m_panelDebugConsole, GUI::TOGGLE_ON);
 	GUI::TogglePanel(m_panelMask, m_panelSceneResourceTree, GUI::TOGGLE_ON);
 	GUI::TogglePanel(m_panelMask, m_panelDebugApp, GUI::TOGGLE_ON);
@@ -952,8 +964,385 @@ void OrbitalWorkspace::renderRenderSettingsPanel() {
 
 
 void OrbitalWorkspace::renderOrbitalPlannerPanel() {
+	static const std::vector<std::pair<std::string, const ICelestialBody *>> PLANETS = {
+		{ "Mercury", &Body::Mercury }, { "Venus", &Body::Venus }, { "Earth", &Body::Earth }, { "Mars", &Body::Mars },
+		{ "Jupiter", &Body::Jupiter }, { "Saturn", &Body::Saturn }, { "Uranus", &Body::Uranus }, { "Neptune", &Body::Neptune }
+	};
+	static constexpr int COLOR_BANDS = 12;			// Filled contour bands of the plotted quantity
+	static constexpr float CONTOUR_C3_STEP = 5.0f;	// Contour interval of C3 (km²/s²)
+	static constexpr float CONTOUR_VINF_STEP = 1.0f;	// Contour interval of the arrival v∞ (km/s)
+	static constexpr double DAY = 86400.0;
+
+	// Planner settings
+	static size_t departureIndex = 2, arrivalIndex = 3;
+	static std::string departureStartUTC, arrivalStartUTC;
+	static float departureSpan = 365.0f, arrivalSpan = 540.0f;		// Window lengths (days)
+	static int gridSize = 128;
+	static int maxRevolutions = 0;
+	static bool isPlottingC3 = true;
+	static float maxC3 = 60.0f;				// Largest plotted C3 (km²/s²)
+	static float maxVInf = 10.0f;			// Largest plotted arrival v∞ (km/s)
+	static std::string inputError;
+
+
+	// Converts between UTC strings and Ephemeris Time
+	auto toET = [](const std::string &utc, double &et) -> bool {
+		std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+		str2et_c(utc.c_str(), &et);
+
+		const bool isValid = !failed_c();
+		SPICEUtils::CheckFailure(false);
+		return isValid;
+	};
+
+	auto toUTC = [](double et, bool includeTime) -> std::string {
+		static constexpr int LENOUT = 35;
+		char buf[LENOUT];
+
+		std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+		et2utc_c(et, "C", 0, LENOUT, buf);
+		SPICEUtils::CheckFailure(false);
+
+		std::string utc(buf);
+		return includeTime ? utc : utc.substr(0, 11);		// "YYYY MON DD"
+	};
+
+
 	if (ImGui::Begin(GUI::GetPanelName(m_panelOrbitalPlanner), nullptr, m_windowFlags)) {
-		ImGui::TextWrapped("Pushing the boundaries of space exploration, one line of code at a time.");
+		std::shared_ptr<CoordinateSystem> coordSystem;
+		{
+			std::lock_guard<std::mutex> lock(m_plannerCoordSystemMutex);
+			coordSystem = m_plannerCoordSystem.lock();
+		}
+
+		if (!coordSystem) {
+			ImGui::TextWrapped("Load a simulation to plan transfers with its ephemerides.");
+			ImGui::End();
+			return;
+		}
+
+		// Windows start at the simulation epoch by default
+		if (departureStartUTC.empty()) {
+			departureStartUTC = toUTC(coordSystem->getEpochET(), false);
+			arrivalStartUTC = toUTC(coordSystem->getEpochET() + 180.0 * DAY, false);
+		}
+
+		const PorkchopGrid::Status status = m_porkchopGrid.getStatus();
+		const bool isEvaluating = (status == PorkchopGrid::Status::SAMPLING || status == PorkchopGrid::Status::SOLVING);
+
+
+		// ----- TRANSFER -----
+		ImGui::SeparatorText("Transfer");
+		ImGui::BeginDisabled(isEvaluating);
+		{
+			auto bodyCombo = [](const char *label, const char *id, size_t &index) {
+				ImGui::Text("%s", label);
+				ImGui::SameLine();
+				ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth());
+
+				if (ImGui::BeginCombo(id, PLANETS[index].first.c_str(), ImGuiComboFlags_NoArrowButton)) {
+					for (size_t i = 0; i < PLANETS.size(); i++) {
+						bool isSelected = (i == index);
+						if (ImGui::Selectable(PLANETS[i].first.c_str(), isSelected))
+							index = i;
+
+						if (isSelected)
+							ImGui::SetItemDefaultFocus();
+					}
+
+					ImGui::EndCombo();
+				}
+				ImGuiUtils::CursorOnHover();
+			};
+
+			bodyCombo("From:", "##PlannerDepartureCombo", departureIndex);
+			bodyCombo("To:  ", "##PlannerArrivalCombo", arrivalIndex);
+
+			ImGui::Text("Max. revolutions:");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth());
+			ImGui::SliderInt("##PlannerRevolutionsSlider", &maxRevolutions, 0, 3);
+
+
+			// ----- WINDOWS -----
+			ImGui::SeparatorText("Windows (UTC)");
+
+			ImGui::Text("Departure from");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth() * 0.5f);
+			ImGui::InputText("##PlannerDepartureStart", &departureStartUTC);
+			ImGui::SameLine();
+			ImGui::Text("over");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth());
+			ImGui::DragFloat("##PlannerDepartureSpan", &departureSpan, 1.0f, 1.0f, 3650.0f, "%.0f days");
+
+			ImGui::Text("Arrival from  ");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth() * 0.5f);
+			ImGui::InputText("##PlannerArrivalStart", &arrivalStartUTC);
+			ImGui::SameLine();
+			ImGui::Text("over");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth());
+			ImGui::DragFloat("##PlannerArrivalSpan", &arrivalSpan, 1.0f, 1.0f, 7300.0f, "%.0f days");
+
+			ImGui::Text("Grid:");
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth());
+			ImGui::SliderInt("##PlannerGridSlider", &gridSize, 16, 256, "%d epochs per window");
+		}
+		ImGui::EndDisabled();
+
+
+		// ----- EVALUATION -----
+		if (!isEvaluating) {
+			if (ImGui::Button(ImGuiUtils::IconString(ICON_FA_PLAY, "Compute").c_str())) {
+				PorkchopGrid::Config config{
+					.departureBody = PLANETS[departureIndex].second->getIdentifiers().spiceID.value(),
+					.arrivalBody = PLANETS[arrivalIndex].second->getIdentifiers().spiceID.value(),
+					.centralBody = Body::Sun.getIdentifiers().spiceID.value(),
+					.gravParam = Body::Sun.getGravParam(),
+					.departureSteps = static_cast<uint32_t>(gridSize),
+					.arrivalSteps = static_cast<uint32_t>(gridSize),
+					.maxRevolutions = maxRevolutions
+				};
+
+				inputError.clear();
+				if (departureIndex == arrivalIndex)
+					inputError = "The departure and arrival bodies must differ.";
+				else if (!toET(departureStartUTC, config.departureStart) || !toET(arrivalStartUTC, config.arrivalStart))
+					inputError = "Cannot parse the start of a window (e.g., \"2026 SEP 01\").";
+
+				if (inputError.empty()) {
+					config.departureEnd = config.departureStart + departureSpan * DAY;
+					config.arrivalEnd = config.arrivalStart + arrivalSpan * DAY;
+
+					m_porkchopCells.clear();
+					m_porkchopCursor = 0;
+					m_porkchopGrid.start(config, coordSystem, g_appCtx.Config.simulation_PhysicsThreads);
+				}
+			}
+			ImGuiUtils::CursorOnHover();
+		}
+		else {
+			if (ImGui::Button(ImGuiUtils::IconString(ICON_FA_STOP, "Cancel").c_str()))
+				m_porkchopGrid.cancel();
+			ImGuiUtils::CursorOnHover();
+		}
+
+		ImGui::SameLine();
+		ImGui::ProgressBar(m_porkchopGrid.getProgress(), ImVec2(-1.0f, 0.0f));
+
+		if (!inputError.empty()) {
+			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 0, 0, 255));
+			ImGui::TextWrapped("%s", inputError.c_str());
+			ImGui::PopStyleColor();
+		}
+		else if (status == PorkchopGrid::Status::FAILED) {
+			ImGui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 0, 0, 255));
+			ImGui::TextWrapped("%s", m_porkchopGrid.getError().c_str());
+			ImGui::PopStyleColor();
+		}
+		else if (status == PorkchopGrid::Status::COMPLETE || status == PorkchopGrid::Status::CANCELLED) {
+			const PorkchopGrid::Statistics stats = m_porkchopGrid.getStatistics();
+			ImGuiUtils::LightText("%llu cells (%llu with transfers) in %.1f ms, %.3g cells/s",
+				static_cast<unsigned long long>(stats.cells), static_cast<unsigned long long>(stats.transferCells), stats.solvingTime * 1e3, stats.getCellsPerSecond());
+		}
+
+
+		// Rows solved since the last frame
+		m_porkchopGrid.fetchRows(m_porkchopCells, m_porkchopCursor);
+
+		const PorkchopGrid::Config &config = m_porkchopGrid.getConfig();
+		const size_t rowCount = config.departureSteps;
+		const size_t columnCount = config.arrivalSteps;
+
+		if (m_porkchopCells.size() != rowCount * columnCount || m_porkchopCells.empty()) {
+			ImGui::End();
+			return;
+		}
+
+
+		// ----- PORKCHOP PLOT -----
+		ImGui::SeparatorText("Porkchop Plot");
+
+		if (ImGui::RadioButton("C3", isPlottingC3))
+			isPlottingC3 = true;
+		ImGui::SameLine();
+		if (ImGui::RadioButton("Arrival v∞", !isPlottingC3))
+			isPlottingC3 = false;
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(ImGuiUtils::GetAvailableWidth());
+		if (isPlottingC3)
+			ImGui::SliderFloat("##PlannerMaxC3", &maxC3, 5.0f, 200.0f, "Max. %.0f km²/s²");
+		else
+			ImGui::SliderFloat("##PlannerMaxVInf", &maxVInf, 1.0f, 30.0f, "Max. %.1f km/s");
+
+		ImGuiUtils::LightText(isPlottingC3 ? "Filled: C3 (km²/s²). Lines: arrival v∞, every %.0f km/s." : "Filled: arrival v∞ (km/s). Lines: C3, every %.0f km²/s².",
+			isPlottingC3 ? CONTOUR_VINF_STEP : CONTOUR_C3_STEP);
+
+
+		// Plotted (filled) and contoured (lines) quantities, in km²/s² and km/s
+		auto filledValue = [&](const PorkchopGrid::Cell &cell) -> float {
+			return static_cast<float>(isPlottingC3 ? cell.c3 * 1e-6 : cell.arrivalVInf * 1e-3);
+		};
+		auto contourValue = [&](const PorkchopGrid::Cell &cell) -> float {
+			return static_cast<float>(isPlottingC3 ? cell.arrivalVInf * 1e-3 : cell.c3 * 1e-6);
+		};
+		const float maxValue = isPlottingC3 ? maxC3 : maxVInf;
+		const float contourStep = isPlottingC3 ? CONTOUR_VINF_STEP : CONTOUR_C3_STEP;
+		const float maxContour = isPlottingC3 ? maxVInf : maxC3;
+
+
+		// Plot area: arrival epochs on the left axis, departure epochs on the bottom axis
+		const float labelHeight = ImGui::GetTextLineHeightWithSpacing();
+		const float labelWidth = ImGui::CalcTextSize("0000 MMM 00 ").x;
+		const float plotWidth = std::max(ImGuiUtils::GetAvailableWidth() - labelWidth, 100.0f);
+		const float plotHeight = std::max(plotWidth * 0.75f, 100.0f);
+
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		const ImVec2 plotMin(origin.x + labelWidth, origin.y);
+		const ImVec2 plotMax(plotMin.x + plotWidth, plotMin.y + plotHeight);
+		const float cellWidth = plotWidth / rowCount;
+		const float cellHeight = plotHeight / columnCount;
+
+		ImGui::InvisibleButton("##PorkchopPlot", ImVec2(labelWidth + plotWidth, plotHeight + labelHeight));
+		const bool isHovered = ImGui::IsItemHovered();
+
+		ImDrawList *drawList = ImGui::GetWindowDrawList();
+		drawList->AddRectFilled(plotMin, plotMax, ImGuiUtils::ImVec4ToImU32(ColorUtils::sRGBToLinear(0.05f, 0.05f, 0.05f, 1.0f)));
+
+		auto cellCorner = [&](size_t row, size_t column) {
+			return ImVec2(plotMin.x + row * cellWidth, plotMax.y - column * cellHeight);
+		};
+
+
+		// Filled contours: cells colored by band, from blue (low) to red (high)
+		std::array<ImU32, COLOR_BANDS> bandColors;
+		for (int band = 0; band < COLOR_BANDS; band++) {
+			float r, g, b;
+			ImGui::ColorConvertHSVtoRGB(0.66f * (1.0f - (band + 0.5f) / COLOR_BANDS), 0.85f, 0.9f, r, g, b);
+			bandColors[band] = ImGuiUtils::ImVec4ToImU32(ColorUtils::sRGBToLinear(r, g, b, 1.0f));
+		}
+
+		size_t minRow = 0, minColumn = 0;
+		float minValue = std::numeric_limits<float>::infinity();
+
+		for (size_t row = 0; row < rowCount; row++)
+			for (size_t column = 0; column < columnCount; column++) {
+				const PorkchopGrid::Cell &cell = m_porkchopCells[row * columnCount + column];
+				if (!cell.hasTransfer())
+					continue;
+
+				const float value = filledValue(cell);
+				if (value < minValue) {
+					minValue = value;
+					minRow = row;
+					minColumn = column;
+				}
+
+				if (value > maxValue)
+					continue;
+
+				const int band = std::min(static_cast<int>(value / maxValue * COLOR_BANDS), COLOR_BANDS - 1);
+				const ImVec2 corner = cellCorner(row, column);
+				drawList->AddRectFilled(ImVec2(corner.x, corner.y - cellHeight), ImVec2(corner.x + cellWidth, corner.y), bandColors[band]);
+			}
+
+
+		// Contour lines of the other quantity (marching squares over cell centers)
+		const ImU32 contourColor = ImGuiUtils::ImVec4ToImU32(ColorUtils::sRGBToLinear(1.0f, 1.0f, 1.0f, 0.6f));
+
+		for (size_t row = 0; row + 1 < rowCount; row++)
+			for (size_t column = 0; column + 1 < columnCount; column++) {
+				const PorkchopGrid::Cell *corners[4] = {
+					&m_porkchopCells[row * columnCount + column],
+					&m_porkchopCells[(row + 1) * columnCount + column],
+					&m_porkchopCells[(row + 1) * columnCount + column + 1],
+					&m_porkchopCells[row * columnCount + column + 1]
+				};
+				if (!corners[0]->hasTransfer() || !corners[1]->hasTransfer() || !corners[2]->hasTransfer() || !corners[3]->hasTransfer())
+					continue;
+
+				const float values[4] = { contourValue(*corners[0]), contourValue(*corners[1]), contourValue(*corners[2]), contourValue(*corners[3]) };
+				const ImVec2 positions[4] = {
+					cellCorner(row, column) + ImVec2(cellWidth, -cellHeight) * 0.5f,
+					cellCorner(row + 1, column) + ImVec2(cellWidth, -cellHeight) * 0.5f,
+					cellCorner(row + 1, column + 1) + ImVec2(cellWidth, -cellHeight) * 0.5f,
+					cellCorner(row, column + 1) + ImVec2(cellWidth, -cellHeight) * 0.5f
+				};
+
+				const float low = std::min({ values[0], values[1], values[2], values[3] });
+				const float high = std::min(std::max({ values[0], values[1], values[2], values[3] }), maxContour);
+
+				for (float level = std::ceil(low / contourStep) * contourStep; level <= high; level += contourStep) {
+					ImVec2 crossings[4];
+					int crossingCount = 0;
+
+					for (int edge = 0; edge < 4; edge++) {
+						const float a = values[edge] - level, b = values[(edge + 1) % 4] - level;
+						if ((a < 0.0f) != (b < 0.0f)) {
+							const float t = a / (a - b);
+							crossings[crossingCount++] = positions[edge] + (positions[(edge + 1) % 4] - positions[edge]) * t;
+						}
+					}
+
+					for (int i = 0; i + 1 < crossingCount; i += 2)
+						drawList->AddLine(crossings[i], crossings[i + 1], contourColor);
+				}
+			}
+
+
+		// Minimum of the plotted quantity
+		if (std::isfinite(minValue))
+			drawList->AddCircle(cellCorner(minRow, minColumn) + ImVec2(cellWidth, -cellHeight) * 0.5f, 5.0f, IM_COL32(255, 255, 255, 255), 0, 2.0f);
+
+
+		// Axes
+		const ImU32 textColor = ImGui::GetColorU32(ImGuiCol_Text);
+		drawList->AddText(ImVec2(plotMin.x, plotMax.y), textColor, toUTC(config.departureStart, false).c_str());
+		const std::string departureEnd = toUTC(config.departureEnd, false);
+		drawList->AddText(ImVec2(plotMax.x - ImGui::CalcTextSize(departureEnd.c_str()).x, plotMax.y), textColor, departureEnd.c_str());
+		drawList->AddText(ImVec2(origin.x, plotMax.y - labelHeight), textColor, toUTC(config.arrivalStart, false).c_str());
+		drawList->AddText(ImVec2(origin.x, plotMin.y), textColor, toUTC(config.arrivalEnd, false).c_str());
+
+
+		// Details of the hovered cell
+		if (isHovered) {
+			const ImVec2 mouse = ImGui::GetMousePos();
+			const long row = static_cast<long>((mouse.x - plotMin.x) / cellWidth);
+			const long column = static_cast<long>((plotMax.y - mouse.y) / cellHeight);
+
+			if (row >= 0 && row < static_cast<long>(rowCount) && column >= 0 && column < static_cast<long>(columnCount)) {
+				const PorkchopGrid::Cell &cell = m_porkchopCells[row * columnCount + column];
+				const double departureET = m_porkchopGrid.getDepartureET(row);
+				const double arrivalET = m_porkchopGrid.getArrivalET(column);
+
+				ImGui::BeginTooltip();
+				ImGui::Text("Departure: %s", toUTC(departureET, true).c_str());
+				ImGui::Text("Arrival: %s", toUTC(arrivalET, true).c_str());
+				ImGui::Text("Time of flight: %.1f days", (arrivalET - departureET) / DAY);
+
+				if (cell.hasTransfer()) {
+					ImGui::Text("C3: %.2f km²/s²", cell.c3 * 1e-6);
+					ImGui::Text("Arrival v∞: %.3f km/s", cell.arrivalVInf * 1e-3);
+					ImGui::Text("Revolutions: %d", cell.revolutions);
+				}
+				else
+					ImGuiUtils::LightText("No transfer");
+
+				ImGui::EndTooltip();
+			}
+		}
+
+		if (std::isfinite(minValue)) {
+			const PorkchopGrid::Cell &cell = m_porkchopCells[minRow * columnCount + minColumn];
+			ImGuiUtils::LightText("Minimum %s: departure %s, arrival %s (C3 %.2f km²/s², arrival v∞ %.3f km/s)", isPlottingC3 ? "C3" : "arrival v∞",
+				toUTC(m_porkchopGrid.getDepartureET(minRow), false).c_str(), toUTC(m_porkchopGrid.getArrivalET(minColumn), false).c_str(),
+				cell.c3 * 1e-6, cell.arrivalVInf * 1e-3);
+		}
+
 
 		ImGui::End();
 	}
@@ -1294,6 +1683,12 @@ void OrbitalWorkspace::renderSceneResourceTree() {
 						case SGP4:
 							propagatorName = "SGP4";
 							break;
+						case KEPLER:
+							propagatorName = "Kepler";
+							break;
+						case ENCKE:
+							propagatorName = "Encke";
+							break;
 						}
 
 
@@ -1438,6 +1833,44 @@ void OrbitalWorkspace::renderSceneResourceDetails() {
 						}
 						ImGui::Unindent();
 					}
+
+
+					if (m_ecsRegistry->hasComponent<PhysicsComponent::Eclipse>(entityID)) {
+						ImGuiUtils::Padding();
+
+						PhysicsComponent::Eclipse eclipse = m_ecsRegistry->getComponent<PhysicsComponent::Eclipse>(entityID);
+
+						static const char *STATE_NAMES[] = { "Sunlight", "Penumbra", "Annular eclipse", "Umbra" };
+
+						// Times of boundary crossings, in UTC
+						auto formatET = [](double et) -> std::string {
+							if (std::isnan(et))
+								return "N/A";
+
+							static constexpr int LENOUT = 35;
+							char buf[LENOUT];
+
+							std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+							et2utc_c(et, "C", 1, LENOUT, buf);
+
+							return std::string(buf);
+						};
+
+						ImGui::SeparatorText("Illumination");
+						ImGui::Indent();
+						{
+							ImGui::Text("State: %s", STATE_NAMES[static_cast<size_t>(eclipse.state)]);
+							ImGui::Text("Visible fraction of the solar disk: %.4f", eclipse.sunFraction);
+							if (eclipse.occulter != INVALID_ENTITY)
+								ImGui::Text("Occulting body: %s", m_ecsRegistry->getEntity(eclipse.occulter).name.c_str());
+
+							ImGui::Text("Last penumbra entry: %s", formatET(eclipse.penumbraEntryET).c_str());
+							ImGui::Text("Last umbra entry: %s", formatET(eclipse.umbraEntryET).c_str());
+							ImGui::Text("Last umbra exit: %s", formatET(eclipse.umbraExitET).c_str());
+							ImGui::Text("Last penumbra exit: %s", formatET(eclipse.penumbraExitET).c_str());
+						}
+						ImGui::Unindent();
+					}
 				}
 
 
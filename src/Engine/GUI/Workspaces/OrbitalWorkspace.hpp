@@ -5,6 +5,7 @@
 
 #include <any>
 #include <cmath>
+#include <mutex>
 #include <sstream>
 #include <iostream>
 #include <unordered_set>
@@ -20,6 +21,7 @@
 
 #include <Core/Data/Contexts/AppContext.hpp>
 #include <Core/Utils/SpaceUtils.hpp>
+#include <Core/Utils/SPICEUtils.hpp>
 #include <Core/Utils/SystemUtils.hpp>
 
 #include <Platform/Vulkan/Contexts.hpp>
@@ -39,7 +41,9 @@
 #include <Engine/Registry/ECS/Components/SpacecraftComponents.hpp>
 #include <Engine/Rendering/Textures/TextureManager.hpp>
 
+#include <Simulation/Data/Bodies.hpp>
 #include <Simulation/Data/CoordSys.hpp>
+#include <Simulation/Maneuvers/PorkchopGrid.hpp>
 
 
 // Custom hash function for pairs
@@ -145,6 +149,13 @@ private:
 	bool m_simulationConfigSaved = true;
 	bool m_errorMarkersChanged = false;
 
+			// Orbital planner
+	PorkchopGrid m_porkchopGrid;
+	std::vector<PorkchopGrid::Cell> m_porkchopCells;		// Rows fetched from the grid so far
+	size_t m_porkchopCursor = 0;
+	std::weak_ptr<CoordinateSystem> m_plannerCoordSystem;	// The physics system's coordinate system (see UpdateEvent::CoordinateSystem)
+	std::mutex m_plannerCoordSystemMutex;					// Guards m_plannerCoordSystem, which is set from the scene loading thread
+
 
 	void bindEvents();
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <atomic>
+#include <limits>
 
 
 #include "CoreComponents.hpp"
@@ -13,7 +14,10 @@
 
 #include <Platform/External/GLM.hpp>
 
+#include <Simulation/Eclipses/EclipseTracker.hpp>
 #include <Simulation/Propagators/SGP4/TLE.hpp>
+#include <Simulation/Propagators/Kepler/KeplerPropagator.hpp>
+#include <Simulation/Propagators/Encke/EnckePropagator.hpp>
 
 
 namespace PhysicsComponent {
@@ -39,6 +43,7 @@ namespace PhysicsComponent {
 		double gravParam;						// Gravitational parameter (m^3 / s^(-2))
 		glm::dvec3 rotVelocity;					// Angular/Rotational velocity (rad/s)
 		double j2;								// J2 oblateness coefficient
+		double j3 = 0.0, j4 = 0.0, j5 = 0.0, j6 = 0.0;	// Higher zonal harmonic coefficients (optional)
 	};
 
 
@@ -58,6 +63,20 @@ namespace PhysicsComponent {
 	};
 
 
+
+	/* Illumination of a spacecraft by the Sun, occulted by celestial bodies (see EclipseTracker). */
+	struct Eclipse {
+		EclipseTracker::State state = EclipseTracker::State::SUNLIGHT;
+		double sunFraction = 1.0;					// Visible fraction of the solar disk
+		EntityID occulter = INVALID_ENTITY;			// The body occulting the Sun (INVALID_ENTITY in full sunlight)
+
+		// Times of the latest shadow boundary crossings, in Ephemeris Time (NaN until the first crossing)
+		double penumbraEntryET = std::numeric_limits<double>::quiet_NaN();
+		double umbraEntryET = std::numeric_limits<double>::quiet_NaN();		// Entry into the umbra (or antumbra, for annular occultations)
+		double umbraExitET = std::numeric_limits<double>::quiet_NaN();
+		double penumbraExitET = std::numeric_limits<double>::quiet_NaN();
+	};
+
 	struct NutationAngles {
 		double deltaPsi;				// Nutation in longitude (radians). This is the change in the celestial longitude of a body caused by nutation.
 		double deltaEpsilon;			// Nutation in obliquity (radians). This is the change in the obliquity of the ecliptic (the tilt of a body's axis) caused by nutation.
@@ -78,7 +97,9 @@ namespace PhysicsComponent {
 
 	struct Propagator {
 		enum class Type {
-			SGP4
+			SGP4,
+			KEPLER,
+			ENCKE
 		};
 
 		Type propagatorType;			// The type of propagator used.
@@ -89,5 +110,11 @@ namespace PhysicsComponent {
 		double tleEpochET;				// The TLE's epoch, measured as TDB seconds elapsed since the J2000 epoch.
 
 		TLE tle;						// The TLE instance.
+		bool isTLEInitialized = false;	// Whether the TLE instance is already parsed and initialized (e.g., by a catalog loader), so that it need not be parsed from the TLE lines.
+
+		EntityID parentBody;						// The central body (Kepler and Encke only). This is taken from the entity's orbital elements.
+		KeplerPropagator::Orbit keplerOrbit{};		// The reference state relative to the central body (Kepler only). This is captured from the entity's state at the simulation epoch.
+		EnckePropagator::State enckeState{};		// The reference conic and the deviation from it (Encke only). The first reference conic is captured from the entity's state at the simulation epoch.
+		bool hasKeplerOrbit = false;				// Whether the reference state has been captured (Kepler and Encke only).
 	};
 }
\ No newline at end of file
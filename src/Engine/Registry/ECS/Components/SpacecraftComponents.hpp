@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <vector>
+
+
 #include <Platform/External/GLM.hpp>
 
 
@@ -16,11 +19,29 @@ namespace SpacecraftComponent {
 	};
 
 
+	/* A scheduled finite burn of a thruster. */
+	struct FiniteBurn {
+		enum class Attitude {
+			INERTIAL,			// Along a fixed direction in the simulation frame
+			VELOCITY,			// Along the velocity relative to the dominant gravitating body (prograde)
+			ANTI_VELOCITY		// Against the velocity relative to the dominant gravitating body (retrograde)
+		};
+
+		double startTime;							// Start of the burn, in simulation time (seconds past the simulation epoch)
+		double duration;							// Duration of the burn (s)
+		Attitude attitude = Attitude::VELOCITY;		// Thrust attitude mode
+		glm::dvec3 direction{ 1.0, 0.0, 0.0 };		// Thrust direction in the simulation frame (inertial attitude only)
+		double throttle = 1.0;						// Fraction of the max thrust (0 to 1)
+	};
+
+
 	/* Properties of spacecraft thrusters. */
 	struct Thruster {
 		double thrustMagnitude;			// Max thrust of the main engine (N)
 		double specificImpulse;			// Isp for propellant consumption (s)
 		double currentFuelMass;			// Remaining fuel mass (kg)
 		double maxFuelMass;				// Total fuel capacity (kg)
+
+		std::vector<FiniteBurn> burns;	// Scheduled burns (optional)
 	};
-}
\ No newline at end of file
+}
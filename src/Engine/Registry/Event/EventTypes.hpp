@@ -18,6 +18,9 @@
 #include <Engine/Rendering/Data/Geometry.hpp>
 
 
+class CoordinateSystem;
+
+
 // All events (used as bitfield flags)
 using EventFlags = unsigned int;
 enum EventFlag {
@@ -51,9 +54,11 @@ enum EventFlag {
 	EVENT_FLAG_REQUEST_REINIT_IMGUI_BIT					= 1 << 24,
 
 	EVENT_FLAG_CONFIG_SIMULATION_FILE_PARSED_BIT		= 1 << 25,
-	EVENT_FLAG_CONFIG_SIMULATION_ERROR_BIT				= 1 << 26
+	EVENT_FLAG_CONFIG_SIMULATION_ERROR_BIT				= 1 << 26,
+
+	EVENT_FLAG_UPDATE_COORDINATE_SYSTEM_BIT				= 1 << 27
 };
-constexpr size_t EVENT_FLAG_COUNT = 26 + 1; // Highest bit position + 1
+constexpr size_t EVENT_FLAG_COUNT = 27 + 1; // Highest bit position + 1
 
 
 namespace InitEvent {
@@ -280,6 +285,14 @@ namespace UpdateEvent {
 
 		VmaAllocator vmaAllocator = VK_NULL_HANDLE;
 	};
+
+
+	/* Used when the physics system has (re)created its coordinate system, i.e., when the SPICE kernels of a scene have been loaded. */
+	struct CoordinateSystem {
+		const EventFlag eventFlag = EVENT_FLAG_UPDATE_COORDINATE_SYSTEM_BIT;
+
+		std::weak_ptr<::CoordinateSystem> coordSystem;		// Weak, so that listeners never keep the coordinate system alive (its destruction clears the kernels, which may by then belong to the next session)
+	};
 }
 
 
@@ -66,6 +66,12 @@ void SceneLoader::loadDeserialBindings() {
             shapeParams.rotVelocity = celestialBody->getRotVelocity();
             shapeParams.j2 = celestialBody->getJ2();
 
+            const std::array<double, 4> higherZonals = celestialBody->getHigherZonals();
+            shapeParams.j3 = higherZonals[0];
+            shapeParams.j4 = higherZonals[1];
+            shapeParams.j5 = higherZonals[2];
+            shapeParams.j6 = higherZonals[3];
+
             RenderComponent::MeshRenderable meshRenderable{};
             meshRenderable.meshPath = celestialBody->getMeshPath();
             meshRenderable.meshRange = m_geometryLoader.loadGeometryFromFile(meshRenderable.meshPath);
@@ -174,7 +180,7 @@ void SceneLoader::loadDeserialBindings() {
             YAMLUtils::GetComponentData(&propagator, ctx->selfComponents->at(ctx->currentComponentType));
 
             // Get the last 2 compact lines in the TLE
-            {
+            if (propagator.propagatorType == PhysicsComponent::Propagator::Type::SGP4) {
                 propagator.tlePath = FilePathUtils::JoinPaths(ROOT_DIR, propagator.tlePath);
                 std::vector<std::string> tleLines = FilePathUtils::GetFileLines(
                     FilePathUtils::ReadFile(propagator.tlePath)
@@ -197,6 +203,13 @@ void SceneLoader::loadDeserialBindings() {
                 m_ecsRegistry->addOrUpdateComponent(ctx->entityID, orbitalElems);
             }
 
+            // If propagator is Kepler or Encke, the parent body must be specified in the entity's orbital elements
+            const bool needsParentBody = (propagator.propagatorType == PhysicsComponent::Propagator::Type::KEPLER || propagator.propagatorType == PhysicsComponent::Propagator::Type::ENCKE);
+            if (needsParentBody && !ctx->selfComponents->count(YAMLScene::Physics_OrbitalElements)) {
+                throw Log::RuntimeException(__FUNCTION__, __LINE__, "A Kepler or Encke propagator requires a " + enquote(YAMLScene::Physics_OrbitalElements) + " component to specify its parent body!");
+                throw;
+            }
+
 
             m_ecsRegistry->addOrUpdateComponent(ctx->entityID, propagator);
         }
@@ -222,8 +235,12 @@ void SceneLoader::loadDeserialBindings() {
             auto *ctx = static_cast<YAMLParseCtx *>(context);
 
             if (ctx->selfComponents->count(YAMLScene::Physics_Propagator)) {
-                throw Log::RuntimeException(__FUNCTION__, __LINE__, "If a Propagator is specified, OrbitalElements cannot be overridden, and must be derived from it.");
-                throw;
+                // Only TLE-based propagators define their own orbital elements
+                const YAML::Node propagatorTypeNode = ctx->selfComponents->at(YAMLScene::Physics_Propagator)[YAMLScene::Entity_Components_Type_Data][YAMLData::Physics_Propagator_PropagatorType];
+                if (!propagatorTypeNode || propagatorTypeNode.as<std::string>() == "SGP4") {
+                    throw Log::RuntimeException(__FUNCTION__, __LINE__, "If an SGP4 Propagator is specified, OrbitalElements cannot be overridden, and must be derived from it.");
+                    throw;
+                }
             }
 
             PhysicsComponent::OrbitalElements orbitalElems{};
@@ -501,6 +518,154 @@ void SceneLoader::processMetadata(Application::YAMLFileConfig *fileConfig, Appli
                     YAMLUtils::TryGetEntryData(&simConfig->epochFormat, YAMLSimConfig::CoordSys_EpochFormat, coordSysNode);
                 }
             }
+
+
+            // Physics (optional)
+            const auto physicsNode = simCfgRoot[YAMLSimConfig::Physics];
+            if (physicsNode) {
+                std::string gravitySolverStr;
+                if (YAMLUtils::TryGetEntryData(&gravitySolverStr, YAMLSimConfig::Physics_GravitySolver, physicsNode)) {
+                    if (Solvers::GravityStrToEnumMap.count(gravitySolverStr))
+                        simConfig->gravitySolver = Solvers::GravityStrToEnumMap.at(gravitySolverStr);
+                    else
+                        addErrorMarker(physicsNode[YAMLSimConfig::Physics_GravitySolver].Mark().line, "Simulation configuration error", "Unknown gravity solver " + enquote(gravitySolverStr) + "!");
+                }
+
+                if (YAMLUtils::TryGetEntryData(&simConfig->openingAngle, YAMLSimConfig::Physics_OpeningAngle, physicsNode) && simConfig->openingAngle < 0.0)
+                    addErrorMarker(physicsNode[YAMLSimConfig::Physics_OpeningAngle].Mark().line, "Simulation configuration error", "The Barnes-Hut opening angle cannot be negative!");
+
+                std::string integrationModeStr;
+                if (YAMLUtils::TryGetEntryData(&integrationModeStr, YAMLSimConfig::Physics_IntegrationMode, physicsNode)) {
+                    if (Solvers::IntegrationModeStrToEnumMap.count(integrationModeStr))
+                        simConfig->integrationMode = Solvers::IntegrationModeStrToEnumMap.at(integrationModeStr);
+                    else
+                        addErrorMarker(physicsNode[YAMLSimConfig::Physics_IntegrationMode].Mark().line, "Simulation configuration error", "Unknown integration mode " + enquote(integrationModeStr) + "!");
+                }
+
+                std::string integratorStr;
+                if (YAMLUtils::TryGetEntryData(&integratorStr, YAMLSimConfig::Physics_Integrator, physicsNode)) {
+                    if (Solvers::IntegratorStrToEnumMap.count(integratorStr))
+                        simConfig->integrator = Solvers::IntegratorStrToEnumMap.at(integratorStr);
+                    else
+                        addErrorMarker(physicsNode[YAMLSimConfig::Physics_Integrator].Mark().line, "Simulation configuration error", "Unknown integrator " + enquote(integratorStr) + "!");
+                }
+
+                if (YAMLUtils::TryGetEntryData(&simConfig->absoluteTolerance, YAMLSimConfig::Physics_AbsoluteTolerance, physicsNode) && simConfig->absoluteTolerance <= 0.0)
+                    addErrorMarker(physicsNode[YAMLSimConfig::Physics_AbsoluteTolerance].Mark().line, "Simulation configuration error", "The absolute error tolerance must be positive!");
+
+                if (YAMLUtils::TryGetEntryData(&simConfig->relativeTolerance, YAMLSimConfig::Physics_RelativeTolerance, physicsNode) && simConfig->relativeTolerance < 0.0)
+                    addErrorMarker(physicsNode[YAMLSimConfig::Physics_RelativeTolerance].Mark().line, "Simulation configuration error", "The relative error tolerance cannot be negative!");
+
+                if (YAMLUtils::TryGetEntryData(&simConfig->timeStep, YAMLSimConfig::Physics_TimeStep, physicsNode) && simConfig->timeStep <= 0.0)
+                    addErrorMarker(physicsNode[YAMLSimConfig::Physics_TimeStep].Mark().line, "Simulation configuration error", "The time step must be positive!");
+
+                if (YAMLUtils::TryGetEntryData(&simConfig->zonalDegree, YAMLSimConfig::Physics_ZonalDegree, physicsNode) && (simConfig->zonalDegree < 0 || simConfig->zonalDegree > Solvers::MAX_ZONAL_DEGREE))
+                    addErrorMarker(physicsNode[YAMLSimConfig::Physics_ZonalDegree].Mark().line, "Simulation configuration error", "The zonal harmonic degree must be between 0 and " + std::to_string(Solvers::MAX_ZONAL_DEGREE) + "!");
+
+                YAMLUtils::TryGetEntryData(&simConfig->atmosphericDrag, YAMLSimConfig::Physics_AtmosphericDrag, physicsNode);
+                YAMLUtils::TryGetEntryData(&simConfig->solarRadiationPressure, YAMLSimConfig::Physics_SolarRadiationPressure, physicsNode);
+
+                std::string shadowModelStr;
+                if (YAMLUtils::TryGetEntryData(&shadowModelStr, YAMLSimConfig::Physics_ShadowModel, physicsNode)) {
+                    if (Solvers::ShadowModelStrToEnumMap.count(shadowModelStr))
+                        simConfig->shadowModel = Solvers::ShadowModelStrToEnumMap.at(shadowModelStr);
+                    else
+                        addErrorMarker(physicsNode[YAMLSimConfig::Physics_ShadowModel].Mark().line, "Simulation configuration error", "Unknown shadow model " + enquote(shadowModelStr) + "!");
+                }
+
+                if (YAMLUtils::TryGetEntryData(&simConfig->thirdBodies, YAMLSimConfig::Physics_ThirdBodies, physicsNode)) {
+                    for (const std::string &bodyName : simConfig->thirdBodies) {
+                        try {
+                            Body::GetCelestialBody(bodyName);
+                        }
+                        catch (const Log::RuntimeException &) {
+                            addErrorMarker(physicsNode[YAMLSimConfig::Physics_ThirdBodies].Mark().line, "Simulation configuration error", "Unknown third body " + enquote(bodyName) + "!");
+                        }
+                    }
+                }
+
+                const auto gravityFieldNode = physicsNode[YAMLSimConfig::Physics_GravityField];
+                if (gravityFieldNode) {
+                    if (!YAMLUtils::TryGetEntryData(&simConfig->gravityFieldPath, YAMLSimConfig::GravityField_CoefficientFile, gravityFieldNode))
+                        addErrorMarker(gravityFieldNode.Mark().line, "Simulation configuration error", "The gravity field does not specify a coefficient file!");
+
+                    if (YAMLUtils::TryGetEntryData(&simConfig->gravityFieldBody, YAMLSimConfig::GravityField_CentralBody, gravityFieldNode)) {
+                        try {
+                            Body::GetCelestialBody(simConfig->gravityFieldBody);
+                        }
+                        catch (const Log::RuntimeException &) {
+                            addErrorMarker(gravityFieldNode[YAMLSimConfig::GravityField_CentralBody].Mark().line, "Simulation configuration error", "Unknown gravity field body " + enquote(simConfig->gravityFieldBody) + "!");
+                        }
+                    }
+
+                    YAMLUtils::TryGetEntryData(&simConfig->gravityFieldFrame, YAMLSimConfig::GravityField_BodyFixedFrame, gravityFieldNode);
+
+                    if (YAMLUtils::TryGetEntryData(&simConfig->gravityFieldDegree, YAMLSimConfig::GravityField_Degree, gravityFieldNode) && (simConfig->gravityFieldDegree < 2 || simConfig->gravityFieldDegree > GravityField::MAX_DEGREE))
+                        addErrorMarker(gravityFieldNode[YAMLSimConfig::GravityField_Degree].Mark().line, "Simulation configuration error", "The gravity field degree must be between 2 and " + std::to_string(GravityField::MAX_DEGREE) + "!");
+
+                    if (YAMLUtils::TryGetEntryData(&simConfig->gravityFieldOrder, YAMLSimConfig::GravityField_Order, gravityFieldNode) && simConfig->gravityFieldOrder < 0)
+                        addErrorMarker(gravityFieldNode[YAMLSimConfig::GravityField_Order].Mark().line, "Simulation configuration error", "The gravity field order cannot be negative!");
+                }
+
+                const auto ephemerisCacheNode = physicsNode[YAMLSimConfig::Physics_EphemerisCache];
+                if (ephemerisCacheNode) {
+                    YAMLUtils::TryGetEntryData(&simConfig->ephemerisCache, YAMLSimConfig::EphemerisCache_Enabled, ephemerisCacheNode);
+                    YAMLUtils::TryGetEntryData(&simConfig->ephemerisValidation, YAMLSimConfig::EphemerisCache_Validate, ephemerisCacheNode);
+
+                    if (YAMLUtils::TryGetEntryData(&simConfig->ephemerisPositionTolerance, YAMLSimConfig::EphemerisCache_PositionTolerance, ephemerisCacheNode) && simConfig->ephemerisPositionTolerance <= 0.0)
+                        addErrorMarker(ephemerisCacheNode[YAMLSimConfig::EphemerisCache_PositionTolerance].Mark().line, "Simulation configuration error", "The ephemeris position tolerance must be positive!");
+
+                    if (YAMLUtils::TryGetEntryData(&simConfig->ephemerisRotationTolerance, YAMLSimConfig::EphemerisCache_RotationTolerance, ephemerisCacheNode) && simConfig->ephemerisRotationTolerance <= 0.0)
+                        addErrorMarker(ephemerisCacheNode[YAMLSimConfig::EphemerisCache_RotationTolerance].Mark().line, "Simulation configuration error", "The ephemeris rotation tolerance must be positive!");
+                }
+            }
+
+
+            // Monte Carlo dispersion analysis (optional)
+            const auto monteCarloNode = simCfgRoot[YAMLSimConfig::MonteCarlo];
+            if (monteCarloNode) {
+                Dispersions::Config &monteCarlo = simConfig->monteCarlo;
+
+                YAMLUtils::TryGetEntryData(&monteCarlo.runs, YAMLSimConfig::MonteCarlo_Runs, monteCarloNode);
+                YAMLUtils::TryGetEntryData(&monteCarlo.seed, YAMLSimConfig::MonteCarlo_Seed, monteCarloNode);
+                YAMLUtils::TryGetEntryData(&monteCarlo.measuredEntity, YAMLSimConfig::MonteCarlo_MeasuredEntity, monteCarloNode);
+
+                if (!YAMLUtils::TryGetEntryData(&monteCarlo.duration, YAMLSimConfig::MonteCarlo_Duration, monteCarloNode) || monteCarlo.duration <= 0.0)
+                    addErrorMarker(monteCarloNode.Mark().line, "Simulation configuration error", "The Monte Carlo analysis duration must be positive!");
+
+                const auto dispersionsNode = monteCarloNode[YAMLSimConfig::MonteCarlo_Dispersions];
+                if (!dispersionsNode || !dispersionsNode.IsSequence() || dispersionsNode.size() == 0)
+                    addErrorMarker(monteCarloNode.Mark().line, "Simulation configuration error", "The Monte Carlo analysis does not specify any dispersions!");
+
+                else {
+                    for (const auto &dispersionNode : dispersionsNode) {
+                        Dispersions::Spec spec;
+
+                        if (!YAMLUtils::TryGetEntryData(&spec.entity, YAMLSimConfig::Dispersion_Entity, dispersionNode))
+                            addErrorMarker(dispersionNode.Mark().line, "Simulation configuration error", "A Monte Carlo dispersion does not specify its entity!");
+
+                        YAMLUtils::TryGetEntryData(&spec.positionSigma, YAMLSimConfig::Dispersion_Position, dispersionNode);
+                        YAMLUtils::TryGetEntryData(&spec.velocitySigma, YAMLSimConfig::Dispersion_Velocity, dispersionNode);
+                        YAMLUtils::TryGetEntryData(&spec.massSigma, YAMLSimConfig::Dispersion_Mass, dispersionNode);
+                        YAMLUtils::TryGetEntryData(&spec.dragCoefficientSigma, YAMLSimConfig::Dispersion_DragCoefficient, dispersionNode);
+                        YAMLUtils::TryGetEntryData(&spec.burnStartSigma, YAMLSimConfig::Dispersion_BurnStartTime, dispersionNode);
+                        YAMLUtils::TryGetEntryData(&spec.burnDurationSigma, YAMLSimConfig::Dispersion_BurnDuration, dispersionNode);
+                        YAMLUtils::TryGetEntryData(&spec.burnThrottleSigma, YAMLSimConfig::Dispersion_BurnThrottle, dispersionNode);
+                        YAMLUtils::TryGetEntryData(&spec.burnPointingSigma, YAMLSimConfig::Dispersion_BurnPointing, dispersionNode);
+
+                        const double minSigma = std::min({
+                            spec.positionSigma.x, spec.positionSigma.y, spec.positionSigma.z,
+                            spec.velocitySigma.x, spec.velocitySigma.y, spec.velocitySigma.z,
+                            spec.massSigma, spec.dragCoefficientSigma,
+                            spec.burnStartSigma, spec.burnDurationSigma, spec.burnThrottleSigma, spec.burnPointingSigma
+                        });
+                        if (minSigma < 0.0)
+                            addErrorMarker(dispersionNode.Mark().line, "Simulation configuration error", "The dispersions of " + enquote(spec.entity) + " cannot be negative!");
+
+                        monteCarlo.specs.push_back(spec);
+                    }
+                }
+            }
         }
 
         else {
@@ -553,6 +718,7 @@ void SceneLoader::processScene(const YAML::Node &rootNode, std::string &currentE
     std::unordered_map<EntityName, EntityID> sceneEntities;
 
     std::vector<YAMLParseCtx> entityParseContexts;
+    std::vector<YAML::Node> catalogNodes;
 
     std::unordered_map<EntityName,
         std::unordered_map<ComponentName, YAML::Node>
@@ -560,6 +726,12 @@ void SceneLoader::processScene(const YAML::Node &rootNode, std::string &currentE
 
         // ----- LOAD ENTITIES & COMPONENTS -----
     for (auto entityNode : sceneRoot) {
+        // Element set catalogs are spawned once every entity they refer to (i.e., Earth) is loaded
+        if (entityNode[YAMLScene::Catalog]) {
+            catalogNodes.push_back(entityNode);
+            continue;
+        }
+
         // Create entity
         EntityName entityName = entityNode[YAMLScene::Entity].as<std::string>();
 
@@ -672,6 +844,172 @@ void SceneLoader::processScene(const YAML::Node &rootNode, std::string &currentE
             }
         }
     }
+
+
+        // ----- SPAWN ELEMENT SET CATALOGS -----
+    for (const YAML::Node &catalogNode : catalogNodes) {
+        currentEntity = catalogNode[YAMLScene::Catalog].as<std::string>();
+        currentComponent = YAMLScene::Catalog;
+
+        const int line = catalogNode.Mark().is_null() ? -1 : catalogNode.Mark().line;
+
+        try {
+            processCatalog(catalogNode, sceneEntities);
+        }
+        catch (const Log::RuntimeException &e) {
+            addErrorMarker(line, getExceptionHeader(currentEntity, currentComponent), e.what());
+        }
+        catch (const YAML::Exception &e) {
+            addErrorMarker(line, getExceptionHeader(currentEntity, currentComponent), getYAMLExceptionMsg(e, ""));
+        }
+    }
+}
+
+
+void SceneLoader::processCatalog(const YAML::Node &catalogNode, std::unordered_map<std::string, EntityID> &sceneEntities) {
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t PROGRESS_INTERVAL = 1000;      // Spawned objects between progress updates
+
+    const std::string catalogName = catalogNode[YAMLScene::Catalog].as<std::string>();
+    const std::string catalogPath = FilePathUtils::JoinPaths(ROOT_DIR, catalogName);
+
+    if (!sceneEntities.count(YAMLScene::Body_Earth)) {
+        throw Log::RuntimeException(__FUNCTION__, __LINE__, "An element set catalog requires " + enquote(YAMLScene::Body_Earth) + " in the scene, since its objects orbit Earth!");
+        throw;
+    }
+
+
+    // Components shared by every object of the catalog
+    std::unordered_map<std::string, YAML::Node> templateComponents;
+
+    for (YAML::Node componentNode : catalogNode[YAMLScene::Entity_Components]) {
+        const std::string componentType = componentNode[YAMLScene::Entity_Components_Type].as<std::string>();
+
+        if (componentType == YAMLScene::Physics_Propagator || componentType == YAMLScene::Physics_OrbitalElements) {
+            throw Log::RuntimeException(__FUNCTION__, __LINE__, "Catalog objects cannot override " + enquote(componentType) + ": They are propagated with SGP4 from their element sets.");
+            throw;
+        }
+
+        if (!m_serialRegistry.containsDeserialLogic(componentType)) {
+            throw Log::RuntimeException(__FUNCTION__, __LINE__, "Unrecognized or unsupported component " + enquote(componentType));
+            throw;
+        }
+
+        templateComponents[componentType] = componentNode;
+    }
+
+
+    // Load the catalog (parsing and initializing element sets across every hardware thread)
+    m_eventDispatcher->dispatch(UpdateEvent::SceneLoadProgress{
+        .progress = 0.85f,
+        .message = "[" + catalogName + "] Loading element sets..."
+    });
+
+    const Clock::time_point start = Clock::now();
+
+    TLECatalog::Statistics stats{};
+    std::vector<TLECatalog::Entry> entries;
+    {
+        ThreadPool pool;
+        pool.init("SCENE_CATALOG", 0);
+
+        // OMM catalogs are recognized by their content, since catalog services do not name files consistently
+        entries = OMMCatalog::IsOMMFile(catalogPath) ?
+            OMMCatalog::Load(catalogPath, pool, &stats) :
+            TLECatalog::Load(catalogPath, pool, &stats);
+    }
+
+    if (entries.empty()) {
+        throw Log::RuntimeException(__FUNCTION__, __LINE__, "The catalog " + enquote(catalogName) + " contains no valid element sets!");
+        throw;
+    }
+
+
+    // Spawn objects
+    const Clock::time_point spawnStart = Clock::now();
+    const EntityID earthID = sceneEntities.at(YAMLScene::Body_Earth);
+    EntityID templateEntityID{};
+
+        // Copies a component of the first object (if it has one) to another object
+    auto copyFromTemplate = [&]<typename Component>(EntityID entityID) {
+        if (m_ecsRegistry->hasComponent<Component>(templateEntityID))
+            m_ecsRegistry->addComponent(entityID, m_ecsRegistry->getComponent<Component>(templateEntityID));
+    };
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        TLECatalog::Entry &entry = entries[i];
+
+        Entity entity = m_ecsRegistry->createEntity(entry.name);
+        m_ecsRegistry->addComponent(entity.id, TelemetryComponent::RenderTransform{});
+
+        if (i == 0) {
+            // Defaults, which the catalog's components may override
+            CoreComponent::Identifiers identifiers{};
+            identifiers.entityType = CoreComponent::Identifiers::EntityType::SPACECRAFT;
+
+            CoreComponent::Transform transform{};
+            transform.scale = 1.0;
+
+            m_ecsRegistry->addComponent(entity.id, identifiers);
+            m_ecsRegistry->addComponent(entity.id, transform);
+            m_ecsRegistry->addComponent(entity.id, PhysicsComponent::RigidBody{});
+
+            YAMLParseCtx ctx{};
+            ctx.entityID = entity.id;
+            ctx.entityName = entry.name;
+            ctx.sceneEntities = &sceneEntities;
+            ctx.selfComponents = &templateComponents;
+
+            for (const auto &[componentType, componentNode] : templateComponents) {
+                ctx.currentComponentType = componentType;
+                m_serialRegistry.deserialize(componentType, static_cast<IParseCtx *>(&ctx));
+            }
+
+            templateEntityID = entity.id;
+        }
+        else {
+            copyFromTemplate.template operator()<CoreComponent::Identifiers>(entity.id);
+            copyFromTemplate.template operator()<CoreComponent::Transform>(entity.id);
+            copyFromTemplate.template operator()<PhysicsComponent::RigidBody>(entity.id);
+            copyFromTemplate.template operator()<SpacecraftComponent::Spacecraft>(entity.id);
+            copyFromTemplate.template operator()<SpacecraftComponent::Thruster>(entity.id);
+            copyFromTemplate.template operator()<RenderComponent::MeshRenderable>(entity.id);
+        }
+
+
+        // SGP4 propagator, from the already initialized element set
+        PhysicsComponent::Propagator propagator{};
+        propagator.propagatorType = PhysicsComponent::Propagator::Type::SGP4;
+        propagator.tlePath = catalogPath;
+        propagator.tleLine1 = entry.tle.line1;     // Empty for OMM catalogs
+        propagator.tleLine2 = entry.tle.line2;
+        propagator.tle = entry.tle;
+        propagator.isTLEInitialized = true;
+
+        PhysicsComponent::OrbitalElements orbitalElems{};
+        orbitalElems.parentBody = earthID;
+
+        m_ecsRegistry->addComponent(entity.id, propagator);
+        m_ecsRegistry->addComponent(entity.id, orbitalElems);
+
+
+        if ((i + 1) % PROGRESS_INTERVAL == 0) {
+            m_eventDispatcher->dispatch(UpdateEvent::SceneLoadProgress{
+                .progress = 0.85f + 0.05f * static_cast<float>(i + 1) / entries.size(),
+                .message = "[" + catalogName + "] Spawning objects (" + std::to_string(i + 1) + "/" + std::to_string(entries.size()) + ")..."
+            });
+        }
+    }
+
+    const Clock::time_point end = Clock::now();
+
+
+    std::ostringstream report;
+    report << "Spawned " << entries.size() << " objects from catalog " << enquote(catalogName) << " (" << stats.rejected << " of " << stats.elementSets
+        << " element sets rejected) in " << (std::chrono::duration<double>(end - start).count() * 1e3) << " ms: mapping and splitting " << (stats.scanTime * 1e3)
+        << " ms, parsing and initialization " << (stats.parseTime * 1e3) << " ms, spawning " << (std::chrono::duration<double>(end - spawnStart).count() * 1e3) << " ms.";
+
+    Log::Print(Log::T_INFO, __FUNCTION__, report.str());
 }
 
 
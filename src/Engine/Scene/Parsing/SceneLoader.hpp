@@ -23,6 +23,9 @@
 #include <Engine/Rendering/Geometry/GeometryLoader.hpp>
 
 #include <Simulation/Data/Bodies.hpp>
+#include <Simulation/Forces/GravityField.hpp>
+#include <Simulation/Propagators/SGP4/TLECatalog.hpp>
+#include <Simulation/Propagators/SGP4/OMMCatalog.hpp>
 
 
 class SceneLoader {
@@ -102,6 +105,15 @@ private:
 	void processScene(const YAML::Node &rootNode, std::string &currentEntity, std::string &currentComponent);
 
 
+	/* Spawns an SGP4-propagated spacecraft for every valid element set of a catalog scene entry.
+		The entry's components are deserialized once, onto the first spacecraft, and copied to the others.
+
+		@param catalogNode: The catalog scene entry.
+		@param sceneEntities: The entities of the scene, by name.
+	*/
+	void processCatalog(const YAML::Node &catalogNode, std::unordered_map<std::string, EntityID> &sceneEntities);
+
+
 	// Exception handling
 	std::string getExceptionHeader(const std::string &faultyEntity, const std::string &faultyComponent);
 	std::string getYAMLExceptionMsg(const YAML::Exception &e, const std::string &customMsg);
@@ -4,10 +4,36 @@
 #include "PhysicsSystem.hpp"
 
 
+namespace {
+	/* Integrates a single state over one fixed step with the configured (fixed-step) integrator. */
+	template<typename ODESystem>
+	void IntegrateFixedStep(Solvers::Integrator integrator, Physics::State &state, double t, double dt, ODESystem ode) {
+		switch (integrator) {
+		case Solvers::Integrator::VELOCITY_VERLET:
+			VelocityVerletIntegrator<Physics::State, ODESystem>::Integrate(state, t, dt, ode);
+			break;
+		case Solvers::Integrator::YOSHIDA4:
+			Yoshida4Integrator<Physics::State, ODESystem>::Integrate(state, t, dt, ode);
+			break;
+		case Solvers::Integrator::YOSHIDA6:
+			Yoshida6Integrator<Physics::State, ODESystem>::Integrate(state, t, dt, ode);
+			break;
+		case Solvers::Integrator::YOSHIDA8:
+			Yoshida8Integrator<Physics::State, ODESystem>::Integrate(state, t, dt, ode);
+			break;
+		default:
+			RK4Integrator<Physics::State, ODESystem>::Integrate(state, t, dt, ode);
+			break;
+		}
+	}
+}
+
+
 PhysicsSystem::PhysicsSystem(std::shared_ptr<PhysicsRenderBridge> physRendBridge):
 	m_physRendBridge(physRendBridge) {
 
 	m_ecsRegistry = ServiceLocator::GetService<ECSRegistry>(__FUNCTION__);
+	m_eventDispatcher = ServiceLocator::GetService<EventDispatcher>(__FUNCTION__);
 
 	Log::Print(Log::T_DEBUG, __FUNCTION__, "Initialized.");
 }
@@ -25,6 +51,71 @@ void PhysicsSystem::init(const Application::YAMLFileConfig &fileCfg, const Appli
 			kernelPaths,
 			simCfg.epoch, simCfg.epochFormat
 		);
+
+		m_ephemerisCache.init(m_coordSystem, simCfg.ephemerisCache, simCfg.ephemerisPositionTolerance, simCfg.ephemerisRotationTolerance, simCfg.ephemerisValidation);
+		m_spiceEntityHandles.clear();
+	}
+
+	m_sgp4Batch.clear();
+	m_sgp4BatchEntities.clear();
+
+
+	// Configure solvers
+	m_gravitySolver = simCfg.gravitySolver;
+	m_gravityTree.setOpeningAngle(simCfg.openingAngle);
+	m_integrationMode = simCfg.integrationMode;
+	m_integrator = simCfg.integrator;
+	m_tolerance = EmbeddedRK::Tolerance{
+		.absolute = simCfg.absoluteTolerance,
+		.relative = simCfg.relativeTolerance
+	};
+	m_adaptiveSystemIntegrator.configure(GetEmbeddedRKMethod(m_integrator), m_tolerance);
+	m_adaptiveBodyIntegrators.clear();
+	m_symplecticSystemIntegrator.configure(GetSymplecticScheme(m_integrator));
+	m_wisdomHolmanFallbackReported = false;
+	m_timeStep = simCfg.timeStep;
+	m_conservationMonitor.reset();
+
+	m_forcePool.init("PHYSICS_FORCE", g_appCtx.Config.simulation_PhysicsThreads);
+	m_sgp4Pool.init("PHYSICS_SGP4", g_appCtx.Config.simulation_SGP4Threads);
+
+
+	// Configure force models
+	{
+		uint32_t models = 0;
+		if (simCfg.zonalDegree >= 2)			models |= ForceModel::ZONAL_HARMONICS;
+		if (simCfg.atmosphericDrag)				models |= ForceModel::ATMOSPHERIC_DRAG;
+		if (simCfg.solarRadiationPressure)		models |= ForceModel::SOLAR_RADIATION_PRESSURE;
+		if (!simCfg.thirdBodies.empty())		models |= ForceModel::THIRD_BODY;
+
+		if (!simCfg.gravityFieldPath.empty()) {
+			const ICelestialBody *fieldBody = Body::GetCelestialBody(simCfg.gravityFieldBody);
+			m_gravityFieldSpiceID = fieldBody->getIdentifiers().spiceID.value();
+			m_gravityFieldFrame = simCfg.gravityFieldFrame.empty() ? ("IAU_" + m_gravityFieldSpiceID) : simCfg.gravityFieldFrame;
+			m_gravityFieldFrameHandle = m_ephemerisCache.addFrame(m_gravityFieldFrame);
+
+			m_gravityField.load(FilePathUtils::JoinPaths(ROOT_DIR, simCfg.gravityFieldPath), simCfg.gravityFieldDegree);
+			m_gravityField.setTruncation(simCfg.gravityFieldDegree, simCfg.gravityFieldOrder);
+
+			models |= ForceModel::GRAVITY_FIELD;
+		}
+
+		m_forceModels.configure(models, simCfg.zonalDegree, simCfg.shadowModel);
+
+		// Every frame except the barycentric one is centered on a body, which is itself accelerated by third bodies
+		m_forceModels.getEnvironment().isOriginAccelerated = (simCfg.frame != CoordSys::Frame::SSB);
+
+		m_thirdBodySources.clear();
+		for (const std::string &bodyName : simCfg.thirdBodies) {
+			const ICelestialBody *celestialBody = Body::GetCelestialBody(bodyName);
+			const std::string &spiceID = celestialBody->getIdentifiers().spiceID.value();
+
+			m_thirdBodySources.push_back(_ThirdBodySource{
+				.spiceID = spiceID,
+				.gravParam = celestialBody->getGravParam(),
+				.ephemerisHandle = m_ephemerisCache.addBody(spiceID)
+			});
+		}
 	}
 
 
@@ -42,6 +133,29 @@ void PhysicsSystem::init(const Application::YAMLFileConfig &fileCfg, const Appli
 		createTrajectoryPoints();
 		publishSnapshot();
 	}
+
+
+	// Monte Carlo dispersion analysis of the scene (in the background, from its initial state)
+	if (simCfg.monteCarlo.runs > 0) {
+		try {
+			MonteCarloRunner::Scenario scenario;
+			buildMonteCarloScenario(simCfg.monteCarlo.duration, scenario);
+
+			m_monteCarloRunner.start(simCfg.monteCarlo, std::move(scenario), g_appCtx.Config.simulation_PhysicsThreads);
+		}
+		catch (const std::exception &e) {
+			Log::Print(Log::T_ERROR, __FUNCTION__, "Cannot start Monte Carlo analysis: " + std::string(e.what()));
+		}
+	}
+	else
+		m_monteCarloRunner.cancel();
+
+
+	if (g_appCtx.Config.debugging_PhysicsDiagnostics && m_gravitySolver != Solvers::Gravity::DIRECT)
+		reportGravitySolverError();
+
+	if (m_gravityField.isLoaded())
+		reportGravityFieldCost();
 }
 
 
@@ -51,9 +165,16 @@ void PhysicsSystem::configureCoordSys(CoordSys::FrameType frameType, CoordSys::F
 
 	LOG_ASSERT(CoordSys::EpochToSPICEMap.count(epoch), "Cannot configure coordinate system: Cannot retrieve properties for an unknown/unsupported epoch!");
 
+	// The ephemeris cache's prefetch thread must not query the kernels while they are reloaded
+	m_ephemerisCache.shutdown();
+
 	m_coordSystem = std::make_shared<CoordinateSystem>();
 	m_coordSystem->init(kernelPaths, frame, epoch, epochFormat);
 
+	m_eventDispatcher->dispatch(UpdateEvent::CoordinateSystem{
+		.coordSystem = m_coordSystem
+	});
+
 	auto view = m_ecsRegistry->getView<PhysicsComponent::CoordinateSystem>();
 	LOG_ASSERT(view.size() == 1, "Cannot configure coordinate system: Corrupt registry or incorrect simulation configuration!");
 	auto [id, coordSys] = view[0];
@@ -82,8 +203,62 @@ void PhysicsSystem::tick(WorkerThread *worker) {
 	}
 
 
-	// TODO: Implement adaptive timestepping instead of a constant TIME_STEP
-	if (timeScale > 1000.0f) {
+	if (Solvers::IsAdaptive(m_integrator)) {
+		// Adaptive integrators cover the accumulated time in as few steps as the error tolerance allows.
+		// The time is only split into intervals so that SPICE bodies and propagators, which are held fixed or extrapolated within each update, are refreshed regularly.
+		uint32_t iterations = 0;
+		static constexpr uint32_t SYNC_FREQUENCY = 10;
+
+		while (localAccumulator > 0.0) {
+			if (worker->stopRequested() || Time::GetTimeScale() != timeScale) {
+				localAccumulator = 0.0;
+				break;
+			}
+
+			const double interval = std::min(localAccumulator, EPHEMERIS_UPDATE_INTERVAL);
+			update(interval);
+			localAccumulator -= interval;
+
+			if (++iterations % SYNC_FREQUENCY == 0) {
+				syncECSData();
+				publishSnapshot();
+			}
+		}
+
+		if (g_appCtx.Config.debugging_PhysicsDiagnostics)
+			reportIntegratorStatistics(false);
+	}
+	else if (Solvers::IsSymplectic(m_integrator)) {
+		// Symplectic integrators only keep their energy error bounded at a constant step size, so the accumulated time is never covered in one big jump.
+		// Instead, the number of steps per tick is capped, and the remaining time is carried over to the next tick.
+		uint32_t iterations = 0;
+		static constexpr uint32_t SYNC_FREQUENCY = 100;
+
+		while (localAccumulator >= m_timeStep && iterations < static_cast<uint32_t>(SimulationConst::MAX_SIMULATION_STEPS)) {
+			if (worker->stopRequested() || Time::GetTimeScale() != timeScale) {
+				localAccumulator = 0.0;
+				break;
+			}
+
+			update(m_timeStep);
+			localAccumulator -= m_timeStep;
+
+			if (iterations++ % SYNC_FREQUENCY == 0) {
+				syncECSData();
+				publishSnapshot();
+			}
+		}
+
+		// A backlog of more than one tick's worth of steps means the time scale outpaces the step cap, and would only keep growing; that time is dropped (i.e., the simulation runs slower than the time scale demands) and reported.
+		const double maxBacklog = SimulationConst::MAX_SIMULATION_STEPS * m_timeStep;
+		if (localAccumulator > maxBacklog) {
+			m_droppedSimulationTime += localAccumulator - maxBacklog;
+			localAccumulator = maxBacklog;
+
+			reportDroppedSimulationTime();
+		}
+	}
+	else if (timeScale > 1000.0f) {
 		// For high time scales, do big jumps
 		update(localAccumulator);
 		localAccumulator = 0.0;
@@ -93,7 +268,7 @@ void PhysicsSystem::tick(WorkerThread *worker) {
 		uint32_t iterations = 0;
 		static constexpr uint32_t SYNC_FREQUENCY = 100;
 
-		while (localAccumulator >= SimulationConst::TIME_STEP) {
+		while (localAccumulator >= m_timeStep) {
 			if (worker->stopRequested() || Time::GetTimeScale() != timeScale) {
 				// If the thread in which this function is called is requested to be stopped,
 				// OR If time scale changes while physics is updating (e.g., when the simulation is stopped in the middle of the updates),
@@ -102,8 +277,8 @@ void PhysicsSystem::tick(WorkerThread *worker) {
 				break;
 			}
 
-			update(SimulationConst::TIME_STEP);
-			localAccumulator -= SimulationConst::TIME_STEP;
+			update(m_timeStep);
+			localAccumulator -= m_timeStep;
 
 			// Sync registry & snapshot data every [SYNC_FREQUENCY] iterations to see frequent visual progress on high time scales
 			if (iterations++ % SYNC_FREQUENCY == 0) {
@@ -120,6 +295,18 @@ void PhysicsSystem::tick(WorkerThread *worker) {
 	}
 
 
+	// Track energy and angular momentum drift
+	if (Solvers::IsSymplectic(m_integrator) || g_appCtx.Config.debugging_PhysicsDiagnostics) {
+		m_conservationMonitor.record(m_bodyStore);
+
+		if (g_appCtx.Config.debugging_PhysicsDiagnostics)
+			reportConservationDrift();
+	}
+
+	if (m_ephemerisCache.isValidating())
+		reportEphemerisCache(false);
+
+
 	// Write cache to ECS registry & publish snapshot
 	syncECSData();
 	publishSnapshot();
@@ -149,10 +336,354 @@ void PhysicsSystem::cacheECSData() {
 		std::get<EntityID>(m_identifierData[i]) = id;
 		std::get<CoreComponent::Identifiers>(m_identifierData[i]) = m_ecsRegistry->getComponent<CoreComponent::Identifiers>(id);
 	}
+
+
+	// Body store
+	m_bodyStore.resize(m_generalData.size());
+	m_isFixedBody.resize(m_generalData.size());
+	m_spiceStateHandles.assign(m_generalData.size(), EphemerisCache::NO_HANDLE);
+	m_spiceFrameHandles.assign(m_generalData.size(), EphemerisCache::NO_HANDLE);
+	m_generalDataIndex.clear();
+
+	for (size_t i = 0; i < m_generalData.size(); i++) {
+		auto &&[entityID, transform, rigidBody] = m_generalData[i];
+
+		m_bodyStore.setPosition(i, transform.position);
+		m_bodyStore.setVelocity(i, rigidBody.velocity);
+		m_bodyStore.setAcceleration(i, rigidBody.acceleration);
+		m_bodyStore.mu[i] = PhysicsConst::G * rigidBody.mass;
+
+		// SPICE names are resolved to NAIF IDs (and their kernel coverage checked) the first time an entity is cached, i.e., at scene load
+		const std::optional<std::string> &spiceID = std::get<CoreComponent::Identifiers>(m_identifierData[i]).spiceID;
+		if (spiceID.has_value()) {
+			auto it = m_spiceEntityHandles.find(entityID);
+			if (it == m_spiceEntityHandles.end()) {
+				it = m_spiceEntityHandles.emplace(entityID, _SPICEHandles{
+					.state = m_ephemerisCache.addBody(spiceID.value()),
+					.frame = m_ephemerisCache.addFrame("IAU_" + spiceID.value())
+				}).first;
+			}
+
+			m_spiceStateHandles[i] = it->second.state;
+			m_spiceFrameHandles[i] = it->second.frame;
+		}
+
+		m_isFixedBody[i] = spiceID.has_value();
+		m_generalDataIndex[entityID] = i;
+	}
+
+	// Propagated bodies are driven by their propagators, not integrated
+	m_isEnckeBody.assign(m_generalData.size(), false);
+	for (auto &&[entityID, propagator, transform, rigidBody] : m_propData) {
+		const size_t bodyIdx = m_generalDataIndex.at(entityID);
+
+		m_isFixedBody[bodyIdx] = true;
+		m_isEnckeBody[bodyIdx] = (propagator.propagatorType == PhysicsComponent::Propagator::Type::ENCKE);
+	}
+
+
+	cacheForceModels();
+	cacheBurns();
+	cacheEclipses();
+}
+
+
+void PhysicsSystem::cacheForceModels() {
+	ForceModelPipeline::Environment &env = m_forceModels.getEnvironment();
+
+	env.centralBodies.clear();
+	env.sunIndex = ForceModel::NO_INDEX;
+	m_centralBodyRotVelocities.clear();
+
+	std::vector<ForceModel::Target> targets;
+
+	for (size_t i = 0; i < m_generalData.size(); i++) {
+		auto &&[entityID, transform, rigidBody] = m_generalData[i];
+		const CoreComponent::Identifiers &identifiers = std::get<CoreComponent::Identifiers>(m_identifierData[i]);
+
+		if (identifiers.entityType == CoreComponent::Identifiers::EntityType::STAR && env.sunIndex == ForceModel::NO_INDEX)
+			env.sunIndex = static_cast<uint32_t>(i);
+
+
+		// Central bodies
+		if (m_ecsRegistry->hasComponent<PhysicsComponent::ShapeParameters>(entityID)) {
+			const auto &shapeParams = m_ecsRegistry->getComponent<PhysicsComponent::ShapeParameters>(entityID);
+
+			ForceModel::CentralBody centralBody{
+				.bodyIndex = static_cast<uint32_t>(i),
+				.gravParam = shapeParams.gravParam,
+				.equatRadius = shapeParams.equatRadius,
+				.flattening = shapeParams.flattening,
+				.zonals = { 0.0, 0.0, shapeParams.j2, shapeParams.j3, shapeParams.j4, shapeParams.j5, shapeParams.j6 },
+				.hasAtmosphere = (identifiers.spiceID == "EARTH"),		// Only Earth's atmosphere is modeled
+				.gravityField = (m_gravityField.isLoaded() && identifiers.spiceID == m_gravityFieldSpiceID) ? &m_gravityField : nullptr
+			};
+
+			env.centralBodies.push_back(centralBody);
+			m_centralBodyRotVelocities.push_back(shapeParams.rotVelocity);
+		}
+
+
+		// Targets (bodies driven externally are unaffected, except those propagated with Encke's method)
+		if (m_isFixedBody[i] && !m_isEnckeBody[i])
+			continue;
+
+		ForceModel::Target target{ .bodyIndex = static_cast<uint32_t>(i) };
+
+		if (m_ecsRegistry->hasComponent<SpacecraftComponent::Spacecraft>(entityID) && rigidBody.mass > 0.0) {
+			const auto &spacecraft = m_ecsRegistry->getComponent<SpacecraftComponent::Spacecraft>(entityID);
+
+			target.ballisticFactor = spacecraft.dragCoefficient * spacecraft.referenceArea / rigidBody.mass;
+			target.radiationFactor = spacecraft.reflectivityCoefficient * spacecraft.referenceArea / rigidBody.mass;
+		}
+
+		targets.push_back(target);
+	}
+
+	m_forceModels.setTargets(targets, m_generalData.size());
+
+
+	// Third bodies that are part of the scene already act as point masses
+	m_activeThirdBodySources.clear();
+	for (const _ThirdBodySource &source : m_thirdBodySources) {
+		const bool isInScene = std::any_of(m_identifierData.begin(), m_identifierData.end(), [&source](const auto &entry) {
+			return std::get<CoreComponent::Identifiers>(entry).spiceID == source.spiceID;
+		});
+
+		if (isInScene)
+			Log::Print(Log::T_WARNING, __FUNCTION__, "Third body " + enquote(source.spiceID) + " is already part of the scene, and will not be applied twice.");
+		else
+			m_activeThirdBodySources.push_back(source);
+	}
+	env.thirdBodies.resize(m_activeThirdBodySources.size());
+
+	m_forceModels.compile();
+}
+
+
+void PhysicsSystem::cacheBurns() {
+	std::vector<FiniteBurnScheduler::Engine> engines;
+	m_burnEntities.clear();
+
+	for (size_t i = 0; i < m_generalData.size(); i++) {
+		auto &&[entityID, transform, rigidBody] = m_generalData[i];
+
+		// Bodies driven by SPICE or propagators cannot be maneuvered
+		if (m_isFixedBody[i] || !m_ecsRegistry->hasComponent<SpacecraftComponent::Thruster>(entityID))
+			continue;
+
+		const auto &thruster = m_ecsRegistry->getComponent<SpacecraftComponent::Thruster>(entityID);
+		if (thruster.burns.empty())
+			continue;
+
+		engines.push_back(FiniteBurnScheduler::Engine{
+			.bodyIndex = static_cast<uint32_t>(i),
+			.thrust = thruster.thrustMagnitude,
+			.exhaustVelocity = thruster.specificImpulse * PhysicsConst::G0,
+			.mass = rigidBody.mass,
+			.fuelMass = thruster.currentFuelMass,
+			.burns = thruster.burns
+		});
+	}
+
+	m_burnScheduler.setEngines(engines, m_generalData.size());
+
+	// The scheduler ignores unusable thrusters
+	for (const FiniteBurnScheduler::Engine &engine : m_burnScheduler.getEngines())
+		m_burnEntities.push_back(std::get<EntityID>(m_generalData[engine.bodyIndex]));
+}
+
+
+void PhysicsSystem::updateThrusterMasses() {
+	for (const FiniteBurnScheduler::Engine &engine : m_burnScheduler.getEngines()) {
+		std::get<PhysicsComponent::RigidBody>(m_generalData[engine.bodyIndex]).mass = engine.mass;
+		m_bodyStore.mu[engine.bodyIndex] = PhysicsConst::G * engine.mass;
+	}
+}
+
+
+void PhysicsSystem::updateForceModels(const double et) {
+	if (m_forceModels.getModels() == 0)
+		return;
+
+	ForceModelPipeline::Environment &env = m_forceModels.getEnvironment();
+
+	// Central body orientations
+	for (size_t k = 0; k < env.centralBodies.size(); k++) {
+		ForceModel::CentralBody &centralBody = env.centralBodies[k];
+		const glm::dquat &rotation = std::get<CoreComponent::Transform>(m_generalData[centralBody.bodyIndex]).rotation;
+
+		centralBody.pole = glm::normalize(rotation * glm::dvec3(0.0, 0.0, 1.0));
+		centralBody.angularVelocity = rotation * m_centralBodyRotVelocities[k];
+
+		if (centralBody.gravityField) {
+			centralBody.bodyFixedRotation = m_ephemerisCache.getRotationMatrix(m_gravityFieldFrameHandle, et);
+			centralBody.rotationEpochET = et;
+		}
+	}
+
+
+	// Third-body ephemerides
+	for (size_t k = 0; k < m_activeThirdBodySources.size(); k++) {
+		const std::array<double, 6> stateVec = m_ephemerisCache.getBodyState(m_activeThirdBodySources[k].ephemerisHandle, et);
+
+		env.thirdBodies[k] = ForceModel::ThirdBody{
+			.position = glm::dvec3(stateVec[0], stateVec[1], stateVec[2]),
+			.velocity = glm::dvec3(stateVec[3], stateVec[4], stateVec[5]),
+			.epochET = et,
+			.gravParam = m_activeThirdBodySources[k].gravParam
+		};
+	}
+
+
+	m_forceModels.assignCentralBodies(m_bodyStore);
+}
+
+
+void PhysicsSystem::buildMonteCarloScenario(const double duration, MonteCarloRunner::Scenario &scenario) {
+	scenario = MonteCarloRunner::Scenario();
+	scenario.epochET = m_currentEpoch;
+
+	const double interval = scenario.sampleInterval;
+	const size_t sampleCount = static_cast<size_t>(std::ceil(duration / interval)) + 1;
+
+
+	// Bodies (propagated bodies are left out, so that the indices of the scenario differ from those of the body store)
+	std::vector<uint32_t> scenarioIndices(m_generalData.size(), ForceModel::NO_INDEX);
+	size_t propagatedBodies = 0;
+
+	for (size_t i = 0; i < m_generalData.size(); i++) {
+		auto &&[entityID, transform, rigidBody] = m_generalData[i];
+
+		if (m_isFixedBody[i] && m_spiceStateHandles[i] == EphemerisCache::NO_HANDLE) {
+			propagatedBodies++;
+			continue;
+		}
+
+		MonteCarloRunner::Body body{
+			.name = m_ecsRegistry->getEntity(entityID).name,
+			.position = m_bodyStore.getPosition(i),
+			.velocity = m_bodyStore.getVelocity(i),
+			.mass = rigidBody.mass,
+			.isFixed = static_cast<bool>(m_isFixedBody[i])
+		};
+
+		if (m_ecsRegistry->hasComponent<SpacecraftComponent::Spacecraft>(entityID)) {
+			const auto &spacecraft = m_ecsRegistry->getComponent<SpacecraftComponent::Spacecraft>(entityID);
+
+			body.isSpacecraft = true;
+			body.dragCoefficient = spacecraft.dragCoefficient;
+			body.referenceArea = spacecraft.referenceArea;
+			body.reflectivityCoefficient = spacecraft.reflectivityCoefficient;
+		}
+
+		scenarioIndices[i] = static_cast<uint32_t>(scenario.bodies.size());
+		scenario.bodies.push_back(body);
+	}
+
+	if (propagatedBodies > 0)
+		Log::Print(Log::T_WARNING, __FUNCTION__, std::to_string(propagatedBodies) + " propagated " + ((propagatedBodies == 1) ? "body is" : "bodies are") + " left out of the Monte Carlo analysis.");
+
+
+	// Force models
+	const ForceModelPipeline::Environment &env = m_forceModels.getEnvironment();
+	std::vector<uint32_t> centralBodySources;		// Indices of the scenario's central bodies in the force models' list
+
+	scenario.models = m_forceModels.getModels();
+	scenario.zonalDegree = env.zonalDegree;
+	scenario.shadowModel = env.shadowModel;
+	scenario.environment = env;
+	scenario.environment.centralBodies.clear();
+	scenario.environment.sunIndex = (env.sunIndex != ForceModel::NO_INDEX) ? scenarioIndices[env.sunIndex] : ForceModel::NO_INDEX;
+
+	for (size_t k = 0; k < env.centralBodies.size(); k++) {
+		ForceModel::CentralBody centralBody = env.centralBodies[k];
+		if (scenarioIndices[centralBody.bodyIndex] == ForceModel::NO_INDEX)
+			continue;
+
+		centralBody.bodyIndex = scenarioIndices[centralBody.bodyIndex];
+
+		// The scenario owns a copy of the gravity field, as runs may outlive this system's field
+		if (centralBody.gravityField) {
+			scenario.gravityField = std::make_shared<const GravityField>(m_gravityField);
+			scenario.gravityFieldBody = static_cast<uint32_t>(scenario.environment.centralBodies.size());
+			centralBody.gravityField = nullptr;
+		}
+
+		scenario.environment.centralBodies.push_back(centralBody);
+		scenario.centralBodyRotVelocities.push_back(m_centralBodyRotVelocities[k]);
+		centralBodySources.push_back(static_cast<uint32_t>(k));
+	}
+
+
+	// Finite burns (only integrated bodies have thrusters)
+	scenario.engines = m_burnScheduler.getEngines();
+	for (FiniteBurnScheduler::Engine &engine : scenario.engines)
+		engine.bodyIndex = scenarioIndices[engine.bodyIndex];
+
+
+	// Integration (fixed-step integrators are replaced by the default embedded method, as runs are integrated adaptively)
+	scenario.method = GetEmbeddedRKMethod(m_integrator);
+	scenario.tolerance = m_tolerance;
+
+
+	// Ephemerides
+	scenario.samples.resize(sampleCount);
+
+	for (size_t s = 0; s < sampleCount; s++) {
+		const double et = m_currentEpoch + s * interval;
+		MonteCarloRunner::Sample &sample = scenario.samples[s];
+
+		sample.positions.assign(scenario.bodies.size(), glm::dvec3(0.0));
+		sample.velocities.assign(scenario.bodies.size(), glm::dvec3(0.0));
+
+		for (size_t i = 0; i < m_generalData.size(); i++) {
+			const uint32_t bodyIndex = scenarioIndices[i];
+			if (bodyIndex == ForceModel::NO_INDEX || !scenario.bodies[bodyIndex].isFixed)
+				continue;
+
+			const std::array<double, 6> stateVec = m_ephemerisCache.getBodyState(m_spiceStateHandles[i], et);
+			sample.positions[bodyIndex] = glm::dvec3(stateVec[0], stateVec[1], stateVec[2]);
+			sample.velocities[bodyIndex] = glm::dvec3(stateVec[3], stateVec[4], stateVec[5]);
+		}
+
+		// Central bodies without SPICE frames keep their current orientation
+		for (const uint32_t k : centralBodySources) {
+			const uint32_t i = env.centralBodies[k].bodyIndex;
+
+			sample.orientations.push_back((m_spiceFrameHandles[i] != EphemerisCache::NO_HANDLE)
+				? m_ephemerisCache.getRotationMatrix(m_spiceFrameHandles[i], et)
+				: glm::mat3_cast(std::get<CoreComponent::Transform>(m_generalData[i]).rotation));
+		}
+
+		if (scenario.gravityField)
+			sample.gravityFieldRotation = m_ephemerisCache.getRotationMatrix(m_gravityFieldFrameHandle, et);
+
+		for (const _ThirdBodySource &source : m_activeThirdBodySources) {
+			const std::array<double, 6> stateVec = m_ephemerisCache.getBodyState(source.ephemerisHandle, et);
+
+			sample.thirdBodies.push_back(ForceModel::ThirdBody{
+				.position = glm::dvec3(stateVec[0], stateVec[1], stateVec[2]),
+				.velocity = glm::dvec3(stateVec[3], stateVec[4], stateVec[5]),
+				.epochET = et,
+				.gravParam = source.gravParam
+			});
+		}
+	}
 }
 
 
 void PhysicsSystem::syncECSData() {
+	// Body store
+	for (size_t i = 0; i < m_generalData.size(); i++) {
+		auto &&[_, transform, rigidBody] = m_generalData[i];
+
+		transform.position = m_bodyStore.getPosition(i);
+		rigidBody.velocity = m_bodyStore.getVelocity(i);
+		rigidBody.acceleration = m_bodyStore.getAcceleration(i);
+	}
+
+
 	// General data
 	for (auto &&[entityID, transform, rigidBody] : m_generalData) {
 		m_ecsRegistry->updateComponent(entityID, transform);
@@ -166,6 +697,21 @@ void PhysicsSystem::syncECSData() {
 	}
 
 
+	// Thrusters (the masses of their bodies are synced with the general data)
+	const std::vector<FiniteBurnScheduler::Engine> &engines = m_burnScheduler.getEngines();
+	for (size_t k = 0; k < engines.size(); k++) {
+		SpacecraftComponent::Thruster &thruster = m_ecsRegistry->getComponent<SpacecraftComponent::Thruster>(m_burnEntities[k]);
+		thruster.currentFuelMass = engines[k].fuelMass;
+
+		m_ecsRegistry->updateComponent(m_burnEntities[k], thruster);
+	}
+
+
+	// Eclipses
+	for (size_t i = 0; i < m_eclipseEntities.size(); i++)
+		m_ecsRegistry->updateComponent(m_eclipseEntities[i], m_eclipseData[i]);
+
+
 	// Specific data
 		// Identifiers (NONE - they should be constant and read-only)
 		// Point lights: If an entity is a star, update its point light position to its own
@@ -192,6 +738,7 @@ void PhysicsSystem::syncECSData() {
 		static constexpr int LENOUT = 35;
 		static char buf[LENOUT];
 
+		std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
 		et2utc_c(m_currentEpoch, FMT, PREC, LENOUT, buf);
 
 		coordSys.currentEpoch = std::string(buf);
@@ -232,13 +779,28 @@ void PhysicsSystem::publishSnapshot() {
 
 
 void PhysicsSystem::update(const double dt) {
-	m_currentEpoch = m_coordSystem->getEpochET() + m_simulationTime;
-	
-	updateSPICEBodies(m_currentEpoch);
-	propagateBodies(m_currentEpoch);
-	updateGeneralBodies(dt, m_currentEpoch);
+	// The update is split into segments at burn starts, burn ends and fuel exhaustion, so that no integration step straddles a thrust discontinuity.
+	// Each segment is a regular update; without scheduled burns, there is a single segment.
+	const double endTime = m_simulationTime + dt;
+
+	do {
+		const double segmentEnd = m_burnScheduler.getNextBoundary(m_simulationTime, endTime);
+		m_currentEpoch = m_coordSystem->getEpochET() + m_simulationTime;
 
-	m_simulationTime += dt;
+		// Force models are refreshed before propagation, since Encke propagators evaluate them
+		updateSPICEBodies(m_currentEpoch);
+		updateForceModels(m_currentEpoch);
+		propagateBodies(m_currentEpoch);
+		updateEclipses(m_currentEpoch);
+
+		m_burnScheduler.beginSegment(m_simulationTime, m_currentEpoch, m_bodyStore);
+		updateGeneralBodies(segmentEnd - m_simulationTime, m_currentEpoch);
+
+		m_simulationTime = segmentEnd;
+		if (m_burnScheduler.endSegment(m_simulationTime))
+			updateThrusterMasses();
+
+	} while (m_simulationTime < endTime);
 }
 
 
@@ -253,30 +815,26 @@ void PhysicsSystem::updateSPICEBodies(const double et) {
 		auto &&[_, identifiers] = m_identifierData[i];
 
 		if (identifiers.spiceID.has_value()) {
-			const std::string &spiceID = identifiers.spiceID.value();
-
 			// Update position and velocity
-			const std::array<double, 6> stateVec = m_coordSystem->getBodyState(spiceID, et);
+			const std::array<double, 6> stateVec = m_ephemerisCache.getBodyState(m_spiceStateHandles[i], et);
 
-			transform.position = glm::dvec3(
+			m_bodyStore.setPosition(i, glm::dvec3(
 				stateVec[0], stateVec[1], stateVec[2]
-			);
+			));
 
-			rigidBody.velocity = glm::dvec3(
+			m_bodyStore.setVelocity(i, glm::dvec3(
 				stateVec[3], stateVec[4], stateVec[5]
-			);
+			));
 
 
 			// Update rotation
-			const std::string frameName = "IAU_" + spiceID;
-			const glm::mat3 rotMatrix = m_coordSystem->getRotationMatrix(frameName, et);
+			const glm::dmat3 rotMatrix = m_ephemerisCache.getRotationMatrix(m_spiceFrameHandles[i], et);
 
 			transform.rotation = glm::dquat(rotMatrix);
 
 
 			// Update cache data
 			std::get<CoreComponent::Transform>(m_generalData[i]) = transform;
-			std::get<PhysicsComponent::RigidBody>(m_generalData[i]) = rigidBody;
 			//m_ecsRegistry->updateComponent(entityID, transform);
 			//m_ecsRegistry->updateComponent(entityID, rigidBody);
 		}
@@ -285,131 +843,708 @@ void PhysicsSystem::updateSPICEBodies(const double et) {
 
 
 void PhysicsSystem::updateGeneralBodies(const double dt, const double et) {
-	using namespace PhysicsConst;
-	
-	//auto view = m_ecsRegistry->getView<CoreComponent::Transform, PhysicsComponent::RigidBody>();
+	const bool isAdaptive = Solvers::IsAdaptive(m_integrator);
+
+	// The Wisdom-Holman mapping is defined over the whole system (it needs the central body and the barycenter)
+	const Solvers::IntegrationMode integrationMode = (m_integrator == Solvers::Integrator::WISDOM_HOLMAN) ? Solvers::IntegrationMode::SYSTEM : m_integrationMode;
+
+	switch (integrationMode) {
+	case Solvers::IntegrationMode::PER_BODY:
+		if (isAdaptive)
+			integrateBodiesIndividuallyAdaptive(dt, et);
+		else
+			integrateBodiesIndividually(dt, et);
+		break;
+
+	case Solvers::IntegrationMode::SYSTEM:
+		if (isAdaptive)
+			integrateSystemAdaptive(dt, et);
+		else
+			integrateSystem(dt, et);
+		break;
+	}
+}
 
 
-	// Integration and component updating
-	for (size_t i = 0; i < m_generalData.size(); i++) {
-		auto &&[targetEntityID, targetTransform, targetRigidBody] = m_generalData[i];
+void PhysicsSystem::integrateBodiesIndividually(const double dt, const double et) {
+	const bool useBarnesHut = (m_gravitySolver == Solvers::Gravity::BARNES_HUT);
+	if (useBarnesHut)
+		buildGravityTree(m_bodyStore);
 
-		{
-			// If the target entity uses SPICE, its state vector has already been computed. We must, therefore, skip them.
-			auto &&[_, targetIDs] = m_identifierData[i];
-			if (targetIDs.spiceID.has_value())
-				continue;
-		
-			// TODO: If the target has a propagator, its state vector has already been computed.
-			//if (m_ecsRegistry->hasComponent<PhysicsComponent::Propagator>(targetEntityID))
-			//	continue;
-		}
+
+	// Integration and body store updating
+	for (size_t i = 0; i < m_generalData.size(); i++) {
+		// If the target entity uses SPICE or a propagator, its state vector has already been computed. We must, therefore, skip them.
+		if (m_isFixedBody[i])
+			continue;
 
 		// Prepare initial states and ODE
 		Physics::State state{};
-		state.position = targetTransform.position;
-		state.velocity = targetRigidBody.velocity;
+		state.position = m_bodyStore.getPosition(i);
+		state.velocity = m_bodyStore.getVelocity(i);
+		state.mass = std::get<PhysicsComponent::RigidBody>(m_generalData[i]).mass;
+
+		glm::dvec3 acceleration;
+
+		// Perturbing force models (if any) and thrust (if the body is burning) are added on top of point-mass gravity. Thrust depletes the mass at a constant rate.
+		auto withPerturbations = [this, i](auto gravityODE) {
+			return [this, i, gravityODE](const Physics::State &state, double t) {
+				Physics::State derivative = gravityODE(state, t);
+				derivative.velocity += m_forceModels.computeAcceleration(static_cast<uint32_t>(i), m_bodyStore, state.position, state.velocity, t);
+				derivative.velocity += m_burnScheduler.computeAcceleration(static_cast<uint32_t>(i), m_bodyStore, state.velocity, state.mass);
+				derivative.mass = m_burnScheduler.getMassRate(static_cast<uint32_t>(i));
+				return derivative;
+			};
+		};
+
+		if (useBarnesHut) {
+			ODE::BarnesHutNBody gravityODE{};
+			gravityODE.tree = &m_gravityTree;
+			gravityODE.bodyIndex = static_cast<uint32_t>(i);
+			auto ode = withPerturbations(gravityODE);
+
+			// Integrate!
+			IntegrateFixedStep(m_integrator, state, et, dt, ode);
+			acceleration = ode(state, et + dt).velocity;		// Recompute acceleration again
+		}
+		else {
+			ODE::VectorizedNBody gravityODE{};
+			gravityODE.bodies = &m_bodyStore;
+			gravityODE.bodyIndex = static_cast<uint32_t>(i);
+			auto ode = withPerturbations(gravityODE);
+
+			// Integrate!
+			IntegrateFixedStep(m_integrator, state, et, dt, ode);
+			acceleration = ode(state, et + dt).velocity;		// Recompute acceleration again
+		}
 
-		ODE::NewtonianNBody ode{};
-		//ode.view = &view;
-		ode.bodies = &m_generalData;
-		ode.entityID = targetEntityID;
 
+		// Update body store
+		m_bodyStore.setPosition(i, state.position);
+		m_bodyStore.setVelocity(i, state.velocity);
+		m_bodyStore.setAcceleration(i, acceleration);
+	}
+}
 
-		// Integrate!
-		RK4Integrator<Physics::State, ODE::NewtonianNBody>::Integrate(state, et, dt, ode);
 
+void PhysicsSystem::integrateSystem(const double dt, const double et) {
+	auto computeStageAccelerations = [this](NBodyStore &stage, double t) {
+		computeAccelerations(stage, t);
+	};
 
-		// Update cache data
-		targetTransform.position = state.position;
+	if (m_integrator == Solvers::Integrator::WISDOM_HOLMAN) {
+		if (m_wisdomHolmanIntegrator.integrate(m_bodyStore, m_isFixedBody, et, dt, computeStageAccelerations))
+			return;
 
-		targetRigidBody.velocity = state.velocity;
-		targetRigidBody.acceleration = ode(state, dt).velocity;		// Recompute acceleration again
+		// The perturbations are too large for the Keplerian splitting (e.g., close encounters, or hierarchies of integrated bodies): cover the step with the adaptive integrator instead
+		if (!m_wisdomHolmanFallbackReported) {
+			Log::Print(Log::T_WARNING, __FUNCTION__, "Perturbations exceed " + std::to_string(NBodyWisdomHolmanIntegrator::MAX_PERTURBATION_RATIO) + " of the Keplerian pull of a body's primary. The Wisdom-Holman integrator falls back to adaptive integration for such steps.");
+			m_wisdomHolmanFallbackReported = true;
+		}
 
-		std::get<CoreComponent::Transform>(m_generalData[i]) = targetTransform;
-		std::get<PhysicsComponent::RigidBody>(m_generalData[i]) = targetRigidBody;
-		//m_ecsRegistry->updateComponent(targetEntityID, targetTransform);
-		//m_ecsRegistry->updateComponent(targetEntityID, targetRigidBody);
+		integrateSystemAdaptive(dt, et);
 	}
+	else if (Solvers::IsSymplectic(m_integrator))
+		m_symplecticSystemIntegrator.integrate(m_bodyStore, m_isFixedBody, et, dt, computeStageAccelerations);
+	else
+		m_systemIntegrator.integrate(m_bodyStore, m_isFixedBody, et, dt, computeStageAccelerations);
 }
 
 
-void PhysicsSystem::propagateBodies(const double et) {
-	//auto view = m_ecsRegistry->getView<PhysicsComponent::Propagator, CoreComponent::Transform, PhysicsComponent::RigidBody>();
+void PhysicsSystem::integrateBodiesIndividuallyAdaptive(const double dt, const double et) {
+	const bool useBarnesHut = (m_gravitySolver == Solvers::Gravity::BARNES_HUT);
 
-	for (int i = 0; i < m_propData.size(); i++) {
-		auto &&[entityID, propagator, transform, rigidBody] = m_propData[i];
+	// Fixed bodies are evaluated at each stage time (see loadFixedBodyStates), so accelerations are computed against a stage copy of the body store
+	m_adaptiveStage = m_bodyStore;
+	double stageTime = std::numeric_limits<double>::quiet_NaN();
 
-		const double secondsSinceEpoch = et - propagator.tleEpochET;
-		const double minutesSinceEpoch = secondsSinceEpoch / 60.0;
+	m_fixedSourceIndices.clear();
 
-		double position[3], velocity[3];
-		propagator.tle.getRV(minutesSinceEpoch, position, velocity);
+	if (useBarnesHut) {
+		// The tree only holds the free bodies; fixed bodies move within the interval and are summed directly at each stage
+		m_treeGravParams = m_bodyStore.mu;
 
-		std::array<double, 6> stateVec = {
-			position[0], position[1], position[2],
-			velocity[0], velocity[1], velocity[2]
-		};
+		for (size_t i = 0; i < m_bodyStore.size(); i++) {
+			if (!m_isFixedBody[i])
+				continue;
 
+			m_fixedSourceIndices.push_back(static_cast<uint32_t>(i));
+			m_treeGravParams[i] = 0.0;
+		}
 
-		//std::cout << "Epoch: " << et << " (ET), " << minutesSinceEpoch << " minutes (" << secondsSinceEpoch << " seconds) since epoch.\n";
-		//std::cout << "State vector (in km and km/s):\n\tr_TEME  = {" << stateVec[0] << ", " << stateVec[1] << ", " << stateVec[2] << "}, v_TEME  = {" << stateVec[3] << ", " << stateVec[4] << ", " << stateVec[5] << "}";
+		m_fixedSources.resize(m_fixedSourceIndices.size());
+		for (size_t k = 0; k < m_fixedSourceIndices.size(); k++)
+			m_fixedSources.mu[k] = m_bodyStore.mu[m_fixedSourceIndices[k]];
 
+		m_bodyPositions.resize(m_bodyStore.size());
+		for (size_t i = 0; i < m_bodyStore.size(); i++)
+			m_bodyPositions[i] = m_bodyStore.getPosition(i);
 
-		glm::dvec3 rT(stateVec[0], stateVec[1], stateVec[2]);
-		
-		// Transform the state vector from TEME to this system's frame
-		stateVec = m_coordSystem->TEMEToThisFrame(stateVec, et);
+		m_gravityTree.build(m_bodyPositions, m_treeGravParams);
+	}
 
-		glm::dvec3 rJ(stateVec[0], stateVec[1], stateVec[2]);
-		
-		//std::cout << "\n\tr_J2000 = {" << stateVec[0] << ", " << stateVec[1] << ", " << stateVec[2] << "}, v_J2000 = {" << stateVec[3] << ", " << stateVec[4] << ", " << stateVec[5] << "}\n\n";
+	auto loadStage = [&](double t) {
+		if (t == stageTime)
+			return;
 
+		stageTime = t;
+		loadFixedBodyStates(m_adaptiveStage, et, t);
 
+		for (size_t k = 0; k < m_fixedSourceIndices.size(); k++)
+			m_fixedSources.setPosition(k, m_adaptiveStage.getPosition(m_fixedSourceIndices[k]));
+	};
 
-		double dr = glm::length(rJ - rT);
-		double angular = glm::degrees(acos(glm::dot(glm::normalize(rJ), glm::normalize(rT)))); // deg
-		//std::cout << " |delta-r| = " << dr << " km, angular = " << angular << " deg\n";
 
+	// Each body keeps its own integrator (and therefore its own step size and statistics)
+	if (m_adaptiveBodyIntegrators.size() != m_bodyStore.size()) {
+		m_adaptiveBodyIntegrators.resize(m_bodyStore.size());
 
+		for (EmbeddedRKIntegrator &integrator : m_adaptiveBodyIntegrators)
+			integrator.configure(GetEmbeddedRKMethod(m_integrator), m_tolerance);
+	}
 
 
-		// Convert propagator output from km and km/s to m and m/s respectively
-		if (propagator.propagatorType == PhysicsComponent::Propagator::Type::SGP4)
-			for (size_t i = 0; i < stateVec.size(); i++)
-				stateVec[i] *= 1e3;
+	std::vector<double> y(6);
 
+	for (size_t i = 0; i < m_bodyStore.size(); i++) {
+		if (m_isFixedBody[i])
+			continue;
 
-		// Write new data to the cache
-		transform.position = glm::dvec3(
-			stateVec[0], stateVec[1], stateVec[2]
-		);
+		const glm::dvec3 position = m_bodyStore.getPosition(i);
+		const glm::dvec3 velocity = m_bodyStore.getVelocity(i);
+		y = { position.x, position.y, position.z, velocity.x, velocity.y, velocity.z };
 
-		rigidBody.velocity = glm::dvec3(
-			stateVec[3], stateVec[4], stateVec[5]
-		);
+		// Burning bodies also integrate their mass: [x, y, z, vx, vy, vz, m]
+		const double massRate = m_burnScheduler.getMassRate(static_cast<uint32_t>(i));
+		if (massRate != 0.0)
+			y.push_back(std::get<PhysicsComponent::RigidBody>(m_generalData[i]).mass);
 
+		glm::dvec3 acceleration(0.0);
 
-		std::get<CoreComponent::Transform>(m_propData[i]) = transform;
-		std::get<PhysicsComponent::RigidBody>(m_propData[i]) = rigidBody;
-		//m_ecsRegistry->updateComponent(entityID, transform);
-		//m_ecsRegistry->updateComponent(entityID, rigidBody);
-	}
-}
+		auto computeDerivative = [&](double t, const double *state, double *derivative) {
+			loadStage(t);
 
+			const glm::dvec3 statePosition(state[0], state[1], state[2]);
 
-void PhysicsSystem::homogenizeCoordinateSystems() {
-	// Convert TLE state vectors (TEME coordinate system)
-	auto view = m_ecsRegistry->getView<PhysicsComponent::Propagator, CoreComponent::Transform, PhysicsComponent::RigidBody>();
+			const glm::dvec3 stateVelocity(state[3], state[4], state[5]);
 
-	for (auto &&[entityID, propagator, transform, rigidBody] : view) {
-		// Compute TLE epoch
-		propagator.tleEpochET = SPICEUtils::tleEpochToET(propagator.tleLine1);
+			acceleration = useBarnesHut
+				? m_gravityTree.computeAcceleration(statePosition, static_cast<uint32_t>(i)) + GravityKernels::ComputeAccelerationAt(m_fixedSources, statePosition)
+				: GravityKernels::ComputeAccelerationAt(m_adaptiveStage, statePosition, static_cast<uint32_t>(i));
+			acceleration += m_forceModels.computeAcceleration(static_cast<uint32_t>(i), m_adaptiveStage, statePosition, stateVelocity, t);
 
-		// Get state vector from TLE
-		propagator.tle.parseLines(propagator.tleLine1, propagator.tleLine2);
+			derivative[0] = state[3];
+			derivative[1] = state[4];
+			derivative[2] = state[5];
 
-		double position[3], velocity[3];
+			if (massRate != 0.0) {
+				acceleration += m_burnScheduler.computeAcceleration(static_cast<uint32_t>(i), m_adaptiveStage, stateVelocity, state[6]);
+				derivative[6] = massRate;
+			}
+
+			derivative[3] = acceleration.x;
+			derivative[4] = acceleration.y;
+			derivative[5] = acceleration.z;
+		};
+
+		m_adaptiveBodyIntegrators[i].integrate(y, et, dt, computeDerivative);
+
+
+		// Update body store (the acceleration is the one of the last evaluation); bodies integrated later see the updated state
+		m_bodyStore.setPosition(i, glm::dvec3(y[0], y[1], y[2]));
+		m_bodyStore.setVelocity(i, glm::dvec3(y[3], y[4], y[5]));
+		m_bodyStore.setAcceleration(i, acceleration);
+
+		m_adaptiveStage.setPosition(i, m_bodyStore.getPosition(i));
+		m_adaptiveStage.setVelocity(i, m_bodyStore.getVelocity(i));
+	}
+}
+
+
+void PhysicsSystem::integrateSystemAdaptive(const double dt, const double et) {
+	const size_t bodyCount = m_bodyStore.size();
+
+	// Flatten the state vectors: [x, y, z, vx, vy, vz] per body
+	m_flatState.resize(6 * bodyCount);
+	for (size_t i = 0; i < bodyCount; i++) {
+		double *state = &m_flatState[6 * i];
+		state[0] = m_bodyStore.x[i];
+		state[1] = m_bodyStore.y[i];
+		state[2] = m_bodyStore.z[i];
+		state[3] = m_bodyStore.vx[i];
+		state[4] = m_bodyStore.vy[i];
+		state[5] = m_bodyStore.vz[i];
+	}
+
+	m_adaptiveStage.resize(bodyCount);
+	m_adaptiveStage.mu = m_bodyStore.mu;
+
+
+	// Fixed bodies are not integrated: their stage states are evaluated at each stage time, and are refreshed at the start of the next update.
+	auto computeDerivative = [this, bodyCount, et](double t, const double *state, double *derivative) {
+		for (size_t i = 0; i < bodyCount; i++) {
+			m_adaptiveStage.x[i] = state[6 * i + 0];
+			m_adaptiveStage.y[i] = state[6 * i + 1];
+			m_adaptiveStage.z[i] = state[6 * i + 2];
+			m_adaptiveStage.vx[i] = state[6 * i + 3];
+			m_adaptiveStage.vy[i] = state[6 * i + 4];
+			m_adaptiveStage.vz[i] = state[6 * i + 5];
+		}
+
+		loadFixedBodyStates(m_adaptiveStage, et, t);
+		computeAccelerations(m_adaptiveStage, t);
+
+		for (size_t i = 0; i < bodyCount; i++) {
+			const bool isFixed = m_isFixedBody[i];
+
+			derivative[6 * i + 0] = state[6 * i + 3];
+			derivative[6 * i + 1] = state[6 * i + 4];
+			derivative[6 * i + 2] = state[6 * i + 5];
+			derivative[6 * i + 3] = isFixed ? 0.0 : m_adaptiveStage.ax[i];
+			derivative[6 * i + 4] = isFixed ? 0.0 : m_adaptiveStage.ay[i];
+			derivative[6 * i + 5] = isFixed ? 0.0 : m_adaptiveStage.az[i];
+		}
+	};
+
+	m_adaptiveSystemIntegrator.integrate(m_flatState, et, dt, computeDerivative);
+
+
+	// Update body store (the accelerations are the ones of the last evaluation)
+	for (size_t i = 0; i < bodyCount; i++) {
+		if (m_isFixedBody[i])
+			continue;
+
+		const double *state = &m_flatState[6 * i];
+		m_bodyStore.setPosition(i, glm::dvec3(state[0], state[1], state[2]));
+		m_bodyStore.setVelocity(i, glm::dvec3(state[3], state[4], state[5]));
+		m_bodyStore.setAcceleration(i, m_adaptiveStage.getAcceleration(i));
+	}
+}
+
+
+void PhysicsSystem::loadFixedBodyStates(NBodyStore &stage, const double et, const double t) {
+	for (size_t i = 0; i < m_bodyStore.size(); i++) {
+		if (!m_isFixedBody[i])
+			continue;
+
+		if (m_spiceStateHandles[i] != EphemerisCache::NO_HANDLE) {
+			const std::array<double, 6> stateVec = m_ephemerisCache.getBodyState(m_spiceStateHandles[i], t);
+
+			stage.setPosition(i, glm::dvec3(stateVec[0], stateVec[1], stateVec[2]));
+			stage.setVelocity(i, glm::dvec3(stateVec[3], stateVec[4], stateVec[5]));
+		}
+		else {
+			// Propagated bodies are only refreshed once per update, and are extrapolated with their current velocities in between
+			stage.setPosition(i, m_bodyStore.getPosition(i) + (t - et) * m_bodyStore.getVelocity(i));
+			stage.setVelocity(i, m_bodyStore.getVelocity(i));
+		}
+	}
+}
+
+
+void PhysicsSystem::propagateBodies(const double et) {
+	propagateSGP4Bodies(et);
+	propagateKeplerBodies(et);
+	propagateEnckeBodies(et);
+}
+
+
+void PhysicsSystem::propagateSGP4Bodies(const double et) {
+	// Gather SGP4 entities (the batch is only rebuilt when they change, i.e., at scene load)
+	m_sgp4PropIndices.clear();
+	bool isBatchStale = false;
+
+	for (size_t i = 0; i < m_propData.size(); i++) {
+		auto &&[entityID, propagator, transform, rigidBody] = m_propData[i];
+		if (propagator.propagatorType != PhysicsComponent::Propagator::Type::SGP4)
+			continue;
+
+		const size_t k = m_sgp4PropIndices.size();
+		if (k >= m_sgp4BatchEntities.size() || m_sgp4BatchEntities[k] != entityID)
+			isBatchStale = true;
+
+		m_sgp4PropIndices.push_back(i);
+	}
+
+	if (isBatchStale || m_sgp4PropIndices.size() != m_sgp4BatchEntities.size()) {
+		m_sgp4Batch.clear();
+		m_sgp4BatchEntities.clear();
+
+		for (size_t i : m_sgp4PropIndices) {
+			auto &&[entityID, propagator, transform, rigidBody] = m_propData[i];
+
+			m_sgp4Batch.add(propagator.tle.rec, propagator.tleEpochET);
+			m_sgp4BatchEntities.push_back(entityID);
+		}
+
+		resetConjunctionScreening();
+	}
+
+	if (m_sgp4PropIndices.empty())
+		return;
+
+
+	// Propagate all element sets at once (in TEME, km and km/s), across the SGP4 thread pool
+	m_sgp4Batch.propagate(et, m_sgp4Positions, m_sgp4Velocities, m_sgp4Pool);
+
+
+	// Transform states from TEME to this system's frame, and scatter them (converting them from km and km/s to m and m/s respectively), across the pool.
+	// Every entity shares the epoch, and thus the rotation, which is evaluated here since its cache is not thread-safe. Each task writes only to its own entities' components and body store slots.
+	const glm::dmat3 &temeRotation = m_coordSystem->getTEMERotationMatrix(et);
+
+	m_sgp4Batch.scatterStates(m_sgp4Positions, m_sgp4Velocities, temeRotation, m_sgp4Pool, [&](size_t k, int error, const glm::dvec3 &position, const glm::dvec3 &velocity) {
+		auto &&[entityID, propagator, transform, rigidBody] = m_propData[m_sgp4PropIndices[k]];
+		propagator.tle.sgp4Error = error;
+
+		// Element sets rejected before their state could be computed (errors 1-4) keep their previous states
+		if (error != 0 && error <= 4)
+			return;
+
+		transform.position = position;
+		rigidBody.velocity = velocity;
+
+		const size_t bodyIdx = m_generalDataIndex.at(entityID);
+		m_bodyStore.setPosition(bodyIdx, transform.position);
+		m_bodyStore.setVelocity(bodyIdx, rigidBody.velocity);
+	});
+
+	const std::vector<int> &errors = m_sgp4Batch.getErrors();
+	const size_t failures = std::count_if(errors.begin(), errors.end(), [](int error) { return error != 0 && error <= 4; });
+	if (failures > 0)
+		Log::Print(Log::T_WARNING, __FUNCTION__, "SGP4 propagation failed for " + std::to_string(failures) + " propagated bodies. Their previous states are kept.");
+
+
+	// Screen the step for close approaches (in TEME). This comes last, since subdividing long steps propagates the batch to other epochs.
+	if (g_appCtx.Config.simulation_ConjunctionThreshold > 0.0) {
+		const size_t eventCount = m_conjunctionEvents.size();
+		m_conjunctionScreener.advance(et, m_sgp4Positions, m_sgp4Velocities, m_sgp4Batch.getErrors(), m_conjunctionEvents);
+
+		for (size_t i = eventCount; i < m_conjunctionEvents.size(); i++)
+			reportConjunction(m_conjunctionEvents[i]);
+	}
+}
+
+
+void PhysicsSystem::resetConjunctionScreening() {
+	m_conjunctionEvents.clear();
+
+	ConjunctionScreener::Config config = m_conjunctionScreener.getConfig();
+	config.threshold = g_appCtx.Config.simulation_ConjunctionThreshold;
+	m_conjunctionScreener.setConfig(config);
+
+	std::vector<ConjunctionScreener::Shell> shells;
+	shells.reserve(m_sgp4PropIndices.size());
+
+	m_conjunctionElsets.clear();
+	m_conjunctionElsets.reserve(m_sgp4PropIndices.size());
+
+	for (size_t i : m_sgp4PropIndices) {
+		auto &&[entityID, propagator, transform, rigidBody] = m_propData[i];
+		shells.push_back(ConjunctionScreener::GetShell(propagator.tle.rec, config.shellMargin));
+		m_conjunctionElsets.push_back(propagator.tle.rec);
+	}
+
+	m_conjunctionCheckpoints.assign(m_sgp4PropIndices.size(), SDP4Checkpoints());
+
+	m_conjunctionScreener.reset(m_sgp4PropIndices.size(), shells);
+
+	// Close approaches are refined on the scalar model, from each object's own copy of its element set (whose deep-space resonance integrator resumes from the nearest checkpoint, rather than from the epoch)
+	m_conjunctionScreener.setObjectStateProvider([this](uint32_t object, double et, glm::dvec3 &position, glm::dvec3 &velocity) {
+		auto &&[entityID, propagator, transform, rigidBody] = m_propData[m_sgp4PropIndices[object]];
+
+		ElsetRec &rec = m_conjunctionElsets[object];
+		double r[3], v[3];
+		if (!m_conjunctionCheckpoints[object].propagate(rec, (et - propagator.tleEpochET) / 60.0, r, v) || rec.error != 0)
+			return false;
+
+		position = glm::dvec3(r[0], r[1], r[2]);
+		velocity = glm::dvec3(v[0], v[1], v[2]);
+		return true;
+	});
+
+	// Steps longer than the screener's maximum step (at high time scales) are subdivided by batch propagation
+	m_conjunctionScreener.setStateProvider([this](double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities, std::vector<int> &errors) {
+		m_sgp4Batch.propagate(et, positions, velocities, m_sgp4Pool);
+		errors = m_sgp4Batch.getErrors();
+	});
+}
+
+
+void PhysicsSystem::reportConjunction(const ConjunctionScreener::Event &event) {
+	static constexpr int PREC = 3;
+	static constexpr int LENOUT = 35;
+	char buf[LENOUT];
+
+	{
+		std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+		et2utc_c(event.tca, "C", PREC, LENOUT, buf);
+	}
+
+	std::ostringstream message;
+	message << "Conjunction: " << m_ecsRegistry->getEntity(m_sgp4BatchEntities[event.objectA]).name
+		<< " and " << m_ecsRegistry->getEntity(m_sgp4BatchEntities[event.objectB]).name
+		<< " at " << buf << " UTC, miss distance " << event.missDistance << " km, relative speed " << event.relativeSpeed << " km/s.";
+
+	Log::Print(Log::T_INFO, __FUNCTION__, message.str());
+}
+
+
+void PhysicsSystem::cacheEclipses() {
+	const ForceModelPipeline::Environment &env = m_forceModels.getEnvironment();
+
+	// Occulting bodies: every body with shape parameters, except the Sun
+	std::vector<EclipseTracker::Occulter> occulters;
+	std::vector<EntityID> occulterEntities;
+
+	for (const ForceModel::CentralBody &centralBody : env.centralBodies) {
+		if (centralBody.bodyIndex == env.sunIndex)
+			continue;
+
+		occulters.push_back(EclipseTracker::Occulter{ .bodyIndex = centralBody.bodyIndex, .radius = centralBody.equatRadius });
+		occulterEntities.push_back(std::get<EntityID>(m_generalData[centralBody.bodyIndex]));
+	}
+
+
+	// Spacecraft
+	std::vector<uint32_t> spacecraft;
+	std::vector<EntityID> spacecraftEntities;
+
+	for (size_t i = 0; i < m_generalData.size(); i++) {
+		const EntityID entityID = std::get<EntityID>(m_generalData[i]);
+		if (std::get<CoreComponent::Identifiers>(m_identifierData[i]).entityType != CoreComponent::Identifiers::EntityType::SPACECRAFT)
+			continue;
+
+		if (!m_ecsRegistry->hasComponent<PhysicsComponent::Eclipse>(entityID))
+			m_ecsRegistry->addComponent(entityID, PhysicsComponent::Eclipse{});
+
+		spacecraft.push_back(static_cast<uint32_t>(i));
+		spacecraftEntities.push_back(entityID);
+	}
+
+
+	// The tracker keeps its previous update (from which transitions are refined) across ticks, unless the bodies change
+	const std::vector<EclipseTracker::Occulter> &trackedOcculters = m_eclipseTracker.getOcculters();
+	const bool isSameOcculters = std::equal(occulters.begin(), occulters.end(), trackedOcculters.begin(), trackedOcculters.end(), [](const auto &a, const auto &b) {
+		return a.bodyIndex == b.bodyIndex && a.radius == b.radius;
+	});
+
+	if (isSameOcculters && env.sunIndex == m_eclipseTracker.getSunIndex() && spacecraft == m_eclipseTracker.getSpacecraft() && spacecraftEntities == m_eclipseEntities)
+		return;
+
+	m_eclipseTracker.setBodies(env.sunIndex, occulters, spacecraft);
+	m_eclipseEntities = spacecraftEntities;
+	m_eclipseOcculterEntities = occulterEntities;
+
+	m_eclipseData.resize(m_eclipseEntities.size());
+	for (size_t i = 0; i < m_eclipseEntities.size(); i++)
+		m_eclipseData[i] = m_ecsRegistry->getComponent<PhysicsComponent::Eclipse>(m_eclipseEntities[i]);
+}
+
+
+void PhysicsSystem::updateEclipses(const double et) {
+	if (m_eclipseEntities.empty())
+		return;
+
+	m_eclipseTransitions.clear();
+	m_eclipseTracker.update(et, m_bodyStore, m_forcePool, m_eclipseTransitions);
+
+
+	// Latest boundary crossings (in the order in which they occurred)
+	using State = EclipseTracker::State;
+
+	for (const EclipseTracker::Transition &transition : m_eclipseTransitions) {
+		PhysicsComponent::Eclipse &eclipse = m_eclipseData[transition.spacecraft];
+
+		if (transition.from == State::SUNLIGHT)
+			eclipse.penumbraEntryET = transition.et;
+		else if (transition.to == State::SUNLIGHT)
+			eclipse.penumbraExitET = transition.et;
+		else if (transition.from == State::PENUMBRA)
+			eclipse.umbraEntryET = transition.et;
+		else
+			eclipse.umbraExitET = transition.et;
+	}
+
+
+	// Current shadows
+	const std::vector<EclipseTracker::Shadow> &shadows = m_eclipseTracker.getShadows();
+
+	for (size_t i = 0; i < shadows.size(); i++) {
+		PhysicsComponent::Eclipse &eclipse = m_eclipseData[i];
+
+		eclipse.state = shadows[i].state;
+		eclipse.sunFraction = shadows[i].sunFraction;
+		eclipse.occulter = (shadows[i].occulter == EclipseTracker::NO_INDEX) ? INVALID_ENTITY : m_eclipseOcculterEntities[shadows[i].occulter];
+	}
+}
+
+
+void PhysicsSystem::propagateKeplerBodies(const double et) {
+	// Gather Kepler orbits
+	m_keplerPropIndices.clear();
+	m_keplerOrbits.clear();
+
+	for (size_t i = 0; i < m_propData.size(); i++) {
+		auto &&[entityID, propagator, transform, rigidBody] = m_propData[i];
+		if (propagator.propagatorType != PhysicsComponent::Propagator::Type::KEPLER)
+			continue;
+
+		if (!propagator.hasKeplerOrbit)
+			initKeplerOrbit(entityID, propagator, transform, rigidBody, et);
+
+		m_keplerPropIndices.push_back(i);
+		m_keplerOrbits.push_back(propagator.keplerOrbit);
+	}
+
+	if (m_keplerOrbits.empty())
+		return;
+
+
+	// Propagate all orbits at once
+	const size_t failures = KeplerPropagator::PropagateBatch(m_keplerOrbits, et, m_keplerPositions, m_keplerVelocities);
+	if (failures > 0)
+		Log::Print(Log::T_WARNING, __FUNCTION__, "The Kepler solver did not converge for " + std::to_string(failures) + " propagated bodies. Their previous states are kept.");
+
+
+	// Scatter states (relative to the moving parent bodies)
+	for (size_t k = 0; k < m_keplerPropIndices.size(); k++) {
+		auto &&[entityID, propagator, transform, rigidBody] = m_propData[m_keplerPropIndices[k]];
+		propagator.keplerOrbit = m_keplerOrbits[k];
+
+		const size_t parentIdx = m_generalDataIndex.at(propagator.parentBody);
+		const glm::dvec3 &relPosition = m_keplerPositions[k];
+		const double distance = glm::length(relPosition);
+
+		transform.position = m_bodyStore.getPosition(parentIdx) + relPosition;
+		rigidBody.velocity = m_bodyStore.getVelocity(parentIdx) + m_keplerVelocities[k];
+		rigidBody.acceleration = (distance > 0.0)
+			? -propagator.keplerOrbit.gravParam * relPosition / (distance * distance * distance)
+			: glm::dvec3(0.0);
+
+		const size_t bodyIdx = m_generalDataIndex.at(entityID);
+		m_bodyStore.setPosition(bodyIdx, transform.position);
+		m_bodyStore.setVelocity(bodyIdx, rigidBody.velocity);
+		m_bodyStore.setAcceleration(bodyIdx, rigidBody.acceleration);
+	}
+}
+
+
+void PhysicsSystem::propagateEnckeBodies(const double et) {
+	size_t failures = 0;
+
+	for (auto &&[entityID, propagator, transform, rigidBody] : m_propData) {
+		if (propagator.propagatorType != PhysicsComponent::Propagator::Type::ENCKE)
+			continue;
+
+		if (!propagator.hasKeplerOrbit)
+			initKeplerOrbit(entityID, propagator, transform, rigidBody, et);
+
+		const uint32_t bodyIdx = static_cast<uint32_t>(m_generalDataIndex.at(entityID));
+		const uint32_t parentIdx = static_cast<uint32_t>(m_generalDataIndex.at(propagator.parentBody));
+
+		// Sources (including the parent body) are held at their states at the target epoch
+		const glm::dvec3 parentPosition = m_bodyStore.getPosition(parentIdx);
+		const glm::dvec3 parentVelocity = m_bodyStore.getVelocity(parentIdx);
+		const glm::dvec3 bodyPosition = m_bodyStore.getPosition(bodyIdx);
+
+		auto pullOf = [this](uint32_t source, const glm::dvec3 &sourcePosition, const glm::dvec3 &position) {
+			const glm::dvec3 offset = sourcePosition - position;
+			const double distance = glm::length(offset);
+			return (distance > 0.0) ? (m_bodyStore.mu[source] / (distance * distance * distance)) * offset : glm::dvec3(0.0);
+		};
+
+		// The reference conic is centered on the parent body, which is itself accelerated by the other bodies (its pull by this body is evaluated along the way)
+		const glm::dvec3 parentAcceleration = GravityKernels::ComputeAccelerationAt(m_bodyStore, parentPosition, parentIdx) - pullOf(bodyIdx, bodyPosition, parentPosition);
+
+		// Perturbations relative to the parent body: every acceleration but the parent's point-mass gravity (which the reference conic accounts for)
+		auto perturbation = [&](double t, const glm::dvec3 &relPosition, const glm::dvec3 &relVelocity) {
+			const glm::dvec3 position = parentPosition + relPosition;
+
+			glm::dvec3 acceleration = GravityKernels::ComputeAccelerationAt(m_bodyStore, position, bodyIdx) - pullOf(parentIdx, parentPosition, position);
+			acceleration += m_forceModels.computeAcceleration(bodyIdx, m_bodyStore, position, parentVelocity + relVelocity, t);
+
+			return acceleration - (parentAcceleration + pullOf(bodyIdx, position, parentPosition));
+		};
+
+		EnckePropagator::State &state = propagator.enckeState;
+		if (!EnckePropagator::Propagate(state, et, perturbation)) {
+			failures++;
+			continue;
+		}
+
+
+		// Write new data to the cache
+		glm::dvec3 relPosition, relVelocity;
+		if (!EnckePropagator::GetState(state, relPosition, relVelocity)) {
+			failures++;
+			continue;
+		}
+
+		const double distance = glm::length(relPosition);
+
+		transform.position = parentPosition + relPosition;
+		rigidBody.velocity = parentVelocity + relVelocity;
+		rigidBody.acceleration = perturbation(et, relPosition, relVelocity);
+		if (distance > 0.0)
+			rigidBody.acceleration -= state.reference.gravParam * relPosition / (distance * distance * distance);
+
+		m_bodyStore.setPosition(bodyIdx, transform.position);
+		m_bodyStore.setVelocity(bodyIdx, rigidBody.velocity);
+		m_bodyStore.setAcceleration(bodyIdx, rigidBody.acceleration);
+	}
+
+	if (failures > 0)
+		Log::Print(Log::T_WARNING, __FUNCTION__, "Encke propagation failed for " + std::to_string(failures) + " propagated bodies. Their states are kept at their last successful steps.");
+}
+
+
+void PhysicsSystem::initKeplerOrbit(EntityID entityID, PhysicsComponent::Propagator &propagator, const CoreComponent::Transform &transform, const PhysicsComponent::RigidBody &rigidBody, const double et) {
+	propagator.parentBody = m_ecsRegistry->getComponent<PhysicsComponent::OrbitalElements>(entityID).parentBody;
+
+	LOG_ASSERT(m_generalDataIndex.count(propagator.parentBody), "Cannot initialize Kepler propagator: The parent body has no physical state!");
+	const size_t parentIdx = m_generalDataIndex.at(propagator.parentBody);
+
+	// Prefer the parent's published gravitational parameter over its mass
+	double gravParam = m_bodyStore.mu[parentIdx];
+	if (m_ecsRegistry->hasComponent<PhysicsComponent::ShapeParameters>(propagator.parentBody))
+		gravParam = m_ecsRegistry->getComponent<PhysicsComponent::ShapeParameters>(propagator.parentBody).gravParam;
+
+	propagator.keplerOrbit = KeplerPropagator::Orbit{
+		.position = transform.position - m_bodyStore.getPosition(parentIdx),
+		.velocity = rigidBody.velocity - m_bodyStore.getVelocity(parentIdx),
+		.epochET = et,
+		.gravParam = gravParam
+	};
+
+	// Encke propagators start from the osculating orbit of the same state
+	if (propagator.propagatorType == PhysicsComponent::Propagator::Type::ENCKE) {
+		if (!EnckePropagator::Rectify(propagator.enckeState, propagator.keplerOrbit.position, propagator.keplerOrbit.velocity, et, gravParam))
+			throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot initialize Encke propagator: The entity's state relative to its parent body does not define an orbit!");
+	}
+
+	propagator.hasKeplerOrbit = true;
+}
+
+
+void PhysicsSystem::homogenizeCoordinateSystems() {
+	// Convert TLE state vectors (TEME coordinate system)
+	auto view = m_ecsRegistry->getView<PhysicsComponent::Propagator, CoreComponent::Transform, PhysicsComponent::RigidBody>();
+
+	for (auto &&[entityID, propagator, transform, rigidBody] : view) {
+		// Kepler and Encke propagators are defined in this system's frame already
+		if (propagator.propagatorType != PhysicsComponent::Propagator::Type::SGP4)
+			continue;
+
+		// Compute TLE epoch, and get state vector from TLE (element sets loaded from catalogs are already parsed)
+		if (propagator.isTLEInitialized) {
+			propagator.tleEpochET = SPICEUtils::utcJulianDateToET(propagator.tle.rec.jdsatepoch, propagator.tle.rec.jdsatepochF);
+		}
+		else {
+			propagator.tleEpochET = SPICEUtils::tleEpochToET(propagator.tleLine1);
+			propagator.tle.parseLines(propagator.tleLine1, propagator.tleLine2);
+		}
+
+		double position[3], velocity[3];
 
 		propagator.tle.getRV(0.0, position, velocity);
 
@@ -424,9 +1559,8 @@ void PhysicsSystem::homogenizeCoordinateSystems() {
 
 
 		// Convert propagator output from km and km/s to m and m/s respectively
-		if (propagator.propagatorType == PhysicsComponent::Propagator::Type::SGP4)
-			for (size_t i = 0; i < stateVec.size(); i++)
-				stateVec[i] *= 1e3;
+		for (size_t i = 0; i < stateVec.size(); i++)
+			stateVec[i] *= 1e3;
 
 
 		// Write new data to the components
@@ -487,3 +1621,278 @@ void PhysicsSystem::createTrajectoryPoints() {
 		};
 	}
 }
+
+
+void PhysicsSystem::computeAccelerations(NBodyStore &store, double t) {
+	const size_t bodyCount = store.size();
+	const size_t taskCount = (bodyCount + FORCE_TASK_SIZE - 1) / FORCE_TASK_SIZE;
+
+	// NOTE: The choice between the serial and the parallel paths only depends on the number of bodies, so that the results never depend on the number of threads.
+	const bool isParallel = (bodyCount >= PARALLEL_FORCE_MIN_BODIES);
+
+	switch (m_gravitySolver) {
+	case Solvers::Gravity::BARNES_HUT:
+		// The tree is rebuilt over each stage's positions, and is only read afterwards
+		buildGravityTree(store);
+
+		m_forcePool.parallelFor(taskCount, [&](size_t task) {
+			const size_t last = std::min(bodyCount, (task + 1) * FORCE_TASK_SIZE);
+
+			for (size_t i = task * FORCE_TASK_SIZE; i < last; i++)
+				store.setAcceleration(i, m_gravityTree.computeAcceleration(store.getPosition(i), static_cast<uint32_t>(i)));
+		});
+		break;
+
+	case Solvers::Gravity::DIRECT:
+		if (!isParallel) {
+			GravityKernels::ComputeAccelerationsSymmetric(store);
+			break;
+		}
+
+		GravityKernels::ComputeAccelerationsSymmetricParallel(store, m_pairLaneAccelerations, m_forcePool);
+		break;
+	}
+
+	m_forceModels.apply(store, t);
+	m_burnScheduler.apply(store, t);
+}
+
+
+void PhysicsSystem::buildGravityTree(const NBodyStore &store) {
+	m_bodyPositions.resize(store.size());
+
+	for (size_t i = 0; i < store.size(); i++)
+		m_bodyPositions[i] = store.getPosition(i);
+
+	m_gravityTree.build(m_bodyPositions, store.mu);
+}
+
+
+void PhysicsSystem::reportGravitySolverError() {
+	using Clock = std::chrono::steady_clock;
+	static constexpr size_t SAMPLE_SIZE = 256;		// Target bodies compared (each against every body of the store), so that the report stays cheap in large scenes
+
+	const size_t bodyCount = m_bodyStore.size();
+	if (bodyCount < 2)
+		return;
+
+	// Targets, evenly spread over the store
+	const size_t sampleCount = std::min(bodyCount, SAMPLE_SIZE);
+	std::vector<uint32_t> targets(sampleCount);
+	for (size_t k = 0; k < sampleCount; k++)
+		targets[k] = static_cast<uint32_t>(k * bodyCount / sampleCount);
+
+
+	// Approximate accelerations
+	const Clock::time_point buildStart = Clock::now();
+	buildGravityTree(m_bodyStore);
+	const double buildTime = std::chrono::duration<double>(Clock::now() - buildStart).count();
+
+	std::vector<glm::dvec3> approxAccelerations(sampleCount);
+
+	const Clock::time_point approxStart = Clock::now();
+	for (size_t k = 0; k < sampleCount; k++)
+		approxAccelerations[k] = m_gravityTree.computeAcceleration(m_bodyPositions[targets[k]], targets[k]);
+	const double approxTime = std::chrono::duration<double>(Clock::now() - approxStart).count();
+
+
+	// Reference (direct-sum) accelerations
+	std::vector<glm::dvec3> exactAccelerations(sampleCount);
+
+	const Clock::time_point exactStart = Clock::now();
+	for (size_t k = 0; k < sampleCount; k++)
+		exactAccelerations[k] = GravityKernels::ComputeAccelerationAt(m_bodyStore, m_bodyPositions[targets[k]], targets[k]);
+	const double exactTime = std::chrono::duration<double>(Clock::now() - exactStart).count();
+
+
+	// Relative errors
+	double maxError = 0.0, sumError = 0.0, sumSqError = 0.0;
+	size_t comparedCount = 0;
+
+	for (size_t k = 0; k < sampleCount; k++) {
+		const double exactMagnitude = glm::length(exactAccelerations[k]);
+		if (exactMagnitude < EPSILON)
+			continue;
+
+		const double error = glm::length(approxAccelerations[k] - exactAccelerations[k]) / exactMagnitude;
+		maxError = std::max(maxError, error);
+		sumError += error;
+		sumSqError += error * error;
+		comparedCount++;
+	}
+
+	if (comparedCount == 0)
+		return;
+
+
+	std::ostringstream report;
+	report << "Barnes-Hut gravity solver (theta = " << m_gravityTree.getOpeningAngle() << ", " << bodyCount << " bodies, " << m_gravityTree.getNodeCount() << " nodes) against direct summation, on "
+		<< sampleCount << " target bodies:\n"
+		<< "\tRelative acceleration error: max = " << maxError << ", mean = " << (sumError / comparedCount) << ", RMS = " << std::sqrt(sumSqError / comparedCount) << "\n"
+		<< "\tEvaluation time per target: Barnes-Hut = " << (approxTime * 1e6 / sampleCount) << " us (tree build: " << (buildTime * 1e3) << " ms), direct = "
+		<< (exactTime * 1e6 / sampleCount) << " us";
+
+	Log::Print(Log::T_INFO, __FUNCTION__, report.str());
+}
+
+
+void PhysicsSystem::reportIntegratorStatistics(bool force) {
+	using Clock = std::chrono::steady_clock;
+	static constexpr double REPORT_INTERVAL = 10.0;		// Minimum real time between reports (s)
+
+	static Clock::time_point lastReport = Clock::now();
+	if (!force && std::chrono::duration<double>(Clock::now() - lastReport).count() < REPORT_INTERVAL)
+		return;
+	lastReport = Clock::now();
+
+
+	EmbeddedRK::Statistics stats{};
+	double meanRecentStep = 0.0;
+
+	if (m_integrationMode == Solvers::IntegrationMode::SYSTEM) {
+		stats = m_adaptiveSystemIntegrator.getStatistics();
+		meanRecentStep = stats.getMeanRecentStep();
+	}
+	else {
+		size_t integratedCount = 0;
+		for (const EmbeddedRKIntegrator &integrator : m_adaptiveBodyIntegrators) {
+			if (integrator.getStatistics().acceptedSteps == 0)
+				continue;
+
+			stats += integrator.getStatistics();
+			meanRecentStep += integrator.getStatistics().getMeanRecentStep();
+			integratedCount++;
+		}
+
+		if (integratedCount > 0)
+			meanRecentStep /= integratedCount;
+	}
+
+	if (stats.acceptedSteps == 0)
+		return;
+
+
+	std::ostringstream report;
+	report << "Adaptive integrator statistics (" << ((m_integrationMode == Solvers::IntegrationMode::SYSTEM) ? "system" : "per-body") << " error control):\n"
+		<< "\tSteps: " << stats.acceptedSteps << " accepted, " << stats.rejectedSteps << " rejected ("
+		<< (100.0 * stats.rejectedSteps / (stats.acceptedSteps + stats.rejectedSteps)) << "% rejection rate)\n"
+		<< "\tODE evaluations: " << stats.evaluations << " (" << (static_cast<double>(stats.evaluations) / stats.acceptedSteps) << " per accepted step)\n"
+		<< "\tStep size: min = " << stats.minStep << " s, max = " << stats.maxStep << " s, recent mean = " << meanRecentStep << " s";
+
+	Log::Print(Log::T_INFO, __FUNCTION__, report.str());
+}
+
+
+void PhysicsSystem::reportDroppedSimulationTime() {
+	using Clock = std::chrono::steady_clock;
+	static constexpr double REPORT_INTERVAL = 10.0;		// Minimum real time between reports (s)
+
+	static Clock::time_point lastReport = Clock::now() - std::chrono::seconds(static_cast<int>(REPORT_INTERVAL));
+	if (std::chrono::duration<double>(Clock::now() - lastReport).count() < REPORT_INTERVAL)
+		return;
+	lastReport = Clock::now();
+
+
+	std::ostringstream report;
+	report << "The time scale outpaces the symplectic integrator's step cap (" << SimulationConst::MAX_SIMULATION_STEPS << " steps of " << m_timeStep << " s per tick): "
+		<< m_droppedSimulationTime << " s of simulation time dropped so far. Raise the time step or lower the time scale.";
+
+	Log::Print(Log::T_WARNING, __FUNCTION__, report.str());
+}
+
+
+void PhysicsSystem::reportConservationDrift() {
+	using Clock = std::chrono::steady_clock;
+	static constexpr double REPORT_INTERVAL = 10.0;		// Minimum real time between reports (s)
+
+	static Clock::time_point lastReport = Clock::now();
+	if (std::chrono::duration<double>(Clock::now() - lastReport).count() < REPORT_INTERVAL)
+		return;
+	lastReport = Clock::now();
+
+
+	std::ostringstream report;
+	report << "Conservation drift over " << m_conservationMonitor.getSampleCount() << " samples:\n"
+		<< "\tRelative energy drift: " << m_conservationMonitor.getEnergyDrift() << " (max. " << m_conservationMonitor.getMaxEnergyDrift() << ")\n"
+		<< "\tRelative angular momentum drift: " << m_conservationMonitor.getAngularMomentumDrift() << " (max. " << m_conservationMonitor.getMaxAngularMomentumDrift() << ")";
+
+	if (m_integrator == Solvers::Integrator::WISDOM_HOLMAN)
+		report << "\n\tUnconverged Kepler drifts: " << m_wisdomHolmanIntegrator.getFailedDriftCount()
+			<< "\n\tSteps refused (covered by adaptive integration): " << m_wisdomHolmanIntegrator.getRefusedStepCount();
+
+	Log::Print(Log::T_INFO, __FUNCTION__, report.str());
+}
+
+
+void PhysicsSystem::reportEphemerisCache(bool force) {
+	using Clock = std::chrono::steady_clock;
+	static constexpr double REPORT_INTERVAL = 10.0;		// Minimum real time between reports (s)
+
+	static Clock::time_point lastReport = Clock::now();
+	if (!force && std::chrono::duration<double>(Clock::now() - lastReport).count() < REPORT_INTERVAL)
+		return;
+	lastReport = Clock::now();
+
+
+	const EphemerisCache::Statistics stats = m_ephemerisCache.getStatistics();
+	if (stats.queries == 0)
+		return;
+
+	const uint64_t segmentChanges = stats.prefetchHits + stats.prefetchMisses;
+
+	std::ostringstream report;
+	report << "Ephemeris cache statistics:\n"
+		<< "\tQueries: " << stats.queries << " answered with " << stats.spiceCalls << " SPICE calls ("
+		<< (static_cast<double>(stats.queries) / std::max<uint64_t>(stats.spiceCalls, 1)) << " queries per call)\n"
+		<< "\tSegments: " << stats.fits << " fitted, " << stats.refits << " refitted; "
+		<< (100.0 * stats.prefetchHits / std::max<uint64_t>(segmentChanges, 1)) << "% of segment changes served by the prefetch thread";
+
+	if (stats.validations > 0) {
+		report << std::scientific << std::setprecision(3)
+			<< "\n\tMax interpolation error over " << stats.validations << " validated queries:\n"
+			<< "\t\tPosition: " << stats.maxPositionError << " m (tolerance: " << m_ephemerisCache.getPositionTolerance() << " m)\n"
+			<< "\t\tVelocity: " << stats.maxVelocityError << " m/s\n"
+			<< "\t\tRotation: " << stats.maxRotationError << " rad (tolerance: " << m_ephemerisCache.getRotationTolerance() << " rad)";
+	}
+
+	Log::Print(Log::T_INFO, __FUNCTION__, report.str());
+}
+
+
+void PhysicsSystem::reportGravityFieldCost() {
+	static constexpr double SAMPLE_ALTITUDE = 400e3;		// Altitude of the sample positions above the reference radius (m)
+	static constexpr int DEGREE_LADDER[] = { 2, 4, 8, 12, 16, 20, 30, 40, 50, 70, 100, 150, 200, 360 };
+
+	const int degree = m_gravityField.getDegree();
+	const int order = m_gravityField.getOrder();
+	const double sampleRadius = m_gravityField.getRadius() + SAMPLE_ALTITUDE;
+
+
+	std::vector<std::pair<int, int>> truncations;
+	if (g_appCtx.Config.debugging_PhysicsDiagnostics) {
+		for (int ladderDegree : DEGREE_LADDER)
+			if (ladderDegree < degree)
+				truncations.push_back({ ladderDegree, ladderDegree });
+	}
+	truncations.push_back({ degree, order });
+
+	const std::vector<GravityField::CostReport> reports = m_gravityField.profile(truncations, sampleRadius);
+
+
+	std::ostringstream report;
+	report << std::fixed << std::setprecision(2);
+	report << "Gravity field cost (" << m_gravityFieldSpiceID << ", " << m_gravityFieldFrame << ", at " << SAMPLE_ALTITUDE / 1e3 << " km altitude):";
+
+	for (const GravityField::CostReport &entry : reports) {
+		report << "\n\t" << entry.degree << "x" << entry.order << ": " << entry.terms << " terms, "
+			<< entry.nsPerCall / 1e3 << " us/call";
+
+		if (entry.degree != degree || entry.order != order)
+			report << ", max deviation from " << degree << "x" << order << ": " << std::scientific << entry.maxDeviation << std::fixed << " m/s^2";
+		else
+			report << " (configured)";
+	}
+
+	Log::Print(Log::T_INFO, __FUNCTION__, report.str());
+}
+
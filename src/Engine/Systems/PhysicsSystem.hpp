@@ -6,30 +6,57 @@
 #define NOMINMAX	// minwindef.h keeps overriding std::min and std::max definitions provided by the algorithms header for some reason, so we have to define this macro to disable minwindef.h definitions. Why, Microsoft??
 
 #include <mutex>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
 #include <algorithm>
 
 
+#include <Core/Data/Math.hpp>
 #include <Core/Data/Physics.hpp>
 #include <Core/Utils/SpaceUtils.hpp>
 #include <Core/Utils/SPICEUtils.hpp>
 #include <Core/Utils/FilePathUtils.hpp>
+#include <Core/Data/Contexts/AppContext.hpp>
 #include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
 #include <Core/Application/Threading/WorkerThread.hpp>
 #include <Core/Application/Resources/ServiceLocator.hpp>
 
 #include <Engine/Systems/Subsystems/PhysicsRenderBridge.hpp>
 #include <Engine/Systems/Subsystems/Physics/OrbitPointGen.hpp>
 #include <Engine/Registry/ECS/ECS.hpp>
+#include <Engine/Registry/Event/EventDispatcher.hpp>
 #include <Engine/Registry/ECS/Components/PhysicsComponents.hpp>
 #include <Engine/Registry/ECS/Components/RenderComponents.hpp>
+#include <Engine/Registry/ECS/Components/SpacecraftComponents.hpp>
 
 #include <Simulation/ODEs.hpp>
+#include <Simulation/Data/Bodies.hpp>
 #include <Simulation/Systems/Time.hpp>
 #include <Simulation/Systems/CoordinateSystem.hpp>
+#include <Simulation/Systems/EphemerisCache.hpp>
+#include <Simulation/Gravity/BarnesHut.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Gravity/GravityKernels.hpp>
+#include <Simulation/Forces/ForceModelPipeline.hpp>
+#include <Simulation/Maneuvers/FiniteBurnScheduler.hpp>
+#include <Simulation/Dispersions/MonteCarloRunner.hpp>
 #include <Simulation/Algorithms/COE/RV2COE.hpp>
 #include <Simulation/Integrators/RK4.hpp>
+#include <Simulation/Integrators/NBodyRK4.hpp>
+#include <Simulation/Integrators/EmbeddedRK.hpp>
+#include <Simulation/Integrators/Symplectic.hpp>
+#include <Simulation/Integrators/WisdomHolman.hpp>
+#include <Simulation/Integrators/ConservationMonitor.hpp>
 #include <Simulation/Integrators/SymplecticEuler.hpp>
 #include <Simulation/Propagators/SGP4/TLE.hpp>
+#include <Simulation/Propagators/SGP4/SGP4Batch.hpp>
+#include <Simulation/Propagators/SGP4/SDP4Checkpoints.hpp>
+#include <Simulation/Conjunctions/ConjunctionScreener.hpp>
+#include <Simulation/Eclipses/EclipseTracker.hpp>
+#include <Simulation/Propagators/Kepler/KeplerPropagator.hpp>
+#include <Simulation/Propagators/Encke/EnckePropagator.hpp>
 
 
 class PhysicsSystem {
@@ -78,7 +105,9 @@ public:
 
 private:
 	std::shared_ptr<ECSRegistry> m_ecsRegistry;
+	std::shared_ptr<EventDispatcher> m_eventDispatcher;
 	std::shared_ptr<CoordinateSystem> m_coordSystem;
+	EphemerisCache m_ephemerisCache;								// Interpolated SPICE states and orientations
 
 	std::shared_ptr<PhysicsRenderBridge> m_physRendBridge;
 
@@ -99,7 +128,50 @@ private:
 	std::vector<std::tuple<EntityID, PhysicsComponent::Propagator, CoreComponent::Transform, PhysicsComponent::RigidBody>> m_propData;
 	std::vector<std::tuple<EntityID, CoreComponent::Identifiers>> m_identifierData;
 
+	// Structure-of-arrays state of every body in m_generalData (parallel to it).
+	// Between sync points, this is the authoritative copy of positions, velocities, and accelerations; it is loaded in cacheECSData and written back in syncECSData.
+	NBodyStore m_bodyStore;
+	std::vector<uint8_t> m_isFixedBody;		// Whether a body's state is driven externally (SPICE or a propagator), parallel to m_bodyStore
+	std::vector<uint8_t> m_isEnckeBody;		// Whether a body is propagated with Encke's method (and is therefore affected by the force models), parallel to m_bodyStore
+	std::unordered_map<EntityID, size_t> m_generalDataIndex;	// Maps entities to their indices in m_generalData (and m_bodyStore)
+	std::vector<uint32_t> m_spiceStateHandles;					// Ephemeris cache handles of the states of SPICE bodies (or EphemerisCache::NO_HANDLE), parallel to m_bodyStore
+	std::vector<uint32_t> m_spiceFrameHandles;					// Ephemeris cache handles of the IAU frames of SPICE bodies (or EphemerisCache::NO_HANDLE), parallel to m_bodyStore
+
+	struct _SPICEHandles {
+		uint32_t state;
+		uint32_t frame;
+	};
+	std::unordered_map<EntityID, _SPICEHandles> m_spiceEntityHandles;	// Ephemeris cache handles of every SPICE entity, resolved once per entity (so that ticks do no string work)
+
+	// SGP4 propagation (batch) buffers
+	SGP4Batch m_sgp4Batch;
+	std::vector<EntityID> m_sgp4BatchEntities;					// Entities whose element sets are in the batch, in batch order (the batch is rebuilt when they change)
+	std::vector<size_t> m_sgp4PropIndices;						// Indices of SGP4-propagated entities in m_propData
+	std::vector<glm::dvec3> m_sgp4Positions;					// TEME positions (km), in batch order
+	std::vector<glm::dvec3> m_sgp4Velocities;					// TEME velocities (km/s), in batch order
+	ThreadPool m_sgp4Pool;										// Threads sharing the propagation of SGP4 entities
+
+	// Conjunction screening (of SGP4 entities, in batch order)
+	ConjunctionScreener m_conjunctionScreener;
+	std::vector<ConjunctionScreener::Event> m_conjunctionEvents;	// Close approaches found since the batch was last rebuilt
+	std::vector<ElsetRec> m_conjunctionElsets;					// Element sets with which close approaches are refined, in batch order
+	std::vector<SDP4Checkpoints> m_conjunctionCheckpoints;		// Resonance integrator checkpoints of m_conjunctionElsets
+
+	// Eclipses of spacecraft
+	EclipseTracker m_eclipseTracker;
+	std::vector<EntityID> m_eclipseEntities;						// Entities of the tracker's spacecraft (parallel to its list)
+	std::vector<EntityID> m_eclipseOcculterEntities;				// Entities of the tracker's occulting bodies (parallel to its list)
+	std::vector<PhysicsComponent::Eclipse> m_eclipseData;			// Eclipse components of the tracker's spacecraft (parallel to its list)
+	std::vector<EclipseTracker::Transition> m_eclipseTransitions;	// Transitions found by the last update
+
+	// Kepler propagation (batch) buffers
+	std::vector<size_t> m_keplerPropIndices;					// Indices of Kepler-propagated entities in m_propData
+	std::vector<KeplerPropagator::Orbit> m_keplerOrbits;
+	std::vector<glm::dvec3> m_keplerPositions;
+	std::vector<glm::dvec3> m_keplerVelocities;
+
 	double m_accumulator = 0.0;
+	double m_droppedSimulationTime = 0.0;		// Simulation time (s) dropped because the time scale outpaced the symplectic step cap
 	double m_avgAccumulation = 0.0;
 	std::mutex m_accumulatorMutex;
 
@@ -112,6 +184,60 @@ private:
 	};
 	std::unordered_map<EntityID, _OrbitTrajectory> m_orbitTrajectories;
 
+	// Solvers
+	Solvers::Gravity m_gravitySolver = Solvers::Gravity::DIRECT;
+	Solvers::IntegrationMode m_integrationMode = Solvers::IntegrationMode::PER_BODY;
+	NBodyRK4Integrator m_systemIntegrator;
+	NBodySymplecticIntegrator m_symplecticSystemIntegrator;
+	NBodyWisdomHolmanIntegrator m_wisdomHolmanIntegrator;
+	bool m_wisdomHolmanFallbackReported = false;		// Whether the Wisdom-Holman integrator's fallback to adaptive integration has been reported
+
+	Solvers::Integrator m_integrator = Solvers::Integrator::RK4;
+	EmbeddedRK::Tolerance m_tolerance{ Solvers::DEFAULT_ABSOLUTE_TOLERANCE, Solvers::DEFAULT_RELATIVE_TOLERANCE };
+	EmbeddedRKIntegrator m_adaptiveSystemIntegrator;
+	std::vector<EmbeddedRKIntegrator> m_adaptiveBodyIntegrators;	// Per-body adaptive integrators, parallel to m_bodyStore
+	std::vector<double> m_flatState;								// Flattened state vectors of all bodies (system mode)
+	NBodyStore m_adaptiveStage;										// Stage buffer used to evaluate accelerations, with fixed bodies at the stage time
+
+	double m_timeStep = Solvers::DEFAULT_TIME_STEP;					// Step size of fixed-step integrators (s)
+	ConservationMonitor m_conservationMonitor;						// Energy and angular momentum drift of the body store
+
+	static constexpr double EPHEMERIS_UPDATE_INTERVAL = 600.0;		// Maximum simulation time (s) covered by a single update with adaptive integrators
+	BarnesHutTree m_gravityTree;
+	std::vector<glm::dvec3> m_bodyPositions;		// Scratch buffer used to (re)build the gravity tree
+	std::vector<double> m_treeGravParams;			// Scratch gravitational parameters of the tree's sources (adaptive per-body mode, fixed bodies zeroed)
+	NBodyStore m_fixedSources;						// Fixed bodies at the stage time, summed directly alongside the tree (adaptive per-body mode)
+	std::vector<uint32_t> m_fixedSourceIndices;		// Body store indices of m_fixedSources
+
+	// Perturbing force models
+	ForceModelPipeline m_forceModels;
+	std::vector<glm::dvec3> m_centralBodyRotVelocities;			// Body-fixed angular velocities of the force models' central bodies (parallel to their list)
+
+	struct _ThirdBodySource {
+		std::string spiceID;
+		double gravParam;
+		uint32_t ephemerisHandle;		// Ephemeris cache handle of the body's state
+	};
+	std::vector<_ThirdBodySource> m_thirdBodySources;				// Requested third bodies
+	std::vector<_ThirdBodySource> m_activeThirdBodySources;			// Requested third bodies that are not already part of the scene
+
+	GravityField m_gravityField;									// Spherical harmonic gravity field (if loaded)
+	std::string m_gravityFieldSpiceID;								// SPICE ID of the body the gravity field belongs to
+	std::string m_gravityFieldFrame;								// Body-fixed frame of the gravity field
+	uint32_t m_gravityFieldFrameHandle = EphemerisCache::NO_HANDLE;	// Ephemeris cache handle of the gravity field's frame
+
+	// Finite burns
+	FiniteBurnScheduler m_burnScheduler;
+	std::vector<EntityID> m_burnEntities;							// Entities of the scheduler's thrusters (parallel to its list)
+
+	// Monte Carlo dispersion analysis (see Application::SimulationConfig::monteCarlo)
+	MonteCarloRunner m_monteCarloRunner;
+
+	ThreadPool m_forcePool;											// Threads sharing the acceleration pass of system-mode integration
+	static constexpr size_t PARALLEL_FORCE_MIN_BODIES = 512;		// Minimum number of bodies for the parallel acceleration pass
+	static constexpr size_t FORCE_TASK_SIZE = 64;					// Number of target bodies per task of the parallel acceleration pass (Barnes-Hut solver)
+	std::vector<double> m_pairLaneAccelerations;					// Per-lane acceleration buffers of the parallel symmetric direct-sum pass
+
 
 	/* Caches physics data from the ECS registry.
 		The goal is to have update functions write to the cached data instead of querying views from the registry and updating the components directly, which can become a huge performance bottleneck with larger time scales.
@@ -136,6 +262,186 @@ private:
 	void homogenizeCoordinateSystems();
 
 
+	/* Propagates all entities with SGP4 propagators, and transforms their states from TEME to this system's frame in a single batch.
+		@param et: The epoch in Ephemeris Time.
+	*/
+	void propagateSGP4Bodies(const double et);
+
+
+	/* Resets conjunction screening to the SGP4 entities of the batch (with the configured threshold), and discards the close approaches found so far. */
+	void resetConjunctionScreening();
+
+
+	/* Logs a close approach between two SGP4 entities.
+		@param event: The close approach (whose objects are indices into the batch).
+	*/
+	void reportConjunction(const ConjunctionScreener::Event &event);
+
+
+	/* Registers the Sun, the occulting bodies (bodies with shape parameters) and the spacecraft with the eclipse tracker, adding eclipse components to spacecraft that have none. The tracker is only reset if these bodies change. */
+	void cacheEclipses();
+
+
+	/* Updates the shadow states of every spacecraft, and records the times of the shadow boundaries they crossed since the previous update in their eclipse components.
+		@param et: The epoch in Ephemeris Time.
+	*/
+	void updateEclipses(const double et);
+
+
+	/* Propagates all entities with Kepler propagators at once.
+		@param et: The epoch in Ephemeris Time.
+	*/
+	void propagateKeplerBodies(const double et);
+
+
+	/* Propagates all entities with Encke propagators, integrating their deviations from their reference conics under the gravity of the other bodies and the force models.
+		@param et: The epoch in Ephemeris Time.
+	*/
+	void propagateEnckeBodies(const double et);
+
+
+	/* Captures the reference state of a Kepler or Encke propagator from its entity's current state, relative to its parent body.
+		@param entityID: The propagated entity.
+		@param propagator: The entity's propagator.
+		@param transform: The entity's transform.
+		@param rigidBody: The entity's rigid body.
+		@param et: The current epoch in Ephemeris Time, which becomes the reference epoch.
+	*/
+	void initKeplerOrbit(EntityID entityID, PhysicsComponent::Propagator &propagator, const CoreComponent::Transform &transform, const PhysicsComponent::RigidBody &rigidBody, const double et);
+
+
 	/* Creates orbit trajectory points for each entity (if applicable) for orbit visualization. */
 	void createTrajectoryPoints();
+
+
+	/* Integrates general bodies one at a time. Each body sees the already-updated states of the bodies integrated before it.
+		@param dt: Delta-time.
+		@param et: The current epoch in Ephemeris Time.
+	*/
+	void integrateBodiesIndividually(const double dt, const double et);
+
+
+	/* Integrates all general bodies together as one system, evaluating every pairwise force once per stage.
+		@param dt: Delta-time.
+		@param et: The current epoch in Ephemeris Time.
+	*/
+	void integrateSystem(const double dt, const double et);
+
+
+	/* Integrates general bodies one at a time with adaptive step sizes, each under its own error control.
+		@param dt: The time interval to cover.
+		@param et: The current epoch in Ephemeris Time.
+	*/
+	void integrateBodiesIndividuallyAdaptive(const double dt, const double et);
+
+
+	/* Integrates all general bodies together with adaptive step sizes, under a single (system-wide) error control.
+		@param dt: The time interval to cover.
+		@param et: The current epoch in Ephemeris Time.
+	*/
+	void integrateSystemAdaptive(const double dt, const double et);
+
+
+	/* Loads the states of fixed bodies at a stage time within an update into a stage buffer. SPICE bodies are queried from the ephemeris cache; propagated bodies are extrapolated with their current velocities.
+		@param stage: The stage buffer (parallel to m_bodyStore).
+		@param et: The epoch of the start of the update in Ephemeris Time.
+		@param t: The stage time in Ephemeris Time.
+	*/
+	void loadFixedBodyStates(NBodyStore &stage, const double et, const double t);
+
+
+	/* Logs the step statistics of the adaptive integrators.
+		@param force: If false, the statistics are logged only if enough time has passed since the last report.
+	*/
+	void reportIntegratorStatistics(bool force);
+
+
+	/* Warns that simulation time has been dropped by the symplectic step cap (at most once per report interval). */
+	void reportDroppedSimulationTime();
+
+
+	/* Logs the energy and angular momentum drift recorded by the conservation monitor. */
+	void reportConservationDrift();
+
+
+	/* Logs the usage of the ephemeris cache, and the max interpolation errors recorded by its validation mode.
+		@param force: If false, the report is logged only if enough time has passed since the last one.
+	*/
+	void reportEphemerisCache(bool force);
+
+
+	/* Gets the composition scheme that corresponds to a symplectic integrator. */
+	static inline Symplectic::Scheme GetSymplecticScheme(Solvers::Integrator integrator) {
+		switch (integrator) {
+		case Solvers::Integrator::YOSHIDA4:
+			return Symplectic::Scheme::YOSHIDA4;
+		case Solvers::Integrator::YOSHIDA6:
+			return Symplectic::Scheme::YOSHIDA6;
+		case Solvers::Integrator::YOSHIDA8:
+			return Symplectic::Scheme::YOSHIDA8;
+		default:
+			return Symplectic::Scheme::VELOCITY_VERLET;
+		}
+	}
+
+
+	/* Gets the embedded Runge-Kutta method that corresponds to an (adaptive) integrator. */
+	static inline EmbeddedRK::Method GetEmbeddedRKMethod(Solvers::Integrator integrator) {
+		switch (integrator) {
+		case Solvers::Integrator::RKF45:
+			return EmbeddedRK::Method::RKF45;
+		case Solvers::Integrator::DOP853:
+			return EmbeddedRK::Method::DOP853;
+		default:
+			return EmbeddedRK::Method::DOPRI54;
+		}
+	}
+
+
+	/* Computes the accelerations of every body in a store (gravity from the configured gravity solver, plus the perturbing force models and the thrust of burning bodies), and writes them to the store's acceleration arrays.
+		With the direct solver, every pair of bodies is evaluated once (Newton's third law); stores of at least PARALLEL_FORCE_MIN_BODIES bodies are evaluated in parallel (see GravityKernels::ComputeAccelerationsSymmetricParallel), so the accelerations do not depend on the number of threads.
+
+		@param store: The body store. Its velocities must be valid if velocity-dependent force models (drag) are enabled.
+		@param t: The time at which the accelerations are evaluated, in Ephemeris Time.
+	*/
+	void computeAccelerations(NBodyStore &store, double t);
+
+
+	/* Registers the central bodies, the Sun, and the targets of the force models from the cached ECS data. */
+	void cacheForceModels();
+
+
+	/* Refreshes the time-dependent state of the force models (central body orientations, third-body ephemerides, and the central body of each target).
+		@param et: The current epoch in Ephemeris Time.
+	*/
+	void updateForceModels(const double et);
+
+
+	/* Freezes the scene, from its current state, into a Monte Carlo scenario. Bodies driven by propagators have no ephemerides to sample, and are left out.
+		@param duration: The simulation time the scenario's ephemerides must cover (s).
+		@param scenario [out]: The scenario.
+	*/
+	void buildMonteCarloScenario(const double duration, MonteCarloRunner::Scenario &scenario);
+
+
+	/* Registers the thrusters with scheduled burns from the cached ECS data. */
+	void cacheBurns();
+
+
+	/* Writes the mass of every thruster's body (after fuel consumption) to the body store and the cached ECS data. */
+	void updateThrusterMasses();
+
+
+	/* Rebuilds the Barnes-Hut gravity tree over the positions of all bodies in a store.
+		@param store: The body store.
+	*/
+	void buildGravityTree(const NBodyStore &store);
+
+
+	/* Reports the acceleration error and evaluation cost of the selected gravity solver against direct summation (GravityKernels), on a fixed sample of target bodies. The comparison over every body is benchmarked by AstrocelerateBenchmarks ("[barneshut]"). */
+	void reportGravitySolverError();
+
+
+	/* Reports the evaluation cost of the configured gravity field truncation. With physics diagnostics enabled, also reports the cost and accuracy of a ladder of cheaper truncations, from which the cheapest field meeting an accuracy target can be chosen. */
+	void reportGravityFieldCost();
 };
\ No newline at end of file
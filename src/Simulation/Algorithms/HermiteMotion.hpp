@@ -0,0 +1,30 @@
+/* HermiteMotion.hpp - Relative motion over an interval, interpolated between sampled states.
+*/
+
+#pragma once
+
+#include <Platform/External/GLM.hpp>
+
+
+/* The motion of a body relative to another over an interval, as the cubic Hermite interpolant of its sampled relative states.
+	Time is normalized to the interval (s in [0, 1]), so velocities are scaled by its duration. Positions and scaled velocities share the same (arbitrary) unit.
+*/
+struct HermiteMotion {
+	glm::dvec3 r0, r1;		// Relative positions at the ends of the interval
+	glm::dvec3 w0, w1;		// Relative velocities at the ends of the interval, scaled by its duration
+
+	/* Gets the relative position at a normalized time s (in [0, 1]). */
+	inline glm::dvec3 position(double s) const {
+		const double s2 = s * s, s3 = s2 * s;
+		return (2.0 * s3 - 3.0 * s2 + 1.0) * r0 + (s3 - 2.0 * s2 + s) * w0 + (-2.0 * s3 + 3.0 * s2) * r1 + (s3 - s2) * w1;
+	}
+
+	/* Gets the derivative of the relative position with respect to the normalized time. */
+	inline glm::dvec3 derivative(double s) const {
+		const double s2 = s * s;
+		return (6.0 * s2 - 6.0 * s) * r0 + (3.0 * s2 - 4.0 * s + 1.0) * w0 + (-6.0 * s2 + 6.0 * s) * r1 + (3.0 * s2 - 2.0 * s) * w1;
+	}
+
+	/* Gets the range rate function, r . dr/ds, whose root within the interval is a closest (or farthest) approach. */
+	inline double rangeRate(double s) const { return glm::dot(position(s), derivative(s)); }
+};
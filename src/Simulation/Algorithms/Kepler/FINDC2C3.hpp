@@ -0,0 +1,63 @@
+/* FINDC2C3 implementation
+	C++ adaptation of David Vallado's FINDC2C3 algorithm for Astrocelerate.
+
+	Sources:
+	- c2, c3 functions: Section 2.2 (Algorithm 1), Fundamentals of Astrodynamics and Applications
+	- findc2c3 MATLAB Implementation: https://github.com/jgte/matlab-sgp4/blob/master/findc2c3.m
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include <Platform/External/GLM.hpp>
+
+
+namespace Kepler {
+	/* Computes the c2 and c3 (Stumpff) functions of the universal-variable formulation.
+		@param psi: The universal variable squared, times the inverse of the semi-major axis (ψ = χ²/a).
+
+		@return The array {c2, c3}.
+	*/
+	inline std::array<double, 2> findc2c3(double psi) {
+		// Near ψ = 0, the closed forms suffer catastrophic cancellation (1 - cos√ψ, √ψ - sin√ψ). Their Taylor series, which converge quickly for |ψ| < 1, are used instead.
+		static constexpr double SERIES_THRESHOLD = 1.0;
+		static constexpr int SERIES_TERMS = 12;
+
+		double c2, c3;
+
+		// Elliptical
+		if (psi > SERIES_THRESHOLD) {
+			double sqrt_psi = std::sqrt(psi);
+			c2 = (1.0 - std::cos(sqrt_psi)) / psi;
+			c3 = (sqrt_psi - std::sin(sqrt_psi)) / (sqrt_psi * psi);
+		}
+
+		// Hyperbolic
+		else if (psi < -SERIES_THRESHOLD) {
+			double sqrt_psi = std::sqrt(-psi);
+			c2 = (1.0 - std::cosh(sqrt_psi)) / psi;
+			c3 = (std::sinh(sqrt_psi) - sqrt_psi) / (sqrt_psi * -psi);
+		}
+
+		// Parabolic (and nearly parabolic)
+		//	c2 = Σ (-ψ)^k / (2k + 2)!,  c3 = Σ (-ψ)^k / (2k + 3)!
+		else {
+			double term2 = 1.0 / 2.0;
+			double term3 = 1.0 / 6.0;
+			c2 = term2;
+			c3 = term3;
+
+			for (int k = 1; k < SERIES_TERMS; k++) {
+				term2 *= -psi / ((2.0 * k + 1.0) * (2.0 * k + 2.0));
+				term3 *= -psi / ((2.0 * k + 2.0) * (2.0 * k + 3.0));
+				c2 += term2;
+				c3 += term3;
+			}
+		}
+
+
+		return std::array<double, 2>{ c2, c3 };
+	}
+}
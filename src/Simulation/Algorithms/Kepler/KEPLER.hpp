@@ -0,0 +1,168 @@
+/* KEPLER implementation
+	C++ adaptation of David Vallado's KEPLER (universal-variable two-body propagation) algorithm for Astrocelerate.
+	The Newton iteration of the original is replaced by the Laguerre-Conway iteration, which converges from the same initial guesses for all conic sections, including highly eccentric and hyperbolic orbits where Newton's method can overshoot.
+
+	Sources:
+	- KEPLER Pseudocode: Algorithm 8, Fundamentals of Astrodynamics and Applications
+	- kepler MATLAB Implementation: https://github.com/jgte/matlab-sgp4/blob/master/kepler.m
+	- Laguerre-Conway iteration: B. A. Conway, "An improved algorithm due to Laguerre for the solution of Kepler's equation", Celestial Mechanics 39 (1986)
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Core/Data/Math.hpp>
+
+#include <Simulation/Algorithms/Kepler/FINDC2C3.hpp>
+
+
+namespace Kepler {
+	/* Propagates a state vector along its two-body (Keplerian) trajectory.
+		@param r0: The initial position vector, relative to the central body.
+		@param v0: The initial velocity vector, relative to the central body.
+		@param dt: The time of flight (may be negative).
+		@param mu: The gravitational parameter of the central body.
+		@param r [out]: The final position vector.
+		@param v [out]: The final velocity vector.
+		@param xi_io [in/out, optional]: If not null, an initial guess of the universal variable (used if finite, e.g., the solution of a nearby time of flight), which receives the converged value.
+
+		@return True if the universal-variable equation converged, false otherwise (in which case r and v are left unchanged).
+	*/
+	inline bool kepler(const glm::dvec3 &r0, const glm::dvec3 &v0, double dt, double mu, glm::dvec3 &r, glm::dvec3 &v, double *xi_io = nullptr) {
+		static constexpr int MAX_ITERATIONS = 50;
+		static constexpr double LAGUERRE_ORDER = 5.0;
+		static constexpr double TOLERANCE = 1e-13;			// Relative convergence tolerance of the universal variable
+		static constexpr double ROUNDOFF_FACTOR = 16.0;		// Residuals within this many ULPs of the magnitude of their terms are considered converged
+
+		const double r0_mag = glm::length(r0);
+		if (std::abs(dt) < R_EPSILON || r0_mag < R_EPSILON || mu <= 0.0) {
+			r = r0;
+			v = v0;
+			if (xi_io != nullptr)
+				*xi_io = 0.0;
+			return true;
+		}
+
+		const double sqrt_mu = std::sqrt(mu);
+		const double v0_mag_sq = glm::dot(v0, v0);
+		const double rdotv = glm::dot(r0, v0);
+		const double sigma0 = rdotv / sqrt_mu;
+
+		// Inverse of the semi-major axis (α > 0: elliptical, α = 0: parabolic, α < 0: hyperbolic)
+		const double alpha = 2.0 / r0_mag - v0_mag_sq / mu;
+
+
+		// Initial guess
+		double xi;
+
+			// Elliptical or circular
+		if (alpha > R_EPSILON / r0_mag) {
+			// Remove whole revolutions; they do not change the state
+			const double period = TWOPI / (sqrt_mu * alpha * std::sqrt(alpha));
+			if (std::abs(dt) > period)
+				dt = std::fmod(dt, period);
+
+			xi = sqrt_mu * dt * alpha;
+		}
+
+			// Hyperbolic
+		else if (alpha < -R_EPSILON / r0_mag) {
+			const double a = 1.0 / alpha;
+			const double sign_dt = (dt >= 0.0) ? 1.0 : -1.0;
+			const double arg = (-2.0 * mu * alpha * dt) / (rdotv + sign_dt * std::sqrt(-mu * a) * (1.0 - r0_mag * alpha));
+
+			xi = (arg > 0.0)
+				? sign_dt * std::sqrt(-a) * std::log(arg)
+				: sqrt_mu * dt / r0_mag;
+		}
+
+			// Parabolic
+		else {
+			const glm::dvec3 h = glm::cross(r0, v0);
+			const double p = glm::dot(h, h) / mu;
+			const double s = 0.5 * std::atan(1.0 / (3.0 * std::sqrt(mu / (p * p * p)) * dt));
+			const double w = std::atan(std::cbrt(std::tan(s)));
+
+			xi = std::sqrt(p) * 2.0 / std::tan(2.0 * w);
+		}
+
+
+		if (xi_io != nullptr && std::isfinite(*xi_io))
+			xi = *xi_io;
+
+
+		// Solve the universal Kepler equation with the Laguerre-Conway iteration
+		double c2 = 0.0, c3 = 0.0, psi = 0.0, r_mag = r0_mag;
+		bool converged = false;
+
+		for (int i = 0; i < MAX_ITERATIONS; i++) {
+			psi = xi * xi * alpha;
+			const auto [c2_i, c3_i] = findc2c3(psi);
+			c2 = c2_i;
+			c3 = c3_i;
+
+			const double xi_sq = xi * xi;
+			const double F = sigma0 * xi_sq * c2 + (1.0 - r0_mag * alpha) * xi_sq * xi * c3 + r0_mag * xi - sqrt_mu * dt;
+			const double dF = xi_sq * c2 + sigma0 * xi * (1.0 - psi * c3) + r0_mag * (1.0 - psi * c2);		// = |r|
+			const double ddF = sigma0 * (1.0 - psi * c2) + (1.0 - r0_mag * alpha) * xi * (1.0 - psi * c3);
+
+			r_mag = dF;
+
+			// Near the root, F is dominated by round-off in its (large, cancelling) terms, so the iteration may stall before the correction becomes negligible.
+			// A residual at the round-off level of its terms is accepted.
+			const double roundoffScale = std::abs(sigma0 * xi_sq * c2) + std::abs((1.0 - r0_mag * alpha) * xi_sq * xi * c3) + std::abs(r0_mag * xi) + sqrt_mu * std::abs(dt);
+			if (std::abs(F) <= ROUNDOFF_FACTOR * EPSILON * roundoffScale) {
+				converged = true;
+				break;
+			}
+
+			const double n = LAGUERRE_ORDER;
+			const double discriminant = std::abs((n - 1.0) * (n - 1.0) * dF * dF - n * (n - 1.0) * F * ddF);
+			const double denom = dF + ((dF >= 0.0) ? 1.0 : -1.0) * std::sqrt(discriminant);
+			if (std::abs(denom) < EPSILON)
+				break;
+
+			const double delta = n * F / denom;
+			xi -= delta;
+
+			if (std::abs(delta) <= TOLERANCE * std::max(1.0, std::abs(xi))) {
+				converged = true;
+				break;
+			}
+		}
+
+		if (!converged || !std::isfinite(xi))
+			return false;
+
+		if (xi_io != nullptr)
+			*xi_io = xi;
+
+
+		// Recompute the Stumpff functions at the converged universal variable
+		psi = xi * xi * alpha;
+		{
+			const auto [c2_i, c3_i] = findc2c3(psi);
+			c2 = c2_i;
+			c3 = c3_i;
+		}
+
+		const double xi_sq = xi * xi;
+		r_mag = xi_sq * c2 + sigma0 * xi * (1.0 - psi * c3) + r0_mag * (1.0 - psi * c2);
+
+
+		// Lagrange coefficients
+		const double f = 1.0 - xi_sq / r0_mag * c2;
+		const double g = dt - xi_sq * xi / sqrt_mu * c3;
+		const double g_dot = 1.0 - xi_sq / r_mag * c2;
+		const double f_dot = sqrt_mu / (r_mag * r0_mag) * xi * (psi * c3 - 1.0);
+
+		r = f * r0 + g * v0;
+		v = f_dot * r0 + g_dot * v0;
+
+		return true;
+	}
+}
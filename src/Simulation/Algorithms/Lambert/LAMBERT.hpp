@@ -0,0 +1,318 @@
+/* LAMBERT implementation
+	C++ implementation of Izzo's solver of Lambert's problem (the two-body orbit connecting two positions in a given time of flight) for Astrocelerate.
+	The time of flight is expressed as a function of a single variable x, whose Householder iteration converges in 2-3 iterations from its initial guesses for every transfer geometry, including multi-revolution transfers (whose left and right branches are both solved).
+
+	Sources:
+	- D. Izzo, "Revisiting Lambert's problem", Celestial Mechanics and Dynamical Astronomy 121 (2015)
+	- PyKEP Implementation: https://github.com/esa/pykep/blob/master/src/lambert_problem.cpp
+	- R. H. Battin, "An Introduction to the Mathematics and Methods of Astrodynamics", AIAA, 1999 (Section 7.4: hypergeometric series near the parabola)
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Core/Data/Math.hpp>
+
+
+namespace Lambert {
+	/* A solution of Lambert's problem. */
+	struct Solution {
+		glm::dvec3 v1;				// Velocity at the first position
+		glm::dvec3 v2;				// Velocity at the second position
+		int revolutions;			// Complete revolutions before the second position
+		bool isRightBranch;			// Whether the solution is on the right branch (the longer-period one) of a multi-revolution transfer
+		int iterations;				// Householder iterations taken
+	};
+
+
+	namespace _Izzo {
+		constexpr double BATTIN_THRESHOLD = 0.01;		// |x - 1| below which the time of flight is computed by Battin's series
+		constexpr double LAGRANGE_THRESHOLD = 0.2;		// |x - 1| below which the time of flight is computed by Lagrange's equation (and above which by Lancaster's)
+		constexpr int MAX_ITERATIONS = 15;
+		constexpr int MAX_TMIN_ITERATIONS = 12;
+
+
+		/* Gauss' hypergeometric function 2F1(3, 1; 5/2; z), by its series. */
+		inline double HypergeometricF(double z, double tolerance) {
+			double sum = 1.0;
+			double term = 1.0;
+
+			for (int j = 0; std::abs(term) > tolerance && j < 100; j++) {
+				term *= (3.0 + j) * (1.0 + j) / (2.5 + j) * z / (j + 1.0);
+				sum += term;
+			}
+
+			return sum;
+		}
+
+
+		/* Computes the non-dimensional time of flight of x by Lagrange's equation. */
+		inline double TimeOfFlightLagrange(double x, int revolutions, double lambda) {
+			const double a = 1.0 / (1.0 - x * x);
+
+				// Elliptical
+			if (a > 0.0) {
+				const double alpha = 2.0 * std::acos(std::clamp(x, -1.0, 1.0));
+				double beta = 2.0 * std::asin(std::sqrt(lambda * lambda / a));
+				if (lambda < 0.0)
+					beta = -beta;
+
+				return a * std::sqrt(a) * ((alpha - std::sin(alpha)) - (beta - std::sin(beta)) + TWOPI * revolutions) / 2.0;
+			}
+
+				// Hyperbolic
+			const double alpha = 2.0 * std::acosh(x);
+			double beta = 2.0 * std::asinh(std::sqrt(-lambda * lambda / a));
+			if (lambda < 0.0)
+				beta = -beta;
+
+			return -a * std::sqrt(-a) * ((beta - std::sinh(beta)) - (alpha - std::sinh(alpha))) / 2.0;
+		}
+
+
+		/* Computes the non-dimensional time of flight of x.
+			@param x: The iteration variable (x < 1: elliptical, x = 1: parabolic, x > 1: hyperbolic).
+			@param revolutions: The number of complete revolutions.
+			@param lambda: The transfer geometry parameter.
+
+			@return The non-dimensional time of flight.
+		*/
+		inline double TimeOfFlight(double x, int revolutions, double lambda) {
+			const double distance = std::abs(x - 1.0);
+
+			if (distance < LAGRANGE_THRESHOLD && distance > BATTIN_THRESHOLD)
+				return TimeOfFlightLagrange(x, revolutions, lambda);
+
+			const double k = lambda * lambda;
+			const double e = x * x - 1.0;
+			const double rho = std::abs(e);
+			const double z = std::sqrt(1.0 + k * e);
+
+				// Battin's series
+			if (distance < BATTIN_THRESHOLD) {
+				const double eta = z - lambda * x;
+				const double s1 = 0.5 * (1.0 - lambda - x * eta);
+				const double q = 4.0 / 3.0 * HypergeometricF(s1, 1e-11);
+
+				return (eta * eta * eta * q + 4.0 * lambda * eta) / 2.0 + revolutions * PI / std::pow(rho, 1.5);
+			}
+
+				// Lancaster's equation
+			const double y = std::sqrt(rho);
+			const double g = x * z - lambda * e;
+			double d;
+
+			if (e < 0.0)
+				d = revolutions * PI + std::acos(std::clamp(g, -1.0, 1.0));
+			else
+				d = std::log(y * (z - lambda * x) + g);
+
+			return (x - lambda * z - d / y) / e;
+		}
+
+
+		/* Computes the first three derivatives of the non-dimensional time of flight with respect to x.
+			@param x: The iteration variable.
+			@param T: The time of flight of x.
+			@param lambda: The transfer geometry parameter.
+			@param dT, ddT, dddT [out]: The derivatives.
+		*/
+		inline void TimeOfFlightDerivatives(double x, double T, double lambda, double &dT, double &ddT, double &dddT) {
+			const double l2 = lambda * lambda;
+			const double l3 = l2 * lambda;
+			const double umx2 = 1.0 - x * x;
+			const double y = std::sqrt(1.0 - l2 * umx2);
+			const double y2 = y * y;
+			const double y3 = y2 * y;
+
+			dT = 1.0 / umx2 * (3.0 * T * x - 2.0 + 2.0 * l3 * x / y);
+			ddT = 1.0 / umx2 * (3.0 * T + 5.0 * x * dT + 2.0 * (1.0 - l2) * l3 / y3);
+			dddT = 1.0 / umx2 * (7.0 * x * ddT + 8.0 * dT - 6.0 * (1.0 - l2) * l2 * l3 * x / y3 / y2);
+		}
+
+
+		/* Solves T(x) = T by Householder's (third-order) iteration.
+			@param T: The non-dimensional time of flight.
+			@param x [in/out]: The initial guess, which receives the solution.
+			@param revolutions: The number of complete revolutions.
+			@param lambda: The transfer geometry parameter.
+			@param tolerance: The convergence tolerance of x.
+
+			@return The number of iterations taken, or -1 if the iteration did not converge.
+		*/
+		inline int Householder(double T, double &x, int revolutions, double lambda, double tolerance) {
+			for (int iteration = 1; iteration <= MAX_ITERATIONS; iteration++) {
+				const double tof = TimeOfFlight(x, revolutions, lambda);
+
+				double dT, ddT, dddT;
+				TimeOfFlightDerivatives(x, tof, lambda, dT, ddT, dddT);
+
+				const double delta = tof - T;
+				const double dT2 = dT * dT;
+				const double xNew = x - delta * (dT2 - delta * ddT / 2.0) / (dT * (dT2 - delta * ddT) + dddT * delta * delta / 6.0);
+
+				if (!std::isfinite(xNew))
+					return -1;
+
+				const double error = std::abs(x - xNew);
+				x = xNew;
+
+				if (error <= tolerance)
+					return iteration;
+			}
+
+			return -1;
+		}
+	}
+
+
+	/* Solves Lambert's problem.
+		@param r1: The first position vector, relative to the central body.
+		@param r2: The second position vector, relative to the central body.
+		@param tof: The time of flight (must be positive).
+		@param mu: The gravitational parameter of the central body.
+		@param isRetrograde: Whether the transfer is retrograde (clockwise as seen from +Z) rather than prograde.
+		@param maxRevolutions: The maximum number of complete revolutions. Multi-revolution solutions are found only up to the number of revolutions the time of flight allows.
+		@param solutions [out]: The vector that receives the solutions (cleared first): the single-revolution solution, then the left and right branches of each number of revolutions.
+
+		@return True if the single-revolution solution was found, false otherwise (including degenerate geometries, e.g., 180° transfers whose plane is undefined).
+	*/
+	inline bool izzo(const glm::dvec3 &r1, const glm::dvec3 &r2, double tof, double mu, bool isRetrograde, int maxRevolutions, std::vector<Solution> &solutions) {
+		solutions.clear();
+
+		const double r1_mag = glm::length(r1);
+		const double r2_mag = glm::length(r2);
+		const double c = glm::length(r2 - r1);
+
+		if (tof <= 0.0 || mu <= 0.0 || r1_mag < R_EPSILON || r2_mag < R_EPSILON || c < R_EPSILON)
+			return false;
+
+		const double s = (r1_mag + r2_mag + c) / 2.0;
+
+		const glm::dvec3 ir1 = r1 / r1_mag;
+		const glm::dvec3 ir2 = r2 / r2_mag;
+		glm::dvec3 ih = glm::cross(ir1, ir2);
+		const double ih_mag = glm::length(ih);
+
+		if (ih_mag < 1e-12)
+			return false;
+		ih /= ih_mag;
+
+
+		// Transfer geometry
+		double lambda = std::sqrt(std::max(0.0, 1.0 - c / s));
+		glm::dvec3 it1, it2;
+
+		if (ih.z < 0.0) {
+			lambda = -lambda;
+			it1 = glm::normalize(glm::cross(ir1, ih));
+			it2 = glm::normalize(glm::cross(ir2, ih));
+		}
+		else {
+			it1 = glm::normalize(glm::cross(ih, ir1));
+			it2 = glm::normalize(glm::cross(ih, ir2));
+		}
+
+		if (isRetrograde) {
+			lambda = -lambda;
+			it1 = -it1;
+			it2 = -it2;
+		}
+
+		const double l2 = lambda * lambda;
+		const double l3 = l2 * lambda;
+
+		// Non-dimensional time of flight
+		const double T = std::sqrt(2.0 * mu / (s * s * s)) * tof;
+
+
+		// Maximum number of revolutions, from the minimum time of flight of the highest one (found by Halley's iteration)
+		int revolutionLimit = static_cast<int>(T / PI);
+		const double T00 = std::acos(lambda) + lambda * std::sqrt(1.0 - l2);
+		const double T0 = T00 + revolutionLimit * PI;
+		const double T1 = 2.0 / 3.0 * (1.0 - l3);
+
+		if (revolutionLimit > 0 && T < T0) {
+			double xOld = 0.0;
+			double Tmin = T0;
+
+			for (int iteration = 0; iteration <= _Izzo::MAX_TMIN_ITERATIONS; iteration++) {
+				double dT, ddT, dddT;
+				_Izzo::TimeOfFlightDerivatives(xOld, Tmin, lambda, dT, ddT, dddT);
+
+				const double xNew = (dT != 0.0) ? xOld - dT * ddT / (ddT * ddT - dT * dddT / 2.0) : xOld;
+				if (std::abs(xOld - xNew) < 1e-13)
+					break;
+
+				Tmin = _Izzo::TimeOfFlight(xNew, revolutionLimit, lambda);
+				xOld = xNew;
+			}
+
+			if (Tmin > T)
+				revolutionLimit--;
+		}
+		revolutionLimit = std::min(std::max(maxRevolutions, 0), revolutionLimit);
+
+
+		// Velocities from x
+		const double gamma = std::sqrt(mu * s / 2.0);
+		const double rho = (r1_mag - r2_mag) / c;
+		const double sigma = std::sqrt(std::max(0.0, 1.0 - rho * rho));
+
+		auto addSolution = [&](double x, int revolutions, bool isRightBranch, int iterations) {
+			const double y = std::sqrt(1.0 - l2 + l2 * x * x);
+			const double vr1 = gamma * ((lambda * y - x) - rho * (lambda * y + x)) / r1_mag;
+			const double vr2 = -gamma * ((lambda * y - x) + rho * (lambda * y + x)) / r2_mag;
+			const double vt = gamma * sigma * (y + lambda * x);
+
+			solutions.push_back(Solution{
+				.v1 = vr1 * ir1 + (vt / r1_mag) * it1,
+				.v2 = vr2 * ir2 + (vt / r2_mag) * it2,
+				.revolutions = revolutions,
+				.isRightBranch = isRightBranch,
+				.iterations = iterations
+			});
+		};
+
+
+		// Single revolution
+		{
+			double x;
+			if (T >= T00)
+				x = -(T - T00) / (T - T00 + 4.0);
+			else if (T <= T1)
+				x = T1 * (T1 - T) / (2.0 / 5.0 * (1.0 - l2 * l3) * T) + 1.0;
+			else
+				x = std::pow(T / T00, 0.69314718055994529 / std::log(T1 / T00)) - 1.0;
+
+			const int iterations = _Izzo::Householder(T, x, 0, lambda, 1e-5);
+			if (iterations < 0)
+				return false;
+
+			addSolution(x, 0, false, iterations);
+		}
+
+
+		// Multiple revolutions (left and right branches)
+		for (int n = 1; n <= revolutionLimit; n++) {
+			double tmp = std::pow((n * PI + PI) / (8.0 * T), 2.0 / 3.0);
+			double x = (tmp - 1.0) / (tmp + 1.0);
+			int iterations = _Izzo::Householder(T, x, n, lambda, 1e-8);
+			if (iterations >= 0)
+				addSolution(x, n, false, iterations);
+
+			tmp = std::pow(8.0 * T / (n * PI), 2.0 / 3.0);
+			x = (tmp - 1.0) / (tmp + 1.0);
+			iterations = _Izzo::Householder(T, x, n, lambda, 1e-8);
+			if (iterations >= 0)
+				addSolution(x, n, true, iterations);
+		}
+
+		return true;
+	}
+}
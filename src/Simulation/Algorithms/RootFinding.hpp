@@ -0,0 +1,57 @@
+/* RootFinding.hpp - Bracketed root finding for event refinement (e.g., rises and sets, shadow boundaries, closest approaches).
+	Sources:
+		- M. Dowell, P. Jarratt, "A modified regula falsi method for computing the root of an equation", BIT 11 (1971) (Illinois algorithm).
+*/
+
+#pragma once
+
+#include <cmath>
+
+
+namespace RootFinding {
+	constexpr int MAX_ITERATIONS = 64;
+
+
+	/* Finds a root of a function within a bracket by the Illinois variant of regula falsi (which keeps the root bracketed).
+		@param f: The function.
+		@param a, b: The bracket (a < b).
+		@param fa, fb: The values of the function at a and b, of opposite signs.
+		@param tolerance: The tolerance of the root.
+		@param maxIterations (optional): The maximum number of iterations.
+
+		@return The root.
+	*/
+	template<typename Function>
+	inline double FindRoot(Function &&f, double a, double b, double fa, double fb, double tolerance, int maxIterations = MAX_ITERATIONS) {
+		double s = a;
+		int side = 0;
+
+		for (int iteration = 0; iteration < maxIterations; iteration++) {
+			const double previous = s;
+			s = (a * fb - b * fa) / (fb - fa);
+			if ((iteration > 0 && std::fabs(s - previous) < tolerance) || b - a < tolerance)
+				break;
+
+			const double fs = f(s);
+			if (fs == 0.0)
+				break;
+
+			if ((fs > 0.0) == (fa > 0.0)) {
+				a = s;
+				fa = fs;
+				if (side == 1)
+					fb *= 0.5;
+				side = 1;
+			}
+			else {
+				b = s;
+				fb = fs;
+				if (side == -1)
+					fa *= 0.5;
+				side = -1;
+			}
+		}
+
+		return s;
+	}
+}
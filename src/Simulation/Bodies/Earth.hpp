@@ -36,6 +36,7 @@ namespace _Bodies {
         double getEquatRadius() const override { return 6.3781363e+6; }
         glm::dvec3 getRotVelocity() const override { return glm::dvec3(0.0, 0.0, 7.2921159e-5); }
         double getJ2() const override { return 1.08262668355315e-3; }
+        std::array<double, 4> getHigherZonals() const override { return { -2.53265649e-6, -1.61962159e-6, -2.27296083e-7, 5.40681239e-7 }; }	// EGM96
         double getFlattening() const override { return 0.0033528197; }
         double getMass() const override { return 5.972e+24; }
 
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <array>
+
+
 #include <Platform/External/GLM.hpp>
 
 #include <Engine/Registry/ECS/Components/CoreComponents.hpp>
@@ -30,6 +33,9 @@ public:
 	/* J2 oblateness coefficient */
 	virtual double getJ2() const = 0;
 
+	/* Higher zonal harmonic coefficients (J3 to J6). Bodies without published values return zeros. */
+	virtual std::array<double, 4> getHigherZonals() const { return {}; }
+
 	/* Flattening */
 	virtual double getFlattening() const = 0;
 
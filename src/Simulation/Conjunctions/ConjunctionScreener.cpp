@@ -0,0 +1,484 @@
+/* ConjunctionScreener.cpp - Conjunction screening implementation.
+*/
+
+#include "ConjunctionScreener.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+
+#include <Simulation/Algorithms/RootFinding.hpp>
+#include <Simulation/Algorithms/HermiteMotion.hpp>
+
+
+namespace {
+	constexpr double MAX_ACCELERATION = 0.00982;		// Gravitational acceleration at Earth's surface, which bounds the acceleration of orbiting objects (km/s^2)
+	constexpr double TCA_TOLERANCE = 1e-4;				// Tolerance of the time of closest approach (s)
+	constexpr int MAX_TCA_ITERATIONS = 64;
+	constexpr int MAX_REFINEMENT_ITERATIONS = 8;
+	constexpr double REFINEMENT_RANGE = 2.0;			// Interpolated miss distances up to which close approaches are refined (in thresholds)
+
+	// Cell keys: the level of the grid, and three 19-bit cell coordinates (biased, so that they are non-negative)
+	constexpr int64_t CELL_COORDINATE_BITS = 19;
+	constexpr int64_t CELL_COORDINATE_MAX = (int64_t(1) << CELL_COORDINATE_BITS) - 1;
+	constexpr int64_t CELL_COORDINATE_BIAS = int64_t(1) << (CELL_COORDINATE_BITS - 1);
+	constexpr int64_t CELL_LEVEL_SHIFT = 3 * CELL_COORDINATE_BITS;
+	constexpr uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max();
+
+
+	inline uint64_t PackCell(uint32_t level, int64_t x, int64_t y, int64_t z) {
+		return (static_cast<uint64_t>(level) << CELL_LEVEL_SHIFT) | (static_cast<uint64_t>(x) << (2 * CELL_COORDINATE_BITS)) | (static_cast<uint64_t>(y) << CELL_COORDINATE_BITS) | static_cast<uint64_t>(z);
+	}
+
+
+	/* Gets the (biased) cell coordinate of a position coordinate. Positions beyond the grid are clamped to its edge cells, which only adds candidates. */
+	inline int64_t GetCellCoordinate(double x, double inverseCellSize) {
+		const double cell = std::floor(x * inverseCellSize) + static_cast<double>(CELL_COORDINATE_BIAS);
+		return static_cast<int64_t>(std::clamp(cell, 0.0, static_cast<double>(CELL_COORDINATE_MAX)));
+	}
+
+
+	/* Forward neighbors of a cell: the 13 of its 26 neighbors whose offsets are lexicographically positive, so that every pair of neighboring cells is visited once. */
+	constexpr int FORWARD_NEIGHBORS[13][3] = {
+		{ 1, -1, -1 }, { 1, -1, 0 }, { 1, -1, 1 },
+		{ 1,  0, -1 }, { 1,  0, 0 }, { 1,  0, 1 },
+		{ 1,  1, -1 }, { 1,  1, 0 }, { 1,  1, 1 },
+		{ 0,  1, -1 }, { 0,  1, 0 }, { 0,  1, 1 },
+		{ 0,  0,  1 }
+	};
+}
+
+
+ConjunctionScreener::Shell ConjunctionScreener::GetShell(const ElsetRec &rec, double margin) {
+	const double semiMajorAxis = rec.a * rec.radiusearthkm;
+	return Shell{
+		.perigee = semiMajorAxis * (1.0 - rec.ecco) - margin,
+		.apogee = semiMajorAxis * (1.0 + rec.ecco) + margin
+	};
+}
+
+
+void ConjunctionScreener::reset(size_t objectCount, const std::vector<Shell> &shells) {
+	LOG_ASSERT(shells.empty() || shells.size() == objectCount, "Cannot reset conjunction screener: There must be one radial shell per object!");
+
+	m_objectCount = objectCount;
+	m_shells = shells;
+	m_hasPrevious = false;
+	m_skipReported = false;
+
+
+	// Pairs passing the apogee/perigee filter: sorted by perigee, an object's shell overlaps those of the following objects whose perigees are within the threshold of its apogee
+	m_shellPairCount = static_cast<uint64_t>(objectCount) * (objectCount - std::min<size_t>(objectCount, 1)) / 2;
+
+	if (!m_shells.empty()) {
+		std::vector<double> perigees(objectCount);
+		std::vector<uint32_t> order(objectCount);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return m_shells[a].perigee < m_shells[b].perigee; });
+
+		for (size_t k = 0; k < objectCount; k++)
+			perigees[k] = m_shells[order[k]].perigee;
+
+		m_shellPairCount = 0;
+		for (size_t k = 0; k < objectCount; k++) {
+			const size_t end = std::upper_bound(perigees.begin() + k + 1, perigees.end(), m_shells[order[k]].apogee + m_config.threshold) - perigees.begin();
+			m_shellPairCount += end - (k + 1);
+		}
+	}
+}
+
+
+size_t ConjunctionScreener::advance(double et, const std::vector<glm::dvec3> &positions, const std::vector<glm::dvec3> &velocities, const std::vector<int> &errors, std::vector<Event> &events) {
+	const double dt = et - m_previousET;
+
+	if (!m_hasPrevious || std::fabs(dt) <= m_config.maxStep)
+		return advanceSample(et, positions, velocities, errors, m_config.maxStep, events);
+
+	if (!m_stateProvider) {
+		if (!m_skipReported) {
+			Log::Print(Log::T_WARNING, __FUNCTION__, "Intervals longer than " + std::to_string(m_config.maxStep) + " s (e.g., at high time scales) are not screened for conjunctions: No state provider is set to subdivide them.");
+			m_skipReported = true;
+		}
+
+		return advanceSample(et, positions, velocities, errors, m_config.maxStep, events);
+	}
+
+
+	// Long intervals (e.g., at high time scales) are subdivided at the coarse step, as in ConjunctionScreener::screen. The sample is copied first, since the provider may share its storage.
+	using Clock = std::chrono::steady_clock;
+
+	m_endPositions.assign(positions.begin(), positions.begin() + m_objectCount);
+	m_endVelocities.assign(velocities.begin(), velocities.begin() + m_objectCount);
+	m_endErrors.assign(errors.begin(), errors.begin() + std::min(errors.size(), m_objectCount));
+
+	const double startET = m_previousET;
+	const size_t subintervalCount = static_cast<size_t>(std::ceil(std::fabs(dt) / m_config.step));
+	size_t eventCount = 0;
+
+	m_stats.subdividedIntervals++;
+
+	for (size_t k = 1; k < subintervalCount; k++) {
+		const double subET = startET + dt * (static_cast<double>(k) / subintervalCount);
+
+		const Clock::time_point start = Clock::now();
+		m_stateProvider(subET, m_subPositions, m_subVelocities, m_subErrors);
+		m_stats.propagationTime += std::chrono::duration<double>(Clock::now() - start).count();
+
+		eventCount += advanceSample(subET, m_subPositions, m_subVelocities, m_subErrors, std::numeric_limits<double>::infinity(), events);
+	}
+
+	eventCount += advanceSample(et, m_endPositions, m_endVelocities, m_endErrors, std::numeric_limits<double>::infinity(), events);
+	return eventCount;
+}
+
+
+size_t ConjunctionScreener::advanceSample(double et, const std::vector<glm::dvec3> &positions, const std::vector<glm::dvec3> &velocities, const std::vector<int> &errors, double maxStep, std::vector<Event> &events) {
+	LOG_ASSERT(positions.size() >= m_objectCount && velocities.size() >= m_objectCount && (errors.empty() || errors.size() >= m_objectCount),
+		"Cannot screen conjunctions: The sample must have a state for every object!");
+
+	using Clock = std::chrono::steady_clock;
+	const double dt = et - m_previousET;
+	size_t eventCount = 0;
+
+	if (m_hasPrevious && dt != 0.0) {
+		if (std::fabs(dt) > maxStep)
+			m_stats.skippedIntervals++;
+
+		else {
+			const Clock::time_point start = Clock::now();
+
+			m_intervalValid.resize(m_objectCount);
+			for (size_t i = 0; i < m_objectCount; i++)
+				m_intervalValid[i] = m_previousValid[i] && (errors.empty() || errors[i] == 0);
+
+			// Intervals may run backwards (e.g., with negative time scales)
+			if (dt > 0.0)
+				eventCount = screenInterval(m_previousET, et, m_previousPositions.data(), m_previousVelocities.data(), positions.data(), velocities.data(), m_intervalValid.data(), events);
+			else
+				eventCount = screenInterval(et, m_previousET, positions.data(), velocities.data(), m_previousPositions.data(), m_previousVelocities.data(), m_intervalValid.data(), events);
+
+			m_stats.screeningTime += std::chrono::duration<double>(Clock::now() - start).count();
+		}
+	}
+
+
+	// Keep the sample for the next interval
+	m_hasPrevious = true;
+	m_previousET = et;
+	m_previousPositions.assign(positions.begin(), positions.begin() + m_objectCount);
+	m_previousVelocities.assign(velocities.begin(), velocities.begin() + m_objectCount);
+
+	m_previousValid.resize(m_objectCount);
+	for (size_t i = 0; i < m_objectCount; i++)
+		m_previousValid[i] = (errors.empty() || errors[i] == 0);
+
+	return eventCount;
+}
+
+
+std::vector<ConjunctionScreener::Event> ConjunctionScreener::screen(double startET, double endET, const StateProvider &stateProvider) {
+	LOG_ASSERT(m_config.step > 0.0 && endET >= startET, "Cannot screen conjunctions: The step must be positive, and the window must not end before it starts!");
+
+	using Clock = std::chrono::steady_clock;
+
+	std::vector<Event> events;
+	std::vector<glm::dvec3> positions, velocities;
+	std::vector<int> errors;
+
+	m_hasPrevious = false;
+
+	for (size_t k = 0; ; k++) {
+		const double et = std::min(startET + k * m_config.step, endET);
+
+		const Clock::time_point start = Clock::now();
+		stateProvider(et, positions, velocities, errors);
+		m_stats.propagationTime += std::chrono::duration<double>(Clock::now() - start).count();
+
+		advanceSample(et, positions, velocities, errors, std::numeric_limits<double>::infinity(), events);
+
+		if (et >= endET)
+			break;
+	}
+
+	// The last sample is not part of the (online) samples that ConjunctionScreener::advance screens
+	m_hasPrevious = false;
+
+	std::sort(events.begin(), events.end(), [](const Event &a, const Event &b) { return a.tca < b.tca; });
+	return events;
+}
+
+
+size_t ConjunctionScreener::screenInterval(double t0, double t1, const glm::dvec3 *r0, const glm::dvec3 *v0, const glm::dvec3 *r1, const glm::dvec3 *v1, const uint8_t *valid, std::vector<Event> &events) {
+	const double h = t1 - t0;
+	const double threshold = m_config.threshold;
+	const bool hasShells = !m_shells.empty();
+
+
+	// Motion bounds: over the interval, every object stays within |v|h + a h^2 / 2 of its position at its start
+	m_motionRadii.resize(m_objectCount);
+
+	size_t validCount = 0;
+	double minRadius = std::numeric_limits<double>::infinity(), maxRadius = 0.0;
+
+	for (size_t i = 0; i < m_objectCount; i++) {
+		if (!valid[i])
+			continue;
+
+		m_motionRadii[i] = glm::length(v0[i]) * h + 0.5 * MAX_ACCELERATION * h * h;
+		minRadius = std::min(minRadius, m_motionRadii[i]);
+		maxRadius = std::max(maxRadius, m_motionRadii[i]);
+		validCount++;
+	}
+
+	const uint64_t pairCount = static_cast<uint64_t>(validCount) * (validCount - std::min<size_t>(validCount, 1)) / 2;
+	m_stats.intervals++;
+	m_stats.pairs += pairCount;
+	m_stats.shellPairs += hasShells ? std::min(m_shellPairCount, pairCount) : pairCount;
+
+	if (validCount < 2)
+		return 0;
+
+
+	// Multi-level spatial hash: objects are binned into levels whose motion radius bounds double from the smallest radius (the last level is bounded by the largest radius), and each level is hashed into its own grid, with cells wider than the threshold plus twice the level's bound.
+	// A pair can then only come closer than the threshold if its objects are in the same or neighboring cells of the grid of the higher of their levels, so that fast (or eccentric) objects only coarsen the grid of their own level.
+	m_levelCount = 1;
+	if (minRadius > 0.0 && maxRadius > minRadius)
+		m_levelCount = std::min(MAX_LEVELS, 1 + static_cast<uint32_t>(std::ceil(std::log2(maxRadius / minRadius))));
+
+	for (uint32_t level = 0; level < m_levelCount; level++) {
+		const double bound = (level + 1 == m_levelCount) ? maxRadius : std::ldexp(minRadius, static_cast<int>(level));
+		m_inverseCellSizes[level] = 1.0 / (threshold + 2.0 * bound);
+		m_levelBounds[level] = bound;
+	}
+
+	m_levels.resize(m_objectCount);
+	for (size_t i = 0; i < m_objectCount; i++) {
+		if (!valid[i])
+			continue;
+
+		uint32_t level = 0;
+		while (m_motionRadii[i] > m_levelBounds[level])
+			level++;		// The last level's bound is the largest radius
+
+		m_levels[i] = static_cast<uint8_t>(level);
+	}
+
+	const size_t cellCount = buildSpatialHash(r0, valid);
+
+	size_t eventCount = 0;
+
+	auto testPair = [&](uint32_t i, uint32_t j) {
+		m_stats.candidatePairs++;
+
+		// Apogee/perigee filter
+		if (hasShells && std::max(m_shells[i].perigee, m_shells[j].perigee) - std::min(m_shells[i].apogee, m_shells[j].apogee) > threshold)
+			return;
+
+		// Motion bounds
+		const glm::dvec3 dr0 = r0[j] - r0[i];
+		const double reach = threshold + m_motionRadii[i] + m_motionRadii[j];
+		if (glm::dot(dr0, dr0) > reach * reach)
+			return;
+
+		m_stats.proximatePairs++;
+
+		// The closest approach is within the interval if the pair approaches at its start and recedes at its end
+		const HermiteMotion motion{
+			.r0 = dr0,
+			.r1 = r1[j] - r1[i],
+			.w0 = (v0[j] - v0[i]) * h,
+			.w1 = (v1[j] - v1[i]) * h
+		};
+
+		const double fa = glm::dot(motion.r0, motion.w0);
+		const double fb = glm::dot(motion.r1, motion.w1);
+		if (!(fa < 0.0 && fb >= 0.0))
+			return;
+
+		m_stats.refinedPairs++;
+
+
+		// TCA: root of the range rate
+		const double s = RootFinding::FindRoot([&motion](double s) { return motion.rangeRate(s); }, 0.0, 1.0, fa, fb, TCA_TOLERANCE / h, MAX_TCA_ITERATIONS);
+
+		double tca = t0 + s * h;
+		glm::dvec3 relativePosition = motion.position(s);
+		glm::dvec3 relativeVelocity = motion.derivative(s) / h;
+
+
+		// Refinement with the actual states (Newton's method on the range rate, whose derivative is about |v|^2 near the closest approach)
+		if (m_objectStateProvider && glm::length(relativePosition) <= REFINEMENT_RANGE * threshold) {
+			glm::dvec3 ri, vi, rj, vj;
+			double evaluatedTCA = tca;		// Epoch of the relative state
+
+			for (int iteration = 0; iteration < MAX_REFINEMENT_ITERATIONS; iteration++) {
+				if (!m_objectStateProvider(i, tca, ri, vi) || !m_objectStateProvider(j, tca, rj, vj)) {
+					tca = evaluatedTCA;
+					break;
+				}
+
+				relativePosition = rj - ri;
+				relativeVelocity = vj - vi;
+				evaluatedTCA = tca;
+
+				const double correction = -glm::dot(relativePosition, relativeVelocity) / glm::dot(relativeVelocity, relativeVelocity);
+				const double refined = std::clamp(tca + correction, t0 - h, t1 + h);		// The actual closest approach may lie slightly outside of the interval
+				if (std::fabs(refined - tca) < TCA_TOLERANCE)
+					break;
+
+				tca = refined;
+			}
+		}
+
+		const double missDistance = glm::length(relativePosition);
+		if (missDistance > threshold)
+			return;
+
+		const bool isOrdered = (i < j);
+		events.push_back(Event{
+			.objectA = isOrdered ? i : j,
+			.objectB = isOrdered ? j : i,
+			.tca = tca,
+			.missDistance = missDistance,
+			.relativeSpeed = glm::length(relativeVelocity),
+			.relativePosition = isOrdered ? relativePosition : -relativePosition
+		});
+
+		eventCount++;
+	};
+
+
+	// Pairs within a level
+	for (uint32_t cell = 0; cell < cellCount; cell++) {
+		const uint32_t begin = m_cellStarts[cell];
+		const uint32_t end = m_cellStarts[cell + 1];
+
+		// Pairs within the cell
+		for (uint32_t a = begin; a < end; a++)
+			for (uint32_t b = a + 1; b < end; b++)
+				testPair(m_cellEntries[a].object, m_cellEntries[b].object);
+
+		// Pairs with forward neighbors
+		const uint64_t key = m_cellEntries[begin].key;
+		const uint32_t level = static_cast<uint32_t>(key >> CELL_LEVEL_SHIFT);
+		const int64_t x = static_cast<int64_t>((key >> (2 * CELL_COORDINATE_BITS)) & CELL_COORDINATE_MAX);
+		const int64_t y = static_cast<int64_t>((key >> CELL_COORDINATE_BITS) & CELL_COORDINATE_MAX);
+		const int64_t z = static_cast<int64_t>(key & CELL_COORDINATE_MAX);
+
+		for (const auto &offset : FORWARD_NEIGHBORS) {
+			const int64_t nx = x + offset[0], ny = y + offset[1], nz = z + offset[2];
+			if (nx < 0 || ny < 0 || nz < 0 || nx > CELL_COORDINATE_MAX || ny > CELL_COORDINATE_MAX || nz > CELL_COORDINATE_MAX)
+				continue;
+
+			const uint32_t neighbor = findCell(PackCell(level, nx, ny, nz));
+			if (neighbor == UINT32_MAX)
+				continue;
+
+			for (uint32_t a = begin; a < end; a++)
+				for (uint32_t b = m_cellStarts[neighbor]; b < m_cellStarts[neighbor + 1]; b++)
+					testPair(m_cellEntries[a].object, m_cellEntries[b].object);
+		}
+	}
+
+
+	// Pairs across levels: each object visits its own and the neighboring cells in the grids of the higher levels
+	for (uint32_t i = 0; i < m_objectCount && m_levelCount > 1; i++) {
+		if (!valid[i])
+			continue;
+
+		const glm::dvec3 &r = r0[i];
+
+		for (uint32_t level = m_levels[i] + 1u; level < m_levelCount; level++) {
+			const double inverseCellSize = m_inverseCellSizes[level];
+			const int64_t x = GetCellCoordinate(r.x, inverseCellSize);
+			const int64_t y = GetCellCoordinate(r.y, inverseCellSize);
+			const int64_t z = GetCellCoordinate(r.z, inverseCellSize);
+
+			for (int64_t nx = std::max<int64_t>(x - 1, 0); nx <= std::min(x + 1, CELL_COORDINATE_MAX); nx++)
+				for (int64_t ny = std::max<int64_t>(y - 1, 0); ny <= std::min(y + 1, CELL_COORDINATE_MAX); ny++)
+					for (int64_t nz = std::max<int64_t>(z - 1, 0); nz <= std::min(z + 1, CELL_COORDINATE_MAX); nz++) {
+						const uint32_t cell = findCell(PackCell(level, nx, ny, nz));
+						if (cell == UINT32_MAX)
+							continue;
+
+						for (uint32_t b = m_cellStarts[cell]; b < m_cellStarts[cell + 1]; b++)
+							testPair(i, m_cellEntries[b].object);
+					}
+		}
+	}
+
+	m_stats.events += eventCount;
+	return eventCount;
+}
+
+
+size_t ConjunctionScreener::buildSpatialHash(const glm::dvec3 *positions, const uint8_t *valid) {
+	// Sort objects by cell (in the grid of their level)
+	m_cellEntries.clear();
+	for (uint32_t i = 0; i < m_objectCount; i++) {
+		if (!valid[i])
+			continue;
+
+		const glm::dvec3 &r = positions[i];
+		const double inverseCellSize = m_inverseCellSizes[m_levels[i]];
+		m_cellEntries.push_back({
+			PackCell(m_levels[i], GetCellCoordinate(r.x, inverseCellSize), GetCellCoordinate(r.y, inverseCellSize), GetCellCoordinate(r.z, inverseCellSize)),
+			i
+		});
+	}
+
+	std::sort(m_cellEntries.begin(), m_cellEntries.end(), [](const _CellEntry &a, const _CellEntry &b) {
+		return (a.key != b.key) ? a.key < b.key : a.object < b.object;
+	});
+
+	m_cellStarts.clear();
+	for (uint32_t k = 0; k < m_cellEntries.size(); k++)
+		if (k == 0 || m_cellEntries[k].key != m_cellEntries[k - 1].key)
+			m_cellStarts.push_back(k);
+
+	const size_t cellCount = m_cellStarts.size();
+	m_cellStarts.push_back(static_cast<uint32_t>(m_cellEntries.size()));
+
+
+	// Open-addressing table (at most half full)
+	uint32_t capacityBits = 4;
+	while ((size_t(1) << capacityBits) < 2 * cellCount)
+		capacityBits++;
+
+	m_tableShift = 64 - capacityBits;
+	m_tableKeys.assign(size_t(1) << capacityBits, EMPTY_KEY);
+	m_tableCells.resize(size_t(1) << capacityBits);
+
+	const size_t mask = (size_t(1) << capacityBits) - 1;
+	for (uint32_t cell = 0; cell < cellCount; cell++) {
+		const uint64_t key = m_cellEntries[m_cellStarts[cell]].key;
+
+		size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_tableShift);
+		while (m_tableKeys[slot] != EMPTY_KEY)
+			slot = (slot + 1) & mask;
+
+		m_tableKeys[slot] = key;
+		m_tableCells[slot] = cell;
+	}
+
+	return cellCount;
+}
+
+
+uint32_t ConjunctionScreener::findCell(uint64_t key) const {
+	const size_t mask = m_tableKeys.size() - 1;
+
+	size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_tableShift);
+	while (m_tableKeys[slot] != EMPTY_KEY) {
+		if (m_tableKeys[slot] == key)
+			return m_tableCells[slot];
+		slot = (slot + 1) & mask;
+	}
+
+	return UINT32_MAX;
+}
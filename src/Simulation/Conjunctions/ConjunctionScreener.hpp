@@ -0,0 +1,214 @@
+/* ConjunctionScreener.hpp - Screening of close approaches between the objects of large catalogs.
+	Sources:
+		- F. R. Hoots, L. L. Crawford, R. L. Roehrich, "An Analytic Method to Determine Future Close Approaches Between Satellites", Celestial Mechanics 33, 1984 (apogee/perigee filter).
+		- S. Alarcón-Rodríguez, F. Martínez-Fadrique, H. Klinkrad, "Development of a Collision Risk Assessment Tool", Advances in Space Research 34, 2004 (time filters and TCA search).
+		- M. Teschner et al., "Optimized Spatial Hashing for Collision Detection of Deformable Objects", VMV 2003.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+
+
+/* Finds the close approaches (conjunctions) between the objects of a catalog: their times of closest approach (TCA) and miss distances below a threshold.
+	States are sampled at coarse steps (e.g., as they are propagated), and each interval between consecutive samples is screened with three filters of increasing cost, so that only a tiny fraction of the N(N-1)/2 pairs is examined:
+		1. Apogee/perigee filter: pairs whose radial shells (perigee to apogee, with a margin) are further apart than the threshold can never meet.
+		2. Spatial hash: over an interval, every object stays within a sphere around its position at the start of the interval, whose radius is bounded by its speed and the largest gravitational acceleration. Objects are binned into levels by radius (with bounds doubling from the smallest radius), and each level is hashed into a uniform grid whose cells are wider than the threshold plus twice the level's bound, so that only pairs in neighboring cells of the grid of the higher of their levels can come closer than the threshold; these are kept if their spheres come closer than the threshold.
+		   Fast or eccentric objects thus only coarsen the grid of their own level, rather than the grid of the whole catalog.
+		3. TCA search: the relative motion of each remaining pair is interpolated over the interval (cubic Hermite interpolation of the sampled positions and velocities), and the time of closest approach is the root of the range rate (r . v = 0) within the interval, found by safeguarded regula falsi.
+		   Interpolation is accurate to centimeters for coarse steps of tens of seconds, except near the perigees of highly eccentric orbits. If an object state provider is set, close approaches are then refined with Newton iterations on the range rate of the objects' actual states.
+	A closest approach is attributed to the interval in which the range rate changes sign from negative to positive, so that it is reported once even though it may be seen by both intervals around it.
+	Positions and velocities are in any inertial frame (e.g., TEME), in km and km/s.
+*/
+class ConjunctionScreener {
+public:
+	/* Screening parameters. */
+	struct Config {
+		double threshold = 5.0;			// Miss distance below which a close approach is reported (km)
+		double step = 20.0;				// Coarse step of ConjunctionScreener::screen (s)
+		double maxStep = 120.0;			// Longest interval screened by ConjunctionScreener::advance in one piece (s); longer intervals are subdivided at Config::step if a state provider is set, and skipped otherwise
+		double shellMargin = 25.0;		// Margin added to the radial shells of element sets, covering the difference between their mean and osculating elements (km)
+	};
+
+
+	/* The radial shell of an object's orbit. */
+	struct Shell {
+		double perigee;		// Perigee radius (km)
+		double apogee;		// Apogee radius (km)
+	};
+
+
+	/* A close approach. */
+	struct Event {
+		uint32_t objectA;					// Index of the first object (objectA < objectB)
+		uint32_t objectB;					// Index of the second object
+		double tca;							// Time of closest approach, in Ephemeris Time
+		double missDistance;				// Miss distance (km)
+		double relativeSpeed;				// Relative speed at the time of closest approach (km/s)
+		glm::dvec3 relativePosition;		// Position of the second object relative to the first at the time of closest approach (km)
+	};
+
+
+	/* Screening statistics. */
+	struct Statistics {
+		uint64_t intervals = 0;				// Intervals screened
+		uint64_t subdividedIntervals = 0;	// Intervals longer than Config::maxStep, subdivided at Config::step
+		uint64_t skippedIntervals = 0;		// Intervals longer than Config::maxStep, skipped (without a state provider)
+		uint64_t pairs = 0;					// Object pairs screened, i.e., N(N-1)/2 per interval
+		uint64_t shellPairs = 0;			// Pairs passing the apogee/perigee filter (per interval)
+		uint64_t candidatePairs = 0;		// Pairs in neighboring cells of the spatial hash
+		uint64_t proximatePairs = 0;		// Candidate pairs passing the apogee/perigee filter whose motion bounds come closer than the threshold
+		uint64_t refinedPairs = 0;			// Proximate pairs whose closest approach falls within the interval (and was searched for)
+		uint64_t events = 0;				// Close approaches found
+		double screeningTime = 0.0;			// Time spent screening (s)
+		double propagationTime = 0.0;		// Time spent sampling states in ConjunctionScreener::screen (s)
+
+		/* Gets the screening throughput (object pairs screened per second, excluding propagation). */
+		inline double getThroughput() const { return (screeningTime > 0.0) ? pairs / screeningTime : 0.0; }
+	};
+
+
+	/* Samples the states (km, km/s) and error codes (0 if valid) of every object at an epoch (in Ephemeris Time). */
+	using StateProvider = std::function<void(double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities, std::vector<int> &errors)>;
+
+	/* Computes the state (km, km/s) of a single object at an epoch (in Ephemeris Time), for the refinement of close approaches. Returns false if the state is invalid (e.g., the propagation failed), in which case the refinement stops at the last valid states. */
+	using ObjectStateProvider = std::function<bool(uint32_t object, double et, glm::dvec3 &position, glm::dvec3 &velocity)>;
+
+
+	ConjunctionScreener() = default;
+	~ConjunctionScreener() = default;
+
+
+	/* Gets the radial shell of an element set's orbit (from its mean elements, widened by a margin).
+		@param rec: The element set, initialized by sgp4init.
+		@param margin: The margin (km).
+
+		@return The shell.
+	*/
+	static Shell GetShell(const ElsetRec &rec, double margin);
+
+
+	inline void setConfig(const Config &config) { m_config = config; }
+	inline const Config &getConfig() const { return m_config; }
+
+
+	/* Sets (or, if empty, removes) the provider of single objects' states, with which close approaches are refined. It is called from the screening thread. */
+	inline void setObjectStateProvider(const ObjectStateProvider &objectStateProvider) { m_objectStateProvider = objectStateProvider; }
+
+
+	/* Sets (or, if empty, removes) the provider of every object's states, with which ConjunctionScreener::advance samples intervals longer than Config::maxStep at Config::step. It is called from the screening thread, and may overwrite the storage of the sample being screened. */
+	inline void setStateProvider(const StateProvider &stateProvider) { m_stateProvider = stateProvider; }
+
+
+	/* Sets the objects to screen, and discards the previous sample.
+		@param objectCount: The number of objects.
+		@param shells (optional): The radial shells of the objects, for the apogee/perigee filter (which uses the threshold of the current configuration). If empty, the filter is disabled.
+	*/
+	void reset(size_t objectCount, const std::vector<Shell> &shells = {});
+
+
+	/* Screens the interval between the previous sample and a new one, and keeps the new sample for the next interval.
+		Intervals longer than Config::maxStep are subdivided at Config::step with the state provider (see setStateProvider); without one, they are skipped with a warning.
+
+		@param et: The epoch of the sample, in Ephemeris Time.
+		@param positions: The positions of every object (km).
+		@param velocities: The velocities of every object (km/s).
+		@param errors: The error codes of every object (objects with non-zero codes are not screened). If empty, every object is valid.
+		@param events [out]: The vector to which the close approaches found in the interval are appended.
+
+		@return The number of close approaches found.
+	*/
+	size_t advance(double et, const std::vector<glm::dvec3> &positions, const std::vector<glm::dvec3> &velocities, const std::vector<int> &errors, std::vector<Event> &events);
+
+
+	/* Screens a time window, sampling states every Config::step.
+		@param startET: The start of the window, in Ephemeris Time.
+		@param endET: The end of the window, in Ephemeris Time.
+		@param stateProvider: The provider of the objects' states.
+
+		@return The close approaches, ordered by time of closest approach.
+	*/
+	std::vector<Event> screen(double startET, double endET, const StateProvider &stateProvider);
+
+
+	inline const Statistics &getStatistics() const { return m_stats; }
+	inline void resetStatistics() { m_stats = Statistics(); }
+
+private:
+	Config m_config;
+	Statistics m_stats;
+	ObjectStateProvider m_objectStateProvider;
+	StateProvider m_stateProvider;
+	bool m_skipReported = false;					// Whether skipped intervals have been reported since the last reset
+
+	size_t m_objectCount = 0;
+	std::vector<Shell> m_shells;					// Empty if the apogee/perigee filter is disabled
+	uint64_t m_shellPairCount = 0;					// Pairs passing the apogee/perigee filter
+
+	// Previous sample
+	bool m_hasPrevious = false;
+	double m_previousET = 0.0;
+	std::vector<glm::dvec3> m_previousPositions;
+	std::vector<glm::dvec3> m_previousVelocities;
+	std::vector<uint8_t> m_previousValid;
+	std::vector<uint8_t> m_intervalValid;			// Whether each object is valid at both ends of the current interval
+
+	// Samples within a subdivided interval
+	std::vector<glm::dvec3> m_subPositions, m_subVelocities;
+	std::vector<int> m_subErrors;
+	std::vector<glm::dvec3> m_endPositions, m_endVelocities;
+	std::vector<int> m_endErrors;
+
+	// Multi-level spatial hash (rebuilt every interval)
+	static constexpr uint32_t MAX_LEVELS = 32;
+	uint32_t m_levelCount = 1;
+	double m_levelBounds[MAX_LEVELS] = {};			// Largest motion radius of each level (km)
+	double m_inverseCellSizes[MAX_LEVELS] = {};		// Inverse cell size of each level's grid (1/km)
+	std::vector<uint8_t> m_levels;					// Level of each object
+
+	struct _CellEntry {
+		uint64_t key;		// Packed level and cell coordinates
+		uint32_t object;
+	};
+	std::vector<_CellEntry> m_cellEntries;			// Objects, sorted by cell
+	std::vector<uint32_t> m_cellStarts;				// Start of each occupied cell in m_cellEntries (plus the end of the last one)
+	std::vector<uint64_t> m_tableKeys;				// Open-addressing table from cell keys...
+	std::vector<uint32_t> m_tableCells;				// ... to occupied cells
+	uint32_t m_tableShift = 0;						// 64 - log2(table capacity)
+	std::vector<double> m_motionRadii;				// Radius of each object's motion bound over the interval (km)
+
+
+	/* Screens the interval between the previous sample and a new one (see ConjunctionScreener::advance), unless it is longer than a given duration. */
+	size_t advanceSample(double et, const std::vector<glm::dvec3> &positions, const std::vector<glm::dvec3> &velocities, const std::vector<int> &errors, double maxStep, std::vector<Event> &events);
+
+
+	/* Screens an interval.
+		@param t0, t1: The start and end of the interval, in Ephemeris Time (t0 < t1).
+		@param r0, v0: The states at the start of the interval.
+		@param r1, v1: The states at the end of the interval.
+		@param valid: Whether each object is valid at both ends of the interval.
+		@param events [out]: The vector to which close approaches are appended.
+
+		@return The number of close approaches found.
+	*/
+	size_t screenInterval(double t0, double t1, const glm::dvec3 *r0, const glm::dvec3 *v0, const glm::dvec3 *r1, const glm::dvec3 *v1, const uint8_t *valid, std::vector<Event> &events);
+
+
+	/* Builds the spatial hash of the valid objects' positions, each in the grid of its level.
+		@return The number of occupied cells.
+	*/
+	size_t buildSpatialHash(const glm::dvec3 *positions, const uint8_t *valid);
+
+
+	/* Finds an occupied cell by key.
+		@return The index of the cell, or UINT32_MAX if it is not occupied.
+	*/
+	uint32_t findCell(uint64_t key) const;
+};
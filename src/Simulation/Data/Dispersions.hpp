@@ -0,0 +1,44 @@
+/* Dispersions - Common data pertaining to Monte Carlo dispersion analyses of a scene.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+#include <Platform/External/GLM.hpp>
+
+
+namespace Dispersions {
+	constexpr uint64_t DEFAULT_SEED = 1;
+	constexpr double DEFAULT_SAMPLE_INTERVAL = 600.0;		// Interval between the ephemeris samples of fixed bodies (s)
+
+
+	/* The dispersions of a spacecraft. Every value is the standard deviation (1-sigma) of a zero-mean Gaussian error added to the nominal value; 0 leaves the value undispersed. */
+	struct Spec {
+		std::string entity;							// Name of the dispersed spacecraft
+
+		glm::dvec3 positionSigma{ 0.0 };			// Initial position, along the radial, in-track and cross-track axes relative to the dominant body (m)
+		glm::dvec3 velocitySigma{ 0.0 };			// Initial velocity, along the radial, in-track and cross-track axes relative to the dominant body (m/s)
+		double massSigma = 0.0;						// Initial mass (kg)
+		double dragCoefficientSigma = 0.0;			// Drag coefficient
+
+		double burnStartSigma = 0.0;				// Start time of every burn (s)
+		double burnDurationSigma = 0.0;				// Duration of every burn (s)
+		double burnThrottleSigma = 0.0;				// Throttle of every burn (fraction of the max thrust)
+		double burnPointingSigma = 0.0;				// Pointing error of every inertially pointed burn (deg)
+	};
+
+
+	/* A Monte Carlo dispersion analysis. */
+	struct Config {
+		uint32_t runs = 0;							// Number of dispersed runs (0 = no analysis)
+		double duration = 0.0;						// Simulation time covered by every run (s)
+		uint64_t seed = DEFAULT_SEED;				// Seed of the random dispersions (runs are reproducible for a given seed, whatever the number of threads)
+		std::string measuredEntity;					// Name of the spacecraft whose final state is measured (empty = the first dispersed spacecraft)
+
+		std::vector<Spec> specs;
+	};
+}
@@ -0,0 +1,102 @@
+/* Solvers - Common data pertaining to the physics solvers used by the simulation.
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+
+namespace Solvers {
+	// ----- GRAVITY -----
+	enum class Gravity {
+		DIRECT,			// Direct pairwise summation (O(N^2))
+		BARNES_HUT		// Barnes-Hut octree approximation (O(N log N))
+	};
+
+		// Mappings between gravity solver YAML values and their enums
+	const std::unordered_map<std::string, Gravity> GravityStrToEnumMap = {
+		{ "Direct",		Gravity::DIRECT },
+		{ "BarnesHut",	Gravity::BARNES_HUT }
+	};
+
+	constexpr double DEFAULT_OPENING_ANGLE = 0.5;		// Default Barnes-Hut opening angle (theta)
+
+
+
+	// ----- INTEGRATION -----
+	enum class IntegrationMode {
+		PER_BODY,		// Bodies are integrated one at a time, each seeing the already-updated states of the bodies before it
+		SYSTEM			// The states of all bodies are integrated together as one ODE
+	};
+
+		// Mappings between integration mode YAML values and their enums
+	const std::unordered_map<std::string, IntegrationMode> IntegrationModeStrToEnumMap = {
+		{ "PerBody",	IntegrationMode::PER_BODY },
+		{ "System",		IntegrationMode::SYSTEM }
+	};
+
+
+
+	// ----- INTEGRATORS -----
+	enum class Integrator {
+		RK4,			// Fixed-step fourth-order Runge-Kutta
+		RKF45,			// Adaptive Runge-Kutta-Fehlberg 4(5)
+		DOPRI54,		// Adaptive Dormand-Prince 5(4)
+		DOP853,			// Adaptive Dormand-Prince 8(5,3)
+		VELOCITY_VERLET,	// Symplectic second-order velocity Verlet
+		YOSHIDA4,		// Symplectic fourth-order Yoshida composition
+		YOSHIDA6,		// Symplectic sixth-order Yoshida composition
+		YOSHIDA8,		// Symplectic eighth-order Yoshida composition
+		WISDOM_HOLMAN	// Symplectic Wisdom-Holman mapping (Kepler drifts about each body's primary + interaction kicks)
+	};
+
+		// Mappings between integrator YAML values and their enums
+	const std::unordered_map<std::string, Integrator> IntegratorStrToEnumMap = {
+		{ "RK4",		Integrator::RK4 },
+		{ "RKF45",		Integrator::RKF45 },
+		{ "DOPRI5",		Integrator::DOPRI54 },
+		{ "DOP853",		Integrator::DOP853 },
+		{ "VelocityVerlet",	Integrator::VELOCITY_VERLET },
+		{ "Yoshida4",	Integrator::YOSHIDA4 },
+		{ "Yoshida6",	Integrator::YOSHIDA6 },
+		{ "Yoshida8",	Integrator::YOSHIDA8 },
+		{ "WisdomHolman",	Integrator::WISDOM_HOLMAN }
+	};
+
+		// Whether an integrator chooses its own step sizes
+	inline bool IsAdaptive(Integrator integrator) {
+		return integrator == Integrator::RKF45 || integrator == Integrator::DOPRI54 || integrator == Integrator::DOP853;
+	}
+
+		// Whether an integrator is a (fixed-step) symplectic composition method
+	inline bool IsSymplectic(Integrator integrator) {
+		return integrator == Integrator::VELOCITY_VERLET || integrator == Integrator::YOSHIDA4 || integrator == Integrator::YOSHIDA6 || integrator == Integrator::YOSHIDA8 || integrator == Integrator::WISDOM_HOLMAN;
+	}
+
+	constexpr double DEFAULT_ABSOLUTE_TOLERANCE = 1e-6;		// Default absolute error tolerance of adaptive integrators (m, m/s)
+	constexpr double DEFAULT_RELATIVE_TOLERANCE = 1e-10;	// Default relative error tolerance of adaptive integrators
+	constexpr double DEFAULT_TIME_STEP = 1.0 / 60.0;		// Default step size of fixed-step integrators (s). Matches SimulationConst::TIME_STEP.
+
+
+
+	// ----- FORCE MODELS -----
+	enum class ShadowModel {
+		CYLINDRICAL,	// Cylindrical shadow behind the occulting body (umbra only)
+		CONICAL			// Conical umbra and penumbra from the apparent sizes of the Sun and the occulting body
+	};
+
+		// Mappings between shadow model YAML values and their enums
+	const std::unordered_map<std::string, ShadowModel> ShadowModelStrToEnumMap = {
+		{ "Cylindrical",	ShadowModel::CYLINDRICAL },
+		{ "Conical",		ShadowModel::CONICAL }
+	};
+
+	constexpr int MAX_ZONAL_DEGREE = 6;		// Highest supported zonal harmonic degree (J6)
+
+
+
+	// ----- EPHEMERIDES -----
+	constexpr double DEFAULT_EPHEMERIS_POSITION_TOLERANCE = 1.0;	// Default fit tolerance of cached ephemeris positions (m)
+	constexpr double DEFAULT_EPHEMERIS_ROTATION_TOLERANCE = 1e-9;	// Default fit tolerance of cached frame orientations (rad)
+}
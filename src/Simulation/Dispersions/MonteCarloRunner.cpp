@@ -0,0 +1,578 @@
+/* MonteCarloRunner.cpp - Monte Carlo dispersion runner implementation.
+*/
+
+#include "MonteCarloRunner.hpp"
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+
+#include <Core/Data/Math.hpp>
+#include <Core/Data/Constants.h>
+#include <Core/Utils/StringUtils.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+
+#include <Simulation/Gravity/GravityKernels.hpp>
+
+
+namespace {
+	constexpr double MIN_DRY_MASS = 1e-3;		// Smallest mass of a dispersed spacecraft beyond its fuel (kg)
+
+
+	/* Thrown by the equations of motion of a run that cannot complete (its state diverged, or a body hit a central body). */
+	struct RunAborted {};
+}
+
+
+void MonteCarloRunner::setup(const Dispersions::Config &config, Scenario scenario) {
+	LOG_ASSERT(config.duration > 0.0, "Cannot set up Monte Carlo analysis: The duration of the runs must be positive!");
+	LOG_ASSERT(scenario.sampleInterval > 0.0 && scenario.samples.size() >= 2 && (scenario.samples.size() - 1) * scenario.sampleInterval >= config.duration,
+		"Cannot set up Monte Carlo analysis: The ephemerides of the scenario do not cover the duration of the runs!");
+
+	m_config = config;
+	m_scenario = std::move(scenario);
+
+
+	// Bodies
+	auto findBody = [this](const std::string &name) -> uint32_t {
+		for (size_t i = 0; i < m_scenario.bodies.size(); i++) {
+			if (m_scenario.bodies[i].name == name) {
+				if (m_scenario.bodies[i].isFixed)
+					throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot set up Monte Carlo analysis: " + enquote(name) + " is driven by ephemerides or a propagator, and cannot be dispersed!");
+
+				return static_cast<uint32_t>(i);
+			}
+		}
+
+		throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot set up Monte Carlo analysis: There is no integrated body named " + enquote(name) + "!");
+	};
+
+	m_specBodies.clear();
+	for (const Dispersions::Spec &spec : m_config.specs)
+		m_specBodies.push_back(findBody(spec.entity));
+
+	if (!m_config.measuredEntity.empty())
+		m_measuredBody = findBody(m_config.measuredEntity);
+	else if (!m_specBodies.empty())
+		m_measuredBody = m_specBodies.front();
+	else
+		throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot set up Monte Carlo analysis: No spacecraft is dispersed or measured!");
+
+	m_referenceBody = GetDominantBody(m_scenario.bodies, m_measuredBody);
+
+	m_integratedBodies.clear();
+	for (size_t i = 0; i < m_scenario.bodies.size(); i++) {
+		if (!m_scenario.bodies[i].isFixed)
+			m_integratedBodies.push_back(static_cast<uint32_t>(i));
+	}
+
+
+	// The gravity field is owned by the scenario
+	for (size_t k = 0; k < m_scenario.environment.centralBodies.size(); k++)
+		m_scenario.environment.centralBodies[k].gravityField = (k == m_scenario.gravityFieldBody) ? m_scenario.gravityField.get() : nullptr;
+
+	m_scenario.environment.thirdBodies = m_scenario.samples.front().thirdBodies;
+}
+
+
+void MonteCarloRunner::run(ThreadPool &pool, uint32_t maxThreads, std::stop_token stopToken) {
+	LOG_ASSERT(!m_scenario.bodies.empty(), "Cannot run Monte Carlo analysis: The analysis has not been set up!");
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_status = Status::RUNNING;
+		m_error.clear();
+		m_stats = Statistics();
+		m_deviationM2 = glm::dmat3(0.0);
+		m_missDistances.clear();
+		m_missDistances.reserve(m_config.runs);
+	}
+	m_completedRuns.store(0);
+	m_startTime = std::chrono::steady_clock::now();
+
+
+	// The dispersed runs are measured against the nominal run
+	const Outcome nominal = simulate(0);
+	if (!nominal.isValid)
+		throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot run Monte Carlo analysis: The nominal run did not complete!");
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_nominal = nominal;
+		m_nominalBasis = GetRTNBasis(nominal.position, nominal.velocity);
+	}
+	m_completedRuns.fetch_add(1);
+
+
+	// Runs are tasks: each is simulated in its own context, and merged into the statistics as soon as it completes
+	std::atomic<uint32_t> completedRuns{ 0 };
+
+	pool.parallelFor(m_config.runs,
+		[&](size_t task) {
+			if (stopToken.stop_requested())
+				return;
+
+			record(simulate(static_cast<uint32_t>(task + 1)));
+
+			m_completedRuns.fetch_add(1);
+			completedRuns.fetch_add(1);
+		},
+		maxThreads
+	);
+
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+	m_status = (completedRuns.load() == m_config.runs) ? Status::COMPLETE : Status::CANCELLED;
+}
+
+
+MonteCarloRunner::Outcome MonteCarloRunner::simulate(uint32_t run) const {
+	const size_t bodyCount = m_scenario.bodies.size();
+	const double duration = m_config.duration;
+	const double interval = m_scenario.sampleInterval;
+
+	_Context context;
+	context.bodies = m_scenario.bodies;
+	context.engines = m_scenario.engines;
+	disperse(run, context);
+
+
+	// Initial state
+	context.stage.resize(bodyCount);
+	for (size_t i = 0; i < bodyCount; i++)
+		context.stage.mu[i] = PhysicsConst::G * context.bodies[i].mass;
+
+	context.state.resize(6 * m_integratedBodies.size());
+	for (size_t k = 0; k < m_integratedBodies.size(); k++) {
+		const Body &body = context.bodies[m_integratedBodies[k]];
+		double *state = &context.state[6 * k];
+
+		state[0] = body.position.x;
+		state[1] = body.position.y;
+		state[2] = body.position.z;
+		state[3] = body.velocity.x;
+		state[4] = body.velocity.y;
+		state[5] = body.velocity.z;
+	}
+
+	context.forceModels.configure(m_scenario.models, m_scenario.zonalDegree, m_scenario.shadowModel);
+	context.forceModels.getEnvironment() = m_scenario.environment;
+	setTargets(context);
+
+	context.burnScheduler.setEngines(context.engines, bodyCount);
+	context.integrator.configure(m_scenario.method, m_scenario.tolerance);
+
+
+	// Equations of motion: fixed bodies are interpolated from the samples at every evaluation, and integrated bodies are subject to the gravity of every body, the force models and thrust
+	const std::vector<ForceModel::CentralBody> &centralBodies = context.forceModels.getEnvironment().centralBodies;
+
+	auto computeDerivative = [&](double et, const double *state, double *derivative) {
+		NBodyStore &stage = context.stage;
+		loadStage(context, et - m_scenario.epochET, state);
+
+		for (const uint32_t i : m_integratedBodies) {
+			const glm::dvec3 position = stage.getPosition(i);
+
+			if (!std::isfinite(position.x) || !std::isfinite(position.y) || !std::isfinite(position.z))
+				throw RunAborted();
+
+			for (const ForceModel::CentralBody &centralBody : centralBodies) {
+				if (centralBody.bodyIndex != i && glm::length(position - stage.getPosition(centralBody.bodyIndex)) < centralBody.equatRadius * (1.0 - centralBody.flattening))
+					throw RunAborted();
+			}
+
+			stage.setAcceleration(i, GravityKernels::ComputeAccelerationAt(stage, position, i));
+		}
+
+		context.forceModels.apply(stage, et);
+		context.burnScheduler.apply(stage, et);
+
+		for (size_t k = 0; k < m_integratedBodies.size(); k++) {
+			const uint32_t i = m_integratedBodies[k];
+
+			derivative[6 * k + 0] = state[6 * k + 3];
+			derivative[6 * k + 1] = state[6 * k + 4];
+			derivative[6 * k + 2] = state[6 * k + 5];
+			derivative[6 * k + 3] = stage.ax[i];
+			derivative[6 * k + 4] = stage.ay[i];
+			derivative[6 * k + 5] = stage.az[i];
+		}
+	};
+
+
+	// Every sample interval is split into segments at burn starts, burn ends and fuel exhaustion (see FiniteBurnScheduler), as in PhysicsSystem::update
+	Outcome outcome{ .run = run, .isValid = true };
+
+	try {
+		double t = 0.0;
+
+		for (size_t k = 0; t < duration; k++) {
+			const double intervalEnd = std::min((k + 1) * interval, duration);
+
+			loadStage(context, t, context.state.data());
+			updateForceModels(context, k);
+
+			do {
+				const double segmentEnd = context.burnScheduler.getNextBoundary(t, intervalEnd);
+
+				loadStage(context, t, context.state.data());
+				context.burnScheduler.beginSegment(t, m_scenario.epochET + t, context.stage);
+				context.integrator.integrate(context.state, m_scenario.epochET + t, segmentEnd - t, computeDerivative);
+
+				t = segmentEnd;
+
+				// Fuel consumption changes the masses of thrusters, and therefore their ballistic and radiation factors
+				if (context.burnScheduler.endSegment(t)) {
+					for (const FiniteBurnScheduler::Engine &engine : context.burnScheduler.getEngines()) {
+						context.bodies[engine.bodyIndex].mass = engine.mass;
+						context.stage.mu[engine.bodyIndex] = PhysicsConst::G * engine.mass;
+					}
+
+					loadStage(context, t, context.state.data());
+					setTargets(context);
+					context.forceModels.assignCentralBodies(context.stage);
+				}
+
+			} while (t < intervalEnd);
+		}
+	}
+	catch (const RunAborted &) {
+		outcome.isValid = false;
+		return outcome;
+	}
+
+
+	// Final state of the measured spacecraft
+	loadStage(context, duration, context.state.data());
+
+	outcome.position = context.stage.getPosition(m_measuredBody) - context.stage.getPosition(m_referenceBody);
+	outcome.velocity = context.stage.getVelocity(m_measuredBody) - context.stage.getVelocity(m_referenceBody);
+	outcome.mass = context.bodies[m_measuredBody].mass;
+	outcome.isValid = std::isfinite(glm::length(outcome.position)) && std::isfinite(glm::length(outcome.velocity));
+
+	return outcome;
+}
+
+
+void MonteCarloRunner::disperse(uint32_t run, _Context &context) const {
+	if (run == 0)
+		return;
+
+	// Every run has its own stream, and draws every error (even undispersed ones), so that its errors only depend on the seed and its index
+	std::seed_seq seedSequence{ static_cast<uint32_t>(m_config.seed), static_cast<uint32_t>(m_config.seed >> 32), run };
+	std::mt19937_64 generator(seedSequence);
+	std::normal_distribution<double> gaussian(0.0, 1.0);
+	std::uniform_real_distribution<double> uniform(0.0, TWOPI);
+
+	for (size_t s = 0; s < m_config.specs.size(); s++) {
+		const Dispersions::Spec &spec = m_config.specs[s];
+		const uint32_t bodyIndex = m_specBodies[s];
+		Body &body = context.bodies[bodyIndex];
+
+
+		// Initial state, in the radial, in-track and cross-track axes relative to the dominant body
+		const Body &dominantBody = m_scenario.bodies[GetDominantBody(m_scenario.bodies, bodyIndex)];
+		const glm::dmat3 basis = GetRTNBasis(body.position - dominantBody.position, body.velocity - dominantBody.velocity);
+
+		const glm::dvec3 positionError(gaussian(generator), gaussian(generator), gaussian(generator));
+		const glm::dvec3 velocityError(gaussian(generator), gaussian(generator), gaussian(generator));
+
+		body.position += basis * (spec.positionSigma * positionError);
+		body.velocity += basis * (spec.velocitySigma * velocityError);
+
+
+		// Mass (never below the fuel, so that thrusters remain usable) and drag coefficient
+		double fuelMass = 0.0;
+		for (const FiniteBurnScheduler::Engine &engine : context.engines) {
+			if (engine.bodyIndex == bodyIndex)
+				fuelMass = std::max(fuelMass, engine.fuelMass);
+		}
+
+		body.mass = std::max(body.mass + spec.massSigma * gaussian(generator), fuelMass + MIN_DRY_MASS);
+		body.dragCoefficient = std::max(body.dragCoefficient + spec.dragCoefficientSigma * gaussian(generator), 0.0);
+
+
+		// Burns
+		for (FiniteBurnScheduler::Engine &engine : context.engines) {
+			if (engine.bodyIndex != bodyIndex)
+				continue;
+
+			engine.mass = body.mass;
+
+			for (SpacecraftComponent::FiniteBurn &burn : engine.burns) {
+				burn.startTime += spec.burnStartSigma * gaussian(generator);
+				burn.duration = std::max(burn.duration + spec.burnDurationSigma * gaussian(generator), 0.0);
+				burn.throttle = std::clamp(burn.throttle + spec.burnThrottleSigma * gaussian(generator), 0.0, 1.0);
+
+				// The pointing error tilts the thrust direction by a Gaussian angle, towards a uniformly distributed azimuth
+				const double tilt = glm::radians(spec.burnPointingSigma) * gaussian(generator);
+				const double azimuth = uniform(generator);
+
+				if (burn.attitude == SpacecraftComponent::FiniteBurn::Attitude::INERTIAL && tilt != 0.0) {
+					const glm::dvec3 direction = glm::normalize(burn.direction);
+					const glm::dvec3 helper = (std::abs(direction.x) < 0.9) ? glm::dvec3(1.0, 0.0, 0.0) : glm::dvec3(0.0, 1.0, 0.0);
+					const glm::dvec3 u = glm::normalize(glm::cross(direction, helper));
+					const glm::dvec3 v = glm::cross(direction, u);
+
+					burn.direction = std::cos(tilt) * direction + std::sin(tilt) * (std::cos(azimuth) * u + std::sin(azimuth) * v);
+				}
+			}
+		}
+	}
+}
+
+
+void MonteCarloRunner::loadStage(_Context &context, double t, const double *state) const {
+	for (size_t i = 0; i < context.bodies.size(); i++) {
+		if (!context.bodies[i].isFixed)
+			continue;
+
+		glm::dvec3 position, velocity;
+		interpolate(static_cast<uint32_t>(i), t, position, velocity);
+
+		context.stage.setPosition(i, position);
+		context.stage.setVelocity(i, velocity);
+	}
+
+	for (size_t k = 0; k < m_integratedBodies.size(); k++) {
+		const double *bodyState = &state[6 * k];
+
+		context.stage.setPosition(m_integratedBodies[k], glm::dvec3(bodyState[0], bodyState[1], bodyState[2]));
+		context.stage.setVelocity(m_integratedBodies[k], glm::dvec3(bodyState[3], bodyState[4], bodyState[5]));
+	}
+}
+
+
+void MonteCarloRunner::updateForceModels(_Context &context, size_t sampleIndex) const {
+	if (context.forceModels.getModels() == 0)
+		return;
+
+	ForceModelPipeline::Environment &env = context.forceModels.getEnvironment();
+	const Sample &sample = m_scenario.samples[sampleIndex];
+	const double et = m_scenario.epochET + sampleIndex * m_scenario.sampleInterval;
+
+	// Central body orientations
+	for (size_t k = 0; k < env.centralBodies.size(); k++) {
+		ForceModel::CentralBody &centralBody = env.centralBodies[k];
+		const glm::dmat3 &orientation = sample.orientations[k];
+
+		centralBody.pole = glm::normalize(orientation * glm::dvec3(0.0, 0.0, 1.0));
+		centralBody.angularVelocity = orientation * m_scenario.centralBodyRotVelocities[k];
+
+		if (centralBody.gravityField) {
+			centralBody.bodyFixedRotation = sample.gravityFieldRotation;
+			centralBody.rotationEpochET = et;
+		}
+	}
+
+	// Third-body ephemerides
+	env.thirdBodies = sample.thirdBodies;
+
+	context.forceModels.assignCentralBodies(context.stage);
+}
+
+
+void MonteCarloRunner::setTargets(_Context &context) const {
+	context.targets.clear();
+
+	for (const uint32_t i : m_integratedBodies) {
+		const Body &body = context.bodies[i];
+		ForceModel::Target target{ .bodyIndex = i };
+
+		if (body.isSpacecraft && body.mass > 0.0) {
+			target.ballisticFactor = body.dragCoefficient * body.referenceArea / body.mass;
+			target.radiationFactor = body.reflectivityCoefficient * body.referenceArea / body.mass;
+		}
+
+		context.targets.push_back(target);
+	}
+
+	context.forceModels.setTargets(context.targets, context.bodies.size());
+	context.forceModels.compile();
+}
+
+
+void MonteCarloRunner::interpolate(uint32_t bodyIndex, double t, glm::dvec3 &position, glm::dvec3 &velocity) const {
+	const std::vector<Sample> &samples = m_scenario.samples;
+	const double h = m_scenario.sampleInterval;
+
+	const size_t k = std::min(static_cast<size_t>(std::max(std::floor(t / h), 0.0)), samples.size() - 2);
+	const double s = (t - k * h) / h;
+
+	const glm::dvec3 &p0 = samples[k].positions[bodyIndex];
+	const glm::dvec3 &v0 = samples[k].velocities[bodyIndex];
+	const glm::dvec3 &p1 = samples[k + 1].positions[bodyIndex];
+	const glm::dvec3 &v1 = samples[k + 1].velocities[bodyIndex];
+
+	// Cubic Hermite basis functions, and their derivatives
+	const double s2 = s * s, s3 = s2 * s;
+	const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+	const double h10 = s3 - 2.0 * s2 + s;
+	const double h01 = -2.0 * s3 + 3.0 * s2;
+	const double h11 = s3 - s2;
+
+	const double dh00 = 6.0 * s2 - 6.0 * s;
+	const double dh10 = 3.0 * s2 - 4.0 * s + 1.0;
+	const double dh01 = -6.0 * s2 + 6.0 * s;
+	const double dh11 = 3.0 * s2 - 2.0 * s;
+
+	position = h00 * p0 + (h10 * h) * v0 + h01 * p1 + (h11 * h) * v1;
+	velocity = (dh00 / h) * p0 + dh10 * v0 + (dh01 / h) * p1 + dh11 * v1;
+}
+
+
+void MonteCarloRunner::record(const Outcome &outcome) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if (!outcome.isValid) {
+		m_stats.failedRuns++;
+		return;
+	}
+
+	const uint32_t n = ++m_stats.runs;
+
+	// Running mean and covariance of the deviation, in the axes of the nominal final state (Welford)
+	const glm::dvec3 deviation = glm::transpose(m_nominalBasis) * (outcome.position - m_nominal.position);
+	const glm::dvec3 delta = deviation - m_stats.meanDeviation;
+
+	m_stats.meanDeviation += delta / static_cast<double>(n);
+	m_deviationM2 += glm::outerProduct(delta, deviation - m_stats.meanDeviation);
+
+
+	const double missDistance = glm::length(outcome.position - m_nominal.position);
+	const double velocityError = glm::length(outcome.velocity - m_nominal.velocity);
+
+	m_missDistances.push_back(missDistance);
+	m_stats.meanMissDistance += (missDistance - m_stats.meanMissDistance) / n;
+	m_stats.maxMissDistance = std::max(m_stats.maxMissDistance, missDistance);
+	m_stats.meanVelocityError += (velocityError - m_stats.meanVelocityError) / n;
+	m_stats.maxVelocityError = std::max(m_stats.maxVelocityError, velocityError);
+	m_stats.meanMass += (outcome.mass - m_stats.meanMass) / n;
+}
+
+
+void MonteCarloRunner::start(const Dispersions::Config &config, Scenario scenario, uint32_t threadCount) {
+	cancel();
+
+	setup(config, std::move(scenario));
+	setStatus(Status::RUNNING);
+	m_completedRuns.store(0);
+
+	if (m_pool.getThreadCount() != threadCount || threadCount == 0)
+		m_pool.init("MONTE_CARLO_RUNS", threadCount);
+
+	if (!m_worker)
+		m_worker = ThreadManager::CreateThread("MONTE_CARLO");
+
+	m_worker->set([this](std::stop_token stopToken) {
+		try {
+			run(m_pool, 0, stopToken);
+
+			const Statistics stats = getStatistics();
+			const glm::dvec3 sigma(std::sqrt(stats.covariance[0][0]), std::sqrt(stats.covariance[1][1]), std::sqrt(stats.covariance[2][2]));
+
+			std::ostringstream message;
+			message << std::setprecision(4)
+				<< "Monte Carlo analysis: " << stats.runs << " dispersed runs (" << stats.failedRuns << " incomplete) in " << stats.time << " s (" << stats.getRunsPerSecond() << " runs/s). "
+				<< "Final state of " << enquote(m_scenario.bodies[m_measuredBody].name) << " relative to " << enquote(m_scenario.bodies[m_referenceBody].name) << ": "
+				<< "miss distance " << stats.meanMissDistance << " m (mean), " << stats.missDistance3Sigma << " m (3-sigma), " << stats.maxMissDistance << " m (max); "
+				<< "1-sigma deviation (radial, in-track, cross-track) (" << sigma.x << ", " << sigma.y << ", " << sigma.z << ") m; "
+				<< "velocity error " << stats.meanVelocityError << " m/s (mean), " << stats.maxVelocityError << " m/s (max); "
+				<< "mean final mass " << stats.meanMass << " kg.";
+
+			Log::Print(Log::T_INFO, __FUNCTION__, message.str());
+		}
+		catch (const std::exception &e) {
+			Log::Print(Log::T_ERROR, __FUNCTION__, "Monte Carlo analysis failed: " + std::string(e.what()));
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_status = Status::FAILED;
+			m_error = e.what();
+		}
+	});
+
+	m_worker->start();
+}
+
+
+void MonteCarloRunner::cancel() {
+	if (!m_worker)
+		return;
+
+	m_worker->requestStop();
+	m_worker->waitForStop();
+}
+
+
+MonteCarloRunner::Status MonteCarloRunner::getStatus() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_status;
+}
+
+
+std::string MonteCarloRunner::getError() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_error;
+}
+
+
+MonteCarloRunner::Statistics MonteCarloRunner::getStatistics() {
+	std::vector<double> missDistances;
+	Statistics stats;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		stats = m_stats;
+		missDistances = m_missDistances;
+
+		if (stats.runs > 1)
+			stats.covariance = m_deviationM2 / static_cast<double>(stats.runs - 1);
+
+		if (m_status == Status::RUNNING)
+			stats.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+	}
+
+	if (!missDistances.empty()) {
+		const size_t rank = std::min(static_cast<size_t>(std::ceil(THREE_SIGMA_PERCENTILE * missDistances.size())), missDistances.size()) - 1;
+		std::nth_element(missDistances.begin(), missDistances.begin() + rank, missDistances.end());
+
+		stats.missDistance3Sigma = missDistances[rank];
+	}
+
+	return stats;
+}
+
+
+uint32_t MonteCarloRunner::GetDominantBody(const std::vector<Body> &bodies, uint32_t bodyIndex) {
+	uint32_t dominantBody = bodyIndex;
+	double maxPull = 0.0;
+
+	for (size_t j = 0; j < bodies.size(); j++) {
+		if (j == bodyIndex)
+			continue;
+
+		const glm::dvec3 offset = bodies[bodyIndex].position - bodies[j].position;
+		const double pull = bodies[j].mass / glm::dot(offset, offset);
+
+		if (pull > maxPull) {
+			maxPull = pull;
+			dominantBody = static_cast<uint32_t>(j);
+		}
+	}
+
+	LOG_ASSERT(dominantBody != bodyIndex, "Cannot find the dominant body of " + enquote(bodies[bodyIndex].name) + ": No other body attracts it!");
+	return dominantBody;
+}
+
+
+glm::dmat3 MonteCarloRunner::GetRTNBasis(const glm::dvec3 &position, const glm::dvec3 &velocity) {
+	const glm::dvec3 radial = glm::normalize(position);
+	const glm::dvec3 crossTrack = glm::normalize(glm::cross(position, velocity));
+	const glm::dvec3 inTrack = glm::cross(crossTrack, radial);
+
+	return glm::dmat3(radial, inTrack, crossTrack);
+}
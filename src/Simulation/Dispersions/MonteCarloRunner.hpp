@@ -0,0 +1,286 @@
+/* MonteCarloRunner.hpp - Monte Carlo dispersion analyses of a scene, over many independent runs simulated concurrently.
+	Sources:
+		- B. P. Welford, "Note on a method for calculating corrected sums of squares and products", Technometrics 4(3) (1962).
+		- D. A. Vallado, "Fundamentals of Astrodynamics and Applications", 4th ed., 2013 (§3.3 RSW (radial, in-track, cross-track) frame).
+*/
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stop_token>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+#include <Core/Application/Threading/WorkerThread.hpp>
+#include <Core/Application/Threading/ThreadManager.hpp>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Data/Solvers.hpp>
+#include <Simulation/Data/Dispersions.hpp>
+#include <Simulation/Forces/ForceModels.hpp>
+#include <Simulation/Forces/GravityField.hpp>
+#include <Simulation/Forces/ForceModelPipeline.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Integrators/EmbeddedRK.hpp>
+#include <Simulation/Maneuvers/FiniteBurnScheduler.hpp>
+
+
+/* Simulates dispersed variants of a scene (errors on the initial states, masses, drag coefficients and burns of its spacecraft, see Dispersions::Spec), and aggregates the final states of a measured spacecraft into statistics as runs complete.
+	The scene is first frozen into a Scenario: plain data holding the initial states of the bodies, the force models and burns, and the ephemerides of the bodies driven by SPICE (sampled at regular intervals, and interpolated by cubic Hermite polynomials). Runs only read the scenario, and each one is simulated in its own context (body store, force model pipeline, burn scheduler and integrator), so that they share no state with the ECS registry, SPICE, or each other. Runs are therefore distributed across a thread pool with no synchronization other than the merging of their outcomes.
+	Run 0 is the nominal (undispersed) run, against which the final states of the dispersed runs are measured. Every run draws its errors from its own generator, seeded by Dispersions::Config::seed and the run's index, so that the outcome of a run does not depend on the number of threads (the statistics may differ by rounding, since outcomes are merged in the order in which runs complete).
+*/
+class MonteCarloRunner {
+public:
+	/* Analysis status. */
+	enum class Status : uint8_t {
+		IDLE,			// Nothing simulated yet
+		RUNNING,		// Simulating runs
+		COMPLETE,		// Every run is simulated
+		CANCELLED,		// Cancelled before completion (the statistics of the completed runs remain available)
+		FAILED			// Failed (see MonteCarloRunner::getError)
+	};
+
+
+	/* A body of a scenario. */
+	struct Body {
+		std::string name;
+		glm::dvec3 position;						// Initial position (m)
+		glm::dvec3 velocity;						// Initial velocity (m/s)
+		double mass;								// Initial mass (kg)
+		bool isFixed;								// Whether the body's state is driven by ephemerides (see Scenario::samples) rather than integrated
+
+		bool isSpacecraft = false;					// Whether the body has spacecraft properties
+		double dragCoefficient = 0.0;
+		double referenceArea = 0.0;					// (m^2)
+		double reflectivityCoefficient = 0.0;
+	};
+
+
+	/* The ephemerides of a scenario at a sample epoch. */
+	struct Sample {
+		std::vector<glm::dvec3> positions;					// Positions of the fixed bodies, parallel to Scenario::bodies (unused for integrated bodies) (m)
+		std::vector<glm::dvec3> velocities;					// (m/s)
+		std::vector<glm::dmat3> orientations;				// Rotations from the body-fixed frames of the central bodies of the force models to the simulation frame (parallel to their list)
+		glm::dmat3 gravityFieldRotation{ 1.0 };				// Rotation from the body-fixed frame of the gravity field (if any) to the simulation frame
+		std::vector<ForceModel::ThirdBody> thirdBodies;		// Third bodies of the force models
+	};
+
+
+	/* A scene, frozen into plain data from which every run starts. */
+	struct Scenario {
+		double epochET = 0.0;								// Start of the runs (from which the start times of burns count), in Ephemeris Time
+		std::vector<Body> bodies;
+
+		// Force models
+		uint32_t models = 0;								// Requested force models (a combination of ForceModel::Model flags)
+		int zonalDegree = 0;
+		Solvers::ShadowModel shadowModel = Solvers::ShadowModel::CONICAL;
+		ForceModelPipeline::Environment environment;		// Central bodies, the Sun and the origin. Orientations and third bodies are refreshed from the samples.
+		std::vector<glm::dvec3> centralBodyRotVelocities;	// Body-fixed angular velocities of the central bodies (parallel to their list)
+		std::shared_ptr<const GravityField> gravityField;	// Gravity field of a central body, or nullptr
+		uint32_t gravityFieldBody = ForceModel::NO_INDEX;	// Index of the gravity field's body in the central body list
+
+		// Finite burns (bodies are indices into Scenario::bodies)
+		std::vector<FiniteBurnScheduler::Engine> engines;
+
+		// Integration
+		EmbeddedRK::Method method = EmbeddedRK::Method::DOPRI54;
+		EmbeddedRK::Tolerance tolerance{ Solvers::DEFAULT_ABSOLUTE_TOLERANCE, Solvers::DEFAULT_RELATIVE_TOLERANCE };
+
+		// Ephemerides, at epochET + k * sampleInterval (covering the duration of the runs)
+		double sampleInterval = Dispersions::DEFAULT_SAMPLE_INTERVAL;
+		std::vector<Sample> samples;
+	};
+
+
+	/* The final state of the measured spacecraft in a run. */
+	struct Outcome {
+		uint32_t run;
+		bool isValid;					// Whether the run completed (i.e., it did not diverge, or hit a central body)
+		glm::dvec3 position;			// Position relative to the reference body (m)
+		glm::dvec3 velocity;			// Velocity relative to the reference body (m/s)
+		double mass;					// Mass (kg)
+	};
+
+
+	/* Statistics of the dispersed runs, against the nominal run. */
+	struct Statistics {
+		uint32_t runs = 0;						// Dispersed runs completed
+		uint32_t failedRuns = 0;				// Dispersed runs that did not complete (excluded from the statistics)
+
+		glm::dvec3 meanDeviation{ 0.0 };		// Mean final position deviation, along the radial, in-track and cross-track axes of the nominal final state (m)
+		glm::dmat3 covariance{ 0.0 };			// Covariance of the final position deviation, in the same axes (m^2)
+		double meanMissDistance = 0.0;			// Mean distance between the final positions of the dispersed and nominal runs (m)
+		double missDistance3Sigma = 0.0;		// 99.73th percentile of the miss distance (m)
+		double maxMissDistance = 0.0;			// (m)
+		double meanVelocityError = 0.0;			// Mean distance between the final velocities of the dispersed and nominal runs (m/s)
+		double maxVelocityError = 0.0;			// (m/s)
+		double meanMass = 0.0;					// Mean final mass (kg)
+
+		double time = 0.0;						// Time spent simulating runs (s)
+
+		/* Gets the number of runs (including the nominal one) simulated per second. */
+		inline double getRunsPerSecond() const { return (time > 0.0) ? (runs + failedRuns + 1) / time : 0.0; }
+	};
+
+
+	static constexpr double THREE_SIGMA_PERCENTILE = 0.9973;		// Fraction of a Gaussian distribution within 3 standard deviations of its mean
+
+
+	MonteCarloRunner() = default;
+	~MonteCarloRunner() { cancel(); }
+
+	MonteCarloRunner(const MonteCarloRunner &) = delete;
+	MonteCarloRunner &operator=(const MonteCarloRunner &) = delete;
+
+
+	/* Sets the analysis and the scenario it disperses. The analysis must not be running in the background.
+		@param config: The analysis.
+		@param scenario: The scenario. Its samples must cover the duration of the runs.
+	*/
+	void setup(const Dispersions::Config &config, Scenario scenario);
+
+	inline const Dispersions::Config &getConfig() const { return m_config; }
+	inline const Scenario &getScenario() const { return m_scenario; }
+
+
+	/* Simulates the nominal run, then the dispersed runs, aggregating their outcomes as they complete. Blocks until every run is simulated, or the analysis is cancelled.
+		@param pool: The thread pool across which runs are shared.
+		@param maxThreads (optional): The maximum number of threads to use (0: the whole pool).
+		@param stopToken (optional): The token whose stop request cancels the analysis.
+	*/
+	void run(ThreadPool &pool, uint32_t maxThreads = 0, std::stop_token stopToken = {});
+
+
+	/* Runs an analysis in the background. Any analysis in progress is cancelled first.
+		@param config: The analysis.
+		@param scenario: The scenario.
+		@param threadCount: The number of threads simulating runs (0: the number of hardware threads).
+	*/
+	void start(const Dispersions::Config &config, Scenario scenario, uint32_t threadCount);
+
+
+	/* Cancels the analysis in progress (if any), and waits for it to stop. */
+	void cancel();
+
+
+	/* Simulates a single run.
+		@param run: The index of the run (0: the nominal run).
+
+		@return The final state of the measured spacecraft.
+	*/
+	Outcome simulate(uint32_t run) const;
+
+
+	/* Gets the fraction of the runs completed (from 0 to 1). */
+	inline float getProgress() const {
+		const uint64_t runCount = static_cast<uint64_t>(m_config.runs) + 1;
+		return static_cast<float>(m_completedRuns.load()) / runCount;
+	}
+
+	Status getStatus();
+	std::string getError();
+	Statistics getStatistics();
+
+	/* Gets the index (in Scenario::bodies) of the body relative to which the measured spacecraft's final states are expressed. */
+	inline uint32_t getReferenceBody() const { return m_referenceBody; }
+
+private:
+	Dispersions::Config m_config;
+	Scenario m_scenario;
+
+	uint32_t m_measuredBody = 0;					// Index of the measured spacecraft in the scenario
+	uint32_t m_referenceBody = 0;					// Index of the measured spacecraft's dominant body at the start of the runs
+	std::vector<uint32_t> m_specBodies;				// Index of the dispersed spacecraft of every spec
+	std::vector<uint32_t> m_integratedBodies;		// Indices of the integrated (non-fixed) bodies
+
+	// Aggregated outcomes (guarded by m_mutex)
+	std::mutex m_mutex;
+	Status m_status = Status::IDLE;
+	std::string m_error;
+	Outcome m_nominal{};
+	glm::dmat3 m_nominalBasis{ 1.0 };				// Radial, in-track and cross-track axes of the nominal final state (columns)
+	Statistics m_stats;
+	glm::dmat3 m_deviationM2{ 0.0 };				// Sum of the outer products of the deviations from their running mean (Welford)
+	std::vector<double> m_missDistances;
+	std::atomic<uint64_t> m_completedRuns{ 0 };
+	std::chrono::steady_clock::time_point m_startTime;
+
+	// Background analysis
+	std::shared_ptr<WorkerThread> m_worker;
+	ThreadPool m_pool;
+
+
+	/* The state of a run. Every run has its own, so that runs share nothing but the (read-only) scenario. */
+	struct _Context {
+		std::vector<Body> bodies;							// Dispersed bodies
+		std::vector<FiniteBurnScheduler::Engine> engines;	// Dispersed burns
+
+		NBodyStore stage;									// Bodies at the time of an evaluation
+		std::vector<double> state;							// Integrated bodies: [x, y, z, vx, vy, vz] per body
+		ForceModelPipeline forceModels;
+		std::vector<ForceModel::Target> targets;
+		FiniteBurnScheduler burnScheduler;
+		EmbeddedRKIntegrator integrator;
+	};
+
+
+	/* Applies the dispersions of a run to a context's bodies and burns.
+		@param run: The index of the run (0: the nominal run, which is not dispersed).
+		@param context [out]: The context.
+	*/
+	void disperse(uint32_t run, _Context &context) const;
+
+
+	/* Loads the states of every body at a given time into a context's stage.
+		@param context: The context.
+		@param t: The time, in simulation time.
+		@param state: The state vector of the integrated bodies at that time.
+	*/
+	void loadStage(_Context &context, double t, const double *state) const;
+
+
+	/* Refreshes the time-dependent state of a context's force models from the sample at a given time.
+		@param context: The context.
+		@param sampleIndex: The index of the sample.
+	*/
+	void updateForceModels(_Context &context, size_t sampleIndex) const;
+
+
+	/* Sets the targets of a context's force models from the current masses of its bodies. */
+	void setTargets(_Context &context) const;
+
+
+	/* Interpolates the state of a fixed body.
+		@param bodyIndex: The index of the body.
+		@param t: The time, in simulation time.
+		@param position [out], velocity [out]: The state.
+	*/
+	void interpolate(uint32_t bodyIndex, double t, glm::dvec3 &position, glm::dvec3 &velocity) const;
+
+
+	/* Merges the outcome of a dispersed run into the statistics. */
+	void record(const Outcome &outcome);
+
+
+	/* Gets the index of the body (other than a given one) that exerts the strongest point-mass acceleration on a body, from their initial states. */
+	static uint32_t GetDominantBody(const std::vector<Body> &bodies, uint32_t bodyIndex);
+
+
+	/* Gets the radial, in-track and cross-track axes of a relative state (as the columns of a matrix). */
+	static glm::dmat3 GetRTNBasis(const glm::dvec3 &position, const glm::dvec3 &velocity);
+
+
+	inline void setStatus(Status status) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_status = status;
+	}
+};
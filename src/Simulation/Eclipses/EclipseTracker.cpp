@@ -0,0 +1,439 @@
+/* EclipseTracker.cpp - Eclipse tracking implementation.
+*/
+
+#include "EclipseTracker.hpp"
+
+#include <cmath>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+
+#include <Simulation/Forces/ForceModels.hpp>
+#include <Simulation/Algorithms/RootFinding.hpp>
+#include <Simulation/Algorithms/HermiteMotion.hpp>
+
+
+namespace {
+	constexpr size_t BOUNDARY_COUNT = 3;		// Penumbra, umbra and antumbra cones
+
+
+	/* Gets the shadow state of an apparent geometry (see ForceModel::VisibleFraction). */
+	inline EclipseTracker::State GetState(const ForceModel::Occultation &occultation) {
+		const double a = occultation.sunRadius;
+		const double b = occultation.occulterRadius;
+		const double c = occultation.separation;
+
+		if (occultation.isInside || c <= b - a)
+			return EclipseTracker::State::UMBRA;
+		if (c >= a + b)
+			return EclipseTracker::State::SUNLIGHT;
+		if (c <= a - b)
+			return EclipseTracker::State::ANNULAR;
+
+		return EclipseTracker::State::PENUMBRA;
+	}
+
+
+	/* Evaluates the boundary functions of an apparent geometry, each positive on the sunlit side of its boundary:
+		- Penumbra cone: c - (a + b)
+		- Umbra cone: c - (b - a)
+		- Antumbra cone: c - (a - b)
+	*/
+	inline std::array<double, BOUNDARY_COUNT> GetBoundaries(const ForceModel::Occultation &occultation) {
+		const double a = occultation.sunRadius;
+		const double b = occultation.occulterRadius;
+		const double c = occultation.separation;
+
+		return { c - (a + b), c - (b - a), c - (a - b) };
+	}
+
+
+	/* The states on the shadowed and sunlit sides of each boundary. */
+	constexpr EclipseTracker::State BOUNDARY_STATES[BOUNDARY_COUNT][2] = {
+		{ EclipseTracker::State::PENUMBRA, EclipseTracker::State::SUNLIGHT },
+		{ EclipseTracker::State::UMBRA, EclipseTracker::State::PENUMBRA },
+		{ EclipseTracker::State::ANNULAR, EclipseTracker::State::PENUMBRA }
+	};
+}
+
+
+void EclipseTracker::setBodies(uint32_t sunIndex, const std::vector<Occulter> &occulters, const std::vector<uint32_t> &spacecraft) {
+	m_sunIndex = sunIndex;
+	m_occulters = occulters;
+	m_spacecraft = spacecraft;
+
+	m_shadows.assign(spacecraft.size(), Shadow());
+	m_previousShadows.assign(spacecraft.size(), Shadow());
+	m_hosts.assign(spacecraft.size(), 0);
+	m_order.clear();
+
+	m_hasHosts = false;
+	m_hasPrevious = false;
+}
+
+
+size_t EclipseTracker::update(double et, const NBodyStore &store, ThreadPool &pool, std::vector<Transition> &transitions) {
+	const size_t spacecraftCount = m_spacecraft.size();
+	const size_t occulterCount = m_occulters.size();
+
+	if (spacecraftCount == 0 || m_sunIndex == NO_INDEX)
+		return 0;
+
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+
+
+	// States of the Sun and occulting bodies
+	_Snapshot snapshot{
+		.et = et,
+		.sunPosition = store.getPosition(m_sunIndex),
+		.sunVelocity = store.getVelocity(m_sunIndex)
+	};
+	snapshot.occulterPositions.resize(occulterCount);
+	snapshot.occulterVelocities.resize(occulterCount);
+
+	for (size_t k = 0; k < occulterCount; k++) {
+		snapshot.occulterPositions[k] = store.getPosition(m_occulters[k].bodyIndex);
+		snapshot.occulterVelocities[k] = store.getVelocity(m_occulters[k].bodyIndex);
+	}
+
+
+	// Without occulting bodies, every spacecraft is in full sunlight
+	if (occulterCount == 0) {
+		m_shadows.assign(spacecraftCount, Shadow());
+		m_previousShadows = m_shadows;
+		m_stats.updates++;
+		return 0;
+	}
+
+
+	// Clusters
+	if (!m_hasHosts || ++m_updatesSinceHosts >= m_config.hostInterval)
+		assignHosts(store);
+
+	const size_t taskCount = (spacecraftCount + TASK_SIZE - 1) / TASK_SIZE;
+	m_taskClusterRadii.assign(taskCount * occulterCount, -1.0);
+
+	pool.parallelFor(taskCount, [&](size_t task) {
+		double *radii = &m_taskClusterRadii[task * occulterCount];
+		const size_t end = std::min(spacecraftCount, (task + 1) * TASK_SIZE);
+
+		for (size_t i = task * TASK_SIZE; i < end; i++) {
+			const uint32_t host = m_hosts[m_order[i]];
+			const glm::dvec3 relPosition = store.getPosition(m_spacecraft[m_order[i]]) - snapshot.occulterPositions[host];
+			radii[host] = std::max(radii[host], glm::dot(relPosition, relPosition));
+		}
+	});
+
+	m_clusterRadii.assign(occulterCount, -1.0);
+	for (size_t task = 0; task < taskCount; task++)
+		for (size_t k = 0; k < occulterCount; k++)
+			m_clusterRadii[k] = std::max(m_clusterRadii[k], m_taskClusterRadii[task * occulterCount + k]);
+
+	for (double &radius : m_clusterRadii)
+		if (radius >= 0.0)
+			radius = std::sqrt(radius);
+
+	cullOcculters(snapshot);
+
+
+	// Evaluation (and refinement of the transitions since the previous update)
+	const double dt = et - m_previousET;
+	const bool isRefined = m_hasPrevious && dt != 0.0 && std::fabs(dt) <= m_config.maxStep;
+	if (m_hasPrevious && std::fabs(dt) > m_config.maxStep)
+		m_stats.skippedIntervals++;
+
+	m_taskResults.assign(taskCount, _TaskResults());
+
+	pool.parallelFor(taskCount, [&](size_t task) {
+		evaluateRange(task * TASK_SIZE, std::min(spacecraftCount, (task + 1) * TASK_SIZE), store, snapshot, isRefined, m_taskResults[task]);
+	});
+
+
+	// Merge the tasks' results in task order, so that they do not depend on the number of threads
+	const size_t firstTransition = transitions.size();
+
+	for (const _TaskResults &results : m_taskResults) {
+		transitions.insert(transitions.end(), results.transitions.begin(), results.transitions.end());
+
+		m_stats.candidatePairs += results.candidatePairs;
+		m_stats.shadowPairs += results.shadowPairs;
+		m_stats.refinements += results.refinements;
+	}
+
+	std::stable_sort(transitions.begin() + firstTransition, transitions.end(), [](const Transition &a, const Transition &b) {
+		return (a.et != b.et) ? (a.et < b.et) : (a.spacecraft < b.spacecraft);
+	});
+
+	const size_t transitionCount = transitions.size() - firstTransition;
+
+
+	// Keep this update for the next interval
+	if (dt != 0.0 || !m_hasPrevious) {
+		m_previousPositions.resize(spacecraftCount + occulterCount + 1);
+		m_previousVelocities.resize(spacecraftCount + occulterCount + 1);
+
+		for (size_t i = 0; i < spacecraftCount; i++) {
+			m_previousPositions[i] = store.getPosition(m_spacecraft[i]);
+			m_previousVelocities[i] = store.getVelocity(m_spacecraft[i]);
+		}
+		for (size_t k = 0; k < occulterCount; k++) {
+			m_previousPositions[spacecraftCount + k] = snapshot.occulterPositions[k];
+			m_previousVelocities[spacecraftCount + k] = snapshot.occulterVelocities[k];
+		}
+		m_previousPositions.back() = snapshot.sunPosition;
+		m_previousVelocities.back() = snapshot.sunVelocity;
+
+		m_previousShadows = m_shadows;
+		m_previousET = et;
+		m_hasPrevious = true;
+	}
+
+
+	m_stats.updates++;
+	m_stats.pairs += static_cast<uint64_t>(spacecraftCount) * occulterCount;
+	m_stats.transitions += transitionCount;
+	m_stats.time += std::chrono::duration<double>(Clock::now() - start).count();
+
+	return transitionCount;
+}
+
+
+void EclipseTracker::assignHosts(const NBodyStore &store) {
+	const size_t spacecraftCount = m_spacecraft.size();
+
+	for (size_t i = 0; i < spacecraftCount; i++) {
+		const glm::dvec3 position = store.getPosition(m_spacecraft[i]);
+		double nearest = std::numeric_limits<double>::infinity();
+
+		for (size_t k = 0; k < m_occulters.size(); k++) {
+			const glm::dvec3 relPosition = position - store.getPosition(m_occulters[k].bodyIndex);
+			const double distanceSq = glm::dot(relPosition, relPosition);
+
+			if (distanceSq < nearest) {
+				nearest = distanceSq;
+				m_hosts[i] = static_cast<uint32_t>(k);
+			}
+		}
+	}
+
+
+	// Order the spacecraft by host (counting sort, keeping their order within each cluster)
+	std::vector<uint32_t> starts(m_occulters.size() + 1, 0);
+	for (uint32_t host : m_hosts)
+		starts[host + 1]++;
+	for (size_t k = 0; k < m_occulters.size(); k++)
+		starts[k + 1] += starts[k];
+
+	m_order.resize(spacecraftCount);
+	for (size_t i = 0; i < spacecraftCount; i++)
+		m_order[starts[m_hosts[i]]++] = static_cast<uint32_t>(i);
+
+	m_updatesSinceHosts = 0;
+	m_hasHosts = true;
+}
+
+
+void EclipseTracker::cullOcculters(const _Snapshot &snapshot) {
+	const size_t occulterCount = m_occulters.size();
+
+	m_candidateStarts.assign(occulterCount + 1, 0);
+	m_candidates.clear();
+
+	for (size_t j = 0; j < occulterCount; j++) {
+		m_candidateStarts[j] = static_cast<uint32_t>(m_candidates.size());
+
+		const double clusterRadius = m_clusterRadii[j];
+		if (clusterRadius < 0.0)
+			continue;		// No spacecraft
+
+		const glm::dvec3 &hostPosition = snapshot.occulterPositions[j];
+		const glm::dvec3 toSun = snapshot.sunPosition - hostPosition;
+		const double sunDistance = glm::length(toSun);
+
+		for (size_t k = 0; k < occulterCount; k++) {
+			if (k == j) {
+				m_candidates.push_back(static_cast<uint32_t>(k));
+				continue;
+			}
+
+			const glm::dvec3 toOcculter = snapshot.occulterPositions[k] - hostPosition;
+			const double distance = glm::length(toOcculter);
+
+			// The sphere of the cluster reaches the occulting body or the Sun: the bounds do not hold
+			if (distance - clusterRadius <= m_occulters[k].radius || sunDistance - clusterRadius <= ForceModel::SOLAR_RADIUS) {
+				m_candidates.push_back(static_cast<uint32_t>(k));
+				continue;
+			}
+
+			// Bounds of the apparent radii of the Sun and the occulting body, and of the apparent separation of their centers, from anywhere in the sphere
+			const double maxSunRadius = std::asin(std::min(1.0, ForceModel::SOLAR_RADIUS / (sunDistance - clusterRadius)));
+			const double maxOcculterRadius = std::asin(std::min(1.0, m_occulters[k].radius / (distance - clusterRadius)));
+
+			const double separation = std::acos(std::clamp(glm::dot(toOcculter, toSun) / (distance * sunDistance), -1.0, 1.0));
+			const double parallax = std::asin(std::min(1.0, clusterRadius / distance)) + std::asin(std::min(1.0, clusterRadius / sunDistance));
+
+			if (separation - parallax < maxSunRadius + maxOcculterRadius)
+				m_candidates.push_back(static_cast<uint32_t>(k));
+		}
+	}
+
+	m_candidateStarts[occulterCount] = static_cast<uint32_t>(m_candidates.size());
+}
+
+
+void EclipseTracker::evaluateRange(size_t begin, size_t end, const NBodyStore &store, const _Snapshot &snapshot, bool isRefined, _TaskResults &results) {
+	// Contiguous arrays of the spacecraft's positions, for the sunlight test
+	double x[TASK_SIZE], y[TASK_SIZE], z[TASK_SIZE];
+	double sunX[TASK_SIZE], sunY[TASK_SIZE], sunZ[TASK_SIZE];		// Position of the Sun relative to the spacecraft
+	uint8_t isSunlit[TASK_SIZE];
+
+	for (size_t i = begin; i < end; i++) {
+		const uint32_t body = m_spacecraft[m_order[i]];
+		x[i - begin] = store.x[body];
+		y[i - begin] = store.y[body];
+		z[i - begin] = store.z[body];
+
+		sunX[i - begin] = snapshot.sunPosition.x - x[i - begin];
+		sunY[i - begin] = snapshot.sunPosition.y - y[i - begin];
+		sunZ[i - begin] = snapshot.sunPosition.z - z[i - begin];
+
+		m_shadows[m_order[i]] = Shadow();
+	}
+
+
+	// Runs of spacecraft sharing a host
+	for (size_t runBegin = begin; runBegin < end; ) {
+		const uint32_t host = m_hosts[m_order[runBegin]];
+		size_t runEnd = runBegin + 1;
+		while (runEnd < end && m_hosts[m_order[runEnd]] == host)
+			runEnd++;
+
+		const size_t first = runBegin - begin;
+		const size_t count = runEnd - runBegin;
+
+		for (uint32_t c = m_candidateStarts[host]; c < m_candidateStarts[host + 1]; c++) {
+			const uint32_t k = m_candidates[c];
+			const glm::dvec3 &occulterPosition = snapshot.occulterPositions[k];
+			const double radius = m_occulters[k].radius;
+
+			// Sunlight test: c >= a + b <=> cos(c) <= cos(a) cos(b) - sin(a) sin(b), on the apparent radii of the Sun (a) and the occulting body (b) and their separation (c)
+			for (size_t l = first; l < first + count; l++) {
+				const double rx = x[l] - occulterPosition.x;
+				const double ry = y[l] - occulterPosition.y;
+				const double rz = z[l] - occulterPosition.z;
+
+				const double distanceSq = rx * rx + ry * ry + rz * rz;
+				const double sunDistanceSq = sunX[l] * sunX[l] + sunY[l] * sunY[l] + sunZ[l] * sunZ[l];
+
+				const double sinB = radius / std::sqrt(distanceSq);
+				const double sinA = ForceModel::SOLAR_RADIUS / std::sqrt(sunDistanceSq);
+				const double cosB = std::sqrt(std::max(0.0, 1.0 - sinB * sinB));
+				const double cosA = std::sqrt(std::max(0.0, 1.0 - sinA * sinA));
+				const double cosC = -(rx * sunX[l] + ry * sunY[l] + rz * sunZ[l]) / std::sqrt(distanceSq * sunDistanceSq);
+
+				isSunlit[l] = (distanceSq > radius * radius) & (cosC <= cosA * cosB - sinA * sinB);
+			}
+
+			// Shadow fractions of the others
+			for (size_t l = first; l < first + count; l++) {
+				if (isSunlit[l])
+					continue;
+
+				const glm::dvec3 position(x[l], y[l], z[l]);
+				const ForceModel::Occultation occultation = ForceModel::GetOccultation(position - occulterPosition, snapshot.sunPosition - occulterPosition, radius);
+				const double fraction = ForceModel::VisibleFraction(occultation);
+
+				Shadow &shadow = m_shadows[m_order[begin + l]];
+				if (shadow.occulter == NO_INDEX || fraction < shadow.sunFraction) {
+					shadow.sunFraction = fraction;
+					shadow.state = GetState(occultation);
+					shadow.occulter = (shadow.state == State::SUNLIGHT) ? NO_INDEX : k;
+				}
+
+				results.shadowPairs++;
+			}
+
+			results.candidatePairs += count;
+		}
+
+		runBegin = runEnd;
+	}
+
+
+	// Transitions since the previous update, at the boundaries of the occulting bodies shadowing the spacecraft at either end of the interval
+	if (!isRefined)
+		return;
+
+	for (size_t i = begin; i < end; i++) {
+		const uint32_t spacecraft = m_order[i];
+		const Shadow &shadow = m_shadows[spacecraft];
+		const Shadow &previous = m_previousShadows[spacecraft];
+
+		if (shadow.state == previous.state && shadow.occulter == previous.occulter)
+			continue;
+
+		const glm::dvec3 position(x[i - begin], y[i - begin], z[i - begin]);
+		const glm::dvec3 velocity = store.getVelocity(m_spacecraft[spacecraft]);
+
+		if (shadow.occulter != NO_INDEX)
+			refineTransitions(spacecraft, shadow.occulter, position, velocity, snapshot, results);
+		if (previous.occulter != NO_INDEX && previous.occulter != shadow.occulter)
+			refineTransitions(spacecraft, previous.occulter, position, velocity, snapshot, results);
+	}
+}
+
+
+void EclipseTracker::refineTransitions(uint32_t spacecraft, uint32_t occulter, const glm::dvec3 &position, const glm::dvec3 &velocity, const _Snapshot &snapshot, _TaskResults &results) const {
+	const size_t previousOcculter = m_spacecraft.size() + occulter;
+	const double duration = snapshot.et - m_previousET;
+	const double radius = m_occulters[occulter].radius;
+
+	// Motions of the spacecraft and the Sun relative to the occulting body
+	const HermiteMotion spacecraftMotion{
+		.r0 = m_previousPositions[spacecraft] - m_previousPositions[previousOcculter],
+		.r1 = position - snapshot.occulterPositions[occulter],
+		.w0 = (m_previousVelocities[spacecraft] - m_previousVelocities[previousOcculter]) * duration,
+		.w1 = (velocity - snapshot.occulterVelocities[occulter]) * duration
+	};
+	const HermiteMotion sunMotion{
+		.r0 = m_previousPositions.back() - m_previousPositions[previousOcculter],
+		.r1 = snapshot.sunPosition - snapshot.occulterPositions[occulter],
+		.w0 = (m_previousVelocities.back() - m_previousVelocities[previousOcculter]) * duration,
+		.w1 = (snapshot.sunVelocity - snapshot.occulterVelocities[occulter]) * duration
+	};
+
+	const ForceModel::Occultation start = ForceModel::GetOccultation(spacecraftMotion.r0, sunMotion.r0, radius);
+	const ForceModel::Occultation end = ForceModel::GetOccultation(spacecraftMotion.r1, sunMotion.r1, radius);
+	if (start.isInside || end.isInside)
+		return;
+
+	const std::array<double, BOUNDARY_COUNT> startBoundaries = GetBoundaries(start);
+	const std::array<double, BOUNDARY_COUNT> endBoundaries = GetBoundaries(end);
+
+	for (size_t m = 0; m < BOUNDARY_COUNT; m++) {
+		const double g0 = startBoundaries[m];
+		const double g1 = endBoundaries[m];
+		if ((g0 > 0.0) == (g1 > 0.0))
+			continue;
+
+		const double s = RootFinding::FindRoot([&](double s) {
+			results.refinements++;
+			return GetBoundaries(ForceModel::GetOccultation(spacecraftMotion.position(s), sunMotion.position(s), radius))[m];
+		}, 0.0, 1.0, g0, g1, m_config.tolerance / std::fabs(duration));
+
+		const bool isEntering = (g0 > 0.0);		// From the sunlit side of the boundary
+
+		results.transitions.push_back(Transition{
+			.spacecraft = spacecraft,
+			.occulter = occulter,
+			.et = m_previousET + s * duration,
+			.from = BOUNDARY_STATES[m][isEntering ? 1 : 0],
+			.to = BOUNDARY_STATES[m][isEntering ? 0 : 1]
+		});
+	}
+}
@@ -0,0 +1,200 @@
+/* EclipseTracker.hpp - Shadow states of spacecraft, and their eclipse entry and exit times.
+	Sources:
+		- O. Montenbruck and E. Gill, "Satellite Orbits: Models, Methods and Applications" (2000), Section 3.4.2 (conical shadow model).
+		- D. A. Vallado, "Fundamentals of Astrodynamics and Applications", 4th ed., 2013 (§5.3 eclipses).
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+/* Tracks the illumination of every spacecraft of a body store by the Sun, occulted by spherical bodies (conical shadow model), and finds the times at which spacecraft enter and leave the penumbras and umbras of the occulting bodies.
+	Every update evaluates all spacecraft in a single pass, at a cost close to O(spacecraft) rather than O(spacecraft x occulters):
+		1. Clustering: every spacecraft is assigned a host, the occulting body whose center is nearest to it (reassigned every Config::hostInterval updates), and spacecraft are ordered by host. The cluster of a host is bounded by a sphere around it, enclosing its spacecraft.
+		2. Occulter culling: from anywhere in the sphere of a cluster, the apparent radii of the Sun and of another occulting body are bounded, and so is the apparent separation of their centers (by the parallax across the sphere). Occulting bodies that appear further from the Sun than the sum of these radii cannot shadow any spacecraft of the cluster, and are never evaluated for them. In practice, only the host remains.
+		3. Evaluation: for every run of spacecraft sharing a host and every remaining occulting body, spacecraft in full sunlight are identified from the cosines of the apparent radii and separation, in a branch-free loop over contiguous arrays (with square roots and divisions only, so that it is vectorized). The shadow fractions of the others are computed by ForceModel::VisibleFraction.
+	When the shadow state of a spacecraft changes between two updates, the boundaries crossed (penumbra, umbra and antumbra cones) are found in the interval by safeguarded regula falsi, on the cubic Hermite interpolants of the positions of the spacecraft and the Sun relative to the occulting body. Boundaries crossed twice within an interval (e.g., a grazing penumbra) are not seen; updates should be a small fraction of an orbital period apart.
+*/
+class EclipseTracker {
+public:
+	/* Shadow states, by increasing occultation. */
+	enum class State : uint8_t {
+		SUNLIGHT,		// Full sunlight
+		PENUMBRA,		// Partial occultation
+		ANNULAR,		// Annular occultation (the occulting body appears smaller than the Sun, and within its disk)
+		UMBRA			// Total occultation
+	};
+
+
+	/* Tracking parameters. */
+	struct Config {
+		double tolerance = 0.01;			// Tolerance of entry and exit times (s)
+		double maxStep = 600.0;				// Longest interval between updates whose transitions are refined (s); transitions over longer intervals are not reported
+		uint32_t hostInterval = 64;			// Updates between reassignments of the spacecraft's hosts
+	};
+
+
+	/* An occulting body. */
+	struct Occulter {
+		uint32_t bodyIndex;		// Index of the body in the store
+		double radius;			// Radius (m)
+	};
+
+
+	/* The illumination of a spacecraft. */
+	struct Shadow {
+		double sunFraction = 1.0;			// Visible fraction of the solar disk
+		State state = State::SUNLIGHT;
+		uint32_t occulter = NO_INDEX;		// Index of the occulting body (hiding the largest part of the solar disk), or NO_INDEX in full sunlight
+	};
+
+
+	/* A change of the shadow state of a spacecraft. */
+	struct Transition {
+		uint32_t spacecraft;		// Index of the spacecraft
+		uint32_t occulter;			// Index of the occulting body whose shadow boundary is crossed
+		double et;					// Time of the crossing, in Ephemeris Time
+		State from;					// State before the crossing
+		State to;					// State after the crossing
+	};
+
+
+	/* Tracking statistics. */
+	struct Statistics {
+		uint64_t updates = 0;
+		uint64_t pairs = 0;					// Spacecraft-occulter pairs, i.e., spacecraft x occulters per update
+		uint64_t candidatePairs = 0;		// Pairs not culled by the clusters' bounds
+		uint64_t shadowPairs = 0;			// Candidate pairs not in full sunlight (whose shadow fractions were computed)
+		uint64_t transitions = 0;			// Transitions found
+		uint64_t refinements = 0;			// Boundary evaluations during refinement
+		uint64_t skippedIntervals = 0;		// Intervals longer than Config::maxStep
+		double time = 0.0;					// Time spent updating (s)
+	};
+
+
+	static constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+
+	EclipseTracker() = default;
+	~EclipseTracker() = default;
+
+
+	inline void setConfig(const Config &config) { m_config = config; }
+	inline const Config &getConfig() const { return m_config; }
+
+
+	/* Sets the bodies of the store to track, and discards the previous update.
+		@param sunIndex: The index of the Sun in the store.
+		@param occulters: The occulting bodies.
+		@param spacecraft: The indices of the spacecraft in the store.
+	*/
+	void setBodies(uint32_t sunIndex, const std::vector<Occulter> &occulters, const std::vector<uint32_t> &spacecraft);
+
+
+	/* Updates the shadows of the spacecraft, and finds the transitions since the previous update.
+		@param et: The epoch of the store's states, in Ephemeris Time.
+		@param store: The body store (positions in m, velocities in m/s, in any inertial frame).
+		@param pool: The thread pool across which spacecraft are shared.
+		@param transitions [out]: The vector to which the transitions are appended, ordered by time.
+
+		@return The number of transitions found.
+	*/
+	size_t update(double et, const NBodyStore &store, ThreadPool &pool, std::vector<Transition> &transitions);
+
+
+	/* Gets the shadows of the spacecraft (in the order of EclipseTracker::setBodies), as of the last update. */
+	inline const std::vector<Shadow> &getShadows() const { return m_shadows; }
+
+	inline uint32_t getSunIndex() const { return m_sunIndex; }
+	inline const std::vector<Occulter> &getOcculters() const { return m_occulters; }
+	inline const std::vector<uint32_t> &getSpacecraft() const { return m_spacecraft; }
+
+
+	inline const Statistics &getStatistics() const { return m_stats; }
+	inline void resetStatistics() { m_stats = Statistics(); }
+
+private:
+	static constexpr size_t TASK_SIZE = 256;		// Spacecraft per task
+
+	Config m_config;
+	Statistics m_stats;
+
+	uint32_t m_sunIndex = NO_INDEX;
+	std::vector<Occulter> m_occulters;
+	std::vector<uint32_t> m_spacecraft;
+	std::vector<Shadow> m_shadows;
+
+	// Clusters
+	std::vector<uint32_t> m_hosts;					// Host of each spacecraft
+	std::vector<uint32_t> m_order;					// Spacecraft, ordered by host
+	uint32_t m_updatesSinceHosts = 0;				// Updates since the hosts were assigned
+	bool m_hasHosts = false;
+	std::vector<double> m_clusterRadii;				// Radius of every cluster's sphere (m), or a negative value if it has no spacecraft
+	std::vector<double> m_taskClusterRadii;			// Squared radius of every cluster's sphere, per task (tasks x occulters)
+	std::vector<uint32_t> m_candidateStarts;		// Start of each cluster's candidate occulters in m_candidates (plus the end of the last one)
+	std::vector<uint32_t> m_candidates;				// Occulters that may shadow each cluster
+
+	// Previous update
+	bool m_hasPrevious = false;
+	double m_previousET = 0.0;
+	std::vector<glm::dvec3> m_previousPositions;	// Spacecraft, then occulters, then the Sun
+	std::vector<glm::dvec3> m_previousVelocities;
+	std::vector<Shadow> m_previousShadows;
+
+
+	/* The states of the Sun and occulting bodies at an update. */
+	struct _Snapshot {
+		double et;
+		glm::dvec3 sunPosition;
+		glm::dvec3 sunVelocity;
+		std::vector<glm::dvec3> occulterPositions;
+		std::vector<glm::dvec3> occulterVelocities;
+	};
+
+
+	/* Per-task results (merged once the tasks complete). */
+	struct _TaskResults {
+		std::vector<Transition> transitions;
+		uint64_t candidatePairs = 0;
+		uint64_t shadowPairs = 0;
+		uint64_t refinements = 0;
+	};
+	std::vector<_TaskResults> m_taskResults;
+
+
+	/* Assigns every spacecraft to the nearest occulting body, and orders the spacecraft by host. */
+	void assignHosts(const NBodyStore &store);
+
+
+	/* Culls, for every cluster, the occulting bodies that cannot shadow any of its spacecraft. */
+	void cullOcculters(const _Snapshot &snapshot);
+
+
+	/* Evaluates the shadows of a range of spacecraft (in host order), and refines their transitions.
+		@param begin, end: The range, in m_order.
+		@param store: The body store.
+		@param snapshot: The states of the Sun and occulting bodies.
+		@param isRefined: Whether transitions since the previous update are refined.
+		@param results [out]: The task's results.
+	*/
+	void evaluateRange(size_t begin, size_t end, const NBodyStore &store, const _Snapshot &snapshot, bool isRefined, _TaskResults &results);
+
+
+	/* Finds the shadow boundaries of an occulting body crossed by a spacecraft between the previous update and the current one.
+		@param spacecraft: The index of the spacecraft.
+		@param occulter: The index of the occulting body.
+		@param position, velocity: The state of the spacecraft at the current update.
+		@param snapshot: The states of the Sun and occulting bodies at the current update.
+		@param results [out]: The task's results, to whose transitions the crossings are appended.
+	*/
+	void refineTransitions(uint32_t spacecraft, uint32_t occulter, const glm::dvec3 &position, const glm::dvec3 &velocity, const _Snapshot &snapshot, _TaskResults &results) const;
+};
@@ -0,0 +1,71 @@
+/* Atmosphere.hpp - Atmospheric density models.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <array>
+
+
+namespace Atmosphere {
+	/* A layer of the exponential atmosphere model. */
+	struct ExponentialLayer {
+		double baseAltitude;		// Base altitude of the layer (m)
+		double baseDensity;			// Nominal density at the base altitude (kg/m^3)
+		double scaleHeight;			// Scale height (m)
+	};
+
+
+	/* Layers of Earth's exponential atmosphere model (CIRA-72 fit, 0 to 1000+ km).
+		Reference: D. A. Vallado, "Fundamentals of Astrodynamics and Applications" (4th ed.), Table 8-4.
+	*/
+	constexpr std::array<ExponentialLayer, 28> EARTH_EXPONENTIAL_LAYERS = {{
+		{ 0.0,			1.225,		7249.0 },
+		{ 25e3,			3.899e-2,	6349.0 },
+		{ 30e3,			1.774e-2,	6682.0 },
+		{ 40e3,			3.972e-3,	7554.0 },
+		{ 50e3,			1.057e-3,	8382.0 },
+		{ 60e3,			3.206e-4,	7714.0 },
+		{ 70e3,			8.770e-5,	6549.0 },
+		{ 80e3,			1.905e-5,	5799.0 },
+		{ 90e3,			3.396e-6,	5382.0 },
+		{ 100e3,		5.297e-7,	5877.0 },
+		{ 110e3,		9.661e-8,	7263.0 },
+		{ 120e3,		2.438e-8,	9473.0 },
+		{ 130e3,		8.484e-9,	12636.0 },
+		{ 140e3,		3.845e-9,	16149.0 },
+		{ 150e3,		2.070e-9,	22523.0 },
+		{ 180e3,		5.464e-10,	29740.0 },
+		{ 200e3,		2.789e-10,	37105.0 },
+		{ 250e3,		7.248e-11,	45546.0 },
+		{ 300e3,		2.418e-11,	53628.0 },
+		{ 350e3,		9.518e-12,	53298.0 },
+		{ 400e3,		3.725e-12,	58515.0 },
+		{ 450e3,		1.585e-12,	60828.0 },
+		{ 500e3,		6.967e-13,	63822.0 },
+		{ 600e3,		1.454e-13,	71835.0 },
+		{ 700e3,		3.614e-14,	88667.0 },
+		{ 800e3,		1.170e-14,	124640.0 },
+		{ 900e3,		5.245e-15,	181050.0 },
+		{ 1000e3,		3.019e-15,	268000.0 }
+	}};
+
+
+	/* Computes the density of Earth's atmosphere with the exponential model.
+		@param altitude: The altitude above the reference ellipsoid (m).
+
+		@return The density (kg/m^3). Altitudes below 0 are clamped to sea level.
+	*/
+	inline double ExponentialDensity(double altitude) {
+		if (altitude <= 0.0)
+			return EARTH_EXPONENTIAL_LAYERS[0].baseDensity;
+
+		// The layers are few and sorted: a linear scan from the top is faster than a binary search for orbital altitudes
+		size_t layer = EARTH_EXPONENTIAL_LAYERS.size() - 1;
+		while (layer > 0 && altitude < EARTH_EXPONENTIAL_LAYERS[layer].baseAltitude)
+			layer--;
+
+		const ExponentialLayer &base = EARTH_EXPONENTIAL_LAYERS[layer];
+		return base.baseDensity * std::exp(-(altitude - base.baseAltitude) / base.scaleHeight);
+	}
+}
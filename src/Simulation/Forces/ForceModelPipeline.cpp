@@ -0,0 +1,177 @@
+/* ForceModelPipeline.cpp - Fused force model pipeline implementation.
+*/
+
+#include "ForceModelPipeline.hpp"
+
+#include <array>
+#include <utility>
+#include <algorithm>
+
+
+namespace {
+	using namespace ForceModel;
+
+
+	/* Computes the perturbing acceleration of a target with a fixed combination of force models. Disabled models are discarded at compile time. */
+	template<uint32_t Models>
+	glm::dvec3 EvaluateFused(const ForceModelPipeline::Environment &env, const Target &target, const NBodyStore &sources, const glm::dvec3 &position, const glm::dvec3 &velocity, double t) {
+		glm::dvec3 acceleration(0.0);
+
+		const CentralBody *central = (target.centralBody != NO_INDEX) ? &env.centralBodies[target.centralBody] : nullptr;
+		glm::dvec3 relPosition(0.0);
+		if (central)
+			relPosition = position - sources.getPosition(central->bodyIndex);
+
+
+		if constexpr ((Models & GRAVITY_FIELD) != 0) {
+			if (central && central->gravityField)
+				acceleration += SphericalHarmonics(relPosition, *central, t);
+		}
+
+		if constexpr ((Models & ZONAL_HARMONICS) != 0) {
+			if (central && !central->gravityField)
+				acceleration += ZonalHarmonics(relPosition, *central, env.zonalDegree);
+		}
+
+		if constexpr ((Models & ATMOSPHERIC_DRAG) != 0) {
+			if (central && central->hasAtmosphere && target.ballisticFactor > 0.0)
+				acceleration += AtmosphericDrag(relPosition, velocity - sources.getVelocity(central->bodyIndex), *central, target.ballisticFactor);
+		}
+
+		if constexpr ((Models & SOLAR_RADIATION_PRESSURE) != 0) {
+			if (target.radiationFactor > 0.0) {
+				const glm::dvec3 sunPosition = sources.getPosition(env.sunIndex);
+
+				// The central body casts the shadow (unless it is the Sun itself)
+				double shadowFactor = 1.0;
+				if (central && central->bodyIndex != env.sunIndex)
+					shadowFactor = ShadowFactor(relPosition, sunPosition - sources.getPosition(central->bodyIndex), central->equatRadius, env.shadowModel);
+
+				if (shadowFactor > 0.0)
+					acceleration += SolarRadiationPressure(position, sunPosition, target.radiationFactor, shadowFactor);
+			}
+		}
+
+		if constexpr ((Models & THIRD_BODY) != 0) {
+			for (const ThirdBody &thirdBody : env.thirdBodies) {
+				const glm::dvec3 thirdBodyPosition = thirdBody.position + (t - thirdBody.epochET) * thirdBody.velocity;
+				acceleration += ThirdBodyPointMass(position, thirdBodyPosition, thirdBody.gravParam, env.isOriginAccelerated);
+			}
+		}
+
+		return acceleration;
+	}
+
+
+	/* Adds the perturbing accelerations of every target to a store with a fixed combination of force models. */
+	template<uint32_t Models>
+	void ApplyFused(const ForceModelPipeline::Environment &env, const std::vector<Target> &targets, NBodyStore &stage, double t) {
+		for (const Target &target : targets) {
+			const uint32_t i = target.bodyIndex;
+			const glm::dvec3 acceleration = EvaluateFused<Models>(env, target, stage, stage.getPosition(i), stage.getVelocity(i), t);
+
+			stage.ax[i] += acceleration.x;
+			stage.ay[i] += acceleration.y;
+			stage.az[i] += acceleration.z;
+		}
+	}
+
+
+	template<uint32_t... Models>
+	constexpr std::array<ForceModelPipeline::ApplyFunc, sizeof...(Models)> MakeApplyTable(std::integer_sequence<uint32_t, Models...>) {
+		return { &ApplyFused<Models>... };
+	}
+
+	template<uint32_t... Models>
+	constexpr std::array<ForceModelPipeline::EvaluateFunc, sizeof...(Models)> MakeEvaluateTable(std::integer_sequence<uint32_t, Models...>) {
+		return { &EvaluateFused<Models>... };
+	}
+
+
+	// Fused functions of every model combination, indexed by their model flags
+	constexpr auto APPLY_TABLE = MakeApplyTable(std::make_integer_sequence<uint32_t, MODEL_COMBINATIONS>{});
+	constexpr auto EVALUATE_TABLE = MakeEvaluateTable(std::make_integer_sequence<uint32_t, MODEL_COMBINATIONS>{});
+}
+
+
+
+void ForceModelPipeline::configure(uint32_t models, int zonalDegree, Solvers::ShadowModel shadowModel) {
+	m_models = models & (MODEL_COMBINATIONS - 1);
+	m_environment.zonalDegree = std::clamp(zonalDegree, 0, Solvers::MAX_ZONAL_DEGREE);
+	m_environment.shadowModel = shadowModel;
+
+	if (m_environment.zonalDegree < 2)
+		m_models &= ~ZONAL_HARMONICS;
+
+	compile();
+}
+
+
+void ForceModelPipeline::setTargets(const std::vector<Target> &targets, size_t bodyCount) {
+	m_targets = targets;
+
+	m_targetSlots.assign(bodyCount, NO_INDEX);
+	for (size_t slot = 0; slot < m_targets.size(); slot++)
+		m_targetSlots[m_targets[slot].bodyIndex] = static_cast<uint32_t>(slot);
+}
+
+
+void ForceModelPipeline::assignCentralBodies(const NBodyStore &store) {
+	const std::vector<CentralBody> &centralBodies = m_environment.centralBodies;
+
+	for (Target &target : m_targets) {
+		const glm::dvec3 position = store.getPosition(target.bodyIndex);
+
+		target.centralBody = NO_INDEX;
+		double maxPull = 0.0;
+
+		for (size_t k = 0; k < centralBodies.size(); k++) {
+			if (centralBodies[k].bodyIndex == target.bodyIndex)
+				continue;
+
+			const glm::dvec3 offset = position - store.getPosition(centralBodies[k].bodyIndex);
+			const double pull = centralBodies[k].gravParam / glm::dot(offset, offset);
+
+			if (pull > maxPull) {
+				maxPull = pull;
+				target.centralBody = static_cast<uint32_t>(k);
+			}
+		}
+	}
+}
+
+
+void ForceModelPipeline::compile() {
+	m_activeModels = m_models;
+
+	if (m_environment.sunIndex == NO_INDEX)
+		m_activeModels &= ~SOLAR_RADIATION_PRESSURE;
+
+	if (m_environment.thirdBodies.empty())
+		m_activeModels &= ~THIRD_BODY;
+
+	const bool hasGravityField = std::any_of(m_environment.centralBodies.begin(), m_environment.centralBodies.end(), [](const CentralBody &centralBody) {
+		return centralBody.gravityField != nullptr;
+	});
+	if (!hasGravityField)
+		m_activeModels &= ~GRAVITY_FIELD;
+
+	m_apply = APPLY_TABLE[m_activeModels];
+	m_evaluate = EVALUATE_TABLE[m_activeModels];
+}
+
+
+void ForceModelPipeline::apply(NBodyStore &stage, double t) const {
+	if (!isActive())
+		return;
+
+	m_apply(m_environment, m_targets, stage, t);
+}
+
+
+glm::dvec3 ForceModelPipeline::computeAcceleration(uint32_t bodyIndex, const NBodyStore &sources, const glm::dvec3 &position, const glm::dvec3 &velocity, double t) const {
+	if (!isActive() || bodyIndex >= m_targetSlots.size() || m_targetSlots[bodyIndex] == NO_INDEX)
+		return glm::dvec3(0.0);
+
+	return m_evaluate(m_environment, m_targets[m_targetSlots[bodyIndex]], sources, position, velocity, t);
+}
@@ -0,0 +1,108 @@
+/* ForceModelPipeline.hpp - Composes the enabled perturbing force models into a single fused acceleration function.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Data/Solvers.hpp>
+#include <Simulation/Forces/ForceModels.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+/* Applies perturbing accelerations (on top of point-mass gravity) to the bodies of a body store.
+	Every combination of force models is instantiated at compile time as its own acceleration function, in which the disabled models do not exist. Compiling the pipeline selects one of these functions, so that the models are not re-checked for every body at every integrator stage.
+*/
+class ForceModelPipeline {
+public:
+	/* The state of the environment shared by all targets. It is refreshed between integration steps. */
+	struct Environment {
+		std::vector<ForceModel::CentralBody> centralBodies;
+		std::vector<ForceModel::ThirdBody> thirdBodies;
+
+		uint32_t sunIndex = ForceModel::NO_INDEX;		// Index of the Sun in the body store (radiation pressure source), or NO_INDEX
+		int zonalDegree = 0;							// Highest zonal harmonic degree
+		Solvers::ShadowModel shadowModel = Solvers::ShadowModel::CONICAL;
+		bool isOriginAccelerated = false;				// Whether the origin of the simulation frame is a body (see ForceModel::ThirdBodyPointMass)
+	};
+
+
+	ForceModelPipeline() = default;
+	~ForceModelPipeline() = default;
+
+
+	/* Sets the requested force models. The pipeline must be (re)compiled afterwards.
+		@param models: A combination (bitwise OR) of ForceModel::Model flags.
+		@param zonalDegree: The highest zonal harmonic degree (2 to Solvers::MAX_ZONAL_DEGREE). Zonal harmonics are disabled below degree 2.
+		@param shadowModel: The shadow model used by solar radiation pressure.
+	*/
+	void configure(uint32_t models, int zonalDegree, Solvers::ShadowModel shadowModel);
+
+
+	/* Sets the bodies affected by the force models.
+		@param targets: The targets.
+		@param bodyCount: The number of bodies in the body store.
+	*/
+	void setTargets(const std::vector<ForceModel::Target> &targets, size_t bodyCount);
+
+
+	/* Assigns each target to the central body that exerts the strongest point-mass acceleration on it.
+		@param store: The body store.
+	*/
+	void assignCentralBodies(const NBodyStore &store);
+
+
+	/* Selects the fused acceleration function for the requested force models that the current environment supports (e.g., radiation pressure needs the Sun, third-body perturbations need third bodies, and gravity fields need a central body with a field). */
+	void compile();
+
+
+	/* Adds the perturbing accelerations of every target to the acceleration arrays of a store.
+		@param stage: The body store (or a stage buffer parallel to it). Its positions and velocities must be those at which the accelerations are evaluated.
+		@param t: The time at which the accelerations are evaluated, in Ephemeris Time.
+	*/
+	void apply(NBodyStore &stage, double t) const;
+
+
+	/* Computes the perturbing acceleration of a single body.
+		@param bodyIndex: The index of the body in the body store.
+		@param sources: The body store that provides the states of the central bodies and of the Sun.
+		@param position: The position of the body (m).
+		@param velocity: The velocity of the body (m/s).
+		@param t: The time at which the acceleration is evaluated, in Ephemeris Time.
+
+		@return The acceleration (m/s^2), or 0 if the body is not a target.
+	*/
+	glm::dvec3 computeAcceleration(uint32_t bodyIndex, const NBodyStore &sources, const glm::dvec3 &position, const glm::dvec3 &velocity, double t) const;
+
+
+	/* Is any force model active on any target? */
+	inline bool isActive() const { return m_activeModels != 0 && !m_targets.empty(); }
+
+	/* Gets the requested force models. */
+	inline uint32_t getModels() const { return m_models; }
+
+	/* Gets the force models of the compiled acceleration function. */
+	inline uint32_t getActiveModels() const { return m_activeModels; }
+
+	inline Environment &getEnvironment() { return m_environment; }
+	inline const std::vector<ForceModel::Target> &getTargets() const { return m_targets; }
+
+
+	using ApplyFunc = void(*)(const Environment &, const std::vector<ForceModel::Target> &, NBodyStore &, double);
+	using EvaluateFunc = glm::dvec3(*)(const Environment &, const ForceModel::Target &, const NBodyStore &, const glm::dvec3 &, const glm::dvec3 &, double);
+
+private:
+	uint32_t m_models = 0;
+	uint32_t m_activeModels = 0;
+
+	Environment m_environment;
+	std::vector<ForceModel::Target> m_targets;
+	std::vector<uint32_t> m_targetSlots;		// Body index -> index in m_targets (or NO_INDEX)
+
+	ApplyFunc m_apply = nullptr;
+	EvaluateFunc m_evaluate = nullptr;
+};
@@ -0,0 +1,312 @@
+/* ForceModels.hpp - Perturbing accelerations: zonal harmonics, gravity fields, atmospheric drag, solar radiation pressure, and third-body point masses.
+	Sources:
+		- D. A. Vallado, "Fundamentals of Astrodynamics and Applications" (4th ed.), Chapter 8.
+		- O. Montenbruck and E. Gill, "Satellite Orbits: Models, Methods and Applications" (2000), Chapter 3.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <numbers>
+#include <algorithm>
+
+
+#include <Core/Data/Constants.h>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Data/Solvers.hpp>
+#include <Simulation/Forces/Atmosphere.hpp>
+#include <Simulation/Forces/GravityField.hpp>
+
+
+namespace ForceModel {
+	// Force model flags. A force model pipeline is compiled for a combination (bitwise OR) of them.
+	enum Model : uint32_t {
+		ZONAL_HARMONICS				= 1 << 0,
+		ATMOSPHERIC_DRAG			= 1 << 1,
+		SOLAR_RADIATION_PRESSURE	= 1 << 2,
+		THIRD_BODY					= 1 << 3,
+		GRAVITY_FIELD				= 1 << 4
+	};
+
+	constexpr uint32_t MODEL_COMBINATIONS = 1 << 5;		// Number of distinct model combinations
+
+	constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+	constexpr double SOLAR_PRESSURE_1AU = 4.56e-6;		// Solar radiation pressure at 1 AU (N/m^2)
+	constexpr double SOLAR_RADIUS = 6.96342e+8;			// Radius of the Sun (m)
+
+
+	/* A body whose gravity field and atmosphere perturb the bodies orbiting it. */
+	struct CentralBody {
+		uint32_t bodyIndex;									// Index of the body in the body store
+		double gravParam;									// Gravitational parameter (m^3/s^2)
+		double equatRadius;									// Equatorial radius (m)
+		double flattening;									// Flattening of the reference ellipsoid
+		std::array<double, Solvers::MAX_ZONAL_DEGREE + 1> zonals{};	// Unnormalized zonal coefficients, indexed by degree (J0 and J1 are unused)
+
+		glm::dvec3 pole{ 0.0, 0.0, 1.0 };					// Unit rotation axis (body-fixed +Z) in the simulation frame
+		glm::dvec3 angularVelocity{ 0.0 };					// Angular velocity in the simulation frame (rad/s)
+		bool hasAtmosphere = false;							// Whether the body has a modeled atmosphere (see Atmosphere::ExponentialDensity)
+
+		const GravityField *gravityField = nullptr;			// Spherical harmonic gravity field (replaces the zonal harmonics), or nullptr
+		glm::dmat3 bodyFixedRotation{ 1.0 };				// Rotation from the body-fixed frame of the gravity field to the simulation frame, at the reference epoch
+		double rotationEpochET = 0.0;						// Reference epoch of the rotation, in Ephemeris Time
+	};
+
+
+	/* A body affected by the force models. */
+	struct Target {
+		uint32_t bodyIndex;						// Index of the body in the body store
+		uint32_t centralBody = NO_INDEX;		// Index of the dominant central body (in the central body list), or NO_INDEX
+		double ballisticFactor = 0.0;			// Cd * A / m (m^2/kg); 0 for bodies without drag properties
+		double radiationFactor = 0.0;			// Cr * A / m (m^2/kg); 0 for bodies without radiation properties
+	};
+
+
+	/* A perturbing point mass whose state is taken from ephemerides (rather than being part of the simulation). It moves linearly between ephemeris updates. */
+	struct ThirdBody {
+		glm::dvec3 position;		// Position in the simulation frame at the reference epoch (m)
+		glm::dvec3 velocity;		// Velocity in the simulation frame (m/s)
+		double epochET;				// Reference epoch, in Ephemeris Time
+		double gravParam;			// Gravitational parameter (m^3/s^2)
+	};
+
+
+
+	/* Computes the acceleration due to the zonal harmonics J2 to J<maxDegree> of a central body.
+		The acceleration of each term follows from the gradient of the zonal potential -mu/r Jn (R/r)^n Pn(sin(lat)), with the Legendre polynomials Pn and their derivatives evaluated by recursion.
+
+		@param relPosition: The position relative to the central body (m).
+		@param central: The central body.
+		@param maxDegree: The highest degree (at most Solvers::MAX_ZONAL_DEGREE).
+
+		@return The acceleration (m/s^2).
+	*/
+	inline glm::dvec3 ZonalHarmonics(const glm::dvec3 &relPosition, const CentralBody &central, int maxDegree) {
+		const double distanceSq = glm::dot(relPosition, relPosition);
+		if (distanceSq < central.equatRadius * central.equatRadius * 1e-4)
+			return glm::dvec3(0.0);		// Deep inside the body
+
+		const double distance = std::sqrt(distanceSq);
+		const glm::dvec3 radial = relPosition / distance;
+		const double u = glm::dot(radial, central.pole);		// sin(latitude)
+		const double ratio = central.equatRadius / distance;
+
+		double p0 = 1.0, p1 = u;				// P(n-2), P(n-1)
+		double dp1 = 1.0;						// P'(n-1)
+		double ratioPower = ratio;				// (R/r)^(n-1)
+
+		double radialSum = 0.0, polarSum = 0.0;
+
+		for (int n = 2; n <= maxDegree; n++) {
+			const double p = ((2 * n - 1) * u * p1 - (n - 1) * p0) / n;
+			const double dp = n * p1 + u * dp1;
+			ratioPower *= ratio;
+
+			const double jn = central.zonals[n] * ratioPower;
+			radialSum += jn * ((n + 1) * p + u * dp);
+			polarSum += jn * dp;
+
+			p0 = p1;
+			p1 = p;
+			dp1 = dp;
+		}
+
+		return (central.gravParam / distanceSq) * (radialSum * radial - polarSum * central.pole);
+	}
+
+
+	/* Computes the acceleration due to the spherical harmonic gravity field of a central body.
+		Between ephemeris updates, the body-fixed frame is assumed to spin uniformly about the pole.
+
+		@param relPosition: The position relative to the central body (m).
+		@param central: The central body (with a gravity field).
+		@param t: The time at which the acceleration is evaluated, in Ephemeris Time.
+
+		@return The acceleration (m/s^2).
+	*/
+	inline glm::dvec3 SphericalHarmonics(const glm::dvec3 &relPosition, const CentralBody &central, double t) {
+		const double angle = glm::dot(central.angularVelocity, central.pole) * (t - central.rotationEpochET);
+		const double cosAngle = std::cos(angle), sinAngle = std::sin(angle);
+
+		// Simulation frame -> body-fixed frame at the reference epoch -> body-fixed frame at t
+		const glm::dvec3 epochPosition = glm::transpose(central.bodyFixedRotation) * relPosition;
+		const glm::dvec3 bodyFixedPosition(
+			cosAngle * epochPosition.x + sinAngle * epochPosition.y,
+			-sinAngle * epochPosition.x + cosAngle * epochPosition.y,
+			epochPosition.z
+		);
+
+		const glm::dvec3 acceleration = central.gravityField->computeAcceleration(bodyFixedPosition);
+
+		return central.bodyFixedRotation * glm::dvec3(
+			cosAngle * acceleration.x - sinAngle * acceleration.y,
+			sinAngle * acceleration.x + cosAngle * acceleration.y,
+			acceleration.z
+		);
+	}
+
+
+	/* Computes the acceleration due to atmospheric drag on a cannonball (a sphere, or a body of constant attitude) in an atmosphere that co-rotates with its central body.
+		@param relPosition: The position relative to the central body (m).
+		@param relVelocity: The velocity relative to the central body (m/s).
+		@param central: The central body.
+		@param ballisticFactor: Cd * A / m (m^2/kg).
+
+		@return The acceleration (m/s^2).
+	*/
+	inline glm::dvec3 AtmosphericDrag(const glm::dvec3 &relPosition, const glm::dvec3 &relVelocity, const CentralBody &central, double ballisticFactor) {
+		const double distance = glm::length(relPosition);
+
+		// Altitude above the reference ellipsoid, to first order in the flattening
+		const double sinLatitude = glm::dot(relPosition, central.pole) / distance;
+		const double altitude = distance - central.equatRadius * (1.0 - central.flattening * sinLatitude * sinLatitude);
+
+		const double density = Atmosphere::ExponentialDensity(altitude);
+		if (density <= 0.0)
+			return glm::dvec3(0.0);
+
+		const glm::dvec3 airVelocity = relVelocity - glm::cross(central.angularVelocity, relPosition);
+		return -0.5 * density * ballisticFactor * glm::length(airVelocity) * airVelocity;
+	}
+
+
+	/* The apparent geometry of the Sun and an occulting body, as seen from a point (Montenbruck & Gill, Section 3.4.2). */
+	struct Occultation {
+		double sunRadius;			// Apparent radius of the Sun (rad)
+		double occulterRadius;		// Apparent radius of the occulting body (rad)
+		double separation;			// Apparent separation of their centers (rad)
+		bool isInside;				// Whether the point is inside the occulting body
+	};
+
+
+	/* Computes the apparent geometry of the Sun and an occulting body.
+		@param relPosition: The position relative to the occulting body (m).
+		@param relSunPosition: The position of the Sun relative to the occulting body (m).
+		@param occulterRadius: The radius of the occulting body (m).
+
+		@return The geometry.
+	*/
+	inline Occultation GetOccultation(const glm::dvec3 &relPosition, const glm::dvec3 &relSunPosition, double occulterRadius) {
+		const glm::dvec3 toSun = relSunPosition - relPosition;
+		const double sunDistance = glm::length(toSun);
+		const double distance = glm::length(relPosition);
+
+		if (distance <= occulterRadius)
+			return { 0.0, 0.0, 0.0, true };
+
+		return {
+			std::asin(std::min(1.0, SOLAR_RADIUS / sunDistance)),
+			std::asin(std::min(1.0, occulterRadius / distance)),
+			std::acos(std::clamp(-glm::dot(relPosition, toSun) / (distance * sunDistance), -1.0, 1.0)),
+			false
+		};
+	}
+
+
+	/* Computes the visible fraction of the solar disk from its apparent geometry with an occulting body (conical shadow model).
+		@param occultation: The geometry (see GetOccultation).
+
+		@return The visible fraction, from 0 (umbra) to 1 (full sunlight).
+	*/
+	inline double VisibleFraction(const Occultation &occultation) {
+		if (occultation.isInside)
+			return 0.0;
+
+		const double a = occultation.sunRadius;
+		const double b = occultation.occulterRadius;
+		const double c = occultation.separation;
+
+		if (c >= a + b)
+			return 1.0;		// No occultation
+		if (c <= b - a)
+			return 0.0;		// Total occultation
+		if (c <= a - b)
+			return 1.0 - (b * b) / (a * a);		// Annular occultation
+
+		// Partial occultation: area of the overlap of two circles
+		const double x = (c * c + a * a - b * b) / (2.0 * c);
+		const double y = std::sqrt(std::max(0.0, a * a - x * x));
+		const double overlap = a * a * std::acos(std::clamp(x / a, -1.0, 1.0)) + b * b * std::acos(std::clamp((c - x) / b, -1.0, 1.0)) - c * y;
+
+		return 1.0 - overlap / (std::numbers::pi * a * a);
+	}
+
+
+	/* Computes the fraction of the solar disk visible from a position, as occulted by a spherical body.
+		@param relPosition: The position relative to the occulting body (m).
+		@param relSunPosition: The position of the Sun relative to the occulting body (m).
+		@param occulterRadius: The radius of the occulting body (m).
+		@param model: The shadow model. The cylindrical model has no penumbra; the conical model accounts for the apparent sizes of the Sun and the occulting body (Montenbruck & Gill, Section 3.4.2).
+
+		@return The visible fraction, from 0 (umbra) to 1 (full sunlight).
+	*/
+	inline double ShadowFactor(const glm::dvec3 &relPosition, const glm::dvec3 &relSunPosition, double occulterRadius, Solvers::ShadowModel model) {
+		switch (model) {
+		case Solvers::ShadowModel::CYLINDRICAL: {
+			const glm::dvec3 sunDirection = glm::normalize(relSunPosition);
+			const double projection = glm::dot(relPosition, sunDirection);
+
+			if (projection >= 0.0)
+				return 1.0;		// On the day side
+
+			const glm::dvec3 perpendicular = relPosition - projection * sunDirection;
+			return (glm::dot(perpendicular, perpendicular) < occulterRadius * occulterRadius) ? 0.0 : 1.0;
+		}
+
+		case Solvers::ShadowModel::CONICAL:
+		default:
+			return VisibleFraction(GetOccultation(relPosition, relSunPosition, occulterRadius));
+		}
+	}
+
+
+	/* Computes the acceleration due to solar radiation pressure on a cannonball.
+		@param position: The position of the body (m).
+		@param sunPosition: The position of the Sun (m).
+		@param radiationFactor: Cr * A / m (m^2/kg).
+		@param shadowFactor: The visible fraction of the solar disk (see ShadowFactor).
+
+		@return The acceleration (m/s^2).
+	*/
+	inline glm::dvec3 SolarRadiationPressure(const glm::dvec3 &position, const glm::dvec3 &sunPosition, double radiationFactor, double shadowFactor) {
+		const glm::dvec3 fromSun = position - sunPosition;
+		const double distanceSq = glm::dot(fromSun, fromSun);
+		const double distance = std::sqrt(distanceSq);
+
+		const double pressure = SOLAR_PRESSURE_1AU * (PhysicsConst::AU * PhysicsConst::AU) / distanceSq;
+		return (shadowFactor * pressure * radiationFactor / distance) * fromSun;
+	}
+
+
+	/* Computes the acceleration due to a third-body point mass.
+		@param position: The position of the body (m).
+		@param thirdBodyPosition: The position of the third body (m).
+		@param gravParam: The gravitational parameter of the third body (m^3/s^2).
+		@param isOriginAccelerated: Whether the origin of the simulation frame is a body, which is itself accelerated by the third body. If so, the indirect term (the acceleration of the origin) is subtracted, unless the third body is the origin itself.
+
+		@return The acceleration (m/s^2).
+	*/
+	inline glm::dvec3 ThirdBodyPointMass(const glm::dvec3 &position, const glm::dvec3 &thirdBodyPosition, double gravParam, bool isOriginAccelerated) {
+		const glm::dvec3 toThirdBody = thirdBodyPosition - position;
+		const double distance = glm::length(toThirdBody);
+
+		glm::dvec3 acceleration(0.0);
+		if (distance >= std::numeric_limits<float>::epsilon())
+			acceleration = gravParam * toThirdBody / (distance * distance * distance);
+
+		if (isOriginAccelerated) {
+			// A third body at the origin is the origin body, which does not accelerate itself
+			const double originDistance = glm::length(thirdBodyPosition);
+			if (originDistance >= std::numeric_limits<float>::epsilon())
+				acceleration -= gravParam * thirdBodyPosition / (originDistance * originDistance * originDistance);
+		}
+
+		return acceleration;
+	}
+}
@@ -0,0 +1,368 @@
+/* GravityField.cpp - Spherical harmonic gravity field implementation.
+*/
+
+#include "GravityField.hpp"
+
+#include <array>
+#include <cmath>
+#include <chrono>
+#include <cctype>
+#include <limits>
+#include <cstdlib>
+#include <sstream>
+#include <fstream>
+#include <numbers>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+
+
+namespace {
+	/* Converts Fortran double-precision exponents (e.g., "0.48D-03") to C exponents ("0.48E-03"). */
+	void NormalizeExponents(std::string &line) {
+		for (size_t i = 1; i + 1 < line.size(); i++) {
+			if ((line[i] == 'D' || line[i] == 'd') && std::isdigit(static_cast<unsigned char>(line[i - 1]))
+				&& (line[i + 1] == '+' || line[i + 1] == '-' || std::isdigit(static_cast<unsigned char>(line[i + 1]))))
+				line[i] = 'E';
+		}
+	}
+
+
+	/* Parses a whole token as a number. */
+	bool ParseNumber(const std::string &token, double &value) {
+		char *end = nullptr;
+		value = std::strtod(token.c_str(), &end);
+		return !token.empty() && end == token.c_str() + token.size();
+	}
+}
+
+
+
+void GravityField::load(const std::string &filePath, int maxDegree, double gravParam, double radius) {
+	std::ifstream file(filePath);
+	if (!file.is_open())
+		throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot open gravity field file " + enquote(filePath) + "!");
+
+	if (maxDegree < 0 || maxDegree > MAX_DEGREE)
+		maxDegree = MAX_DEGREE;
+
+	m_gravParam = gravParam;
+	m_radius = radius;
+
+
+	struct Coefficient {
+		int n, m;
+		double C, S;
+	};
+	std::vector<Coefficient> coefficients;
+	int loadedDegree = -1;
+	int fileDegree = -1;
+
+	std::string line;
+	size_t lineNumber = 0;
+
+	while (std::getline(file, line)) {
+		lineNumber++;
+		NormalizeExponents(line);
+
+		std::istringstream stream(line);
+		std::vector<std::string> tokens;
+		for (std::string token; stream >> token; )
+			tokens.push_back(token);
+
+		if (tokens.empty())
+			continue;
+
+
+		// ICGEM header keywords
+		double headerValue;
+		if (tokens.size() >= 2 && ParseNumber(tokens[1], headerValue)) {
+			if (tokens[0] == "earth_gravity_constant" || tokens[0] == "gravity_constant") {
+				m_gravParam = headerValue;
+				continue;
+			}
+			if (tokens[0] == "radius") {
+				m_radius = headerValue;
+				continue;
+			}
+		}
+		if (tokens.size() >= 2 && tokens[0] == "norm" && tokens[1] != "fully_normalized")
+			throw Log::RuntimeException(__FUNCTION__, __LINE__, "Gravity field file " + enquote(filePath) + " is not fully normalized!");
+
+		// ICGEM data keywords
+		if (tokens[0] == "gfc" || tokens[0] == "gfct")
+			tokens.erase(tokens.begin());
+
+
+		// Coefficients: n m C S [...]
+		double n, m, C, S;
+		if (tokens.size() < 4 || !ParseNumber(tokens[0], n) || !ParseNumber(tokens[1], m) || !ParseNumber(tokens[2], C) || !ParseNumber(tokens[3], S))
+			continue;		// Header or comment line
+
+		if (n != std::floor(n) || m != std::floor(m) || m < 0 || m > n)
+			throw Log::RuntimeException(__FUNCTION__, __LINE__, "Invalid degree/order on line " + std::to_string(lineNumber) + " of gravity field file " + enquote(filePath) + "!");
+
+		fileDegree = std::max(fileDegree, static_cast<int>(n));
+
+		if (n < 2 || n > maxDegree)
+			continue;
+
+		coefficients.push_back(Coefficient{ static_cast<int>(n), static_cast<int>(m), C, S });
+		loadedDegree = std::max(loadedDegree, static_cast<int>(n));
+	}
+
+	if (loadedDegree < 2)
+		throw Log::RuntimeException(__FUNCTION__, __LINE__, "Gravity field file " + enquote(filePath) + " does not contain any coefficients of degree 2 or above!");
+
+	if (fileDegree > MAX_DEGREE)
+		Log::Print(Log::T_WARNING, __FUNCTION__, "Gravity field " + enquote(filePath) + " is of degree " + std::to_string(fileDegree) + ", and has been truncated to degree " + std::to_string(MAX_DEGREE) + ".");
+
+
+	// Store coefficients by column
+	m_maxDegree = loadedDegree;
+	precomputeFactors();
+
+	for (const Coefficient &coefficient : coefficients) {
+		m_C[index(coefficient.n, coefficient.m)] = coefficient.C;
+		m_S[index(coefficient.n, coefficient.m)] = coefficient.S;
+	}
+
+	setTruncation(-1, -1);
+
+	Log::Print(Log::T_INFO, __FUNCTION__, "Loaded gravity field " + enquote(filePath) + " up to degree and order " + std::to_string(m_maxDegree) + ".");
+}
+
+
+void GravityField::precomputeFactors() {
+	const int N = m_maxDegree;
+
+	// Column offsets: column m holds degrees m..N (including the unused degrees 0 and 1, so that indexing is uniform)
+	m_columnOffsets.resize(N + 2);
+	m_columnOffsets[0] = 0;
+	for (int m = 0; m <= N; m++)
+		m_columnOffsets[m + 1] = m_columnOffsets[m] + static_cast<size_t>(N - m + 1);
+
+	const size_t elementCount = m_columnOffsets[N + 1];
+	m_C.assign(elementCount, 0.0);
+	m_S.assign(elementCount, 0.0);
+	m_alpha.assign(elementCount, 0.0);
+	m_beta.assign(elementCount, 0.0);
+	m_derivFactors.assign(elementCount, 0.0);
+
+
+	// Sectoral factors: A(1, 1) = sqrt(3) A(0, 0); A(m, m) = sqrt((2m + 1) / 2m) A(m-1, m-1)
+	m_sectoralFactors.assign(N + 1, 0.0);
+	m_sectoralFactors[0] = 1.0;
+	if (N >= 1)
+		m_sectoralFactors[1] = std::numbers::sqrt3;
+	for (int m = 2; m <= N; m++)
+		m_sectoralFactors[m] = std::sqrt((2.0 * m + 1.0) / (2.0 * m));
+
+
+	for (int m = 0; m <= N; m++) {
+		for (int n = m + 1; n <= N; n++) {
+			const size_t i = index(n, m);
+			const double nd = n, md = m;
+
+			// Column recursion (beta vanishes for n = m + 1, where A(n-2, m) = 0)
+			m_alpha[i] = std::sqrt((2.0 * nd - 1.0) * (2.0 * nd + 1.0) / ((nd - md) * (nd + md)));
+			if (n >= m + 2)
+				m_beta[i] = std::sqrt((2.0 * nd + 1.0) * (nd + md - 1.0) * (nd - md - 1.0) / ((nd - md) * (nd + md) * (2.0 * nd - 3.0)));
+
+			// Derivative: ratio of the normalization factors of (n, m) and (n, m+1)
+			m_derivFactors[i] = std::sqrt((m == 0 ? 0.5 : 1.0) * (nd - md) * (nd + md + 1.0));
+		}
+	}
+}
+
+
+void GravityField::setTruncation(int degree, int order) {
+	m_degree = (degree < 0) ? m_maxDegree : std::min(degree, m_maxDegree);
+	m_order = (order < 0) ? m_degree : std::min(order, m_degree);
+}
+
+
+size_t GravityField::GetTermCount(int degree, int order) {
+	size_t terms = 0;
+	for (int n = 2; n <= degree; n++)
+		terms += static_cast<size_t>(std::min(n, order) + 1);
+
+	return terms;
+}
+
+
+glm::dvec3 GravityField::computeAcceleration(const glm::dvec3 &bodyFixedPosition) const {
+	return evaluate(bodyFixedPosition, m_degree, m_order);
+}
+
+
+glm::dvec3 GravityField::evaluate(const glm::dvec3 &bodyFixedPosition, int degree, int order) const {
+	/* With the direction cosines (s, t, u) and rho = R/r, the potential is
+			U = mu/r * sum_n rho^n * sum_m A(n, m)(u) * (C(n, m) * Re[(s + it)^m] + S(n, m) * Im[(s + it)^m]),
+		where A(n, m) are the normalized derived Legendre functions (Helmholtz polynomials).
+		Treating (r, s, t, u) as independent variables, grad U = dU/dr * r_hat + (grad_stu U - (s, t, u) . grad_stu U * r_hat) / r.
+	*/
+	if (degree < 2)
+		return glm::dvec3(0.0);
+
+	const double r = glm::length(bodyFixedPosition);
+	if (r < m_radius * 1e-2)
+		return glm::dvec3(0.0);		// Deep inside the body
+
+	const glm::dvec3 direction = bodyFixedPosition / r;
+	const double s = direction.x, t = direction.y, u = direction.z;
+	const double rho = m_radius / r;
+
+	// The columns hold rho^n * A(n, m), so that the recursions also carry the powers of rho
+	const double uRho = u * rho;
+	const double rhoSq = rho * rho;
+
+
+	// Two adjacent columns: the current column, and the next one (for the u-derivatives of the current column)
+	std::array<double, MAX_DEGREE + 2> columnBuffers[2];
+	double *column = columnBuffers[0].data();
+	double *nextColumn = columnBuffers[1].data();
+
+	// Column 0
+	column[0] = 1.0;
+	column[1] = m_alpha[1] * uRho;
+	for (int n = 2; n <= degree; n++)
+		column[n] = m_alpha[n] * uRho * column[n - 1] - m_beta[n] * rhoSq * column[n - 2];
+
+
+	double radialSum = 0.0;
+	glm::dvec3 stuGradient(0.0);		// Gradient with respect to (s, t, u), without the mu/r^2 factor
+
+	double realPower = 1.0, imagPower = 0.0;			// Re/Im[(s + it)^m]
+	double prevRealPower = 0.0, prevImagPower = 0.0;	// Re/Im[(s + it)^(m-1)]
+
+	for (int m = 0; m <= order; m++) {
+		const size_t base = m_columnOffsets[m] - m;
+		const size_t nextBase = m_columnOffsets[m + 1] - (m + 1);
+
+		double sumC = 0.0, sumS = 0.0;				// sum rho^n A C, sum rho^n A S
+		double sumRadialC = 0.0, sumRadialS = 0.0;	// sum (n + 1) rho^n A C, ...
+		double sumDerivC = 0.0, sumDerivS = 0.0;	// sum rho^n dA/du C, ...
+
+		// The sectoral term has no u-derivative
+		if (m >= 2) {
+			const double C = m_C[base + m], S = m_S[base + m];
+
+			sumC = C * column[m];
+			sumS = S * column[m];
+			sumRadialC = (m + 1) * sumC;
+			sumRadialS = (m + 1) * sumS;
+		}
+
+		// The next column is computed alongside the current one, so that their recursions overlap
+		if (m + 1 <= degree)
+			nextColumn[m + 1] = m_sectoralFactors[m + 1] * rho * column[m];
+
+		for (int n = m + 1; n <= degree; n++) {
+			if (n >= m + 3)
+				nextColumn[n] = m_alpha[nextBase + n] * uRho * nextColumn[n - 1] - m_beta[nextBase + n] * rhoSq * nextColumn[n - 2];
+			else if (n == m + 2)
+				nextColumn[n] = m_alpha[nextBase + n] * uRho * nextColumn[n - 1];
+
+			if (n < 2)
+				continue;
+
+			const double A = column[n];
+			const double derivA = m_derivFactors[base + n] * nextColumn[n];
+			const double C = m_C[base + n], S = m_S[base + n];
+
+			sumC += C * A;
+			sumS += S * A;
+			sumRadialC += (n + 1) * C * A;
+			sumRadialS += (n + 1) * S * A;
+			sumDerivC += C * derivA;
+			sumDerivS += S * derivA;
+		}
+
+		radialSum -= sumRadialC * realPower + sumRadialS * imagPower;
+		stuGradient.x += m * (sumC * prevRealPower + sumS * prevImagPower);
+		stuGradient.y += m * (sumS * prevRealPower - sumC * prevImagPower);
+		stuGradient.z += sumDerivC * realPower + sumDerivS * imagPower;
+
+
+		// Advance to the next column
+		prevRealPower = realPower;
+		prevImagPower = imagPower;
+		realPower = s * prevRealPower - t * prevImagPower;
+		imagPower = s * prevImagPower + t * prevRealPower;
+
+		std::swap(column, nextColumn);
+	}
+
+
+	const double scale = m_gravParam / (r * r);
+	return scale * ((radialSum - glm::dot(direction, stuGradient)) * direction + stuGradient);
+}
+
+
+std::vector<GravityField::CostReport> GravityField::profile(const std::vector<std::pair<int, int>> &truncations, double sampleRadius, size_t sampleCount) const {
+	using Clock = std::chrono::steady_clock;
+	static constexpr double MIN_BENCHMARK_DURATION = 0.02;		// Minimum duration of each benchmark (s)
+
+	sampleCount = std::max<size_t>(sampleCount, 1);
+
+	// Sample positions: Fibonacci lattice on the sphere
+	std::vector<glm::dvec3> samples(sampleCount);
+	std::vector<glm::dvec3> reference(sampleCount);
+
+	const double goldenAngle = std::numbers::pi * (3.0 - std::sqrt(5.0));
+	for (size_t i = 0; i < sampleCount; i++) {
+		const double z = 1.0 - 2.0 * (i + 0.5) / sampleCount;
+		const double ringRadius = std::sqrt(1.0 - z * z);
+		const double angle = goldenAngle * i;
+
+		samples[i] = sampleRadius * glm::dvec3(ringRadius * std::cos(angle), ringRadius * std::sin(angle), z);
+		reference[i] = evaluate(samples[i], m_degree, m_order);
+	}
+
+
+	std::vector<CostReport> reports;
+	reports.reserve(truncations.size());
+
+	for (auto [degree, order] : truncations) {
+		degree = std::min(degree, m_degree);
+		order = std::clamp(order, 0, degree);
+
+		CostReport report{
+			.degree = degree,
+			.order = order,
+			.terms = GetTermCount(degree, order),
+			.nsPerCall = 0.0,
+			.maxDeviation = 0.0
+		};
+
+		for (size_t i = 0; i < sampleCount; i++)
+			report.maxDeviation = std::max(report.maxDeviation, glm::length(evaluate(samples[i], degree, order) - reference[i]));
+
+
+		// Evaluate the sample positions repeatedly until the benchmark is long enough to be timed reliably
+		size_t calls = 0;
+		glm::dvec3 sink(0.0);
+		const Clock::time_point start = Clock::now();
+		double elapsed = 0.0;
+
+		do {
+			for (size_t i = 0; i < sampleCount; i++)
+				sink += evaluate(samples[i], degree, order);
+
+			calls += sampleCount;
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		} while (elapsed < MIN_BENCHMARK_DURATION);
+
+		report.nsPerCall = elapsed * 1e9 / calls;
+
+		// Keep the benchmark from being optimized away
+		if (!std::isfinite(sink.x))
+			report.nsPerCall = std::numeric_limits<double>::quiet_NaN();
+
+		reports.push_back(report);
+	}
+
+	return reports;
+}
@@ -0,0 +1,121 @@
+/* GravityField.hpp - Spherical harmonic gravity field of a central body (e.g., EGM96, EGM2008).
+	Sources:
+		- S. Pines, "Uniform Representation of the Gravitational Potential and its Derivatives", AIAA Journal 11(11), 1973.
+		- R. Eckman, A. Brown and D. Adamo, "Normalization and Implementation of Three Gravitational Acceleration Models", NASA/TP-2016-218604.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+
+#include <Platform/External/GLM.hpp>
+
+
+/* A spherical harmonic gravity field, evaluated with the fully normalized Pines recursion.
+	The Pines formulation expresses the field in Cartesian direction cosines rather than latitude and longitude, so it has no singularity at the poles, and the normalized recursions stay accurate to high degrees.
+	Normalization and recursion factors are computed once, when the coefficients are loaded.
+*/
+class GravityField {
+public:
+	/* The cost of evaluating a truncation of the field. */
+	struct CostReport {
+		int degree;
+		int order;
+		size_t terms;				// Number of (n, m) terms
+		double nsPerCall;			// Measured evaluation time (ns/call)
+		double maxDeviation;		// Largest deviation from the full field over the sample positions (m/s^2)
+	};
+
+
+	GravityField() = default;
+	~GravityField() = default;
+
+
+	/* Loads fully normalized coefficients from a file.
+		Supported formats are the NGA EGM96/EGM2008 coefficient files (lines of "n m Cnm Snm [sigmaC sigmaS]", with E or D exponents), and ICGEM .gfc files (whose header may override the gravitational parameter and reference radius).
+		Terms of degree 0 and 1 are ignored: the central point mass is accounted for by the gravity solver.
+
+		@param filePath: The path to the coefficient file.
+		@param maxDegree (optional): The highest degree to load. If negative, every degree in the file (up to MAX_DEGREE) is loaded.
+		@param gravParam (optional): The gravitational parameter of the field (m^3/s^2). Defaults to that of EGM96/EGM2008.
+		@param radius (optional): The reference radius of the field (m). Defaults to that of EGM96/EGM2008.
+	*/
+	void load(const std::string &filePath, int maxDegree = -1, double gravParam = EGM_GRAV_PARAM, double radius = EGM_RADIUS);
+
+
+	/* Truncates the evaluated field.
+		@param degree: The highest degree (at most the loaded degree). If negative, the loaded degree is used.
+		@param order: The highest order (at most the degree). If negative, the degree is used.
+	*/
+	void setTruncation(int degree, int order = -1);
+
+
+	/* Computes the acceleration due to the non-spherical terms (degree 2 and above) of the truncated field.
+		@param bodyFixedPosition: The position in the body-fixed frame of the field (m).
+
+		@return The acceleration in the body-fixed frame (m/s^2).
+	*/
+	glm::dvec3 computeAcceleration(const glm::dvec3 &bodyFixedPosition) const;
+
+
+	/* Measures the cost and accuracy of truncations of the field.
+		@param truncations: The (degree, order) pairs to measure. Pairs beyond the loaded degree are clamped.
+		@param sampleRadius: The distance from the center of the body of the sample positions (m).
+		@param sampleCount: The number of sample positions (spread uniformly over the sphere).
+
+		@return The cost report of each truncation. Deviations are measured against the current truncation.
+	*/
+	std::vector<CostReport> profile(const std::vector<std::pair<int, int>> &truncations, double sampleRadius, size_t sampleCount = 1000) const;
+
+
+	/* Gets the number of terms of a truncation of the field. */
+	static size_t GetTermCount(int degree, int order);
+
+
+	inline bool isLoaded() const { return m_maxDegree >= 2; }
+
+	inline int getMaxDegree() const { return m_maxDegree; }
+	inline int getDegree() const { return m_degree; }
+	inline int getOrder() const { return m_order; }
+
+	inline double getGravParam() const { return m_gravParam; }
+	inline double getRadius() const { return m_radius; }
+
+
+	static constexpr int MAX_DEGREE = 360;							// Highest supported degree
+
+	static constexpr double EGM_GRAV_PARAM = 3.986004415e+14;		// Gravitational parameter of EGM96/EGM2008 (m^3/s^2)
+	static constexpr double EGM_RADIUS = 6378136.3;					// Reference radius of EGM96/EGM2008 (m)
+
+private:
+	int m_maxDegree = -1;			// Highest loaded degree
+	int m_degree = -1;				// Highest evaluated degree
+	int m_order = -1;				// Highest evaluated order
+
+	double m_gravParam = EGM_GRAV_PARAM;
+	double m_radius = EGM_RADIUS;
+
+	/* Coefficients and recursion factors are stored column by column (order-major), in the order in which the recursion visits them.
+		The element (n, m) is at m_columnOffsets[m] + (n - m).
+	*/
+	std::vector<size_t> m_columnOffsets;
+	std::vector<double> m_C, m_S;				// Fully normalized coefficients
+	std::vector<double> m_alpha, m_beta;		// Column recursion factors: A(n, m) = alpha * u * A(n-1, m) - beta * A(n-2, m)
+	std::vector<double> m_derivFactors;			// dA(n, m)/du = factor * A(n, m+1)
+	std::vector<double> m_sectoralFactors;		// A(m, m) = factor * A(m-1, m-1)
+
+
+	/* Gets the index of an element in the column-major arrays. */
+	inline size_t index(int n, int m) const { return m_columnOffsets[m] + static_cast<size_t>(n - m); }
+
+
+	/* Computes the normalization and recursion factors. */
+	void precomputeFactors();
+
+
+	/* Computes the acceleration of a truncation of the field. */
+	glm::dvec3 evaluate(const glm::dvec3 &bodyFixedPosition, int degree, int order) const;
+};
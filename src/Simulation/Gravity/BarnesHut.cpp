@@ -0,0 +1,182 @@
+/* BarnesHut.cpp - Barnes-Hut octree implementation.
+*/
+
+#include "BarnesHut.hpp"
+
+
+void BarnesHutTree::build(const std::vector<glm::dvec3> &positions, const std::vector<double> &gravParams) {
+	LOG_ASSERT(positions.size() == gravParams.size(), "Cannot build Barnes-Hut tree: Body positions and gravitational parameters are not parallel!");
+
+	m_positions = positions;
+	m_gravParams = gravParams;
+
+	const uint32_t bodyCount = static_cast<uint32_t>(m_positions.size());
+
+	m_nodes.clear();
+	m_order.resize(bodyCount);
+	m_slot.resize(bodyCount);
+	for (uint32_t i = 0; i < bodyCount; i++)
+		m_order[i] = i;
+
+	if (bodyCount == 0)
+		return;
+
+
+	// Compute the root cube (the bounding box of all bodies, expanded to a cube)
+	glm::dvec3 minBound = m_positions[0];
+	glm::dvec3 maxBound = m_positions[0];
+	for (const glm::dvec3 &position : m_positions) {
+		minBound = glm::min(minBound, position);
+		maxBound = glm::max(maxBound, position);
+	}
+
+	const glm::dvec3 extent = maxBound - minBound;
+	const double halfSize = 0.5 * std::max({ extent.x, extent.y, extent.z }) * (1.0 + 1e-9) + std::numeric_limits<float>::epsilon();
+
+	m_nodes.reserve(2 * (bodyCount / LEAF_CAPACITY + 1));
+	buildNode(0.5 * (minBound + maxBound), halfSize, 0, bodyCount, 0);
+
+
+	for (uint32_t i = 0; i < bodyCount; i++)
+		m_slot[m_order[i]] = i;
+}
+
+
+uint32_t BarnesHutTree::buildNode(const glm::dvec3 &center, double halfSize, uint32_t first, uint32_t count, uint32_t depth) {
+	const uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+	m_nodes.emplace_back();
+
+	// Compute monopole (total GM and center of mass)
+	double gravParam = 0.0;
+	glm::dvec3 weightedPosition(0.0);
+	for (uint32_t i = first; i < first + count; i++) {
+		const uint32_t body = m_order[i];
+		gravParam += m_gravParams[body];
+		weightedPosition += m_gravParams[body] * m_positions[body];
+	}
+
+	{
+		_Node &node = m_nodes[nodeIndex];
+		node.center = center;
+		node.halfSize = halfSize;
+		node.gravParam = gravParam;
+		node.centerOfMass = (gravParam > 0.0) ? (weightedPosition / gravParam) : center;
+		node.comOffset = glm::length(node.centerOfMass - center);
+		node.first = first;
+		node.count = count;
+		node.isLeaf = (count <= LEAF_CAPACITY || depth >= MAX_DEPTH);
+		std::fill(std::begin(node.children), std::end(node.children), NO_CHILD);
+
+		if (node.isLeaf)
+			return nodeIndex;
+	}
+
+
+	// Partition the node's bodies into octants (counting sort, so each octant owns a contiguous range of m_order)
+	auto octantOf = [&](uint32_t body) {
+		const glm::dvec3 &position = m_positions[body];
+		return static_cast<uint32_t>(position.x >= center.x)
+			| (static_cast<uint32_t>(position.y >= center.y) << 1)
+			| (static_cast<uint32_t>(position.z >= center.z) << 2);
+	};
+
+	uint32_t octantCounts[8] = {};
+	for (uint32_t i = first; i < first + count; i++)
+		octantCounts[octantOf(m_order[i])]++;
+
+	uint32_t octantFirsts[8]{};
+	for (uint32_t octant = 1; octant < 8; octant++)
+		octantFirsts[octant] = octantFirsts[octant - 1] + octantCounts[octant - 1];
+
+	std::vector<uint32_t> partitioned(count);
+	{
+		uint32_t cursors[8];
+		std::copy(std::begin(octantFirsts), std::end(octantFirsts), std::begin(cursors));
+
+		for (uint32_t i = first; i < first + count; i++) {
+			const uint32_t body = m_order[i];
+			partitioned[cursors[octantOf(body)]++] = body;
+		}
+	}
+	std::copy(partitioned.begin(), partitioned.end(), m_order.begin() + first);
+
+
+	// Recursively build child nodes
+	const double childHalfSize = 0.5 * halfSize;
+	for (uint32_t octant = 0; octant < 8; octant++) {
+		if (octantCounts[octant] == 0)
+			continue;
+
+		const glm::dvec3 childCenter = center + childHalfSize * glm::dvec3(
+			(octant & 1) ? 1.0 : -1.0,
+			(octant & 2) ? 1.0 : -1.0,
+			(octant & 4) ? 1.0 : -1.0
+		);
+
+		// NOTE: m_nodes may reallocate during recursion, so the child index must be written through the node index.
+		const uint32_t child = buildNode(childCenter, childHalfSize, first + octantFirsts[octant], octantCounts[octant], depth + 1);
+		m_nodes[nodeIndex].children[octant] = child;
+	}
+
+	return nodeIndex;
+}
+
+
+glm::dvec3 BarnesHutTree::computeAcceleration(const glm::dvec3 &position, uint32_t excludedBody) const {
+	glm::dvec3 acceleration(0.0);
+	if (m_nodes.empty())
+		return acceleration;
+
+	const uint32_t excludedSlot = (excludedBody != NO_BODY) ? m_slot[excludedBody] : NO_BODY;
+	static constexpr double MIN_DISTANCE = std::numeric_limits<float>::epsilon();
+
+
+	// Iterative depth-first traversal (at most 7 siblings are deferred per level)
+	uint32_t stack[7 * MAX_DEPTH + 8];
+	uint32_t stackSize = 0;
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0) {
+		const _Node &node = m_nodes[stack[--stackSize]];
+
+		const bool containsExcluded = (excludedSlot >= node.first && excludedSlot < node.first + node.count);
+
+		if (node.isLeaf) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				if (i == excludedSlot)
+					continue;
+
+				const uint32_t body = m_order[i];
+				const glm::dvec3 relativePos = position - m_positions[body];
+				const double distance = glm::length(relativePos);
+
+				if (distance >= MIN_DISTANCE)
+					acceleration += -m_gravParams[body] * relativePos / (distance * distance * distance);
+			}
+
+			continue;
+		}
+
+
+		const glm::dvec3 relativePos = position - node.centerOfMass;
+		const double distanceSq = glm::dot(relativePos, relativePos);
+		const double size = 2.0 * node.halfSize;
+
+		// Opening criterion: Approximate the node by its monopole if it is sufficiently far away (size / (distance - comOffset) < theta).
+		// A node containing the excluded body is always opened, so that a body never attracts itself.
+		const double distance = std::sqrt(distanceSq);
+
+		if (!containsExcluded && size + m_theta * node.comOffset < m_theta * distance) {
+			if (distance >= MIN_DISTANCE)
+				acceleration += -node.gravParam * relativePos / (distanceSq * distance);
+
+			continue;
+		}
+
+		for (uint32_t child : node.children)
+			if (child != NO_CHILD)
+				stack[stackSize++] = child;
+	}
+
+	return acceleration;
+}
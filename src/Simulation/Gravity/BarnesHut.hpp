@@ -0,0 +1,91 @@
+/* BarnesHut.hpp - Implementation of a Barnes-Hut octree for approximate N-body gravity.
+	Sources:
+		- J. Barnes and P. Hut, "A hierarchical O(N log N) force-calculation algorithm", Nature 324 (1986).
+*/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+
+#include <Core/Data/Constants.h>
+#include <Core/Application/IO/LoggingManager.hpp>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Data/Solvers.hpp>
+
+
+class BarnesHutTree {
+public:
+	BarnesHutTree() = default;
+	~BarnesHutTree() = default;
+
+
+	/* Builds the octree over a set of bodies. This should be done once per step, before any acceleration queries.
+		@param positions: The positions of the bodies.
+		@param gravParams: The standard gravitational parameters (GM) of the bodies. Must be parallel to `positions`.
+	*/
+	void build(const std::vector<glm::dvec3> &positions, const std::vector<double> &gravParams);
+
+
+	/* Computes the gravitational acceleration at a given position.
+		@param position: The position at which the acceleration is evaluated.
+		@param excludedBody: The index of a body whose contribution is ignored (usually the body being integrated), or NO_BODY.
+
+		@return The acceleration at the given position.
+	*/
+	glm::dvec3 computeAcceleration(const glm::dvec3 &position, uint32_t excludedBody = NO_BODY) const;
+
+
+	/* Sets the opening angle (theta).
+		A node is approximated by its center of mass if (node size / distance) < theta, where the distance is reduced by the center of mass' offset from the node's center (Barnes' modified criterion, which avoids large errors for nodes whose mass is concentrated near an edge). A theta of 0 degenerates to direct summation.
+	*/
+	inline void setOpeningAngle(double theta) { m_theta = theta; }
+
+	/* Gets the opening angle (theta). */
+	inline double getOpeningAngle() const { return m_theta; }
+
+
+	/* Gets the number of nodes in the tree. */
+	inline size_t getNodeCount() const { return m_nodes.size(); }
+
+
+	static constexpr uint32_t NO_BODY = UINT32_MAX;
+
+private:
+	static constexpr uint32_t NO_CHILD = UINT32_MAX;
+	static constexpr uint32_t LEAF_CAPACITY = 8;		// Maximum bodies per leaf before it is subdivided
+	static constexpr uint32_t MAX_DEPTH = 48;			// Bodies at (near-)identical positions stop being subdivided past this depth
+
+	struct _Node {
+		glm::dvec3 center;				// Geometric center of the node's cube
+		double halfSize;				// Half of the cube's edge length
+
+		glm::dvec3 centerOfMass;
+		double gravParam;				// Total GM of all bodies in this node
+		double comOffset;				// Distance between the center of mass and the geometric center
+
+		uint32_t first;					// Index of the node's first body in m_order
+		uint32_t count;					// Number of bodies in the node
+		uint32_t children[8];
+		bool isLeaf;
+	};
+
+	std::vector<_Node> m_nodes;
+	std::vector<uint32_t> m_order;		// Body indices, ordered so that each node owns a contiguous range
+	std::vector<uint32_t> m_slot;		// Inverse of m_order (body index -> position in m_order)
+
+	std::vector<glm::dvec3> m_positions;
+	std::vector<double> m_gravParams;
+
+	double m_theta = Solvers::DEFAULT_OPENING_ANGLE;
+
+
+	/* Recursively subdivides a node. */
+	uint32_t buildNode(const glm::dvec3 &center, double halfSize, uint32_t first, uint32_t count, uint32_t depth);
+};
@@ -0,0 +1,478 @@
+/* GravityKernels.cpp - Scalar and SIMD direct-sum gravity kernels.
+*/
+
+#include "GravityKernels.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define GRAVITY_KERNELS_X86
+
+	#include <immintrin.h>
+
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define KERNEL_TARGET(isa)		// MSVC does not require per-function target attributes to emit AVX2/AVX-512 intrinsics
+	#else
+		#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+	#endif
+#endif
+
+
+namespace {
+	// Bodies closer than this distance are ignored (see ODE::NewtonianNBody)
+	constexpr double MIN_DISTANCE = std::numeric_limits<float>::epsilon();
+	constexpr double MIN_DISTANCE_SQ = MIN_DISTANCE * MIN_DISTANCE;
+
+
+	/* Accumulates the acceleration at (px, py, pz) due to bodies [first, last). */
+	inline void AccumulateScalar(const NBodyStore &store, size_t first, size_t last, double px, double py, double pz, double &ax, double &ay, double &az) {
+		const double *x = store.x.data(), *y = store.y.data(), *z = store.z.data(), *mu = store.mu.data();
+
+		for (size_t j = first; j < last; j++) {
+			const double dx = x[j] - px;
+			const double dy = y[j] - py;
+			const double dz = z[j] - pz;
+			const double distanceSq = dx * dx + dy * dy + dz * dz;
+
+			if (distanceSq >= MIN_DISTANCE_SQ) {
+				const double factor = mu[j] / (distanceSq * std::sqrt(distanceSq));
+				ax += factor * dx;
+				ay += factor * dy;
+				az += factor * dz;
+			}
+		}
+	}
+
+
+	void Accumulate_Scalar(const NBodyStore &store, size_t first, size_t last, const glm::dvec3 &position, glm::dvec3 &acceleration) {
+		AccumulateScalar(store, first, last, position.x, position.y, position.z, acceleration.x, acceleration.y, acceleration.z);
+	}
+
+
+	/* Accumulates the pairwise interactions between body i and bodies [first, last) into both parties (Newton's third law). The reactions on bodies [first, last) are accumulated into (ax, ay, az). */
+	inline void AccumulatePairsScalar(const NBodyStore &store, size_t i, size_t first, size_t last, double &aix, double &aiy, double &aiz, double *ax, double *ay, double *az) {
+		const double *x = store.x.data(), *y = store.y.data(), *z = store.z.data(), *mu = store.mu.data();
+
+		for (size_t j = first; j < last; j++) {
+			const double dx = x[j] - x[i];
+			const double dy = y[j] - y[i];
+			const double dz = z[j] - z[i];
+			const double distanceSq = dx * dx + dy * dy + dz * dz;
+
+			if (distanceSq >= MIN_DISTANCE_SQ) {
+				const double invDistanceCubed = 1.0 / (distanceSq * std::sqrt(distanceSq));
+				const double factorI = mu[j] * invDistanceCubed;
+				const double factorJ = mu[i] * invDistanceCubed;
+
+				aix += factorI * dx;
+				aiy += factorI * dy;
+				aiz += factorI * dz;
+
+				ax[j] -= factorJ * dx;
+				ay[j] -= factorJ * dy;
+				az[j] -= factorJ * dz;
+			}
+		}
+	}
+
+
+	void AccumulatePairs_Scalar(const NBodyStore &store, size_t i, double *ax, double *ay, double *az) {
+		double aix = 0.0, aiy = 0.0, aiz = 0.0;
+		AccumulatePairsScalar(store, i, i + 1, store.size(), aix, aiy, aiz, ax, ay, az);
+
+		ax[i] += aix;
+		ay[i] += aiy;
+		az[i] += aiz;
+	}
+
+
+#ifdef GRAVITY_KERNELS_X86
+	KERNEL_TARGET("avx2,fma")
+	inline double HorizontalSum_AVX2(__m256d v) {
+		const __m128d low = _mm256_castpd256_pd128(v);
+		const __m128d high = _mm256_extractf128_pd(v, 1);
+		const __m128d sum = _mm_add_pd(low, high);
+
+		return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+	}
+
+
+	KERNEL_TARGET("avx2,fma")
+	void Accumulate_AVX2(const NBodyStore &store, size_t first, size_t last, const glm::dvec3 &position, glm::dvec3 &acceleration) {
+		static constexpr size_t LANES = 4;
+
+		const double *x = store.x.data(), *y = store.y.data(), *z = store.z.data(), *mu = store.mu.data();
+		const size_t vectorLast = first + (last - first) / LANES * LANES;
+
+		const __m256d px = _mm256_set1_pd(position.x);
+		const __m256d py = _mm256_set1_pd(position.y);
+		const __m256d pz = _mm256_set1_pd(position.z);
+		const __m256d minDistanceSq = _mm256_set1_pd(MIN_DISTANCE_SQ);
+
+		__m256d ax = _mm256_setzero_pd();
+		__m256d ay = _mm256_setzero_pd();
+		__m256d az = _mm256_setzero_pd();
+
+		for (size_t j = first; j < vectorLast; j += LANES) {
+			const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + j), px);
+			const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + j), py);
+			const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(z + j), pz);
+
+			const __m256d distanceSq = _mm256_fmadd_pd(dz, dz, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx)));
+			const __m256d mask = _mm256_cmp_pd(distanceSq, minDistanceSq, _CMP_GE_OQ);
+
+			// Lanes that fail the distance check divide by zero, but are masked out afterwards
+			const __m256d factor = _mm256_and_pd(mask,
+				_mm256_div_pd(_mm256_loadu_pd(mu + j), _mm256_mul_pd(distanceSq, _mm256_sqrt_pd(distanceSq)))
+			);
+
+			ax = _mm256_fmadd_pd(factor, dx, ax);
+			ay = _mm256_fmadd_pd(factor, dy, ay);
+			az = _mm256_fmadd_pd(factor, dz, az);
+		}
+
+		acceleration.x += HorizontalSum_AVX2(ax);
+		acceleration.y += HorizontalSum_AVX2(ay);
+		acceleration.z += HorizontalSum_AVX2(az);
+		AccumulateScalar(store, vectorLast, last, position.x, position.y, position.z, acceleration.x, acceleration.y, acceleration.z);
+	}
+
+
+	KERNEL_TARGET("avx2,fma")
+	void AccumulatePairs_AVX2(const NBodyStore &store, size_t i, double *ax, double *ay, double *az) {
+		static constexpr size_t LANES = 4;
+
+		const double *x = store.x.data(), *y = store.y.data(), *z = store.z.data(), *mu = store.mu.data();
+
+		const size_t first = i + 1, last = store.size();
+		const size_t vectorLast = first + (last - first) / LANES * LANES;
+
+		const __m256d px = _mm256_set1_pd(x[i]);
+		const __m256d py = _mm256_set1_pd(y[i]);
+		const __m256d pz = _mm256_set1_pd(z[i]);
+		const __m256d muI = _mm256_set1_pd(mu[i]);
+		const __m256d one = _mm256_set1_pd(1.0);
+		const __m256d minDistanceSq = _mm256_set1_pd(MIN_DISTANCE_SQ);
+
+		__m256d aix = _mm256_setzero_pd();
+		__m256d aiy = _mm256_setzero_pd();
+		__m256d aiz = _mm256_setzero_pd();
+
+		for (size_t j = first; j < vectorLast; j += LANES) {
+			const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + j), px);
+			const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + j), py);
+			const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(z + j), pz);
+
+			const __m256d distanceSq = _mm256_fmadd_pd(dz, dz, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx)));
+			const __m256d mask = _mm256_cmp_pd(distanceSq, minDistanceSq, _CMP_GE_OQ);
+
+			const __m256d invDistanceCubed = _mm256_and_pd(mask,
+				_mm256_div_pd(one, _mm256_mul_pd(distanceSq, _mm256_sqrt_pd(distanceSq)))
+			);
+			const __m256d factorI = _mm256_mul_pd(_mm256_loadu_pd(mu + j), invDistanceCubed);
+			const __m256d factorJ = _mm256_mul_pd(muI, invDistanceCubed);
+
+			aix = _mm256_fmadd_pd(factorI, dx, aix);
+			aiy = _mm256_fmadd_pd(factorI, dy, aiy);
+			aiz = _mm256_fmadd_pd(factorI, dz, aiz);
+
+			_mm256_storeu_pd(ax + j, _mm256_fnmadd_pd(factorJ, dx, _mm256_loadu_pd(ax + j)));
+			_mm256_storeu_pd(ay + j, _mm256_fnmadd_pd(factorJ, dy, _mm256_loadu_pd(ay + j)));
+			_mm256_storeu_pd(az + j, _mm256_fnmadd_pd(factorJ, dz, _mm256_loadu_pd(az + j)));
+		}
+
+		double sumX = HorizontalSum_AVX2(aix);
+		double sumY = HorizontalSum_AVX2(aiy);
+		double sumZ = HorizontalSum_AVX2(aiz);
+		AccumulatePairsScalar(store, i, vectorLast, last, sumX, sumY, sumZ, ax, ay, az);
+
+		ax[i] += sumX;
+		ay[i] += sumY;
+		az[i] += sumZ;
+	}
+
+
+	KERNEL_TARGET("avx512f")
+	void Accumulate_AVX512(const NBodyStore &store, size_t first, size_t last, const glm::dvec3 &position, glm::dvec3 &acceleration) {
+		static constexpr size_t LANES = 8;
+
+		const double *x = store.x.data(), *y = store.y.data(), *z = store.z.data(), *mu = store.mu.data();
+		const size_t vectorLast = first + (last - first) / LANES * LANES;
+
+		const __m512d px = _mm512_set1_pd(position.x);
+		const __m512d py = _mm512_set1_pd(position.y);
+		const __m512d pz = _mm512_set1_pd(position.z);
+		const __m512d minDistanceSq = _mm512_set1_pd(MIN_DISTANCE_SQ);
+
+		__m512d ax = _mm512_setzero_pd();
+		__m512d ay = _mm512_setzero_pd();
+		__m512d az = _mm512_setzero_pd();
+
+		for (size_t j = first; j < vectorLast; j += LANES) {
+			const __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x + j), px);
+			const __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(y + j), py);
+			const __m512d dz = _mm512_sub_pd(_mm512_loadu_pd(z + j), pz);
+
+			const __m512d distanceSq = _mm512_fmadd_pd(dz, dz, _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dx, dx)));
+			const __mmask8 mask = _mm512_cmp_pd_mask(distanceSq, minDistanceSq, _CMP_GE_OQ);
+
+			const __m512d factor = _mm512_maskz_div_pd(mask,
+				_mm512_loadu_pd(mu + j), _mm512_mul_pd(distanceSq, _mm512_sqrt_pd(distanceSq))
+			);
+
+			ax = _mm512_fmadd_pd(factor, dx, ax);
+			ay = _mm512_fmadd_pd(factor, dy, ay);
+			az = _mm512_fmadd_pd(factor, dz, az);
+		}
+
+		acceleration.x += _mm512_reduce_add_pd(ax);
+		acceleration.y += _mm512_reduce_add_pd(ay);
+		acceleration.z += _mm512_reduce_add_pd(az);
+		AccumulateScalar(store, vectorLast, last, position.x, position.y, position.z, acceleration.x, acceleration.y, acceleration.z);
+	}
+
+
+	KERNEL_TARGET("avx512f")
+	void AccumulatePairs_AVX512(const NBodyStore &store, size_t i, double *ax, double *ay, double *az) {
+		static constexpr size_t LANES = 8;
+
+		const double *x = store.x.data(), *y = store.y.data(), *z = store.z.data(), *mu = store.mu.data();
+
+		const size_t first = i + 1, last = store.size();
+		const size_t vectorLast = first + (last - first) / LANES * LANES;
+
+		const __m512d px = _mm512_set1_pd(x[i]);
+		const __m512d py = _mm512_set1_pd(y[i]);
+		const __m512d pz = _mm512_set1_pd(z[i]);
+		const __m512d muI = _mm512_set1_pd(mu[i]);
+		const __m512d one = _mm512_set1_pd(1.0);
+		const __m512d minDistanceSq = _mm512_set1_pd(MIN_DISTANCE_SQ);
+
+		__m512d aix = _mm512_setzero_pd();
+		__m512d aiy = _mm512_setzero_pd();
+		__m512d aiz = _mm512_setzero_pd();
+
+		for (size_t j = first; j < vectorLast; j += LANES) {
+			const __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(x + j), px);
+			const __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(y + j), py);
+			const __m512d dz = _mm512_sub_pd(_mm512_loadu_pd(z + j), pz);
+
+			const __m512d distanceSq = _mm512_fmadd_pd(dz, dz, _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dx, dx)));
+			const __mmask8 mask = _mm512_cmp_pd_mask(distanceSq, minDistanceSq, _CMP_GE_OQ);
+
+			const __m512d invDistanceCubed = _mm512_maskz_div_pd(mask, one, _mm512_mul_pd(distanceSq, _mm512_sqrt_pd(distanceSq)));
+			const __m512d factorI = _mm512_mul_pd(_mm512_loadu_pd(mu + j), invDistanceCubed);
+			const __m512d factorJ = _mm512_mul_pd(muI, invDistanceCubed);
+
+			aix = _mm512_fmadd_pd(factorI, dx, aix);
+			aiy = _mm512_fmadd_pd(factorI, dy, aiy);
+			aiz = _mm512_fmadd_pd(factorI, dz, aiz);
+
+			_mm512_storeu_pd(ax + j, _mm512_fnmadd_pd(factorJ, dx, _mm512_loadu_pd(ax + j)));
+			_mm512_storeu_pd(ay + j, _mm512_fnmadd_pd(factorJ, dy, _mm512_loadu_pd(ay + j)));
+			_mm512_storeu_pd(az + j, _mm512_fnmadd_pd(factorJ, dz, _mm512_loadu_pd(az + j)));
+		}
+
+		double sumX = _mm512_reduce_add_pd(aix);
+		double sumY = _mm512_reduce_add_pd(aiy);
+		double sumZ = _mm512_reduce_add_pd(aiz);
+		AccumulatePairsScalar(store, i, vectorLast, last, sumX, sumY, sumZ, ax, ay, az);
+
+		ax[i] += sumX;
+		ay[i] += sumY;
+		az[i] += sumZ;
+	}
+#endif
+
+
+	using AccumulateFunc = void(*)(const NBodyStore &, size_t, size_t, const glm::dvec3 &, glm::dvec3 &);
+
+	AccumulateFunc GetKernel(GravityKernels::InstructionSet instructionSet) {
+		using enum GravityKernels::InstructionSet;
+
+		switch (instructionSet) {
+#ifdef GRAVITY_KERNELS_X86
+		case AVX512:
+			return Accumulate_AVX512;
+		case AVX2:
+			return Accumulate_AVX2;
+#endif
+		default:
+			return Accumulate_Scalar;
+		}
+	}
+
+
+	using AccumulatePairsFunc = void(*)(const NBodyStore &, size_t, double *, double *, double *);
+
+	AccumulatePairsFunc GetPairKernel(GravityKernels::InstructionSet instructionSet) {
+		using enum GravityKernels::InstructionSet;
+
+		switch (instructionSet) {
+#ifdef GRAVITY_KERNELS_X86
+		case AVX512:
+			return AccumulatePairs_AVX512;
+		case AVX2:
+			return AccumulatePairs_AVX2;
+#endif
+		default:
+			return AccumulatePairs_Scalar;
+		}
+	}
+
+
+	GravityKernels::InstructionSet DetectInstructionSet() {
+		using enum GravityKernels::InstructionSet;
+
+#if defined(GRAVITY_KERNELS_X86) && defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+
+		__cpuid(info, 1);
+		const bool hasFMA = (info[2] & (1 << 12)) != 0;
+		const bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+		if (!hasOSXSAVE)
+			return SCALAR;
+
+		// The OS must also save the YMM (and, for AVX-512, the opmask and ZMM) registers on context switches
+		const unsigned long long xcr0 = _xgetbv(0);
+		const bool osSavesYMM = (xcr0 & 0x6) == 0x6;
+		const bool osSavesZMM = (xcr0 & 0xE6) == 0xE6;
+
+		__cpuidex(info, 7, 0);
+		const bool hasAVX2 = (info[1] & (1 << 5)) != 0;
+		const bool hasAVX512F = (info[1] & (1 << 16)) != 0;
+
+		if (hasAVX512F && osSavesZMM)
+			return AVX512;
+		if (hasAVX2 && hasFMA && osSavesYMM)
+			return AVX2;
+
+#elif defined(GRAVITY_KERNELS_X86)
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx512f"))
+			return AVX512;
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+			return AVX2;
+#endif
+
+		return SCALAR;
+	}
+}
+
+
+
+namespace GravityKernels {
+	InstructionSet GetSupportedInstructionSet() {
+		static const InstructionSet instructionSet = DetectInstructionSet();
+		return instructionSet;
+	}
+
+
+	std::string GetInstructionSetName(InstructionSet instructionSet) {
+		switch (instructionSet) {
+		case InstructionSet::AVX512:
+			return "AVX-512";
+		case InstructionSet::AVX2:
+			return "AVX2";
+		default:
+			return "Scalar";
+		}
+	}
+
+
+	glm::dvec3 ComputeAccelerationAt(const NBodyStore &store, const glm::dvec3 &position, uint32_t excludedBody, InstructionSet instructionSet) {
+		const AccumulateFunc accumulate = GetKernel(instructionSet);
+		glm::dvec3 acceleration(0.0);
+
+		// The excluded body splits the sources into two contiguous ranges
+		if (excludedBody < store.size()) {
+			accumulate(store, 0, excludedBody, position, acceleration);
+			accumulate(store, excludedBody + 1, store.size(), position, acceleration);
+		}
+		else
+			accumulate(store, 0, store.size(), position, acceleration);
+
+		return acceleration;
+	}
+
+
+	void ComputeAccelerationsSymmetric(NBodyStore &store, InstructionSet instructionSet) {
+		const AccumulatePairsFunc accumulatePairs = GetPairKernel(instructionSet);
+
+		std::fill(store.ax.begin(), store.ax.end(), 0.0);
+		std::fill(store.ay.begin(), store.ay.end(), 0.0);
+		std::fill(store.az.begin(), store.az.end(), 0.0);
+
+		for (size_t i = 0; i < store.size(); i++)
+			accumulatePairs(store, i, store.ax.data(), store.ay.data(), store.az.data());
+	}
+
+
+	size_t GetPairLaneCount(size_t bodyCount) {
+		const size_t rowBlockCount = (bodyCount + PAIR_ROWS_PER_BLOCK - 1) / PAIR_ROWS_PER_BLOCK;
+		return std::min(PAIR_LANE_COUNT, rowBlockCount);
+	}
+
+
+	void ComputePairLane(const NBodyStore &store, size_t lane, size_t laneCount, double *laneAccelerations, InstructionSet instructionSet) {
+		const AccumulatePairsFunc accumulatePairs = GetPairKernel(instructionSet);
+		const size_t bodyCount = store.size();
+
+		double *ax = laneAccelerations;
+		double *ay = laneAccelerations + bodyCount;
+		double *az = laneAccelerations + 2 * bodyCount;
+		std::fill(laneAccelerations, laneAccelerations + 3 * bodyCount, 0.0);
+
+		// Row blocks are dealt out round-robin, so that every lane gets both long (low i) and short (high i) rows
+		for (size_t blockFirst = lane * PAIR_ROWS_PER_BLOCK; blockFirst < bodyCount; blockFirst += laneCount * PAIR_ROWS_PER_BLOCK) {
+			const size_t blockLast = std::min(blockFirst + PAIR_ROWS_PER_BLOCK, bodyCount);
+
+			for (size_t i = blockFirst; i < blockLast; i++)
+				accumulatePairs(store, i, ax, ay, az);
+		}
+	}
+
+
+	void ReducePairLanes(NBodyStore &store, const double *laneAccelerations, size_t laneCount, size_t firstBody, size_t lastBody) {
+		const size_t bodyCount = store.size();
+		lastBody = std::min(lastBody, bodyCount);
+
+		for (size_t i = firstBody; i < lastBody; i++) {
+			double sumX = 0.0, sumY = 0.0, sumZ = 0.0;
+
+			for (size_t lane = 0; lane < laneCount; lane++) {
+				const double *accelerations = laneAccelerations + 3 * bodyCount * lane;
+				sumX += accelerations[i];
+				sumY += accelerations[bodyCount + i];
+				sumZ += accelerations[2 * bodyCount + i];
+			}
+
+			store.ax[i] = sumX;
+			store.ay[i] = sumY;
+			store.az[i] = sumZ;
+		}
+	}
+
+
+	void ComputeAccelerationsSymmetricParallel(NBodyStore &store, std::vector<double> &laneAccelerations, ThreadPool &pool, uint32_t maxThreads, InstructionSet instructionSet) {
+		const size_t bodyCount = store.size();
+		const size_t taskCount = (bodyCount + PAIR_REDUCTION_TASK_SIZE - 1) / PAIR_REDUCTION_TASK_SIZE;
+		const size_t laneCount = GetPairLaneCount(bodyCount);
+
+		laneAccelerations.resize(laneCount * 3 * bodyCount);
+
+		// Each pair is evaluated once, by one lane; lanes are then summed per body in a fixed order
+		pool.parallelFor(laneCount, [&](size_t lane) {
+			ComputePairLane(store, lane, laneCount, laneAccelerations.data() + lane * 3 * bodyCount, instructionSet);
+		}, maxThreads);
+
+		pool.parallelFor(taskCount, [&](size_t task) {
+			ReducePairLanes(store, laneAccelerations.data(), laneCount, task * PAIR_REDUCTION_TASK_SIZE, (task + 1) * PAIR_REDUCTION_TASK_SIZE);
+		}, maxThreads);
+	}
+}
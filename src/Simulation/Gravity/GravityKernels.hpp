@@ -0,0 +1,103 @@
+/* GravityKernels.hpp - Direct-sum gravitational acceleration kernels over structure-of-arrays body data.
+	The widest instruction set supported by the host CPU (AVX-512, AVX2, or plain scalar code) is selected at runtime.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+namespace GravityKernels {
+	enum class InstructionSet {
+		SCALAR,
+		AVX2,		// 4 doubles per lane (AVX2 + FMA)
+		AVX512		// 8 doubles per lane (AVX-512F)
+	};
+
+
+	/* Gets the widest instruction set supported by both the build and the host CPU. The result is detected once and cached. */
+	InstructionSet GetSupportedInstructionSet();
+
+
+	/* Gets the display name of an instruction set. */
+	std::string GetInstructionSetName(InstructionSet instructionSet);
+
+
+	constexpr uint32_t NO_BODY = UINT32_MAX;
+
+
+	/* Computes the gravitational acceleration at a given position due to every body in the store.
+		Bodies closer than float epsilon to the position are ignored, as in ODE::NewtonianNBody.
+
+		@param store: The body store.
+		@param position: The position at which the acceleration is evaluated.
+		@param excludedBody: The index of a body whose contribution is ignored (usually the body being integrated), or NO_BODY.
+		@param instructionSet: The instruction set to use. Must be supported by the host CPU.
+
+		@return The acceleration at the given position.
+	*/
+	glm::dvec3 ComputeAccelerationAt(const NBodyStore &store, const glm::dvec3 &position, uint32_t excludedBody = NO_BODY, InstructionSet instructionSet = GetSupportedInstructionSet());
+
+
+	/* Computes the gravitational accelerations of every body in the store by evaluating each pair of bodies once and applying the interaction to both of them (Newton's third law), and writes them to the store's acceleration arrays.
+		This halves the number of pair evaluations compared to evaluating every body's acceleration separately (see ComputeAccelerationAt). The summation order only depends on the order of the bodies in the store.
+
+		@param store: The body store.
+		@param instructionSet: The instruction set to use. Must be supported by the host CPU.
+	*/
+	void ComputeAccelerationsSymmetric(NBodyStore &store, InstructionSet instructionSet = GetSupportedInstructionSet());
+
+
+	constexpr size_t PAIR_LANE_COUNT = 32;			// Maximum number of lanes of the parallel symmetric pass
+	constexpr size_t PAIR_ROWS_PER_BLOCK = 64;		// Number of consecutive rows (bodies i, with their pairs j > i) that a lane processes at a time
+	constexpr size_t PAIR_REDUCTION_TASK_SIZE = 64;	// Number of bodies per task of the lane reduction
+
+
+	/* Gets the number of lanes into which the parallel symmetric pass over a given number of bodies is split. It only depends on the number of bodies (never on the number of threads). */
+	size_t GetPairLaneCount(size_t bodyCount);
+
+
+	/* Computes one lane of the parallel symmetric pass: the pairwise interactions (i, j > i) of the lane's rows, applied to both bodies of each pair, into the lane's own acceleration buffer.
+		Rows are dealt out to the lanes in blocks of PAIR_ROWS_PER_BLOCK, round-robin, so each pair is evaluated exactly once, by the lane of its row. Lanes only write to their own buffers, and can be computed concurrently.
+
+		@param store: The body store.
+		@param lane: The index of the lane, in [0, laneCount).
+		@param laneCount: The number of lanes (see GetPairLaneCount).
+		@param laneAccelerations: The lane's acceleration buffer of 3 * store.size() doubles (x components, then y, then z). It is overwritten.
+		@param instructionSet: The instruction set to use. Must be supported by the host CPU.
+	*/
+	void ComputePairLane(const NBodyStore &store, size_t lane, size_t laneCount, double *laneAccelerations, InstructionSet instructionSet = GetSupportedInstructionSet());
+
+
+	/* Sums the lane buffers of the parallel symmetric pass for a range of bodies, and writes the totals to the store's acceleration arrays.
+		Lanes are always summed in ascending order, so the accelerations are bit-for-bit identical however the bodies are split into ranges, and whichever thread reduces them.
+
+		@param store: The body store.
+		@param laneAccelerations: The buffers of all lanes, laid out consecutively (3 * store.size() doubles each).
+		@param laneCount: The number of lanes.
+		@param firstBody: The index of the first body.
+		@param lastBody: The index past the last body.
+	*/
+	void ReducePairLanes(NBodyStore &store, const double *laneAccelerations, size_t laneCount, size_t firstBody, size_t lastBody);
+
+
+	/* Computes the gravitational accelerations of every body in the store with the parallel symmetric pass, and writes them to the store's acceleration arrays.
+		The lanes (see ComputePairLane) are computed concurrently, then summed per body in ascending lane order (see ReducePairLanes). The number of lanes only depends on the number of bodies, so the accelerations are bit-for-bit identical for any number of threads.
+
+		@param store: The body store.
+		@param laneAccelerations: The buffers of all lanes, resized as needed (kept by the caller, to be reused across passes).
+		@param pool: The thread pool.
+		@param maxThreads: The maximum number of threads to use (0 for every thread of the pool).
+		@param instructionSet: The instruction set to use. Must be supported by the host CPU.
+	*/
+	void ComputeAccelerationsSymmetricParallel(NBodyStore &store, std::vector<double> &laneAccelerations, ThreadPool &pool, uint32_t maxThreads = 0, InstructionSet instructionSet = GetSupportedInstructionSet());
+}
@@ -0,0 +1,66 @@
+/* NBodyStore.hpp - Structure-of-arrays storage of N-body state vectors.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+
+#include <Platform/External/GLM.hpp>
+
+
+/* Stores the state of N bodies as contiguous arrays of doubles (one array per component), so that the gravity kernels can stream through positions and gravitational parameters with packed SIMD loads instead of gathering them from padded, interleaved structures. */
+struct NBodyStore {
+	// Positions (m)
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> z;
+
+	// Velocities (m/s)
+	std::vector<double> vx;
+	std::vector<double> vy;
+	std::vector<double> vz;
+
+	// Accelerations (m/s^2)
+	std::vector<double> ax;
+	std::vector<double> ay;
+	std::vector<double> az;
+
+	// Standard gravitational parameters (GM; m^3/s^2)
+	std::vector<double> mu;
+
+
+	/* Gets the number of bodies in the store. */
+	inline size_t size() const { return x.size(); }
+
+
+	/* Resizes the store. */
+	inline void resize(size_t count) {
+		for (std::vector<double> *array : { &x, &y, &z, &vx, &vy, &vz, &ax, &ay, &az, &mu })
+			array->resize(count, 0.0);
+	}
+
+
+	inline glm::dvec3 getPosition(size_t i) const { return glm::dvec3(x[i], y[i], z[i]); }
+	inline glm::dvec3 getVelocity(size_t i) const { return glm::dvec3(vx[i], vy[i], vz[i]); }
+	inline glm::dvec3 getAcceleration(size_t i) const { return glm::dvec3(ax[i], ay[i], az[i]); }
+
+	inline void setPosition(size_t i, const glm::dvec3 &position) {
+		x[i] = position.x;
+		y[i] = position.y;
+		z[i] = position.z;
+	}
+
+	inline void setVelocity(size_t i, const glm::dvec3 &velocity) {
+		vx[i] = velocity.x;
+		vy[i] = velocity.y;
+		vz[i] = velocity.z;
+	}
+
+	inline void setAcceleration(size_t i, const glm::dvec3 &acceleration) {
+		ax[i] = acceleration.x;
+		ay[i] = acceleration.y;
+		az[i] = acceleration.z;
+	}
+};
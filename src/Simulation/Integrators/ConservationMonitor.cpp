@@ -0,0 +1,102 @@
+/* ConservationMonitor.cpp - Tracks the drift of the conserved quantities of an N-body system.
+*/
+
+#include "ConservationMonitor.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+
+ConservationMonitor::Invariants ConservationMonitor::ComputeInvariants(const NBodyStore &store) {
+	using namespace PhysicsConst;
+
+	static constexpr double MIN_DISTANCE_SQ = std::numeric_limits<float>::epsilon() * std::numeric_limits<float>::epsilon();
+
+	const size_t bodyCount = store.size();
+
+
+	// Barycenter (the store holds GM, which is proportional to the mass)
+	double totalMu = 0.0;
+	glm::dvec3 barycenterPosition(0.0), barycenterVelocity(0.0);
+
+	for (size_t i = 0; i < bodyCount; i++) {
+		totalMu += store.mu[i];
+		barycenterPosition += store.mu[i] * store.getPosition(i);
+		barycenterVelocity += store.mu[i] * store.getVelocity(i);
+	}
+
+	if (totalMu > 0.0) {
+		barycenterPosition /= totalMu;
+		barycenterVelocity /= totalMu;
+	}
+
+
+	// Kinetic energy and angular momentum (multiplied by G)
+	double kineticEnergy = 0.0;
+	glm::dvec3 angularMomentum(0.0);
+
+	for (size_t i = 0; i < bodyCount; i++) {
+		const glm::dvec3 velocity = store.getVelocity(i);
+
+		kineticEnergy += 0.5 * store.mu[i] * glm::dot(velocity, velocity);
+		angularMomentum += store.mu[i] * glm::cross(store.getPosition(i) - barycenterPosition, velocity - barycenterVelocity);
+	}
+
+
+	// Potential energy (multiplied by G), each pair counted once
+	double potentialEnergy = 0.0;
+
+	for (size_t i = 0; i < bodyCount; i++) {
+		double bodyPotential = 0.0;
+
+		for (size_t j = i + 1; j < bodyCount; j++) {
+			const double dx = store.x[j] - store.x[i];
+			const double dy = store.y[j] - store.y[i];
+			const double dz = store.z[j] - store.z[i];
+			const double distanceSq = dx * dx + dy * dy + dz * dz;
+
+			if (distanceSq >= MIN_DISTANCE_SQ)
+				bodyPotential += store.mu[j] / std::sqrt(distanceSq);
+		}
+
+		potentialEnergy -= store.mu[i] * bodyPotential;
+	}
+
+
+	return Invariants{
+		.energy = (kineticEnergy + potentialEnergy) / G,
+		.angularMomentum = angularMomentum / G
+	};
+}
+
+
+void ConservationMonitor::record(const NBodyStore &store) {
+	const Invariants invariants = ComputeInvariants(store);
+
+	if (m_sampleCount == 0 || store.size() != m_bodyCount) {
+		reset();
+		m_reference = invariants;
+		m_bodyCount = store.size();
+	}
+
+	m_energyDrift = RelativeDrift(std::abs(invariants.energy - m_reference.energy), m_reference.energy);
+	m_angularMomentumDrift = RelativeDrift(glm::length(invariants.angularMomentum - m_reference.angularMomentum), glm::length(m_reference.angularMomentum));
+
+	m_maxEnergyDrift = std::max(m_maxEnergyDrift, m_energyDrift);
+	m_maxAngularMomentumDrift = std::max(m_maxAngularMomentumDrift, m_angularMomentumDrift);
+
+	m_sampleCount++;
+}
+
+
+void ConservationMonitor::reset() {
+	m_reference = Invariants{};
+	m_bodyCount = 0;
+	m_sampleCount = 0;
+
+	m_energyDrift = 0.0;
+	m_maxEnergyDrift = 0.0;
+	m_angularMomentumDrift = 0.0;
+	m_maxAngularMomentumDrift = 0.0;
+}
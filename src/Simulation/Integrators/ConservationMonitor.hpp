@@ -0,0 +1,76 @@
+/* ConservationMonitor.hpp - Tracks the drift of the conserved quantities (total energy and angular momentum) of an N-body system.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+
+#include <Core/Data/Constants.h>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+/* Records the relative drift of the total energy and angular momentum of a body store from their values at the first sample.
+	NOTE: Both quantities are only conserved when the bodies move under their mutual gravity alone. Bodies driven by SPICE or by propagators, or additional forces, make the system open, in which case the drift measures that rather than the integrator's error.
+*/
+class ConservationMonitor {
+public:
+	struct Invariants {
+		double energy;					// Total (kinetic + potential) energy (J)
+		glm::dvec3 angularMomentum;		// Total angular momentum about the barycenter (kg m^2/s)
+	};
+
+
+	ConservationMonitor() = default;
+	~ConservationMonitor() = default;
+
+
+	/* Computes the conserved quantities of a body store.
+		Bodies closer than float epsilon to each other do not contribute to the potential energy, as in the gravity kernels.
+	*/
+	static Invariants ComputeInvariants(const NBodyStore &store);
+
+
+	/* Records a sample. The first sample (and the first sample after the number of bodies changes) becomes the reference. */
+	void record(const NBodyStore &store);
+
+
+	/* Discards the reference and all statistics. */
+	void reset();
+
+
+	/* Gets the relative energy drift |E - E0| / |E0| of the last sample. */
+	inline double getEnergyDrift() const { return m_energyDrift; }
+
+	/* Gets the largest relative energy drift of all samples. */
+	inline double getMaxEnergyDrift() const { return m_maxEnergyDrift; }
+
+	/* Gets the relative angular momentum drift |L - L0| / |L0| of the last sample. */
+	inline double getAngularMomentumDrift() const { return m_angularMomentumDrift; }
+
+	/* Gets the largest relative angular momentum drift of all samples. */
+	inline double getMaxAngularMomentumDrift() const { return m_maxAngularMomentumDrift; }
+
+	/* Gets the number of samples recorded since the reference was taken. */
+	inline uint64_t getSampleCount() const { return m_sampleCount; }
+
+private:
+	Invariants m_reference{};
+	size_t m_bodyCount = 0;
+	uint64_t m_sampleCount = 0;
+
+	double m_energyDrift = 0.0;
+	double m_maxEnergyDrift = 0.0;
+	double m_angularMomentumDrift = 0.0;
+	double m_maxAngularMomentumDrift = 0.0;
+
+
+	/* Computes the drift of a quantity relative to its reference value. */
+	static inline double RelativeDrift(double drift, double reference) {
+		return (reference != 0.0) ? drift / std::abs(reference) : drift;
+	}
+};
@@ -0,0 +1,464 @@
+/* EmbeddedRK.hpp - Implementation of adaptive-step embedded Runge-Kutta integrators (RKF45, Dormand-Prince 5(4), and Dormand-Prince 8(5,3)).
+	Sources:
+		- E. Fehlberg, "Low-order classical Runge-Kutta formulas with stepsize control and their application to some heat transfer problems", NASA TR R-315 (1969).
+		- J. R. Dormand and P. J. Prince, "A family of embedded Runge-Kutta formulae", Journal of Computational and Applied Mathematics 6 (1980).
+		- E. Hairer, S. P. Norsett, and G. Wanner, "Solving Ordinary Differential Equations I: Nonstiff Problems", 2nd ed., Sections II.4-II.5 (DOPRI5 and DOP853).
+*/
+
+#pragma once
+
+#include <cmath>
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+
+
+namespace EmbeddedRK {
+	enum class Method {
+		RKF45,			// Runge-Kutta-Fehlberg 4(5) (propagates the 4th-order solution)
+		DOPRI54,		// Dormand-Prince 5(4), first-same-as-last
+		DOP853			// Dormand-Prince 8(5,3)
+	};
+
+
+	constexpr size_t MAX_STAGES = 12;
+
+	/* Butcher tableau of an embedded Runge-Kutta pair. */
+	struct Tableau {
+		size_t stages;
+		double errorExponent;										// 1 / (q + 1), where q is the order of the error estimate
+
+		std::array<double, MAX_STAGES> c;							// Nodes
+		std::array<std::array<double, MAX_STAGES>, MAX_STAGES> a;	// Runge-Kutta matrix
+		std::array<double, MAX_STAGES> b;							// Weights of the propagated solution
+		std::array<double, MAX_STAGES> e;							// Error estimate weights (b - b_hat)
+		std::array<double, MAX_STAGES> e3;							// DOP853 only: third-order error estimate weights (b - b_hhat)
+
+		bool hasSecondaryEstimate;									// Whether `e3` is used (DOP853)
+		bool firstSameAsLast;										// Whether the last stage is evaluated at the new solution, and can be reused as the first stage of the next step
+	};
+
+
+	inline const Tableau RKF45_TABLEAU = {
+		.stages = 6,
+		.errorExponent = 1.0 / 5.0,
+		.c = { 0.0, 1.0 / 4.0, 3.0 / 8.0, 12.0 / 13.0, 1.0, 1.0 / 2.0 },
+		.a = {{
+			{},
+			{ 1.0 / 4.0 },
+			{ 3.0 / 32.0, 9.0 / 32.0 },
+			{ 1932.0 / 2197.0, -7200.0 / 2197.0, 7296.0 / 2197.0 },
+			{ 439.0 / 216.0, -8.0, 3680.0 / 513.0, -845.0 / 4104.0 },
+			{ -8.0 / 27.0, 2.0, -3544.0 / 2565.0, 1859.0 / 4104.0, -11.0 / 40.0 }
+		}},
+		.b = { 25.0 / 216.0, 0.0, 1408.0 / 2565.0, 2197.0 / 4104.0, -1.0 / 5.0, 0.0 },
+		.e = {
+			25.0 / 216.0 - 16.0 / 135.0,
+			0.0,
+			1408.0 / 2565.0 - 6656.0 / 12825.0,
+			2197.0 / 4104.0 - 28561.0 / 56430.0,
+			-1.0 / 5.0 + 9.0 / 50.0,
+			-2.0 / 55.0
+		},
+		.e3 = {},
+		.hasSecondaryEstimate = false,
+		.firstSameAsLast = false
+	};
+
+
+	inline const Tableau DOPRI54_TABLEAU = {
+		.stages = 7,
+		.errorExponent = 1.0 / 5.0,
+		.c = { 0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0 },
+		.a = {{
+			{},
+			{ 1.0 / 5.0 },
+			{ 3.0 / 40.0, 9.0 / 40.0 },
+			{ 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0 },
+			{ 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0 },
+			{ 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0 },
+			{ 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 }
+		}},
+		.b = { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0 },
+		.e = {
+			35.0 / 384.0 - 5179.0 / 57600.0,
+			0.0,
+			500.0 / 1113.0 - 7571.0 / 16695.0,
+			125.0 / 192.0 - 393.0 / 640.0,
+			-2187.0 / 6784.0 + 92097.0 / 339200.0,
+			11.0 / 84.0 - 187.0 / 2100.0,
+			-1.0 / 40.0
+		},
+		.e3 = {},
+		.hasSecondaryEstimate = false,
+		.firstSameAsLast = true
+	};
+
+
+	// Coefficients are taken from Hairer's reference implementation (dop853.f).
+	inline const Tableau DOP853_TABLEAU = {
+		.stages = 12,
+		.errorExponent = 1.0 / 8.0,
+		.c = {
+			0.0,
+			0.526001519587677318785587544488e-01,
+			0.789002279381515978178381316732e-01,
+			0.118350341907227396726757197510,
+			0.281649658092772603273242802490,
+			0.333333333333333333333333333333,
+			0.25,
+			0.307692307692307692307692307692,
+			0.651282051282051282051282051282,
+			0.6,
+			0.857142857142857142857142857142,
+			1.0
+		},
+		.a = {{
+			{},
+			{ 5.26001519587677318785587544488e-2 },
+			{ 1.97250569845378994544595329183e-2, 5.91751709536136983633785987549e-2 },
+			{ 2.95875854768068491816892993775e-2, 0.0, 8.87627564304205475450678981324e-2 },
+			{ 2.41365134159266685502369798665e-1, 0.0, -8.84549479328286085344864962717e-1, 9.24834003261792003115737966543e-1 },
+			{ 3.7037037037037037037037037037e-2, 0.0, 0.0, 1.70828608729473871279604482173e-1, 1.25467687566822425016691814123e-1 },
+			{ 3.7109375e-2, 0.0, 0.0, 1.70252211019544039314978060272e-1, 6.02165389804559606850219397283e-2, -1.7578125e-2 },
+			{ 3.70920001185047927108779319836e-2, 0.0, 0.0, 1.70383925712239993810214054705e-1, 1.07262030446373284651809199168e-1, -1.53194377486244017527936158236e-2, 8.27378916381402288758473766002e-3 },
+			{ 6.24110958716075717114429577812e-1, 0.0, 0.0, -3.36089262944694129406857109825, -8.68219346841726006818189891453e-1, 2.75920996994467083049415600797e1, 2.01540675504778934086186788979e1, -4.34898841810699588477366255144e1 },
+			{ 4.77662536438264365890433908527e-1, 0.0, 0.0, -2.48811461997166764192642586468, -5.90290826836842996371446475743e-1, 2.12300514481811942347288949897e1, 1.52792336328824235832596922938e1, -3.32882109689848629194453265587e1, -2.03312017085086261358222928593e-2 },
+			{ -9.3714243008598732571704021658e-1, 0.0, 0.0, 5.18637242884406370830023853209, 1.09143734899672957818500254654, -8.14978701074692612513997267357, -1.85200656599969598641566180701e1, 2.27394870993505042818970056734e1, 2.49360555267965238987089396762, -3.0467644718982195003823669022 },
+			{ 2.27331014751653820792359768449, 0.0, 0.0, -1.05344954667372501984066689879e1, -2.00087205822486249909675718444, -1.79589318631187989172765950534e1, 2.79488845294199600508499808837e1, -2.85899827713502369474065508674, -8.87285693353062954433549289258, 1.23605671757943030647266201528e1, 6.43392746015763530355970484046e-1 }
+		}},
+		.b = {
+			5.42937341165687622380535766363e-2, 0.0, 0.0, 0.0, 0.0,
+			4.45031289275240888144113950566,
+			1.89151789931450038304281599044,
+			-5.8012039600105847814672114227,
+			3.1116436695781989440891606237e-1,
+			-1.52160949662516078556178806805e-1,
+			2.01365400804030348374776537501e-1,
+			4.47106157277725905176885569043e-2
+		},
+		.e = {
+			0.1312004499419488073250102996e-01, 0.0, 0.0, 0.0, 0.0,
+			-0.1225156446376204440720569753e+01,
+			-0.4957589496572501915214079952,
+			0.1664377182454986536961530415e+01,
+			-0.3503288487499736816886487290,
+			0.3341791187130174790297318841,
+			0.8192320648511571246570742613e-01,
+			-0.2235530786388629525884427845e-01
+		},
+		.e3 = {
+			5.42937341165687622380535766363e-2 - 0.244094488188976377952755905512, 0.0, 0.0, 0.0, 0.0,
+			4.45031289275240888144113950566,
+			1.89151789931450038304281599044,
+			-5.8012039600105847814672114227,
+			3.1116436695781989440891606237e-1 - 0.733846688281611857341361741547,
+			-1.52160949662516078556178806805e-1,
+			2.01365400804030348374776537501e-1,
+			4.47106157277725905176885569043e-2 - 0.220588235294117647058823529412e-01
+		},
+		.hasSecondaryEstimate = true,
+		.firstSameAsLast = false
+	};
+
+
+	inline const Tableau &GetTableau(Method method) {
+		switch (method) {
+		case Method::RKF45:
+			return RKF45_TABLEAU;
+		case Method::DOPRI54:
+			return DOPRI54_TABLEAU;
+		default:
+			return DOP853_TABLEAU;
+		}
+	}
+
+
+	/* Error tolerances. The error of each component is scaled by (absolute + relative * max(|y_old|, |y_new|)). */
+	struct Tolerance {
+		double absolute;
+		double relative;
+	};
+
+
+	/* Step statistics, accumulated over the lifetime of an integrator. */
+	struct Statistics {
+		static constexpr size_t HISTORY_SIZE = 256;
+
+		uint64_t acceptedSteps = 0;
+		uint64_t rejectedSteps = 0;
+		uint64_t evaluations = 0;								// Number of ODE (right-hand side) evaluations
+
+		std::array<double, HISTORY_SIZE> stepHistory{};			// Ring buffer of the most recently accepted step sizes
+		size_t historyHead = 0;
+
+		double minStep = std::numeric_limits<double>::infinity();
+		double maxStep = 0.0;
+
+
+		inline void recordAcceptedStep(double h) {
+			acceptedSteps++;
+
+			stepHistory[historyHead] = h;
+			historyHead = (historyHead + 1) % HISTORY_SIZE;
+
+			minStep = std::min(minStep, h);
+			maxStep = std::max(maxStep, h);
+		}
+
+
+		/* Gets the mean of the recorded step history. */
+		inline double getMeanRecentStep() const {
+			const size_t count = static_cast<size_t>(std::min<uint64_t>(acceptedSteps, HISTORY_SIZE));
+			if (count == 0)
+				return 0.0;
+
+			double sum = 0.0;
+			for (size_t i = 0; i < count; i++)
+				sum += stepHistory[i];
+
+			return sum / count;
+		}
+
+
+		inline Statistics &operator+=(const Statistics &other) {
+			acceptedSteps += other.acceptedSteps;
+			rejectedSteps += other.rejectedSteps;
+			evaluations += other.evaluations;
+			minStep = std::min(minStep, other.minStep);
+			maxStep = std::max(maxStep, other.maxStep);
+
+			return *this;
+		}
+	};
+}
+
+
+
+/* Adaptive-step embedded Runge-Kutta integrator over a flat state vector.
+	The state is an array of doubles, partitioned into blocks of `blockSize` components (e.g., 6 for [x, y, z, vx, vy, vz]). The error of a step is the maximum, over all blocks, of the RMS scaled error of each block, so that a single body cannot hide its error among many others when a whole system is integrated at once.
+*/
+class EmbeddedRKIntegrator {
+public:
+	EmbeddedRKIntegrator() = default;
+	~EmbeddedRKIntegrator() = default;
+
+	/* Configures the integrator.
+		@param method: The embedded Runge-Kutta pair.
+		@param tolerance: The error tolerances.
+		@param blockSize: The number of state components per error block.
+	*/
+	inline void configure(EmbeddedRK::Method method, const EmbeddedRK::Tolerance &tolerance, size_t blockSize = 6) {
+		m_tableau = &EmbeddedRK::GetTableau(method);
+		m_tolerance = tolerance;
+		m_blockSize = blockSize;
+		m_stepSize = 0.0;
+	}
+
+
+	/* Integrates the state over [t, t + dt] with as few steps as the tolerance allows. The last step is shortened to land exactly on t + dt, and the step size proposed before shortening is kept as the initial guess for the next call.
+		@param y: The state vector.
+		@param t: The current time.
+		@param dt: The time interval to cover.
+		@param f: The ODE system, called as `f(double t, const double *y, double *dydt)`.
+	*/
+	template<typename ODESystem>
+	void integrate(std::vector<double> &y, double t, double dt, ODESystem &&f) {
+		LOG_ASSERT(m_tableau, "Cannot integrate: Embedded Runge-Kutta integrator has not been configured!");
+
+		if (dt <= 0.0)
+			return;
+
+		prepareBuffers(y.size());
+
+		// The state may have been modified externally since the last call, so the first stage must be re-evaluated.
+		f(t, y.data(), m_k[0].data());
+		m_stats.evaluations++;
+
+		if (m_stepSize <= 0.0)
+			m_stepSize = computeInitialStep(y, t, dt, f);
+
+		const double tEnd = t + dt;
+		const double minStep = 16.0 * std::numeric_limits<double>::epsilon() * std::max(std::abs(t), std::abs(tEnd));
+		bool lastStepRejected = false;
+
+		while (t < tEnd) {
+			const bool isFinalStep = (t + m_stepSize >= tEnd - minStep);
+			const double h = isFinalStep ? (tEnd - t) : m_stepSize;
+
+			const double error = attemptStep(y, t, h, f);
+
+
+			// Step size control
+			double factor = (error > 0.0) ? SAFETY * std::pow(error, -m_tableau->errorExponent) : MAX_FACTOR;
+			factor = std::clamp(factor, MIN_FACTOR, lastStepRejected ? 1.0 : MAX_FACTOR);
+
+			if (error <= 1.0 || h <= minStep) {
+				// Accept
+				m_stats.recordAcceptedStep(h);
+
+				t += h;
+				y.swap(m_yNew);
+
+				if (!isFinalStep)
+					m_stepSize = h * factor;
+				else
+					m_stepSize = std::max(m_stepSize, h * factor);
+
+				// Reuse or evaluate the first stage of the next step
+				if (t < tEnd) {
+					if (m_tableau->firstSameAsLast)
+						m_k[0].swap(m_k[m_tableau->stages - 1]);
+					else {
+						f(t, y.data(), m_k[0].data());
+						m_stats.evaluations++;
+					}
+				}
+
+				lastStepRejected = false;
+			}
+			else {
+				// Reject
+				m_stats.rejectedSteps++;
+				m_stepSize = h * factor;
+				lastStepRejected = true;
+			}
+		}
+	}
+
+
+	/* Gets the step statistics. */
+	inline const EmbeddedRK::Statistics &getStatistics() const { return m_stats; }
+
+	/* Gets the step size that will be attempted next. */
+	inline double getStepSize() const { return m_stepSize; }
+
+private:
+	static constexpr double SAFETY = 0.9;
+	static constexpr double MIN_FACTOR = 0.2;
+	static constexpr double MAX_FACTOR = 5.0;
+
+	const EmbeddedRK::Tableau *m_tableau = nullptr;
+	EmbeddedRK::Tolerance m_tolerance{ 1e-6, 1e-9 };
+	size_t m_blockSize = 6;
+
+	double m_stepSize = 0.0;		// Proposed size of the next step (0 = unknown)
+	EmbeddedRK::Statistics m_stats;
+
+	std::array<std::vector<double>, EmbeddedRK::MAX_STAGES> m_k;		// Stage derivatives
+	std::vector<double> m_yStage;
+	std::vector<double> m_yNew;
+
+
+	inline void prepareBuffers(size_t size) {
+		for (size_t s = 0; s < m_tableau->stages; s++)
+			m_k[s].resize(size);
+
+		m_yStage.resize(size);
+		m_yNew.resize(size);
+	}
+
+
+	/* Attempts a step of size h. The candidate solution is written to m_yNew.
+		@return The scaled error norm of the step (accepted if <= 1).
+	*/
+	template<typename ODESystem>
+	double attemptStep(const std::vector<double> &y, double t, double h, ODESystem &f) {
+		const EmbeddedRK::Tableau &tab = *m_tableau;
+		const size_t n = y.size();
+
+		// Stages
+		for (size_t s = 1; s < tab.stages; s++) {
+			for (size_t i = 0; i < n; i++) {
+				double sum = 0.0;
+				for (size_t j = 0; j < s; j++)
+					sum += tab.a[s][j] * m_k[j][i];
+
+				m_yStage[i] = y[i] + h * sum;
+			}
+
+			f(t + tab.c[s] * h, m_yStage.data(), m_k[s].data());
+			m_stats.evaluations++;
+		}
+
+
+		// Solution and error estimate
+		double maxBlockError = 0.0;
+		double blockErrorSq = 0.0, blockErrorSq3 = 0.0;
+
+		for (size_t i = 0; i < n; i++) {
+			double increment = 0.0, error = 0.0, error3 = 0.0;
+
+			for (size_t s = 0; s < tab.stages; s++) {
+				increment += tab.b[s] * m_k[s][i];
+				error += tab.e[s] * m_k[s][i];
+				if (tab.hasSecondaryEstimate)
+					error3 += tab.e3[s] * m_k[s][i];
+			}
+
+			m_yNew[i] = y[i] + h * increment;
+
+			const double scale = m_tolerance.absolute + m_tolerance.relative * std::max(std::abs(y[i]), std::abs(m_yNew[i]));
+			blockErrorSq += (h * error / scale) * (h * error / scale);
+			blockErrorSq3 += (h * error3 / scale) * (h * error3 / scale);
+
+			if ((i + 1) % m_blockSize == 0 || i + 1 == n) {
+				const size_t blockLength = (i % m_blockSize) + 1;
+				double blockError = std::sqrt(blockErrorSq / blockLength);
+
+				// DOP853 combines its fifth- and third-order estimates (Hairer et al., Section II.10)
+				if (tab.hasSecondaryEstimate && blockErrorSq > 0.0)
+					blockError = blockErrorSq / std::sqrt(blockLength * (blockErrorSq + 0.01 * blockErrorSq3));
+
+				maxBlockError = std::max(maxBlockError, blockError);
+				blockErrorSq = blockErrorSq3 = 0.0;
+			}
+		}
+
+
+		return std::isfinite(maxBlockError) ? maxBlockError : std::numeric_limits<double>::infinity();
+	}
+
+
+	/* Estimates an initial step size (Hairer et al., Section II.4, "Starting Step Size"). */
+	template<typename ODESystem>
+	double computeInitialStep(const std::vector<double> &y, double t, double dt, ODESystem &f) {
+		const size_t n = y.size();
+		const double order = 1.0 / m_tableau->errorExponent;
+
+		double d0 = 0.0, d1 = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			const double scale = m_tolerance.absolute + m_tolerance.relative * std::abs(y[i]);
+			d0 = std::max(d0, std::abs(y[i]) / scale);
+			d1 = std::max(d1, std::abs(m_k[0][i]) / scale);
+		}
+
+		double h0 = (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+		h0 = std::min(h0, dt);
+
+
+		// Explicit Euler step to estimate the second derivative
+		for (size_t i = 0; i < n; i++)
+			m_yStage[i] = y[i] + h0 * m_k[0][i];
+
+		f(t + h0, m_yStage.data(), m_k[1].data());
+		m_stats.evaluations++;
+
+		double d2 = 0.0;
+		for (size_t i = 0; i < n; i++) {
+			const double scale = m_tolerance.absolute + m_tolerance.relative * std::abs(y[i]);
+			d2 = std::max(d2, std::abs(m_k[1][i] - m_k[0][i]) / scale);
+		}
+		d2 /= h0;
+
+		const double maxDerivative = std::max(d1, d2);
+		const double h1 = (maxDerivative <= 1e-15) ? std::max(1e-6, h0 * 1e-3) : std::pow(0.01 / maxDerivative, 1.0 / order);
+
+		return std::min({ 100.0 * h0, h1, dt });
+	}
+};
@@ -0,0 +1,119 @@
+/* NBodyRK4.hpp - Implementation of the fourth-order Runge-Kutta (RK4) numerical integrator over a whole N-body system.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+/* Fourth-order Runge-Kutta integrator that treats the state vectors of all bodies as a single ODE.
+	Every stage is evaluated for all bodies at once on a separate stage buffer (the store itself holds the state at the start of the step), so the result does not depend on the order in which bodies are stored.
+*/
+class NBodyRK4Integrator {
+public:
+	NBodyRK4Integrator() = default;
+	~NBodyRK4Integrator() = default;
+
+	/* Integrates all bodies in a store.
+		@param store: The body store. Its acceleration arrays receive the accelerations at the start of the step.
+		@param isFixed: A mask (parallel to the store) of bodies whose states are driven externally (e.g., by SPICE). Fixed bodies act as stationary gravity sources during the step, and are not integrated.
+		@param t: The current time.
+		@param dt: The time step for integration.
+		@param f: The acceleration system, called as `f(NBodyStore &stage, double t)`. It must write the accelerations of all bodies in `stage` to the stage's acceleration arrays.
+	*/
+	template<typename AccelerationSystem>
+	void integrate(NBodyStore &store, const std::vector<uint8_t> &isFixed, double t, double dt, AccelerationSystem &&f) {
+		static constexpr double STAGE_NODES[4] = { 0.0, 0.5, 0.5, 1.0 };
+		static constexpr double STAGE_WEIGHTS[4] = { 1.0, 2.0, 2.0, 1.0 };
+
+		const size_t bodyCount = store.size();
+		prepareBuffers(store);
+
+		double *position[3] = { store.x.data(), store.y.data(), store.z.data() };
+		double *velocity[3] = { store.vx.data(), store.vy.data(), store.vz.data() };
+
+		double *stagePosition[3] = { m_stage.x.data(), m_stage.y.data(), m_stage.z.data() };
+		double *stageVelocity[3] = { m_stage.vx.data(), m_stage.vy.data(), m_stage.vz.data() };
+		const double *stageAcceleration[3] = { m_stage.ax.data(), m_stage.ay.data(), m_stage.az.data() };
+
+
+		for (int stage = 0; stage < 4; stage++) {
+			f(m_stage, t + STAGE_NODES[stage] * dt);
+
+			if (stage == 0) {
+				store.ax = m_stage.ax;
+				store.ay = m_stage.ay;
+				store.az = m_stage.az;
+			}
+
+
+			// Accumulate weighted stage derivatives
+			const double weight = STAGE_WEIGHTS[stage];
+
+			for (int k = 0; k < 3; k++) {
+				double *positionIncrement = m_positionIncrement[k].data();
+				double *velocityIncrement = m_velocityIncrement[k].data();
+
+				for (size_t i = 0; i < bodyCount; i++) {
+					positionIncrement[i] += weight * stageVelocity[k][i];
+					velocityIncrement[i] += weight * stageAcceleration[k][i];
+				}
+			}
+
+
+			// Compute the next stage state from the state at the start of the step
+			if (stage < 3) {
+				const double h = STAGE_NODES[stage + 1] * dt;
+
+				for (int k = 0; k < 3; k++)
+					for (size_t i = 0; i < bodyCount; i++) {
+						if (isFixed[i])
+							continue;
+
+						// NOTE: The stage position must be computed with the current stage velocity, before it is overwritten.
+						stagePosition[k][i] = position[k][i] + h * stageVelocity[k][i];
+						stageVelocity[k][i] = velocity[k][i] + h * stageAcceleration[k][i];
+					}
+			}
+		}
+
+
+		// Combine stages
+		for (int k = 0; k < 3; k++)
+			for (size_t i = 0; i < bodyCount; i++) {
+				if (isFixed[i])
+					continue;
+
+				position[k][i] += dt * m_positionIncrement[k][i] / 6.0;
+				velocity[k][i] += dt * m_velocityIncrement[k][i] / 6.0;
+			}
+	}
+
+private:
+	NBodyStore m_stage;										// Stage state buffer
+	std::vector<double> m_positionIncrement[3];				// Weighted sum of stage velocities
+	std::vector<double> m_velocityIncrement[3];				// Weighted sum of stage accelerations
+
+
+	/* Copies the state at the start of the step to the stage buffer, and clears the increment buffers. */
+	inline void prepareBuffers(const NBodyStore &store) {
+		m_stage.resize(store.size());
+
+		m_stage.x = store.x;
+		m_stage.y = store.y;
+		m_stage.z = store.z;
+		m_stage.vx = store.vx;
+		m_stage.vy = store.vy;
+		m_stage.vz = store.vz;
+		m_stage.mu = store.mu;
+
+		for (int k = 0; k < 3; k++) {
+			m_positionIncrement[k].assign(store.size(), 0.0);
+			m_velocityIncrement[k].assign(store.size(), 0.0);
+		}
+	}
+};
@@ -0,0 +1,231 @@
+/* Symplectic.hpp - Implementation of symplectic composition integrators (velocity Verlet and Yoshida 4th/6th/8th order).
+*/
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+namespace Symplectic {
+	enum class Scheme {
+		VELOCITY_VERLET,	// Second-order kick-drift-kick leapfrog
+		YOSHIDA4,			// Fourth-order Yoshida composition (3 substeps)
+		YOSHIDA6,			// Sixth-order Yoshida composition, solution A (7 substeps)
+		YOSHIDA8			// Eighth-order Yoshida composition, solution D (15 substeps)
+	};
+
+
+	constexpr size_t MAX_SUBSTEPS = 15;
+
+
+	/* A symmetric composition of velocity Verlet substeps. The i-th substep advances the state by weights[i] * dt. */
+	struct Composition {
+		size_t substeps;
+		std::array<double, MAX_SUBSTEPS> weights;
+	};
+
+
+	/* Builds a symmetric composition from its outer weights and its central weight.
+		@param outerWeights: The weights w_n, ..., w_1 (outermost first).
+		@param centralWeight: The central weight w_0.
+
+		@return The composition w_n, ..., w_1, w_0, w_1, ..., w_n.
+	*/
+	template<size_t N>
+	constexpr Composition MakeSymmetricComposition(const std::array<double, N> &outerWeights, double centralWeight) {
+		Composition composition{ .substeps = 2 * N + 1, .weights = {} };
+
+		for (size_t i = 0; i < N; i++) {
+			composition.weights[i] = outerWeights[i];
+			composition.weights[2 * N - i] = outerWeights[i];
+		}
+		composition.weights[N] = centralWeight;
+
+		return composition;
+	}
+
+
+	/* Gets the composition of a scheme.
+		Reference: H. Yoshida, "Construction of higher order symplectic integrators", Physics Letters A 150 (1990).
+	*/
+	constexpr Composition GetComposition(Scheme scheme) {
+		switch (scheme) {
+		case Scheme::YOSHIDA4: {
+			// w1 = 1 / (2 - 2^(1/3)),  w0 = -2^(1/3) / (2 - 2^(1/3))
+			constexpr double W1 = 1.3512071919596576;
+			constexpr double W0 = -1.7024143839193153;
+			return MakeSymmetricComposition(std::array<double, 1>{ W1 }, W0);
+		}
+
+		case Scheme::YOSHIDA6: {
+			constexpr std::array<double, 3> W = {
+				0.784513610477560,		// w3
+				0.235573213359357,		// w2
+				-1.17767998417887		// w1
+			};
+			return MakeSymmetricComposition(W, 1.0 - 2.0 * (W[0] + W[1] + W[2]));
+		}
+
+		case Scheme::YOSHIDA8: {
+			constexpr std::array<double, 7> W = {
+				0.914844246229740,		// w7
+				0.253693336566229,		// w6
+				-1.44485223686048,		// w5
+				-0.158240635368243,		// w4
+				1.93813913762276,		// w3
+				-1.96061023297549,		// w2
+				0.102799849391985		// w1
+			};
+			return MakeSymmetricComposition(W, 1.0 - 2.0 * (W[0] + W[1] + W[2] + W[3] + W[4] + W[5] + W[6]));
+		}
+
+		case Scheme::VELOCITY_VERLET:
+		default:
+			return Composition{ .substeps = 1, .weights = { 1.0 } };
+		}
+	}
+
+
+	/* Gets the number of acceleration evaluations a scheme needs per step.
+		Adjacent half-kicks of consecutive substeps are merged, so a composition of s substeps needs s + 1 evaluations.
+	*/
+	constexpr size_t GetEvaluationsPerStep(Scheme scheme) {
+		return GetComposition(scheme).substeps + 1;
+	}
+}
+
+
+/* Symplectic composition integrator for separable systems (the acceleration depends only on the position).
+	It shares its interface with RK4Integrator: the ODE system returns the time derivative of the state, of which only the velocity component (the acceleration) is used.
+	If the state has a mass, it is drifted along with the position, at the mass rate of the preceding kick. Mass rates that are constant over the step (e.g., the propellant flow of a burn) are therefore integrated exactly.
+	Symplectic integrators do not conserve energy exactly, but keep its error bounded over arbitrarily long runs at a constant step size, instead of letting it drift.
+*/
+template<typename State, typename ODESystem, Symplectic::Scheme Scheme>
+class SymplecticIntegrator {
+public:
+	SymplecticIntegrator() = default;
+	~SymplecticIntegrator() = default;
+
+	/* Integrates the state using the integrator's composition scheme.
+		@param state: The current state of the system.
+		@param t: The current time.
+		@param dt: The time step for integration.
+		@param f: The ODE system function that computes the derivatives.
+	*/
+	static void Integrate(State& state, double t, double dt, ODESystem f) {
+		static constexpr Symplectic::Composition COMPOSITION = Symplectic::GetComposition(Scheme);
+
+		double time = t;
+		double pendingKick = 0.5 * COMPOSITION.weights[0] * dt;
+
+		for (size_t i = 0; i < COMPOSITION.substeps; i++) {
+			const double h = COMPOSITION.weights[i] * dt;
+
+			// Kick (merged with the closing half-kick of the previous substep)
+			const State derivative = f(state, time);
+			state.velocity += pendingKick * derivative.velocity;
+
+			// Drift
+			state.position += h * state.velocity;
+			if constexpr (requires { state.mass; })
+				state.mass += h * derivative.mass;
+			time += h;
+
+			pendingKick = 0.5 * h + ((i + 1 < COMPOSITION.substeps) ? 0.5 * COMPOSITION.weights[i + 1] * dt : 0.0);
+		}
+
+		// Closing half-kick
+		state.velocity += pendingKick * f(state, time).velocity;
+	}
+};
+
+
+template<typename State, typename ODESystem>
+using VelocityVerletIntegrator = SymplecticIntegrator<State, ODESystem, Symplectic::Scheme::VELOCITY_VERLET>;
+
+template<typename State, typename ODESystem>
+using Yoshida4Integrator = SymplecticIntegrator<State, ODESystem, Symplectic::Scheme::YOSHIDA4>;
+
+template<typename State, typename ODESystem>
+using Yoshida6Integrator = SymplecticIntegrator<State, ODESystem, Symplectic::Scheme::YOSHIDA6>;
+
+template<typename State, typename ODESystem>
+using Yoshida8Integrator = SymplecticIntegrator<State, ODESystem, Symplectic::Scheme::YOSHIDA8>;
+
+
+
+/* Symplectic composition integrator that treats the state vectors of all bodies as a single ODE.
+	It shares its interface with NBodyRK4Integrator. Since every kick only needs the accelerations at the current positions, the store itself is advanced in place and no stage buffers are needed.
+*/
+class NBodySymplecticIntegrator {
+public:
+	NBodySymplecticIntegrator() = default;
+	~NBodySymplecticIntegrator() = default;
+
+	/* Sets the composition scheme. */
+	inline void configure(Symplectic::Scheme scheme) { m_composition = Symplectic::GetComposition(scheme); }
+
+
+	/* Integrates all bodies in a store.
+		@param store: The body store. Its acceleration arrays receive the accelerations at the end of the step.
+		@param isFixed: A mask (parallel to the store) of bodies whose states are driven externally (e.g., by SPICE). Fixed bodies act as stationary gravity sources during the step, and are not integrated.
+		@param t: The current time.
+		@param dt: The time step for integration.
+		@param f: The acceleration system, called as `f(NBodyStore &store, double t)`. It must write the accelerations of all bodies in `store` to the store's acceleration arrays.
+	*/
+	template<typename AccelerationSystem>
+	void integrate(NBodyStore &store, const std::vector<uint8_t> &isFixed, double t, double dt, AccelerationSystem &&f) {
+		double time = t;
+		double pendingKick = 0.5 * m_composition.weights[0] * dt;
+
+		for (size_t i = 0; i < m_composition.substeps; i++) {
+			const double h = m_composition.weights[i] * dt;
+
+			f(store, time);
+			kick(store, isFixed, pendingKick);
+			drift(store, isFixed, h);
+			time += h;
+
+			pendingKick = 0.5 * h + ((i + 1 < m_composition.substeps) ? 0.5 * m_composition.weights[i + 1] * dt : 0.0);
+		}
+
+		f(store, time);
+		kick(store, isFixed, pendingKick);
+	}
+
+private:
+	Symplectic::Composition m_composition = Symplectic::GetComposition(Symplectic::Scheme::VELOCITY_VERLET);
+
+
+	/* Advances the velocities of all free bodies by their current accelerations. */
+	static inline void kick(NBodyStore &store, const std::vector<uint8_t> &isFixed, double h) {
+		for (size_t i = 0; i < store.size(); i++) {
+			if (isFixed[i])
+				continue;
+
+			store.vx[i] += h * store.ax[i];
+			store.vy[i] += h * store.ay[i];
+			store.vz[i] += h * store.az[i];
+		}
+	}
+
+
+	/* Advances the positions of all free bodies by their current velocities. */
+	static inline void drift(NBodyStore &store, const std::vector<uint8_t> &isFixed, double h) {
+		for (size_t i = 0; i < store.size(); i++) {
+			if (isFixed[i])
+				continue;
+
+			store.x[i] += h * store.vx[i];
+			store.y[i] += h * store.vy[i];
+			store.z[i] += h * store.vz[i];
+		}
+	}
+};
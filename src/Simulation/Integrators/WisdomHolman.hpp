@@ -0,0 +1,519 @@
+/* WisdomHolman.hpp - Implementation of the Wisdom-Holman mixed-variable symplectic integrator, with per-body primaries.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <numeric>
+#include <algorithm>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Algorithms/Kepler/KEPLER.hpp>
+
+
+/* Wisdom-Holman integrator for systems dominated by central masses (planetary and satellite systems).
+	The motion of each body is split into its Keplerian orbit about its primary, which is advanced exactly with the universal-variable Kepler solver, and the (small) remaining interactions, which are applied as kicks. The step size is therefore limited by the perturbations rather than by the orbits themselves, and can be a sizeable fraction of the shortest orbital period.
+
+	Each body's primary is the least massive attractor whose sphere of influence (Laplace) contains it, so that, e.g., a spacecraft in low Earth orbit orbits the Earth even if the Sun is in the scene:
+		- Bodies whose primary is driven externally (e.g., by SPICE) use positions and velocities relative to it. Within a step, the primary follows its state and evaluated acceleration (to second order); it does not recoil, as its motion is prescribed.
+		- Bodies whose primary is integrated are grouped about the most massive integrated primary (the free central body), in democratic heliocentric coordinates (positions relative to the central body, velocities relative to the group's barycenter), which keeps the splitting canonical for any number of massive bodies.
+		- Bodies without a primary are advanced with a plain leapfrog (linear drifts and full kicks).
+
+	Limitation: bodies are only ever split about one free central body. In hierarchies of integrated bodies (e.g., an integrated Moon orbiting an integrated Earth orbiting the Sun), or in close encounters, the remaining interactions are no longer small compared with the Keplerian pull, and the splitting loses its accuracy. Steps whose relative perturbation exceeds MAX_PERTURBATION_RATIO are therefore refused (see integrate), and must be covered by a non-splitting integrator instead.
+
+	Sources:
+		- J. Wisdom & M. Holman, "Symplectic maps for the N-body problem", The Astronomical Journal 102 (1991).
+		- M. J. Duncan, H. F. Levison & M. H. Lee, "A multiple time step symplectic algorithm for integrating close encounters", The Astronomical Journal 116 (1998).
+		- H. D. Curtis, "Orbital Mechanics for Engineering Students", Section 8.3 (Sphere of influence).
+*/
+class NBodyWisdomHolmanIntegrator {
+public:
+	NBodyWisdomHolmanIntegrator() = default;
+	~NBodyWisdomHolmanIntegrator() = default;
+
+	static constexpr double MAX_PERTURBATION_RATIO = 0.1;		// Largest ratio of a body's perturbing acceleration to its primary's Keplerian pull for which a step is taken
+	static constexpr double MIN_ATTRACTOR_RATIO = 1e-10;		// Smallest gravitational parameter (relative to the largest one) of bodies that can be primaries
+
+	/* Integrates all bodies in a store.
+		@param store: The body store. Its acceleration arrays receive the accelerations at the end of the step.
+		@param isFixed: A mask (parallel to the store) of bodies whose states are driven externally (e.g., by SPICE). Fixed bodies move linearly with their current velocities during the step (or to second order, if they are primaries), and are not integrated.
+		@param t: The current time.
+		@param dt: The time step for integration.
+		@param f: The acceleration system, called as `f(NBodyStore &stage, double t)`. It must write the (total) accelerations of all bodies in `stage` to the stage's acceleration arrays.
+
+		@return True if the step was taken, or false if it was refused because a body's perturbations are too large for the splitting (the store is left untouched).
+	*/
+	template<typename AccelerationSystem>
+	bool integrate(NBodyStore &store, const std::vector<uint8_t> &isFixed, double t, double dt, AccelerationSystem &&f) {
+		const size_t bodyCount = store.size();
+		if (bodyCount == 0)
+			return true;
+
+		assignPrimaries(store, isFixed);
+		toRelativeCoordinates(store);
+
+
+		// Kick-(jump-drift-jump)-kick
+		evaluate(store, t, 0.0, f);
+
+		if (getMaxPerturbationRatio() > MAX_PERTURBATION_RATIO) {
+			m_refusedSteps++;
+			return false;
+		}
+
+		// Primaries that are driven externally follow their evaluated accelerations within the step
+		for (size_t i = 0; i < bodyCount; i++)
+			if (m_roles[i] == _Role::FIXED && m_isPrimary[i])
+				m_fixedAccelerations[i] = m_stage.getAcceleration(i);
+
+		kick(0.5 * dt);
+
+		jump(0.5 * dt);
+		drift(dt);
+		jump(0.5 * dt);
+
+		evaluate(store, t, dt, f);
+		kick(0.5 * dt);
+
+
+		fromRelativeCoordinates(store, dt);
+		return true;
+	}
+
+
+	/* Gets the number of Kepler drifts that failed to converge (and were replaced with linear drifts) so far. */
+	inline uint64_t getFailedDriftCount() const { return m_failedDrifts; }
+
+
+	/* Gets the number of steps refused so far (see integrate). */
+	inline uint64_t getRefusedStepCount() const { return m_refusedSteps; }
+
+private:
+	static constexpr size_t NO_BODY = std::numeric_limits<size_t>::max();
+
+	enum class _Role : uint8_t {
+		FIXED,			// Driven externally
+		CENTRAL,		// The free central body
+		DEMOCRATIC,		// Orbits the free central body (democratic heliocentric coordinates)
+		RELATIVE,		// Orbits a fixed primary (coordinates relative to the primary)
+		UNBOUND			// Has no primary (inertial coordinates)
+	};
+
+	NBodyStore m_stage;							// Stage buffer (inertial positions at which accelerations are evaluated)
+
+	std::vector<size_t> m_primaries;			// Primary of each body (or NO_BODY)
+	std::vector<uint8_t> m_isPrimary;			// Whether a body is the primary of another body
+	std::vector<_Role> m_roles;
+	std::vector<size_t> m_attractors;			// Candidate primaries, sorted by decreasing gravitational parameter
+	std::vector<double> m_influenceRadii;		// Sphere of influence radii of the candidate primaries (parallel to the store)
+
+	std::vector<glm::dvec3> m_relPositions;		// Positions relative to the primary (Q)
+	std::vector<glm::dvec3> m_relVelocities;	// Velocities relative to the central group's barycenter or to the fixed primary (V)
+	std::vector<glm::dvec3> m_fixedAccelerations;	// Accelerations of fixed primaries at the start of the step
+
+	size_t m_central = NO_BODY;					// The free central body
+
+	glm::dvec3 m_refPosition{};					// Barycenter of the central group (the free central body and the bodies orbiting it)
+	glm::dvec3 m_refVelocity{};					// Velocity of the barycenter
+	double m_groupMu = 0.0;						// Total gravitational parameter of the central group
+
+	uint64_t m_failedDrifts = 0;
+	uint64_t m_refusedSteps = 0;
+
+
+	/* Assigns each body its primary (the least massive attractor whose sphere of influence contains it), and its role in the splitting. */
+	inline void assignPrimaries(const NBodyStore &store, const std::vector<uint8_t> &isFixed) {
+		const size_t bodyCount = store.size();
+
+		m_primaries.assign(bodyCount, NO_BODY);
+		m_isPrimary.assign(bodyCount, 0);
+		m_roles.assign(bodyCount, _Role::UNBOUND);
+		m_influenceRadii.assign(bodyCount, 0.0);
+
+		const double maxMu = *std::max_element(store.mu.begin(), store.mu.end());
+		if (maxMu <= 0.0) {
+			for (size_t i = 0; i < bodyCount; i++)
+				if (isFixed[i])
+					m_roles[i] = _Role::FIXED;
+
+			m_central = NO_BODY;
+			return;
+		}
+
+
+		// Candidate primaries, from the most massive down; each candidate's sphere of influence is taken about its own primary
+		m_attractors.clear();
+		for (size_t i = 0; i < bodyCount; i++)
+			if (store.mu[i] >= MIN_ATTRACTOR_RATIO * maxMu)
+				m_attractors.push_back(i);
+
+		std::stable_sort(m_attractors.begin(), m_attractors.end(), [&store](size_t a, size_t b) { return store.mu[a] > store.mu[b]; });
+
+		for (size_t k = 0; k < m_attractors.size(); k++) {
+			const size_t j = m_attractors[k];
+			m_primaries[j] = findPrimary(store, j, k);
+
+			m_influenceRadii[j] = (m_primaries[j] == NO_BODY)
+				? std::numeric_limits<double>::infinity()
+				: glm::length(store.getPosition(j) - store.getPosition(m_primaries[j])) * std::pow(store.mu[j] / store.mu[m_primaries[j]], 0.4);
+		}
+
+		for (size_t i = 0; i < bodyCount; i++)
+			if (store.mu[i] < MIN_ATTRACTOR_RATIO * maxMu)
+				m_primaries[i] = findPrimary(store, i, m_attractors.size());
+
+
+		// The free central body is the most massive free body that is the primary of another free body
+		m_central = NO_BODY;
+		for (size_t i = 0; i < bodyCount; i++) {
+			if (isFixed[i] || m_primaries[i] == NO_BODY)
+				continue;
+
+			const size_t primary = m_primaries[i];
+			m_isPrimary[primary] = 1;
+
+			if (!isFixed[primary] && (m_central == NO_BODY || store.mu[primary] > store.mu[m_central]))
+				m_central = primary;
+		}
+
+		for (size_t i = 0; i < bodyCount; i++) {
+			if (isFixed[i])
+				m_roles[i] = _Role::FIXED;
+			else if (i == m_central)
+				m_roles[i] = _Role::CENTRAL;
+			else if (m_primaries[i] == NO_BODY)
+				m_roles[i] = _Role::UNBOUND;
+			else if (isFixed[m_primaries[i]])
+				m_roles[i] = _Role::RELATIVE;
+			else
+				m_roles[i] = _Role::DEMOCRATIC;		// Bodies orbiting another free body are split about the central body as well (see MAX_PERTURBATION_RATIO)
+		}
+	}
+
+
+	/* Finds the primary of a body among the first candidates: the one with the smallest sphere of influence that contains the body.
+		@param store: The body store.
+		@param i: The body.
+		@param candidateCount: The number of (most massive) candidates to consider.
+
+		@return The primary, or NO_BODY if there is none.
+	*/
+	inline size_t findPrimary(const NBodyStore &store, size_t i, size_t candidateCount) const {
+		const glm::dvec3 position = store.getPosition(i);
+		size_t primary = NO_BODY;
+
+		for (size_t k = 0; k < candidateCount; k++) {
+			const size_t j = m_attractors[k];
+			if (j == i || store.mu[j] <= store.mu[i])
+				continue;
+
+			const double radius = m_influenceRadii[j];
+			if (glm::length(position - store.getPosition(j)) < radius && (primary == NO_BODY || radius < m_influenceRadii[primary]))
+				primary = j;
+		}
+
+		return primary;
+	}
+
+
+	/* Converts the store's inertial state vectors to coordinates relative to each body's primary. */
+	inline void toRelativeCoordinates(const NBodyStore &store) {
+		const size_t bodyCount = store.size();
+
+		m_relPositions.assign(bodyCount, glm::dvec3(0.0));
+		m_relVelocities.assign(bodyCount, glm::dvec3(0.0));
+		m_fixedAccelerations.assign(bodyCount, glm::dvec3(0.0));
+
+		m_refPosition = glm::dvec3(0.0);
+		m_refVelocity = glm::dvec3(0.0);
+		m_groupMu = 0.0;
+
+		if (m_central != NO_BODY) {
+			for (size_t i = 0; i < bodyCount; i++) {
+				if (m_roles[i] != _Role::CENTRAL && m_roles[i] != _Role::DEMOCRATIC)
+					continue;
+
+				m_refPosition += store.mu[i] * store.getPosition(i);
+				m_refVelocity += store.mu[i] * store.getVelocity(i);
+				m_groupMu += store.mu[i];
+			}
+
+			m_refPosition /= m_groupMu;
+			m_refVelocity /= m_groupMu;
+		}
+
+		for (size_t i = 0; i < bodyCount; i++) {
+			switch (m_roles[i]) {
+			case _Role::DEMOCRATIC:
+				m_relPositions[i] = store.getPosition(i) - store.getPosition(m_central);
+				m_relVelocities[i] = store.getVelocity(i) - m_refVelocity;
+				break;
+
+			case _Role::RELATIVE:
+				m_relPositions[i] = store.getPosition(i) - store.getPosition(m_primaries[i]);
+				m_relVelocities[i] = store.getVelocity(i) - store.getVelocity(m_primaries[i]);
+				break;
+
+			case _Role::UNBOUND:
+				m_relPositions[i] = store.getPosition(i);
+				m_relVelocities[i] = store.getVelocity(i);
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+
+	/* Gets the inertial position of the free central body. */
+	inline glm::dvec3 getCentralPosition(const NBodyStore &store) const {
+		// The barycenter of the central group moves linearly (up to external kicks, which are applied to m_refVelocity)
+		glm::dvec3 weightedOffset(0.0);
+		for (size_t i = 0; i < store.size(); i++)
+			if (m_roles[i] == _Role::DEMOCRATIC)
+				weightedOffset += store.mu[i] * m_relPositions[i];
+
+		return m_refPosition - weightedOffset / m_groupMu;
+	}
+
+
+	/* Gets the inertial velocity of the free central body. */
+	inline glm::dvec3 getCentralVelocity(const NBodyStore &store) const {
+		glm::dvec3 momentum(0.0);
+		for (size_t i = 0; i < store.size(); i++)
+			if (m_roles[i] == _Role::DEMOCRATIC)
+				momentum += store.mu[i] * m_relVelocities[i];
+
+		return m_refVelocity - momentum / store.mu[m_central];
+	}
+
+
+	/* Gets the inertial position of a fixed body, tau seconds into the step. */
+	inline glm::dvec3 getFixedPosition(const NBodyStore &store, size_t i, double tau) const {
+		return store.getPosition(i) + tau * store.getVelocity(i) + (0.5 * tau * tau) * m_fixedAccelerations[i];
+	}
+
+
+	/* Gets the inertial velocity of a fixed body, tau seconds into the step. */
+	inline glm::dvec3 getFixedVelocity(const NBodyStore &store, size_t i, double tau) const {
+		return store.getVelocity(i) + tau * m_fixedAccelerations[i];
+	}
+
+
+	/* Writes the inertial state vectors at tau seconds into the step to the stage buffer, and evaluates the accelerations there.
+		Velocities are only needed by velocity-dependent forces (e.g., atmospheric drag).
+	*/
+	template<typename AccelerationSystem>
+	inline void evaluate(const NBodyStore &store, double t, double tau, AccelerationSystem &&f) {
+		const size_t bodyCount = store.size();
+		m_stage.resize(bodyCount);
+		m_stage.mu = store.mu;
+
+		glm::dvec3 centralPosition(0.0), centralVelocity(0.0);
+		if (m_central != NO_BODY) {
+			centralPosition = getCentralPosition(store);
+			centralVelocity = getCentralVelocity(store);
+		}
+
+		for (size_t i = 0; i < bodyCount; i++) {
+			switch (m_roles[i]) {
+			case _Role::FIXED:
+				m_stage.setPosition(i, getFixedPosition(store, i, tau));
+				m_stage.setVelocity(i, getFixedVelocity(store, i, tau));
+				break;
+
+			case _Role::CENTRAL:
+				m_stage.setPosition(i, centralPosition);
+				m_stage.setVelocity(i, centralVelocity);
+				break;
+
+			case _Role::DEMOCRATIC:
+				m_stage.setPosition(i, centralPosition + m_relPositions[i]);
+				m_stage.setVelocity(i, m_refVelocity + m_relVelocities[i]);
+				break;
+
+			case _Role::RELATIVE:
+				m_stage.setPosition(i, getFixedPosition(store, m_primaries[i], tau) + m_relPositions[i]);
+				m_stage.setVelocity(i, getFixedVelocity(store, m_primaries[i], tau) + m_relVelocities[i]);
+				break;
+
+			case _Role::UNBOUND:
+				m_stage.setPosition(i, m_relPositions[i]);
+				m_stage.setVelocity(i, m_relVelocities[i]);
+				break;
+			}
+		}
+
+		f(m_stage, t + tau);
+	}
+
+
+	/* Gets the acceleration of the central group's barycenter in the last evaluation (the barycenter only accelerates under forces from outside the group). */
+	inline glm::dvec3 getGroupAcceleration() const {
+		glm::dvec3 acceleration(0.0);
+		if (m_central == NO_BODY)
+			return acceleration;
+
+		for (size_t i = 0; i < m_stage.size(); i++)
+			if (m_roles[i] == _Role::CENTRAL || m_roles[i] == _Role::DEMOCRATIC)
+				acceleration += m_stage.mu[i] * m_stage.getAcceleration(i);
+
+		return acceleration / m_groupMu;
+	}
+
+
+	/* Gets the Keplerian acceleration of a body towards its primary (the central body, for democratic heliocentric coordinates). */
+	inline glm::dvec3 getKeplerAcceleration(size_t i) const {
+		static constexpr double MIN_DISTANCE_SQ = std::numeric_limits<float>::epsilon() * std::numeric_limits<float>::epsilon();
+
+		const glm::dvec3 &q = m_relPositions[i];
+		const double distanceSq = glm::dot(q, q);
+		if (distanceSq < MIN_DISTANCE_SQ)
+			return glm::dvec3(0.0);
+
+		const double primaryMu = m_stage.mu[(m_roles[i] == _Role::DEMOCRATIC) ? m_central : m_primaries[i]];
+		return -primaryMu * q / (distanceSq * std::sqrt(distanceSq));
+	}
+
+
+	/* Gets the interaction acceleration of an orbiting body in the last evaluation: its total acceleration, minus its primary's Keplerian pull and the acceleration of its reference point. */
+	inline glm::dvec3 getInteractionAcceleration(size_t i, const glm::dvec3 &groupAcceleration) const {
+		const glm::dvec3 reference = (m_roles[i] == _Role::DEMOCRATIC) ? groupAcceleration : m_stage.getAcceleration(m_primaries[i]);
+		return m_stage.getAcceleration(i) - getKeplerAcceleration(i) - reference;
+	}
+
+
+	/* Gets the largest ratio of an orbiting body's interaction acceleration to its primary's Keplerian pull in the last evaluation. */
+	inline double getMaxPerturbationRatio() const {
+		const glm::dvec3 groupAcceleration = getGroupAcceleration();
+		double maxRatio = 0.0;
+
+		for (size_t i = 0; i < m_stage.size(); i++) {
+			if (m_roles[i] != _Role::DEMOCRATIC && m_roles[i] != _Role::RELATIVE)
+				continue;
+
+			const double keplerAcceleration = glm::length(getKeplerAcceleration(i));
+			if (keplerAcceleration > 0.0)
+				maxRatio = std::max(maxRatio, glm::length(getInteractionAcceleration(i, groupAcceleration)) / keplerAcceleration);
+		}
+
+		return maxRatio;
+	}
+
+
+	/* Applies the interaction accelerations of the last evaluation. */
+	inline void kick(double h) {
+		const glm::dvec3 groupAcceleration = getGroupAcceleration();
+		m_refVelocity += h * groupAcceleration;
+
+		for (size_t i = 0; i < m_stage.size(); i++) {
+			switch (m_roles[i]) {
+			case _Role::DEMOCRATIC:
+			case _Role::RELATIVE:
+				m_relVelocities[i] += h * getInteractionAcceleration(i, groupAcceleration);
+				break;
+
+			case _Role::UNBOUND:
+				m_relVelocities[i] += h * m_stage.getAcceleration(i);
+				break;
+
+			default:
+				break;
+			}
+		}
+	}
+
+
+	/* Advances every orbiting body along its Keplerian orbit about its primary, and every unbound body along a straight line. */
+	inline void drift(double h) {
+		for (size_t i = 0; i < m_relPositions.size(); i++) {
+			if (m_roles[i] == _Role::UNBOUND) {
+				m_relPositions[i] += h * m_relVelocities[i];
+				continue;
+			}
+
+			if (m_roles[i] != _Role::DEMOCRATIC && m_roles[i] != _Role::RELATIVE)
+				continue;
+
+			const double primaryMu = m_stage.mu[(m_roles[i] == _Role::DEMOCRATIC) ? m_central : m_primaries[i]];
+
+			glm::dvec3 position, velocity;
+			if (Kepler::kepler(m_relPositions[i], m_relVelocities[i], h, primaryMu, position, velocity)) {
+				m_relPositions[i] = position;
+				m_relVelocities[i] = velocity;
+			}
+			else {
+				m_relPositions[i] += h * m_relVelocities[i];
+				m_failedDrifts++;
+			}
+		}
+
+		if (m_central != NO_BODY)
+			m_refPosition += h * m_refVelocity;
+	}
+
+
+	/* Applies the "jump" (the central body's momentum) term of the democratic heliocentric Hamiltonian. Only the free central body recoils. */
+	inline void jump(double h) {
+		if (m_central == NO_BODY)
+			return;
+
+		glm::dvec3 momentum(0.0);
+		for (size_t i = 0; i < m_relVelocities.size(); i++)
+			if (m_roles[i] == _Role::DEMOCRATIC)
+				momentum += m_stage.mu[i] * m_relVelocities[i];
+
+		const glm::dvec3 shift = h * momentum / m_stage.mu[m_central];
+		for (size_t i = 0; i < m_relPositions.size(); i++)
+			if (m_roles[i] == _Role::DEMOCRATIC)
+				m_relPositions[i] += shift;
+	}
+
+
+	/* Converts the relative coordinates at the end of the step back to inertial state vectors, and copies the last accelerations. */
+	inline void fromRelativeCoordinates(NBodyStore &store, double dt) {
+		const size_t bodyCount = store.size();
+
+		glm::dvec3 centralPosition(0.0), centralVelocity(0.0);
+		if (m_central != NO_BODY) {
+			centralPosition = getCentralPosition(store);
+			centralVelocity = getCentralVelocity(store);
+		}
+
+		for (size_t i = 0; i < bodyCount; i++) {
+			switch (m_roles[i]) {
+			case _Role::FIXED:
+				continue;
+
+			case _Role::CENTRAL:
+				store.setPosition(i, centralPosition);
+				store.setVelocity(i, centralVelocity);
+				break;
+
+			case _Role::DEMOCRATIC:
+				store.setPosition(i, centralPosition + m_relPositions[i]);
+				store.setVelocity(i, m_refVelocity + m_relVelocities[i]);
+				break;
+
+			case _Role::RELATIVE:
+				store.setPosition(i, getFixedPosition(store, m_primaries[i], dt) + m_relPositions[i]);
+				store.setVelocity(i, getFixedVelocity(store, m_primaries[i], dt) + m_relVelocities[i]);
+				break;
+
+			case _Role::UNBOUND:
+				store.setPosition(i, m_relPositions[i]);
+				store.setVelocity(i, m_relVelocities[i]);
+				break;
+			}
+
+			store.setAcceleration(i, m_stage.getAcceleration(i));
+		}
+	}
+};
@@ -0,0 +1,217 @@
+/* FiniteBurnScheduler.cpp - Finite burn scheduler implementation.
+*/
+
+#include "FiniteBurnScheduler.hpp"
+
+#include <algorithm>
+
+
+void FiniteBurnScheduler::setEngines(const std::vector<Engine> &engines, size_t bodyCount) {
+	m_engines.clear();
+
+	for (const Engine &engine : engines) {
+		if (engine.thrust <= 0.0 || engine.exhaustVelocity <= 0.0 || engine.mass <= engine.fuelMass || engine.burns.empty())
+			continue;
+
+		Engine &added = m_engines.emplace_back(engine);
+
+		std::sort(added.burns.begin(), added.burns.end(), [](const SpacecraftComponent::FiniteBurn &a, const SpacecraftComponent::FiniteBurn &b) {
+			return a.startTime < b.startTime;
+		});
+
+		for (SpacecraftComponent::FiniteBurn &burn : added.burns) {
+			if (burn.attitude == SpacecraftComponent::FiniteBurn::Attitude::INERTIAL)
+				burn.direction = glm::normalize(burn.direction);
+		}
+	}
+
+	m_burnCursors.assign(m_engines.size(), 0);
+	m_activeBurns.clear();
+	m_activeSlots.assign(bodyCount, NO_INDEX);
+}
+
+
+double FiniteBurnScheduler::getNextBoundary(double t, double tEnd) const {
+	double boundary = tEnd;
+
+	for (size_t e = 0; e < m_engines.size(); e++) {
+		const Engine &engine = m_engines[e];
+		if (engine.fuelMass <= EMPTY_FUEL_MASS)
+			continue;
+
+		// Burn starts and ends (burns are sorted by their start times, so the search stops at the first burn that starts after the boundary)
+		for (size_t k = m_burnCursors[e]; k < engine.burns.size(); k++) {
+			const SpacecraftComponent::FiniteBurn &burn = engine.burns[k];
+			const double burnEnd = burn.startTime + burn.duration;
+
+			if (burn.startTime >= boundary)
+				break;
+
+			if (burn.startTime > t)
+				boundary = burn.startTime;
+			else if (burnEnd > t)
+				boundary = std::min(boundary, burnEnd);
+		}
+
+		// Fuel exhaustion
+		if (const SpacecraftComponent::FiniteBurn *burn = GetScheduledBurn(engine, m_burnCursors[e], t)) {
+			const double massFlowRate = burn->throttle * engine.thrust / engine.exhaustVelocity;
+			const double fuelOut = t + engine.fuelMass / massFlowRate;
+
+			if (fuelOut > t)
+				boundary = std::min(boundary, fuelOut);
+		}
+	}
+
+	return boundary;
+}
+
+
+void FiniteBurnScheduler::beginSegment(double t, double et, const NBodyStore &store) {
+	m_segmentStart = t;
+	m_segmentStartET = et;
+
+	for (const _ActiveBurn &active : m_activeBurns)
+		m_activeSlots[m_engines[active.engine].bodyIndex] = NO_INDEX;
+	m_activeBurns.clear();
+
+
+	for (size_t e = 0; e < m_engines.size(); e++) {
+		const Engine &engine = m_engines[e];
+
+		// Skip the burns that have ended
+		size_t &cursor = m_burnCursors[e];
+		while (cursor < engine.burns.size() && engine.burns[cursor].startTime + engine.burns[cursor].duration <= t)
+			cursor++;
+
+		if (engine.fuelMass <= EMPTY_FUEL_MASS)
+			continue;
+
+		const SpacecraftComponent::FiniteBurn *burn = GetScheduledBurn(engine, cursor, t);
+		if (!burn)
+			continue;
+
+		_ActiveBurn active{
+			.engine = static_cast<uint32_t>(e),
+			.referenceBody = NO_INDEX,
+			.attitude = burn->attitude,
+			.direction = burn->direction,
+			.thrust = burn->throttle * engine.thrust,
+			.massFlowRate = burn->throttle * engine.thrust / engine.exhaustVelocity,
+			.initialMass = engine.mass
+		};
+
+		// Velocity-aligned burns follow the velocity relative to the body that exerts the strongest point-mass acceleration on the thruster
+		if (active.attitude != SpacecraftComponent::FiniteBurn::Attitude::INERTIAL) {
+			const glm::dvec3 position = store.getPosition(engine.bodyIndex);
+			double maxPull = 0.0;
+
+			for (size_t j = 0; j < store.size(); j++) {
+				if (j == engine.bodyIndex || store.mu[j] <= 0.0)
+					continue;
+
+				const glm::dvec3 offset = position - store.getPosition(j);
+				const double pull = store.mu[j] / glm::dot(offset, offset);
+
+				if (pull > maxPull) {
+					maxPull = pull;
+					active.referenceBody = static_cast<uint32_t>(j);
+				}
+			}
+		}
+
+		m_activeSlots[engine.bodyIndex] = static_cast<uint32_t>(m_activeBurns.size());
+		m_activeBurns.push_back(active);
+	}
+}
+
+
+bool FiniteBurnScheduler::endSegment(double t) {
+	const double duration = t - m_segmentStart;
+	bool isFuelConsumed = false;
+
+	for (const _ActiveBurn &active : m_activeBurns) {
+		Engine &engine = m_engines[active.engine];
+
+		double fuelUsed = std::min(engine.fuelMass, active.massFlowRate * duration);
+
+		// Segments that end at fuel exhaustion empty the tank exactly (rather than leaving a round-off residue that would start another segment)
+		if (engine.fuelMass - fuelUsed <= EMPTY_FUEL_MASS)
+			fuelUsed = engine.fuelMass;
+
+		engine.fuelMass -= fuelUsed;
+		engine.mass -= fuelUsed;
+
+		if (fuelUsed > 0.0)
+			isFuelConsumed = true;
+	}
+
+	return isFuelConsumed;
+}
+
+
+void FiniteBurnScheduler::apply(NBodyStore &stage, double t) const {
+	for (const _ActiveBurn &active : m_activeBurns) {
+		const uint32_t i = m_engines[active.engine].bodyIndex;
+		const double mass = active.initialMass - active.massFlowRate * (t - m_segmentStartET);
+
+		const glm::dvec3 acceleration = ComputeThrust(active, stage, stage.getVelocity(i), mass);
+
+		stage.ax[i] += acceleration.x;
+		stage.ay[i] += acceleration.y;
+		stage.az[i] += acceleration.z;
+	}
+}
+
+
+glm::dvec3 FiniteBurnScheduler::computeAcceleration(uint32_t bodyIndex, const NBodyStore &sources, const glm::dvec3 &velocity, double mass) const {
+	if (bodyIndex >= m_activeSlots.size() || m_activeSlots[bodyIndex] == NO_INDEX)
+		return glm::dvec3(0.0);
+
+	return ComputeThrust(m_activeBurns[m_activeSlots[bodyIndex]], sources, velocity, mass);
+}
+
+
+double FiniteBurnScheduler::getMassRate(uint32_t bodyIndex) const {
+	if (bodyIndex >= m_activeSlots.size() || m_activeSlots[bodyIndex] == NO_INDEX)
+		return 0.0;
+
+	return -m_activeBurns[m_activeSlots[bodyIndex]].massFlowRate;
+}
+
+
+const SpacecraftComponent::FiniteBurn *FiniteBurnScheduler::GetScheduledBurn(const Engine &engine, size_t firstBurn, double t) {
+	for (size_t k = firstBurn; k < engine.burns.size(); k++) {
+		const SpacecraftComponent::FiniteBurn &burn = engine.burns[k];
+
+		if (burn.startTime > t)
+			break;
+
+		if (t < burn.startTime + burn.duration && burn.throttle > 0.0)
+			return &burn;
+	}
+
+	return nullptr;
+}
+
+
+glm::dvec3 FiniteBurnScheduler::ComputeThrust(const _ActiveBurn &burn, const NBodyStore &sources, const glm::dvec3 &velocity, double mass) {
+	glm::dvec3 direction = burn.direction;
+
+	if (burn.attitude != SpacecraftComponent::FiniteBurn::Attitude::INERTIAL) {
+		glm::dvec3 relVelocity = velocity;
+		if (burn.referenceBody != NO_INDEX)
+			relVelocity -= sources.getVelocity(burn.referenceBody);
+
+		// The thrust direction is undefined at rest relative to the reference body
+		const double speed = glm::length(relVelocity);
+		if (speed <= 0.0)
+			return glm::dvec3(0.0);
+
+		direction = relVelocity / speed;
+		if (burn.attitude == SpacecraftComponent::FiniteBurn::Attitude::ANTI_VELOCITY)
+			direction = -direction;
+	}
+
+	return (burn.thrust / mass) * direction;
+}
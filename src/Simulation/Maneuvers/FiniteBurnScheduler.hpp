@@ -0,0 +1,139 @@
+/* FiniteBurnScheduler.hpp - Schedules the finite burns of thrusters and computes their thrust.
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Core/Data/Constants.h>
+
+#include <Engine/Registry/ECS/Components/SpacecraftComponents.hpp>
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+/* Splits simulation time into segments over which every thruster is either firing or idle, and computes the thrust of the firing thrusters.
+	Thrust switches on and off discontinuously (at burn starts, burn ends, and fuel exhaustion). Integrating across such a switch either smears the burn (fixed-step integrators) or forces adaptive integrators to shrink their steps until they resolve it. Instead, integration is split at every switch, so that the thrust is smooth within each segment.
+	Within a segment, the thrust and mass flow of every firing thruster are constant; the mass therefore decreases linearly with time.
+*/
+class FiniteBurnScheduler {
+public:
+	/* A thruster with scheduled burns. */
+	struct Engine {
+		uint32_t bodyIndex;				// Index of the thrusting body in the body store
+		double thrust;					// Max thrust (N)
+		double exhaustVelocity;			// Effective exhaust velocity (specific impulse * standard gravity; m/s)
+		double mass;					// Total mass of the body (kg)
+		double fuelMass;				// Remaining fuel mass (kg)
+
+		std::vector<SpacecraftComponent::FiniteBurn> burns;
+	};
+
+
+	FiniteBurnScheduler() = default;
+	~FiniteBurnScheduler() = default;
+
+
+	/* Sets the thrusters. Any segment in progress is discarded.
+		@param engines: The thrusters. Thrusters without burns, thrust or exhaust velocity, and thrusters whose fuel outweighs their body, are ignored.
+		@param bodyCount: The number of bodies in the body store.
+	*/
+	void setEngines(const std::vector<Engine> &engines, size_t bodyCount);
+
+
+	/* Gets the end of the segment that starts at a given time: the first burn start, burn end, or fuel exhaustion after it.
+		@param t: The start of the segment, in simulation time.
+		@param tEnd: The latest end of the segment, in simulation time.
+
+		@return The end of the segment (at most tEnd).
+	*/
+	double getNextBoundary(double t, double tEnd) const;
+
+
+	/* Starts a segment, and determines the thrusters that fire during it.
+		@param t: The start of the segment, in simulation time.
+		@param et: The start of the segment, in Ephemeris Time.
+		@param store: The body store, from which the reference body of velocity-aligned burns is chosen.
+	*/
+	void beginSegment(double t, double et, const NBodyStore &store);
+
+
+	/* Ends the current segment, and consumes the fuel burned during it.
+		@param t: The end of the segment, in simulation time.
+
+		@return Whether any fuel was consumed (i.e., whether the mass of any body has changed).
+	*/
+	bool endSegment(double t);
+
+
+	/* Adds the thrust accelerations of the firing thrusters to the acceleration arrays of a store. The mass of each thruster is taken from its (linear) mass flow since the start of the segment.
+		@param stage: The body store (or a stage buffer parallel to it). Its velocities must be those at which the accelerations are evaluated.
+		@param t: The time at which the accelerations are evaluated, in Ephemeris Time.
+	*/
+	void apply(NBodyStore &stage, double t) const;
+
+
+	/* Computes the thrust acceleration of a single body, whose mass is integrated by the caller.
+		@param bodyIndex: The index of the body in the body store.
+		@param sources: The body store that provides the state of the reference body.
+		@param velocity: The velocity of the body (m/s).
+		@param mass: The mass of the body (kg).
+
+		@return The acceleration (m/s^2), or 0 if the body is not thrusting.
+	*/
+	glm::dvec3 computeAcceleration(uint32_t bodyIndex, const NBodyStore &sources, const glm::dvec3 &velocity, double mass) const;
+
+
+	/* Gets the mass flow rate of a body (kg/s; negative while thrusting, 0 otherwise). */
+	double getMassRate(uint32_t bodyIndex) const;
+
+
+	/* Is any thruster firing during the current segment? */
+	inline bool isActive() const { return !m_activeBurns.empty(); }
+
+	/* Does any thruster have scheduled burns? */
+	inline bool hasEngines() const { return !m_engines.empty(); }
+
+	inline const std::vector<Engine> &getEngines() const { return m_engines; }
+
+
+	static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+	static constexpr double EMPTY_FUEL_MASS = 1e-9;		// Fuel mass (kg) below which a thruster is considered empty
+
+private:
+	/* A thruster firing during the current segment. */
+	struct _ActiveBurn {
+		uint32_t engine;				// Index in m_engines
+		uint32_t referenceBody;			// Body whose relative velocity sets the thrust direction (velocity-aligned attitudes), or NO_INDEX
+		SpacecraftComponent::FiniteBurn::Attitude attitude;
+		glm::dvec3 direction;			// Unit thrust direction (inertial attitude)
+		double thrust;					// Thrust (N)
+		double massFlowRate;			// Propellant mass flow rate (kg/s)
+		double initialMass;				// Mass at the start of the segment (kg)
+	};
+
+	std::vector<Engine> m_engines;
+	std::vector<_ActiveBurn> m_activeBurns;
+	std::vector<uint32_t> m_activeSlots;		// Body index -> index in m_activeBurns (or NO_INDEX)
+	std::vector<size_t> m_burnCursors;			// Index of the first burn of each thruster that has not ended yet (parallel to m_engines)
+
+	double m_segmentStart = 0.0;				// Start of the current segment, in simulation time
+	double m_segmentStartET = 0.0;				// Start of the current segment, in Ephemeris Time
+
+
+	/* Gets the burn of a thruster that is scheduled at a given time, or nullptr.
+		@param engine: The thruster.
+		@param firstBurn: The index of the first burn to consider.
+		@param t: The time, in simulation time.
+	*/
+	static const SpacecraftComponent::FiniteBurn *GetScheduledBurn(const Engine &engine, size_t firstBurn, double t);
+
+
+	/* Computes the thrust acceleration of a firing thruster. */
+	static glm::dvec3 ComputeThrust(const _ActiveBurn &burn, const NBodyStore &sources, const glm::dvec3 &velocity, double mass);
+};
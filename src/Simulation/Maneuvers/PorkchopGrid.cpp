@@ -0,0 +1,259 @@
+/* PorkchopGrid.cpp - Porkchop grid implementation.
+*/
+
+#include "PorkchopGrid.hpp"
+
+#include <chrono>
+#include <algorithm>
+
+
+void PorkchopGrid::sample(EphemerisCache &cache) {
+	LOG_ASSERT(m_config.departureSteps > 0 && m_config.arrivalSteps > 0, "Cannot sample porkchop grid ephemerides: The grid is empty!");
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	const uint32_t departureHandle = cache.addBody(m_config.departureBody);
+	const uint32_t arrivalHandle = cache.addBody(m_config.arrivalBody);
+	const uint32_t centralHandle = cache.addBody(m_config.centralBody);
+
+
+	// Samples a body's states relative to the central body at the epochs of a window
+	auto sampleBody = [&](uint32_t handle, const std::string &bodyName, double start, double end, uint32_t steps, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities) {
+		positions.resize(steps);
+		velocities.resize(steps);
+
+		for (uint32_t i = 0; i < steps; i++) {
+			const double et = GetEpoch(start, end, steps, i);
+			const std::array<double, 6> body = cache.getBodyState(handle, et);
+			const std::array<double, 6> central = cache.getBodyState(centralHandle, et);
+
+			positions[i] = glm::dvec3(body[0] - central[0], body[1] - central[1], body[2] - central[2]);
+			velocities[i] = glm::dvec3(body[3] - central[3], body[4] - central[4], body[5] - central[5]);
+
+			// A body coinciding with the central body has no state in the loaded kernels (or is the central body)
+			if (glm::length(positions[i]) < R_EPSILON)
+				throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot sample porkchop grid ephemerides: The state of " + enquote(bodyName) + " relative to " + enquote(m_config.centralBody) + " is unavailable!");
+		}
+	};
+
+	Ephemerides ephemerides;
+	sampleBody(departureHandle, m_config.departureBody, m_config.departureStart, m_config.departureEnd, m_config.departureSteps, ephemerides.departurePositions, ephemerides.departureVelocities);
+	sampleBody(arrivalHandle, m_config.arrivalBody, m_config.arrivalStart, m_config.arrivalEnd, m_config.arrivalSteps, ephemerides.arrivalPositions, ephemerides.arrivalVelocities);
+
+	setEphemerides(ephemerides);
+
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats.ephemerisQueries += 2 * (static_cast<uint64_t>(m_config.departureSteps) + m_config.arrivalSteps);
+	m_stats.samplingTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+
+void PorkchopGrid::setEphemerides(const Ephemerides &ephemerides) {
+	LOG_ASSERT(ephemerides.departurePositions.size() == m_config.departureSteps && ephemerides.departureVelocities.size() == m_config.departureSteps
+		&& ephemerides.arrivalPositions.size() == m_config.arrivalSteps && ephemerides.arrivalVelocities.size() == m_config.arrivalSteps,
+		"Cannot set porkchop grid ephemerides: The number of states does not match the grid!");
+
+	m_ephemerides = ephemerides;
+}
+
+
+void PorkchopGrid::solve(ThreadPool &pool, uint32_t maxThreads, std::stop_token stopToken) {
+	const size_t rowCount = m_config.departureSteps;
+	const size_t columnCount = m_config.arrivalSteps;
+
+	LOG_ASSERT(m_ephemerides.departurePositions.size() == rowCount && m_ephemerides.arrivalPositions.size() == columnCount, "Cannot solve porkchop grid: The states of the bodies have not been sampled!");
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_status = Status::SOLVING;
+		m_cells.assign(rowCount * columnCount, Cell());
+		m_publishedRows.clear();
+	}
+	m_solvedCells.store(0);
+
+	auto startTime = std::chrono::steady_clock::now();
+
+
+	// Rows are tasks: each is solved into local storage, then published at once (so that readers only ever see complete rows)
+	std::vector<_RowStatistics> rowStats(rowCount);
+	std::atomic<uint64_t> solvedRows{ 0 };
+
+	pool.parallelFor(rowCount,
+		[&](size_t row) {
+			if (stopToken.stop_requested())
+				return;
+
+			std::vector<Cell> cells(columnCount);
+			std::vector<Lambert::Solution> solutions;
+			solutions.reserve(1 + 2 * static_cast<size_t>(std::max(m_config.maxRevolutions, 0)));
+
+			solveRow(row, cells.data(), solutions, rowStats[row]);
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				std::copy(cells.begin(), cells.end(), m_cells.begin() + row * columnCount);
+				m_publishedRows.push_back(static_cast<uint32_t>(row));
+			}
+
+			m_solvedCells.fetch_add(columnCount);
+			solvedRows.fetch_add(1);
+		},
+		maxThreads
+	);
+
+
+	const double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for (const _RowStatistics &stats : rowStats) {
+		m_stats.transferCells += stats.transferCells;
+		m_stats.solutions += stats.solutions;
+		m_stats.iterations += stats.iterations;
+	}
+	m_stats.cells += solvedRows.load() * columnCount;
+	m_stats.solvingTime += time;
+
+	m_status = (solvedRows.load() == rowCount) ? Status::COMPLETE : Status::CANCELLED;
+}
+
+
+void PorkchopGrid::solveRow(size_t row, Cell *cells, std::vector<Lambert::Solution> &solutions, _RowStatistics &stats) const {
+	const double departureET = getDepartureET(row);
+	const glm::dvec3 &r1 = m_ephemerides.departurePositions[row];
+	const glm::dvec3 &departureVelocity = m_ephemerides.departureVelocities[row];
+
+	for (size_t column = 0; column < m_config.arrivalSteps; column++) {
+		const double timeOfFlight = getArrivalET(column) - departureET;
+		if (timeOfFlight < MIN_TIME_OF_FLIGHT)
+			continue;
+
+		if (!Lambert::izzo(r1, m_ephemerides.arrivalPositions[column], timeOfFlight, m_config.gravParam, m_config.isRetrograde, m_config.maxRevolutions, solutions))
+			continue;
+
+		const glm::dvec3 &arrivalVelocity = m_ephemerides.arrivalVelocities[column];
+
+		// Keep the solution with the lowest total excess speed
+		double bestCost = std::numeric_limits<double>::infinity();
+		Cell &cell = cells[column];
+
+		for (const Lambert::Solution &solution : solutions) {
+			const double departureVInf = glm::length(solution.v1 - departureVelocity);
+			const double arrivalVInf = glm::length(solution.v2 - arrivalVelocity);
+
+			if (departureVInf + arrivalVInf < bestCost) {
+				bestCost = departureVInf + arrivalVInf;
+				cell.c3 = departureVInf * departureVInf;
+				cell.arrivalVInf = arrivalVInf;
+				cell.revolutions = static_cast<int8_t>(solution.revolutions);
+			}
+
+			stats.iterations += solution.iterations;
+		}
+
+		stats.transferCells++;
+		stats.solutions += solutions.size();
+	}
+}
+
+
+void PorkchopGrid::start(const Config &config, std::shared_ptr<CoordinateSystem> coordSystem, uint32_t threadCount) {
+	LOG_ASSERT(coordSystem, "Cannot start porkchop grid evaluation: No coordinate system!");
+
+	cancel();
+
+	m_config = config;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_status = Status::SAMPLING;
+		m_error.clear();
+		m_stats = Statistics();
+		m_cells.clear();
+		m_publishedRows.clear();
+	}
+	m_solvedCells.store(0);
+
+	if (m_pool.getThreadCount() != threadCount || threadCount == 0)
+		m_pool.init("PORKCHOP_SOLVER", threadCount);
+
+	if (!m_worker)
+		m_worker = ThreadManager::CreateThread("PORKCHOP");
+
+	m_worker->set([this, coordSystem](std::stop_token stopToken) mutable {
+		try {
+			// The cache (and thus the coordinate system) is released as soon as the states are sampled
+			{
+				EphemerisCache cache;
+				cache.init(coordSystem, true, Solvers::DEFAULT_EPHEMERIS_POSITION_TOLERANCE, Solvers::DEFAULT_EPHEMERIS_ROTATION_TOLERANCE, false);
+				coordSystem.reset();
+
+				sample(cache);
+			}
+
+			if (stopToken.stop_requested()) {
+				setStatus(Status::CANCELLED);
+				return;
+			}
+
+			solve(m_pool, 0, stopToken);
+
+			Statistics stats = getStatistics();
+			Log::Print(Log::T_INFO, __FUNCTION__, "Solved " + std::to_string(stats.cells) + " porkchop grid cells (" + std::to_string(stats.transferCells) + " with transfers) at " + std::to_string(static_cast<uint64_t>(stats.getCellsPerSecond())) + " cells/s.");
+		}
+		catch (const std::exception &e) {
+			Log::Print(Log::T_ERROR, __FUNCTION__, "Porkchop grid evaluation failed: " + std::string(e.what()));
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_status = Status::FAILED;
+			m_error = e.what();
+		}
+	});
+
+	m_worker->start();
+}
+
+
+void PorkchopGrid::cancel() {
+	if (!m_worker)
+		return;
+
+	m_worker->requestStop();
+	m_worker->waitForStop();
+}
+
+
+size_t PorkchopGrid::fetchRows(std::vector<Cell> &cells, size_t &cursor) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	const size_t columnCount = m_config.arrivalSteps;
+	if (cells.size() != m_cells.size())
+		cells.assign(m_cells.size(), Cell());
+
+	const size_t begin = std::min(cursor, m_publishedRows.size());
+	for (size_t i = begin; i < m_publishedRows.size(); i++) {
+		const size_t row = m_publishedRows[i];
+		std::copy_n(m_cells.begin() + row * columnCount, columnCount, cells.begin() + row * columnCount);
+	}
+
+	cursor = m_publishedRows.size();
+	return cursor - begin;
+}
+
+
+PorkchopGrid::Status PorkchopGrid::getStatus() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_status;
+}
+
+
+std::string PorkchopGrid::getError() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_error;
+}
+
+
+PorkchopGrid::Statistics PorkchopGrid::getStatistics() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
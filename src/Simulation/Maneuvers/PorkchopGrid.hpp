@@ -0,0 +1,221 @@
+/* PorkchopGrid.hpp - Grids of Lambert transfers between two bodies, over departure and arrival windows (porkchop plots).
+	Sources:
+		- D. Izzo, "Revisiting Lambert's problem", Celestial Mechanics and Dynamical Astronomy 121 (2015).
+		- D. A. Vallado, "Fundamentals of Astrodynamics and Applications", 4th ed., 2013 (§7.6 Lambert's problem, §12.4 interplanetary transfers).
+*/
+
+#pragma once
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstdint>
+#include <stop_token>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+#include <Core/Application/Threading/WorkerThread.hpp>
+#include <Core/Application/Threading/ThreadManager.hpp>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Systems/CoordinateSystem.hpp>
+#include <Simulation/Systems/EphemerisCache.hpp>
+#include <Simulation/Algorithms/Lambert/LAMBERT.hpp>
+
+
+/* Evaluates the transfers from a departure body to an arrival body, around a central body, for every pair of departure and arrival epochs of a grid.
+	Every cell of the grid (a row per departure epoch, a column per arrival epoch) is a Lambert problem between the positions of the bodies, relative to the central body. Its solutions (including multi-revolution ones, up to Config::maxRevolutions) are rated by the sum of their hyperbolic excess speeds at departure and arrival, and the best one is kept: its departure characteristic energy (C3) and arrival excess speed (v∞) are the quantities of porkchop plots.
+	The states of the bodies are sampled once per row and column (from an EphemerisCache, rather than once per cell), and rows are solved across a thread pool. Rows are published as they complete, so that a plot can fill in while the grid is being solved (see PorkchopGrid::fetchRows).
+*/
+class PorkchopGrid {
+public:
+	/* Evaluation status. */
+	enum class Status : uint8_t {
+		IDLE,			// Nothing evaluated yet
+		SAMPLING,		// Sampling the states of the bodies
+		SOLVING,		// Solving cells
+		COMPLETE,		// Every cell is solved
+		CANCELLED,		// Cancelled before completion (the solved rows remain available)
+		FAILED			// Failed (see PorkchopGrid::getError)
+	};
+
+
+	/* Grid parameters. */
+	struct Config {
+		std::string departureBody = "EARTH";		// SPICE ID of the departure body
+		std::string arrivalBody = "MARS";			// SPICE ID of the arrival body
+		std::string centralBody = "SUN";			// SPICE ID of the central body of the transfers
+		double gravParam = 1.32712440018e+20;		// Gravitational parameter of the central body (m^3/s^2)
+
+		double departureStart = 0.0;				// Start of the departure window, in Ephemeris Time
+		double departureEnd = 0.0;					// End of the departure window, in Ephemeris Time
+		double arrivalStart = 0.0;					// Start of the arrival window, in Ephemeris Time
+		double arrivalEnd = 0.0;					// End of the arrival window, in Ephemeris Time
+		uint32_t departureSteps = 128;				// Departure epochs (rows)
+		uint32_t arrivalSteps = 128;				// Arrival epochs (columns)
+
+		int maxRevolutions = 0;						// Maximum complete revolutions of transfers
+		bool isRetrograde = false;					// Whether transfers are retrograde
+	};
+
+
+	/* The best transfer of a cell. */
+	struct Cell {
+		double c3 = std::numeric_limits<double>::quiet_NaN();				// Characteristic energy at departure, i.e., the squared hyperbolic excess speed (m^2/s^2)
+		double arrivalVInf = std::numeric_limits<double>::quiet_NaN();		// Hyperbolic excess speed at arrival (m/s)
+		int8_t revolutions = NO_TRANSFER;									// Complete revolutions of the transfer, or NO_TRANSFER if the cell has none (or is not solved yet)
+
+		inline bool hasTransfer() const { return revolutions != NO_TRANSFER; }
+	};
+
+
+	/* The states of the bodies at the epochs of the grid, relative to the central body. */
+	struct Ephemerides {
+		std::vector<glm::dvec3> departurePositions;		// Departure body, at every departure epoch (m)
+		std::vector<glm::dvec3> departureVelocities;	// (m/s)
+		std::vector<glm::dvec3> arrivalPositions;		// Arrival body, at every arrival epoch (m)
+		std::vector<glm::dvec3> arrivalVelocities;		// (m/s)
+	};
+
+
+	/* Evaluation statistics. */
+	struct Statistics {
+		uint64_t cells = 0;					// Cells solved
+		uint64_t transferCells = 0;			// Cells with a transfer
+		uint64_t solutions = 0;				// Lambert solutions found
+		uint64_t iterations = 0;			// Householder iterations of the solutions
+		uint64_t ephemerisQueries = 0;		// States sampled
+		double samplingTime = 0.0;			// Time spent sampling states (s)
+		double solvingTime = 0.0;			// Time spent solving cells (s)
+
+		/* Gets the number of cells solved per second. */
+		inline double getCellsPerSecond() const { return (solvingTime > 0.0) ? cells / solvingTime : 0.0; }
+	};
+
+
+	static constexpr int8_t NO_TRANSFER = -1;
+	static constexpr double MIN_TIME_OF_FLIGHT = 3600.0;		// Shortest time of flight of a cell with a transfer (s)
+
+
+	PorkchopGrid() = default;
+	~PorkchopGrid() { cancel(); }
+
+	PorkchopGrid(const PorkchopGrid &) = delete;
+	PorkchopGrid &operator=(const PorkchopGrid &) = delete;
+
+
+	/* Sets the grid parameters. The grid must not be evaluating in the background. */
+	inline void setConfig(const Config &config) { m_config = config; }
+	inline const Config &getConfig() const { return m_config; }
+
+
+	/* Samples the states of the bodies at the epochs of the grid.
+		@param cache: The ephemeris cache queried (from this thread only).
+	*/
+	void sample(EphemerisCache &cache);
+
+
+	/* Sets the states of the bodies at the epochs of the grid (instead of sampling them).
+		@param ephemerides: The states (departure states per row, arrival states per column).
+	*/
+	void setEphemerides(const Ephemerides &ephemerides);
+
+
+	/* Solves every cell of the grid, publishing rows as they complete. Blocks until every cell is solved, or the evaluation is cancelled.
+		@param pool: The thread pool across which rows are shared.
+		@param maxThreads (optional): The maximum number of threads to use (0: the whole pool).
+		@param stopToken (optional): The token whose stop request cancels the evaluation.
+	*/
+	void solve(ThreadPool &pool, uint32_t maxThreads = 0, std::stop_token stopToken = {});
+
+
+	/* Evaluates a grid in the background: samples the states of the bodies from a dedicated ephemeris cache, then solves the cells. Any evaluation in progress is cancelled first.
+		@param config: The grid parameters.
+		@param coordSystem: The coordinate system whose kernels provide the states. It is only held while sampling.
+		@param threadCount: The number of threads solving cells (0: the number of hardware threads).
+	*/
+	void start(const Config &config, std::shared_ptr<CoordinateSystem> coordSystem, uint32_t threadCount);
+
+
+	/* Cancels the evaluation in progress (if any), and waits for it to stop. */
+	void cancel();
+
+
+	/* Copies the rows published since the last call.
+		@param cells [out]: The cells of the grid (row-major), resized to the grid if needed. Only the published rows are written.
+		@param cursor [in/out]: The number of rows already copied by previous calls (0 for the first call of an evaluation), which receives the new number.
+
+		@return The number of rows copied.
+	*/
+	size_t fetchRows(std::vector<Cell> &cells, size_t &cursor);
+
+
+	/* Gets the epoch of a row or column of the grid.
+		@param start, end: The window, in Ephemeris Time.
+		@param steps: The number of epochs in the window.
+		@param index: The index of the epoch.
+
+		@return The epoch, in Ephemeris Time.
+	*/
+	static inline double GetEpoch(double start, double end, uint32_t steps, size_t index) {
+		return (steps > 1) ? start + (end - start) * static_cast<double>(index) / (steps - 1) : start;
+	}
+
+	inline double getDepartureET(size_t row) const { return GetEpoch(m_config.departureStart, m_config.departureEnd, m_config.departureSteps, row); }
+	inline double getArrivalET(size_t column) const { return GetEpoch(m_config.arrivalStart, m_config.arrivalEnd, m_config.arrivalSteps, column); }
+
+
+	/* Gets the fraction of the cells solved (from 0 to 1). */
+	inline float getProgress() const {
+		const uint64_t cellCount = static_cast<uint64_t>(m_config.departureSteps) * m_config.arrivalSteps;
+		return (cellCount > 0) ? static_cast<float>(m_solvedCells.load()) / cellCount : 0.0f;
+	}
+
+	Status getStatus();
+	std::string getError();
+	Statistics getStatistics();
+
+private:
+	Config m_config;
+	Ephemerides m_ephemerides;
+
+	// Published results (guarded by m_mutex)
+	std::mutex m_mutex;
+	Status m_status = Status::IDLE;
+	std::string m_error;
+	Statistics m_stats;
+	std::vector<Cell> m_cells;
+	std::vector<uint32_t> m_publishedRows;		// Rows, in the order they were published
+	std::atomic<uint64_t> m_solvedCells{ 0 };
+
+	// Background evaluation
+	std::shared_ptr<WorkerThread> m_worker;
+	ThreadPool m_pool;
+
+
+	/* Per-row statistics (merged once the rows complete). */
+	struct _RowStatistics {
+		uint64_t transferCells = 0;
+		uint64_t solutions = 0;
+		uint64_t iterations = 0;
+	};
+
+
+	/* Solves the cells of a row.
+		@param row: The index of the row.
+		@param cells [out]: The cells of the row.
+		@param solutions: Scratch storage of Lambert solutions.
+		@param stats [out]: The row's statistics.
+	*/
+	void solveRow(size_t row, Cell *cells, std::vector<Lambert::Solution> &solutions, _RowStatistics &stats) const;
+
+
+	inline void setStatus(Status status) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_status = status;
+	}
+};
@@ -9,6 +9,10 @@
 
 #include <Core/Data/Physics.hpp>
 
+#include <Simulation/Gravity/BarnesHut.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Gravity/GravityKernels.hpp>
+
 
 namespace ODE {
 	using namespace Physics;
@@ -85,4 +89,36 @@ namespace ODE {
 			};
 		}
 	};
+
+
+	/* Direct-sum N-body gravity over a structure-of-arrays body store, evaluated with the widest SIMD kernel supported by the host CPU. */
+	struct VectorizedNBody {
+		const NBodyStore *bodies;
+		uint32_t bodyIndex;			// The index of this body in the store (its own contribution is ignored).
+
+
+		State operator()(const State &state, double t) const {
+			return State{
+				.position = state.velocity,																// dr/dt = v(t)
+				.velocity = GravityKernels::ComputeAccelerationAt(*bodies, state.position, bodyIndex)	// dv/dt = a(t)
+			};
+		}
+	};
+
+
+	/* N-body gravity, approximated with a Barnes-Hut octree.
+		The tree must be (re)built over the bodies' positions before the ODE is evaluated, and is treated as fixed for the duration of a step.
+	*/
+	struct BarnesHutNBody {
+		const BarnesHutTree *tree;
+		uint32_t bodyIndex;			// The index of this body in the tree (its own contribution is ignored).
+
+
+		State operator()(const State &state, double t) const {
+			return State{
+				.position = state.velocity,											// dr/dt = v(t)
+				.velocity = tree->computeAcceleration(state.position, bodyIndex)	// dv/dt = a(t)
+			};
+		}
+	};
 }
\ No newline at end of file
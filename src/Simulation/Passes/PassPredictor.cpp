@@ -0,0 +1,385 @@
+/* PassPredictor.cpp - Pass prediction implementation.
+*/
+
+#include "PassPredictor.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+
+
+#include <Core/Utils/SPICEUtils.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+
+#include <Simulation/Systems/CoordinateSystem.hpp>
+#include <Simulation/Algorithms/RootFinding.hpp>
+#include <Simulation/Propagators/SGP4/SDP4Checkpoints.hpp>
+
+
+namespace {
+	constexpr double WGS84_RADIUS = 6378.137;						// Equatorial radius of the WGS-84 ellipsoid (km)
+	constexpr double WGS84_FLATTENING = 1.0 / 298.257223563;
+	const double FILTER_MARGIN = 2.0 * PI / 180.0;					// Margin of the geometric filter, covering the differences between mean and osculating inclinations, and between geodetic and geocentric latitudes (rad)
+
+
+	/* The observation of a satellite from a site. */
+	struct _Observation {
+		glm::dvec3 range;				// Position relative to the site, in ECEF (km)
+		double elevationFunction;		// sin(elevation) - sin(elevation mask): positive when the satellite is in view
+		double elevationRate;			// Rate of sin(elevation) (1/s), of the same sign as the elevation rate
+	};
+
+
+	/* Observes a satellite from a site.
+		@param position: The ECEF position of the satellite (km).
+		@param velocity: The ECEF velocity of the satellite (km/s).
+	*/
+	template<typename SiteFrame>
+	inline _Observation Observe(const glm::dvec3 &position, const glm::dvec3 &velocity, const SiteFrame &site) {
+		const glm::dvec3 range = position - site.position;
+		const double distance = glm::length(range);
+		const double height = glm::dot(range, site.up);
+
+		return _Observation{
+			.range = range,
+			.elevationFunction = height / distance - site.sinMinElevation,
+			.elevationRate = (glm::dot(velocity, site.up) - height * glm::dot(range, velocity) / (distance * distance)) / distance
+		};
+	}
+
+
+	template<typename SiteFrame>
+	inline double GetElevation(const _Observation &observation, const SiteFrame &site) {
+		return std::asin(std::clamp(observation.elevationFunction + site.sinMinElevation, -1.0, 1.0)) * 180.0 / PI;
+	}
+
+
+	template<typename SiteFrame>
+	inline double GetAzimuth(const _Observation &observation, const SiteFrame &site) {
+		const double azimuth = std::atan2(glm::dot(observation.range, site.east), glm::dot(observation.range, site.north)) * 180.0 / PI;
+		return (azimuth < 0.0) ? azimuth + 360.0 : azimuth;
+	}
+}
+
+
+std::vector<PassPredictor::Pass> PassPredictor::predict(const std::vector<ElsetRec> &elementSets, const std::vector<double> &epochs, double startET, double endET, ThreadPool &pool, uint32_t maxThreads) {
+	LOG_ASSERT(elementSets.size() == epochs.size(), "Cannot predict passes: There must be one epoch per element set!");
+	LOG_ASSERT(endET > startET && m_config.gridStep > 0.0, "Cannot predict passes: The window and the grid step must be positive!");
+
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+
+
+	// Local frames of the sites (geodetic coordinates on the WGS-84 ellipsoid -> ECEF)
+	std::vector<_SiteFrame> siteFrames;
+	siteFrames.reserve(m_sites.size());
+
+	for (const Site &site : m_sites) {
+		const double latitude = site.latitude * PI / 180.0;
+		const double longitude = site.longitude * PI / 180.0;
+		const double eccentricitySquared = WGS84_FLATTENING * (2.0 - WGS84_FLATTENING);
+		const double primeVerticalRadius = WGS84_RADIUS / std::sqrt(1.0 - eccentricitySquared * std::sin(latitude) * std::sin(latitude));
+
+		_SiteFrame frame{};
+		frame.position = glm::dvec3(
+			(primeVerticalRadius + site.altitude) * std::cos(latitude) * std::cos(longitude),
+			(primeVerticalRadius + site.altitude) * std::cos(latitude) * std::sin(longitude),
+			(primeVerticalRadius * (1.0 - eccentricitySquared) + site.altitude) * std::sin(latitude)
+		);
+		frame.up = glm::dvec3(std::cos(latitude) * std::cos(longitude), std::cos(latitude) * std::sin(longitude), std::sin(latitude));
+		frame.east = glm::dvec3(-std::sin(longitude), std::cos(longitude), 0.0);
+		frame.north = glm::cross(frame.up, frame.east);
+		frame.minElevation = site.minElevation * PI / 180.0;
+		frame.sinMinElevation = std::sin(frame.minElevation);
+		frame.latitude = latitude;
+
+		siteFrames.push_back(frame);
+	}
+
+
+	// Sampling grid, and the TEME -> ECEF rotation (i.e., the sidereal time) at each of its epochs
+	_Grid grid{};
+	grid.startET = startET;
+	grid.endET = endET;
+	grid.step = m_config.gridStep;
+	grid.sampleCount = static_cast<size_t>(std::ceil((endET - startET) / grid.step)) + 1;
+
+	grid.gmst.resize(grid.sampleCount);
+	for (size_t sample = 0; sample < grid.sampleCount; sample++)
+		grid.gmst[sample] = CoordinateSystem::GetGreenwichMeanSiderealTime(grid.getET(sample));
+
+
+	// Predict passes across the pool (each task appends to its own vector, so that the results do not depend on the number of threads)
+	const size_t objectCount = elementSets.size();
+	const size_t taskCount = (objectCount + TASK_SIZE - 1) / TASK_SIZE;
+
+	std::vector<std::vector<Pass>> taskPasses(taskCount);
+	std::vector<_TaskStatistics> taskStats(taskCount);
+
+	pool.parallelFor(taskCount, [&](size_t task) {
+		const size_t end = std::min(objectCount, (task + 1) * TASK_SIZE);
+
+		for (size_t i = task * TASK_SIZE; i < end; i++)
+			predictObject(elementSets[i], epochs[i], static_cast<uint32_t>(i), grid, siteFrames, taskPasses[task], taskStats[task]);
+	}, maxThreads);
+
+
+	std::vector<Pass> passes;
+	for (size_t task = 0; task < taskCount; task++) {
+		passes.insert(passes.end(), taskPasses[task].begin(), taskPasses[task].end());
+
+		m_stats.filteredPairs += taskStats[task].filteredPairs;
+		m_stats.samples += taskStats[task].samples;
+		m_stats.refinements += taskStats[task].refinements;
+		m_stats.failures += taskStats[task].failures;
+	}
+
+	std::sort(passes.begin(), passes.end(), [](const Pass &a, const Pass &b) {
+		if (a.site != b.site)
+			return a.site < b.site;
+		if (a.rise != b.rise)
+			return a.rise < b.rise;
+		return a.object < b.object;
+	});
+
+	m_stats.objects += objectCount;
+	m_stats.sitePairs += objectCount * m_sites.size();
+	m_stats.passes += passes.size();
+	m_stats.time += std::chrono::duration<double>(Clock::now() - start).count();
+
+	return passes;
+}
+
+
+void PassPredictor::predictObject(const ElsetRec &rec, double epoch, uint32_t object, const _Grid &grid, const std::vector<_SiteFrame> &siteFrames, std::vector<Pass> &passes, _TaskStatistics &stats) const {
+	// Geometric filter: the site must lie within the horizon's Earth central angle (at apogee, above the mask) of the ground track
+	const double apogeeRadius = rec.a * rec.radiusearthkm * (1.0 + rec.ecco);
+	const double maxTrackLatitude = (rec.inclo <= PI / 2.0) ? rec.inclo : PI - rec.inclo;
+
+	std::vector<uint32_t> sites;
+	for (uint32_t s = 0; s < siteFrames.size(); s++) {
+		const _SiteFrame &site = siteFrames[s];
+		const double horizonAngle = std::acos(std::min(1.0, rec.radiusearthkm * std::cos(site.minElevation) / apogeeRadius)) - site.minElevation;
+
+		if (horizonAngle > 0.0 && std::fabs(site.latitude) <= maxTrackLatitude + horizonAngle + FILTER_MARGIN)
+			sites.push_back(s);
+		else
+			stats.filteredPairs++;
+	}
+
+	if (sites.empty())
+		return;
+
+
+	// Coarse step: a fraction of the orbital period, at the angular rate at perigee (faster than the mean motion by sqrt((1 + e) / (1 - e)^3))
+	const double period = 2.0 * PI / rec.no_unkozai * 60.0;
+	const double perigeeRateFactor = std::sqrt((1.0 + rec.ecco) / std::pow(1.0 - rec.ecco, 3.0));
+	const double coarseStep = std::min(m_config.orbitFraction * period / perigeeRateFactor, m_config.maxStep);
+	const size_t stride = std::max<size_t>(1, static_cast<size_t>(coarseStep / grid.step));
+
+
+	// Propagation (to ECEF)
+	ElsetRec scratch = rec;
+	SDP4Checkpoints checkpoints;
+
+	auto propagate = [&](double et, size_t sample, glm::dvec3 &position, glm::dvec3 &velocity) {
+		double r[3], v[3];
+		if (!checkpoints.propagate(scratch, (et - epoch) / 60.0, r, v))
+			return false;
+
+		// The sidereal time advances linearly from the nearest grid epoch
+		const double gmst = grid.gmst[sample] + CoordinateSystem::EARTH_ROTATION_RATE * (et - grid.getET(sample));
+		const double cosGMST = std::cos(gmst);
+		const double sinGMST = std::sin(gmst);
+
+		position = glm::dvec3(cosGMST * r[0] + sinGMST * r[1], -sinGMST * r[0] + cosGMST * r[1], r[2]);
+		velocity = glm::dvec3(cosGMST * v[0] + sinGMST * v[1], -sinGMST * v[0] + cosGMST * v[1], v[2])
+			+ CoordinateSystem::EARTH_ROTATION_RATE * glm::dvec3(position.y, -position.x, 0.0);		// - omega x r
+
+		return true;
+	};
+
+	bool hasFailed = false;
+
+	/* Observes the satellite from a site at any time within the interval following a sample (during refinement). */
+	auto observeAt = [&](double et, size_t sample, const _SiteFrame &site) {
+		glm::dvec3 position, velocity;
+		stats.refinements++;
+
+		if (!propagate(et, sample, position, velocity)) {
+			hasFailed = true;
+			return _Observation{ .range = glm::dvec3(0.0), .elevationFunction = -1.0, .elevationRate = 0.0 };
+		}
+
+		return Observe(position, velocity, site);
+	};
+
+
+	// Per-site state: the previous sample, and the pass in progress
+	struct _SiteState {
+		_Observation previous;
+		bool isInView = false;
+		Pass pass;
+	};
+	std::vector<_SiteState> states(sites.size());
+
+	auto openPass = [&](_SiteState &state, uint32_t site, double rise, const _Observation &observation, bool isInViewAtStart) {
+		state.isInView = true;
+		state.pass = Pass{
+			.object = object,
+			.site = site,
+			.rise = rise,
+			.culmination = rise,
+			.set = rise,
+			.maxElevation = GetElevation(observation, siteFrames[site]),
+			.riseAzimuth = GetAzimuth(observation, siteFrames[site]),
+			.setAzimuth = 0.0,
+			.isInViewAtStart = isInViewAtStart,
+			.isInViewAtEnd = false
+		};
+	};
+
+	auto updateCulmination = [&](_SiteState &state, double et, const _Observation &observation) {
+		const double elevation = GetElevation(observation, siteFrames[state.pass.site]);
+		if (elevation > state.pass.maxElevation) {
+			state.pass.maxElevation = elevation;
+			state.pass.culmination = et;
+		}
+	};
+
+	auto closePass = [&](_SiteState &state, double set, const _Observation &observation, bool isInViewAtEnd) {
+		state.isInView = false;
+		state.pass.set = set;
+		state.pass.setAzimuth = GetAzimuth(observation, siteFrames[state.pass.site]);
+		state.pass.isInViewAtEnd = isInViewAtEnd;
+		passes.push_back(state.pass);
+	};
+
+
+	// Coarse sampling, bracketing and refinement
+	const double tolerance = m_config.tolerance;
+	size_t previousSample = 0;
+	double previousET = grid.startET;
+
+	for (size_t sample = 0; ; sample = std::min(sample + stride, grid.sampleCount - 1)) {
+		const double et = grid.getET(sample);
+
+		glm::dvec3 position, velocity;
+		stats.samples++;
+
+		if (!propagate(et, sample, position, velocity)) {
+			hasFailed = true;
+			break;
+		}
+
+		for (size_t k = 0; k < sites.size(); k++) {
+			const uint32_t site = sites[k];
+			const _SiteFrame &frame = siteFrames[site];
+			_SiteState &state = states[k];
+			const _Observation current = Observe(position, velocity, frame);
+
+			if (sample == 0) {
+				if (current.elevationFunction >= 0.0)
+					openPass(state, site, et, current, true);
+
+				state.previous = current;
+				continue;
+			}
+
+
+			const _Observation &previous = state.previous;
+			auto elevationFunction = [&](double t) { return observeAt(t, previousSample, frame).elevationFunction; };
+			auto elevationRate = [&](double t) { return observeAt(t, previousSample, frame).elevationRate; };
+
+			// Culmination: the elevation rate changes sign from positive to negative
+			const bool hasCulmination = (previous.elevationRate > 0.0 && current.elevationRate <= 0.0);
+			double culmination = 0.0;
+			_Observation culminationObservation{};
+
+			if (hasCulmination) {
+				culmination = RootFinding::FindRoot(elevationRate, previousET, et, previous.elevationRate, current.elevationRate, tolerance);
+				culminationObservation = observeAt(culmination, previousSample, frame);
+			}
+
+			if (!state.isInView) {
+				if (current.elevationFunction >= 0.0) {
+					// Rise
+					const double rise = RootFinding::FindRoot(elevationFunction, previousET, et, previous.elevationFunction, current.elevationFunction, tolerance);
+					openPass(state, site, rise, observeAt(rise, previousSample, frame), false);
+
+					if (hasCulmination)
+						updateCulmination(state, culmination, culminationObservation);
+
+					// The current sample is in view (and may be the last one, if the window ends during the pass)
+					updateCulmination(state, et, current);
+				}
+
+				else if (hasCulmination && culminationObservation.elevationFunction >= 0.0) {
+					// Rise and set between samples
+					const double rise = RootFinding::FindRoot(elevationFunction, previousET, culmination, previous.elevationFunction, culminationObservation.elevationFunction, tolerance);
+					openPass(state, site, rise, observeAt(rise, previousSample, frame), false);
+					updateCulmination(state, culmination, culminationObservation);
+
+					const double set = RootFinding::FindRoot(elevationFunction, culmination, et, culminationObservation.elevationFunction, current.elevationFunction, tolerance);
+					closePass(state, set, observeAt(set, previousSample, frame), false);
+				}
+			}
+
+			else {
+				if (hasCulmination)
+					updateCulmination(state, culmination, culminationObservation);
+
+				if (current.elevationFunction < 0.0) {
+					// Set
+					const double set = RootFinding::FindRoot(elevationFunction, previousET, et, previous.elevationFunction, current.elevationFunction, tolerance);
+					closePass(state, set, observeAt(set, previousSample, frame), false);
+				}
+				else
+					updateCulmination(state, et, current);
+			}
+
+			state.previous = current;
+		}
+
+		if (hasFailed || sample + 1 >= grid.sampleCount)
+			break;
+
+		previousSample = sample;
+		previousET = et;
+	}
+
+
+	// Passes in progress at the end of the window (or when propagation failed)
+	for (_SiteState &state : states)
+		if (state.isInView)
+			closePass(state, hasFailed ? previousET : grid.endET, state.previous, true);
+
+	if (hasFailed)
+		stats.failures++;
+}
+
+
+void PassPredictor::writeTable(std::ostream &out, const std::vector<Pass> &passes, const std::vector<std::string> &objectNames) const {
+	static constexpr int PREC = 1;
+	static constexpr int LENOUT = 35;
+	char rise[LENOUT], culmination[LENOUT], set[LENOUT];
+
+	out << "SITE,OBJECT,RISE_UTC,RISE_AZIMUTH,CULMINATION_UTC,MAX_ELEVATION,SET_UTC,SET_AZIMUTH,DURATION,IN_VIEW_AT_START,IN_VIEW_AT_END\n"
+		<< std::fixed << std::setprecision(2);
+
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+	for (const Pass &pass : passes) {
+		et2utc_c(pass.rise, "ISOC", PREC, LENOUT, rise);
+		et2utc_c(pass.culmination, "ISOC", PREC, LENOUT, culmination);
+		et2utc_c(pass.set, "ISOC", PREC, LENOUT, set);
+
+		out << m_sites[pass.site].name << ',' << objectNames[pass.object] << ','
+			<< rise << ',' << pass.riseAzimuth << ','
+			<< culmination << ',' << pass.maxElevation << ','
+			<< set << ',' << pass.setAzimuth << ','
+			<< (pass.set - pass.rise) << ','
+			<< (pass.isInViewAtStart ? 1 : 0) << ',' << (pass.isInViewAtEnd ? 1 : 0) << '\n';
+	}
+}
@@ -0,0 +1,165 @@
+/* PassPredictor.hpp - Prediction of the passes of catalogs of satellites over ground sites.
+	Sources:
+		- D. A. Vallado, "Fundamentals of Astrodynamics and Applications", 4th ed., 2013 (§3.4 site coordinates, §3.7 TEME to ECEF, §11.2 site-track visibility).
+		- J. R. Wertz, "Spacecraft Orbit and Attitude Systems", 2001 (§9.2 Earth central angle of the horizon).
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+
+
+/* Finds the passes (rise, culmination and set) of the satellites of a catalog over a set of ground sites, in a time window.
+	Rather than sampling every satellite's elevation at a fine cadence, passes are found in stages of increasing cost:
+		1. Geometric filter: a satellite can only be seen from sites within the Earth central angle of the horizon at its apogee (above the sites' elevation masks) of its ground track, whose latitudes never exceed its inclination. Other satellite-site pairs are never propagated.
+		2. Coarse sampling: every satellite is propagated at a step short enough (a fraction of its orbital period at its perigee angular rate) that its elevation from any site has at most one extremum between samples. Samples lie on a grid shared by all satellites, at whose epochs the TEME to ECEF rotation is evaluated once.
+		3. Bracketing and refinement: rises and sets are brackets where the elevation crosses the site's mask, and culminations are brackets where the elevation rate changes sign from positive to negative (which also finds passes that rise and set between two samples). Each is refined to the tolerance by safeguarded regula falsi on the propagated elevation (or elevation rate).
+	Satellites are propagated with SGP4, from checkpoints of the deep-space resonance integrator (see SDP4Checkpoints), across a thread pool.
+*/
+class PassPredictor {
+public:
+	/* Prediction parameters. */
+	struct Config {
+		double gridStep = 30.0;				// Step of the sampling grid shared by all satellites (s). Coarse steps are multiples of it.
+		double maxStep = 600.0;				// Longest coarse step (s)
+		double orbitFraction = 0.125;		// Coarse step, as a fraction of the orbital period at the perigee angular rate
+		double tolerance = 0.1;				// Tolerance of the times of rises, culminations and sets (s)
+	};
+
+
+	/* A ground site. */
+	struct Site {
+		std::string name;
+		double latitude;				// Geodetic latitude (deg)
+		double longitude;				// East longitude (deg)
+		double altitude = 0.0;			// Altitude above the WGS-84 ellipsoid (km)
+		double minElevation = 0.0;		// Elevation mask (deg)
+	};
+
+
+	/* A pass of a satellite over a site. */
+	struct Pass {
+		uint32_t object;				// Index of the satellite
+		uint32_t site;					// Index of the site
+		double rise;					// Rise time, in Ephemeris Time (the start of the window if the satellite is in view then)
+		double culmination;				// Time of maximum elevation, in Ephemeris Time
+		double set;						// Set time, in Ephemeris Time (the end of the window if the satellite is in view then)
+		double maxElevation;			// Maximum elevation (deg)
+		double riseAzimuth;				// Azimuth at rise (deg, clockwise from north)
+		double setAzimuth;				// Azimuth at set (deg)
+		bool isInViewAtStart;			// Whether the pass began before the window
+		bool isInViewAtEnd;				// Whether the pass ends after the window (or the satellite's propagation failed during it)
+	};
+
+
+	/* Prediction statistics. */
+	struct Statistics {
+		uint64_t objects = 0;				// Satellites
+		uint64_t sitePairs = 0;				// Satellite-site pairs
+		uint64_t filteredPairs = 0;			// Satellite-site pairs rejected by the geometric filter
+		uint64_t samples = 0;				// Propagations at coarse samples
+		uint64_t refinements = 0;			// Propagations during refinement
+		uint64_t failures = 0;				// Satellites whose propagation failed during the window
+		uint64_t passes = 0;				// Passes found
+		double time = 0.0;					// Time spent predicting (s)
+	};
+
+
+	PassPredictor() = default;
+	~PassPredictor() = default;
+
+
+	inline void setConfig(const Config &config) { m_config = config; }
+	inline const Config &getConfig() const { return m_config; }
+
+	inline void setSites(const std::vector<Site> &sites) { m_sites = sites; }
+	inline const std::vector<Site> &getSites() const { return m_sites; }
+
+
+	/* Predicts the passes of a catalog over the sites.
+		@param elementSets: The element sets of the satellites, initialized by sgp4init.
+		@param epochs: The epochs of the element sets, in Ephemeris Time.
+		@param startET: The start of the window, in Ephemeris Time.
+		@param endET: The end of the window, in Ephemeris Time.
+		@param pool: The thread pool across which satellites are shared.
+		@param maxThreads (optional): The maximum number of threads to use (0: the whole pool).
+
+		@return The passes, ordered by site, then by rise time.
+	*/
+	std::vector<Pass> predict(const std::vector<ElsetRec> &elementSets, const std::vector<double> &epochs, double startET, double endET, ThreadPool &pool, uint32_t maxThreads = 0);
+
+
+	/* Writes a table of passes, in CSV format (times in UTC).
+		@param out: The output stream.
+		@param passes: The passes (see PassPredictor::predict).
+		@param objectNames: The names of the satellites, by index.
+	*/
+	void writeTable(std::ostream &out, const std::vector<Pass> &passes, const std::vector<std::string> &objectNames) const;
+
+
+	inline const Statistics &getStatistics() const { return m_stats; }
+	inline void resetStatistics() { m_stats = Statistics(); }
+
+private:
+	static constexpr size_t TASK_SIZE = 16;		// Satellites per task
+
+	Config m_config;
+	Statistics m_stats;
+	std::vector<Site> m_sites;
+
+
+	/* The local frame of a site, in ECEF. */
+	struct _SiteFrame {
+		glm::dvec3 position;		// (km)
+		glm::dvec3 up;				// Geodetic normal
+		glm::dvec3 east;
+		glm::dvec3 north;
+		double sinMinElevation;
+		double latitude;			// Geodetic latitude (rad)
+		double minElevation;		// (rad)
+	};
+
+
+	/* The sampling grid shared by all satellites. */
+	struct _Grid {
+		double startET;
+		double endET;
+		double step;
+		size_t sampleCount;					// Samples (the last one is at the end of the window)
+		std::vector<double> gmst;			// Greenwich mean sidereal time of each sample (rad)
+
+		/* Gets the epoch of a sample. */
+		inline double getET(size_t sample) const { return (sample + 1 < sampleCount) ? startET + sample * step : endET; }
+	};
+
+
+	/* Per-task statistics (merged once the tasks complete). */
+	struct _TaskStatistics {
+		uint64_t filteredPairs = 0;
+		uint64_t samples = 0;
+		uint64_t refinements = 0;
+		uint64_t failures = 0;
+	};
+
+
+	/* Predicts the passes of a satellite over the sites.
+		@param rec: The element set.
+		@param epoch: The epoch of the element set, in Ephemeris Time.
+		@param object: The index of the satellite.
+		@param grid: The sampling grid.
+		@param siteFrames: The local frames of the sites.
+		@param passes [out]: The vector to which the passes are appended.
+		@param stats [out]: The task's statistics.
+	*/
+	void predictObject(const ElsetRec &rec, double epoch, uint32_t object, const _Grid &grid, const std::vector<_SiteFrame> &siteFrames, std::vector<Pass> &passes, _TaskStatistics &stats) const;
+};
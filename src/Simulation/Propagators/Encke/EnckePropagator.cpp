@@ -0,0 +1,58 @@
+/* EnckePropagator.cpp - Encke-method propagation.
+*/
+
+#include "EnckePropagator.hpp"
+
+
+namespace EnckePropagator {
+	bool Rectify(State &state, const glm::dvec3 &position, const glm::dvec3 &velocity, double et, double gravParam) {
+		// The elements are left undefined if the state has (almost) no angular momentum
+		const COE::Elements elements = COE::rv2coe(position, velocity, gravParam);
+		if (std::isnan(elements.e))
+			return false;
+
+		state.reference = KeplerPropagator::Orbit{
+			.position = position,
+			.velocity = velocity,
+			.epochET = et,
+			.gravParam = gravParam
+		};
+		state.referenceElements = elements;
+
+		state.deviationPosition = glm::dvec3(0.0);
+		state.deviationVelocity = glm::dvec3(0.0);
+		state.epochET = et;
+
+		return true;
+	}
+
+
+	bool GetState(State &state, glm::dvec3 &position, glm::dvec3 &velocity) {
+		glm::dvec3 referencePosition, referenceVelocity;
+		if (!KeplerPropagator::Propagate(state.reference, state.epochET, referencePosition, referenceVelocity))
+			return false;
+
+		position = referencePosition + state.deviationPosition;
+		velocity = referenceVelocity + state.deviationVelocity;
+		return true;
+	}
+
+
+	glm::dvec3 ComputeDeviationAcceleration(const glm::dvec3 &referencePosition, const glm::dvec3 &deviationPosition, double gravParam) {
+		/*
+			Let rho be the reference position, and r = rho + dr the true position. Then:
+				d(dr)/dt^2 = -mu/r^3 * r + mu/rho^3 * rho = -mu/rho^3 * (dr + f(q) * r),
+			where f(q) = (rho/r)^3 - 1 is evaluated without cancellation as
+				q    = dr . (dr - 2r) / r^2        (so that rho^2 / r^2 = 1 + q)
+				f(q) = q * (3 + 3q + q^2) / (1 + (1 + q)^(3/2)).
+		*/
+		const glm::dvec3 position = referencePosition + deviationPosition;
+
+		const double q = glm::dot(deviationPosition, deviationPosition - 2.0 * position) / glm::dot(position, position);
+		const double fq = q * (3.0 + 3.0 * q + q * q) / (1.0 + std::pow(1.0 + q, 1.5));
+
+		const double rho = glm::length(referencePosition);
+
+		return (-gravParam / (rho * rho * rho)) * (deviationPosition + fq * position);
+	}
+}
@@ -0,0 +1,153 @@
+/* EnckePropagator.hpp - Encke-method propagation of perturbed orbits relative to an osculating reference conic.
+	Sources:
+		- R. H. Battin, "An Introduction to the Mathematics and Methods of Astrodynamics", AIAA, 1999 (Section 9.3).
+		- D. A. Vallado, "Fundamentals of Astrodynamics and Applications", 4th ed., Section 8.3.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Algorithms/COE/RV2COE.hpp>
+#include <Simulation/Propagators/Kepler/KeplerPropagator.hpp>
+
+
+/* Encke's method integrates only the deviation of an orbit from a reference conic (the osculating two-body orbit at some epoch), which is itself evaluated analytically.
+	For nearly Keplerian orbits, the deviation and its derivatives are orders of magnitude smaller than the full state, so the truncation error of a step is orders of magnitude smaller too: the same accuracy is reached with far larger steps than the full (Cowell) equations of motion allow.
+	The deviation grows as perturbations accumulate. Once it exceeds a fraction of the distance to the central body, the reference conic is rectified: it is replaced by the osculating orbit of the current state, and the deviation is reset to zero.
+*/
+namespace EnckePropagator {
+	static constexpr double DEFAULT_STEP_SIZE = 60.0;						// Default integration step size (s)
+	static constexpr double DEFAULT_RECTIFICATION_THRESHOLD = 1e-2;		// Default ratio of the deviation to the reference distance at which the reference conic is rectified
+
+
+	/* The state of an Encke propagator. */
+	struct State {
+		KeplerPropagator::Orbit reference{};		// Reference conic (the osculating orbit at the last rectification)
+		COE::Elements referenceElements{};			// Classical orbital elements of the reference conic
+
+		glm::dvec3 deviationPosition{ 0.0 };		// Position relative to the reference conic (m)
+		glm::dvec3 deviationVelocity{ 0.0 };		// Velocity relative to the reference conic (m/s)
+		double epochET = 0.0;						// Epoch of the deviation, in Ephemeris Time
+
+		double stepSize = DEFAULT_STEP_SIZE;								// Maximum integration step size (s)
+		double rectificationThreshold = DEFAULT_RECTIFICATION_THRESHOLD;	// Ratio of the deviation to the reference distance at which the reference conic is rectified
+
+		uint64_t steps = 0;							// Number of integration steps taken
+		uint64_t rectifications = 0;				// Number of rectifications
+	};
+
+
+	/* Rectifies the reference conic: the osculating orbit of a state becomes the reference conic, and the deviation is reset to zero.
+		@param state: The propagator state.
+		@param position: The position relative to the central body (m).
+		@param velocity: The velocity relative to the central body (m/s).
+		@param et: The epoch of the position and velocity, in Ephemeris Time.
+		@param gravParam: The gravitational parameter of the central body (m^3/s^2).
+
+		@return True if successful, false if the state has no well-defined conic (e.g., rectilinear motion).
+	*/
+	bool Rectify(State &state, const glm::dvec3 &position, const glm::dvec3 &velocity, double et, double gravParam);
+
+
+	/* Gets the state vector at the propagator's epoch.
+		@param state: The propagator state. Its reference conic's cached universal variable is updated.
+		@param position [out]: The position relative to the central body (m).
+		@param velocity [out]: The velocity relative to the central body (m/s).
+
+		@return True if successful, false if the Kepler solver did not converge.
+	*/
+	bool GetState(State &state, glm::dvec3 &position, glm::dvec3 &velocity);
+
+
+	/* Computes the acceleration of the deviation from the reference conic.
+		The difference of the two-body accelerations of the true and reference orbits is evaluated with Battin's f(q) formulation, which avoids the cancellation of two nearly equal terms.
+
+		@param referencePosition: The position on the reference conic, relative to the central body (m).
+		@param deviationPosition: The position relative to the reference conic (m).
+		@param gravParam: The gravitational parameter of the central body (m^3/s^2).
+
+		@return The two-body part of the deviation's acceleration (m/s^2), without perturbations.
+	*/
+	glm::dvec3 ComputeDeviationAcceleration(const glm::dvec3 &referencePosition, const glm::dvec3 &deviationPosition, double gravParam);
+
+
+	/* Propagates a state to a given epoch with RK4 steps of at most the propagator's step size, rectifying the reference conic whenever the deviation exceeds the rectification threshold.
+		@param state: The propagator state.
+		@param et: The target epoch, in Ephemeris Time (may precede the propagator's epoch).
+		@param perturbation: The perturbing acceleration, called as `glm::dvec3 perturbation(double t, const glm::dvec3 &position, const glm::dvec3 &velocity)` with the state relative to the central body.
+
+		@return True if successful, false if the Kepler solver did not converge or the reference conic could not be rectified (in which case the state is left at the last successful step).
+	*/
+	template<typename Perturbation>
+	bool Propagate(State &state, double et, Perturbation &&perturbation) {
+		const double gravParam = state.reference.gravParam;
+
+		// Reference conic at the start of the step (the reference at the end of a step is reused at the start of the next one)
+		glm::dvec3 referencePosition, referenceVelocity;
+		if (state.epochET != et && !KeplerPropagator::Propagate(state.reference, state.epochET, referencePosition, referenceVelocity))
+			return false;
+
+		// Acceleration of the deviation, given the reference state at the same time
+		auto computeAcceleration = [&](double t, const glm::dvec3 &refPosition, const glm::dvec3 &refVelocity, const glm::dvec3 &deviationPosition, const glm::dvec3 &deviationVelocity) {
+			return ComputeDeviationAcceleration(refPosition, deviationPosition, gravParam)
+				+ perturbation(t, refPosition + deviationPosition, refVelocity + deviationVelocity);
+		};
+
+
+		while (state.epochET != et) {
+			const double remaining = et - state.epochET;
+			const double h = (std::abs(remaining) <= state.stepSize) ? remaining : std::copysign(state.stepSize, remaining);
+			const double t = state.epochET;
+			const double tEnd = (h == remaining) ? et : (t + h);
+
+			// The two midpoint stages share the reference state
+			glm::dvec3 midPosition, midVelocity, endPosition, endVelocity;
+			if (!KeplerPropagator::Propagate(state.reference, t + 0.5 * h, midPosition, midVelocity) ||
+				!KeplerPropagator::Propagate(state.reference, tEnd, endPosition, endVelocity))
+				return false;
+
+			const glm::dvec3 &r = state.deviationPosition;
+			const glm::dvec3 &v = state.deviationVelocity;
+
+			const glm::dvec3 a1 = computeAcceleration(t, referencePosition, referenceVelocity, r, v);
+
+			const glm::dvec3 r2 = r + 0.5 * h * v, v2 = v + 0.5 * h * a1;
+			const glm::dvec3 a2 = computeAcceleration(t + 0.5 * h, midPosition, midVelocity, r2, v2);
+
+			const glm::dvec3 r3 = r + 0.5 * h * v2, v3 = v + 0.5 * h * a2;
+			const glm::dvec3 a3 = computeAcceleration(t + 0.5 * h, midPosition, midVelocity, r3, v3);
+
+			const glm::dvec3 r4 = r + h * v3, v4 = v + h * a3;
+			const glm::dvec3 a4 = computeAcceleration(tEnd, endPosition, endVelocity, r4, v4);
+
+			state.deviationPosition = r + (h / 6.0) * (v + 2.0 * v2 + 2.0 * v3 + v4);
+			state.deviationVelocity = v + (h / 6.0) * (a1 + 2.0 * a2 + 2.0 * a3 + a4);
+			state.epochET = tEnd;
+			state.steps++;
+
+			referencePosition = endPosition;
+			referenceVelocity = endVelocity;
+
+
+			// Rectification
+			if (glm::length(state.deviationPosition) > state.rectificationThreshold * glm::length(referencePosition)) {
+				const glm::dvec3 position = referencePosition + state.deviationPosition;
+				const glm::dvec3 velocity = referenceVelocity + state.deviationVelocity;
+
+				if (!Rectify(state, position, velocity, state.epochET, gravParam))
+					return false;
+
+				referencePosition = position;
+				referenceVelocity = velocity;
+				state.rectifications++;
+			}
+		}
+
+		return true;
+	}
+}
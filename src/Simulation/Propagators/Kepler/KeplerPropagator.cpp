@@ -0,0 +1,27 @@
+/* KeplerPropagator.cpp - Analytic two-body (Keplerian) propagation.
+*/
+
+#include "KeplerPropagator.hpp"
+
+#include <Simulation/Algorithms/Kepler/KEPLER.hpp>
+
+
+namespace KeplerPropagator {
+	bool Propagate(Orbit &orbit, double et, glm::dvec3 &position, glm::dvec3 &velocity) {
+		return Kepler::kepler(orbit.position, orbit.velocity, et - orbit.epochET, orbit.gravParam, position, velocity, &orbit.universalVar);
+	}
+
+
+	size_t PropagateBatch(std::vector<Orbit> &orbits, double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities) {
+		positions.resize(orbits.size(), glm::dvec3(0.0));
+		velocities.resize(orbits.size(), glm::dvec3(0.0));
+
+		size_t failures = 0;
+
+		for (size_t i = 0; i < orbits.size(); i++)
+			if (!Propagate(orbits[i], et, positions[i], velocities[i]))
+				failures++;
+
+		return failures;
+	}
+}
@@ -0,0 +1,47 @@
+/* KeplerPropagator.hpp - Analytic two-body (Keplerian) propagation of elliptic, parabolic, and hyperbolic orbits.
+*/
+
+#pragma once
+
+#include <vector>
+#include <limits>
+
+
+#include <Platform/External/GLM.hpp>
+
+
+namespace KeplerPropagator {
+	/* A reference state on a Keplerian orbit. */
+	struct Orbit {
+		glm::dvec3 position;		// Position relative to the central body at the reference epoch (m)
+		glm::dvec3 velocity;		// Velocity relative to the central body at the reference epoch (m/s)
+		double epochET;				// Reference epoch, in Ephemeris Time
+		double gravParam;			// Gravitational parameter of the central body (m^3/s^2)
+
+		double universalVar = std::numeric_limits<double>::quiet_NaN();		// [INTERNAL] Last solution of the universal variable, used as the initial guess of the next evaluation
+	};
+
+
+	/* Evaluates the state vector on an orbit at a given epoch. The cost does not depend on the time of flight.
+		@param orbit: The orbit. Its cached universal variable is updated.
+		@param et: The epoch, in Ephemeris Time.
+		@param position [out]: The position relative to the central body (m).
+		@param velocity [out]: The velocity relative to the central body (m/s).
+
+		@return True if successful, false if the Kepler solver did not converge (in which case the outputs are left unchanged).
+	*/
+	bool Propagate(Orbit &orbit, double et, glm::dvec3 &position, glm::dvec3 &velocity);
+
+
+	/* Evaluates the state vectors on many orbits at a given epoch.
+		Consecutive calls with nearby epochs are cheap, since each orbit's Kepler solver starts from its previous solution.
+
+		@param orbits: The orbits.
+		@param et: The epoch, in Ephemeris Time.
+		@param positions [out]: The positions relative to the central bodies (m), resized to the number of orbits.
+		@param velocities [out]: The velocities relative to the central bodies (m/s), resized to the number of orbits.
+
+		@return The number of orbits whose Kepler solver did not converge. Their outputs are left unchanged (or zero, if the output arrays had to grow).
+	*/
+	size_t PropagateBatch(std::vector<Orbit> &orbits, double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities);
+}
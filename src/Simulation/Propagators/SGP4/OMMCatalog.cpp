@@ -0,0 +1,724 @@
+/* OMMCatalog.cpp - OMM catalog loader implementation.
+*/
+
+#include "OMMCatalog.hpp"
+
+#include <cmath>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+
+
+#include <Core/Utils/FilePathUtils.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+
+
+namespace {
+	/* The OMM keywords read by the loader. */
+	enum _Field : uint8_t {
+		F_OBJECT_NAME,
+		F_OBJECT_ID,
+		F_CENTER_NAME,
+		F_REF_FRAME,
+		F_TIME_SYSTEM,
+		F_MEAN_ELEMENT_THEORY,
+		F_EPOCH,
+		F_MEAN_MOTION,
+		F_ECCENTRICITY,
+		F_INCLINATION,
+		F_RA_OF_ASC_NODE,
+		F_ARG_OF_PERICENTER,
+		F_MEAN_ANOMALY,
+		F_EPHEMERIS_TYPE,
+		F_CLASSIFICATION_TYPE,
+		F_NORAD_CAT_ID,
+		F_ELEMENT_SET_NO,
+		F_REV_AT_EPOCH,
+		F_BSTAR,
+		F_MEAN_MOTION_DOT,
+		F_MEAN_MOTION_DDOT,
+
+		F_COUNT
+	};
+
+
+	constexpr std::string_view KEYWORDS[F_COUNT] = {
+		"OBJECT_NAME", "OBJECT_ID", "CENTER_NAME", "REF_FRAME", "TIME_SYSTEM", "MEAN_ELEMENT_THEORY",
+		"EPOCH", "MEAN_MOTION", "ECCENTRICITY", "INCLINATION", "RA_OF_ASC_NODE", "ARG_OF_PERICENTER", "MEAN_ANOMALY",
+		"EPHEMERIS_TYPE", "CLASSIFICATION_TYPE", "NORAD_CAT_ID", "ELEMENT_SET_NO", "REV_AT_EPOCH", "BSTAR", "MEAN_MOTION_DOT", "MEAN_MOTION_DDOT"
+	};
+
+
+	/* The fields of a message, as views into the mapped catalog. */
+	struct _Record {
+		std::array<std::string_view, F_COUNT> fields;		// Empty if absent
+		size_t offset;										// Byte offset of the message in the catalog
+	};
+
+
+	inline bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+
+	inline std::string_view Trim(std::string_view str) {
+		while (!str.empty() && IsBlank(str.front()))
+			str.remove_prefix(1);
+		while (!str.empty() && IsBlank(str.back()))
+			str.remove_suffix(1);
+
+		return str;
+	}
+
+
+	/* Finds the field of a keyword.
+		@return The field, or F_COUNT if the keyword is not read by the loader.
+	*/
+	_Field FindField(std::string_view keyword) {
+		for (uint8_t i = 0; i < F_COUNT; i++)
+			if (KEYWORDS[i] == keyword)
+				return static_cast<_Field>(i);
+
+		return F_COUNT;
+	}
+
+
+	/* Reads the line starting at a position, and advances the position past it. */
+	inline std::string_view NextLine(std::string_view content, size_t &position) {
+		const size_t end = std::min(content.find('\n', position), content.size());
+		const std::string_view line = content.substr(position, end - position);
+
+		position = end + 1;
+		return line;
+	}
+
+
+	/* Scans KVN messages: "KEYWORD = value [units]" lines, with each message starting with CCSDS_OMM_VERS.
+		A keyword that is already set also starts a new message, so that concatenated messages without headers are split correctly.
+	*/
+	class _KVNScanner {
+	public:
+		explicit _KVNScanner(std::string_view content) : m_content(content) {}
+
+
+		bool next(_Record &record) {
+			record = _Record{};
+			bool started = false;
+
+			while (m_position < m_content.size()) {
+				const size_t lineStart = m_position;
+				const std::string_view line = Trim(NextLine(m_content, m_position));
+
+				const size_t separator = line.find('=');
+				if (line.empty() || separator == std::string_view::npos || line.starts_with("COMMENT"))
+					continue;
+
+				const std::string_view keyword = Trim(line.substr(0, separator));
+				std::string_view value = Trim(line.substr(separator + 1));
+
+				const bool isHeader = (keyword == "CCSDS_OMM_VERS");
+				const _Field field = isHeader ? F_COUNT : FindField(keyword);
+
+				if (!isHeader && field == F_COUNT)
+					continue;
+
+				// The line starts the next message
+				if (started && (isHeader || !record.fields[field].empty())) {
+					m_position = lineStart;
+					return true;
+				}
+
+				if (!started) {
+					started = true;
+					record.offset = lineStart;
+				}
+
+				if (isHeader)
+					continue;
+
+				// Units (e.g., "[deg]") follow the values of numeric keywords
+				if (field != F_OBJECT_NAME && field != F_OBJECT_ID && value.ends_with(']')) {
+					const size_t unitStart = value.rfind('[');
+					if (unitStart != std::string_view::npos)
+						value = Trim(value.substr(0, unitStart));
+				}
+
+				record.fields[field] = value;
+			}
+
+			return started;
+		}
+
+	private:
+		std::string_view m_content;
+		size_t m_position = 0;
+	};
+
+
+	/* Scans XML messages: every <omm> element is a message, whose leaf elements named after keywords hold its fields. Other markup (declarations, comments, and the headers of the document and its messages) is skipped. */
+	class _XMLScanner {
+	public:
+		explicit _XMLScanner(std::string_view content) : m_content(content) {}
+
+
+		bool next(_Record &record) {
+			record = _Record{};
+			bool started = false;
+
+			while (true) {
+				const size_t tagStart = m_content.find('<', m_position);
+				if (tagStart == std::string_view::npos) {
+					m_position = m_content.size();
+					return started;
+				}
+
+				// Declarations, processing instructions, and comments
+				if (m_content.compare(tagStart, 4, "<!--") == 0) {
+					m_position = skipPast(tagStart, "-->");
+					continue;
+				}
+				if (m_content.compare(tagStart, 2, "<?") == 0) {
+					m_position = skipPast(tagStart, "?>");
+					continue;
+				}
+
+				const size_t tagEnd = m_content.find('>', tagStart);
+				if (tagEnd == std::string_view::npos) {
+					m_position = m_content.size();
+					return started;
+				}
+				m_position = tagEnd + 1;
+
+				if (m_content[tagStart + 1] == '!')
+					continue;
+
+				const bool isClosing = (m_content[tagStart + 1] == '/');
+				const bool isSelfClosing = (m_content[tagEnd - 1] == '/');
+				const std::string_view name = getTagName(m_content.substr(tagStart + (isClosing ? 2 : 1), tagEnd - tagStart - (isClosing ? 2 : 1)));
+
+				if (name == "omm") {
+					if (isClosing) {
+						if (started)
+							return true;
+					}
+					else {
+						// An unterminated message ends where the next one starts
+						if (started) {
+							m_position = tagStart;
+							return true;
+						}
+
+						started = true;
+						record.offset = tagStart;
+					}
+					continue;
+				}
+
+				if (isClosing || isSelfClosing)
+					continue;
+
+				const _Field field = FindField(name);
+				if (field == F_COUNT)
+					continue;
+
+				const size_t textEnd = std::min(m_content.find('<', m_position), m_content.size());
+				record.fields[field] = Trim(m_content.substr(m_position, textEnd - m_position));
+
+				if (!started) {
+					started = true;
+					record.offset = tagStart;
+				}
+			}
+		}
+
+	private:
+		std::string_view m_content;
+		size_t m_position = 0;
+
+
+		inline size_t skipPast(size_t position, std::string_view terminator) const {
+			const size_t end = m_content.find(terminator, position);
+			return (end == std::string_view::npos) ? m_content.size() : end + terminator.size();
+		}
+
+
+		/* Gets the name of an element from the inside of its tag, without attributes or a namespace prefix. */
+		static std::string_view getTagName(std::string_view tag) {
+			const size_t nameEnd = std::min(tag.find_first_of(" \t\r\n/"), tag.size());
+			std::string_view name = tag.substr(0, nameEnd);
+
+			const size_t prefixEnd = name.find(':');
+			if (prefixEnd != std::string_view::npos)
+				name.remove_prefix(prefixEnd + 1);
+
+			return name;
+		}
+	};
+
+
+	/* Scans CSV messages: one message per line, whose columns are named by the keywords of the header line. Values may be quoted. */
+	class _CSVScanner {
+	public:
+		explicit _CSVScanner(std::string_view content) : m_content(content) {
+			// Header
+			std::string_view header;
+			while (m_position < m_content.size() && header.empty())
+				header = Trim(NextLine(m_content, m_position));
+
+			size_t position = 0;
+			while (position <= header.size())
+				m_columns.push_back(FindField(nextValue(header, position)));
+
+			if (std::find(m_columns.begin(), m_columns.end(), F_EPOCH) == m_columns.end())
+				throw Log::RuntimeException(__FUNCTION__, __LINE__, "The header of the CSV catalog has no " + enquote(std::string(KEYWORDS[F_EPOCH])) + " column!");
+		}
+
+
+		bool next(_Record &record) {
+			while (m_position < m_content.size()) {
+				const size_t lineStart = m_position;
+				const std::string_view line = Trim(NextLine(m_content, m_position));
+				if (line.empty())
+					continue;
+
+				record = _Record{};
+				record.offset = lineStart;
+
+				size_t position = 0;
+				for (size_t column = 0; column < m_columns.size() && position <= line.size(); column++) {
+					const std::string_view value = nextValue(line, position);
+					if (m_columns[column] != F_COUNT)
+						record.fields[m_columns[column]] = value;
+				}
+
+				return true;
+			}
+
+			return false;
+		}
+
+	private:
+		std::string_view m_content;
+		size_t m_position = 0;
+		std::vector<_Field> m_columns;		// Field of each column (F_COUNT if not read)
+
+
+		/* Reads the value starting at a position of a line, and advances the position past its separator. Quotes around the value are removed (doubled quotes inside it are kept). */
+		static std::string_view nextValue(std::string_view line, size_t &position) {
+			std::string_view value;
+
+			if (position < line.size() && line[position] == '"') {
+				size_t end = position + 1;
+				while (end < line.size() && !(line[end] == '"' && (end + 1 == line.size() || line[end + 1] != '"')))
+					end += (line[end] == '"') ? 2 : 1;
+
+				value = line.substr(position + 1, std::min(end, line.size()) - position - 1);
+				position = std::min(line.find(',', end), line.size()) + 1;
+			}
+			else {
+				const size_t end = std::min(line.find(',', position), line.size());
+				value = line.substr(position, end - position);
+				position = end + 1;
+			}
+
+			return Trim(value);
+		}
+	};
+
+
+	/* Parses a decimal value (a leading '+' is allowed). */
+	bool ParseDouble(std::string_view str, double &value) {
+		if (!str.empty() && str.front() == '+')
+			str.remove_prefix(1);
+		if (str.empty())
+			return false;
+
+		const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+		return error == std::errc() && end == str.data() + str.size();
+	}
+
+
+	/* Parses an integer value (a leading '+' is allowed). */
+	bool ParseInteger(std::string_view str, long &value) {
+		if (!str.empty() && str.front() == '+')
+			str.remove_prefix(1);
+		if (str.empty())
+			return false;
+
+		const auto [end, error] = std::from_chars(str.data(), str.data() + str.size(), value);
+		return error == std::errc() && end == str.data() + str.size();
+	}
+
+
+	/* Parses an optional decimal value, which defaults to zero if absent. */
+	inline bool ParseOptionalDouble(std::string_view str, double &value) {
+		value = 0.0;
+		return str.empty() || ParseDouble(str, value);
+	}
+
+
+	/* Parses a fixed number of digits. */
+	bool ParseDigits(std::string_view str, size_t position, size_t count, int &value) {
+		if (position + count > str.size())
+			return false;
+
+		value = 0;
+		for (size_t i = position; i < position + count; i++) {
+			if (str[i] < '0' || str[i] > '9')
+				return false;
+			value = 10 * value + (str[i] - '0');
+		}
+
+		return true;
+	}
+
+
+	inline bool IsLeapYear(int year) { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+
+
+	/* Parses a CCSDS epoch (YYYY-MM-DDThh:mm:ss[.d...][Z] or YYYY-DDDThh:mm:ss[.d...][Z]) into the epoch of an element set, as parseEpoch does for TLE epochs.
+		@param str: The epoch.
+		@param rec [out]: The element set.
+		@param epochMillis [out]: The epoch, in milliseconds since 1970.
+
+		@return True if successful, false otherwise.
+	*/
+	bool ParseEpoch(std::string_view str, ElsetRec &rec, long &epochMillis) {
+		if (str.ends_with('Z'))
+			str.remove_suffix(1);
+
+		int year, month, day, dayOfYear, hour, minute;
+		if (!ParseDigits(str, 0, 4, year) || str.size() < 5 || str[4] != '-')
+			return false;
+
+		int daysInMonth[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+		if (IsLeapYear(year))
+			daysInMonth[1] = 29;
+
+		size_t timeStart;
+		if (str.size() > 7 && str[7] == '-') {
+			// Calendar date
+			if (!ParseDigits(str, 5, 2, month) || !ParseDigits(str, 8, 2, day) || month < 1 || month > 12 || day < 1 || day > daysInMonth[month - 1])
+				return false;
+
+			dayOfYear = day;
+			for (int i = 0; i < month - 1; i++)
+				dayOfYear += daysInMonth[i];
+
+			timeStart = 10;
+		}
+		else {
+			// Ordinal date
+			if (!ParseDigits(str, 5, 3, dayOfYear) || dayOfYear < 1 || dayOfYear > (IsLeapYear(year) ? 366 : 365))
+				return false;
+
+			day = dayOfYear;
+			month = 1;
+			while (day > daysInMonth[month - 1]) {
+				day -= daysInMonth[month - 1];
+				month++;
+			}
+
+			timeStart = 8;
+		}
+
+		// Time of day
+		double second;
+		if (str.size() < timeStart + 9 || str[timeStart] != 'T' || str[timeStart + 3] != ':' || str[timeStart + 6] != ':' ||
+			!ParseDigits(str, timeStart + 1, 2, hour) || !ParseDigits(str, timeStart + 4, 2, minute) || !ParseDouble(str.substr(timeStart + 7), second) ||
+			hour > 23 || minute > 59 || second < 0.0 || second >= 61.0)
+			return false;
+
+		rec.epochyr = year % 100;
+		rec.epochdays = dayOfYear + (hour * 3600.0 + minute * 60.0 + second) / 86400.0;
+		jday(year, month, day, hour, minute, second, &rec.jdsatepoch, &rec.jdsatepochF);
+
+		epochMillis = static_cast<long>((rec.jdsatepoch - 2440587.5) * 86400000.0) + static_cast<long>(86400000.0 * rec.jdsatepochF);
+		return true;
+	}
+
+
+	/* Parses a message, and initializes it for propagation.
+		@return nullptr if successful, or the reason the message was rejected.
+	*/
+	const char *ParseRecord(const _Record &record, TLE &tle) {
+		const auto &fields = record.fields;
+
+		for (_Field field : { F_EPOCH, F_MEAN_MOTION, F_ECCENTRICITY, F_INCLINATION, F_RA_OF_ASC_NODE, F_ARG_OF_PERICENTER, F_MEAN_ANOMALY })
+			if (fields[field].empty())
+				return "Missing mean elements (SGP4 requires the epoch, mean motion, eccentricity, inclination, RAAN, argument of pericenter, and mean anomaly)";
+
+
+		// Metadata (optional, but must describe SGP4 mean elements if present)
+		if (!fields[F_CENTER_NAME].empty() && fields[F_CENTER_NAME] != "EARTH")
+			return "Unsupported center (must be EARTH)";
+
+		if (!fields[F_REF_FRAME].empty() && fields[F_REF_FRAME] != "TEME")
+			return "Unsupported reference frame (must be TEME)";
+
+		if (!fields[F_TIME_SYSTEM].empty() && fields[F_TIME_SYSTEM] != "UTC")
+			return "Unsupported time system (must be UTC)";
+
+		const std::string_view theory = fields[F_MEAN_ELEMENT_THEORY];
+		if (!theory.empty() && theory != "SGP4" && theory != "SDP4" && theory != "SGP/SGP4" && theory != "SGP4/SDP4")
+			return "Unsupported mean element theory (must be SGP4)";
+
+		long ephemerisType = 0;
+		if (!fields[F_EPHEMERIS_TYPE].empty() && (!ParseInteger(fields[F_EPHEMERIS_TYPE], ephemerisType) || ephemerisType == 4))
+			return "Unsupported ephemeris type (SGP4-XP element sets are not supported)";
+
+
+		// Elements
+		long elementSetNumber = 0, revolutionNumber = 0;
+		if (!ParseDouble(fields[F_MEAN_MOTION], tle.n) ||
+			!ParseDouble(fields[F_ECCENTRICITY], tle.ecc) ||
+			!ParseDouble(fields[F_INCLINATION], tle.incDeg) ||
+			!ParseDouble(fields[F_RA_OF_ASC_NODE], tle.raanDeg) ||
+			!ParseDouble(fields[F_ARG_OF_PERICENTER], tle.argpDeg) ||
+			!ParseDouble(fields[F_MEAN_ANOMALY], tle.maDeg) ||
+			!ParseOptionalDouble(fields[F_BSTAR], tle.bstar) ||
+			!ParseOptionalDouble(fields[F_MEAN_MOTION_DOT], tle.ndot) ||
+			!ParseOptionalDouble(fields[F_MEAN_MOTION_DDOT], tle.nddot) ||
+			(!fields[F_ELEMENT_SET_NO].empty() && !ParseInteger(fields[F_ELEMENT_SET_NO], elementSetNumber)) ||
+			(!fields[F_REV_AT_EPOCH].empty() && !ParseInteger(fields[F_REV_AT_EPOCH], revolutionNumber)))
+			return "Malformed field";
+
+		if (tle.n <= 0.0 || tle.ecc < 0.0 || tle.ecc >= 1.0)
+			return "Mean elements out of range";
+
+		tle.elnum = static_cast<int>(elementSetNumber);
+		tle.revnum = static_cast<int>(revolutionNumber);
+
+		if (!ParseEpoch(fields[F_EPOCH], tle.rec, tle.epoch))
+			return "Malformed epoch";
+
+
+		// Identifiers (the TLE lines are left empty: OMMs have none)
+		tle.line1[0] = 0;
+		tle.line2[0] = 0;
+
+		const std::string_view catalogNumber = fields[F_NORAD_CAT_ID].substr(0, sizeof(tle.objectID) - 1);
+		std::memcpy(tle.objectID, catalogNumber.data(), catalogNumber.size());
+		tle.objectID[catalogNumber.size()] = 0;
+
+			// International designator: "1998-067A" is "98067A" in a TLE
+		const std::string_view objectID = fields[F_OBJECT_ID];
+		std::string_view designator = objectID;
+		size_t designatorLength = 0;
+		if (objectID.size() > 5 && objectID[4] == '-') {
+			tle.intlid[designatorLength++] = objectID[2];
+			tle.intlid[designatorLength++] = objectID[3];
+			designator = objectID.substr(5);
+		}
+		designator = designator.substr(0, sizeof(tle.intlid) - 1 - designatorLength);
+		std::memcpy(&tle.intlid[designatorLength], designator.data(), designator.size());
+		tle.intlid[designatorLength + designator.size()] = 0;
+
+		tle.rec.whichconst = wgs72;
+		tle.rec.classification = fields[F_CLASSIFICATION_TYPE].empty() ? 'U' : fields[F_CLASSIFICATION_TYPE].front();
+		tle.sgp4Error = 0;
+
+
+		// Initialization
+		setValsToRec(&tle, &tle.rec);
+
+		if (tle.rec.error != 0)
+			return "SGP4 initialization failed";
+
+		return nullptr;
+	}
+
+
+	/* Decodes the predefined entities of an XML value (e.g., "&amp;"), or the doubled quotes of a quoted CSV value. */
+	std::string DecodeValue(std::string_view value, OMMCatalog::Encoding encoding) {
+		static constexpr std::pair<std::string_view, char> XML_ENTITIES[] = {
+			{ "&amp;", '&' }, { "&lt;", '<' }, { "&gt;", '>' }, { "&quot;", '"' }, { "&apos;", '\'' }
+		};
+
+		std::string decoded;
+		decoded.reserve(value.size());
+
+		for (size_t i = 0; i < value.size(); i++) {
+			if (encoding == OMMCatalog::Encoding::XML && value[i] == '&') {
+				const auto entity = std::find_if(std::begin(XML_ENTITIES), std::end(XML_ENTITIES), [&](const auto &pair) { return value.substr(i).starts_with(pair.first); });
+				if (entity != std::end(XML_ENTITIES)) {
+					decoded += entity->second;
+					i += entity->first.size() - 1;
+					continue;
+				}
+			}
+			else if (encoding == OMMCatalog::Encoding::CSV && value[i] == '"' && i + 1 < value.size() && value[i + 1] == '"')
+				i++;
+
+			decoded += value[i];
+		}
+
+		return decoded;
+	}
+
+
+	/* Streams the messages of a catalog: they are scanned and then parsed and initialized in parallel, one batch at a time. */
+	template<typename Scanner>
+	void StreamRecords(Scanner &scanner, OMMCatalog::Encoding encoding, std::string_view content, const std::string &filePath, ThreadPool &pool,
+		std::vector<TLECatalog::Entry> &entries, TLECatalog::Statistics &stats) {
+
+		using Clock = std::chrono::steady_clock;
+		static constexpr size_t MAX_REPORTED_REJECTIONS = 10;
+
+		std::vector<_Record> records;
+		std::vector<const char *> rejections;
+		records.reserve(OMMCatalog::BATCH_SIZE);
+
+		std::string rejectionReport;
+		bool isAtEnd = false;
+
+		while (!isAtEnd) {
+			// Scan a batch
+			const Clock::time_point scanStart = Clock::now();
+
+			records.clear();
+			_Record record;
+			while (records.size() < OMMCatalog::BATCH_SIZE) {
+				if (!scanner.next(record)) {
+					isAtEnd = true;
+					break;
+				}
+				records.push_back(record);
+			}
+
+			const Clock::time_point parseStart = Clock::now();
+			stats.scanTime += std::chrono::duration<double>(parseStart - scanStart).count();
+
+			if (records.empty())
+				break;
+
+
+			// Parse and initialize the batch in parallel (each task writes only to its own entries)
+			const size_t first = entries.size();
+			entries.resize(first + records.size());
+			rejections.assign(records.size(), nullptr);
+
+			pool.parallelFor((records.size() + OMMCatalog::INIT_TASK_SIZE - 1) / OMMCatalog::INIT_TASK_SIZE, [&](size_t task) {
+				const size_t end = std::min(records.size(), (task + 1) * OMMCatalog::INIT_TASK_SIZE);
+
+				for (size_t i = task * OMMCatalog::INIT_TASK_SIZE; i < end; i++) {
+					const _Record &record = records[i];
+					TLECatalog::Entry &entry = entries[first + i];
+
+					rejections[i] = ParseRecord(record, entry.tle);
+
+					const std::string_view name = record.fields[F_OBJECT_NAME].empty() ? record.fields[F_NORAD_CAT_ID] : record.fields[F_OBJECT_NAME];
+					entry.name = DecodeValue(name, encoding);
+				}
+			});
+
+
+			// Remove rejected messages, and report them
+			size_t accepted = first;
+			for (size_t i = 0; i < records.size(); i++) {
+				if (rejections[i]) {
+					if (stats.rejected++ < MAX_REPORTED_REJECTIONS) {
+						const size_t lineNumber = 1 + std::count(content.begin(), content.begin() + records[i].offset, '\n');
+						rejectionReport += "\n\tLine " + std::to_string(lineNumber) + " (" + enquote(entries[first + i].name) + "): " + rejections[i];
+					}
+					continue;
+				}
+
+				if (accepted != first + i)
+					entries[accepted] = std::move(entries[first + i]);
+				accepted++;
+			}
+
+			entries.resize(accepted);
+			stats.elementSets += records.size();
+			stats.parseTime += std::chrono::duration<double>(Clock::now() - parseStart).count();
+		}
+
+		if (stats.rejected > 0)
+			Log::Print(Log::T_WARNING, __FUNCTION__, "Rejected " + std::to_string(stats.rejected) + " of " + std::to_string(stats.elementSets) + " messages in OMM catalog " + enquote(filePath) + ":" + rejectionReport
+				+ ((stats.rejected > MAX_REPORTED_REJECTIONS) ? "\n\t..." : ""));
+	}
+}
+
+
+
+namespace OMMCatalog {
+	std::optional<Encoding> DetectEncoding(std::string_view content) {
+		// Skip a byte order mark and leading blank lines
+		if (content.starts_with("\xEF\xBB\xBF"))
+			content.remove_prefix(3);
+
+		size_t position = 0;
+		std::string_view line;
+		while (position < content.size() && line.empty())
+			line = Trim(NextLine(content, position));
+
+		if (line.starts_with('<'))
+			return Encoding::XML;
+
+		if (line.starts_with("CCSDS_OMM_VERS") || line.starts_with("COMMENT"))
+			return Encoding::KVN;
+
+		if (line.find(',') != std::string_view::npos && line.find("EPOCH") != std::string_view::npos)
+			return Encoding::CSV;
+
+		return std::nullopt;
+	}
+
+
+	bool IsOMMFile(const std::string &filePath) {
+		FilePathUtils::MappedFile file(filePath);
+
+		// Only the beginning of the file is paged in
+		static constexpr size_t SNIFF_LENGTH = 4096;
+		return DetectEncoding(file.getView().substr(0, SNIFF_LENGTH)).has_value();
+	}
+
+
+	std::vector<TLECatalog::Entry> Load(const std::string &filePath, ThreadPool &pool, TLECatalog::Statistics *stats) {
+		using Clock = std::chrono::steady_clock;
+		const Clock::time_point start = Clock::now();
+
+		FilePathUtils::MappedFile file(filePath);
+		std::string_view content = file.getView();
+
+		if (content.starts_with("\xEF\xBB\xBF"))
+			content.remove_prefix(3);
+
+		const std::optional<Encoding> encoding = DetectEncoding(content);
+		if (!encoding.has_value()) {
+			throw Log::RuntimeException(__FUNCTION__, __LINE__, "The file " + enquote(filePath) + " is not an OMM catalog in KVN, XML, or CSV encoding!");
+			throw;
+		}
+
+		TLECatalog::Statistics loadStats{};
+		loadStats.scanTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+		std::vector<TLECatalog::Entry> entries;
+
+		switch (encoding.value()) {
+		case Encoding::KVN: {
+			_KVNScanner scanner(content);
+			StreamRecords(scanner, Encoding::KVN, content, filePath, pool, entries, loadStats);
+			break;
+		}
+
+		case Encoding::XML: {
+			_XMLScanner scanner(content);
+			StreamRecords(scanner, Encoding::XML, content, filePath, pool, entries, loadStats);
+			break;
+		}
+
+		case Encoding::CSV: {
+			_CSVScanner scanner(content);
+			StreamRecords(scanner, Encoding::CSV, content, filePath, pool, entries, loadStats);
+			break;
+		}
+		}
+
+		if (stats)
+			*stats = loadStats;
+
+		return entries;
+	}
+}
@@ -0,0 +1,64 @@
+/* OMMCatalog.hpp - Bulk loading of CCSDS Orbit Mean-Elements Message (OMM) catalogs.
+	Sources:
+		- CCSDS 502.0-B-3, "Orbit Data Messages", Blue Book, 2023 (Section 4: Orbit Mean-Elements Message).
+		- T. S. Kelso, "A New Way to Obtain GP Data (aka TLEs)", CelesTrak, 2020 (https://celestrak.org/NORAD/documentation/gp-data-formats.php).
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Propagators/SGP4/TLE.hpp>
+#include <Simulation/Propagators/SGP4/TLECatalog.hpp>
+
+
+/* Loads catalogs of Orbit Mean-Elements Messages (e.g., CelesTrak's GP data in KVN, XML, or CSV format), which may hold tens of thousands of objects and run to hundreds of megabytes.
+	Unlike TLEs, OMMs carry their elements at full precision (e.g., the epoch to the microsecond), and catalog numbers beyond 5 digits.
+	The file is memory-mapped and streamed in a single forward pass, without building a document tree: each message is scanned into views of its fields' values, and messages are parsed and initialized for propagation (sgp4init) in parallel, one batch at a time, so that the memory of a load is bounded by the batch size (besides the loaded element sets).
+	Element sets are initialized through the same path as TLE::parseLines, and are returned without TLE lines.
+*/
+namespace OMMCatalog {
+	static constexpr size_t BATCH_SIZE = 16384;			// Messages scanned before a batch is parsed and initialized
+	static constexpr size_t INIT_TASK_SIZE = 256;		// Messages per task of the parallel parse and initialization
+
+
+	/* The encoding of an OMM catalog. */
+	enum class Encoding {
+		KVN,		// Keyword = value notation (concatenated messages, each starting with CCSDS_OMM_VERS)
+		XML,		// CCSDS NDM/XML (one <omm> element per message)
+		CSV			// One message per line, with a header line naming the columns (keywords)
+	};
+
+
+	/* Detects the encoding of an OMM catalog from its leading content.
+		@param content: The content (or the beginning of it).
+
+		@return The encoding, or std::nullopt if the content is not an OMM catalog (e.g., a TLE catalog).
+	*/
+	std::optional<Encoding> DetectEncoding(std::string_view content);
+
+
+	/* Checks whether a file is an OMM catalog.
+		@param filePath: The path to the file.
+
+		@return True if the file is an OMM catalog, false otherwise.
+	*/
+	bool IsOMMFile(const std::string &filePath);
+
+
+	/* Loads a catalog. Rejected messages (missing or malformed fields, unsupported frames or mean element theories, or failed initialization) are skipped, and reported as a warning.
+		@param filePath: The path to the catalog file (KVN, XML, or CSV encoding).
+		@param pool: The thread pool sharing the parse and initialization of messages.
+		@param stats [out] (optional): The statistics of the load.
+
+		@return The element sets, in file order.
+	*/
+	std::vector<TLECatalog::Entry> Load(const std::string &filePath, ThreadPool &pool, TLECatalog::Statistics *stats = nullptr);
+}
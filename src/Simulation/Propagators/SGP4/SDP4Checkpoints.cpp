@@ -0,0 +1,65 @@
+/* SDP4Checkpoints.cpp - SDP4 resonance checkpoint implementation.
+*/
+
+#include "SDP4Checkpoints.hpp"
+
+#include <cmath>
+
+
+void SDP4Checkpoints::clear() {
+	m_forward.clear();
+	m_backward.clear();
+}
+
+
+void SDP4Checkpoints::restore(ElsetRec &rec, double tsince) {
+	if (!IsResonant(rec) || tsince == 0.0)
+		return;
+
+	const double direction = (tsince > 0.0) ? 1.0 : -1.0;
+	std::vector<_State> &ladder = (tsince > 0.0) ? m_forward : m_backward;
+
+	// Checkpoints up to the query (none within the first interval, which is integrated from the epoch)
+	const size_t count = static_cast<size_t>(std::floor(std::fabs(tsince) / INTERVAL));
+	if (count == 0)
+		return;
+
+
+	// Extend the ladder, integrating one interval at a time from its last checkpoint
+	if (ladder.size() < count) {
+		ElsetRec scratch = rec;
+		if (ladder.empty())
+			scratch.atime = 0.0;		// Restart from the epoch
+		else {
+			scratch.atime = ladder.back().atime;
+			scratch.xli = ladder.back().xli;
+			scratch.xni = ladder.back().xni;
+		}
+
+		ladder.reserve(count);
+		double r[3], v[3];
+
+		for (size_t i = ladder.size(); i < count; i++) {
+			// The integrator stops exactly at the query when it is a multiple of the step
+			sgp4(&scratch, direction * static_cast<double>(i + 1) * INTERVAL, r, v);
+			ladder.push_back({ scratch.atime, scratch.xli, scratch.xni });
+		}
+	}
+
+
+	// Resume from the checkpoint, unless the integrator is already between it and the query
+	const _State &checkpoint = ladder[count - 1];
+	const bool isCurrentNearer = (rec.atime * tsince > 0.0) && (std::fabs(rec.atime) <= std::fabs(tsince)) && (std::fabs(rec.atime) >= std::fabs(checkpoint.atime));
+
+	if (!isCurrentNearer) {
+		rec.atime = checkpoint.atime;
+		rec.xli = checkpoint.xli;
+		rec.xni = checkpoint.xni;
+	}
+}
+
+
+bool SDP4Checkpoints::propagate(ElsetRec &rec, double tsince, double r[3], double v[3]) {
+	restore(rec, tsince);
+	return sgp4(&rec, tsince, r, v);
+}
@@ -0,0 +1,70 @@
+/* SDP4Checkpoints.hpp - Checkpoints of the SDP4 deep-space resonance integrator, for random-access propagation.
+	Sources:
+		- D. A. Vallado, P. Crawford, R. Hujsak, T. S. Kelso, "Revisiting Spacetrack Report #3", AIAA 2006-6753, 2006 (dspace: Euler-Maclaurin resonance integration).
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+
+
+/* Stores the resonance integrator state of a deep-space element set at regular intervals from its epoch (a "ladder" of checkpoints, forward and backward in time).
+	dspace() integrates the resonance terms of synchronous (e.g., GEO) and half-day (e.g., Molniya) orbits in fixed steps of STEP minutes from the last time it was queried, and restarts from the epoch whenever the query moves back towards it or crosses it. Without checkpoints, scrubbing backwards or propagating with a negative time scale costs a number of steps proportional to the time since epoch, for every query.
+	Before a query, the integrator is moved to the nearest checkpoint not past the query (unless its own state is already nearer), so that a query integrates fewer than CHECKPOINT_STEPS steps once the ladder reaches it. The ladder is extended lazily, one checkpoint at a time, as queries move away from the epoch.
+	Since the integrator's steps are deterministic (they only depend on its state, and the times of checkpoints are multiples of the step), propagation from a checkpoint is bit-identical to propagation from the epoch.
+*/
+class SDP4Checkpoints {
+public:
+	static constexpr double STEP = 720.0;						// Integrator step of dspace() (min)
+	static constexpr uint32_t CHECKPOINT_STEPS = 16;			// Integrator steps between checkpoints
+	static constexpr double INTERVAL = STEP * CHECKPOINT_STEPS;	// Time between checkpoints (min)
+
+
+	SDP4Checkpoints() = default;
+	~SDP4Checkpoints() = default;
+
+
+	/* Checks whether an element set has a resonance integrator (i.e., whether checkpoints apply to it). */
+	static inline bool IsResonant(const ElsetRec &rec) { return rec.method == 'd' && rec.irez != 0; }
+
+
+	/* Removes every checkpoint (e.g., when the element set changes). */
+	void clear();
+
+
+	/* Moves the resonance integrator of an element set to the nearest checkpoint not past a time since epoch, extending the ladder to it if needed. Does nothing for non-resonant element sets.
+		@param rec: The element set, initialized by sgp4init. Must be the element set the checkpoints were built from.
+		@param tsince: The time since epoch of the next query (min).
+	*/
+	void restore(ElsetRec &rec, double tsince);
+
+
+	/* Propagates an element set from its nearest checkpoint (see SDP4Checkpoints::restore).
+		@param rec: The element set.
+		@param tsince: The time since epoch (min).
+		@param r [out]: The TEME position (km).
+		@param v [out]: The TEME velocity (km/s).
+
+		@return The result of sgp4().
+	*/
+	bool propagate(ElsetRec &rec, double tsince, double r[3], double v[3]);
+
+
+	/* Gets the number of checkpoints (in both directions). */
+	inline size_t size() const { return m_forward.size() + m_backward.size(); }
+
+private:
+	/* The state of the resonance integrator. */
+	struct _State {
+		double atime;		// Time since epoch of the state (min)
+		double xli;
+		double xni;
+	};
+
+	std::vector<_State> m_forward;		// m_forward[i] is the state at (i + 1) * INTERVAL
+	std::vector<_State> m_backward;		// m_backward[i] is the state at -(i + 1) * INTERVAL
+};
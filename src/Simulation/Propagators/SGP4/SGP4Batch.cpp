@@ -0,0 +1,540 @@
+/* SGP4Batch.cpp - Batch SGP4 propagator implementation.
+*/
+
+#include "SGP4Batch.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define SGP4_BATCH_X86
+
+	#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define KERNEL_TARGET(isa)		// MSVC does not require per-function target attributes to emit AVX2/AVX-512 intrinsics
+	#define KERNEL_FLATTEN
+	#define LANE_INLINE __forceinline
+#else
+	#define KERNEL_TARGET(isa) __attribute__((target(isa)))
+	#define KERNEL_FLATTEN __attribute__((flatten))		// Inlines the lane operations into the kernels (they cannot be always_inline, since the generic group code that calls them is not compiled for their target)
+	#define LANE_INLINE inline
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+	#pragma GCC diagnostic ignored "-Wpsabi"		// The generic group code passes AVX vectors by value, but is only ever inlined into kernels compiled for AVX
+#endif
+
+
+namespace {
+	/* Lane types: a group of element sets evaluated by each instruction of the near-Earth kernel, and the per-lane conditions (masks) of its branches.
+		Each type provides Load, store, All and Any, the arithmetic operators, the comparisons <, > and >= (returning masks), and Or, And, Select, Sqrt, Abs, Floor and Trunc.
+	*/
+	struct Lanes1 {
+		using Mask = bool;
+		double v;
+
+		Lanes1() = default;
+		LANE_INLINE Lanes1(double x) : v(x) {}
+
+		static LANE_INLINE Lanes1 Load(const double *p) { return Lanes1(*p); }
+		LANE_INLINE void store(double *p) const { *p = v; }
+
+		static LANE_INLINE Mask All() { return true; }
+		static LANE_INLINE bool Any(Mask m) { return m; }
+	};
+
+	LANE_INLINE Lanes1 operator+(const Lanes1 &a, const Lanes1 &b) { return a.v + b.v; }
+	LANE_INLINE Lanes1 operator-(const Lanes1 &a, const Lanes1 &b) { return a.v - b.v; }
+	LANE_INLINE Lanes1 operator*(const Lanes1 &a, const Lanes1 &b) { return a.v * b.v; }
+	LANE_INLINE Lanes1 operator/(const Lanes1 &a, const Lanes1 &b) { return a.v / b.v; }
+	LANE_INLINE Lanes1 operator-(const Lanes1 &a) { return -a.v; }
+	LANE_INLINE bool operator<(const Lanes1 &a, const Lanes1 &b) { return a.v < b.v; }
+	LANE_INLINE bool operator>(const Lanes1 &a, const Lanes1 &b) { return a.v > b.v; }
+	LANE_INLINE bool operator>=(const Lanes1 &a, const Lanes1 &b) { return a.v >= b.v; }
+	LANE_INLINE bool Or(bool a, bool b) { return a || b; }
+	LANE_INLINE bool And(bool a, bool b) { return a && b; }
+	LANE_INLINE Lanes1 Select(bool mask, const Lanes1 &a, const Lanes1 &b) { return mask ? a : b; }
+	LANE_INLINE Lanes1 Sqrt(const Lanes1 &a) { return std::sqrt(a.v); }
+	LANE_INLINE Lanes1 Abs(const Lanes1 &a) { return std::fabs(a.v); }
+	LANE_INLINE Lanes1 Floor(const Lanes1 &a) { return std::floor(a.v); }
+	LANE_INLINE Lanes1 Trunc(const Lanes1 &a) { return std::trunc(a.v); }
+
+
+#ifdef SGP4_BATCH_X86
+	/* 4 lanes (AVX2 + FMA). */
+	struct Lanes4 {
+		using Mask = __m256d;
+		__m256d v;
+
+		Lanes4() = default;
+		KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4(__m256d x) : v(x) {}
+		KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4(double x) : v(_mm256_set1_pd(x)) {}
+
+		KERNEL_TARGET("avx2,fma") static LANE_INLINE Lanes4 Load(const double *p) { return _mm256_loadu_pd(p); }
+		KERNEL_TARGET("avx2,fma") LANE_INLINE void store(double *p) const { _mm256_storeu_pd(p, v); }
+
+		KERNEL_TARGET("avx2,fma") static LANE_INLINE Mask All() { return _mm256_castsi256_pd(_mm256_set1_epi64x(-1)); }
+		KERNEL_TARGET("avx2,fma") static LANE_INLINE bool Any(const Mask &m) { return _mm256_movemask_pd(m) != 0; }
+	};
+
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 operator+(const Lanes4 &a, const Lanes4 &b) { return _mm256_add_pd(a.v, b.v); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 operator-(const Lanes4 &a, const Lanes4 &b) { return _mm256_sub_pd(a.v, b.v); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 operator*(const Lanes4 &a, const Lanes4 &b) { return _mm256_mul_pd(a.v, b.v); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 operator/(const Lanes4 &a, const Lanes4 &b) { return _mm256_div_pd(a.v, b.v); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 operator-(const Lanes4 &a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE __m256d operator<(const Lanes4 &a, const Lanes4 &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE __m256d operator>(const Lanes4 &a, const Lanes4 &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE __m256d operator>=(const Lanes4 &a, const Lanes4 &b) { return _mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE __m256d Or(const __m256d &a, const __m256d &b) { return _mm256_or_pd(a, b); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE __m256d And(const __m256d &a, const __m256d &b) { return _mm256_and_pd(a, b); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 Select(const __m256d &mask, const Lanes4 &a, const Lanes4 &b) { return _mm256_blendv_pd(b.v, a.v, mask); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 Sqrt(const Lanes4 &a) { return _mm256_sqrt_pd(a.v); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 Abs(const Lanes4 &a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 Floor(const Lanes4 &a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+	KERNEL_TARGET("avx2,fma") LANE_INLINE Lanes4 Trunc(const Lanes4 &a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+
+
+	/* 8 lanes (AVX-512F). */
+	struct Lanes8 {
+		using Mask = __mmask8;
+		__m512d v;
+
+		Lanes8() = default;
+		KERNEL_TARGET("avx512f") LANE_INLINE Lanes8(__m512d x) : v(x) {}
+		KERNEL_TARGET("avx512f") LANE_INLINE Lanes8(double x) : v(_mm512_set1_pd(x)) {}
+
+		KERNEL_TARGET("avx512f") static LANE_INLINE Lanes8 Load(const double *p) { return _mm512_loadu_pd(p); }
+		KERNEL_TARGET("avx512f") LANE_INLINE void store(double *p) const { _mm512_storeu_pd(p, v); }
+
+		static LANE_INLINE Mask All() { return 0xFF; }
+		static LANE_INLINE bool Any(Mask m) { return m != 0; }
+	};
+
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 operator+(const Lanes8 &a, const Lanes8 &b) { return _mm512_add_pd(a.v, b.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 operator-(const Lanes8 &a, const Lanes8 &b) { return _mm512_sub_pd(a.v, b.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 operator*(const Lanes8 &a, const Lanes8 &b) { return _mm512_mul_pd(a.v, b.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 operator/(const Lanes8 &a, const Lanes8 &b) { return _mm512_div_pd(a.v, b.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 operator-(const Lanes8 &a) { return _mm512_sub_pd(_mm512_setzero_pd(), a.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE __mmask8 operator<(const Lanes8 &a, const Lanes8 &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ); }
+	KERNEL_TARGET("avx512f") LANE_INLINE __mmask8 operator>(const Lanes8 &a, const Lanes8 &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ); }
+	KERNEL_TARGET("avx512f") LANE_INLINE __mmask8 operator>=(const Lanes8 &a, const Lanes8 &b) { return _mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ); }
+	LANE_INLINE __mmask8 Or(__mmask8 a, __mmask8 b) { return a | b; }
+	LANE_INLINE __mmask8 And(__mmask8 a, __mmask8 b) { return a & b; }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 Select(__mmask8 mask, const Lanes8 &a, const Lanes8 &b) { return _mm512_mask_blend_pd(mask, b.v, a.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 Sqrt(const Lanes8 &a) { return _mm512_sqrt_pd(a.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 Abs(const Lanes8 &a) { return _mm512_abs_pd(a.v); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 Floor(const Lanes8 &a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+	KERNEL_TARGET("avx512f") LANE_INLINE Lanes8 Trunc(const Lanes8 &a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+#endif
+
+
+	/* Computes x mod 2pi (with the sign of x, as fmod). */
+	template<typename L> inline L Mod2Pi(const L &x) {
+		return x - L(twopi) * Trunc(x * L(1.0 / twopi));
+	}
+
+
+	/* Computes the sine and cosine of x.
+		x is reduced to [-pi/4, pi/4] with a three-part Cody-Waite split of pi/2 (exact for |x| < 2^29), and both functions are evaluated with Cephes' minimax polynomials, whose error is below 1 ulp on the reduced interval.
+	*/
+	template<typename L> inline void SinCos(const L &x, L &sinX, L &cosX) {
+		static constexpr double PIO2_1 = 1.57079625129699707031e+00;
+		static constexpr double PIO2_2 = 7.54978941586159635335e-08;
+		static constexpr double PIO2_3 = 5.39030285815811905290e-15;
+		static constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+
+		static constexpr double S0 = 1.58962301576546568060e-10, S1 = -2.50507477628578072866e-08, S2 = 2.75573136213857245213e-06,
+								S3 = -1.98412698295895385996e-04, S4 = 8.33333333332211858878e-03, S5 = -1.66666666666666307295e-01;
+		static constexpr double C0 = -1.13585365213876817300e-11, C1 = 2.08757008419747316778e-09, C2 = -2.75573141792967388112e-07,
+								C3 = 2.48015872888517045348e-05, C4 = -1.38888888888730564116e-03, C5 = 4.16666666666665929218e-02;
+
+		const L q = Floor(x * L(TWO_OVER_PI) + L(0.5));
+		const L y = ((x - q * L(PIO2_1)) - q * L(PIO2_2)) - q * L(PIO2_3);
+		const L z = y * y;
+
+		const L sinY = y + y * z * (((((L(S0) * z + L(S1)) * z + L(S2)) * z + L(S3)) * z + L(S4)) * z + L(S5));
+		const L cosY = (L(1.0) - L(0.5) * z) + z * z * (((((L(C0) * z + L(C1)) * z + L(C2)) * z + L(C3)) * z + L(C4)) * z + L(C5));
+
+		// Quadrant (0-3): odd quadrants swap sine and cosine, quadrants 2-3 negate the sine, and quadrants 1-2 negate the cosine
+		const L quadrant = q - L(4.0) * Floor(q * L(0.25));
+		const typename L::Mask isOdd = Or(Abs(quadrant - L(1.0)) < L(0.5), Abs(quadrant - L(3.0)) < L(0.5));
+		const typename L::Mask isSinNegative = quadrant > L(1.5);
+		const typename L::Mask isCosNegative = Abs(quadrant - L(1.5)) < L(1.0);
+
+		const L s = Select(isOdd, cosY, sinY);
+		const L c = Select(isOdd, sinY, cosY);
+
+		sinX = Select(isSinNegative, -s, s);
+		cosX = Select(isCosNegative, -c, c);
+	}
+
+
+	/* Propagates a group of near-Earth element sets (one per lane of L), starting at index first.
+		This follows sgp4() (SGP4.cpp) step by step, with method 'n'. The terms that only depend on the element set are precomputed in the store.
+	*/
+	template<typename L> inline void PropagateGroup(SGP4NearEarthStore &store, size_t first, double et) {
+		using Mask = typename L::Mask;
+
+		static constexpr double KEPLER_TOLERANCE = 1.0e-12;
+		static constexpr int MAX_KEPLER_ITERATIONS = 10;
+
+		const L t = (L(et) - L::Load(&store.epochET[first])) / L(60.0);
+
+
+		// Secular gravity and atmospheric drag (the non-simplified terms of element sets with isimp = 1 are zero)
+		const L xmdf = L::Load(&store.mo[first]) + L::Load(&store.mdot[first]) * t;
+		const L argpdf = L::Load(&store.argpo[first]) + L::Load(&store.argpdot[first]) * t;
+		const L nodedf = L::Load(&store.nodeo[first]) + L::Load(&store.nodedot[first]) * t;
+		const L t2 = t * t;
+		L nodem = nodedf + L::Load(&store.nodecf[first]) * t2;
+
+		L sinXmdf, cosXmdf;
+		SinCos(xmdf, sinXmdf, cosXmdf);
+
+		const L delomg = L::Load(&store.omgcof[first]) * t;
+		const L delmtemp = L(1.0) + L::Load(&store.eta[first]) * cosXmdf;
+		const L delm = L::Load(&store.xmcof[first]) * (delmtemp * delmtemp * delmtemp - L::Load(&store.delmo[first]));
+		const L delTotal = delomg + delm;
+		L mm = xmdf + delTotal;
+		L argpm = argpdf - delTotal;
+		const L t3 = t2 * t;
+		const L t4 = t3 * t;
+
+		L sinMm, cosMm;
+		SinCos(mm, sinMm, cosMm);
+
+		const L tempa = (L(1.0) - L::Load(&store.cc1[first]) * t) - L::Load(&store.d2[first]) * t2 - L::Load(&store.d3[first]) * t3 - L::Load(&store.d4[first]) * t4;
+		const L tempe = L::Load(&store.bstarCC4[first]) * t + L::Load(&store.bstarCC5[first]) * (sinMm - L::Load(&store.sinmao[first]));
+		const L templ = L::Load(&store.t2cof[first]) * t2 + L::Load(&store.t3cof[first]) * t3 + t4 * (L::Load(&store.t4cof[first]) + t * L::Load(&store.t5cof[first]));
+
+		const L xke = L::Load(&store.xke[first]);
+		const L am = L::Load(&store.aBase[first]) * tempa * tempa;
+		const L nm = xke / (am * Sqrt(am));
+		L em = L::Load(&store.ecco[first]) - tempe;
+
+		const Mask isEccentricityInvalid = Or(em >= L(1.0), em < L(-0.001));
+		em = Select(em < L(1.0e-6), L(1.0e-6), em);
+
+		mm = mm + L::Load(&store.noUnkozai[first]) * templ;
+		L xlm = mm + argpm + nodem;
+
+		nodem = Mod2Pi(nodem);
+		argpm = Mod2Pi(argpm);
+		xlm = Mod2Pi(xlm);
+		mm = Mod2Pi(xlm - argpm - nodem);
+
+
+		// Long period periodics
+		const L ep = em;
+		const L sinip = L::Load(&store.sinio[first]);
+		const L cosip = L::Load(&store.cosio[first]);
+
+		L sinArgpp, cosArgpp;
+		SinCos(argpm, sinArgpp, cosArgpp);
+
+		const L axnl = ep * cosArgpp;
+		L temp = L(1.0) / (am * (L(1.0) - ep * ep));
+		const L aynl = ep * sinArgpp + temp * L::Load(&store.aycof[first]);
+		const L xl = mm + argpm + nodem + temp * L::Load(&store.xlcof[first]) * axnl;
+
+
+		// Kepler's equation (iterated until every lane has converged; converged lanes are frozen)
+		const L u = Mod2Pi(xl - nodem);
+		L eo1 = u;
+		L sineo1(0.0), coseo1(0.0);
+		Mask isActive = L::All();
+
+		for (int ktr = 1; ktr <= MAX_KEPLER_ITERATIONS && L::Any(isActive); ktr++) {
+			L s, c;
+			SinCos(eo1, s, c);
+
+			L tem5 = L(1.0) - c * axnl - s * aynl;
+			tem5 = (u - aynl * c + axnl * s - eo1) / tem5;
+			tem5 = Select(Abs(tem5) >= L(0.95), Select(tem5 > L(0.0), L(0.95), L(-0.95)), tem5);
+
+			sineo1 = Select(isActive, s, sineo1);
+			coseo1 = Select(isActive, c, coseo1);
+			eo1 = Select(isActive, eo1 + tem5, eo1);
+			isActive = And(isActive, Abs(tem5) >= L(KEPLER_TOLERANCE));
+		}
+
+
+		// Short period preliminary quantities
+		const L ecose = axnl * coseo1 + aynl * sineo1;
+		const L esine = axnl * sineo1 - aynl * coseo1;
+		const L el2 = axnl * axnl + aynl * aynl;
+		const L pl = am * (L(1.0) - el2);
+		const Mask isSemiLatusRectumInvalid = pl < L(0.0);
+
+		const L rl = am * (L(1.0) - ecose);
+		const L rdotl = Sqrt(am) * esine / rl;
+		const L rvdotl = Sqrt(pl) / rl;
+		const L betal = Sqrt(L(1.0) - el2);
+		temp = esine / (L(1.0) + betal);
+		const L sinu = am / rl * (sineo1 - aynl - axnl * temp);
+		const L cosu = am / rl * (coseo1 - axnl + aynl * temp);
+		const L sin2u = (cosu + cosu) * sinu;
+		const L cos2u = L(1.0) - L(2.0) * sinu * sinu;
+		temp = L(1.0) / pl;
+		const L temp1 = L(0.5) * L::Load(&store.j2[first]) * temp;
+		const L temp2 = temp1 * temp;
+
+
+		// Short period periodics
+		const L con41 = L::Load(&store.con41[first]);
+		const L x1mth2 = L::Load(&store.x1mth2[first]);
+
+		const L mrt = rl * (L(1.0) - L(1.5) * temp2 * betal * con41) + L(0.5) * temp1 * x1mth2 * cos2u;
+		const L xnode = nodem + L(1.5) * temp2 * cosip * sin2u;
+		const L xinc = L::Load(&store.inclo[first]) + L(1.5) * temp2 * cosip * sinip * cos2u;
+		const L mvt = rdotl - nm * temp1 * x1mth2 * sin2u / xke;
+		const L rvdot = rvdotl + nm * temp1 * (x1mth2 * cos2u + L(1.5) * con41) / xke;
+
+		// su = atan2(sinu, cosu) - dsu: its sine and cosine follow from the angle difference identities, without evaluating atan2
+		const L dsu = L(0.25) * temp2 * L::Load(&store.x7thm1[first]) * sin2u;
+		const L invNorm = L(1.0) / Sqrt(sinu * sinu + cosu * cosu);
+
+		L sinDsu, cosDsu;
+		SinCos(dsu, sinDsu, cosDsu);
+
+		const L sinsu = (sinu * invNorm) * cosDsu - (cosu * invNorm) * sinDsu;
+		const L cossu = (cosu * invNorm) * cosDsu + (sinu * invNorm) * sinDsu;
+
+
+		// Orientation vectors
+		L snod, cnod, sini, cosi;
+		SinCos(xnode, snod, cnod);
+		SinCos(xinc, sini, cosi);
+
+		const L xmx = -snod * cosi;
+		const L xmy = cnod * cosi;
+		const L ux = xmx * sinsu + cnod * cossu;
+		const L uy = xmy * sinsu + snod * cossu;
+		const L uz = sini * sinsu;
+		const L vx = xmx * cossu - cnod * sinsu;
+		const L vy = xmy * cossu - snod * sinsu;
+		const L vz = sini * cossu;
+
+
+		// Position and velocity (km, km/s); zero for element sets that sgp4() would reject before computing them
+		const L radiusEarth = L::Load(&store.radiusEarth[first]);
+		const L vkmpersec = radiusEarth * xke / L(60.0);
+
+		const Mask isInvalid = Or(isEccentricityInvalid, isSemiLatusRectumInvalid);
+		const L zero(0.0);
+
+		Select(isInvalid, zero, (mrt * ux) * radiusEarth).store(store.rx.data() + first);
+		Select(isInvalid, zero, (mrt * uy) * radiusEarth).store(store.ry.data() + first);
+		Select(isInvalid, zero, (mrt * uz) * radiusEarth).store(store.rz.data() + first);
+		Select(isInvalid, zero, (mvt * ux + rvdot * vx) * vkmpersec).store(store.vx.data() + first);
+		Select(isInvalid, zero, (mvt * uy + rvdot * vy) * vkmpersec).store(store.vy.data() + first);
+		Select(isInvalid, zero, (mvt * uz + rvdot * vz) * vkmpersec).store(store.vz.data() + first);
+
+		// Error codes, in the order sgp4() checks them (1: eccentricity, 4: semi-latus rectum, 6: decayed)
+		Select(isEccentricityInvalid, L(1.0), Select(isSemiLatusRectumInvalid, L(4.0), Select(mrt < L(1.0), L(6.0), zero))).store(store.error.data() + first);
+	}
+
+
+	void PropagateNearEarth_Scalar(SGP4NearEarthStore &store, size_t first, size_t last, double et) {
+		for (size_t i = first; i < last; i++)
+			PropagateGroup<Lanes1>(store, i, et);
+	}
+
+
+#ifdef SGP4_BATCH_X86
+	KERNEL_TARGET("avx2,fma") KERNEL_FLATTEN
+	void PropagateNearEarth_AVX2(SGP4NearEarthStore &store, size_t first, size_t last, double et) {
+		for (size_t g = first; g < last; g += 4)
+			PropagateGroup<Lanes4>(store, g, et);
+	}
+
+
+	KERNEL_TARGET("avx512f") KERNEL_FLATTEN
+	void PropagateNearEarth_AVX512(SGP4NearEarthStore &store, size_t first, size_t last, double et) {
+		for (size_t g = first; g < last; g += 8)
+			PropagateGroup<Lanes8>(store, g, et);
+	}
+#endif
+}
+
+
+
+void SGP4Batch::clear() {
+	m_nearEarth.resize(0);
+	m_nearEarthCount = 0;
+	m_nearEarthSlots.clear();
+
+	m_deepSpace.clear();
+	m_deepSpaceEpochs.clear();
+	m_deepSpaceSlots.clear();
+	m_deepSpaceCheckpoints.clear();
+
+	m_errors.clear();
+}
+
+
+size_t SGP4Batch::add(const ElsetRec &rec, double epochET) {
+	const size_t slot = m_errors.size();
+	m_errors.push_back(0);
+
+	if (rec.method == 'd') {
+		m_deepSpace.push_back(rec);
+		m_deepSpaceEpochs.push_back(epochET);
+		m_deepSpaceSlots.push_back(static_cast<uint32_t>(slot));
+		m_deepSpaceCheckpoints.emplace_back();
+
+		return slot;
+	}
+
+
+	const size_t i = m_nearEarthCount++;
+	m_nearEarthSlots.push_back(static_cast<uint32_t>(slot));
+
+	SGP4NearEarthStore &s = m_nearEarth;
+	s.resize(i + 1);
+
+	const bool isSimplified = (rec.isimp == 1);
+	auto nonSimplified = [isSimplified](double term) { return isSimplified ? 0.0 : term; };
+
+	s.epochET[i] = epochET;
+	s.mo[i] = rec.mo;			s.mdot[i] = rec.mdot;
+	s.argpo[i] = rec.argpo;		s.argpdot[i] = rec.argpdot;
+	s.nodeo[i] = rec.nodeo;		s.nodedot[i] = rec.nodedot;		s.nodecf[i] = rec.nodecf;
+
+	s.cc1[i] = rec.cc1;
+	s.bstarCC4[i] = rec.bstar * rec.cc4;
+	s.bstarCC5[i] = nonSimplified(rec.bstar * rec.cc5);
+	s.t2cof[i] = rec.t2cof;
+	s.t3cof[i] = nonSimplified(rec.t3cof);
+	s.t4cof[i] = nonSimplified(rec.t4cof);
+	s.t5cof[i] = nonSimplified(rec.t5cof);
+	s.omgcof[i] = nonSimplified(rec.omgcof);
+	s.xmcof[i] = nonSimplified(rec.xmcof);
+	s.eta[i] = nonSimplified(rec.eta);
+	s.delmo[i] = nonSimplified(rec.delmo);
+	s.sinmao[i] = nonSimplified(rec.sinmao);
+	s.d2[i] = nonSimplified(rec.d2);
+	s.d3[i] = nonSimplified(rec.d3);
+	s.d4[i] = nonSimplified(rec.d4);
+
+	s.noUnkozai[i] = rec.no_unkozai;
+	s.ecco[i] = rec.ecco;
+	s.inclo[i] = rec.inclo;
+	s.sinio[i] = std::sin(rec.inclo);
+	s.cosio[i] = std::cos(rec.inclo);
+	s.aBase[i] = std::pow(rec.xke / rec.no_unkozai, 2.0 / 3.0);
+	s.aycof[i] = rec.aycof;
+	s.xlcof[i] = rec.xlcof;
+	s.con41[i] = rec.con41;
+	s.x1mth2[i] = rec.x1mth2;
+	s.x7thm1[i] = rec.x7thm1;
+	s.xke[i] = rec.xke;
+	s.j2[i] = rec.j2;
+	s.radiusEarth[i] = rec.radiusearthkm;
+
+	return slot;
+}
+
+
+void SGP4Batch::propagate(double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities, GravityKernels::InstructionSet instructionSet) {
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+
+	preparePropagation(positions, velocities);
+
+	const size_t taskCount = getTaskCount();
+	for (size_t task = 0; task < taskCount; task++)
+		propagateTask(task, et, positions.data(), velocities.data(), instructionSet);
+
+	m_stats.propagations += size();
+	m_stats.deepSpacePropagations += m_deepSpace.size();
+	m_stats.elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+void SGP4Batch::propagate(double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities, ThreadPool &pool, uint32_t maxThreads, GravityKernels::InstructionSet instructionSet) {
+	using Clock = std::chrono::steady_clock;
+	const Clock::time_point start = Clock::now();
+
+	preparePropagation(positions, velocities);
+
+	glm::dvec3 *positionSlots = positions.data();
+	glm::dvec3 *velocitySlots = velocities.data();
+
+	pool.parallelFor(getTaskCount(), [&](size_t task) {
+		propagateTask(task, et, positionSlots, velocitySlots, instructionSet);
+	}, maxThreads);
+
+	m_stats.propagations += size();
+	m_stats.deepSpacePropagations += m_deepSpace.size();
+	m_stats.elapsed += std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+void SGP4Batch::preparePropagation(std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities) {
+	// The store is padded to whole groups with copies of the last element set
+	if (m_nearEarthCount > 0)
+		m_nearEarth.resize((m_nearEarthCount + GROUP_SIZE - 1) / GROUP_SIZE * GROUP_SIZE);
+
+	positions.resize(size());
+	velocities.resize(size());
+}
+
+
+void SGP4Batch::propagateTask(size_t task, double et, glm::dvec3 *positions, glm::dvec3 *velocities, GravityKernels::InstructionSet instructionSet) {
+	const size_t deepSpaceTaskCount = getDeepSpaceTaskCount();
+
+	// Deep-space element sets
+	if (task < deepSpaceTaskCount) {
+		const size_t first = task * DEEP_SPACE_TASK_SIZE;
+		const size_t last = std::min(first + DEEP_SPACE_TASK_SIZE, m_deepSpace.size());
+
+		for (size_t k = first; k < last; k++) {
+			double r[3] = { 0.0, 0.0, 0.0 }, v[3] = { 0.0, 0.0, 0.0 };
+			m_deepSpaceCheckpoints[k].propagate(m_deepSpace[k], (et - m_deepSpaceEpochs[k]) / 60.0, r, v);
+
+			const uint32_t slot = m_deepSpaceSlots[k];
+			positions[slot] = glm::dvec3(r[0], r[1], r[2]);
+			velocities[slot] = glm::dvec3(v[0], v[1], v[2]);
+			m_errors[slot] = m_deepSpace[k].error;
+		}
+
+		return;
+	}
+
+
+	// Near-Earth groups (the last task ends at the padded end of the store)
+	const size_t first = (task - deepSpaceTaskCount) * TASK_SIZE;
+	const size_t last = std::min(first + TASK_SIZE, m_nearEarth.size());
+
+	switch (instructionSet) {
+#ifdef SGP4_BATCH_X86
+	case GravityKernels::InstructionSet::AVX512:
+		PropagateNearEarth_AVX512(m_nearEarth, first, last, et);
+		break;
+
+	case GravityKernels::InstructionSet::AVX2:
+		PropagateNearEarth_AVX2(m_nearEarth, first, last, et);
+		break;
+#endif
+
+	default:
+		PropagateNearEarth_Scalar(m_nearEarth, first, last, et);
+		break;
+	}
+
+	// Scatter
+	const SGP4NearEarthStore &s = m_nearEarth;
+	const size_t end = std::min(last, m_nearEarthCount);
+
+	for (size_t k = first; k < end; k++) {
+		const uint32_t slot = m_nearEarthSlots[k];
+		positions[slot] = glm::dvec3(s.rx[k], s.ry[k], s.rz[k]);
+		velocities[slot] = glm::dvec3(s.vx[k], s.vy[k], s.vz[k]);
+		m_errors[slot] = static_cast<int>(s.error[k]);
+	}
+}
@@ -0,0 +1,196 @@
+/* SGP4Batch.hpp - Batch SGP4 propagation of large element set catalogs.
+	Sources:
+		- D. A. Vallado, P. Crawford, R. Hujsak, T. S. Kelso, "Revisiting Spacetrack Report #3", AIAA 2006-6753, 2006.
+		- S. L. Moshier, "Cephes Mathematical Library" (sin.c: argument reduction and minimax polynomials of sine and cosine).
+*/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Gravity/GravityKernels.hpp>
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+#include <Simulation/Propagators/SGP4/SDP4Checkpoints.hpp>
+
+
+/* Stores the near-Earth (SGP4) element sets of a batch as contiguous arrays of doubles (one array per term of the model that is constant after initialization), so that a group of element sets can be loaded into SIMD registers with packed loads.
+	The arrays are padded to a multiple of SGP4Batch::GROUP_SIZE with copies of the last element set.
+*/
+struct SGP4NearEarthStore {
+	std::vector<double> epochET;		// Epoch of the element set, in Ephemeris Time
+
+	// Secular rates
+	std::vector<double> mo, mdot;
+	std::vector<double> argpo, argpdot;
+	std::vector<double> nodeo, nodedot, nodecf;
+
+	// Drag (the non-simplified terms are zero for element sets with isimp = 1)
+	std::vector<double> cc1, bstarCC4, bstarCC5, t2cof, t3cof, t4cof, t5cof;
+	std::vector<double> omgcof, xmcof, eta, delmo, sinmao;
+	std::vector<double> d2, d3, d4;
+
+	// Mean elements and constants
+	std::vector<double> noUnkozai, ecco, inclo, sinio, cosio;
+	std::vector<double> aBase;			// (xke / no_unkozai)^(2/3), the semi-major axis before drag
+	std::vector<double> aycof, xlcof, con41, x1mth2, x7thm1;
+	std::vector<double> xke, j2, radiusEarth;
+
+	// Outputs (TEME; km, km/s)
+	std::vector<double> rx, ry, rz;
+	std::vector<double> vx, vy, vz;
+	std::vector<double> error;			// SGP4 error code
+
+
+	/* Gets the number of element sets in the store (including padding). */
+	inline size_t size() const { return epochET.size(); }
+
+
+	/* Resizes the store. New element sets are copies of the last one (or zero, if the store is empty). */
+	inline void resize(size_t count) {
+		for (std::vector<double> *array : {
+			&epochET, &mo, &mdot, &argpo, &argpdot, &nodeo, &nodedot, &nodecf,
+			&cc1, &bstarCC4, &bstarCC5, &t2cof, &t3cof, &t4cof, &t5cof, &omgcof, &xmcof, &eta, &delmo, &sinmao, &d2, &d3, &d4,
+			&noUnkozai, &ecco, &inclo, &sinio, &cosio, &aBase, &aycof, &xlcof, &con41, &x1mth2, &x7thm1, &xke, &j2, &radiusEarth,
+			&rx, &ry, &rz, &vx, &vy, &vz, &error
+		})
+			array->resize(count, array->empty() ? 0.0 : array->back());
+	}
+};
+
+
+/* Propagates many element sets to a common epoch.
+	Near-Earth element sets (SGP4) are propagated in groups of GROUP_SIZE: each step of the model is applied to a whole group at once, so that it compiles to packed SIMD instructions (two AVX2 or one AVX-512 instruction per group). Branches of the scalar model become per-lane selects, Kepler's equation is iterated until every lane of a group has converged, and sine and cosine are evaluated with vectorizable polynomials.
+	Deep-space element sets (SDP4), whose resonance integration is sequential, are queued separately and propagated one by one with the scalar model. Each keeps a ladder of resonance integrator checkpoints (see SDP4Checkpoints), so that the cost of propagating it is bounded wherever the epoch moves (e.g., when scrubbing backwards).
+	Propagation is split into tasks of contiguous element sets, which may run across a thread pool: every element set is independent, and every task writes only the output slots of its own element sets, so tasks share no locks and (once the outputs have been sized by the first propagation) allocate nothing.
+	Positions agree with the scalar sgp4() to within rounding of the polynomial approximations (micrometers over days of propagation).
+*/
+class SGP4Batch {
+public:
+	/* Propagation statistics. */
+	struct Statistics {
+		uint64_t propagations = 0;				// Element sets propagated
+		uint64_t deepSpacePropagations = 0;		// Element sets propagated by the scalar (deep-space) queue
+		double elapsed = 0.0;					// Time spent propagating (s)
+
+		/* Gets the throughput (propagations/s). */
+		inline double getThroughput() const { return (elapsed > 0.0) ? propagations / elapsed : 0.0; }
+	};
+
+
+	static constexpr size_t GROUP_SIZE = 8;					// Element sets per group (one AVX-512 register, or two AVX2 registers, per term)
+	static constexpr size_t TASK_SIZE = 64 * GROUP_SIZE;		// Near-Earth element sets per task (a multiple of GROUP_SIZE)
+	static constexpr size_t DEEP_SPACE_TASK_SIZE = 16;			// Deep-space element sets per task
+	static constexpr size_t SCATTER_TASK_SIZE = 1024;			// Element sets per task of SGP4Batch::scatterStates
+
+
+	SGP4Batch() = default;
+	~SGP4Batch() = default;
+
+
+	/* Removes every element set. */
+	void clear();
+
+
+	/* Adds an element set to the batch.
+		@param rec: The element set, initialized by sgp4init.
+		@param epochET: The epoch of the element set, in Ephemeris Time.
+
+		@return The index of the element set's outputs.
+	*/
+	size_t add(const ElsetRec &rec, double epochET);
+
+
+	/* Propagates every element set to an epoch.
+		@param et: The epoch, in Ephemeris Time.
+		@param positions [out]: The TEME positions (km), in the order the element sets were added. Zero for element sets that failed with error codes 1-4 (see SGP4Batch::getErrors).
+		@param velocities [out]: The TEME velocities (km/s), in the order the element sets were added.
+		@param instructionSet: The instruction set of the near-Earth kernel. Must be supported by the host CPU.
+	*/
+	void propagate(double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities, GravityKernels::InstructionSet instructionSet = GravityKernels::GetSupportedInstructionSet());
+
+
+	/* Propagates every element set to an epoch, with the tasks of the propagation shared across a thread pool.
+		The outputs are identical to those of the serial overload, regardless of the number of threads.
+
+		@param et: The epoch, in Ephemeris Time.
+		@param positions [out]: The TEME positions (km), in the order the element sets were added.
+		@param velocities [out]: The TEME velocities (km/s), in the order the element sets were added.
+		@param pool: The thread pool.
+		@param maxThreads (optional): The maximum number of threads (including the calling thread) taking part. If 0, every thread of the pool is used.
+		@param instructionSet (optional): The instruction set of the near-Earth kernel. Must be supported by the host CPU.
+	*/
+	void propagate(double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities, ThreadPool &pool, uint32_t maxThreads = 0, GravityKernels::InstructionSet instructionSet = GravityKernels::GetSupportedInstructionSet());
+
+
+	/* Rotates the states of the last propagation from TEME into another frame, converts them from km and km/s to m and m/s, and hands them to a callback, with the tasks shared across a thread pool.
+		Every element set is handed to exactly one task, so a callback that only writes to the element set's own data (e.g., its entity's components) needs no locks.
+
+		@param positions: The TEME positions of the last propagation (km).
+		@param velocities: The TEME velocities of the last propagation (km/s).
+		@param rotation: The rotation from TEME to the target frame (shared by every element set, since they share the epoch).
+		@param pool: The thread pool.
+		@param scatter: The callback, called as `scatter(size_t index, int error, const glm::dvec3 &position, const glm::dvec3 &velocity)` for every element set, with its output slot, its error code (see SGP4Batch::getErrors), and its state in the target frame (m, m/s). The state is invalid for error codes 1-4.
+		@param maxThreads (optional): The maximum number of threads (including the calling thread) taking part. If 0, every thread of the pool is used.
+	*/
+	template<typename Scatter>
+	inline void scatterStates(const std::vector<glm::dvec3> &positions, const std::vector<glm::dvec3> &velocities, const glm::dmat3 &rotation, ThreadPool &pool, Scatter &&scatter, uint32_t maxThreads = 0) const {
+		const size_t count = size();
+
+		pool.parallelFor((count + SCATTER_TASK_SIZE - 1) / SCATTER_TASK_SIZE, [&](size_t task) {
+			const size_t end = std::min(count, (task + 1) * SCATTER_TASK_SIZE);
+
+			for (size_t k = task * SCATTER_TASK_SIZE; k < end; k++)
+				scatter(k, m_errors[k], (rotation * positions[k]) * 1e3, (rotation * velocities[k]) * 1e3);
+		}, maxThreads);
+	}
+
+
+	/* Gets the SGP4 error codes of the last propagation (0 if successful), in the order the element sets were added. */
+	inline const std::vector<int> &getErrors() const { return m_errors; }
+
+
+	inline size_t size() const { return m_errors.size(); }
+	inline size_t getDeepSpaceCount() const { return m_deepSpace.size(); }
+
+	inline const Statistics &getStatistics() const { return m_stats; }
+	inline void resetStatistics() { m_stats = Statistics(); }
+
+private:
+	SGP4NearEarthStore m_nearEarth;
+	size_t m_nearEarthCount = 0;					// Near-Earth element sets (without padding)
+	std::vector<uint32_t> m_nearEarthSlots;			// Output slot (i.e., order of addition) of each near-Earth element set
+
+	std::vector<ElsetRec> m_deepSpace;				// Deep-space queue
+	std::vector<double> m_deepSpaceEpochs;
+	std::vector<uint32_t> m_deepSpaceSlots;			// Output slot of each deep-space element set
+	std::vector<SDP4Checkpoints> m_deepSpaceCheckpoints;	// Resonance integrator checkpoints of each deep-space element set
+
+	std::vector<int> m_errors;						// Indexed by output slot
+	Statistics m_stats;
+
+
+	/* Gets the number of deep-space and near-Earth tasks, in that order (deep-space tasks are the slowest, so they are handed out first). */
+	inline size_t getDeepSpaceTaskCount() const { return (m_deepSpace.size() + DEEP_SPACE_TASK_SIZE - 1) / DEEP_SPACE_TASK_SIZE; }
+	inline size_t getTaskCount() const { return getDeepSpaceTaskCount() + (m_nearEarthCount + TASK_SIZE - 1) / TASK_SIZE; }
+
+
+	/* Pads the near-Earth store to whole groups, and sizes the outputs. */
+	void preparePropagation(std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities);
+
+
+	/* Propagates the element sets of a task, and writes their outputs.
+		@param task: The index of the task.
+		@param et: The epoch, in Ephemeris Time.
+		@param positions [out]: The positions of every element set (indexed by output slot).
+		@param velocities [out]: The velocities of every element set (indexed by output slot).
+		@param instructionSet: The instruction set of the near-Earth kernel.
+	*/
+	void propagateTask(size_t task, double et, glm::dvec3 *positions, glm::dvec3 *velocities, GravityKernels::InstructionSet instructionSet);
+};
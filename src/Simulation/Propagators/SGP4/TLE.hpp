@@ -50,4 +50,10 @@ public:
 
     void getRV(double minutesAfterEpoch, double r[3], double v[3]);
 
-};
\ No newline at end of file
+};
+
+// parse the epoch field of line 1 (column 19 onwards) into the element set; returns the epoch in milliseconds since 1970
+long parseEpoch(ElsetRec *rec, char *str);
+
+// copy the parsed elements into the element set, and initialize it (sgp4init)
+void setValsToRec(TLE *tle, ElsetRec *rec);
\ No newline at end of file
@@ -0,0 +1,302 @@
+/* TLECatalog.cpp - TLE/3LE catalog loader implementation.
+*/
+
+#include "TLECatalog.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+
+
+#include <Core/Utils/FilePathUtils.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+
+
+namespace {
+	/* The lines of an element set in a mapped catalog. */
+	struct _Record {
+		std::string_view name;		// Empty if the catalog has no names
+		std::string_view line1;
+		std::string_view line2;		// Empty if the first line is not followed by a second line
+		size_t lineNumber;			// Line number (1-based) of the first line
+	};
+
+
+	inline bool IsBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+
+	inline std::string_view Trim(std::string_view str) {
+		while (!str.empty() && IsBlank(str.front()))
+			str.remove_prefix(1);
+		while (!str.empty() && IsBlank(str.back()))
+			str.remove_suffix(1);
+
+		return str;
+	}
+
+
+	/* Gets a field of a line (columns [first, last), 0-based), without its surrounding blanks. */
+	inline std::string_view GetField(std::string_view line, size_t first, size_t last) {
+		return Trim(line.substr(first, last - first));
+	}
+
+
+	/* Parses a decimal field. */
+	bool ParseDouble(std::string_view line, size_t first, size_t last, double &value) {
+		std::string_view field = GetField(line, first, last);
+		if (!field.empty() && field.front() == '+')
+			field.remove_prefix(1);
+		if (field.empty())
+			return false;
+
+		const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+		return error == std::errc() && end == field.data() + field.size();
+	}
+
+
+	/* Parses an integer field (a blank field is zero, as in TLE::parseLines). */
+	bool ParseInteger(std::string_view line, size_t first, size_t last, int &value) {
+		std::string_view field = GetField(line, first, last);
+		if (!field.empty() && field.front() == '+')
+			field.remove_prefix(1);
+		if (field.empty()) {
+			value = 0;
+			return true;
+		}
+
+		const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+		return error == std::errc() && end == field.data() + field.size();
+	}
+
+
+	/* Parses a field of digits with an implied leading decimal point (e.g., "1859667" is 0.1859667).
+		The digits are parsed as an integer and divided by a power of ten; both are exact, so the quotient is the correctly rounded value of the field, as strtod would return.
+	*/
+	bool ParseImpliedDecimal(std::string_view line, size_t first, size_t last, double &value) {
+		static constexpr double POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+		const std::string_view field = GetField(line, first, last);
+		if (field.empty() || field.size() >= std::size(POWERS_OF_TEN))
+			return false;
+
+		uint64_t mantissa = 0;
+		for (char c : field) {
+			if (c < '0' || c > '9')
+				return false;
+			mantissa = 10 * mantissa + static_cast<uint64_t>(c - '0');
+		}
+
+		value = static_cast<double>(mantissa) / POWERS_OF_TEN[field.size()];
+		return true;
+	}
+
+
+	/* Parses a field in exponential notation with an implied leading decimal point and a sign column (e.g., "-11606-4" is -0.11606e-4), as TLE::parseLines does. */
+	bool ParseExponential(std::string_view line, size_t signColumn, size_t mantissaEnd, size_t exponentEnd, double &value) {
+		int exponent = 0;
+		if (!ParseImpliedDecimal(line, signColumn + 1, mantissaEnd, value) || !ParseInteger(line, mantissaEnd, exponentEnd, exponent))
+			return false;
+
+		if (line[signColumn] == '-')
+			value *= -1.0;
+		value *= pow(10.0, static_cast<double>(exponent));
+
+		return true;
+	}
+}
+
+
+
+namespace TLECatalog {
+	bool VerifyChecksum(std::string_view line) {
+		if (line.size() < LINE_LENGTH)
+			return false;
+
+		int sum = 0;
+		for (size_t i = 0; i < LINE_LENGTH - 1; i++) {
+			if (line[i] >= '0' && line[i] <= '9')
+				sum += line[i] - '0';
+			else if (line[i] == '-')
+				sum++;
+		}
+
+		return line[LINE_LENGTH - 1] == static_cast<char>('0' + sum % 10);
+	}
+
+
+	const char *ParseElementSet(std::string_view line1, std::string_view line2, TLE &tle) {
+		// Structure
+		if (line2.empty())
+			return "The first line is not followed by a second line";
+
+		if (line1.size() < LINE_LENGTH || line2.size() < LINE_LENGTH)
+			return "A line is shorter than 69 columns";
+
+		if (line1[0] != '1' || line2[0] != '2')
+			return "Unexpected line numbers";
+
+		if (line1.substr(2, 5) != line2.substr(2, 5))
+			return "The catalog numbers of the two lines differ";
+
+		if (!VerifyChecksum(line1) || !VerifyChecksum(line2))
+			return "Checksum mismatch";
+
+
+		// Fields (columns as in TLE::parseLines)
+		//          1         2         3         4         5         6
+		//0123456789012345678901234567890123456789012345678901234567890123456789
+		//1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753
+		//2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667
+		double epochField;
+		if (!ParseDouble(line1, 18, 32, epochField) ||
+			!ParseDouble(line1, 33, 43, tle.ndot) ||
+			!ParseExponential(line1, 44, 50, 52, tle.nddot) ||
+			!ParseExponential(line1, 53, 59, 61, tle.bstar) ||
+			!ParseInteger(line1, 64, 68, tle.elnum))
+			return "Malformed field in the first line";
+
+		if (!ParseDouble(line2, 8, 16, tle.incDeg) ||
+			!ParseDouble(line2, 17, 25, tle.raanDeg) ||
+			!ParseImpliedDecimal(line2, 26, 33, tle.ecc) ||
+			!ParseDouble(line2, 34, 42, tle.argpDeg) ||
+			!ParseDouble(line2, 43, 51, tle.maDeg) ||
+			!ParseDouble(line2, 52, 63, tle.n) ||
+			!ParseInteger(line2, 63, 68, tle.revnum))
+			return "Malformed field in the second line";
+
+		const double dayOfYear = epochField - 1000.0 * std::floor(epochField / 1000.0);
+		if (dayOfYear < 1.0 || dayOfYear >= 367.0)
+			return "The epoch is out of range";
+
+
+		// Copy the lines and identifiers into the element set
+		std::memcpy(tle.line1, line1.data(), LINE_LENGTH);
+		std::memcpy(tle.line2, line2.data(), LINE_LENGTH);
+		tle.line1[LINE_LENGTH] = 0;
+		tle.line2[LINE_LENGTH] = 0;
+
+		std::memcpy(tle.intlid, &tle.line1[9], 8);
+		tle.intlid[8] = 0;
+		std::memcpy(tle.objectID, &tle.line1[2], 5);
+		tle.objectID[5] = 0;
+
+		tle.rec.whichconst = wgs72;
+		tle.rec.classification = tle.line1[7];
+		tle.sgp4Error = 0;
+
+
+		// Epoch and initialization
+		tle.epoch = parseEpoch(&tle.rec, &tle.line1[18]);
+		setValsToRec(&tle, &tle.rec);
+
+		if (tle.rec.error != 0)
+			return "SGP4 initialization failed";
+
+		return nullptr;
+	}
+
+
+	std::vector<Entry> Load(const std::string &filePath, ThreadPool &pool, Statistics *stats) {
+		using Clock = std::chrono::steady_clock;
+		const Clock::time_point start = Clock::now();
+
+		FilePathUtils::MappedFile file(filePath);
+		const std::string_view content = file.getView();
+
+
+		// Split the file into element sets: a line starting with "1 " and the line after it, preceded by the object's name in 3LE catalogs
+		std::vector<_Record> records;
+		records.reserve(content.size() / (2 * (LINE_LENGTH + 1)));
+
+		std::string_view previousLine;		// Candidate name: the last line that is not part of an element set
+		size_t lineNumber = 0;
+		size_t position = 0;
+
+		auto nextLine = [&]() {
+			const size_t end = std::min(content.find('\n', position), content.size());
+			const std::string_view line = content.substr(position, end - position);
+
+			position = end + 1;
+			lineNumber++;
+			return line;
+		};
+
+		while (position < content.size()) {
+			const std::string_view line = nextLine();
+
+			if (line.size() < 2 || line[0] != '1' || line[1] != ' ') {
+				previousLine = Trim(line);
+				continue;
+			}
+
+			_Record record{ .name = previousLine, .line1 = line, .line2 = {}, .lineNumber = lineNumber };
+			previousLine = {};
+
+			// The second line is only consumed if it is one (so that a truncated element set does not swallow the next object's name)
+			if (position < content.size() && content[position] == '2')
+				record.line2 = nextLine();
+
+			// Name lines of 3LE catalogs may be prefixed with their line number
+			if (record.name.size() > 2 && record.name[0] == '0' && record.name[1] == ' ')
+				record.name = Trim(record.name.substr(2));
+
+			records.push_back(record);
+		}
+
+		const Clock::time_point scanEnd = Clock::now();
+
+
+		// Parse and initialize element sets in parallel (each task writes only to its own entries)
+		std::vector<Entry> entries(records.size());
+		std::vector<const char *> rejections(records.size(), nullptr);
+
+		pool.parallelFor((records.size() + INIT_TASK_SIZE - 1) / INIT_TASK_SIZE, [&](size_t task) {
+			const size_t end = std::min(records.size(), (task + 1) * INIT_TASK_SIZE);
+
+			for (size_t i = task * INIT_TASK_SIZE; i < end; i++) {
+				const _Record &record = records[i];
+				Entry &entry = entries[i];
+
+				rejections[i] = ParseElementSet(Trim(record.line1), Trim(record.line2), entry.tle);
+				entry.name = record.name.empty() ? std::string(GetField(record.line1, 2, 7)) : std::string(record.name);
+			}
+		});
+
+
+		// Remove rejected element sets, and report them
+		static constexpr size_t MAX_REPORTED_REJECTIONS = 10;
+
+		std::string rejectionReport;
+		size_t accepted = 0;
+
+		for (size_t i = 0; i < entries.size(); i++) {
+			if (rejections[i]) {
+				if (i - accepted < MAX_REPORTED_REJECTIONS)
+					rejectionReport += "\n\tLine " + std::to_string(records[i].lineNumber) + " (" + enquote(entries[i].name) + "): " + rejections[i];
+				continue;
+			}
+
+			if (accepted != i)
+				entries[accepted] = std::move(entries[i]);
+			accepted++;
+		}
+
+		const size_t rejected = entries.size() - accepted;
+		entries.resize(accepted);
+
+		if (rejected > 0)
+			Log::Print(Log::T_WARNING, __FUNCTION__, "Rejected " + std::to_string(rejected) + " of " + std::to_string(records.size()) + " element sets in catalog " + enquote(filePath) + ":" + rejectionReport
+				+ ((rejected > MAX_REPORTED_REJECTIONS) ? "\n\t..." : ""));
+
+		if (stats) {
+			stats->elementSets = records.size();
+			stats->rejected = rejected;
+			stats->scanTime = std::chrono::duration<double>(scanEnd - start).count();
+			stats->parseTime = std::chrono::duration<double>(Clock::now() - scanEnd).count();
+		}
+
+		return entries;
+	}
+}
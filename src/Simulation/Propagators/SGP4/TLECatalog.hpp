@@ -0,0 +1,70 @@
+/* TLECatalog.hpp - Bulk loading of TLE/3LE element set catalogs.
+	Sources:
+		- CelesTrak, "NORAD Two-Line Element Set Format" (https://celestrak.org/NORAD/documentation/tle-fmt.php).
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Propagators/SGP4/TLE.hpp>
+
+
+/* Loads catalogs of element sets (e.g., CelesTrak's GP data in TLE or 3LE format), which may hold tens of thousands of objects.
+	The file is memory-mapped and split into element sets without copying it. The fixed-width fields of each element set are then parsed in place (without allocating or copying them into temporary strings), its checksums are validated, and it is initialized for propagation (sgp4init); element sets are parsed and initialized in parallel.
+	Element sets are parsed into the same values as TLE::parseLines.
+*/
+namespace TLECatalog {
+	static constexpr size_t LINE_LENGTH = 69;			// Length of an element set line (the last column being the checksum)
+	static constexpr size_t INIT_TASK_SIZE = 256;		// Element sets per task of the parallel parse and initialization
+
+
+	/* An element set of a catalog. */
+	struct Entry {
+		std::string name;		// Object name (the line preceding the element set in a 3LE catalog), or the catalog number if the catalog has no names
+		TLE tle;				// The element set, initialized for propagation
+	};
+
+
+	/* Statistics of a catalog load. */
+	struct Statistics {
+		size_t elementSets = 0;		// Element sets found in the file
+		size_t rejected = 0;		// Element sets rejected (malformed fields, bad checksums, or failed initialization)
+		double scanTime = 0.0;		// Time spent mapping the file and splitting it into element sets (s)
+		double parseTime = 0.0;		// Time spent parsing and initializing element sets (s)
+	};
+
+
+	/* Verifies the checksum of an element set line: the sum of its digits (with minus signs counting as 1) modulo 10, in its last column.
+		@param line: The line.
+
+		@return True if the checksum is valid, false otherwise (or if the line is too short).
+	*/
+	bool VerifyChecksum(std::string_view line);
+
+
+	/* Parses an element set in place, and initializes it for propagation.
+		@param line1: The first line.
+		@param line2: The second line.
+		@param tle [out]: The element set.
+
+		@return nullptr if successful, or the reason the element set was rejected.
+	*/
+	const char *ParseElementSet(std::string_view line1, std::string_view line2, TLE &tle);
+
+
+	/* Loads a catalog. Rejected element sets are skipped, and reported as a warning.
+		@param filePath: The path to the catalog file (TLE or 3LE format).
+		@param pool: The thread pool sharing the parse and initialization of element sets.
+		@param stats [out] (optional): The statistics of the load.
+
+		@return The element sets, in file order.
+	*/
+	std::vector<Entry> Load(const std::string &filePath, ThreadPool &pool, Statistics *stats = nullptr);
+}
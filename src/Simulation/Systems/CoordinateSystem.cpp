@@ -1,9 +1,13 @@
 #include "CoordinateSystem.hpp"
 
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+
 
 CoordinateSystem::CoordinateSystem() {
 	reset();
 
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
 	// Configure SPICE to return from any functions that failed to execute
 	// (thus allowing us to check the execution status with `failed_c` and handle failures gracefully).
 	erract_c("SET", 0, const_cast<SpiceChar *>("RETURN"));
@@ -20,12 +24,16 @@ CoordinateSystem::~CoordinateSystem() {
 
 
 void CoordinateSystem::reset() {
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
 	kclear_c();
 	SPICEUtils::CheckFailure(true);
 }
 
 
 void CoordinateSystem::init(const std::vector<std::string> &kernelPaths, CoordSys::Frame frame, CoordSys::Epoch epoch, const std::string &epochFormat) {
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
 	// Load kernels
 	for (const auto &path : kernelPaths) {
 		furnsh_c(path.c_str());
@@ -49,10 +57,74 @@ void CoordinateSystem::init(const std::vector<std::string> &kernelPaths, CoordSy
 	m_observerName = CoordSys::FrameProperties.at(frame).spiceName;
 	m_frameName = CoordSys::EpochToSPICEMap.at(epoch);
 	m_epochFormat = epochFormat;
+	m_frameNames.clear();
+
+	m_temeNodeET = std::numeric_limits<double>::quiet_NaN();
+	m_temeMatrixET = std::numeric_limits<double>::quiet_NaN();
+
+	SpiceBoolean isObserverFound = SPICEFALSE;
+	bods2c_c(m_observerName.c_str(), &m_observerID, &isObserverFound);
+	SPICEUtils::CheckFailure(true);
+
+	if (!isObserverFound)
+		throw Log::RuntimeException(__FUNCTION__, __LINE__, "Cannot resolve the NAIF ID of observer " + enquote(m_observerName) + "!");
+}
+
+
+std::optional<SpiceInt> CoordinateSystem::resolveBody(const std::string &targetName) {
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+	SpiceInt targetID = 0;
+	SpiceBoolean isFound = SPICEFALSE;
+
+	// "Body string to ID code"
+	bods2c_c(targetName.c_str(), &targetID, &isFound);
+	SPICEUtils::CheckFailure(false, true);
+
+	if (!isFound) {
+		Log::Print(Log::T_ERROR, __FUNCTION__, "Target body " + enquote(targetName) + " is not available in the SPICE kernels!");
+		return std::nullopt;
+	}
+
+
+	// NOTE: This only checks the segments of the target itself. Its state relative to the observer may chain through other segments (e.g., Moon -> Earth-Moon barycenter -> Solar System barycenter), whose coverage is not checked.
+	if (auto coverage = findCoverage("SPK", targetID)) {
+		static constexpr SpiceInt UTC_LENGTH = 35;
+		char buf[UTC_LENGTH];
+		et2utc_c(coverage->second, "C", 0, UTC_LENGTH, buf);
+		Log::Print(Log::T_DEBUG, __FUNCTION__, "Resolved " + enquote(targetName) + " to NAIF ID " + std::to_string(targetID) + ". Its ephemeris data covers the epoch until " + std::string(buf) + ".");
+	}
+	else
+		Log::Print(Log::T_ERROR, __FUNCTION__, "The loaded SPK kernels have no ephemeris data for " + enquote(targetName) + " (NAIF ID " + std::to_string(targetID) + ") at the simulation epoch!");
+
+	return targetID;
+}
+
+
+std::array<double, 6> CoordinateSystem::getBodyState(SpiceInt targetID, double ephTime) {
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+	std::array<double, 6> state{};
+	double lightTime{};
+
+	/* "S/P Kernel, geometric state"
+		Returns the geometric state (i.e., without aberration corrections) of a target body relative to an observing body, both given by their NAIF IDs.
+	*/
+	spkgeo_c(targetID, ephTime, m_frameName.c_str(), m_observerID, state.data(), &lightTime);
+	SPICEUtils::CheckFailure(false, true);
+
+
+	// Convert state vector from km and km/s to m and m/s respectively
+	for (size_t i = 0; i < state.size(); i++)
+		state[i] *= 1e3;
+
+	return state;
 }
 
 
 std::array<double, 6> CoordinateSystem::getBodyState(const std::string &targetName, double ephTime) {
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
 	if (!SPICEUtils::IsObjectAvailable(targetName)) {
 		Log::Print(Log::T_ERROR, __FUNCTION__, "Target body " + enquote(targetName) + " is not available in the SPICE kernels!");
 		return {};
@@ -78,14 +150,65 @@ std::array<double, 6> CoordinateSystem::getBodyState(const std::string &targetNa
 }
 
 
-glm::mat3 CoordinateSystem::getRotationMatrix(const std::string &targetFrame, double ephTime) {
+glm::dmat3 CoordinateSystem::getRotationMatrix(const std::string &targetFrame, double ephTime) {
 	double rotMat[3][3];
 
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
 	// "Position X-form": Used for transforming position vectors (3 components). "X-form" is an abbreviation for "transformation".
 	pxform_c(m_frameName.c_str(), targetFrame.c_str(), ephTime, rotMat);
 	SPICEUtils::CheckFailure(false, true);
 
-	return glm::mat3(
+	return glm::dmat3(
+		rotMat[0][0], rotMat[0][1], rotMat[0][2],
+		rotMat[1][0], rotMat[1][1], rotMat[1][2],
+		rotMat[2][0], rotMat[2][1], rotMat[2][2]
+	);
+}
+
+
+std::optional<SpiceInt> CoordinateSystem::resolveFrame(const std::string &frameName) {
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+	SpiceInt frameID = 0;
+
+	// "Name to frame"
+	namfrm_c(frameName.c_str(), &frameID);
+	SPICEUtils::CheckFailure(false, true);
+
+	if (frameID == 0) {
+		Log::Print(Log::T_ERROR, __FUNCTION__, "Frame " + enquote(frameName) + " is not available in the SPICE kernels!");
+		return std::nullopt;
+	}
+
+
+	// "Frame information": Frames of class PCK (2) are defined by a binary PCK kernel or, failing that, by the text PCK constants of their body
+	static constexpr SpiceInt PCK_FRAME_CLASS = 2;
+
+	SpiceInt center, frameClass, classID;
+	SpiceBoolean isFound = SPICEFALSE;
+	frinfo_c(frameID, &center, &frameClass, &classID, &isFound);
+	SPICEUtils::CheckFailure(false, true);
+
+	if (isFound && frameClass == PCK_FRAME_CLASS && !findCoverage("PCK", classID) && !bodfnd_c(classID, "PM"))
+		Log::Print(Log::T_ERROR, __FUNCTION__, "The loaded PCK kernels do not define the orientation of frame " + enquote(frameName) + " at the simulation epoch!");
+
+	m_frameNames[frameID] = frameName;
+
+	return frameID;
+}
+
+
+glm::dmat3 CoordinateSystem::getRotationMatrix(SpiceInt frameID, double ephTime) {
+	double rotMat[3][3];
+
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+	// SPICE only transforms between frames by name; the name is that of the resolved frame, so that no string is built here
+	pxform_c(m_frameName.c_str(), m_frameNames.at(frameID).c_str(), ephTime, rotMat);
+	SPICEUtils::CheckFailure(false, true);
+
+	return glm::dmat3(
 		rotMat[0][0], rotMat[0][1], rotMat[0][2],
 		rotMat[1][0], rotMat[1][1], rotMat[1][2],
 		rotMat[2][0], rotMat[2][1], rotMat[2][2]
@@ -93,20 +216,98 @@ glm::mat3 CoordinateSystem::getRotationMatrix(const std::string &targetFrame, do
 }
 
 
+std::optional<std::pair<double, double>> CoordinateSystem::findCoverage(const std::string &kernelType, SpiceInt objectID) {
+	static constexpr SpiceInt MAX_INTERVALS = 10000;
+	static constexpr SpiceInt FILE_LENGTH = 512;
+	static constexpr SpiceInt TYPE_LENGTH = 33;
+
+	std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+	SPICEDOUBLE_CELL(coverage, 2 * MAX_INTERVALS);
+	scard_c(0, &coverage);
+
+	// The coverage windows of every loaded kernel of the given type are merged
+	SpiceInt kernelCount = 0;
+	ktotal_c(kernelType.c_str(), &kernelCount);
+
+	for (SpiceInt i = 0; i < kernelCount; i++) {
+		SpiceChar file[FILE_LENGTH], fileType[TYPE_LENGTH], source[FILE_LENGTH];
+		SpiceInt handle;
+		SpiceBoolean isFound = SPICEFALSE;
+
+		kdata_c(i, kernelType.c_str(), FILE_LENGTH, TYPE_LENGTH, FILE_LENGTH, file, fileType, source, &handle, &isFound);
+		if (!isFound)
+			continue;
+
+		if (kernelType == "SPK")
+			spkcov_c(file, objectID, &coverage);
+		else
+			pckcov_c(file, objectID, &coverage);
+	}
+	SPICEUtils::CheckFailure(false, true);
+
+
+	for (SpiceInt i = 0; i < wncard_c(&coverage); i++) {
+		double start, end;
+		wnfetd_c(&coverage, i, &start, &end);
+
+		if (m_epochET >= start && m_epochET <= end)
+			return std::pair<double, double>{ start, end };
+	}
+
+	return std::nullopt;
+}
+
+
 std::array<double, 6> CoordinateSystem::TEMEToThisFrame(const std::array<double, 6> &stateVector, double ephTime) {
-	// Convert ET -> ...
-	double jdTT = unitim_c(ephTime, "ET", "JDTDT");		// ...JDTDT (Julian Date, Terrestrial Time (DT))
-	double jdTDB = unitim_c(ephTime, "ET", "JDTDB");	// ...JDTDB (Juian Date, UTC)
+	const glm::dmat3 &transformationMatrix = getTEMERotationMatrix(ephTime);
 
+	glm::dvec3 position(stateVector[0], stateVector[1], stateVector[2]);
+	position = transformationMatrix * position;
+
+	glm::dvec3 velocity(stateVector[3], stateVector[4], stateVector[5]);
+	velocity = transformationMatrix * velocity;
+
+
+	return std::array<double, 6>{
+		position.x, position.y, position.z,
+		velocity.x, velocity.y, velocity.z
+	};
+}
+
+
+const glm::dmat3 &CoordinateSystem::getTEMERotationMatrix(double ephTime) {
+	if (ephTime == m_temeMatrixET)
+		return m_temeMatrix;
+
+
+	// Evaluate the nodes that bracket the epoch (the second node becomes the first one as time moves forward)
+	const double nodeET = std::floor(ephTime / TEME_NODE_SPACING) * TEME_NODE_SPACING;
+
+	if (nodeET != m_temeNodeET) {
+		if (nodeET == m_temeNodeET + TEME_NODE_SPACING)
+			m_temeNodes[0] = m_temeNodes[1];
+		else
+			m_temeNodes[0] = ComputeTEMEAngles(nodeET);
+
+		m_temeNodes[1] = ComputeTEMEAngles(nodeET + TEME_NODE_SPACING);
+		m_temeNodeET = nodeET;
+	}
+
+	const double s = (ephTime - nodeET) / TEME_NODE_SPACING;
+	const _TEMEAngles &a = m_temeNodes[0];
+	const _TEMEAngles &b = m_temeNodes[1];
+
+	const glm::dvec3 precession = a.precession + s * (b.precession - a.precession);
+	const double deltaPsi = a.deltaPsi + s * (b.deltaPsi - a.deltaPsi);
+	const double deltaEpsilon = a.deltaEpsilon + s * (b.deltaEpsilon - a.deltaEpsilon);
+	const double meanEpsilon = a.meanEpsilon + s * (b.meanEpsilon - a.meanEpsilon);
 
-	// Calculate Earth orientation parameters & prepare nutation parameters
-	glm::dvec3 precession = Body::Earth.getPrecessionAngles(jdTT);
-	PhysicsComponent::NutationAngles nutation = Body::Earth.getNutationAngles(jdTT, jdTDB);
 
 	auto [pZeta, pTheta, pZed] = std::tuple<double, double, double>(precession.x, precession.y, precession.z);	// Convert (x, y, z) to (ζ, θ, z)
 
-	double epsilon = nutation.meanEpsilon + nutation.deltaEpsilon;			// True obliquity of ecliptic
-	double dPsiCosEps = nutation.deltaPsi * glm::cos(epsilon);				// Nutation in longitude * cos(obliquity)
+	double epsilon = meanEpsilon + deltaEpsilon;			// True obliquity of ecliptic
+	double dPsiCosEps = deltaPsi * glm::cos(epsilon);		// Nutation in longitude * cos(obliquity)
 
 
 	// Nutation correction (TEME -> MOD - Mean of Date)
@@ -117,8 +318,8 @@ std::array<double, 6> CoordinateSystem::TEMEToThisFrame(const std::array<double,
 	glm::dmat4 nutationMatrix(1.0);
 	nutationMatrix = glm::rotate(nutationMatrix, -dPsiCosEps, axisZ);				// Remove equation of equinoxes
 	nutationMatrix = glm::rotate(nutationMatrix, epsilon, axisX);					// Rotate by true obliquity
-	nutationMatrix = glm::rotate(nutationMatrix, nutation.deltaPsi, axisZ);			// Apply nutation in longitude
-	nutationMatrix = glm::rotate(nutationMatrix, -nutation.meanEpsilon, axisX);		// Remove mean obliquity
+	nutationMatrix = glm::rotate(nutationMatrix, deltaPsi, axisZ);					// Apply nutation in longitude
+	nutationMatrix = glm::rotate(nutationMatrix, -meanEpsilon, axisX);				// Remove mean obliquity
 
 
 	// Precession correction (MOD -> J2000)
@@ -129,17 +330,50 @@ std::array<double, 6> CoordinateSystem::TEMEToThisFrame(const std::array<double,
 
 
 	// Final transformation matrix from TEME to J2000 is a combination of nutation and precession.
-	glm::dmat3 transformationMatrix = precessionMatrix * nutationMatrix;
+	m_temeMatrix = glm::dmat3(precessionMatrix * nutationMatrix);
+	m_temeMatrixET = ephTime;
 
-	glm::dvec3 position(stateVector[0], stateVector[1], stateVector[2]);
-	position = transformationMatrix * position;
+	return m_temeMatrix;
+}
 
-	glm::dvec3 velocity(stateVector[3], stateVector[4], stateVector[5]);
-	velocity = transformationMatrix * velocity;
 
+double CoordinateSystem::GetGreenwichMeanSiderealTime(double ephTime) {
+	return gstime(SPICEUtils::etToUTCJulianDate(ephTime));
+}
 
-	return std::array<double, 6>{
-		position.x, position.y, position.z,
-		velocity.x, velocity.y, velocity.z
+
+glm::dmat3 CoordinateSystem::GetTEMEToECEFRotationMatrix(double ephTime) {
+	const double gmst = GetGreenwichMeanSiderealTime(ephTime);
+	const double cosGMST = std::cos(gmst);
+	const double sinGMST = std::sin(gmst);
+
+	// Rotation about the Z-axis by -GMST (column-major)
+	return glm::dmat3(
+		cosGMST, -sinGMST, 0.0,
+		sinGMST, cosGMST, 0.0,
+		0.0, 0.0, 1.0
+	);
+}
+
+
+CoordinateSystem::_TEMEAngles CoordinateSystem::ComputeTEMEAngles(double ephTime) {
+	// Convert ET -> ...
+	double jdTT, jdTDB;
+	{
+		std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+		jdTT = unitim_c(ephTime, "ET", "JDTDT");		// ...JDTDT (Julian Date, Terrestrial Time (DT))
+		jdTDB = unitim_c(ephTime, "ET", "JDTDB");		// ...JDTDB (Juian Date, UTC)
+	}
+
+
+	// Calculate Earth orientation parameters & prepare nutation parameters
+	const PhysicsComponent::NutationAngles nutation = Body::Earth.getNutationAngles(jdTT, jdTDB);
+
+	return _TEMEAngles{
+		.precession = Body::Earth.getPrecessionAngles(jdTT),
+		.deltaPsi = nutation.deltaPsi,
+		.deltaEpsilon = nutation.deltaEpsilon,
+		.meanEpsilon = nutation.meanEpsilon
 	};
 }
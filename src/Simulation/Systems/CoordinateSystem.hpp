@@ -4,7 +4,12 @@
 #pragma once
 
 #include <array>
+#include <cmath>
+#include <limits>
 #include <vector>
+#include <utility>
+#include <optional>
+#include <unordered_map>
 
 
 #include <Core/Utils/SPICEUtils.hpp>
@@ -46,6 +51,25 @@ public:
 	std::array<double, 6> getBodyState(const std::string &targetName, double ephTime);
 
 
+	/* Resolves the name of a body to its NAIF ID, and checks that the loaded SPK kernels cover the epoch for it.
+		Queries by NAIF ID need no name lookups, so names should be resolved once (e.g., at scene load) rather than on every query.
+
+		@param targetName: The name of the target body (e.g., "EARTH").
+
+		@return The NAIF ID of the body, or std::nullopt if the name is unknown (in which case an error is logged).
+	*/
+	std::optional<SpiceInt> resolveBody(const std::string &targetName);
+
+
+	/* Gets the state vector (position and velocity) of a body relative to this system's origin.
+		@param targetID: The NAIF ID of the target body (see CoordinateSystem::resolveBody).
+		@param ephTime: The ephemeris time at which to get the state vector.
+
+		@return The state vector [x, y, z, vx, vy, vz], in meters.
+	*/
+	std::array<double, 6> getBodyState(SpiceInt targetID, double ephTime);
+
+
 	/* Gets the rotation matrix of this system at a given ephemeris time.
 		The rotation matrix is used to transform vectors from this system to another frame.
 
@@ -57,7 +81,24 @@ public:
 		
 		@return A 3x3 rotation matrix.
 	*/
-	glm::mat3 getRotationMatrix(const std::string &targetFrame, double ephTime);
+	glm::dmat3 getRotationMatrix(const std::string &targetFrame, double ephTime);
+
+
+	/* Resolves the name of a frame to its frame ID, and checks that the loaded kernels define its orientation at the epoch.
+		@param frameName: The name of the frame (e.g., "IAU_EARTH").
+
+		@return The frame ID, or std::nullopt if the name is unknown (in which case an error is logged).
+	*/
+	std::optional<SpiceInt> resolveFrame(const std::string &frameName);
+
+
+	/* Gets the rotation matrix from this system to another frame at a given ephemeris time (see the name-based overload).
+		@param frameID: The ID of the target frame (see CoordinateSystem::resolveFrame).
+		@param ephTime: The ephemeris time at which to get the rotation matrix.
+
+		@return A 3x3 rotation matrix.
+	*/
+	glm::dmat3 getRotationMatrix(SpiceInt frameID, double ephTime);
 
 
 	/* Transforms a vector from the TEME coordinate system to this system's frame at a given ephemeris time.
@@ -69,18 +110,83 @@ public:
 	std::array<double, 6> TEMEToThisFrame(const std::array<double, 6> &stateVector, double ephTime);
 
 
+	/* Gets the rotation matrix from the TEME coordinate system to this system's frame at a given ephemeris time.
+		The matrix is cached per epoch, so that every vector transformed at the same epoch shares it. The precession and nutation angles it is built from vary slowly (the shortest nutation period is about 5 days): they are evaluated in full only at nodes TEME_NODE_SPACING apart, and linearly interpolated in between.
+		NOTE: The cache is not thread-safe; this should be called from a single thread (the physics thread).
+
+		@param ephTime: The ephemeris time (ET).
+
+		@return The rotation matrix.
+	*/
+	const glm::dmat3 &getTEMERotationMatrix(double ephTime);
+
+
+	/* Gets the Greenwich mean sidereal time (IAU-1982, as used by SGP4) at a given ephemeris time. UT1 is approximated by UTC (|UT1 - UTC| < 0.9 s).
+		@param ephTime: The ephemeris time (ET).
+
+		@return The Greenwich mean sidereal time, in [0, 2pi) radians.
+	*/
+	static double GetGreenwichMeanSiderealTime(double ephTime);
+
+
+	/* Gets the rotation matrix from the TEME coordinate system to the Earth-fixed frame (ECEF) at a given ephemeris time: a rotation about the TEME pole by the Greenwich mean sidereal time. Polar motion (under 15 m at the surface) is neglected.
+		Unlike CoordinateSystem::getTEMERotationMatrix, this is stateless, and may be called from any thread.
+
+		@param ephTime: The ephemeris time (ET).
+
+		@return The rotation matrix.
+	*/
+	static glm::dmat3 GetTEMEToECEFRotationMatrix(double ephTime);
+
+
+	static constexpr double EARTH_ROTATION_RATE = 7.292115146706979e-5;		// Rotation rate of the Earth-fixed frame relative to TEME (rad/s)
+
+
 	/* Gets the epoch in Ephemeris Time. */
 	inline double getEpochET() const { return m_epochET; };
 
 	/* Gets the epoch in Julian Ephemeris Date. */
 	inline double getEpochJED() const {
+		std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
 		return unitim_c(m_epochET, "ET", "JED");	// ET -> JED (Ephemeris Time -> Julian Ephemeris Date)
 	}
 
 private:
 	std::string m_observerName{};
 	std::string m_frameName{};
+	SpiceInt m_observerID = 0;		// NAIF ID of the observer
+
+	std::unordered_map<SpiceInt, std::string> m_frameNames;		// Names of resolved frames, by frame ID (guarded by the SPICE mutex)
 
 	std::string m_epochFormat{};
 	double m_epochET = 0;	// Epoch in Ephemeris Time (ET)
+
+
+	/* Finds the interval of the loaded kernels' coverage of an object that contains the epoch.
+		@param kernelType: The type of kernels ("SPK" for bodies, "PCK" for binary PCK frames).
+		@param objectID: The NAIF ID of the body (SPK), or the frame class ID (PCK).
+
+		@return The coverage interval [start, end] in Ephemeris Time, or std::nullopt if no loaded kernel covers the epoch.
+	*/
+	std::optional<std::pair<double, double>> findCoverage(const std::string &kernelType, SpiceInt objectID);
+
+
+	// TEME -> this frame rotation cache
+	static constexpr double TEME_NODE_SPACING = 3600.0;		// Spacing of the epochs at which precession and nutation are evaluated in full (s). Linear interpolation over an hour errs by ~1e-10 rad.
+
+	struct _TEMEAngles {
+		glm::dvec3 precession;		// Precession angles (zeta, theta, z)
+		double deltaPsi;			// Nutation in longitude
+		double deltaEpsilon;		// Nutation in obliquity
+		double meanEpsilon;			// Mean obliquity of the ecliptic
+	};
+
+	double m_temeNodeET = std::numeric_limits<double>::quiet_NaN();			// Epoch of the first of the two bracketing nodes
+	std::array<_TEMEAngles, 2> m_temeNodes{};
+	double m_temeMatrixET = std::numeric_limits<double>::quiet_NaN();		// Epoch of the cached matrix
+	glm::dmat3 m_temeMatrix{ 1.0 };
+
+
+	/* Evaluates the precession angles and the full IAU-1980 nutation series at a given ephemeris time. */
+	static _TEMEAngles ComputeTEMEAngles(double ephTime);
 };
\ No newline at end of file
@@ -0,0 +1,382 @@
+/* EphemerisCache.cpp - Ephemeris cache implementation.
+*/
+
+#include "EphemerisCache.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+
+void EphemerisCache::init(std::shared_ptr<CoordinateSystem> coordSystem, bool enabled, double positionTolerance, double rotationTolerance, bool validate) {
+	shutdown();
+
+	m_coordSystem = coordSystem;
+	m_enabled = enabled;
+	m_positionTolerance = positionTolerance;
+	m_rotationTolerance = rotationTolerance;
+	m_validate = validate;
+
+	if (!m_enabled)
+		return;
+
+	m_stopping = false;
+
+	m_prefetchThread = ThreadManager::CreateThread("EPHEMERIS_PREFETCH");
+	m_prefetchThread->set([this](std::stop_token stopToken) {
+		prefetchLoop(stopToken);
+	});
+	m_prefetchThread->start();
+}
+
+
+void EphemerisCache::shutdown() {
+	if (m_prefetchThread) {
+		{
+			std::lock_guard<std::mutex> lock(m_prefetchMutex);
+			m_stopping = true;
+			m_prefetchQueue.clear();
+		}
+
+		m_prefetchThread->requestStop();
+		m_prefetchThread->waitForStop(&m_prefetchCV);
+		m_prefetchThread.reset();
+	}
+
+	m_channels.clear();
+	m_bodyHandles.clear();
+	m_frameHandles.clear();
+	m_stats = Statistics{};
+}
+
+
+uint32_t EphemerisCache::addBody(const std::string &spiceID) {
+	auto it = m_bodyHandles.find(spiceID);
+	if (it != m_bodyHandles.end())
+		return it->second;
+
+	const uint32_t handle = addChannel(_ChannelType::STATE, spiceID, m_bodyHandles);
+
+	const std::optional<SpiceInt> bodyID = m_coordSystem->resolveBody(spiceID);
+	m_channels[handle]->id = bodyID.value_or(0);
+	m_channels[handle]->isAvailable = bodyID.has_value();
+
+	return handle;
+}
+
+
+uint32_t EphemerisCache::addFrame(const std::string &frameName) {
+	auto it = m_frameHandles.find(frameName);
+	if (it != m_frameHandles.end())
+		return it->second;
+
+	const uint32_t handle = addChannel(_ChannelType::ROTATION, frameName, m_frameHandles);
+
+	const std::optional<SpiceInt> frameID = m_coordSystem->resolveFrame(frameName);
+	m_channels[handle]->id = frameID.value_or(0);
+	m_channels[handle]->isAvailable = frameID.has_value();
+
+	return handle;
+}
+
+
+uint32_t EphemerisCache::addChannel(_ChannelType type, const std::string &name, std::unordered_map<std::string, uint32_t> &handles) {
+	const uint32_t handle = static_cast<uint32_t>(m_channels.size());
+
+	std::unique_ptr<_Channel> channel = std::make_unique<_Channel>();
+	channel->type = type;
+	channel->name = name;
+
+	m_channels.push_back(std::move(channel));
+	handles[name] = handle;
+
+	return handle;
+}
+
+
+std::array<double, 6> EphemerisCache::getBodyState(uint32_t handle, double et) {
+	_Channel &channel = *m_channels[handle];
+
+	if (!channel.isAvailable)
+		return {};
+
+	if (!m_enabled)
+		return m_coordSystem->getBodyState(channel.id, et);
+
+	if (!channel.current.contains(et))
+		advance(channel, et);
+
+	std::array<double, MAX_COMPONENTS> values;
+	Evaluate(channel.current, 6, et, values);
+	m_stats.queries++;
+
+	const std::array<double, 6> state = {
+		values[0], values[1], values[2],
+		values[3], values[4], values[5]
+	};
+
+
+	if (m_validate) {
+		const std::array<double, 6> reference = m_coordSystem->getBodyState(channel.id, et);
+
+		const double positionError = glm::length(glm::dvec3(state[0] - reference[0], state[1] - reference[1], state[2] - reference[2]));
+		const double velocityError = glm::length(glm::dvec3(state[3] - reference[3], state[4] - reference[4], state[5] - reference[5]));
+
+		m_stats.maxPositionError = std::max(m_stats.maxPositionError, positionError);
+		m_stats.maxVelocityError = std::max(m_stats.maxVelocityError, velocityError);
+		m_stats.validations++;
+	}
+
+	return state;
+}
+
+
+glm::dmat3 EphemerisCache::getRotationMatrix(uint32_t handle, double et) {
+	_Channel &channel = *m_channels[handle];
+
+	if (!channel.isAvailable)
+		return glm::dmat3(1.0);
+
+	if (!m_enabled)
+		return m_coordSystem->getRotationMatrix(channel.id, et);
+
+	if (!channel.current.contains(et))
+		advance(channel, et);
+
+	std::array<double, MAX_COMPONENTS> values;
+	Evaluate(channel.current, 9, et, values);
+	m_stats.queries++;
+
+	glm::dmat3 rotMatrix;
+	for (int col = 0; col < 3; col++)
+		for (int row = 0; row < 3; row++)
+			rotMatrix[col][row] = values[3 * col + row];
+
+
+	if (m_validate) {
+		const glm::dmat3 reference = m_coordSystem->getRotationMatrix(channel.id, et);
+
+		double rotationError = 0.0;
+		for (int col = 0; col < 3; col++)
+			for (int row = 0; row < 3; row++)
+				rotationError = std::max(rotationError, std::abs(rotMatrix[col][row] - reference[col][row]));
+
+		m_stats.maxRotationError = std::max(m_stats.maxRotationError, rotationError);
+		m_stats.validations++;
+	}
+
+	return rotMatrix;
+}
+
+
+EphemerisCache::Statistics EphemerisCache::getStatistics() {
+	std::lock_guard<std::mutex> lock(m_prefetchMutex);
+	return m_stats;
+}
+
+
+void EphemerisCache::advance(_Channel &channel, double et) {
+	do {
+		const bool hasSegment = (channel.current.end >= channel.current.start);
+		const int direction = (hasSegment && et < channel.current.start) ? -1 : 1;
+
+		// Segments extend the current one while time moves continuously; a jump starts a new segment at the queried epoch
+		double anchor = et;
+		if (hasSegment) {
+			const double boundary = (direction > 0) ? channel.current.end : channel.current.start;
+			if (std::abs(et - boundary) <= channel.segmentLength)
+				anchor = boundary;
+		}
+
+
+		// Take the prefetched segment if it is the one needed.
+		// A prefetch that has not started yet is cancelled and fitted here instead (which yields the same segment, so results do not depend on thread timing).
+		bool isPrefetched = false;
+		{
+			std::unique_lock<std::mutex> lock(m_prefetchMutex);
+
+			auto it = std::find_if(m_prefetchQueue.begin(), m_prefetchQueue.end(), [&channel](const _PrefetchJob &job) {
+				return job.channel == &channel;
+			});
+			if (it != m_prefetchQueue.end()) {
+				m_prefetchQueue.erase(it);
+				channel.isPrefetchPending = false;
+			}
+
+			m_prefetchDoneCV.wait(lock, [&channel] { return !channel.isPrefetchPending; });
+
+			const _Segment &prefetched = channel.prefetched;
+			const bool isAdjacent = (direction > 0) ? (prefetched.start == anchor) : (prefetched.end == anchor);
+
+			if (prefetched.end >= prefetched.start && isAdjacent) {
+				channel.current = prefetched;
+				isPrefetched = true;
+				m_stats.prefetchHits++;
+			}
+			else
+				m_stats.prefetchMisses++;
+
+			channel.prefetched = _Segment{};
+		}
+
+		if (!isPrefetched) {
+			uint32_t attempts = 0;
+			channel.current = fitSegment(channel, anchor, direction, channel.segmentLength, attempts);
+
+			std::lock_guard<std::mutex> lock(m_prefetchMutex);
+			m_stats.fits += attempts;
+			m_stats.refits += attempts - 1;
+			m_stats.spiceCalls += static_cast<uint64_t>(attempts) * NODE_COUNT;
+		}
+
+		channel.segmentLength = channel.current.nextLength;
+		channel.direction = direction;
+
+	} while (!channel.current.contains(et));
+
+
+	// Prefetch the adjacent segment
+	{
+		std::lock_guard<std::mutex> lock(m_prefetchMutex);
+
+		m_prefetchQueue.push_back(_PrefetchJob{
+			.channel = &channel,
+			.anchor = (channel.direction > 0) ? channel.current.end : channel.current.start,
+			.direction = channel.direction,
+			.length = channel.segmentLength
+		});
+		channel.isPrefetchPending = true;
+	}
+	m_prefetchCV.notify_one();
+}
+
+
+EphemerisCache::_Segment EphemerisCache::fitSegment(const _Channel &channel, double anchor, int direction, double length, uint32_t &attempts) const {
+	const uint32_t componentCount = GetComponentCount(channel.type);
+
+	// cos(pi * j * (k + 1/2) / N): the values of T_j at the Chebyshev nodes
+	std::array<std::array<double, NODE_COUNT>, NODE_COUNT> basis;
+	for (uint32_t j = 0; j < NODE_COUNT; j++)
+		for (uint32_t k = 0; k < NODE_COUNT; k++)
+			basis[j][k] = std::cos(PI * j * (k + 0.5) / NODE_COUNT);
+
+	std::array<std::array<double, MAX_COMPONENTS>, NODE_COUNT> samples;
+	attempts = 0;
+
+	while (true) {
+		attempts++;
+
+		_Segment segment{};
+		segment.start = (direction > 0) ? anchor : (anchor - length);
+		segment.end = (direction > 0) ? (anchor + length) : anchor;
+		segment.midpoint = 0.5 * (segment.start + segment.end);
+		segment.inverseHalfLength = 2.0 / length;
+
+		// Sample at the Chebyshev nodes (x_k = cos(pi * (k + 1/2) / N))
+		for (uint32_t k = 0; k < NODE_COUNT; k++)
+			sample(channel, segment.midpoint + 0.5 * length * basis[1][k], samples[k]);
+
+		// Interpolating coefficients (discrete cosine transform of the samples)
+		for (uint32_t c = 0; c < componentCount; c++) {
+			for (uint32_t j = 0; j < NODE_COUNT; j++) {
+				double sum = 0.0;
+				for (uint32_t k = 0; k < NODE_COUNT; k++)
+					sum += samples[k][c] * basis[j][k];
+
+				segment.coefficients[c][j] = ((j == 0) ? 1.0 : 2.0) * sum / NODE_COUNT;
+			}
+		}
+
+
+		// The truncation error is estimated from the two trailing coefficients (which, for smooth functions, bound the rest of the discarded series)
+		auto trailingMagnitude = [&segment](uint32_t c) {
+			return std::abs(segment.coefficients[c][NODE_COUNT - 1]) + std::abs(segment.coefficients[c][NODE_COUNT - 2]);
+		};
+
+		double errorRatio = 0.0;
+		if (channel.type == _ChannelType::STATE) {
+			const glm::dvec3 positionError(trailingMagnitude(0), trailingMagnitude(1), trailingMagnitude(2));
+			const glm::dvec3 velocityError(trailingMagnitude(3), trailingMagnitude(4), trailingMagnitude(5));
+
+			// Velocity errors are held to the position tolerance accumulated over half a segment
+			errorRatio = std::max(glm::length(positionError), glm::length(velocityError) * 0.5 * length) / m_positionTolerance;
+		}
+		else {
+			for (uint32_t c = 0; c < componentCount; c++)
+				errorRatio = std::max(errorRatio, trailingMagnitude(c) / m_rotationTolerance);
+		}
+
+
+		if (errorRatio <= 1.0 || length <= MIN_SEGMENT_LENGTH) {
+			segment.nextLength = (errorRatio < GROWTH_THRESHOLD) ? std::min(2.0 * length, MAX_SEGMENT_LENGTH) : length;
+			return segment;
+		}
+
+		length = std::max(0.5 * length, MIN_SEGMENT_LENGTH);
+	}
+}
+
+
+void EphemerisCache::sample(const _Channel &channel, double et, std::array<double, MAX_COMPONENTS> &values) const {
+	if (channel.type == _ChannelType::STATE) {
+		const std::array<double, 6> state = m_coordSystem->getBodyState(channel.id, et);
+		std::copy(state.begin(), state.end(), values.begin());
+	}
+	else {
+		const glm::dmat3 rotMatrix = m_coordSystem->getRotationMatrix(channel.id, et);
+		for (int col = 0; col < 3; col++)
+			for (int row = 0; row < 3; row++)
+				values[3 * col + row] = rotMatrix[col][row];
+	}
+}
+
+
+void EphemerisCache::Evaluate(const _Segment &segment, uint32_t componentCount, double et, std::array<double, MAX_COMPONENTS> &values) {
+	const double x = (et - segment.midpoint) * segment.inverseHalfLength;
+
+	// Chebyshev polynomials at x, shared by every component
+	std::array<double, NODE_COUNT> T;
+	T[0] = 1.0;
+	T[1] = x;
+	for (uint32_t j = 2; j < NODE_COUNT; j++)
+		T[j] = 2.0 * x * T[j - 1] - T[j - 2];
+
+	for (uint32_t c = 0; c < componentCount; c++) {
+		double value = 0.0;
+		for (uint32_t j = 0; j < NODE_COUNT; j++)
+			value += segment.coefficients[c][j] * T[j];
+
+		values[c] = value;
+	}
+}
+
+
+void EphemerisCache::prefetchLoop(std::stop_token stopToken) {
+	while (true) {
+		_PrefetchJob job;
+		{
+			std::unique_lock<std::mutex> lock(m_prefetchMutex);
+			m_prefetchCV.wait(lock, stopToken, [this] { return m_stopping || !m_prefetchQueue.empty(); });
+
+			if (m_stopping || stopToken.stop_requested())
+				return;
+
+			job = m_prefetchQueue.front();
+			m_prefetchQueue.pop_front();
+		}
+
+		uint32_t attempts = 0;
+		const _Segment segment = fitSegment(*job.channel, job.anchor, job.direction, job.length, attempts);
+
+		{
+			std::lock_guard<std::mutex> lock(m_prefetchMutex);
+
+			job.channel->prefetched = segment;
+			job.channel->isPrefetchPending = false;
+
+			m_stats.fits += attempts;
+			m_stats.refits += attempts - 1;
+			m_stats.spiceCalls += static_cast<uint64_t>(attempts) * NODE_COUNT;
+		}
+		m_prefetchDoneCV.notify_all();
+	}
+}
@@ -0,0 +1,251 @@
+/* EphemerisCache.hpp - Interpolated cache of SPICE body states and frame orientations.
+	Sources:
+		- J. P. Boyd, "Chebyshev and Fourier Spectral Methods", 2nd ed., Dover, 2001 (Sections 2.12 and 4.4).
+		- NAIF, "SPK Required Reading" (Types 2 and 3: Chebyshev position and velocity segments).
+*/
+
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <condition_variable>
+
+
+#include <Core/Data/Math.hpp>
+#include <Core/Utils/SPICEUtils.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/WorkerThread.hpp>
+#include <Core/Application/Threading/ThreadManager.hpp>
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Data/Solvers.hpp>
+#include <Simulation/Systems/CoordinateSystem.hpp>
+
+
+/* Answers body state and frame orientation queries from Chebyshev series fitted to SPICE, instead of querying SPICE every time.
+	Each queried quantity (a body's state, or the rotation matrix to a frame) is a channel. A channel holds one segment: a time window over which every component is a Chebyshev series, fitted by interpolation at the window's Chebyshev nodes (as in SPK types 2 and 3; velocities have their own series rather than being differentiated from the positions).
+	The window length adapts to the fit tolerance: a fit whose truncation error (estimated from its trailing coefficients) exceeds the tolerance is discarded and refitted over half the window, and the next window is twice as long if the fit was far more accurate than needed.
+	Once a segment is in use, the adjacent segment (in the direction time is moving) is fitted by a background thread, so that queries rarely wait for SPICE.
+*/
+class EphemerisCache {
+public:
+	static constexpr uint32_t NO_HANDLE = std::numeric_limits<uint32_t>::max();
+
+
+	/* Usage statistics. */
+	struct Statistics {
+		uint64_t queries = 0;					// Queries answered
+		uint64_t fits = 0;						// Segments fitted (including refits)
+		uint64_t refits = 0;					// Fits discarded for exceeding the tolerance
+		uint64_t spiceCalls = 0;				// SPICE calls made to fit segments
+		uint64_t prefetchHits = 0;				// Segment changes served by a prefetched segment
+		uint64_t prefetchMisses = 0;			// Segment changes that had to be fitted on demand
+
+		uint64_t validations = 0;				// Queries checked against SPICE (validation mode only)
+		double maxPositionError = 0.0;			// Max position error (m)
+		double maxVelocityError = 0.0;			// Max velocity error (m/s)
+		double maxRotationError = 0.0;			// Max rotation matrix element error (rad)
+	};
+
+
+	EphemerisCache() = default;
+	~EphemerisCache() { shutdown(); }
+
+	EphemerisCache(const EphemerisCache &) = delete;
+	EphemerisCache &operator=(const EphemerisCache &) = delete;
+
+
+	/* (Re)initializes the cache. Every channel is discarded.
+		@param coordSystem: The coordinate system whose queries are cached.
+		@param enabled: Whether queries are interpolated. If false, every query is forwarded to SPICE.
+		@param positionTolerance: The fit tolerance of positions (m). Velocities are fitted to the same tolerance over the length of a segment.
+		@param rotationTolerance: The fit tolerance of rotation matrix elements (rad).
+		@param validate: Whether every query is also made directly to SPICE, and the interpolation error recorded (see EphemerisCache::getStatistics).
+	*/
+	void init(std::shared_ptr<CoordinateSystem> coordSystem, bool enabled, double positionTolerance, double rotationTolerance, bool validate);
+
+
+	/* Stops the prefetch thread and discards every channel. */
+	void shutdown();
+
+
+	/* Gets the handle of a body's state channel, which is created (and its body resolved to a NAIF ID) if needed.
+		@param spiceID: The SPICE ID of the body.
+
+		@return The handle.
+	*/
+	uint32_t addBody(const std::string &spiceID);
+
+
+	/* Gets the handle of a frame's orientation channel, which is created (and its frame resolved to a frame ID) if needed.
+		@param frameName: The name of the SPICE frame (e.g., "IAU_EARTH").
+
+		@return The handle.
+	*/
+	uint32_t addFrame(const std::string &frameName);
+
+
+	/* Gets the state of a body (see CoordinateSystem::getBodyState).
+		@param handle: The handle of the body's state channel.
+		@param et: The epoch in Ephemeris Time.
+
+		@return The state vector [x, y, z, vx, vy, vz] (m, m/s), or zero if the body could not be resolved.
+	*/
+	std::array<double, 6> getBodyState(uint32_t handle, double et);
+
+
+	/* Gets the rotation matrix to a frame (see CoordinateSystem::getRotationMatrix).
+		NOTE: Interpolated matrices are orthonormal only to within the rotation tolerance.
+
+		@param handle: The handle of the frame's orientation channel.
+		@param et: The epoch in Ephemeris Time.
+
+		@return The rotation matrix, or the identity matrix if the frame could not be resolved.
+	*/
+	glm::dmat3 getRotationMatrix(uint32_t handle, double et);
+
+
+	/* Gets the usage statistics. */
+	Statistics getStatistics();
+
+
+	inline bool isEnabled() const { return m_enabled; }
+	inline bool isValidating() const { return m_validate; }
+
+	inline double getPositionTolerance() const { return m_positionTolerance; }
+	inline double getRotationTolerance() const { return m_rotationTolerance; }
+
+
+	static constexpr uint32_t NODE_COUNT = 10;							// Chebyshev nodes (i.e., coefficients) per series
+	static constexpr double INITIAL_SEGMENT_LENGTH = 3600.0;			// Length of the first segment of a channel (s)
+	static constexpr double MIN_SEGMENT_LENGTH = 1.0;					// Minimum segment length (s); fits at this length are accepted regardless of their error
+	static constexpr double MAX_SEGMENT_LENGTH = 16.0 * 86400.0;		// Maximum segment length (s)
+	static constexpr double GROWTH_THRESHOLD = 1e-3;					// Ratio of the estimated error to the tolerance below which the next segment is twice as long
+
+private:
+	static constexpr uint32_t MAX_COMPONENTS = 9;
+
+	enum class _ChannelType {
+		STATE,			// 6 components: position, velocity
+		ROTATION		// 9 components: rotation matrix elements (column-major)
+	};
+
+
+	/* A window over which every component of a channel is a Chebyshev series. */
+	struct _Segment {
+		double start = 0.0;
+		double end = -1.0;				// Empty if end < start
+		double midpoint = 0.0;
+		double inverseHalfLength = 0.0;
+		double nextLength = 0.0;		// Suggested length of the next segment (s)
+
+		std::array<std::array<double, NODE_COUNT>, MAX_COMPONENTS> coefficients{};
+
+		inline bool contains(double et) const { return et >= start && et <= end; }
+	};
+
+
+	struct _Channel {
+		_ChannelType type;
+		std::string name;				// SPICE ID of the body, or name of the frame
+		SpiceInt id = 0;				// NAIF ID of the body, or frame ID
+		bool isAvailable = true;		// Whether the body or frame was resolved (unresolved ones were reported when their channel was created)
+
+		_Segment current;								// Segment in use (physics thread only)
+		double segmentLength = INITIAL_SEGMENT_LENGTH;	// Length of the next segment (s)
+		int direction = 1;								// Direction time last moved in (+1 or -1)
+
+		_Segment prefetched;			// Adjacent segment fitted by the prefetch thread (guarded by m_prefetchMutex)
+		bool isPrefetchPending = false;	// Whether the prefetch thread is (or will be) fitting the adjacent segment (guarded by m_prefetchMutex)
+	};
+
+
+	/* A request to fit the segment adjacent to a channel's current one. */
+	struct _PrefetchJob {
+		_Channel *channel;
+		double anchor;					// The boundary of the current segment the new segment starts (direction > 0) or ends (direction < 0) at
+		int direction;
+		double length;
+	};
+
+
+	std::shared_ptr<CoordinateSystem> m_coordSystem;
+	bool m_enabled = true;
+	bool m_validate = false;
+	double m_positionTolerance = Solvers::DEFAULT_EPHEMERIS_POSITION_TOLERANCE;
+	double m_rotationTolerance = Solvers::DEFAULT_EPHEMERIS_ROTATION_TOLERANCE;
+
+	std::vector<std::unique_ptr<_Channel>> m_channels;		// Channels are heap-allocated so that prefetch jobs can refer to them while channels are added
+	std::unordered_map<std::string, uint32_t> m_bodyHandles;
+	std::unordered_map<std::string, uint32_t> m_frameHandles;
+
+	Statistics m_stats;				// Guarded by m_prefetchMutex (fit counters only; the query counters are only touched by the querying thread)
+
+	// Prefetch thread
+	std::shared_ptr<WorkerThread> m_prefetchThread;
+	std::mutex m_prefetchMutex;
+	std::condition_variable_any m_prefetchCV;			// Notified when a job is queued (or the cache is shutting down)
+	std::condition_variable m_prefetchDoneCV;			// Notified when a job is done
+	std::deque<_PrefetchJob> m_prefetchQueue;
+	bool m_stopping = false;
+
+
+	/* Creates a channel.
+		@return The handle of the channel.
+	*/
+	uint32_t addChannel(_ChannelType type, const std::string &name, std::unordered_map<std::string, uint32_t> &handles);
+
+
+	/* Makes a segment that contains an epoch the current segment of a channel (taking the prefetched segment if it contains the epoch), and queues the prefetch of the next one.
+		@param channel: The channel.
+		@param et: The epoch in Ephemeris Time.
+	*/
+	void advance(_Channel &channel, double et);
+
+
+	/* Fits a segment to SPICE, halving its length until it meets the fit tolerance.
+		@param channel: The channel.
+		@param anchor: The epoch the segment starts (direction > 0) or ends (direction < 0) at, in Ephemeris Time.
+		@param direction: The direction the segment extends in from the anchor.
+		@param length: The initial length of the segment (s).
+		@param attempts [out]: The number of fits made (the last one being accepted).
+
+		@return The segment.
+	*/
+	_Segment fitSegment(const _Channel &channel, double anchor, int direction, double length, uint32_t &attempts) const;
+
+
+	/* Samples a channel directly from SPICE.
+		@param channel: The channel.
+		@param et: The epoch in Ephemeris Time.
+		@param values [out]: The components of the channel.
+	*/
+	void sample(const _Channel &channel, double et, std::array<double, MAX_COMPONENTS> &values) const;
+
+
+	/* Evaluates the components of a channel's current segment.
+		@param segment: The segment.
+		@param componentCount: The number of components to evaluate.
+		@param et: The epoch in Ephemeris Time (within the segment).
+		@param values [out]: The components.
+	*/
+	static void Evaluate(const _Segment &segment, uint32_t componentCount, double et, std::array<double, MAX_COMPONENTS> &values);
+
+
+	/* Gets the number of components of a channel type. */
+	static inline uint32_t GetComponentCount(_ChannelType type) {
+		return (type == _ChannelType::STATE) ? 6 : 9;
+	}
+
+
+	/* Fits queued segments until the cache shuts down. */
+	void prefetchLoop(std::stop_token stopToken);
+};
@@ -0,0 +1,86 @@
+/* BarnesHut.bench.cpp - Benchmarks of the Barnes-Hut gravity solver against direct summation over synthetic scenes.
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+
+#include <Core/Data/Math.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+
+#include <Simulation/Gravity/BarnesHut.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Gravity/GravityKernels.hpp>
+
+#include <Fixtures/NBodyFixtures.hpp>
+
+
+TEST_CASE("Barnes-Hut accuracy against direct summation", "[gravity][barneshut]") {
+	using Clock = std::chrono::steady_clock;
+	static constexpr size_t SCENE_SIZES[] = { 1000, 10000, 50000 };
+
+	std::ostringstream report;
+	report << "Barnes-Hut gravity solver against direct summation (every body):";
+
+	for (size_t bodyCount : SCENE_SIZES) {
+		NBodyStore store;
+		NBodyFixtures::BuildSyntheticScene(bodyCount, 42, store);
+
+		std::vector<glm::dvec3> positions(bodyCount);
+		for (size_t i = 0; i < bodyCount; i++)
+			positions[i] = store.getPosition(i);
+
+
+		// Approximate accelerations
+		BarnesHutTree tree;
+		std::vector<glm::dvec3> approxAccelerations(bodyCount);
+
+		const Clock::time_point approxStart = Clock::now();
+		{
+			tree.build(positions, store.mu);
+
+			for (size_t i = 0; i < bodyCount; i++)
+				approxAccelerations[i] = tree.computeAcceleration(positions[i], static_cast<uint32_t>(i));
+		}
+		const double approxTime = std::chrono::duration<double>(Clock::now() - approxStart).count();
+
+
+		// Reference (direct-sum) accelerations
+		const Clock::time_point exactStart = Clock::now();
+		GravityKernels::ComputeAccelerationsSymmetric(store);
+		const double exactTime = std::chrono::duration<double>(Clock::now() - exactStart).count();
+
+
+		// Relative errors
+		double maxError = 0.0, sumError = 0.0, sumSqError = 0.0;
+		size_t comparedCount = 0;
+
+		for (size_t i = 0; i < bodyCount; i++) {
+			const glm::dvec3 exactAcceleration(store.ax[i], store.ay[i], store.az[i]);
+			const double exactMagnitude = glm::length(exactAcceleration);
+			if (exactMagnitude < EPSILON)
+				continue;
+
+			const double error = glm::length(approxAccelerations[i] - exactAcceleration) / exactMagnitude;
+			maxError = std::max(maxError, error);
+			sumError += error;
+			sumSqError += error * error;
+			comparedCount++;
+		}
+
+		REQUIRE(comparedCount > 0);
+		const double rmsError = std::sqrt(sumSqError / comparedCount);
+		CHECK(rmsError < 0.01);
+
+		report << "\n\t" << bodyCount << " bodies (theta = " << tree.getOpeningAngle() << ", " << tree.getNodeCount() << " nodes): relative acceleration error max = " << maxError
+			<< ", mean = " << (sumError / comparedCount) << ", RMS = " << rmsError << "; Barnes-Hut = " << (approxTime * 1e3) << " ms (including tree build), direct = "
+			<< (exactTime * 1e3) << " ms";
+	}
+
+	Log::Print(Log::T_INFO, "Barnes-Hut accuracy against direct summation", report.str());
+}
@@ -0,0 +1,51 @@
+/* BenchmarkUtils.hpp - Utilities shared by the synthetic benchmarks.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+
+namespace BenchmarkUtils {
+	using Clock = std::chrono::steady_clock;
+
+
+	/* Gets the thread counts over which a benchmark scales: powers of two, and the total.
+		@param maxThreads: The total number of threads (e.g., the size of a thread pool).
+
+		@return The thread counts, in increasing order.
+	*/
+	inline std::vector<uint32_t> GetThreadCounts(uint32_t maxThreads) {
+		std::vector<uint32_t> threadCounts;
+		for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+			threadCounts.push_back(threads);
+		threadCounts.push_back(maxThreads);
+
+		return threadCounts;
+	}
+
+
+	/* Repeats a pass until a minimum duration has elapsed.
+		@param minDuration: The minimum duration (s).
+		@param pass: The pass, called with the number of passes completed so far.
+
+		@return The number of passes, and the time they took (s).
+	*/
+	template<typename Pass>
+	inline std::pair<size_t, double> Repeat(double minDuration, Pass &&pass) {
+		size_t passes = 0;
+		double elapsed = 0.0;
+
+		const Clock::time_point start = Clock::now();
+		while (elapsed < minDuration) {
+			pass(passes);
+			passes++;
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+
+		return { passes, elapsed };
+	}
+}
@@ -0,0 +1,88 @@
+/* ConjunctionScreener.bench.cpp - Benchmarks of conjunction screening over a synthetic catalog.
+*/
+
+#include "catch.hpp"
+
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+#include <Simulation/Propagators/SGP4/SGP4Batch.hpp>
+#include <Simulation/Conjunctions/ConjunctionScreener.hpp>
+
+#include <Fixtures/TLEFixtures.hpp>
+
+
+TEST_CASE("Conjunction screening", "[conjunctions]") {
+	static constexpr size_t CATALOG_SIZE = 30000;				// Element sets in the synthetic catalog (about the size of the public catalog)
+	static constexpr double WINDOW = 3600.0;					// Screening window (s)
+	static constexpr double THRESHOLD = 5.0;					// Miss distance threshold (km)
+	static constexpr size_t REPORTED_EVENTS = 5;				// Number of closest approaches reported
+
+	std::vector<ElsetRec> elementSets;
+	std::vector<double> epochs;
+	const double startET = TLEFixtures::BuildSyntheticCatalog(CATALOG_SIZE, elementSets, epochs);
+
+	ThreadPool pool;
+	pool.init("BENCHMARK_SGP4", 0);
+
+	ConjunctionScreener screener;
+	ConjunctionScreener::Config config = screener.getConfig();
+	config.threshold = THRESHOLD;
+	screener.setConfig(config);
+
+	SGP4Batch batch;
+	std::vector<ConjunctionScreener::Shell> shells;
+
+	for (size_t k = 0; k < CATALOG_SIZE; k++) {
+		shells.push_back(ConjunctionScreener::GetShell(elementSets[k], config.shellMargin));
+		batch.add(elementSets[k], epochs[k]);
+	}
+
+	screener.reset(CATALOG_SIZE, shells);
+	screener.setObjectStateProvider([&](uint32_t object, double et, glm::dvec3 &position, glm::dvec3 &velocity) {
+		ElsetRec rec = elementSets[object];
+		double r[3], v[3];
+		if (!sgp4(&rec, (et - epochs[object]) / 60.0, r, v) || rec.error != 0)
+			return false;
+
+		position = glm::dvec3(r[0], r[1], r[2]);
+		velocity = glm::dvec3(v[0], v[1], v[2]);
+		return true;
+	});
+
+
+	// Screen the window, sampling states by batch propagation
+	std::vector<ConjunctionScreener::Event> events = screener.screen(startET, startET + WINDOW,
+		[&](double et, std::vector<glm::dvec3> &positions, std::vector<glm::dvec3> &velocities, std::vector<int> &errors) {
+			batch.propagate(et, positions, velocities, pool);
+			errors = batch.getErrors();
+		}
+	);
+
+	const ConjunctionScreener::Statistics &stats = screener.getStatistics();
+	CHECK(stats.events == events.size());
+
+
+	std::ostringstream report;
+	report << "Conjunction screening (" << CATALOG_SIZE << " element sets, " << (WINDOW / 60.0) << " min window, " << config.step << " s steps, " << THRESHOLD << " km threshold):"
+		<< "\n\tPairs screened: " << stats.pairs << " over " << stats.intervals << " intervals"
+		<< "\n\tApogee/perigee filter: " << stats.shellPairs << " pairs (" << (100.0 * stats.shellPairs / std::max<uint64_t>(stats.pairs, 1)) << "%)"
+		<< "\n\tSpatial hash: " << stats.candidatePairs << " candidate pairs, " << stats.proximatePairs << " within their motion bounds"
+		<< "\n\tTCA search: " << stats.refinedPairs << " pairs, " << stats.events << " close approaches"
+		<< "\n\tScreening: " << (stats.screeningTime * 1e3) << " ms (" << stats.getThroughput() << " pairs/s), propagation: " << (stats.propagationTime * 1e3) << " ms";
+
+	std::sort(events.begin(), events.end(), [](const ConjunctionScreener::Event &a, const ConjunctionScreener::Event &b) { return a.missDistance < b.missDistance; });
+	for (size_t i = 0; i < std::min(events.size(), REPORTED_EVENTS); i++) {
+		const ConjunctionScreener::Event &event = events[i];
+		report << "\n\tObjects " << event.objectA << " and " << event.objectB << ": TCA = epoch + " << (event.tca - startET) << " s, miss distance "
+			<< event.missDistance << " km, relative speed " << event.relativeSpeed << " km/s";
+	}
+
+	Log::Print(Log::T_INFO, "Conjunction screening", report.str());
+}
@@ -0,0 +1,135 @@
+/* EclipseTracker.bench.cpp - Benchmarks of eclipse tracking over synthetic scenes.
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <numeric>
+#include <sstream>
+#include <algorithm>
+
+
+#include <Core/Data/Math.hpp>
+#include <Core/Data/Constants.h>
+#include <Core/Data/Mapping/YAMLKeys.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Data/Bodies.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Eclipses/EclipseTracker.hpp>
+
+
+TEST_CASE("Eclipse tracking", "[eclipses]") {
+	static constexpr size_t SCENE_SIZES[] = { 1000, 10000, 50000 };		// Spacecraft in the synthetic scenes
+	static constexpr double STEP = 60.0;								// Time between updates (s)
+	static constexpr size_t UPDATE_COUNT = 120;							// Updates per scene (2 h, i.e., over an orbital period of the lowest orbits)
+	static constexpr double MOON_DISTANCE = 384400e3;					// Mean distance of the Moon from the Earth (m)
+
+	const ICelestialBody *earth = Body::GetCelestialBody(YAMLScene::Body_Earth);
+	const ICelestialBody *moon = Body::GetCelestialBody(YAMLScene::Body_Moon);
+
+	// Synthetic heliocentric scene: the Sun at rest at the origin, the Earth at 1 AU and the Moon in quadrature, moving uniformly on their circular orbits' tangents
+	const double earthSpeed = std::sqrt(Body::GetCelestialBody(YAMLScene::Body_Sun)->getGravParam() / PhysicsConst::AU);
+	const double moonSpeed = std::sqrt(earth->getGravParam() / MOON_DISTANCE);
+
+	struct _Occulter {
+		const ICelestialBody *body;
+		glm::dvec3 position;
+		glm::dvec3 velocity;
+	};
+	const std::vector<_Occulter> occulterBodies = {
+		{ earth, glm::dvec3(PhysicsConst::AU, 0.0, 0.0), glm::dvec3(0.0, earthSpeed, 0.0) },
+		{ moon, glm::dvec3(PhysicsConst::AU, MOON_DISTANCE, 0.0), glm::dvec3(-moonSpeed, earthSpeed, 0.0) }
+	};
+
+	const size_t occulterCount = occulterBodies.size();
+	std::vector<EclipseTracker::Occulter> occulters(occulterCount);
+	for (size_t k = 0; k < occulterCount; k++)
+		occulters[k] = EclipseTracker::Occulter{ .bodyIndex = static_cast<uint32_t>(k + 1), .radius = occulterBodies[k].body->getEquatRadius() };
+
+	struct _Orbit {
+		size_t host;
+		double radius;
+		double meanMotion;
+		double phase;
+		glm::dvec3 u, w;		// Orthonormal basis of the orbital plane
+	};
+
+	ThreadPool pool;
+	pool.init("BENCHMARK_ECLIPSE", 0);
+
+	std::ostringstream report;
+	report << "Eclipse tracking (" << occulterCount << " occulting bodies, " << UPDATE_COUNT << " updates " << STEP << " s apart):";
+
+	for (size_t sceneSize : SCENE_SIZES) {
+		std::mt19937_64 rng(sceneSize);
+		std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+		// Circular orbits of random orientations, 5 to 55% of their hosts' radii above their surfaces, spread across the occulting bodies
+		std::vector<_Orbit> orbits(sceneSize);
+		for (size_t i = 0; i < sceneSize; i++) {
+			_Orbit &orbit = orbits[i];
+			orbit.host = i % occulterCount;
+			orbit.radius = occulterBodies[orbit.host].body->getEquatRadius() * (1.05 + 0.5 * uniform(rng));
+			orbit.meanMotion = std::sqrt(occulterBodies[orbit.host].body->getGravParam() / (orbit.radius * orbit.radius * orbit.radius));
+			orbit.phase = TWOPI * uniform(rng);
+
+			const double inclination = std::acos(1.0 - 2.0 * uniform(rng));
+			const double raan = TWOPI * uniform(rng);
+			orbit.u = glm::dvec3(std::cos(raan), std::sin(raan), 0.0);
+			orbit.w = glm::dvec3(-std::sin(raan) * std::cos(inclination), std::cos(raan) * std::cos(inclination), std::sin(inclination));
+		}
+
+		NBodyStore store;
+		store.resize(1 + occulterCount + sceneSize);
+
+		auto setStates = [&](double t) {
+			store.setPosition(0, glm::dvec3(0.0));
+			store.setVelocity(0, glm::dvec3(0.0));
+
+			for (size_t k = 0; k < occulterCount; k++) {
+				store.setPosition(k + 1, occulterBodies[k].position + t * occulterBodies[k].velocity);
+				store.setVelocity(k + 1, occulterBodies[k].velocity);
+			}
+
+			for (size_t i = 0; i < sceneSize; i++) {
+				const _Orbit &orbit = orbits[i];
+				const double angle = orbit.phase + orbit.meanMotion * t;
+
+				store.setPosition(1 + occulterCount + i, store.getPosition(orbit.host + 1) + orbit.radius * (std::cos(angle) * orbit.u + std::sin(angle) * orbit.w));
+				store.setVelocity(1 + occulterCount + i, store.getVelocity(orbit.host + 1) + orbit.radius * orbit.meanMotion * (-std::sin(angle) * orbit.u + std::cos(angle) * orbit.w));
+			}
+		};
+
+
+		std::vector<uint32_t> spacecraft(sceneSize);
+		std::iota(spacecraft.begin(), spacecraft.end(), static_cast<uint32_t>(1 + occulterCount));
+
+		EclipseTracker tracker;
+		tracker.setBodies(0, occulters, spacecraft);
+
+		std::vector<EclipseTracker::Transition> transitions;
+		for (size_t update = 0; update < UPDATE_COUNT; update++) {
+			const double t = update * STEP;
+			setStates(t);
+			tracker.update(t, store, pool, transitions);
+		}
+
+		const EclipseTracker::Statistics &stats = tracker.getStatistics();
+		const double timePerUpdate = stats.time / stats.updates;
+
+		// Over an orbital period, spacecraft in low orbits cross their hosts' shadows
+		CHECK(transitions.size() == stats.transitions);
+		CHECK(stats.transitions > 0);
+
+		report << "\n\t" << sceneSize << " spacecraft: " << (timePerUpdate * 1e6) << " us/update (" << (timePerUpdate * 1e9 / sceneSize) << " ns/spacecraft), "
+			<< (static_cast<double>(stats.candidatePairs) / (stats.updates * sceneSize)) << " of " << occulterCount << " occulting bodies evaluated per spacecraft, "
+			<< (100.0 * stats.shadowPairs / std::max<uint64_t>(stats.candidatePairs, 1)) << "% of them outside full sunlight, "
+			<< stats.transitions << " transitions (" << stats.refinements << " boundary evaluations)";
+	}
+
+	Log::Print(Log::T_INFO, "Eclipse tracking", report.str());
+}
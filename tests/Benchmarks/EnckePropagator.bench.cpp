@@ -0,0 +1,120 @@
+/* EnckePropagator.bench.cpp - Benchmarks of Encke propagation against Cowell propagation.
+*/
+
+#include "catch.hpp"
+
+#include <array>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <utility>
+#include <algorithm>
+
+
+#include <Core/Data/Physics.hpp>
+#include <Core/Data/Mapping/YAMLKeys.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+
+#include <Engine/Registry/ECS/Components/CoreComponents.hpp>
+#include <Engine/Registry/ECS/Components/PhysicsComponents.hpp>
+
+#include <Simulation/ODEs.hpp>
+#include <Simulation/Data/Bodies.hpp>
+#include <Simulation/Data/Solvers.hpp>
+#include <Simulation/Forces/ForceModels.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Integrators/RK4.hpp>
+#include <Simulation/Propagators/Encke/EnckePropagator.hpp>
+
+
+TEST_CASE("Encke vs. Cowell propagation", "[encke]") {
+	using Clock = std::chrono::steady_clock;
+	static constexpr double ALTITUDE = 500e3;						// Altitude of the orbit (m)
+	static constexpr double INCLINATION = 51.6;						// Inclination of the orbit (deg)
+	static constexpr double DURATION = 86400.0;						// Propagated time (s)
+	static constexpr double REFERENCE_STEP = 1.0;					// Step size of the reference solution (s)
+	static constexpr double STEP_SIZES[] = { 10.0, 30.0, 60.0, 120.0, 300.0 };
+
+	const ICelestialBody *earth = Body::GetCelestialBody(YAMLScene::Body_Earth);
+	const std::array<double, 4> higherZonals = earth->getHigherZonals();
+
+	// Synthetic scene: the Earth (with zonal harmonics up to J6) at the origin, and a massless satellite
+	NBodyStore store;
+	store.resize(2);
+	store.mu[0] = earth->getGravParam();
+
+	const ForceModel::CentralBody central{
+		.bodyIndex = 0,
+		.gravParam = earth->getGravParam(),
+		.equatRadius = earth->getEquatRadius(),
+		.flattening = earth->getFlattening(),
+		.zonals = { 0.0, 0.0, earth->getJ2(), higherZonals[0], higherZonals[1], higherZonals[2], higherZonals[3] }
+	};
+
+	const double radius = earth->getEquatRadius() + ALTITUDE;
+	const double speed = std::sqrt(earth->getGravParam() / radius);
+	const double inclination = glm::radians(INCLINATION);
+	const glm::dvec3 initialPosition(radius, 0.0, 0.0);
+	const glm::dvec3 initialVelocity(0.0, speed * std::cos(inclination), speed * std::sin(inclination));
+
+
+	// Cowell: the full equations of motion, as integrated by PhysicsSystem::updateGeneralBodies
+	auto propagateCowell = [&](double stepSize) {
+		ODE::VectorizedNBody gravityODE{};
+		gravityODE.bodies = &store;
+		gravityODE.bodyIndex = 1;
+
+		auto ode = [&](const Physics::State &state, double t) {
+			Physics::State derivative = gravityODE(state, t);
+			derivative.velocity += ForceModel::ZonalHarmonics(state.position, central, Solvers::MAX_ZONAL_DEGREE);
+			return derivative;
+		};
+
+		Physics::State state{ .position = initialPosition, .velocity = initialVelocity };
+		for (double t = 0.0; t < DURATION; t += stepSize)
+			RK4Integrator<Physics::State, decltype(ode)>::Integrate(state, t, std::min(stepSize, DURATION - t), ode);
+
+		return state.position;
+	};
+
+	// Encke: the deviation from the osculating conic
+	auto propagateEncke = [&](double stepSize, EnckePropagator::State &state) {
+		state.stepSize = stepSize;
+		EnckePropagator::Rectify(state, initialPosition, initialVelocity, 0.0, earth->getGravParam());
+
+		EnckePropagator::Propagate(state, DURATION, [&](double t, const glm::dvec3 &position, const glm::dvec3 &velocity) {
+			return ForceModel::ZonalHarmonics(position, central, Solvers::MAX_ZONAL_DEGREE);
+		});
+
+		glm::dvec3 position(0.0), velocity(0.0);
+		EnckePropagator::GetState(state, position, velocity);
+		return position;
+	};
+
+	auto measure = [](auto &&propagate) {
+		const Clock::time_point start = Clock::now();
+		const glm::dvec3 position = propagate();
+		return std::make_pair(position, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+	};
+
+
+	const glm::dvec3 reference = propagateCowell(REFERENCE_STEP);
+
+	std::ostringstream report;
+	report << std::fixed << std::setprecision(2);
+	report << "Encke vs. Cowell (RK4) position error after " << DURATION / 3600.0 << " h of a " << ALTITUDE / 1e3 << " km, "
+		<< INCLINATION << " deg orbit under J2-J6 (reference: Cowell, " << REFERENCE_STEP << " s steps):";
+
+	for (double stepSize : STEP_SIZES) {
+		EnckePropagator::State enckeState{};
+
+		const auto [cowellPosition, cowellTime] = measure([&]() { return propagateCowell(stepSize); });
+		const auto [enckePosition, enckeTime] = measure([&]() { return propagateEncke(stepSize, enckeState); });
+
+		report << "\n\t" << stepSize << " s steps: Cowell " << std::scientific << glm::length(cowellPosition - reference) << std::fixed << " m (" << cowellTime << " ms), "
+			<< "Encke " << std::scientific << glm::length(enckePosition - reference) << std::fixed << " m (" << enckeTime << " ms, "
+			<< enckeState.rectifications << " rectifications)";
+	}
+
+	Log::Print(Log::T_INFO, "Encke vs. Cowell propagation", report.str());
+}
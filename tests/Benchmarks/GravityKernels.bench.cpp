@@ -0,0 +1,146 @@
+/* GravityKernels.bench.cpp - Benchmarks of the direct-sum gravity kernels over synthetic scenes.
+*/
+
+#include "catch.hpp"
+
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <sstream>
+
+
+#include <Core/Data/Physics.hpp>
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Engine/Registry/ECS/Components/CoreComponents.hpp>
+#include <Engine/Registry/ECS/Components/PhysicsComponents.hpp>
+
+#include <Simulation/ODEs.hpp>
+#include <Simulation/Gravity/NBodyStore.hpp>
+#include <Simulation/Gravity/GravityKernels.hpp>
+
+#include <Fixtures/NBodyFixtures.hpp>
+#include <Benchmarks/BenchmarkUtils.hpp>
+
+
+TEST_CASE("Direct-sum gravity throughput", "[gravity]") {
+	static constexpr size_t BODY_COUNT = 1000;
+	static constexpr double MIN_BENCHMARK_DURATION = 0.05;		// Minimum duration of each benchmark (s)
+
+	NBodyStore store;
+	NBodyFixtures::BuildSyntheticScene(BODY_COUNT, BODY_COUNT, store);
+
+	// The same scene, as the tuples of the ECS path
+	std::vector<std::tuple<EntityID, CoreComponent::Transform, PhysicsComponent::RigidBody>> bodies(BODY_COUNT);
+	for (size_t i = 0; i < BODY_COUNT; i++) {
+		std::get<0>(bodies[i]) = static_cast<EntityID>(i);
+		std::get<1>(bodies[i]).position = store.getPosition(i);
+		std::get<2>(bodies[i]).mass = store.mu[i] / PhysicsConst::G;
+	}
+
+	const double pairsPerPass = static_cast<double>(BODY_COUNT) * static_cast<double>(BODY_COUNT - 1);
+
+
+	/* Repeats full direct-sum passes until the minimum duration has elapsed, and returns the throughput in pairs/s. */
+	auto measureThroughput = [&](auto &&computePass) {
+		const auto [passes, elapsed] = BenchmarkUtils::Repeat(MIN_BENCHMARK_DURATION, [&](size_t) { computePass(); });
+		return passes * pairsPerPass / elapsed;
+	};
+
+	glm::dvec3 sink(0.0);	// Prevents the passes from being optimized away
+
+
+	// Tuple-based path
+	const double tupleThroughput = measureThroughput([&]() {
+		for (const auto &[entityID, transform, _] : bodies) {
+			ODE::NewtonianNBody ode{};
+			ode.bodies = &bodies;
+			ode.entityID = entityID;
+
+			sink += ode(Physics::State{ .position = transform.position }, 0.0).velocity;
+		}
+	});
+
+
+	// SoA paths
+	using GravityKernels::InstructionSet;
+	const InstructionSet supportedSet = GravityKernels::GetSupportedInstructionSet();
+
+	std::ostringstream report;
+	report << "Direct-sum gravity throughput (" << BODY_COUNT << " bodies):\n"
+		<< "\tTuple-based (NewtonianNBody): " << tupleThroughput << " pairs/s";
+
+	for (InstructionSet instructionSet : { InstructionSet::SCALAR, InstructionSet::AVX2, InstructionSet::AVX512 }) {
+		if (static_cast<int>(instructionSet) > static_cast<int>(supportedSet))
+			break;
+
+		const double throughput = measureThroughput([&]() {
+			for (size_t i = 0; i < BODY_COUNT; i++)
+				sink += GravityKernels::ComputeAccelerationAt(store, store.getPosition(i), static_cast<uint32_t>(i), instructionSet);
+		});
+
+		report << "\n\tSoA (" << GravityKernels::GetInstructionSetName(instructionSet) << "): " << throughput << " pairs/s ("
+			<< (throughput / tupleThroughput) << "x)" << ((instructionSet == supportedSet) ? " [selected]" : "");
+	}
+
+	Log::Print(Log::T_INFO, "Direct-sum gravity throughput", report.str());
+	Log::Print(Log::T_DEBUG, "Direct-sum gravity throughput", "Benchmark checksum: " + std::to_string(glm::length(sink)));
+}
+
+
+TEST_CASE("Parallel symmetric direct-sum scaling", "[gravity][threads]") {
+	static constexpr size_t SCENE_SIZES[] = { 1000, 10000, 50000 };
+	static constexpr double MIN_BENCHMARK_DURATION = 0.2;		// Minimum duration of each benchmark (s)
+
+	ThreadPool pool;
+	pool.init("BENCHMARK_FORCE", 0);
+
+	const std::vector<uint32_t> threadCounts = BenchmarkUtils::GetThreadCounts(pool.getThreadCount());
+	std::vector<double> laneAccelerations;
+
+	std::ostringstream report;
+	report << "Parallel symmetric direct-sum acceleration pass (" << GravityKernels::GetInstructionSetName(GravityKernels::GetSupportedInstructionSet())
+		<< ", up to " << GravityKernels::PAIR_LANE_COUNT << " lanes of " << GravityKernels::PAIR_ROWS_PER_BLOCK << "-row blocks):";
+
+	for (size_t bodyCount : SCENE_SIZES) {
+		NBodyStore scene;
+		NBodyFixtures::BuildSyntheticScene(bodyCount, 42, scene);
+
+		const double pairsPerPass = 0.5 * static_cast<double>(bodyCount) * static_cast<double>(bodyCount - 1);
+
+		report << "\n\t" << bodyCount << " bodies:";
+
+		std::vector<double> referenceAccelerations[3];
+		double serialTime = 0.0;
+
+		for (uint32_t threads : threadCounts) {
+			const auto [passes, elapsed] = BenchmarkUtils::Repeat(MIN_BENCHMARK_DURATION, [&](size_t) {
+				GravityKernels::ComputeAccelerationsSymmetricParallel(scene, laneAccelerations, pool, threads);
+			});
+
+			const double passTime = elapsed / passes;
+			if (threads == 1) {
+				serialTime = passTime;
+				referenceAccelerations[0] = scene.ax;
+				referenceAccelerations[1] = scene.ay;
+				referenceAccelerations[2] = scene.az;
+			}
+
+			// Every thread count must yield bit-for-bit identical accelerations
+			const size_t bytes = bodyCount * sizeof(double);
+			const bool isIdentical =
+				std::memcmp(scene.ax.data(), referenceAccelerations[0].data(), bytes) == 0 &&
+				std::memcmp(scene.ay.data(), referenceAccelerations[1].data(), bytes) == 0 &&
+				std::memcmp(scene.az.data(), referenceAccelerations[2].data(), bytes) == 0;
+			CHECK(isIdentical);
+
+			const double speedup = serialTime / passTime;
+			report << "\n\t\t" << threads << " thread(s): " << (passTime * 1e3) << " ms/pass, " << (pairsPerPass / passTime) << " pairs/s, speedup = "
+				<< speedup << "x, efficiency = " << (100.0 * speedup / threads) << "%" << (isIdentical ? "" : " [MISMATCH against 1 thread]");
+		}
+	}
+
+	Log::Print(Log::T_INFO, "Parallel symmetric direct-sum scaling", report.str());
+}
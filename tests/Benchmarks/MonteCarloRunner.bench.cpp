@@ -0,0 +1,66 @@
+/* MonteCarloRunner.bench.cpp - Benchmarks of Monte Carlo dispersion analysis over a synthetic low Earth orbit.
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <vector>
+#include <sstream>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Data/Dispersions.hpp>
+#include <Simulation/Dispersions/MonteCarloRunner.hpp>
+
+#include <Fixtures/MonteCarloFixtures.hpp>
+#include <Benchmarks/BenchmarkUtils.hpp>
+
+
+TEST_CASE("Monte Carlo scaling", "[montecarlo][threads]") {
+	static constexpr uint32_t RUN_COUNT = 256;
+
+	const double period = MonteCarloFixtures::GetPeriod();
+
+	Dispersions::Config config;
+	MonteCarloRunner::Scenario scenario;
+	MonteCarloFixtures::BuildLEOAnalysis(RUN_COUNT, period, config, scenario);
+
+	MonteCarloRunner runner;
+	runner.setup(config, scenario);
+
+	ThreadPool pool;
+	pool.init("BENCHMARK_MONTE_CARLO", 0);
+
+
+	std::ostringstream report;
+	report << "Monte Carlo dispersion analysis (" << RUN_COUNT << " runs of a " << (MonteCarloFixtures::ALTITUDE * 1e-3) << " km orbit over " << (period / 60.0)
+		<< " min, with J2, drag and a " << MonteCarloFixtures::BURN_DURATION << " s burn):";
+
+	MonteCarloRunner::Statistics serialStats;
+
+	for (uint32_t threads : BenchmarkUtils::GetThreadCounts(pool.getThreadCount())) {
+		runner.run(pool, threads);
+		const MonteCarloRunner::Statistics stats = runner.getStatistics();
+
+		if (threads == 1) {
+			serialStats = stats;
+
+			const glm::dvec3 sigma(std::sqrt(stats.covariance[0][0]), std::sqrt(stats.covariance[1][1]), std::sqrt(stats.covariance[2][2]));
+			report << "\n\tMiss distance: " << stats.meanMissDistance << " m (mean), " << stats.missDistance3Sigma << " m (3-sigma), " << stats.maxMissDistance << " m (max), "
+				<< stats.failedRuns << " incomplete run(s)"
+				<< "\n\t1-sigma deviation (radial, in-track, cross-track): (" << sigma.x << ", " << sigma.y << ", " << sigma.z << ") m, mean final mass: " << stats.meanMass << " kg";
+		}
+
+		// Runs do not depend on the number of threads, and neither do order statistics (unlike sums, which are merged in completion order)
+		const bool isIdentical = (stats.runs == serialStats.runs && stats.maxMissDistance == serialStats.maxMissDistance && stats.missDistance3Sigma == serialStats.missDistance3Sigma);
+		CHECK(isIdentical);
+
+		const double speedup = serialStats.time / stats.time;
+		report << "\n\t" << threads << " thread(s): " << (stats.time * 1e3) << " ms, " << stats.getRunsPerSecond() << " runs/s, speedup = "
+			<< speedup << "x, efficiency = " << (100.0 * speedup / threads) << "%" << (isIdentical ? "" : " [MISMATCH against 1 thread]");
+	}
+
+	Log::Print(Log::T_INFO, "Monte Carlo scaling", report.str());
+}
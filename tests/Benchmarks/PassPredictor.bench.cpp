@@ -0,0 +1,125 @@
+/* PassPredictor.bench.cpp - Benchmarks of pass prediction over a synthetic catalog.
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+#include <Simulation/Passes/PassPredictor.hpp>
+
+#include <Fixtures/TLEFixtures.hpp>
+#include <Fixtures/SPICEFixtures.hpp>
+#include <Benchmarks/BenchmarkUtils.hpp>
+
+
+TEST_CASE("Pass prediction", "[passes][threads]") {
+	using Clock = std::chrono::steady_clock;
+	static constexpr size_t CATALOG_SIZE = 10000;			// Element sets in the synthetic catalog
+	static constexpr double WINDOW = 86400.0;				// Prediction window (s)
+	static constexpr size_t REFERENCE_SIZE = 20;			// Satellites whose passes are checked against fine sampling
+	static constexpr double REFERENCE_STEP = 1.0;			// Step of fine sampling (s)
+	static constexpr double MATCH_TOLERANCE = 30.0;			// Largest difference between the rise times of matching passes (s)
+
+	// Sites are rotated with the Earth by Greenwich Mean Sidereal Time, which is a function of UTC
+	SPICEFixtures::LoadLeapsecondsKernel();
+
+	std::vector<ElsetRec> elementSets;
+	std::vector<double> epochs;
+	const double startET = TLEFixtures::BuildSyntheticCatalog(CATALOG_SIZE, elementSets, epochs);
+	const double endET = startET + WINDOW;
+
+	const std::vector<PassPredictor::Site> sites = {
+		{ .name = "Svalbard", .latitude = 78.23, .longitude = 15.41, .altitude = 0.5, .minElevation = 5.0 },
+		{ .name = "Kourou", .latitude = 5.25, .longitude = -52.80, .altitude = 0.0, .minElevation = 5.0 },
+		{ .name = "Canberra", .latitude = -35.40, .longitude = 148.98, .altitude = 0.7, .minElevation = 10.0 }
+	};
+
+	PassPredictor predictor;
+	predictor.setSites(sites);
+
+	ThreadPool pool;
+	pool.init("BENCHMARK_SGP4", 0);
+
+	auto isSamePass = [](const PassPredictor::Pass &a, const PassPredictor::Pass &b) {
+		return a.object == b.object && a.site == b.site && a.rise == b.rise && a.culmination == b.culmination && a.set == b.set && a.maxElevation == b.maxElevation;
+	};
+
+
+	std::ostringstream report;
+	report << "Pass prediction (" << CATALOG_SIZE << " satellites, " << sites.size() << " sites, " << (WINDOW / 3600.0) << " h window):";
+
+	std::vector<PassPredictor::Pass> passes;
+	double serialTime = 0.0;
+
+	for (uint32_t threads : BenchmarkUtils::GetThreadCounts(pool.getThreadCount())) {
+		predictor.resetStatistics();
+
+		const Clock::time_point start = Clock::now();
+		std::vector<PassPredictor::Pass> threadPasses = predictor.predict(elementSets, epochs, startET, endET, pool, threads);
+		const double time = std::chrono::duration<double>(Clock::now() - start).count();
+
+		if (threads == 1) {
+			serialTime = time;
+			passes = threadPasses;
+
+			const PassPredictor::Statistics &stats = predictor.getStatistics();
+			report << "\n\tSatellite-site pairs: " << stats.sitePairs << " (" << stats.filteredPairs << " rejected by the geometric filter)"
+				<< "\n\tPropagations: " << stats.samples << " coarse samples, " << stats.refinements << " during refinement ("
+				<< (CATALOG_SIZE * WINDOW / REFERENCE_STEP) << " at " << REFERENCE_STEP << " s sampling)"
+				<< "\n\tPasses: " << stats.passes << " (" << stats.failures << " satellites failed to propagate)";
+		}
+
+		// Every thread count must yield the same passes
+		const bool isIdentical = threadPasses.size() == passes.size() && std::equal(threadPasses.begin(), threadPasses.end(), passes.begin(), isSamePass);
+		CHECK(isIdentical);
+
+		const double speedup = serialTime / time;
+		report << "\n\t" << threads << " thread(s): " << (time * 1e3) << " ms, " << (CATALOG_SIZE * WINDOW / 86400.0 / time) << " satellite-days/s, speedup = "
+			<< speedup << "x, efficiency = " << (100.0 * speedup / threads) << "%" << (isIdentical ? "" : " [MISMATCH against 1 thread]");
+	}
+
+
+	// Accuracy: passes of the first satellites against fine sampling (every REFERENCE_STEP, which brackets every pass longer than it)
+	PassPredictor reference;
+	reference.setSites(sites);
+	reference.setConfig(PassPredictor::Config{ .gridStep = REFERENCE_STEP, .maxStep = REFERENCE_STEP });
+
+	const std::vector<ElsetRec> referenceSets(elementSets.begin(), elementSets.begin() + REFERENCE_SIZE);
+	const std::vector<double> referenceEpochs(epochs.begin(), epochs.begin() + REFERENCE_SIZE);
+	const std::vector<PassPredictor::Pass> referencePasses = reference.predict(referenceSets, referenceEpochs, startET, endET, pool);
+
+	size_t missed = 0;
+	double maxRiseError = 0.0, maxSetError = 0.0, maxElevationError = 0.0;
+
+	for (const PassPredictor::Pass &referencePass : referencePasses) {
+		auto match = std::find_if(passes.begin(), passes.end(), [&](const PassPredictor::Pass &pass) {
+			return pass.object == referencePass.object && pass.site == referencePass.site && std::fabs(pass.rise - referencePass.rise) < MATCH_TOLERANCE;
+		});
+
+		if (match == passes.end()) {
+			missed++;
+			continue;
+		}
+
+		maxRiseError = std::max(maxRiseError, std::fabs(match->rise - referencePass.rise));
+		maxSetError = std::max(maxSetError, std::fabs(match->set - referencePass.set));
+		maxElevationError = std::max(maxElevationError, std::fabs(match->maxElevation - referencePass.maxElevation));
+	}
+
+	const size_t coarseCount = std::count_if(passes.begin(), passes.end(), [](const PassPredictor::Pass &pass) { return pass.object < REFERENCE_SIZE; });
+
+	report << "\n\tAgainst " << REFERENCE_STEP << " s sampling (" << REFERENCE_SIZE << " satellites, " << referencePasses.size() << " passes): "
+		<< missed << " missed, " << (coarseCount + missed - referencePasses.size()) << " spurious, max rise error " << maxRiseError << " s, max set error "
+		<< maxSetError << " s, max elevation error " << maxElevationError << " deg";
+
+	Log::Print(Log::T_INFO, "Pass prediction", report.str());
+}
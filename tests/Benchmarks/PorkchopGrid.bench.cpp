@@ -0,0 +1,153 @@
+/* PorkchopGrid.bench.cpp - Benchmarks of porkchop grid evaluation over a synthetic Earth-Mars grid.
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Data/Bodies.hpp>
+#include <Simulation/Maneuvers/PorkchopGrid.hpp>
+#include <Simulation/Algorithms/Kepler/KEPLER.hpp>
+#include <Simulation/Algorithms/Lambert/LAMBERT.hpp>
+
+#include <Benchmarks/BenchmarkUtils.hpp>
+
+
+TEST_CASE("Porkchop grid", "[lambert][threads]") {
+	using Clock = std::chrono::steady_clock;
+	static constexpr uint32_t GRID_SIZE = 500;						// Departure and arrival epochs
+	static constexpr int MAX_REVOLUTIONS = 1;
+	static constexpr size_t SAMPLE_COUNT = 1000;					// Cells whose transfers are checked against Kepler propagation
+	static constexpr double DAY = 86400.0;
+	static constexpr double EPOCH = 0.0;							// Start of the windows, in Ephemeris Time
+
+	const double mu = Body::Sun.getGravParam();
+	const double earthRadius = 1.495978707e11;						// Orbital radii (m)
+	const double marsRadius = 1.52368 * earthRadius;
+	const double marsPhase = 0.75;									// Phase of Mars ahead of the Earth at the start of the windows (rad)
+
+	PorkchopGrid grid;
+	grid.setConfig(PorkchopGrid::Config{
+		.gravParam = mu,
+		.departureStart = EPOCH,
+		.departureEnd = EPOCH + 800.0 * DAY,
+		.arrivalStart = EPOCH + 100.0 * DAY,
+		.arrivalEnd = EPOCH + 1300.0 * DAY,
+		.departureSteps = GRID_SIZE,
+		.arrivalSteps = GRID_SIZE,
+		.maxRevolutions = MAX_REVOLUTIONS
+	});
+
+
+	// Coplanar circular orbits
+	auto circularState = [mu](double radius, double phase, double t, glm::dvec3 &position, glm::dvec3 &velocity) {
+		const double meanMotion = std::sqrt(mu / (radius * radius * radius));
+		const double angle = phase + meanMotion * t;
+
+		position = radius * glm::dvec3(std::cos(angle), std::sin(angle), 0.0);
+		velocity = radius * meanMotion * glm::dvec3(-std::sin(angle), std::cos(angle), 0.0);
+	};
+
+	PorkchopGrid::Ephemerides ephemerides;
+	ephemerides.departurePositions.resize(GRID_SIZE);
+	ephemerides.departureVelocities.resize(GRID_SIZE);
+	ephemerides.arrivalPositions.resize(GRID_SIZE);
+	ephemerides.arrivalVelocities.resize(GRID_SIZE);
+
+	for (uint32_t i = 0; i < GRID_SIZE; i++) {
+		circularState(earthRadius, 0.0, grid.getDepartureET(i) - EPOCH, ephemerides.departurePositions[i], ephemerides.departureVelocities[i]);
+		circularState(marsRadius, marsPhase, grid.getArrivalET(i) - EPOCH, ephemerides.arrivalPositions[i], ephemerides.arrivalVelocities[i]);
+	}
+	grid.setEphemerides(ephemerides);
+
+
+	ThreadPool pool;
+	pool.init("BENCHMARK_LAMBERT", 0);
+
+	auto isSameCell = [](const PorkchopGrid::Cell &a, const PorkchopGrid::Cell &b) {
+		return a.revolutions == b.revolutions && (!a.hasTransfer() || (a.c3 == b.c3 && a.arrivalVInf == b.arrivalVInf));
+	};
+
+
+	std::ostringstream report;
+	report << "Porkchop grid (Earth-Mars, " << GRID_SIZE << " x " << GRID_SIZE << " cells, up to " << MAX_REVOLUTIONS << " revolution(s)):";
+
+	std::vector<PorkchopGrid::Cell> cells;
+	double serialTime = 0.0;
+
+	for (uint32_t threads : BenchmarkUtils::GetThreadCounts(pool.getThreadCount())) {
+		const Clock::time_point start = Clock::now();
+		grid.solve(pool, threads);
+		const double time = std::chrono::duration<double>(Clock::now() - start).count();
+
+		std::vector<PorkchopGrid::Cell> threadCells;
+		size_t cursor = 0;
+		grid.fetchRows(threadCells, cursor);
+
+		if (threads == 1) {
+			serialTime = time;
+			cells = threadCells;
+
+			const PorkchopGrid::Statistics stats = grid.getStatistics();
+			report << "\n\tCells with transfers: " << stats.transferCells << ", Lambert solutions: " << stats.solutions << " ("
+				<< (static_cast<double>(stats.iterations) / std::max<uint64_t>(stats.solutions, 1)) << " iterations per solution)";
+		}
+
+		// Every thread count must yield the same cells
+		const bool isIdentical = std::equal(threadCells.begin(), threadCells.end(), cells.begin(), cells.end(), isSameCell);
+		CHECK(isIdentical);
+
+		const double speedup = serialTime / time;
+		report << "\n\t" << threads << " thread(s): " << (time * 1e3) << " ms, " << (static_cast<double>(GRID_SIZE) * GRID_SIZE / time) << " cells/s, speedup = "
+			<< speedup << "x, efficiency = " << (100.0 * speedup / threads) << "%" << (isIdentical ? "" : " [MISMATCH against 1 thread]");
+	}
+
+
+	// Accuracy: the transfers of random cells, propagated from departure to arrival
+	std::mt19937_64 rng(GRID_SIZE);
+	std::uniform_int_distribution<uint32_t> index(0, GRID_SIZE - 1);
+	std::vector<Lambert::Solution> solutions;
+	double maxPositionError = 0.0, maxVelocityError = 0.0;
+
+	for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+		const uint32_t row = index(rng), column = index(rng);
+		const double timeOfFlight = grid.getArrivalET(column) - grid.getDepartureET(row);
+
+		if (timeOfFlight < PorkchopGrid::MIN_TIME_OF_FLIGHT
+			|| !Lambert::izzo(ephemerides.departurePositions[row], ephemerides.arrivalPositions[column], timeOfFlight, mu, false, MAX_REVOLUTIONS, solutions))
+			continue;
+
+		for (const Lambert::Solution &solution : solutions) {
+			glm::dvec3 position, velocity;
+			if (!Kepler::kepler(ephemerides.departurePositions[row], solution.v1, timeOfFlight, mu, position, velocity))
+				continue;
+
+			maxPositionError = std::max(maxPositionError, glm::length(position - ephemerides.arrivalPositions[column]));
+			maxVelocityError = std::max(maxVelocityError, glm::length(velocity - solution.v2));
+		}
+	}
+
+
+	// Minimum C3 against the Hohmann transfer (which the grid brackets, as the phase of Mars repeats every synodic period)
+	double minC3 = std::numeric_limits<double>::infinity();
+	for (const PorkchopGrid::Cell &cell : cells)
+		if (cell.hasTransfer())
+			minC3 = std::min(minC3, cell.c3);
+
+	const double hohmannVInf = std::sqrt(mu / earthRadius) * (std::sqrt(2.0 * marsRadius / (earthRadius + marsRadius)) - 1.0);
+
+	report << "\n\tAgainst Kepler propagation (" << SAMPLE_COUNT << " cells): max position error " << maxPositionError << " m, max velocity error " << maxVelocityError << " m/s"
+		<< "\n\tMinimum C3: " << (minC3 * 1e-6) << " km^2/s^2 (Hohmann transfer: " << (hohmannVInf * hohmannVInf * 1e-6) << " km^2/s^2)";
+
+	Log::Print(Log::T_INFO, "Porkchop grid", report.str());
+}
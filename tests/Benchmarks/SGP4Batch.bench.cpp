@@ -0,0 +1,188 @@
+/* SGP4Batch.bench.cpp - Benchmarks of batch SGP4 propagation over synthetic catalogs.
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+
+
+#include <Core/Application/IO/LoggingManager.hpp>
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Gravity/GravityKernels.hpp>
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+#include <Simulation/Propagators/SGP4/SGP4Batch.hpp>
+
+#include <Fixtures/TLEFixtures.hpp>
+#include <Benchmarks/BenchmarkUtils.hpp>
+
+
+TEST_CASE("SGP4 throughput", "[sgp4]") {
+	static constexpr size_t CATALOG_SIZE = 30000;				// Element sets in the synthetic catalog (about the size of the public catalog)
+	static constexpr size_t COMPARED_SIZE = 100;				// Element sets whose batch and scalar positions are compared
+	static constexpr double MIN_BENCHMARK_DURATION = 0.05;		// Minimum duration of each benchmark (s)
+	static constexpr double COMPARISON_SPAN = 86400.0;			// Span over which batch and scalar positions are compared (s)
+	static constexpr double COMPARISON_STEP = 600.0;			// Step of the comparison (s)
+
+	std::vector<ElsetRec> elementSets;
+	std::vector<double> epochs;
+	const double startET = TLEFixtures::BuildSyntheticCatalog(CATALOG_SIZE, elementSets, epochs);
+
+	const size_t deepSpaceCount = std::count_if(elementSets.begin(), elementSets.end(), [](const ElsetRec &rec) { return rec.method == 'd'; });
+
+
+	/* Propagates the catalog one minute further per pass until the minimum duration has elapsed, and returns the throughput in propagations/s. */
+	auto measureThroughput = [&](auto &&propagateCatalog) {
+		const auto [passes, elapsed] = BenchmarkUtils::Repeat(MIN_BENCHMARK_DURATION, [&](size_t pass) {
+			propagateCatalog(startET + 60.0 * pass);
+		});
+
+		return passes * CATALOG_SIZE / elapsed;
+	};
+
+	double sink = 0.0;		// Prevents the passes from being optimized away
+
+
+	// Scalar path
+	std::vector<ElsetRec> scalarSets = elementSets;
+	const double scalarThroughput = measureThroughput([&](double et) {
+		for (size_t k = 0; k < CATALOG_SIZE; k++) {
+			double r[3], v[3];
+			sgp4(&scalarSets[k], (et - epochs[k]) / 60.0, r, v);
+			sink += r[0];
+		}
+	});
+
+
+	// Batch paths
+	using GravityKernels::InstructionSet;
+	const InstructionSet supportedSet = GravityKernels::GetSupportedInstructionSet();
+
+	std::ostringstream report;
+	report << "SGP4 throughput (" << CATALOG_SIZE << " element sets, " << deepSpaceCount << " deep-space):\n"
+		<< "\tScalar (sgp4): " << scalarThroughput << " propagations/s";
+
+	for (InstructionSet instructionSet : { InstructionSet::SCALAR, InstructionSet::AVX2, InstructionSet::AVX512 }) {
+		if (static_cast<int>(instructionSet) > static_cast<int>(supportedSet))
+			break;
+
+		SGP4Batch batch;
+		for (size_t k = 0; k < CATALOG_SIZE; k++)
+			batch.add(elementSets[k], epochs[k]);
+
+		std::vector<glm::dvec3> positions, velocities;
+
+		// Largest position difference from the scalar model (over the first element sets of the catalog)
+		double maxDifference = 0.0;
+		for (double dt = 0.0; dt <= COMPARISON_SPAN; dt += COMPARISON_STEP) {
+			batch.propagate(startET + dt, positions, velocities, instructionSet);
+
+			for (size_t k = 0; k < COMPARED_SIZE; k++) {
+				ElsetRec rec = elementSets[k];
+				double r[3], v[3];
+
+				if (sgp4(&rec, (startET + dt - epochs[k]) / 60.0, r, v) && batch.getErrors()[k] == 0)
+					maxDifference = std::max(maxDifference, glm::length(positions[k] - glm::dvec3(r[0], r[1], r[2])));
+			}
+		}
+
+		const double throughput = measureThroughput([&](double et) {
+			batch.propagate(et, positions, velocities, instructionSet);
+			sink += positions[0].x;
+		});
+
+		report << "\n\tBatch (" << GravityKernels::GetInstructionSetName(instructionSet) << "): " << throughput << " propagations/s ("
+			<< (throughput / scalarThroughput) << "x), max position difference " << maxDifference * 1e6 << " mm"
+			<< ((instructionSet == supportedSet) ? " [selected]" : "");
+	}
+
+	Log::Print(Log::T_INFO, "SGP4 throughput", report.str());
+	Log::Print(Log::T_DEBUG, "SGP4 throughput", "Benchmark checksum: " + std::to_string(sink));
+}
+
+
+TEST_CASE("Parallel SGP4 scaling", "[sgp4][threads]") {
+	static constexpr size_t CATALOG_SIZES[] = { 1000, 10000, 50000 };
+	static constexpr double MIN_BENCHMARK_DURATION = 0.2;		// Minimum duration of each benchmark (s)
+	static constexpr double FRAME_BUDGET = 1.0 / 60.0;			// Time per frame at 60 Hz (s)
+	static constexpr double FRAME_ANGLE = 1.0;					// Angle of the TEME-to-simulation frame rotation (rad)
+
+	ThreadPool pool;
+	pool.init("BENCHMARK_SGP4", 0);
+
+	const std::vector<uint32_t> threadCounts = BenchmarkUtils::GetThreadCounts(pool.getThreadCount());
+
+	// Stands in for the TEME-to-simulation frame rotation, which needs SPICE
+	const glm::dmat3 temeRotation(
+		glm::dvec3(std::cos(FRAME_ANGLE), std::sin(FRAME_ANGLE), 0.0),
+		glm::dvec3(-std::sin(FRAME_ANGLE), std::cos(FRAME_ANGLE), 0.0),
+		glm::dvec3(0.0, 0.0, 1.0)
+	);
+
+
+	std::ostringstream report;
+	report << "Parallel SGP4 propagation (" << GravityKernels::GetInstructionSetName(GravityKernels::GetSupportedInstructionSet())
+		<< ", " << SGP4Batch::TASK_SIZE << " element sets per task, " << (FRAME_BUDGET * 1e3) << " ms frame budget):";
+
+	for (size_t catalogSize : CATALOG_SIZES) {
+		std::vector<ElsetRec> elementSets;
+		std::vector<double> epochs;
+		const double startET = TLEFixtures::BuildSyntheticCatalog(catalogSize, elementSets, epochs);
+
+		SGP4Batch batch;
+		for (size_t k = 0; k < catalogSize; k++)
+			batch.add(elementSets[k], epochs[k]);
+
+		std::vector<glm::dvec3> temePositions, temeVelocities;
+		std::vector<glm::dvec3> positions(catalogSize), velocities(catalogSize);
+
+		report << "\n\t" << catalogSize << " satellites (" << batch.getDeepSpaceCount() << " deep-space):";
+
+		std::vector<glm::dvec3> referencePositions, referenceVelocities;
+		double serialTime = 0.0;
+
+		for (uint32_t threads : threadCounts) {
+			// A step as PhysicsSystem::propagateSGP4Bodies takes it: batch propagation, then the frame transformation of its outputs
+			auto step = [&](double et) {
+				batch.propagate(et, temePositions, temeVelocities, pool, threads);
+
+				batch.scatterStates(temePositions, temeVelocities, temeRotation, pool, [&](size_t k, int, const glm::dvec3 &position, const glm::dvec3 &velocity) {
+					positions[k] = position;
+					velocities[k] = velocity;
+				}, threads);
+			};
+
+			const auto [steps, elapsed] = BenchmarkUtils::Repeat(MIN_BENCHMARK_DURATION, [&](size_t stepIndex) {
+				step(startET + 60.0 * stepIndex);
+			});
+
+			const double stepTime = elapsed / steps;
+
+			// Reproducibility: the states at the start epoch must not depend on the thread count
+			step(startET);
+			if (threads == 1) {
+				serialTime = stepTime;
+				referencePositions = positions;
+				referenceVelocities = velocities;
+			}
+
+			const size_t bytes = catalogSize * sizeof(glm::dvec3);
+			const bool isIdentical =
+				std::memcmp(positions.data(), referencePositions.data(), bytes) == 0 &&
+				std::memcmp(velocities.data(), referenceVelocities.data(), bytes) == 0;
+			CHECK(isIdentical);
+
+			const double speedup = serialTime / stepTime;
+			report << "\n\t\t" << threads << " thread(s): " << (stepTime * 1e3) << " ms/step (" << (100.0 * stepTime / FRAME_BUDGET) << "% of a frame), "
+				<< (catalogSize / stepTime) << " propagations/s, speedup = " << speedup << "x, efficiency = " << (100.0 * speedup / threads) << "%"
+				<< (isIdentical ? "" : " [MISMATCH against 1 thread]");
+		}
+	}
+
+	Log::Print(Log::T_INFO, "Parallel SGP4 scaling", report.str());
+}
@@ -0,0 +1,45 @@
+/* ThreadPool.test.cpp - Verifies that exceptions thrown by tasks reach the caller of ThreadPool::parallelFor, and leave the pool usable.
+*/
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+
+TEST_CASE("Thread pool tasks rethrow their exceptions in the caller", "[threads]") {
+	static constexpr uint32_t THREAD_COUNT = 4;
+	static constexpr size_t TASK_COUNT = 256;
+
+	ThreadPool pool;
+	pool.init("TEST_THREAD_POOL", THREAD_COUNT);
+
+	for (uint32_t threads : { 1u, THREAD_COUNT }) {
+		INFO(threads << " thread(s)");
+
+		std::atomic<size_t> completedCount{ 0 };
+		CHECK_THROWS_AS(pool.parallelFor(TASK_COUNT, [&](size_t task) {
+			if (task % 64 == 7)
+				throw std::runtime_error("Task failed");
+
+			completedCount++;
+		}, threads), std::runtime_error);
+
+		// Tasks that had not started when the exception was thrown are skipped
+		CHECK(completedCount < TASK_COUNT);
+
+
+		// The pool still runs every task of the next job
+		std::vector<int> hasRun(TASK_COUNT, 0);
+		pool.parallelFor(TASK_COUNT, [&](size_t task) {
+			hasRun[task] = 1;
+		}, threads);
+
+		for (size_t task = 0; task < TASK_COUNT; task++)
+			CHECK(hasRun[task] == 1);
+	}
+}
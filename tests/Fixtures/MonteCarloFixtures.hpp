@@ -0,0 +1,118 @@
+/* MonteCarloFixtures.hpp - A synthetic Monte Carlo dispersion analysis for the tests and benchmarks.
+*/
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+
+
+#include <Core/Data/Math.hpp>
+#include <Core/Data/Constants.h>
+#include <Core/Data/Mapping/YAMLKeys.hpp>
+
+#include <Engine/Registry/ECS/Components/SpacecraftComponents.hpp>
+
+#include <Simulation/Data/Bodies.hpp>
+#include <Simulation/Data/Dispersions.hpp>
+#include <Simulation/Forces/ForceModels.hpp>
+#include <Simulation/Dispersions/MonteCarloRunner.hpp>
+#include <Simulation/Maneuvers/FiniteBurnScheduler.hpp>
+
+
+namespace MonteCarloFixtures {
+	constexpr double ALTITUDE = 400e3;					// Altitude of the orbit (m)
+	constexpr double INCLINATION = 51.6;				// Inclination of the orbit (deg)
+	constexpr double BURN_START = 1800.0;				// Start of the prograde burn (s)
+	constexpr double BURN_DURATION = 120.0;				// (s)
+
+
+	/* Gets the period of the circular orbit of the analysis (s). */
+	inline double GetPeriod() {
+		const ICelestialBody *earth = Body::GetCelestialBody(YAMLScene::Body_Earth);
+		const double radius = earth->getEquatRadius() + ALTITUDE;
+
+		return TWOPI * radius / std::sqrt(earth->getGravParam() / radius);
+	}
+
+
+	/* Builds the analysis of a spacecraft in a circular low Earth orbit, with J2, drag and a finite burn. The Earth is fixed at the origin, with its pole along the Z axis.
+		@param runs: The number of dispersed runs.
+		@param duration: The simulation time covered by every run (s).
+		@param config [out]: The analysis (with the default seed).
+		@param scenario [out]: The scenario.
+	*/
+	inline void BuildLEOAnalysis(uint32_t runs, double duration, Dispersions::Config &config, MonteCarloRunner::Scenario &scenario) {
+		const ICelestialBody *earth = Body::GetCelestialBody(YAMLScene::Body_Earth);
+		const double radius = earth->getEquatRadius() + ALTITUDE;
+		const double speed = std::sqrt(earth->getGravParam() / radius);
+		const double inclination = glm::radians(INCLINATION);
+
+		scenario = MonteCarloRunner::Scenario();
+		scenario.bodies = {
+			MonteCarloRunner::Body{ .name = "Earth", .position = glm::dvec3(0.0), .velocity = glm::dvec3(0.0), .mass = earth->getMass(), .isFixed = true },
+			MonteCarloRunner::Body{
+				.name = "Spacecraft",
+				.position = glm::dvec3(radius, 0.0, 0.0),
+				.velocity = glm::dvec3(0.0, speed * std::cos(inclination), speed * std::sin(inclination)),
+				.mass = 500.0,
+				.isFixed = false,
+				.isSpacecraft = true,
+				.dragCoefficient = 2.2,
+				.referenceArea = 4.0,
+				.reflectivityCoefficient = 1.3
+			}
+		};
+
+		scenario.models = ForceModel::ZONAL_HARMONICS | ForceModel::ATMOSPHERIC_DRAG;
+		scenario.zonalDegree = 2;
+		scenario.environment.zonalDegree = scenario.zonalDegree;
+		scenario.environment.centralBodies = {
+			ForceModel::CentralBody{
+				.bodyIndex = 0,
+				.gravParam = earth->getGravParam(),
+				.equatRadius = earth->getEquatRadius(),
+				.flattening = earth->getFlattening(),
+				.zonals = { 0.0, 0.0, earth->getJ2() },
+				.hasAtmosphere = true
+			}
+		};
+		scenario.centralBodyRotVelocities = { earth->getRotVelocity() };
+
+		scenario.engines = {
+			FiniteBurnScheduler::Engine{
+				.bodyIndex = 1,
+				.thrust = 20.0,
+				.exhaustVelocity = 220.0 * PhysicsConst::G0,
+				.mass = 500.0,
+				.fuelMass = 50.0,
+				.burns = { SpacecraftComponent::FiniteBurn{ .startTime = BURN_START, .duration = BURN_DURATION } }
+			}
+		};
+
+		const size_t sampleCount = static_cast<size_t>(std::ceil(duration / scenario.sampleInterval)) + 1;
+		scenario.samples.assign(sampleCount, MonteCarloRunner::Sample{
+			.positions = { glm::dvec3(0.0), glm::dvec3(0.0) },
+			.velocities = { glm::dvec3(0.0), glm::dvec3(0.0) },
+			.orientations = { glm::dmat3(1.0) }
+		});
+
+		config = Dispersions::Config{
+			.runs = runs,
+			.duration = duration,
+			.specs = {
+				Dispersions::Spec{
+					.entity = "Spacecraft",
+					.positionSigma = glm::dvec3(100.0, 500.0, 100.0),
+					.velocitySigma = glm::dvec3(0.1),
+					.massSigma = 5.0,
+					.dragCoefficientSigma = 0.2,
+					.burnStartSigma = 5.0,
+					.burnDurationSigma = 1.0,
+					.burnThrottleSigma = 0.02
+				}
+			}
+		};
+	}
+}
@@ -0,0 +1,36 @@
+/* NBodyFixtures.hpp - Synthetic body stores for the gravity tests and benchmarks.
+*/
+
+#pragma once
+
+#include <random>
+#include <cstdint>
+
+
+#include <Platform/External/GLM.hpp>
+
+#include <Simulation/Gravity/NBodyStore.hpp>
+
+
+namespace NBodyFixtures {
+	constexpr double SCENE_RADIUS = 1e12;				// Radius of the synthetic scenes (m)
+	constexpr double MAX_GRAV_PARAM = 1e20;				// Maximum gravitational parameter of synthetic bodies (m^3/s^2)
+
+
+	/* Fills a store with bodies at uniformly random positions, with uniformly random gravitational parameters.
+		@param bodyCount: The number of bodies.
+		@param seed: The seed of the positions and gravitational parameters.
+		@param store [out]: The store.
+	*/
+	inline void BuildSyntheticScene(size_t bodyCount, uint64_t seed, NBodyStore &store) {
+		std::mt19937_64 generator(seed);
+		std::uniform_real_distribution<double> coordinate(-SCENE_RADIUS, SCENE_RADIUS);
+		std::uniform_real_distribution<double> gravParam(0.0, MAX_GRAV_PARAM);
+
+		store.resize(bodyCount);
+		for (size_t i = 0; i < bodyCount; i++) {
+			store.setPosition(i, glm::dvec3(coordinate(generator), coordinate(generator), coordinate(generator)));
+			store.mu[i] = gravParam(generator);
+		}
+	}
+}
@@ -0,0 +1,31 @@
+/* SPICEFixtures.hpp - SPICE kernels for the tests and benchmarks that convert between time scales.
+*/
+
+#pragma once
+
+#include <mutex>
+
+
+#include <Core/Data/Constants.h>
+#include <Core/Utils/SPICEUtils.hpp>
+#include <Core/Utils/FilePathUtils.hpp>
+
+
+namespace SPICEFixtures {
+	/* Loads the leapseconds kernel from the kernels copied next to the executables, as PhysicsSystem::init loads the scene's kernels. It is loaded once per process.
+		The ET/UTC conversions (e.g., CoordinateSystem::GetGreenwichMeanSiderealTime) require it.
+	*/
+	inline void LoadLeapsecondsKernel() {
+		static std::once_flag isLoaded;
+
+		std::call_once(isLoaded, []() {
+			std::lock_guard<std::recursive_mutex> lock(SPICEUtils::GetMutex());
+
+			// As CoordinateSystem does, return from failed SPICE functions rather than aborting
+			erract_c("SET", 0, const_cast<SpiceChar *>("RETURN"));
+
+			furnsh_c(FilePathUtils::JoinPaths(ROOT_DIR, "kernels", "naif0012.tls").c_str());
+			SPICEUtils::CheckFailure(true);
+		});
+	}
+}
@@ -0,0 +1,164 @@
+/* TLEFixtures.hpp - Fixed element sets and synthetic catalogs for the SGP4 tests and benchmarks.
+	Sources:
+		- D. A. Vallado, P. Crawford, R. Hujsak, T. S. Kelso, "Revisiting Spacetrack Report #3", AIAA 2006-6753 (2006) (verification element sets, SGP4-VER.TLE).
+*/
+
+#pragma once
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+
+#include <Core/Data/Math.hpp>
+
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+#include <Simulation/Propagators/SGP4/TLE.hpp>
+
+
+namespace TLEFixtures {
+	/* An element set of the verification set. */
+	struct ElementSet {
+		std::string name;
+		std::string line1;
+		std::string line2;
+		bool isNominal;			// Whether the element set propagates without errors (decaying and invalid element sets exercise the error codes)
+	};
+
+
+	/* Element sets from Vallado's verification set: near-Earth orbits (with light and moderate drag), deep-space orbits (12 h and 24 h resonances), and element sets that fail with error codes. */
+	inline const std::vector<ElementSet> VERIFICATION_SET = {
+		{	// Near-Earth, eccentric, light drag
+			.name = "VANGUARD 1",
+			.line1 = "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753",
+			.line2 = "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667",
+			.isNominal = true
+		},
+		{	// Near-Earth, perigee at 377 km, moderate drag
+			.name = "DELTA 1 DEB",
+			.line1 = "1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985",
+			.line2 = "2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6774",
+			.isNominal = true
+		},
+		{	// Near-Earth, near-circular, sun-synchronous
+			.name = "CBERS 2",
+			.line1 = "1 28057U 03049A   06177.78615833  .00000060  00000-0  35940-4 0  1836",
+			.line2 = "2 28057  98.4283 247.6961 0000884  88.1964  63.8639 14.35478080140550",
+			.isNominal = true
+		},
+		{	// Deep-space, 12 h resonance
+			.name = "MOLNIYA 2-14",
+			.line1 = "1 08195U 75081A   06176.33215444  .00000099  00000-0  11873-3 0   813",
+			.line2 = "2 08195  64.1586 279.0717 6877146 264.7651  20.2257  2.00491383225656",
+			.isNominal = true
+		},
+		{	// Deep-space, 24 h resonance (geostationary)
+			.name = "XM-3",
+			.line1 = "1 28626U 05008A   06176.46683397 -.00000205  00000-0  10000-3 0  2190",
+			.line2 = "2 28626   0.0019 286.9433 0000335  13.7918  55.6504  1.00270176  4891",
+			.isNominal = true
+		},
+		{	// Sub-orbital: decays within the first hour (error 6)
+			.name = "MINOTAUR R/B",
+			.line1 = "1 28872U 05037B   05333.02012661  .25992681  00000-0  24476-3 0  1534",
+			.line2 = "2 28872  96.4736 157.9986 0303955 244.0492 110.6523 16.46015938 10708",
+			.isNominal = false
+		},
+		{	// Last stage of decay
+			.name = "SL-14 DEB",
+			.line1 = "1 29141U 85108AA  06170.26783845  .99999999  00000-0  13519-0 0   718",
+			.line2 = "2 29141  82.4288 273.4882 0015848 277.2124  83.9133 15.93343074  6828",
+			.isNominal = false
+		},
+		{	// Eccentricity driven out of range
+			.name = "ERROR TEST 33333",
+			.line1 = "1 33333U 05037B   05333.02012661  .25992681  00000-0  24476-3 0  1534",
+			.line2 = "2 33333  96.4736 157.9986 9950000 244.0492 110.6523  4.00004038 10708",
+			.isNominal = false
+		}
+	};
+
+
+	/* Gets the epoch of an element set in Ephemeris Time.
+		The epoch is converted without SPICE, with a fixed TT - UTC offset (leap seconds since 2017): it is only used to order element sets, and to offset propagation times.
+
+		@param rec: The element set.
+		@return The epoch, in seconds past J2000.
+	*/
+	inline double GetEpochET(const ElsetRec &rec) {
+		static constexpr double J2000_JD = 2451545.0;
+		static constexpr double TT_MINUS_UTC = 69.184;		// (s)
+
+		return ((rec.jdsatepoch - J2000_JD) + rec.jdsatepochF) * 86400.0 + TT_MINUS_UTC;
+	}
+
+
+	/* Parses element sets.
+		@param set: The element sets.
+		@param elementSets [out]: The parsed element sets, initialized by sgp4init.
+	*/
+	inline void Parse(const std::vector<ElementSet> &set, std::vector<ElsetRec> &elementSets) {
+		elementSets.clear();
+
+		for (const ElementSet &elementSet : set) {
+			TLE tle;
+			tle.parseLines(elementSet.line1, elementSet.line2);
+			elementSets.push_back(tle.rec);
+		}
+	}
+
+
+	/* Builds a synthetic catalog from the nominal element sets of the verification set.
+		About one in ten element sets is deep-space (as in the public catalog), and the ascending nodes and mean anomalies of the copies are spread by low-discrepancy sequences (identical copies would never separate).
+
+		@param size: The number of element sets.
+		@param elementSets [out]: The element sets, initialized by sgp4init.
+		@param epochs [out]: Their epochs, in Ephemeris Time.
+
+		@return The epoch from which the catalog should be propagated (the latest epoch of the element sets), in Ephemeris Time.
+	*/
+	inline double BuildSyntheticCatalog(size_t size, std::vector<ElsetRec> &elementSets, std::vector<double> &epochs) {
+		static constexpr double GOLDEN_RATIO = 1.6180339887498949;
+		static constexpr size_t DEEP_SPACE_PERIOD = 10;		// One in DEEP_SPACE_PERIOD element sets is deep-space
+
+		// Seeds: nominal element sets whose epochs are close to each other (so that none is propagated for years)
+		std::vector<ElsetRec> nearEarthSeeds, deepSpaceSeeds;
+		for (const ElementSet &elementSet : VERIFICATION_SET) {
+			if (!elementSet.isNominal)
+				continue;
+
+			TLE tle;
+			tle.parseLines(elementSet.line1, elementSet.line2);
+
+			if (tle.rec.epochyr != 6)
+				continue;
+
+			((tle.rec.method == 'd') ? deepSpaceSeeds : nearEarthSeeds).push_back(tle.rec);
+		}
+
+		elementSets.clear();
+		epochs.clear();
+
+		double startET = -std::numeric_limits<double>::infinity();
+
+		for (size_t k = 0; k < size; k++) {
+			ElsetRec rec = ((k % DEEP_SPACE_PERIOD) == DEEP_SPACE_PERIOD - 1)
+				? deepSpaceSeeds[(k / DEEP_SPACE_PERIOD) % deepSpaceSeeds.size()]
+				: nearEarthSeeds[k % nearEarthSeeds.size()];
+
+			if (k > 0) {
+				rec.nodeo = std::fmod(rec.nodeo + TWOPI * std::fmod(k / GOLDEN_RATIO, 1.0), TWOPI);
+				rec.mo = std::fmod(rec.mo + TWOPI * std::fmod(k / (GOLDEN_RATIO * GOLDEN_RATIO), 1.0), TWOPI);
+				sgp4init('a', &rec);
+			}
+
+			elementSets.push_back(rec);
+			epochs.push_back(GetEpochET(rec));
+			startET = std::max(startET, epochs.back());
+		}
+
+		return startET;
+	}
+}
@@ -0,0 +1,176 @@
+/* Lambert.test.cpp - Verifies Izzo's Lambert solver against published solutions, and porkchop grids across thread counts.
+	Sources:
+		- D. A. Vallado, "Fundamentals of Astrodynamics and Applications", 4th ed., 2013 (Example 7-5).
+		- H. D. Curtis, "Orbital Mechanics for Engineering Students", 3rd ed., 2014 (Example 5.2).
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Maneuvers/PorkchopGrid.hpp>
+#include <Simulation/Algorithms/Kepler/KEPLER.hpp>
+#include <Simulation/Algorithms/Lambert/LAMBERT.hpp>
+
+
+TEST_CASE("Izzo's Lambert solver matches published solutions", "[lambert]") {
+	struct _Reference {
+		std::string name;
+		glm::dvec3 r1, r2;			// (km)
+		double tof;					// (s)
+		double mu;					// (km^3/s^2)
+		glm::dvec3 v1, v2;			// (km/s)
+		double tolerance;			// Largest velocity difference, from the precision of the published solution (km/s)
+	};
+
+	const std::vector<_Reference> references = {
+		{
+			.name = "Vallado, Example 7-5",
+			.r1 = glm::dvec3(15945.34, 0.0, 0.0), .r2 = glm::dvec3(12214.83899, 10249.46731, 0.0),
+			.tof = 76.0 * 60.0, .mu = 398600.4418,
+			.v1 = glm::dvec3(2.058913, 2.915965, 0.0), .v2 = glm::dvec3(-3.451565, 0.910315, 0.0),
+			.tolerance = 1e-5
+		},
+		{
+			.name = "Curtis, Example 5.2",
+			.r1 = glm::dvec3(5000.0, 10000.0, 2100.0), .r2 = glm::dvec3(-14600.0, 2500.0, 7000.0),
+			.tof = 3600.0, .mu = 398600.0,
+			.v1 = glm::dvec3(-5.9925, 1.9254, 3.2456), .v2 = glm::dvec3(-3.3125, -4.1966, -0.38529),
+			.tolerance = 1e-4
+		}
+	};
+
+	std::vector<Lambert::Solution> solutions;
+
+	for (const _Reference &reference : references) {
+		INFO(reference.name);
+
+		REQUIRE(Lambert::izzo(reference.r1, reference.r2, reference.tof, reference.mu, false, 0, solutions));
+		REQUIRE(solutions.size() == 1);
+
+		const Lambert::Solution &solution = solutions[0];
+		CHECK(solution.revolutions == 0);
+
+		for (int i = 0; i < 3; i++) {
+			CHECK(solution.v1[i] == Approx(reference.v1[i]).margin(reference.tolerance));
+			CHECK(solution.v2[i] == Approx(reference.v2[i]).margin(reference.tolerance));
+		}
+	}
+}
+
+
+TEST_CASE("Lambert solutions reach the second position under Kepler propagation", "[lambert]") {
+	static constexpr double MU = 3.986004418e+14;			// (m^3/s^2)
+	static constexpr int MAX_REVOLUTIONS = 3;
+	static constexpr double POSITION_TOLERANCE = 1e-3;		// Largest position difference, relative to the distance (m/m)
+	static constexpr double VELOCITY_TOLERANCE = 1e-6;		// Largest velocity difference, relative to the speed (m/s per m/s)
+
+	const glm::dvec3 r1(7000e3, 0.0, 0.0);
+	const glm::dvec3 r2(-2000e3, 8500e3, 1500e3);
+
+	// Long enough for transfers of up to MAX_REVOLUTIONS revolutions
+	const double period = TWOPI * std::sqrt(std::pow(8000e3, 3) / MU);
+	const double tof = (MAX_REVOLUTIONS + 0.3) * period;
+
+	std::vector<Lambert::Solution> solutions;
+
+	for (bool isRetrograde : { false, true }) {
+		INFO((isRetrograde ? "Retrograde" : "Prograde"));
+
+		REQUIRE(Lambert::izzo(r1, r2, tof, MU, isRetrograde, MAX_REVOLUTIONS, solutions));
+
+		// The single-revolution solution, then both branches of every number of revolutions
+		REQUIRE(solutions.size() == 1 + 2 * MAX_REVOLUTIONS);
+
+		for (const Lambert::Solution &solution : solutions) {
+			INFO("Revolutions: " << solution.revolutions << (solution.isRightBranch ? " (right branch)" : ""));
+
+			glm::dvec3 position, velocity;
+			REQUIRE(Kepler::kepler(r1, solution.v1, tof, MU, position, velocity));
+
+			CHECK(glm::length(position - r2) <= POSITION_TOLERANCE * glm::length(r2));
+			CHECK(glm::length(velocity - solution.v2) <= VELOCITY_TOLERANCE * glm::length(solution.v2));
+
+			// The angular momentum must have the requested sense (about +Z)
+			CHECK((glm::cross(r1, solution.v1).z < 0.0) == isRetrograde);
+		}
+	}
+}
+
+
+TEST_CASE("Porkchop grids are identical across thread counts", "[lambert][threads]") {
+	static constexpr uint32_t GRID_SIZE = 64;
+	static constexpr uint32_t THREAD_COUNT = 4;
+	static constexpr double DAY = 86400.0;
+
+	const double mu = 1.32712440018e+20;
+	const double earthRadius = 1.495978707e11;			// Orbital radii (m)
+	const double marsRadius = 1.52368 * earthRadius;
+
+	PorkchopGrid grid;
+	grid.setConfig(PorkchopGrid::Config{
+		.gravParam = mu,
+		.departureStart = 0.0,
+		.departureEnd = 800.0 * DAY,
+		.arrivalStart = 100.0 * DAY,
+		.arrivalEnd = 1300.0 * DAY,
+		.departureSteps = GRID_SIZE,
+		.arrivalSteps = GRID_SIZE,
+		.maxRevolutions = 1
+	});
+
+	// Coplanar circular orbits, Mars 0.75 rad ahead of the Earth
+	auto circularPosition = [mu](double radius, double phase, double t) {
+		const double angle = phase + std::sqrt(mu / (radius * radius * radius)) * t;
+		return radius * glm::dvec3(std::cos(angle), std::sin(angle), 0.0);
+	};
+
+	PorkchopGrid::Ephemerides ephemerides;
+	for (uint32_t i = 0; i < GRID_SIZE; i++) {
+		ephemerides.departurePositions.push_back(circularPosition(earthRadius, 0.0, grid.getDepartureET(i)));
+		ephemerides.arrivalPositions.push_back(circularPosition(marsRadius, 0.75, grid.getArrivalET(i)));
+	}
+	ephemerides.departureVelocities.assign(GRID_SIZE, glm::dvec3(0.0));
+	ephemerides.arrivalVelocities.assign(GRID_SIZE, glm::dvec3(0.0));
+	grid.setEphemerides(ephemerides);
+
+	ThreadPool pool;
+	pool.init("TEST_LAMBERT", THREAD_COUNT);
+
+
+	auto solve = [&](uint32_t threads) {
+		grid.solve(pool, threads);
+		REQUIRE(grid.getStatus() == PorkchopGrid::Status::COMPLETE);
+
+		std::vector<PorkchopGrid::Cell> cells;
+		size_t cursor = 0;
+		grid.fetchRows(cells, cursor);
+		REQUIRE(cursor == GRID_SIZE);
+
+		return cells;
+	};
+
+	const std::vector<PorkchopGrid::Cell> serialCells = solve(1);
+	const std::vector<PorkchopGrid::Cell> parallelCells = solve(THREAD_COUNT);
+
+	REQUIRE(serialCells.size() == static_cast<size_t>(GRID_SIZE) * GRID_SIZE);
+	REQUIRE(parallelCells.size() == serialCells.size());
+	CHECK(std::any_of(serialCells.begin(), serialCells.end(), [](const PorkchopGrid::Cell &cell) { return cell.hasTransfer(); }));
+
+	for (size_t i = 0; i < serialCells.size(); i++) {
+		INFO("Cell " << i);
+
+		const PorkchopGrid::Cell &a = serialCells[i], &b = parallelCells[i];
+		REQUIRE(a.revolutions == b.revolutions);
+		if (a.hasTransfer()) {
+			REQUIRE(a.c3 == b.c3);
+			REQUIRE(a.arrivalVInf == b.arrivalVInf);
+		}
+	}
+}
@@ -0,0 +1,107 @@
+/* MonteCarloRunner.test.cpp - Verifies that Monte Carlo dispersion analyses do not depend on the number of threads.
+*/
+
+#include "catch.hpp"
+
+#include <vector>
+#include <cstring>
+
+
+#include <Core/Application/Threading/ThreadPool.hpp>
+
+#include <Simulation/Data/Dispersions.hpp>
+#include <Simulation/Dispersions/MonteCarloRunner.hpp>
+
+#include <Fixtures/MonteCarloFixtures.hpp>
+
+
+namespace {
+	constexpr uint32_t RUN_COUNT = 32;
+	constexpr uint32_t THREAD_COUNT = 4;
+
+
+	/* Checks whether two outcomes are bit-for-bit identical. */
+	bool IsSameOutcome(const MonteCarloRunner::Outcome &a, const MonteCarloRunner::Outcome &b) {
+		return a.run == b.run && a.isValid == b.isValid
+			&& std::memcmp(&a.position, &b.position, sizeof(a.position)) == 0
+			&& std::memcmp(&a.velocity, &b.velocity, sizeof(a.velocity)) == 0
+			&& std::memcmp(&a.mass, &b.mass, sizeof(a.mass)) == 0;
+	}
+}
+
+
+TEST_CASE("Monte Carlo runs do not depend on the thread that simulates them", "[montecarlo][threads]") {
+	Dispersions::Config config;
+	MonteCarloRunner::Scenario scenario;
+	MonteCarloFixtures::BuildLEOAnalysis(RUN_COUNT, MonteCarloFixtures::GetPeriod(), config, scenario);
+
+	MonteCarloRunner runner;
+	runner.setup(config, scenario);
+
+	std::vector<MonteCarloRunner::Outcome> serialOutcomes(RUN_COUNT + 1);
+	for (uint32_t run = 0; run <= RUN_COUNT; run++)
+		serialOutcomes[run] = runner.simulate(run);
+
+	ThreadPool pool;
+	pool.init("TEST_MONTE_CARLO", THREAD_COUNT);
+
+	std::vector<MonteCarloRunner::Outcome> parallelOutcomes(RUN_COUNT + 1);
+	pool.parallelFor(RUN_COUNT + 1, [&](size_t run) {
+		parallelOutcomes[run] = runner.simulate(static_cast<uint32_t>(run));
+	});
+
+	for (uint32_t run = 0; run <= RUN_COUNT; run++) {
+		INFO("Run " << run);
+		CHECK(serialOutcomes[run].isValid);
+		CHECK(IsSameOutcome(serialOutcomes[run], parallelOutcomes[run]));
+	}
+
+	// Dispersed runs must differ from the nominal run
+	CHECK(serialOutcomes[1].position != serialOutcomes[0].position);
+
+
+	// The same seed yields the same runs, and another seed other runs
+	MonteCarloRunner sameSeedRunner;
+	sameSeedRunner.setup(config, scenario);
+	CHECK(IsSameOutcome(sameSeedRunner.simulate(RUN_COUNT), serialOutcomes[RUN_COUNT]));
+
+	Dispersions::Config otherConfig = config;
+	otherConfig.seed = config.seed + 1;
+
+	MonteCarloRunner otherSeedRunner;
+	otherSeedRunner.setup(otherConfig, scenario);
+	CHECK_FALSE(IsSameOutcome(otherSeedRunner.simulate(RUN_COUNT), serialOutcomes[RUN_COUNT]));
+}
+
+
+TEST_CASE("Monte Carlo statistics do not depend on the number of threads", "[montecarlo][threads]") {
+	Dispersions::Config config;
+	MonteCarloRunner::Scenario scenario;
+	MonteCarloFixtures::BuildLEOAnalysis(RUN_COUNT, MonteCarloFixtures::GetPeriod(), config, scenario);
+
+	MonteCarloRunner runner;
+	runner.setup(config, scenario);
+
+	ThreadPool pool;
+	pool.init("TEST_MONTE_CARLO", THREAD_COUNT);
+
+	runner.run(pool, 1);
+	REQUIRE(runner.getStatus() == MonteCarloRunner::Status::COMPLETE);
+	const MonteCarloRunner::Statistics serialStats = runner.getStatistics();
+
+	runner.run(pool, THREAD_COUNT);
+	REQUIRE(runner.getStatus() == MonteCarloRunner::Status::COMPLETE);
+	const MonteCarloRunner::Statistics parallelStats = runner.getStatistics();
+
+	REQUIRE(serialStats.runs == RUN_COUNT);
+	CHECK(serialStats.failedRuns == 0);
+	CHECK(parallelStats.runs == serialStats.runs);
+	CHECK(parallelStats.failedRuns == serialStats.failedRuns);
+
+	// Order statistics are identical, and sums (merged in completion order) equal up to rounding
+	CHECK(parallelStats.maxMissDistance == serialStats.maxMissDistance);
+	CHECK(parallelStats.missDistance3Sigma == serialStats.missDistance3Sigma);
+	CHECK(parallelStats.maxVelocityError == serialStats.maxVelocityError);
+	CHECK(parallelStats.meanMissDistance == Approx(serialStats.meanMissDistance).epsilon(1e-12));
+	CHECK(parallelStats.meanMass == Approx(serialStats.meanMass).epsilon(1e-12));
+}
@@ -0,0 +1,95 @@
+/* SDP4Checkpoints.test.cpp - Verifies that propagation from resonance checkpoints is bit-identical to propagation from the epoch.
+*/
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+#include <Simulation/Propagators/SGP4/SDP4Checkpoints.hpp>
+
+#include <Fixtures/TLEFixtures.hpp>
+
+
+TEST_CASE("SDP4 checkpoints match sgp4() from the epoch", "[sgp4]") {
+	static constexpr double SPAN = 4.5 * SDP4Checkpoints::INTERVAL;		// Largest time from the epoch of the queries, in both directions (min)
+	static constexpr size_t QUERY_COUNT = 200;
+
+	std::vector<ElsetRec> elementSets;
+	TLEFixtures::Parse(TLEFixtures::VERIFICATION_SET, elementSets);
+
+	for (const std::string &name : { "MOLNIYA 2-14", "XM-3" }) {
+		INFO("Element set: " << name);
+
+		auto it = std::find_if(TLEFixtures::VERIFICATION_SET.begin(), TLEFixtures::VERIFICATION_SET.end(), [&name](const TLEFixtures::ElementSet &elementSet) { return elementSet.name == name; });
+		REQUIRE(it != TLEFixtures::VERIFICATION_SET.end());
+
+		const ElsetRec &initial = elementSets[it - TLEFixtures::VERIFICATION_SET.begin()];
+		REQUIRE(SDP4Checkpoints::IsResonant(initial));
+
+
+		// Queries in both directions, across the epoch, and on checkpoints and integrator steps (where dspace() stops exactly at the query)
+		std::vector<double> queries = {
+			SDP4Checkpoints::STEP, -SDP4Checkpoints::STEP,
+			2.0 * SDP4Checkpoints::INTERVAL, -SDP4Checkpoints::INTERVAL, SDP4Checkpoints::INTERVAL, 0.0, -3.0 * SDP4Checkpoints::INTERVAL
+		};
+
+		std::mt19937_64 generator(42);
+		std::uniform_real_distribution<double> distribution(-SPAN, SPAN);
+		for (size_t i = 0; i < QUERY_COUNT; i++)
+			queries.push_back(distribution(generator));
+
+
+		ElsetRec rec = initial;
+		SDP4Checkpoints checkpoints;
+		size_t forwardCount = 0, backwardCount = 0;		// Checkpoints reached by the queries so far
+
+		for (double tsince : queries) {
+			INFO(tsince << " min from epoch");
+
+			double r[3], v[3];
+			REQUIRE(checkpoints.propagate(rec, tsince, r, v));
+
+			ElsetRec reference = initial;
+			double referenceR[3], referenceV[3];
+			REQUIRE(sgp4(&reference, tsince, referenceR, referenceV));
+
+			CHECK(rec.error == reference.error);
+			CHECK(std::memcmp(r, referenceR, sizeof(r)) == 0);
+			CHECK(std::memcmp(v, referenceV, sizeof(v)) == 0);
+
+			// The ladder only extends as far as the queries reach
+			const size_t count = static_cast<size_t>(std::floor(std::fabs(tsince) / SDP4Checkpoints::INTERVAL));
+			if (tsince > 0.0)
+				forwardCount = std::max(forwardCount, count);
+			else if (tsince < 0.0)
+				backwardCount = std::max(backwardCount, count);
+
+			REQUIRE(checkpoints.size() == forwardCount + backwardCount);
+		}
+
+		CHECK(forwardCount == 4);
+		CHECK(backwardCount == 4);
+
+
+		// Cleared checkpoints are rebuilt, and still match
+		checkpoints.clear();
+		CHECK(checkpoints.size() == 0);
+
+		double r[3], v[3];
+		REQUIRE(checkpoints.propagate(rec, -SPAN, r, v));
+		CHECK(checkpoints.size() == 4);
+
+		ElsetRec reference = initial;
+		double referenceR[3], referenceV[3];
+		REQUIRE(sgp4(&reference, -SPAN, referenceR, referenceV));
+		CHECK(std::memcmp(r, referenceR, sizeof(r)) == 0);
+		CHECK(std::memcmp(v, referenceV, sizeof(v)) == 0);
+	}
+}
@@ -0,0 +1,83 @@
+/* SGP4Batch.test.cpp - Verifies batch SGP4 propagation against the scalar model on a fixed verification set.
+*/
+
+#include "catch.hpp"
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+#include <Simulation/Gravity/GravityKernels.hpp>
+#include <Simulation/Propagators/SGP4/SGP4.hpp>
+#include <Simulation/Propagators/SGP4/SGP4Batch.hpp>
+
+#include <Fixtures/TLEFixtures.hpp>
+
+
+TEST_CASE("Batch SGP4 matches scalar sgp4() on the verification set", "[sgp4]") {
+	static constexpr double SPAN = 1440.0;					// Propagated span, from the epoch of each element set (min)
+	static constexpr double STEP = 20.0;					// (min)
+	static constexpr double POSITION_TOLERANCE = 1e-6;		// Largest position difference (km)
+
+	std::vector<ElsetRec> elementSets;
+	TLEFixtures::Parse(TLEFixtures::VERIFICATION_SET, elementSets);
+
+	const size_t setCount = elementSets.size();
+	const size_t deepSpaceCount = std::count_if(elementSets.begin(), elementSets.end(), [](const ElsetRec &rec) { return rec.method == 'd'; });
+	REQUIRE(deepSpaceCount > 0);
+	REQUIRE(deepSpaceCount < setCount);
+
+	using GravityKernels::InstructionSet;
+	const InstructionSet supportedSet = GravityKernels::GetSupportedInstructionSet();
+
+	for (InstructionSet instructionSet : { InstructionSet::SCALAR, InstructionSet::AVX2, InstructionSet::AVX512 }) {
+		if (static_cast<int>(instructionSet) > static_cast<int>(supportedSet))
+			break;
+
+		INFO("Instruction set: " << GravityKernels::GetInstructionSetName(instructionSet));
+
+		// Every element set is propagated from its own epoch (i.e., its epoch is the time origin)
+		SGP4Batch batch;
+		for (const ElsetRec &rec : elementSets)
+			batch.add(rec, 0.0);
+
+		REQUIRE(batch.size() == setCount);
+		REQUIRE(batch.getDeepSpaceCount() == deepSpaceCount);
+
+		std::vector<glm::dvec3> positions, velocities;
+		std::vector<bool> hasFailed(setCount, false);
+		double maxDifference = 0.0;
+
+		for (double tsince = 0.0; tsince <= SPAN; tsince += STEP) {
+			batch.propagate(tsince * 60.0, positions, velocities, instructionSet);
+
+			for (size_t k = 0; k < setCount; k++) {
+				INFO("Element set: " << TLEFixtures::VERIFICATION_SET[k].name << ", " << tsince << " min from epoch");
+
+				ElsetRec rec = elementSets[k];
+				double r[3], v[3];
+				sgp4(&rec, tsince, r, v);
+
+				CHECK(batch.getErrors()[k] == rec.error);
+				hasFailed[k] = hasFailed[k] || (rec.error != 0);
+
+				// sgp4() computes the state of decayed element sets (error 6), but not those of the others that fail
+				if (rec.error == 0 || rec.error == 6) {
+					const double difference = glm::length(positions[k] - glm::dvec3(r[0], r[1], r[2]));
+					CHECK(difference <= POSITION_TOLERANCE);
+
+					maxDifference = std::max(maxDifference, difference);
+				}
+			}
+		}
+
+		// Nominal element sets must propagate over the whole span, and the others must exercise the error codes
+		for (size_t k = 0; k < setCount; k++) {
+			INFO("Element set: " << TLEFixtures::VERIFICATION_SET[k].name);
+			CHECK(hasFailed[k] == !TLEFixtures::VERIFICATION_SET[k].isNominal);
+		}
+
+		CHECK(maxDifference <= POSITION_TOLERANCE);
+	}
+}
@@ -1,2 +1,15 @@
-#define CATCH_CONFIG_MAIN
-#include "catch.hpp"
\ No newline at end of file
+#define CATCH_CONFIG_RUNNER
+#include "catch.hpp"
+
+#include <thread>
+
+
+#include <Core/Application/Threading/ThreadManager.hpp>
+
+
+int main(int argc, char *argv[]) {
+	// Log messages name the thread that printed them, which requires the main thread to be known (as the engine does on startup)
+	ThreadManager::SetMainThreadID(std::this_thread::get_id());
+
+	return Catch::Session().run(argc, argv);
+}